@@ -42,6 +42,14 @@ struct b2ContactPositionConstraint
 	int32 pointCount;
 };
 
+int32 b2ContactSolver::GetAllocationSize(int32 count)
+{
+	const int32 mask = b2StackAllocator::ALIGN_MASK;
+	int32 positionSize = (count * sizeof(b2ContactPositionConstraint) + mask) & ~mask;
+	int32 velocitySize = (count * sizeof(b2ContactVelocityConstraint) + mask) & ~mask;
+	return positionSize + velocitySize;
+}
+
 b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 {
 	m_step = def->step;
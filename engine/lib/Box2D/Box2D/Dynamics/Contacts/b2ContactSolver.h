@@ -72,6 +72,9 @@ public:
 	b2ContactSolver(b2ContactSolverDef* def);
 	~b2ContactSolver();
 
+	/// Get the number of bytes the solver allocates for the given number of contacts.
+	static int32 GetAllocationSize(int32 count);
+
 	void InitializeVelocityConstraints();
 
 	void WarmStart();
@@ -36,6 +36,16 @@ class b2Island
 public:
 	b2Island(int32 bodyCapacity, int32 contactCapacity, int32 jointCapacity,
 			b2StackAllocator* allocator, b2ContactListener* listener);
+
+	/// Construct an island over buffers owned by the caller. Static bodies are not
+	/// members because they are shared between islands. Body state is stored at
+	/// b2Body::m_islandIndex. Impulses are not reported, see ReportStoredImpulses().
+	b2Island(b2Body** bodies, int32 bodyCount,
+			b2Contact** contacts, int32 contactCount,
+			b2Joint** joints, int32 jointCount,
+			b2Position* positions, b2Velocity* velocities,
+			b2StackAllocator* allocator);
+
 	~b2Island();
 
 	void Clear()
@@ -71,6 +81,12 @@ public:
 
 	void Report(const b2ContactVelocityConstraint* constraints);
 
+	/// Report the impulses that the solver stored in the contact manifolds.
+	void ReportStoredImpulses(b2ContactListener* listener);
+
+	/// Load the state of the static bodies referenced by the contacts and joints.
+	void LoadStaticBodies();
+
 	b2StackAllocator* m_allocator;
 	b2ContactListener* m_listener;
 
@@ -88,6 +104,9 @@ public:
 	int32 m_bodyCapacity;
 	int32 m_contactCapacity;
 	int32 m_jointCapacity;
+
+	bool m_ownsBuffers;
+	bool m_staticBodiesShared;
 };
 
 #endif
@@ -33,6 +33,10 @@ struct b2Profile
 	float32 solvePosition;
 	float32 broadphase;
 	float32 solveTOI;
+	float32 solveParticles;
+	float32 findIslands;
+	float32 solveIslands;
+	int32 islandCount;
 };
 
 /// This is an internal structure.
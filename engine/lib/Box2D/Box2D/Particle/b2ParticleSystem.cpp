@@ -20,6 +20,7 @@
 #include <Box2D/Particle/b2VoronoiDiagram.h>
 #include <Box2D/Particle/b2ParticleAssembly.h>
 #include <Box2D/Common/b2BlockAllocator.h>
+#include <Box2D/Common/b2TaskExecutor.h>
 #include <Box2D/Dynamics/b2World.h>
 #include <Box2D/Dynamics/b2WorldCallbacks.h>
 #include <Box2D/Dynamics/b2Body.h>
@@ -39,6 +40,20 @@
 // to the top of the function to re-run the test.
 #define LIQUIDFUN_SIMD_INLINE inline
 
+// The per-particle passes use SSE on x86. Contact finding on ARM uses the
+// NEON assembly instead.
+#if !defined(LIQUIDFUN_SIMD_NEON) && (defined(__SSE__) || defined(_M_X64) || \
+	(defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#include <xmmintrin.h>
+#define LIQUIDFUN_SIMD_SSE
+#endif
+
+// Particles in each range handed to the world's task executor.
+static const int32 k_particlesPerTask = 1024;
+// Contacts reserved per particle for each range in FindContacts_Parallel().
+// Ranges that run out of room are finished on the calling thread.
+static const int32 k_reservedContactsPerParticle = 8;
+
 
 static const uint32 xTruncBits = 12;
 static const uint32 yTruncBits = 12;
@@ -391,7 +406,10 @@ b2ParticleSystem::b2ParticleSystem(const b2ParticleSystemDef* def,
 	m_contactBuffer(world->m_blockAllocator),
 	m_bodyContactBuffer(world->m_blockAllocator),
 	m_pairBuffer(world->m_blockAllocator),
-	m_triadBuffer(world->m_blockAllocator)
+	m_triadBuffer(world->m_blockAllocator),
+	m_contactScratchBuffer(world->m_blockAllocator),
+	m_contactAdjacencyOffsetBuffer(world->m_blockAllocator),
+	m_contactAdjacencyBuffer(world->m_blockAllocator)
 {
 	b2Assert(def);
 	m_paused = false;
@@ -401,6 +419,7 @@ b2ParticleSystem::b2ParticleSystem(const b2ParticleSystemDef* def,
 	m_allGroupFlags = 0;
 	m_needsUpdateAllGroupFlags = false;
 	m_hasForce = false;
+	m_hasContactAdjacency = false;
 	m_iterationIndex = 0;
 
 	SetStrictContactCheck(def->strictContactCheck);
@@ -490,7 +509,7 @@ template <typename T> T* b2ParticleSystem::ReallocateBuffer(
 		sizeof(T) * newCapacity);
 	if (oldBuffer)
 	{
-		//memcpy(newBuffer, oldBuffer, sizeof(T) * oldCapacity);
+		memcpy((void*)newBuffer, oldBuffer, sizeof(T) * oldCapacity);
 		m_world->m_blockAllocator.Free(oldBuffer, sizeof(T) * oldCapacity);
 	}
 	return newBuffer;
@@ -550,7 +569,7 @@ template <typename T> T* b2ParticleSystem::RequestBuffer(T* buffer)
 		buffer = (T*) (m_world->m_blockAllocator.Allocate(
 						   sizeof(T) * m_internalAllocatedCapacity));
 		b2Assert(buffer);
-		//memset(buffer, 0, sizeof(T) * m_internalAllocatedCapacity);
+		memset((void*)buffer, 0, sizeof(T) * m_internalAllocatedCapacity);
 	}
 	return buffer;
 }
@@ -1661,6 +1680,440 @@ void b2ParticleSystem::DestroyParticleGroup(b2ParticleGroup* group)
 	m_world->m_blockAllocator.Free(group, sizeof(b2ParticleGroup));
 }
 
+// Runs a kernel over ranges of k_particlesPerTask particles.
+template <typename Kernel>
+class b2ParticleRangeTask : public b2Task
+{
+public:
+	b2ParticleRangeTask(const Kernel& kernel, int32 count) :
+		m_kernel(kernel), m_count(count) {}
+
+	virtual void Execute(int32 begin, int32 end, int32 workerIndex)
+	{
+		B2_NOT_USED(workerIndex);
+		m_kernel(begin * k_particlesPerTask,
+				 b2Min(end * k_particlesPerTask, m_count));
+	}
+
+private:
+	const Kernel& m_kernel;
+	int32 m_count;
+};
+
+// Only split the passes when each worker gets at least one full range.
+inline bool b2ParticleSystem::ShouldSolveInParallel() const
+{
+	return m_world->m_taskExecutor && m_world->m_workerCount > 1 &&
+		m_count >= m_world->m_workerCount * k_particlesPerTask;
+}
+
+template <typename Kernel>
+void b2ParticleSystem::ForEachParticleRange(const Kernel& kernel)
+{
+	if (ShouldSolveInParallel())
+	{
+		b2ParticleRangeTask<Kernel> task(kernel, m_count);
+		m_world->m_taskExecutor->ParallelFor(
+			&task, (m_count + k_particlesPerTask - 1) / k_particlesPerTask);
+	}
+	else
+	{
+		kernel(0, m_count);
+	}
+}
+
+// Adds the weight of each particle's contacts to its weight.
+class b2ParticleWeightKernel
+{
+public:
+	b2ParticleWeightKernel(const int32* offsets, const int32* adjacency,
+						   const b2ParticleContact* contacts,
+						   float32* weights) :
+		m_offsets(offsets), m_adjacency(adjacency), m_contacts(contacts),
+		m_weights(weights) {}
+
+	void operator()(int32 begin, int32 end) const
+	{
+		for (int32 i = begin; i < end; i++)
+		{
+			float32 w = m_weights[i];
+			for (int32 j = m_offsets[i]; j < m_offsets[i + 1]; j++)
+			{
+				w += m_contacts[m_adjacency[j] >> 1].GetWeight();
+			}
+			m_weights[i] = w;
+		}
+	}
+
+private:
+	const int32* m_offsets;
+	const int32* m_adjacency;
+	const b2ParticleContact* m_contacts;
+	float32* m_weights;
+};
+
+// Computes the pressure of each particle from its weight.
+class b2ParticlePressureKernel
+{
+public:
+	b2ParticlePressureKernel(const float32* weights, const uint32* flags,
+							 const float32* staticPressures,
+							 float32 pressurePerWeight, float32 maxPressure,
+							 uint32 noPressureFlags, float32* pressures) :
+		m_weights(weights), m_flags(flags),
+		m_staticPressures(staticPressures),
+		m_pressurePerWeight(pressurePerWeight), m_maxPressure(maxPressure),
+		m_noPressureFlags(noPressureFlags),
+		m_pressures(pressures) {}
+
+	void operator()(int32 begin, int32 end) const
+	{
+		int32 i = begin;
+#if defined(LIQUIDFUN_SIMD_SSE)
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 minWeight = _mm_set1_ps(b2_minParticleWeight);
+		const __m128 pressurePerWeight = _mm_set1_ps(m_pressurePerWeight);
+		const __m128 maxPressure = _mm_set1_ps(m_maxPressure);
+		for (; i + 4 <= end; i += 4)
+		{
+			const __m128 w = _mm_loadu_ps(m_weights + i);
+			const __m128 h = _mm_mul_ps(pressurePerWeight,
+				_mm_max_ps(zero, _mm_sub_ps(w, minWeight)));
+			_mm_storeu_ps(m_pressures + i, _mm_min_ps(h, maxPressure));
+		}
+#endif
+		for (; i < end; i++)
+		{
+			float32 w = m_weights[i];
+			float32 h = m_pressurePerWeight *
+				b2Max(0.0f, w - b2_minParticleWeight);
+			m_pressures[i] = b2Min(h, m_maxPressure);
+		}
+		// ignores particles which have their own repulsive force
+		if (m_noPressureFlags)
+		{
+			for (i = begin; i < end; i++)
+			{
+				if (m_flags[i] & m_noPressureFlags)
+				{
+					m_pressures[i] = 0;
+				}
+			}
+		}
+		if (m_staticPressures)
+		{
+			for (i = begin; i < end; i++)
+			{
+				if (m_flags[i] & b2_staticPressureParticle)
+				{
+					m_pressures[i] += m_staticPressures[i];
+				}
+			}
+		}
+	}
+
+private:
+	const float32* m_weights;
+	const uint32* m_flags;
+	const float32* m_staticPressures;
+	float32 m_pressurePerWeight;
+	float32 m_maxPressure;
+	uint32 m_noPressureFlags;
+	float32* m_pressures;
+};
+
+// Applies the pressure of each particle's contacts to its velocity.
+class b2ParticlePressureImpulseKernel
+{
+public:
+	b2ParticlePressureImpulseKernel(const int32* offsets,
+									const int32* adjacency,
+									const b2ParticleContact* contacts,
+									const float32* pressures,
+									float32 velocityPerPressure,
+									b2Vec2* velocities) :
+		m_offsets(offsets), m_adjacency(adjacency), m_contacts(contacts),
+		m_pressures(pressures), m_velocityPerPressure(velocityPerPressure),
+		m_velocities(velocities) {}
+
+	void operator()(int32 begin, int32 end) const
+	{
+		for (int32 i = begin; i < end; i++)
+		{
+			b2Vec2 v = m_velocities[i];
+			for (int32 j = m_offsets[i]; j < m_offsets[i + 1]; j++)
+			{
+				const b2ParticleContact& contact =
+					m_contacts[m_adjacency[j] >> 1];
+				int32 a = contact.GetIndexA();
+				int32 b = contact.GetIndexB();
+				float32 w = contact.GetWeight();
+				b2Vec2 n = contact.GetNormal();
+				float32 h = m_pressures[a] + m_pressures[b];
+				b2Vec2 f = m_velocityPerPressure * w * h * n;
+				if (m_adjacency[j] & 1)
+				{
+					v += f;
+				}
+				else
+				{
+					v -= f;
+				}
+			}
+			m_velocities[i] = v;
+		}
+	}
+
+private:
+	const int32* m_offsets;
+	const int32* m_adjacency;
+	const b2ParticleContact* m_contacts;
+	const float32* m_pressures;
+	float32 m_velocityPerPressure;
+	b2Vec2* m_velocities;
+};
+
+// Sums the static pressure of each particle's neighbors.
+class b2StaticPressureAccumulationKernel
+{
+public:
+	b2StaticPressureAccumulationKernel(const int32* offsets,
+									   const int32* adjacency,
+									   const b2ParticleContact* contacts,
+									   const float32* staticPressures,
+									   float32* accumulations) :
+		m_offsets(offsets), m_adjacency(adjacency), m_contacts(contacts),
+		m_staticPressures(staticPressures), m_accumulations(accumulations) {}
+
+	void operator()(int32 begin, int32 end) const
+	{
+		for (int32 i = begin; i < end; i++)
+		{
+			float32 wh = 0;
+			for (int32 j = m_offsets[i]; j < m_offsets[i + 1]; j++)
+			{
+				const b2ParticleContact& contact =
+					m_contacts[m_adjacency[j] >> 1];
+				if (contact.GetFlags() & b2_staticPressureParticle)
+				{
+					int32 other = (m_adjacency[j] & 1) ?
+						contact.GetIndexA() : contact.GetIndexB();
+					wh += contact.GetWeight() * m_staticPressures[other];
+				}
+			}
+			m_accumulations[i] = wh;
+		}
+	}
+
+private:
+	const int32* m_offsets;
+	const int32* m_adjacency;
+	const b2ParticleContact* m_contacts;
+	const float32* m_staticPressures;
+	float32* m_accumulations;
+};
+
+// One relaxation step of the static pressure.
+class b2StaticPressureKernel
+{
+public:
+	b2StaticPressureKernel(const float32* weights, const uint32* flags,
+						   const float32* accumulations,
+						   float32 pressurePerWeight, float32 maxPressure,
+						   float32 relaxation, float32* staticPressures) :
+		m_weights(weights), m_flags(flags), m_accumulations(accumulations),
+		m_pressurePerWeight(pressurePerWeight), m_maxPressure(maxPressure),
+		m_relaxation(relaxation), m_staticPressures(staticPressures) {}
+
+	void operator()(int32 begin, int32 end) const
+	{
+		for (int32 i = begin; i < end; i++)
+		{
+			float32 w = m_weights[i];
+			if (m_flags[i] & b2_staticPressureParticle)
+			{
+				float32 wh = m_accumulations[i];
+				float32 h =
+					(wh + m_pressurePerWeight * (w - b2_minParticleWeight)) /
+					(w + m_relaxation);
+				m_staticPressures[i] = b2Clamp(h, 0.0f, m_maxPressure);
+			}
+			else
+			{
+				m_staticPressures[i] = 0;
+			}
+		}
+	}
+
+private:
+	const float32* m_weights;
+	const uint32* m_flags;
+	const float32* m_accumulations;
+	float32 m_pressurePerWeight;
+	float32 m_maxPressure;
+	float32 m_relaxation;
+	float32* m_staticPressures;
+};
+
+class b2ParticleGravityKernel
+{
+public:
+	b2ParticleGravityKernel(const b2Vec2& gravity, b2Vec2* velocities) :
+		m_gravity(gravity), m_velocities(velocities) {}
+
+	void operator()(int32 begin, int32 end) const
+	{
+		int32 i = begin;
+#if defined(LIQUIDFUN_SIMD_SSE)
+		// Two particles per register.
+		const __m128 gravity = _mm_setr_ps(
+			m_gravity.x, m_gravity.y, m_gravity.x, m_gravity.y);
+		for (; i + 2 <= end; i += 2)
+		{
+			float32* v = &m_velocities[i].x;
+			_mm_storeu_ps(v, _mm_add_ps(_mm_loadu_ps(v), gravity));
+		}
+#endif
+		for (; i < end; i++)
+		{
+			m_velocities[i] += m_gravity;
+		}
+	}
+
+private:
+	b2Vec2 m_gravity;
+	b2Vec2* m_velocities;
+};
+
+class b2ParticleLimitVelocityKernel
+{
+public:
+	b2ParticleLimitVelocityKernel(float32 criticalVelocitySquared,
+								  b2Vec2* velocities) :
+		m_criticalVelocitySquared(criticalVelocitySquared),
+		m_velocities(velocities) {}
+
+	void operator()(int32 begin, int32 end) const
+	{
+		int32 i = begin;
+#if defined(LIQUIDFUN_SIMD_SSE)
+		const __m128 criticalVelocitySquared =
+			_mm_set1_ps(m_criticalVelocitySquared);
+		const __m128 one = _mm_set1_ps(1.0f);
+		for (; i + 4 <= end; i += 4)
+		{
+			float32* v = &m_velocities[i].x;
+			const __m128 v01 = _mm_loadu_ps(v);
+			const __m128 v23 = _mm_loadu_ps(v + 4);
+			const __m128 s01 = _mm_mul_ps(v01, v01);
+			const __m128 s23 = _mm_mul_ps(v23, v23);
+			const __m128 v2 = _mm_add_ps(
+				_mm_shuffle_ps(s01, s23, _MM_SHUFFLE(2, 0, 2, 0)),
+				_mm_shuffle_ps(s01, s23, _MM_SHUFFLE(3, 1, 3, 1)));
+			const __m128 over = _mm_cmpgt_ps(v2, criticalVelocitySquared);
+			if (_mm_movemask_ps(over) == 0)
+			{
+				continue;
+			}
+			// Particles under the limit are scaled by one.
+			__m128 scale = _mm_sqrt_ps(
+				_mm_div_ps(criticalVelocitySquared, v2));
+			scale = _mm_or_ps(_mm_and_ps(over, scale),
+							  _mm_andnot_ps(over, one));
+			_mm_storeu_ps(v, _mm_mul_ps(v01, _mm_unpacklo_ps(scale, scale)));
+			_mm_storeu_ps(v + 4,
+						  _mm_mul_ps(v23, _mm_unpackhi_ps(scale, scale)));
+		}
+#endif
+		for (; i < end; i++)
+		{
+			b2Vec2& v = m_velocities[i];
+			float32 v2 = b2Dot(v, v);
+			if (v2 > m_criticalVelocitySquared)
+			{
+				v *= b2Sqrt(m_criticalVelocitySquared / v2);
+			}
+		}
+	}
+
+private:
+	float32 m_criticalVelocitySquared;
+	b2Vec2* m_velocities;
+};
+
+class b2ParticleIntegrateKernel
+{
+public:
+	b2ParticleIntegrateKernel(float32 dt, const b2Vec2* velocities,
+							  b2Vec2* positions) :
+		m_dt(dt), m_velocities(velocities), m_positions(positions) {}
+
+	void operator()(int32 begin, int32 end) const
+	{
+		int32 i = begin;
+#if defined(LIQUIDFUN_SIMD_SSE)
+		const __m128 dt = _mm_set1_ps(m_dt);
+		for (; i + 2 <= end; i += 2)
+		{
+			float32* p = &m_positions[i].x;
+			const __m128 v = _mm_loadu_ps(&m_velocities[i].x);
+			_mm_storeu_ps(p, _mm_add_ps(_mm_loadu_ps(p), _mm_mul_ps(dt, v)));
+		}
+#endif
+		for (; i < end; i++)
+		{
+			m_positions[i] += m_dt * m_velocities[i];
+		}
+	}
+
+private:
+	float32 m_dt;
+	const b2Vec2* m_velocities;
+	b2Vec2* m_positions;
+};
+
+// Index m_contactBuffer by particle with a counting sort.  Visiting contacts
+// in order keeps each particle's entries in contact order.
+void b2ParticleSystem::UpdateContactAdjacency()
+{
+	const int32 contactCount = m_contactBuffer.GetCount();
+	m_contactAdjacencyOffsetBuffer.SetCount(0);
+	m_contactAdjacencyOffsetBuffer.Reserve(m_count + 1);
+	m_contactAdjacencyOffsetBuffer.SetCount(m_count + 1);
+	m_contactAdjacencyBuffer.SetCount(0);
+	m_contactAdjacencyBuffer.Reserve(2 * contactCount);
+	m_contactAdjacencyBuffer.SetCount(2 * contactCount);
+	int32* offsets = m_contactAdjacencyOffsetBuffer.Data();
+	int32* adjacency = m_contactAdjacencyBuffer.Data();
+
+	memset(offsets, 0, sizeof(*offsets) * (m_count + 1));
+	for (int32 k = 0; k < contactCount; k++)
+	{
+		const b2ParticleContact& contact = m_contactBuffer[k];
+		offsets[contact.GetIndexA()]++;
+		offsets[contact.GetIndexB()]++;
+	}
+	int32 start = 0;
+	for (int32 i = 0; i <= m_count; i++)
+	{
+		int32 count = offsets[i];
+		offsets[i] = start;
+		start += count;
+	}
+	for (int32 k = 0; k < contactCount; k++)
+	{
+		const b2ParticleContact& contact = m_contactBuffer[k];
+		adjacency[offsets[contact.GetIndexA()]++] = k << 1;
+		adjacency[offsets[contact.GetIndexB()]++] = (k << 1) | 1;
+	}
+	// Each offset now holds the end of its particle's entries.
+	for (int32 i = m_count; i > 0; i--)
+	{
+		offsets[i] = offsets[i - 1];
+	}
+	offsets[0] = 0;
+}
+
 void b2ParticleSystem::ComputeWeight()
 {
 	// calculates the sum of contact-weights for each particle
@@ -1673,6 +2126,14 @@ void b2ParticleSystem::ComputeWeight()
 		float32 w = contact.weight;
 		m_weightBuffer[a] += w;
 	}
+	if (m_hasContactAdjacency)
+	{
+		ForEachParticleRange(b2ParticleWeightKernel(
+			m_contactAdjacencyOffsetBuffer.Data(),
+			m_contactAdjacencyBuffer.Data(), m_contactBuffer.Data(),
+			m_weightBuffer));
+		return;
+	}
 	for (int32 k = 0; k < m_contactBuffer.GetCount(); k++)
 	{
 		const b2ParticleContact& contact = m_contactBuffer[k];
@@ -1806,37 +2267,94 @@ b2ParticleSystem::GetInsideBoundsEnumerator(const b2AABB& aabb) const
 	return InsideBoundsEnumerator(lowerTag, upperTag, firstProxy, lastProxy);
 }
 
-inline void b2ParticleSystem::AddContact(int32 a, int32 b,
-	b2GrowableBuffer<b2ParticleContact>& contacts) const
+// Output for FindContactsInRange() that grows as needed.
+class b2ParticleContactBufferOutput
+{
+public:
+	b2ParticleContactBufferOutput(
+		b2GrowableBuffer<b2ParticleContact>& contacts) :
+		m_contacts(contacts) {}
+
+	b2ParticleContact* Append() { return &m_contacts.Append(); }
+	int32 GetCount() const { return m_contacts.GetCount(); }
+	void SetCount(int32 count) { m_contacts.SetCount(count); }
+
+private:
+	b2GrowableBuffer<b2ParticleContact>& m_contacts;
+};
+
+// Output for FindContactsInRange() with a fixed capacity, so that it never
+// allocates from a task.
+class b2ParticleContactArrayOutput
+{
+public:
+	b2ParticleContactArrayOutput(b2ParticleContact* contacts,
+								 int32 capacity) :
+		m_contacts(contacts), m_count(0), m_capacity(capacity) {}
+
+	b2ParticleContact* Append()
+	{
+		return m_count < m_capacity ? &m_contacts[m_count++] : NULL;
+	}
+	int32 GetCount() const { return m_count; }
+	void SetCount(int32 count) { m_count = count; }
+
+private:
+	b2ParticleContact* m_contacts;
+	int32 m_count;
+	int32 m_capacity;
+};
+
+// Returns false if the output is full.
+template <typename Output>
+inline bool b2ParticleSystem::AddContact(int32 a, int32 b,
+	Output& output) const
 {
 	b2Vec2 d = m_positionBuffer.data[b] - m_positionBuffer.data[a];
 	float32 distBtParticlesSq = b2Dot(d, d);
 	if (distBtParticlesSq < m_squaredDiameter)
 	{
 		float32 invD = b2InvSqrt(distBtParticlesSq);
-		b2ParticleContact& contact = contacts.Append();
-		contact.SetIndices(a, b);
-		contact.SetFlags(m_flagsBuffer.data[a] | m_flagsBuffer.data[b]);
+		b2ParticleContact* contact = output.Append();
+		if (contact == NULL)
+		{
+			return false;
+		}
+		contact->SetIndices(a, b);
+		contact->SetFlags(m_flagsBuffer.data[a] | m_flagsBuffer.data[b]);
 		// 1 - distBtParticles / diameter
-		contact.SetWeight(1 - distBtParticlesSq * invD * m_inverseDiameter);
-		contact.SetNormal(invD * d);
+		contact->SetWeight(1 - distBtParticlesSq * invD * m_inverseDiameter);
+		contact->SetNormal(invD * d);
 	}
+	return true;
 }
 
-void b2ParticleSystem::FindContacts_Reference(
-	b2GrowableBuffer<b2ParticleContact>& contacts) const
+// Find the contacts of the proxies in [first, last). Returns the proxy at
+// which the output filled up, or 'last'. The contacts of a proxy are either
+// all output or not at all.
+template <typename Output>
+int32 b2ParticleSystem::FindContactsInRange(int32 first, int32 last,
+	Output& output) const
 {
 	const Proxy* beginProxy = m_proxyBuffer.Begin();
 	const Proxy* endProxy = m_proxyBuffer.End();
 
-	contacts.SetCount(0);
-	for (const Proxy *a = beginProxy, *c = beginProxy; a < endProxy; a++)
+	// Start 'c' where a sweep from the first proxy would have left it.
+	const Proxy* c = beginProxy;
+	if (first > 0)
+	{
+		c = std::lower_bound(beginProxy, endProxy,
+			computeRelativeTag(beginProxy[first].tag, -1, 1));
+	}
+	for (const Proxy* a = beginProxy + first; a < beginProxy + last; a++)
 	{
+		const int32 mark = output.GetCount();
+		bool added = true;
 		uint32 rightTag = computeRelativeTag(a->tag, 1, 0);
-		for (const Proxy* b = a + 1; b < endProxy; b++)
+		for (const Proxy* b = a + 1; added && b < endProxy; b++)
 		{
 			if (rightTag < b->tag) break;
-			AddContact(a->index, b->index, contacts);
+			added = AddContact(a->index, b->index, output);
 		}
 		uint32 bottomLeftTag = computeRelativeTag(a->tag, -1, 1);
 		for (; c < endProxy; c++)
@@ -1844,12 +2362,105 @@ void b2ParticleSystem::FindContacts_Reference(
 			if (bottomLeftTag <= c->tag) break;
 		}
 		uint32 bottomRightTag = computeRelativeTag(a->tag, 1, 1);
-		for (const Proxy* b = c; b < endProxy; b++)
+		for (const Proxy* b = c; added && b < endProxy; b++)
 		{
 			if (bottomRightTag < b->tag) break;
-			AddContact(a->index, b->index, contacts);
+			added = AddContact(a->index, b->index, output);
+		}
+		if (!added)
+		{
+			output.SetCount(mark);
+			return (int32)(a - beginProxy);
+		}
+	}
+	return last;
+}
+
+void b2ParticleSystem::FindContacts_Reference(
+	b2GrowableBuffer<b2ParticleContact>& contacts) const
+{
+	contacts.SetCount(0);
+	b2ParticleContactBufferOutput output(contacts);
+	FindContactsInRange(0, m_proxyBuffer.GetCount(), output);
+}
+
+// Finds the contacts of each range of proxies into its own part of
+// m_contactScratchBuffer.
+class b2FindParticleContactsKernel
+{
+public:
+	b2FindParticleContactsKernel(const b2ParticleSystem* system,
+								 b2ParticleContact* contacts,
+								 int32* rangeCounts, int32* rangeEnds) :
+		m_system(system), m_contacts(contacts), m_rangeCounts(rangeCounts),
+		m_rangeEnds(rangeEnds) {}
+
+	void operator()(int32 begin, int32 end) const
+	{
+		const int32 capacity =
+			k_particlesPerTask * k_reservedContactsPerParticle;
+		for (int32 first = begin; first < end; first += k_particlesPerTask)
+		{
+			const int32 range = first / k_particlesPerTask;
+			b2ParticleContactArrayOutput output(
+				m_contacts + range * capacity, capacity);
+			m_rangeEnds[range] = m_system->FindContactsInRange(
+				first, b2Min(first + k_particlesPerTask, end), output);
+			m_rangeCounts[range] = output.GetCount();
 		}
 	}
+
+private:
+	const b2ParticleSystem* m_system;
+	b2ParticleContact* m_contacts;
+	int32* m_rangeCounts;
+	int32* m_rangeEnds;
+};
+
+// Produces exactly the contacts of FindContacts_Reference(), in the same
+// order, however the proxies are split.
+void b2ParticleSystem::FindContacts_Parallel(
+	b2GrowableBuffer<b2ParticleContact>& contacts)
+{
+	b2Assert(m_proxyBuffer.GetCount() == m_count);
+	const int32 rangeCount =
+		(m_count + k_particlesPerTask - 1) / k_particlesPerTask;
+	const int32 rangeCapacity =
+		k_particlesPerTask * k_reservedContactsPerParticle;
+	m_contactScratchBuffer.SetCount(0);
+	m_contactScratchBuffer.Reserve(rangeCount * rangeCapacity);
+	int32* rangeCounts = (int32*) m_world->m_stackAllocator.Allocate(
+		sizeof(int32) * 2 * rangeCount);
+	int32* rangeEnds = rangeCounts + rangeCount;
+
+	ForEachParticleRange(b2FindParticleContactsKernel(
+		this, m_contactScratchBuffer.Data(), rangeCounts, rangeEnds));
+
+	// Join the ranges in proxy order, finishing any that filled up.
+	int32 count = 0;
+	for (int32 i = 0; i < rangeCount; i++)
+	{
+		count += rangeCounts[i];
+	}
+	contacts.SetCount(0);
+	contacts.Reserve(count);
+	b2ParticleContactBufferOutput output(contacts);
+	for (int32 i = 0; i < rangeCount; i++)
+	{
+		const int32 offset = contacts.GetCount();
+		contacts.Reserve(offset + rangeCounts[i]);
+		memcpy(contacts.Data() + offset,
+			   m_contactScratchBuffer.Data() + i * rangeCapacity,
+			   sizeof(b2ParticleContact) * rangeCounts[i]);
+		contacts.SetCount(offset + rangeCounts[i]);
+		const int32 last = b2Min((i + 1) * k_particlesPerTask, m_count);
+		if (rangeEnds[i] < last)
+		{
+			FindContactsInRange(rangeEnds[i], last, output);
+		}
+	}
+
+	m_world->m_stackAllocator.Free(rangeCounts);
 }
 
 // Put the positions and indices in proxy-order. This allows us to process
@@ -1982,12 +2593,19 @@ void b2ParticleSystem::FindContacts_Simd(
 
 LIQUIDFUN_SIMD_INLINE
 void b2ParticleSystem::FindContacts(
-	b2GrowableBuffer<b2ParticleContact>& contacts) const
+	b2GrowableBuffer<b2ParticleContact>& contacts)
 {
 	#if defined(LIQUIDFUN_SIMD_NEON)
 		FindContacts_Simd(contacts);
 	#else
-		FindContacts_Reference(contacts);
+		if (ShouldSolveInParallel())
+		{
+			FindContacts_Parallel(contacts);
+		}
+		else
+		{
+			FindContacts_Reference(contacts);
+		}
 	#endif
 
 	#if defined(LIQUIDFUN_SIMD_TEST_VS_REFERENCE)
@@ -3007,6 +3625,11 @@ void b2ParticleSystem::Solve(const b2TimeStep& step)
 		subStep.inv_dt *= step.particleIterations;
 		UpdateContacts(false);
 		UpdateBodyContacts();
+		m_hasContactAdjacency = ShouldSolveInParallel();
+		if (m_hasContactAdjacency)
+		{
+			UpdateContactAdjacency();
+		}
 		ComputeWeight();
 		if (m_allGroupFlags & b2_particleGroupNeedsUpdateDepth)
 		{
@@ -3087,11 +3710,9 @@ void b2ParticleSystem::Solve(const b2TimeStep& step)
 			SolveWall();
 		}
 		// The particle positions can be updated only at the end of substep.
-		for (int32 i = 0; i < m_count; i++)
-		{
-			m_positionBuffer.data[i] += subStep.dt * m_velocityBuffer.data[i];
-		}
+		IntegratePositions(subStep);
 	}
+	m_hasContactAdjacency = false;
 }
 
 void b2ParticleSystem::UpdateAllParticleFlags()
@@ -3118,24 +3739,21 @@ void b2ParticleSystem::UpdateAllGroupFlags()
 void b2ParticleSystem::LimitVelocity(const b2TimeStep& step)
 {
 	float32 criticalVelocitySquared = GetCriticalVelocitySquared(step);
-	for (int32 i = 0; i < m_count; i++)
-	{
-		b2Vec2& v = m_velocityBuffer.data[i];
-		float32 v2 = b2Dot(v, v);
-		if (v2 > criticalVelocitySquared)
-		{
-			v *= b2Sqrt(criticalVelocitySquared / v2);
-		}
-	}
+	ForEachParticleRange(b2ParticleLimitVelocityKernel(
+		criticalVelocitySquared, m_velocityBuffer.data));
 }
 
 void b2ParticleSystem::SolveGravity(const b2TimeStep& step)
 {
 	b2Vec2 gravity = step.dt * m_def.gravityScale * m_world->GetGravity();
-	for (int32 i = 0; i < m_count; i++)
-	{
-		m_velocityBuffer.data[i] += gravity;
-	}
+	ForEachParticleRange(b2ParticleGravityKernel(
+		gravity, m_velocityBuffer.data));
+}
+
+void b2ParticleSystem::IntegratePositions(const b2TimeStep& step)
+{
+	ForEachParticleRange(b2ParticleIntegrateKernel(
+		step.dt, m_velocityBuffer.data, m_positionBuffer.data));
 }
 
 void b2ParticleSystem::SolveStaticPressure(const b2TimeStep& step)
@@ -3157,38 +3775,36 @@ void b2ParticleSystem::SolveStaticPressure(const b2TimeStep& step)
 	///     w_i is sum of contact weight of particle i
 	for (int32 t = 0; t < m_def.staticPressureIterations; t++)
 	{
-		memset(m_accumulationBuffer, 0,
-			   sizeof(*m_accumulationBuffer) * m_count);
-		for (int32 k = 0; k < m_contactBuffer.GetCount(); k++)
+		if (m_hasContactAdjacency)
 		{
-			const b2ParticleContact& contact = m_contactBuffer[k];
-			if (contact.GetFlags() & b2_staticPressureParticle)
-			{
-				int32 a = contact.GetIndexA();
-				int32 b = contact.GetIndexB();
-				float32 w = contact.GetWeight();
-				m_accumulationBuffer[a] +=
-					w * m_staticPressureBuffer[b]; // a <- b
-				m_accumulationBuffer[b] +=
-					w * m_staticPressureBuffer[a]; // b <- a
-			}
+			ForEachParticleRange(b2StaticPressureAccumulationKernel(
+				m_contactAdjacencyOffsetBuffer.Data(),
+				m_contactAdjacencyBuffer.Data(), m_contactBuffer.Data(),
+				m_staticPressureBuffer, m_accumulationBuffer));
 		}
-		for (int32 i = 0; i < m_count; i++)
+		else
 		{
-			float32 w = m_weightBuffer[i];
-			if (m_flagsBuffer.data[i] & b2_staticPressureParticle)
+			memset(m_accumulationBuffer, 0,
+				   sizeof(*m_accumulationBuffer) * m_count);
+			for (int32 k = 0; k < m_contactBuffer.GetCount(); k++)
 			{
-				float32 wh = m_accumulationBuffer[i];
-				float32 h =
-					(wh + pressurePerWeight * (w - b2_minParticleWeight)) /
-					(w + relaxation);
-				m_staticPressureBuffer[i] = b2Clamp(h, 0.0f, maxPressure);
-			}
-			else
-			{
-				m_staticPressureBuffer[i] = 0;
+				const b2ParticleContact& contact = m_contactBuffer[k];
+				if (contact.GetFlags() & b2_staticPressureParticle)
+				{
+					int32 a = contact.GetIndexA();
+					int32 b = contact.GetIndexB();
+					float32 w = contact.GetWeight();
+					m_accumulationBuffer[a] +=
+						w * m_staticPressureBuffer[b]; // a <- b
+					m_accumulationBuffer[b] +=
+						w * m_staticPressureBuffer[a]; // b <- a
+				}
 			}
 		}
+		ForEachParticleRange(b2StaticPressureKernel(
+			m_weightBuffer, m_flagsBuffer.data, m_accumulationBuffer,
+			pressurePerWeight, maxPressure, relaxation,
+			m_staticPressureBuffer));
 	}
 }
 
@@ -3198,35 +3814,15 @@ void b2ParticleSystem::SolvePressure(const b2TimeStep& step)
 	float32 criticalPressure = GetCriticalPressure(step);
 	float32 pressurePerWeight = m_def.pressureStrength * criticalPressure;
 	float32 maxPressure = b2_maxParticlePressure * criticalPressure;
-	for (int32 i = 0; i < m_count; i++)
-	{
-		float32 w = m_weightBuffer[i];
-		float32 h = pressurePerWeight * b2Max(0.0f, w - b2_minParticleWeight);
-		m_accumulationBuffer[i] = b2Min(h, maxPressure);
-	}
-	// ignores particles which have their own repulsive force
-	if (m_allParticleFlags & k_noPressureFlags)
-	{
-		for (int32 i = 0; i < m_count; i++)
-		{
-			if (m_flagsBuffer.data[i] & k_noPressureFlags)
-			{
-				m_accumulationBuffer[i] = 0;
-			}
-		}
-	}
-	// static pressure
-	if (m_allParticleFlags & b2_staticPressureParticle)
-	{
-		b2Assert(m_staticPressureBuffer);
-		for (int32 i = 0; i < m_count; i++)
-		{
-			if (m_flagsBuffer.data[i] & b2_staticPressureParticle)
-			{
-				m_accumulationBuffer[i] += m_staticPressureBuffer[i];
-			}
-		}
-	}
+	const bool hasStaticPressure =
+		(m_allParticleFlags & b2_staticPressureParticle) != 0;
+	b2Assert(!hasStaticPressure || m_staticPressureBuffer);
+	ForEachParticleRange(b2ParticlePressureKernel(
+		m_weightBuffer, m_flagsBuffer.data,
+		hasStaticPressure ? m_staticPressureBuffer : NULL,
+		pressurePerWeight, maxPressure,
+		(m_allParticleFlags & k_noPressureFlags) ? k_noPressureFlags : 0,
+		m_accumulationBuffer));
 	// applies pressure between each particles in contact
 	float32 velocityPerPressure = step.dt / (m_def.density * m_particleDiameter);
 	for (int32 k = 0; k < m_bodyContactBuffer.GetCount(); k++)
@@ -3243,6 +3839,15 @@ void b2ParticleSystem::SolvePressure(const b2TimeStep& step)
 		m_velocityBuffer.data[a] -= GetParticleInvMass() * f;
 		b->ApplyLinearImpulse(f, p, true);
 	}
+	if (m_hasContactAdjacency)
+	{
+		ForEachParticleRange(b2ParticlePressureImpulseKernel(
+			m_contactAdjacencyOffsetBuffer.Data(),
+			m_contactAdjacencyBuffer.Data(), m_contactBuffer.Data(),
+			m_accumulationBuffer, velocityPerPressure,
+			m_velocityBuffer.data));
+		return;
+	}
 	for (int32 k = 0; k < m_contactBuffer.GetCount(); k++)
 	{
 		const b2ParticleContact& contact = m_contactBuffer[k];
@@ -4449,7 +5054,7 @@ inline void b2ParticleSystem::PrepareForceBuffer()
 {
 	if (!m_hasForce)
 	{
-		//memset(m_forceBuffer, 0, sizeof(*m_forceBuffer) * m_count);
+		memset((void*)m_forceBuffer, 0, sizeof(*m_forceBuffer) * m_count);
 		m_hasForce = true;
 	}
 }
@@ -743,6 +743,7 @@ private:
 	friend class b2ParticleGroup;
 	friend class b2ParticleBodyContactRemovePredicate;
 	friend class b2FixtureParticleQueryCallback;
+	friend class b2FindParticleContactsKernel;
 #ifdef LIQUIDFUN_UNIT_TESTS
 	FRIEND_TEST(FunctionTests, GetParticleMass);
 	FRIEND_TEST(FunctionTests, AreProxyBuffersTheSame);
@@ -931,10 +932,14 @@ private:
 
 	void UpdateAllParticleFlags();
 	void UpdateAllGroupFlags();
-	void AddContact(int32 a, int32 b,
-		b2GrowableBuffer<b2ParticleContact>& contacts) const;
+	template <typename Output>
+	bool AddContact(int32 a, int32 b, Output& output) const;
+	template <typename Output>
+	int32 FindContactsInRange(int32 first, int32 last, Output& output) const;
 	void FindContacts_Reference(
 		b2GrowableBuffer<b2ParticleContact>& contacts) const;
+	void FindContacts_Parallel(
+		b2GrowableBuffer<b2ParticleContact>& contacts);
 	void ReorderForFindContact(FindContactInput* reordered,
 		                       int alignedCount) const;
 	void GatherChecksOneParticle(
@@ -947,7 +952,7 @@ private:
 	void FindContacts_Simd(
 		b2GrowableBuffer<b2ParticleContact>& contacts) const;
 	void FindContacts(
-		b2GrowableBuffer<b2ParticleContact>& contacts) const;
+		b2GrowableBuffer<b2ParticleContact>& contacts);
 	static void UpdateProxyTags(
 		const uint32* const tags,
 		b2GrowableBuffer<Proxy>& proxies);
@@ -971,6 +976,15 @@ private:
 	void NotifyBodyContactListenerPostContact(FixtureParticleSet& fixtureSet);
 	void UpdateBodyContacts();
 
+	/// Whether per-particle passes are split across the world's task
+	/// executor.
+	bool ShouldSolveInParallel() const;
+	/// Run a kernel over [0, m_count), in ranges on the world's task
+	/// executor when ShouldSolveInParallel().
+	template <typename Kernel>
+	void ForEachParticleRange(const Kernel& kernel);
+	void UpdateContactAdjacency();
+
 	void Solve(const b2TimeStep& step);
 	void SolveCollision(const b2TimeStep& step);
 	void LimitVelocity(const b2TimeStep& step);
@@ -988,6 +1002,7 @@ private:
 	void SolveSpring(const b2TimeStep& step);
 	void SolveTensile(const b2TimeStep& step);
 	void SolveViscous();
+	void IntegratePositions(const b2TimeStep& step);
 	void SolveRepulsive(const b2TimeStep& step);
 	void SolvePowder(const b2TimeStep& step);
 	void SolveSolid(const b2TimeStep& step);
@@ -1072,6 +1087,7 @@ private:
 	int32 m_allGroupFlags;
 	bool m_needsUpdateAllGroupFlags;
 	bool m_hasForce;
+	bool m_hasContactAdjacency;
 	int32 m_iterationIndex;
 	float32 m_inverseDensity;
 	float32 m_particleDiameter;
@@ -1124,6 +1140,15 @@ private:
 	b2GrowableBuffer<b2ParticleBodyContact> m_bodyContactBuffer;
 	b2GrowableBuffer<b2ParticlePair> m_pairBuffer;
 	b2GrowableBuffer<b2ParticleTriad> m_triadBuffer;
+	/// Per task output of FindContacts_Parallel().
+	b2GrowableBuffer<b2ParticleContact> m_contactScratchBuffer;
+	/// m_contactBuffer indexed by particle.  Built for each substep that
+	/// runs in parallel so that passes which scatter over contacts can
+	/// instead gather per particle.  Entries hold (contact index << 1) | 1
+	/// when the particle is contact B and are in contact order, so sums
+	/// are accumulated in the same order as the serial loops.
+	b2GrowableBuffer<int32> m_contactAdjacencyOffsetBuffer;
+	b2GrowableBuffer<int32> m_contactAdjacencyBuffer;
 
 	/// Time each particle should be destroyed relative to the last time
 	/// m_timeElapsed was initialized.  Each unit of time corresponds to
@@ -0,0 +1,52 @@
+/*
+* Copyright (c) 2011 Erin Catto http://box2d.org
+* Copyright (c) 2014 Google, Inc.
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef B2_TASK_EXECUTOR_H
+#define B2_TASK_EXECUTOR_H
+
+#include <Box2D/Common/b2Settings.h>
+
+/// A unit of work that the world can split across workers.
+class b2Task
+{
+public:
+	virtual ~b2Task() {}
+
+	/// Run the items in the range [begin, end) on the given worker.
+	/// @param workerIndex in the range [0, b2TaskExecutor::GetWorkerCount()).
+	virtual void Execute(int32 begin, int32 end, int32 workerIndex) = 0;
+};
+
+/// Implement this to let the world run parts of a time step on your own threads.
+/// The world only hands out work whose results do not depend on how it is
+/// partitioned so any split is deterministic.
+class b2TaskExecutor
+{
+public:
+	virtual ~b2TaskExecutor() {}
+
+	/// Get the number of workers, including the calling thread.
+	virtual int32 GetWorkerCount() const = 0;
+
+	/// Run the task over the range [0, count) and return once every item is complete.
+	/// Each worker must be given at most one range at a time.
+	virtual void ParallelFor(b2Task* task, int32 count) = 0;
+};
+
+#endif
@@ -146,6 +146,7 @@ public:
 
 protected:
 	friend class b2ContactManager;
+	friend class b2ContactUpdateTask;
 	friend class b2World;
 	friend class b2ContactSolver;
 	friend class b2Body;
@@ -189,6 +190,11 @@ protected:
 
 	void Update(b2ContactListener* listener);
 
+	/// Update is split in two so the manifolds can be evaluated on worker threads.
+	/// UpdateManifold only writes to this contact. It returns true if touching.
+	bool UpdateManifold(b2Manifold* oldManifold);
+	void FinishUpdate(bool touching, const b2Manifold* oldManifold, b2ContactListener* listener);
+
 	static b2ContactRegister s_registers[b2Shape::e_typeCount][b2Shape::e_typeCount];
 	static bool s_initialized;
 
@@ -22,6 +22,8 @@
 #include <Box2D/Dynamics/b2Fixture.h>
 #include <Box2D/Dynamics/b2WorldCallbacks.h>
 #include <Box2D/Dynamics/Contacts/b2Contact.h>
+#include <Box2D/Common/b2StackAllocator.h>
+#include <Box2D/Common/b2TaskExecutor.h>
 
 b2ContactFilter b2_defaultFilter;
 b2ContactListener b2_defaultListener;
@@ -33,6 +35,8 @@ b2ContactManager::b2ContactManager()
 	m_contactFilter = &b2_defaultFilter;
 	m_contactListener = &b2_defaultListener;
 	m_allocator = NULL;
+	m_stackAllocator = NULL;
+	m_taskExecutor = NULL;
 }
 
 void b2ContactManager::Destroy(b2Contact* c)
@@ -105,6 +109,12 @@ void b2ContactManager::Destroy(b2Contact* c)
 // contact list.
 void b2ContactManager::Collide()
 {
+	if (m_taskExecutor && m_taskExecutor->GetWorkerCount() > 1 && m_contactCount > 0)
+	{
+		CollideParallel();
+		return;
+	}
+
 	// Update awake contacts.
 	b2Contact* c = m_contactList;
 	while (c)
@@ -170,6 +180,177 @@ void b2ContactManager::Collide()
 	}
 }
 
+// How CollideParallel() updates a contact that survived filtering.
+enum b2ContactUpdateMode
+{
+	// Both bodies were asleep. An earlier contact in the list may still wake them.
+	e_contactUpdateAsleep,
+	// The manifold is evaluated on a worker.
+	e_contactUpdateWorker,
+	// Sensors are updated on the calling thread.
+	e_contactUpdateSerial,
+	// Filtered out or no longer overlapping in the broad-phase.
+	e_contactUpdateDestroy
+};
+
+// Evaluates contact manifolds. Each contact only writes to itself.
+class b2ContactUpdateTask : public b2Task
+{
+public:
+	virtual void Execute(int32 begin, int32 end, int32 workerIndex)
+	{
+		B2_NOT_USED(workerIndex);
+
+		for (int32 i = begin; i < end; ++i)
+		{
+			if (modes[i] == e_contactUpdateWorker)
+			{
+				touching[i] = contacts[i]->UpdateManifold(oldManifolds + i);
+			}
+		}
+	}
+
+	b2Contact** contacts;
+	uint8* modes;
+	bool* touching;
+	b2Manifold* oldManifolds;
+};
+
+// The results are identical to Collide(). Destruction, waking and listener
+// calls all happen on the calling thread in contact list order.
+void b2ContactManager::CollideParallel()
+{
+	int32 capacity = m_contactCount;
+	b2Contact** contacts = (b2Contact**)m_stackAllocator->Allocate(capacity * sizeof(b2Contact*));
+	uint8* modes = (uint8*)m_stackAllocator->Allocate(capacity * sizeof(uint8));
+	bool* touching = (bool*)m_stackAllocator->Allocate(capacity * sizeof(bool));
+	b2Manifold* oldManifolds = (b2Manifold*)m_stackAllocator->Allocate(capacity * sizeof(b2Manifold));
+	int32 count = 0;
+
+	b2Contact* c = m_contactList;
+	while (c)
+	{
+		b2Fixture* fixtureA = c->GetFixtureA();
+		b2Fixture* fixtureB = c->GetFixtureB();
+		int32 indexA = c->GetChildIndexA();
+		int32 indexB = c->GetChildIndexB();
+		b2Body* bodyA = fixtureA->GetBody();
+		b2Body* bodyB = fixtureB->GetBody();
+
+		// Is this contact flagged for filtering?
+		if (c->m_flags & b2Contact::e_filterFlag)
+		{
+			// Should these bodies collide?
+			if (bodyB->ShouldCollide(bodyA) == false)
+			{
+				contacts[count] = c;
+				modes[count++] = e_contactUpdateDestroy;
+				c = c->GetNext();
+				continue;
+			}
+
+			// Check user filtering.
+			if (m_contactFilter && m_contactFilter->ShouldCollide(fixtureA, fixtureB) == false)
+			{
+				contacts[count] = c;
+				modes[count++] = e_contactUpdateDestroy;
+				c = c->GetNext();
+				continue;
+			}
+
+			// Clear the filtering flag.
+			c->m_flags &= ~b2Contact::e_filterFlag;
+		}
+
+		bool activeA = bodyA->IsAwake() && bodyA->m_type != b2_staticBody;
+		bool activeB = bodyB->IsAwake() && bodyB->m_type != b2_staticBody;
+
+		if (activeA == false && activeB == false)
+		{
+			contacts[count] = c;
+			modes[count++] = e_contactUpdateAsleep;
+			c = c->GetNext();
+			continue;
+		}
+
+		int32 proxyIdA = fixtureA->m_proxies[indexA].proxyId;
+		int32 proxyIdB = fixtureB->m_proxies[indexB].proxyId;
+		bool overlap = m_broadPhase.TestOverlap(proxyIdA, proxyIdB);
+
+		// Contacts that cease to overlap in the broad-phase are destroyed below.
+		if (overlap == false)
+		{
+			contacts[count] = c;
+			modes[count++] = e_contactUpdateDestroy;
+			c = c->GetNext();
+			continue;
+		}
+
+		// Sensor overlap tests update the shared distance statistics.
+		bool sensor = fixtureA->IsSensor() || fixtureB->IsSensor();
+
+		contacts[count] = c;
+		modes[count++] = sensor ? e_contactUpdateSerial : e_contactUpdateWorker;
+		c = c->GetNext();
+	}
+
+	b2ContactUpdateTask task;
+	task.contacts = contacts;
+	task.modes = modes;
+	task.touching = touching;
+	task.oldManifolds = oldManifolds;
+	m_taskExecutor->ParallelFor(&task, count);
+
+	for (int32 i = 0; i < count; ++i)
+	{
+		c = contacts[i];
+
+		if (modes[i] == e_contactUpdateWorker)
+		{
+			c->FinishUpdate(touching[i], oldManifolds + i, m_contactListener);
+			continue;
+		}
+
+		if (modes[i] == e_contactUpdateDestroy)
+		{
+			Destroy(c);
+			continue;
+		}
+
+		if (modes[i] == e_contactUpdateAsleep)
+		{
+			b2Fixture* fixtureA = c->GetFixtureA();
+			b2Fixture* fixtureB = c->GetFixtureB();
+			b2Body* bodyA = fixtureA->GetBody();
+			b2Body* bodyB = fixtureB->GetBody();
+
+			bool activeA = bodyA->IsAwake() && bodyA->m_type != b2_staticBody;
+			bool activeB = bodyB->IsAwake() && bodyB->m_type != b2_staticBody;
+
+			// At least one body must be awake and it must be dynamic or kinematic.
+			if (activeA == false && activeB == false)
+			{
+				continue;
+			}
+
+			int32 proxyIdA = fixtureA->m_proxies[c->GetChildIndexA()].proxyId;
+			int32 proxyIdB = fixtureB->m_proxies[c->GetChildIndexB()].proxyId;
+			if (m_broadPhase.TestOverlap(proxyIdA, proxyIdB) == false)
+			{
+				Destroy(c);
+				continue;
+			}
+		}
+
+		c->Update(m_contactListener);
+	}
+
+	m_stackAllocator->Free(oldManifolds);
+	m_stackAllocator->Free(touching);
+	m_stackAllocator->Free(modes);
+	m_stackAllocator->Free(contacts);
+}
+
 void b2ContactManager::FindNewContacts()
 {
 	m_broadPhase.UpdatePairs(this);
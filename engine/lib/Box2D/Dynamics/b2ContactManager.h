@@ -25,7 +25,9 @@ class b2Contact;
 class b2ContactFilter;
 class b2ContactListener;
 class b2BlockAllocator;
+class b2StackAllocator;
 class b2ParticleSystem;
+class b2TaskExecutor;
 
 // Delegate of b2World.
 class b2ContactManager
@@ -43,6 +45,9 @@ public:
 	void Destroy(b2Contact* c);
 
 	void Collide();
+
+	// Narrow phase with the manifolds evaluated on the task executor.
+	void CollideParallel();
             
 	b2BroadPhase m_broadPhase;
 	b2Contact* m_contactList;
@@ -50,6 +55,8 @@ public:
 	b2ContactFilter* m_contactFilter;
 	b2ContactListener* m_contactListener;
 	b2BlockAllocator* m_allocator;
+	b2StackAllocator* m_stackAllocator;
+	b2TaskExecutor* m_taskExecutor;
 };
 
 #endif
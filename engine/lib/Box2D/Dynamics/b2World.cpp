@@ -32,6 +32,7 @@
 #include <Box2D/Collision/Shapes/b2PolygonShape.h>
 #include <Box2D/Collision/b2TimeOfImpact.h>
 #include <Box2D/Common/b2Draw.h>
+#include <Box2D/Common/b2TaskExecutor.h>
 #include <Box2D/Common/b2Timer.h>
 #include <new>
 
@@ -65,6 +66,8 @@ b2World::~b2World()
 		DestroyParticleSystem(m_particleSystemList);
 	}
 
+	SetTaskExecutor(NULL);
+
 	// Even though the block allocator frees them for us, for safety,
 	// we should ensure that all buffers have been freed.
 	b2Assert(m_blockAllocator.GetNumGiantAllocations() == 0);
@@ -420,6 +423,45 @@ void b2World::SetAllowSleeping(bool flag)
 	}
 }
 
+void b2World::SetTaskExecutor(b2TaskExecutor* executor)
+{
+	b2Assert(IsLocked() == false);
+
+	for (int32 i = 0; i < m_workerCount; ++i)
+	{
+		m_workerAllocators[i].~b2StackAllocator();
+	}
+	if (m_workerAllocators)
+	{
+		b2Free(m_workerAllocators);
+	}
+	m_workerAllocators = NULL;
+	m_workerCount = 0;
+
+	if (m_workerPositions)
+	{
+		b2Free(m_workerPositions);
+		b2Free(m_workerVelocities);
+	}
+	m_workerPositions = NULL;
+	m_workerVelocities = NULL;
+	m_workerSlotCapacity = 0;
+
+	m_taskExecutor = executor;
+	m_contactManager.m_taskExecutor = executor;
+
+	if (executor)
+	{
+		// Each worker needs its own allocator for the contact solver.
+		m_workerCount = executor->GetWorkerCount();
+		m_workerAllocators = (b2StackAllocator*)b2Alloc(m_workerCount * sizeof(b2StackAllocator));
+		for (int32 i = 0; i < m_workerCount; ++i)
+		{
+			new (m_workerAllocators + i) b2StackAllocator;
+		}
+	}
+}
+
 // Initialize the world with a specified gravity.
 void b2World::Init(const b2Vec2& gravity)
 {
@@ -447,6 +489,14 @@ void b2World::Init(const b2Vec2& gravity)
 	m_inv_dt0 = 0.0f;
 
 	m_contactManager.m_allocator = &m_blockAllocator;
+	m_contactManager.m_stackAllocator = &m_stackAllocator;
+
+	m_taskExecutor = NULL;
+	m_workerAllocators = NULL;
+	m_workerCount = 0;
+	m_workerPositions = NULL;
+	m_workerVelocities = NULL;
+	m_workerSlotCapacity = 0;
 
 	m_liquidFunVersion = &b2_liquidFunVersion;
 	m_liquidFunVersionString = b2_liquidFunVersionString;
@@ -466,7 +516,48 @@ void b2World::Solve(const b2TimeStep& step)
 	m_profile.solveInit = 0.0f;
 	m_profile.solveVelocity = 0.0f;
 	m_profile.solvePosition = 0.0f;
+	m_profile.findIslands = 0.0f;
+	m_profile.solveIslands = 0.0f;
+	m_profile.islandCount = 0;
+
+	if (m_taskExecutor && m_workerCount > 1)
+	{
+		SolveIslandsParallel(step);
+	}
+	else
+	{
+		SolveIslands(step);
+	}
+
+	{
+		b2Timer timer;
+		// Synchronize fixtures, check for out of range bodies.
+		for (b2Body* b = m_bodyList; b; b = b->GetNext())
+		{
+			// If a body was not in an island then it did not move.
+			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			{
+				continue;
+			}
 
+			if (b->GetType() == b2_staticBody)
+			{
+				continue;
+			}
+
+			// Update fixtures (for broad-phase).
+			b->SynchronizeFixtures();
+		}
+
+		// Look for new contacts.
+		m_contactManager.FindNewContacts();
+		m_profile.broadphase = timer.GetMilliseconds();
+	}
+}
+
+// Find and solve the islands one at a time.
+void b2World::SolveIslands(const b2TimeStep& step)
+{
 	// Size the island for the worst case.
 	b2Island island(m_bodyCount,
 					m_contactManager.m_contactCount,
@@ -509,6 +600,8 @@ void b2World::Solve(const b2TimeStep& step)
 			continue;
 		}
 
+		b2Timer islandTimer;
+
 		// Reset island and stack.
 		island.Clear();
 		int32 stackCount = 0;
@@ -605,8 +698,13 @@ void b2World::Solve(const b2TimeStep& step)
 			}
 		}
 
+		m_profile.findIslands += islandTimer.GetMilliseconds();
+		++m_profile.islandCount;
+
+		islandTimer.Reset();
 		b2Profile profile;
 		island.Solve(&profile, step, m_gravity, m_allowSleep);
+		m_profile.solveIslands += islandTimer.GetMilliseconds();
 		m_profile.solveInit += profile.solveInit;
 		m_profile.solveVelocity += profile.solveVelocity;
 		m_profile.solvePosition += profile.solvePosition;
@@ -624,33 +722,299 @@ void b2World::Solve(const b2TimeStep& step)
 	}
 
 	m_stackAllocator.Free(stack);
+}
 
+// A run of bodies, contacts and joints that form an island.
+struct b2IslandRange
+{
+	int32 bodyStart, bodyCount;
+	int32 contactStart, contactCount;
+	int32 jointStart, jointCount;
+	bool solveOnWorker;
+};
+
+// Solves islands on the task executor workers.
+class b2IslandSolveTask : public b2Task
+{
+public:
+	virtual void Execute(int32 begin, int32 end, int32 workerIndex)
 	{
-		b2Timer timer;
-		// Synchronize fixtures, check for out of range bodies.
-		for (b2Body* b = m_bodyList; b; b = b->GetNext())
+		b2Position* workerPositions = positions + workerIndex * slotCount;
+		b2Velocity* workerVelocities = velocities + workerIndex * slotCount;
+
+		for (int32 i = begin; i < end; ++i)
 		{
-			// If a body was not in an island then it did not move.
-			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			const b2IslandRange& range = islands[i];
+
+			if (range.solveOnWorker == false)
 			{
 				continue;
 			}
 
-			if (b->GetType() == b2_staticBody)
+			b2Island island(bodies + range.bodyStart, range.bodyCount,
+							contacts + range.contactStart, range.contactCount,
+							joints + range.jointStart, range.jointCount,
+							workerPositions, workerVelocities,
+							allocators + workerIndex);
+			island.Solve(profiles + i, *step, gravity, allowSleep);
+		}
+	}
+
+	const b2IslandRange* islands;
+	b2Body** bodies;
+	b2Contact** contacts;
+	b2Joint** joints;
+	b2Position* positions;
+	b2Velocity* velocities;
+	int32 slotCount;
+	b2StackAllocator* allocators;
+	b2Profile* profiles;
+	const b2TimeStep* step;
+	b2Vec2 gravity;
+	bool allowSleep;
+};
+
+// Find all of the islands then solve them on the task executor. Islands share no
+// bodies other than static ones so they are solved independently. Static bodies are
+// not island members and each worker has its own copy of the body state, so
+// workers never write to the same memory. Impulses are reported afterwards in
+// island order so the results do not depend on the number of workers.
+void b2World::SolveIslandsParallel(const b2TimeStep& step)
+{
+	b2Assert(m_taskExecutor->GetWorkerCount() == m_workerCount);
+
+	b2Timer timer;
+
+	// Clear all the island flags and give every body a state slot.
+	int32 slotCount = 0;
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		b->m_flags &= ~b2Body::e_islandFlag;
+		b->m_islandIndex = slotCount++;
+	}
+	for (b2Contact* c = m_contactManager.m_contactList; c; c = c->m_next)
+	{
+		c->m_flags &= ~b2Contact::e_islandFlag;
+	}
+	for (b2Joint* j = m_jointList; j; j = j->m_next)
+	{
+		j->m_islandFlag = false;
+	}
+
+	b2Body** bodies = (b2Body**)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2Body*));
+	b2Contact** contacts = (b2Contact**)m_stackAllocator.Allocate(m_contactManager.m_contactCount * sizeof(b2Contact*));
+	b2Joint** joints = (b2Joint**)m_stackAllocator.Allocate(m_jointCount * sizeof(b2Joint*));
+	b2IslandRange* islands = (b2IslandRange*)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2IslandRange));
+	int32 bodyCount = 0;
+	int32 contactCount = 0;
+	int32 jointCount = 0;
+	int32 islandCount = 0;
+
+	// Build all awake islands in the same order as SolveIslands().
+	int32 stackSize = m_bodyCount;
+	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
+	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+	{
+		if (seed->m_flags & b2Body::e_islandFlag)
+		{
+			continue;
+		}
+
+		if (seed->IsAwake() == false || seed->IsActive() == false)
+		{
+			continue;
+		}
+
+		// The seed can be dynamic or kinematic.
+		if (seed->GetType() == b2_staticBody)
+		{
+			continue;
+		}
+
+		b2IslandRange& range = islands[islandCount++];
+		range.bodyStart = bodyCount;
+		range.contactStart = contactCount;
+		range.jointStart = jointCount;
+
+		int32 stackCount = 0;
+		stack[stackCount++] = seed;
+		seed->m_flags |= b2Body::e_islandFlag;
+
+		// Perform a depth first search (DFS) on the constraint graph.
+		while (stackCount > 0)
+		{
+			// Grab the next body off the stack and add it to the island.
+			b2Body* b = stack[--stackCount];
+			b2Assert(b->IsActive() == true);
+			b2Assert(b->GetType() != b2_staticBody);
+			bodies[bodyCount++] = b;
+
+			// Make sure the body is awake.
+			b->SetAwake(true);
+
+			// Search all contacts connected to this body.
+			for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
 			{
-				continue;
+				b2Contact* contact = ce->contact;
+
+				// Has this contact already been added to an island?
+				if (contact->m_flags & b2Contact::e_islandFlag)
+				{
+					continue;
+				}
+
+				// Is this contact solid and touching?
+				if (contact->IsEnabled() == false ||
+					contact->IsTouching() == false)
+				{
+					continue;
+				}
+
+				// Skip sensors.
+				bool sensorA = contact->m_fixtureA->m_isSensor;
+				bool sensorB = contact->m_fixtureB->m_isSensor;
+				if (sensorA || sensorB)
+				{
+					continue;
+				}
+
+				contacts[contactCount++] = contact;
+				contact->m_flags |= b2Contact::e_islandFlag;
+
+				b2Body* other = ce->other;
+
+				// Was the other body already added to this island?
+				// Static bodies are shared and never become members.
+				if ((other->m_flags & b2Body::e_islandFlag) || other->GetType() == b2_staticBody)
+				{
+					continue;
+				}
+
+				b2Assert(stackCount < stackSize);
+				stack[stackCount++] = other;
+				other->m_flags |= b2Body::e_islandFlag;
 			}
 
-			// Update fixtures (for broad-phase).
-			b->SynchronizeFixtures();
+			// Search all joints connect to this body.
+			for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+			{
+				if (je->joint->m_islandFlag == true)
+				{
+					continue;
+				}
+
+				b2Body* other = je->other;
+
+				// Don't simulate joints connected to inactive bodies.
+				if (other->IsActive() == false)
+				{
+					continue;
+				}
+
+				joints[jointCount++] = je->joint;
+				je->joint->m_islandFlag = true;
+
+				if ((other->m_flags & b2Body::e_islandFlag) || other->GetType() == b2_staticBody)
+				{
+					continue;
+				}
+
+				b2Assert(stackCount < stackSize);
+				stack[stackCount++] = other;
+				other->m_flags |= b2Body::e_islandFlag;
+			}
 		}
 
-		// Look for new contacts.
-		m_contactManager.FindNewContacts();
-		m_profile.broadphase = timer.GetMilliseconds();
+		range.bodyCount = bodyCount - range.bodyStart;
+		range.contactCount = contactCount - range.contactStart;
+		range.jointCount = jointCount - range.jointStart;
+
+		// The contact solver must fit in a worker allocator because b2Alloc() is
+		// not thread safe. Larger islands are solved on this thread afterwards.
+		range.solveOnWorker = b2ContactSolver::GetAllocationSize(range.contactCount) <= b2_stackSize;
+	}
+
+	m_stackAllocator.Free(stack);
+
+	m_profile.findIslands = timer.GetMilliseconds();
+	m_profile.islandCount = islandCount;
+	timer.Reset();
+
+	// Every worker has a copy of the body state so it grows with the world and
+	// comes from the heap rather than the fixed size stack allocator. It is kept
+	// between steps.
+	if (slotCount > m_workerSlotCapacity)
+	{
+		if (m_workerPositions)
+		{
+			b2Free(m_workerPositions);
+			b2Free(m_workerVelocities);
+		}
+		m_workerSlotCapacity = b2Max(slotCount, 2 * m_workerSlotCapacity);
+		m_workerPositions = (b2Position*)b2Alloc(m_workerCount * m_workerSlotCapacity * sizeof(b2Position));
+		m_workerVelocities = (b2Velocity*)b2Alloc(m_workerCount * m_workerSlotCapacity * sizeof(b2Velocity));
+	}
+
+	b2Profile* profiles = (b2Profile*)m_stackAllocator.Allocate(islandCount * sizeof(b2Profile));
+	b2Position* positions = m_workerPositions;
+	b2Velocity* velocities = m_workerVelocities;
+
+	b2IslandSolveTask task;
+	task.islands = islands;
+	task.bodies = bodies;
+	task.contacts = contacts;
+	task.joints = joints;
+	task.positions = positions;
+	task.velocities = velocities;
+	task.slotCount = m_workerSlotCapacity;
+	task.allocators = m_workerAllocators;
+	task.profiles = profiles;
+	task.step = &step;
+	task.gravity = m_gravity;
+	task.allowSleep = m_allowSleep;
+	m_taskExecutor->ParallelFor(&task, islandCount);
+
+	// Solve the large islands on this thread.
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		const b2IslandRange& range = islands[i];
+		if (range.solveOnWorker)
+		{
+			continue;
+		}
+
+		b2Island island(bodies + range.bodyStart, range.bodyCount,
+						contacts + range.contactStart, range.contactCount,
+						joints + range.jointStart, range.jointCount,
+						positions, velocities,
+						&m_stackAllocator);
+		island.Solve(profiles + i, step, m_gravity, m_allowSleep);
 	}
-}
 
+	m_profile.solveIslands = timer.GetMilliseconds();
+
+	// Report and profile in island order.
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		const b2IslandRange& range = islands[i];
+		m_profile.solveInit += profiles[i].solveInit;
+		m_profile.solveVelocity += profiles[i].solveVelocity;
+		m_profile.solvePosition += profiles[i].solvePosition;
+
+		b2Island island(bodies + range.bodyStart, range.bodyCount,
+						contacts + range.contactStart, range.contactCount,
+						joints + range.jointStart, range.jointCount,
+						positions, velocities,
+						&m_stackAllocator);
+		island.ReportStoredImpulses(m_contactManager.m_contactListener);
+	}
+
+	m_stackAllocator.Free(profiles);
+	m_stackAllocator.Free(islands);
+	m_stackAllocator.Free(joints);
+	m_stackAllocator.Free(contacts);
+	m_stackAllocator.Free(bodies);
+}
 // Find TOI contacts and solve them.
 void b2World::SolveTOI(const b2TimeStep& step)
 {
@@ -1023,6 +1387,7 @@ void b2World::Step(
 		{
 			p->Solve(step); // Particle Simulation
 		}
+		m_profile.solveParticles = timer.GetMilliseconds();
 		Solve(step);
 		m_profile.solve = timer.GetMilliseconds();
 	}
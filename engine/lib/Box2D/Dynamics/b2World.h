@@ -37,6 +37,7 @@ class b2Draw;
 class b2Fixture;
 class b2Joint;
 class b2ParticleGroup;
+class b2TaskExecutor;
 
 /// The world class manages all physics entities, dynamic simulation,
 /// and asynchronous queries. The world also contains efficient memory
@@ -211,6 +212,13 @@ public:
 	void SetSubStepping(bool flag) { m_subStepping = flag; }
 	bool GetSubStepping() const { return m_subStepping; }
 
+	/// Set a task executor to solve islands and update contacts on several threads.
+	/// The results do not depend on the number of workers. The executor is owned
+	/// by you, must remain in scope and must keep the same worker count while set.
+	/// Pass NULL to solve on the calling thread.
+	void SetTaskExecutor(b2TaskExecutor* executor);
+	b2TaskExecutor* GetTaskExecutor() const { return m_taskExecutor; }
+
 	/// Get the number of broad-phase proxies.
 	int32 GetProxyCount() const;
 
@@ -301,6 +309,8 @@ private:
 	void Init(const b2Vec2& gravity);
 
 	void Solve(const b2TimeStep& step);
+	void SolveIslands(const b2TimeStep& step);
+	void SolveIslandsParallel(const b2TimeStep& step);
 	void SolveTOI(const b2TimeStep& step);
 
 	void DrawJoint(b2Joint* joint);
@@ -311,6 +321,13 @@ private:
 	b2BlockAllocator m_blockAllocator;
 	b2StackAllocator m_stackAllocator;
 
+	b2TaskExecutor* m_taskExecutor;
+	b2StackAllocator* m_workerAllocators;
+	int32 m_workerCount;
+	b2Position* m_workerPositions;
+	b2Velocity* m_workerVelocities;
+	int32 m_workerSlotCapacity;
+
 	int32 m_flags;
 
 	b2ContactManager m_contactManager;
@@ -32,6 +32,10 @@
 #include "graphics/gBitmap.h"
 #endif
 
+#ifndef _TEXT_LAYOUT_CACHE_H_
+#include "graphics/TextLayoutCache.h"
+#endif
+
 #ifndef _UTILITY_H_
 #include "2d/core/Utility.h"
 #endif
@@ -106,7 +110,8 @@ FontAsset::FontAsset() :    mFontFile(StringTable->EmptyString),
 
 FontAsset::~FontAsset()
 {
-    
+    // Drop any text laid out with this font.
+    TextLayoutCache::purgeFont( this );
 }
 
 //------------------------------------------------------------------------------
@@ -217,6 +222,9 @@ void FontAsset::buildFontData( void )
       return;
    }
 
+   // Drop any text laid out with the previous font data.
+   TextLayoutCache::purgeFont( this );
+
    mBitmapFont.mPageName.clear();
    mBitmapFont.parseFont(fStream);
 
@@ -62,7 +62,8 @@ IMPLEMENT_CONOBJECT(LevelAsset);
 LevelAsset::LevelAsset() : mLevelName(StringTable->EmptyString),
                            mLevelFile(StringTable->EmptyString),
                            mDescription(StringTable->EmptyString),
-                           mPreviewImage(StringTable->EmptyString)
+                           mPreviewImage(StringTable->EmptyString),
+                           mStreamingIndex(StringTable->EmptyString)
 {
    //
 }
@@ -81,6 +82,7 @@ void LevelAsset::initPersistFields()
    addProtectedField("LevelFile", TypeAssetLooseFilePath, Offset(mLevelFile, LevelAsset), &setLevelFile, &getLevelFile, &defaultProtectedWriteFn, "");
    addProtectedField("Description", TypeAssetLooseFilePath, Offset(mDescription, LevelAsset), &setDescription, &getDescription, &defaultProtectedWriteFn, "");
    addProtectedField("PreviewImage", TypeAssetLooseFilePath, Offset(mPreviewImage, LevelAsset), &setPreviewImage, &getPreviewImage, &defaultProtectedWriteFn, "");
+   addProtectedField("StreamingIndex", TypeAssetLooseFilePath, Offset(mStreamingIndex, LevelAsset), &setStreamingIndex, &getStreamingIndex, &writeStreamingIndex, "The index file of the level's streaming cells, if any.");
 }
 
 bool LevelAsset::onAdd()
@@ -114,6 +116,7 @@ void LevelAsset::copyTo(SimObject * object)
    pAsset->setLevelFile(getLevelFile());
    pAsset->setDescription(getDescription());
    pAsset->setPreviewImage(getPreviewImage());
+   pAsset->setStreamingIndex(getStreamingIndex());
 }
 
 void LevelAsset::setLevelName(const char * pLevelName)
@@ -192,6 +195,24 @@ void LevelAsset::setPreviewImage(const char * pPreviewImage)
 
 }
 
+void LevelAsset::setStreamingIndex(const char * pStreamingIndex)
+{
+   // Sanity!
+   AssertFatal(pStreamingIndex != NULL, "Cannot use a NULL streaming index file.");
+
+   pStreamingIndex = StringTable->insert(pStreamingIndex);
+
+   // Ignore no change,
+   if (pStreamingIndex == mStreamingIndex)
+      return;
+
+   // Update.
+   mStreamingIndex = getOwned() ? expandAssetFilePath(pStreamingIndex) : StringTable->insert(pStreamingIndex);
+
+   // Refresh the asset.
+   refreshAsset();
+}
+
 void LevelAsset::initializeAsset(void)
 {
    // Call parent.
@@ -206,6 +227,12 @@ void LevelAsset::initializeAsset(void)
       mPreviewImage = expandAssetFilePath(mPreviewImage);
    }
 
+   if (mStreamingIndex != StringTable->EmptyString)
+   {
+      // Ensure the streaming index file is expanded.
+      mStreamingIndex = expandAssetFilePath(mStreamingIndex);
+   }
+
 }
 
 void LevelAsset::onAssetRefresh(void)
@@ -23,6 +23,7 @@ private:
    StringTableEntry     mLevelFile;
    StringTableEntry     mDescription;
    StringTableEntry     mPreviewImage;
+   StringTableEntry     mStreamingIndex;
 
 public:
    LevelAsset();
@@ -46,6 +47,9 @@ public:
    void                    setPreviewImage(const char* pPreviewImage);
    inline StringTableEntry getPreviewImage(void) const { return mPreviewImage; };
 
+   void                    setStreamingIndex(const char* pStreamingIndex);
+   inline StringTableEntry getStreamingIndex(void) const { return mStreamingIndex; };
+
    /// Declare Console Object.
    DECLARE_CONOBJECT(LevelAsset);
    
@@ -69,6 +73,10 @@ protected:
    static const char* getPreviewImage(void* obj, const char* data) { return static_cast<LevelAsset*>(obj)->getPreviewImage(); }
    static bool writePreviewImage(void* obj, StringTableEntry pFieldName) { return static_cast<LevelAsset*>(obj)->getPreviewImage() != StringTable->EmptyString; }
 
+   static bool setStreamingIndex(void* obj, const char* data) { static_cast<LevelAsset*>(obj)->setStreamingIndex(data); return false; }
+   static const char* getStreamingIndex(void* obj, const char* data) { return static_cast<LevelAsset*>(obj)->getStreamingIndex(); }
+   static bool writeStreamingIndex(void* obj, StringTableEntry pFieldName) { return static_cast<LevelAsset*>(obj)->getStreamingIndex() != StringTable->EmptyString; }
+
 };
 
 
@@ -54,4 +54,18 @@ ConsoleMethodWithDocs(LevelAsset, setPreviewImage, ConsoleVoid, 3, 3, (PreviewIm
 ConsoleMethodWithDocs(LevelAsset, getPreviewImage, ConsoleString, 2, 2, ())
 {
    return object->getPreviewImage();
-}
\ No newline at end of file
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethodWithDocs(LevelAsset, setStreamingIndex, ConsoleVoid, 3, 3, (StreamingIndex))
+{
+   object->setStreamingIndex(argv[2]);
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethodWithDocs(LevelAsset, getStreamingIndex, ConsoleString, 2, 2, ())
+{
+   return object->getStreamingIndex();
+}
@@ -312,6 +312,105 @@ void BatchRender::SubmitQuad(
 
 //-----------------------------------------------------------------------------
 
+void BatchRender::SubmitQuads(
+        const U32 quadCount,
+        const Vector2* pVertexArray,
+        const Vector2* pTextureArray,
+        const ColorF* pColorArray,
+        TextureHandle& texture )
+{
+    // Sanity!
+    AssertFatal( mpDebugStats != NULL, "Debug stats have not been configured." );
+
+    // Debug Profiling.
+    PROFILE_SCOPE(BatchRender_SubmitQuads);
+
+    // Flush if we have a batch without explicit colors.
+    if ( mTriangleCount > 0 && mColorCount == 0 )
+        flush( mpDebugStats->batchColorStateFlush );
+
+    // Flush if there is a texture change in strict order mode.
+    if ( mStrictOrderMode && texture != mStrictOrderTextureHandle && mTriangleCount > 0 )
+        flush( mpDebugStats->batchTextureChangeFlush );
+
+    U32 quadsRemaining = quadCount;
+
+    while( quadsRemaining > 0 )
+    {
+        // Calculate how many quads will fit in the batch.
+        U32 quadsAvailable = (BATCHRENDER_MAXTRIANGLES - mTriangleCount) / 2;
+
+        // Flush if no room.
+        if ( quadsAvailable == 0 )
+        {
+            flush( mpDebugStats->batchBufferFullFlush );
+            quadsAvailable = BATCHRENDER_MAXTRIANGLES / 2;
+        }
+
+        const U32 runCount = getMin( quadsRemaining, quadsAvailable );
+
+        // Strict order mode?
+        if ( mStrictOrderMode )
+        {
+            // Yes, so add new indices.
+            U16 vertexIndex = (U16)mVertexCount;
+            for( U32 n = 0; n < runCount; ++n, vertexIndex += 4 )
+            {
+                mIndexBuffer[mIndexCount++] = vertexIndex;
+                mIndexBuffer[mIndexCount++] = vertexIndex+1;
+                mIndexBuffer[mIndexCount++] = vertexIndex+2;
+                mIndexBuffer[mIndexCount++] = vertexIndex+3;
+                mIndexBuffer[mIndexCount++] = vertexIndex+2;
+                mIndexBuffer[mIndexCount++] = vertexIndex+1;
+            }
+
+            // Set strict order mode texture handle.
+            mStrictOrderTextureHandle = texture;
+        }
+        else
+        {
+            // No, so add a single triangle run for all the quads.
+            findTextureBatch( texture )->push_back( TriangleRun( TriangleRun::QUAD, runCount, mVertexCount ) );
+        }
+
+        // Add colored and textured vertices.
+        // NOTE: We swap #2/#3 here.
+        for( U32 n = 0; n < runCount; ++n )
+        {
+            const ColorF& color = *(pColorArray++);
+            mColorBuffer[mColorCount++] = color;
+            mColorBuffer[mColorCount++] = color;
+            mColorBuffer[mColorCount++] = color;
+            mColorBuffer[mColorCount++] = color;
+
+            mVertexBuffer[mVertexCount++] = pVertexArray[0];
+            mVertexBuffer[mVertexCount++] = pVertexArray[1];
+            mVertexBuffer[mVertexCount++] = pVertexArray[3];
+            mVertexBuffer[mVertexCount++] = pVertexArray[2];
+            mTextureBuffer[mTextureCoordCount++] = pTextureArray[0];
+            mTextureBuffer[mTextureCoordCount++] = pTextureArray[1];
+            mTextureBuffer[mTextureCoordCount++] = pTextureArray[3];
+            mTextureBuffer[mTextureCoordCount++] = pTextureArray[2];
+            pVertexArray += 4;
+            pTextureArray += 4;
+        }
+
+        // Stats.
+        mpDebugStats->batchTrianglesSubmitted += runCount * 2;
+
+        // Increase triangle count.
+        mTriangleCount += runCount * 2;
+
+        quadsRemaining -= runCount;
+
+        // Flush immediately if batching is disabled.
+        if ( !mBatchEnabled )
+            flushInternal();
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 void BatchRender::flush( U32& reasonMetric )
 {
     // Finish if no triangles to flush.
@@ -474,6 +573,9 @@ void BatchRender::flushInternal( void )
                         mIndexBuffer[mIndexCount++] = triangleIndex--;
                         mIndexBuffer[mIndexCount++] = triangleIndex--;
                         mIndexBuffer[mIndexCount++] = triangleIndex--;
+
+                        // Move to the next quad.
+                        triangleIndex += 4;
                     }
                 }
                 else if ( primitiveMode == TriangleRun::TRIANGLE )
@@ -252,6 +252,15 @@ public:
             TextureHandle& texture,
             const ColorF& color = ColorF(-1.0f, -1.0f, -1.0f) );
 
+    /// Submit a run of quads sharing a texture for batching.
+    /// Each quad uses four vertices and texture coordinates ordered as SubmitQuad() and a single color.
+    void SubmitQuads(
+            const U32 quadCount,
+            const Vector2* pVertexArray,
+            const Vector2* pTextureArray,
+            const ColorF* pColorArray,
+            TextureHandle& texture );
+
     /// Render a quad immediately without affecting current batch.
     /// All render state should be set beforehand directly.
     /// Vertex and textures are indexed as:
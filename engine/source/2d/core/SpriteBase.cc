@@ -71,6 +71,33 @@ void SpriteBase::integrateObject( const F32 totalTime, const F32 elapsedTime, De
     ImageFrameProvider::update( elapsedTime );
 }
 
+//-----------------------------------------------------------------------------
+
+SceneObject::TickState SpriteBase::getTickState( void )
+{
+    // Fetch parent tick state.
+    const TickState tickState = Parent::getTickState();
+
+    // Finish if the parent has work or we're not in a scene.
+    if ( tickState == TickRequired || getScene() == NULL || !isEnabled() )
+        return tickState;
+
+    // An animation that has not finished must be updated.
+    return !isStaticFrameProvider() && !isAnimationFinished() ? TickRequired : tickState;
+}
+
+//-----------------------------------------------------------------------------
+
+void SpriteBase::setProcessTicks( bool tick )
+{
+    // Call image frame provider.
+    ImageFrameProvider::setProcessTicks( tick );
+
+    // Starting an animation gives us per-tick work.
+    if ( tick )
+        updateTickState();
+}
+
 //------------------------------------------------------------------------------
 
 bool SpriteBase::validRender( void ) const
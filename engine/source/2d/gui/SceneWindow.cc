@@ -1601,6 +1601,16 @@ void SceneWindow::resetTickCameraPosition( void )
 
 //-----------------------------------------------------------------------------
 
+void SceneWindow::onPreRender( void )
+{
+    // Repaint every frame when attached to a scene.
+    // NOTE: This only matters when the canvas is repainting dirty regions.
+    if ( mpScene != NULL )
+        setUpdate();
+}
+
+//-----------------------------------------------------------------------------
+
 void SceneWindow::onRender( Point2I offset, const RectI& updateRect )
 {
     // Debug Profiling.
@@ -1782,7 +1792,7 @@ void SceneWindow::renderMetricsOverlay( Point2I offset, const RectI& updateRect
     const S32 metricsOffset = (S32)font->getStrWidth( "WWWWWWWWWWWW" );
 
     // Set Banner Height.
-    F32 bannerLineHeight = fullMetrics ? 17.0f : 1.0f;
+    F32 bannerLineHeight = fullMetrics ? 18.25f : 1.0f;
 
     // Add an extra line if we're monitoring a scene object.
     if ( pDebugSceneObject != NULL )
@@ -1822,24 +1832,26 @@ void SceneWindow::renderMetricsOverlay( Point2I offset, const RectI& updateRect
     {
         // Rendering.
         dglDrawText( font, bannerOffset + Point2I(0,(S32)linePositionY), "Render", NULL );
-        dSprintf( mDebugText, sizeof( mDebugText ), "- FPS=%4.1f<%4.1f/%4.1f>, Frames=%u, Picked=%d<%d>, RenderRequests=%d<%d>, RenderFallbacks=%d<%d>",
+        dSprintf( mDebugText, sizeof( mDebugText ), "- FPS=%4.1f<%4.1f/%4.1f>, Frames=%u, Picked=%d<%d>, RenderRequests=%d<%d>, RenderFallbacks=%d<%d>, Lightweight=%d<%d>",
             debugStats.fps, debugStats.minFPS, debugStats.maxFPS,
             debugStats.frameCount,
             debugStats.renderPicked, debugStats.maxRenderPicked,
             debugStats.renderRequests, debugStats.maxRenderRequests,
-            debugStats.renderFallbacks, debugStats.maxRenderFallbacks );
+            debugStats.renderFallbacks, debugStats.maxRenderFallbacks,
+            debugStats.renderLightweightSprites, debugStats.maxRenderLightweightSprites );
         dglDrawText( font, bannerOffset + Point2I(metricsOffset,(S32)linePositionY), mDebugText, NULL );
         linePositionY += linePositionOffsetY;
 
         // Scene.
         dglDrawText( font, bannerOffset + Point2I(0,(S32)linePositionY), "Scene", NULL );
-        dSprintf( mDebugText, sizeof( mDebugText ), "- Count=%d, Index=%d, Time=%0.1fs, Objects=%d<%d>(Global=%d), Enabled=%d<%d>, Visible=%d<%d>, Awake=%d<%d>, Controllers=%d",
+        dSprintf( mDebugText, sizeof( mDebugText ), "- Count=%d, Index=%d, Time=%0.1fs, Objects=%d<%d>(Global=%d), Enabled=%d<%d>, Visible=%d<%d>, Awake=%d<%d>, Ticked=%d<%d>, Controllers=%d",
             Scene::getGlobalSceneCount(), pScene->getSceneIndex(),
             pScene->getSceneTime(),
             debugStats.objectsCount, debugStats.maxObjectsCount, SceneObject::getGlobalSceneObjectCount(),
             debugStats.objectsEnabled, debugStats.maxObjectsEnabled,
             debugStats.objectsVisible, debugStats.maxObjectsVisible,
             debugStats.objectsAwake, debugStats.maxObjectsAwake,
+            debugStats.objectsTicked, debugStats.maxObjectsTicked,
             pScene->getControllers() == NULL ? 0 : pScene->getControllers()->size() );        
         dglDrawText( font, bannerOffset + Point2I(metricsOffset,(S32)linePositionY), mDebugText, NULL );
         linePositionY += linePositionOffsetY;
@@ -1949,6 +1961,16 @@ void SceneWindow::renderMetricsOverlay( Point2I offset, const RectI& updateRect
         dglDrawText( font, bannerOffset + Point2I(metricsOffset,(S32)linePositionY), mDebugText, NULL );
         linePositionY += linePositionOffsetY;
 
+        // Physics timings #3.
+        dSprintf( mDebugText, sizeof( mDebugText ), "- Islands=%d<%d>, FindIslands=%0.0f<%0.0f>, SolveIslands=%0.0f<%0.0f>, SolveParticles=%0.0f<%0.0f>, Workers=%d",
+            worldProfile.islandCount, maxWorldProfile.islandCount,
+            worldProfile.findIslands, maxWorldProfile.findIslands,
+            worldProfile.solveIslands, maxWorldProfile.solveIslands,
+            worldProfile.solveParticles, maxWorldProfile.solveParticles,
+            debugStats.physicsWorkerCount );
+        dglDrawText( font, bannerOffset + Point2I(metricsOffset,(S32)linePositionY), mDebugText, NULL );
+        linePositionY += linePositionOffsetY;
+
         // Physics spatial tree.
         dglDrawText( font, bannerOffset + Point2I(0,(S32)linePositionY), "Partition", NULL );
         const b2World* pWorld = pScene->getWorld();
@@ -298,7 +298,9 @@ public:
 
     /// GuiControl
     virtual void resize(const Point2I &newPosition, const Point2I &newExtent);
+    virtual void onPreRender( void );
     virtual void onRender( Point2I offset, const RectI& updateRect );
+    virtual bool isBatchRendered( void ) { return false; }
 
     virtual void onTouchEnter( const GuiEvent& event );
     virtual void onTouchLeave( const GuiEvent& event );
@@ -214,6 +214,15 @@ void GuiSceneObjectCtrl::onMouseDragged( const GuiEvent &event )
    Parent::onTouchDragged( event );
 }
 
+// -----------------------------------------------------------------------------
+// Repaint every frame while showing a Scene Object as it may be animated.
+// -----------------------------------------------------------------------------
+void GuiSceneObjectCtrl::onPreRender()
+{
+   if( !mSelectedSceneObject.isNull() )
+      setUpdate();
+}
+
 // -----------------------------------------------------------------------------
 // Render any selected Scene Object.
 // -----------------------------------------------------------------------------
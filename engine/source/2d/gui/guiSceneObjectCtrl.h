@@ -72,7 +72,9 @@ public:
     bool onWake();
     void onSleep();
     void inspectPostApply();
+    void onPreRender();
     void onRender(Point2I offset, const RectI &updateRect);
+    bool isBatchRendered() { return false; }
 
     void onMouseEnter(const GuiEvent &event);
     void onMouseLeave(const GuiEvent &event);
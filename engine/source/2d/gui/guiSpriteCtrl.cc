@@ -154,6 +154,10 @@ void GuiSpriteCtrl::onSleep()
 
 void GuiSpriteCtrl::processTick(void)
 {
+	// Repaint while animating.
+	if ( !isStaticFrameProvider() && !isAnimationFinished() )
+		setUpdate();
+
 	// Update using tick period.
 	update(Tickable::smTickSec);
 }
@@ -73,11 +73,13 @@ public:
         if ( objectsEnabled > maxObjectsEnabled ) maxObjectsEnabled = objectsEnabled;
         if ( objectsVisible > maxObjectsVisible ) maxObjectsVisible = objectsVisible;
         if ( objectsAwake > maxObjectsAwake ) maxObjectsAwake = objectsAwake;
+        if ( objectsTicked > maxObjectsTicked ) maxObjectsTicked = objectsTicked;
 
         // Render pick/requests.
         if ( renderPicked > maxRenderPicked ) maxRenderPicked = renderPicked;
         if ( renderRequests > maxRenderRequests ) maxRenderRequests = renderRequests;
         if ( renderFallbacks > maxRenderFallbacks ) maxRenderFallbacks = renderFallbacks;
+        if ( renderLightweightSprites > maxRenderLightweightSprites ) maxRenderLightweightSprites = renderLightweightSprites;
 
         // Batching.
         if ( batchTrianglesSubmitted > maxBatchTrianglesSubmitted ) maxBatchTrianglesSubmitted = batchTrianglesSubmitted;
@@ -106,6 +108,10 @@ public:
         if ( worldProfile.solvePosition > maxWorldProfile.solvePosition ) maxWorldProfile.solvePosition = worldProfile.solvePosition;
         if ( worldProfile.broadphase > maxWorldProfile.broadphase ) maxWorldProfile.broadphase = worldProfile.broadphase;
         if ( worldProfile.solveTOI > maxWorldProfile.solveTOI ) maxWorldProfile.solveTOI = worldProfile.solveTOI;
+        if ( worldProfile.findIslands > maxWorldProfile.findIslands ) maxWorldProfile.findIslands = worldProfile.findIslands;
+        if ( worldProfile.solveIslands > maxWorldProfile.solveIslands ) maxWorldProfile.solveIslands = worldProfile.solveIslands;
+        if ( worldProfile.islandCount > maxWorldProfile.islandCount ) maxWorldProfile.islandCount = worldProfile.islandCount;
+        if ( worldProfile.solveParticles > maxWorldProfile.solveParticles ) maxWorldProfile.solveParticles = worldProfile.solveParticles;
     }
 
     /// Reset debug stats.
@@ -123,6 +129,9 @@ public:
         objectsAwake = 0;
         maxObjectsAwake = 0;
 
+        objectsTicked = 0;
+        maxObjectsTicked = 0;
+
         renderPicked = 0;
         maxRenderPicked = 0;
 
@@ -132,6 +141,9 @@ public:
         renderFallbacks = 0;
         maxRenderFallbacks = 0;
 
+        renderLightweightSprites = 0;
+        maxRenderLightweightSprites = 0;
+
         bodyCount = 0;
         maxBodyCount = 0;
 
@@ -144,6 +156,8 @@ public:
         proxyCount = 0;
         maxProxyCount = 0;
 
+        physicsWorkerCount = 1;
+
         batchTrianglesSubmitted = 0;
         maxBatchTrianglesSubmitted = 0;
 
@@ -213,6 +227,9 @@ public:
     U32     objectsAwake;
     U32     maxObjectsAwake;
 
+    U32     objectsTicked;
+    U32     maxObjectsTicked;
+
     U32     renderPicked;
     U32     maxRenderPicked;
 
@@ -222,6 +239,9 @@ public:
     U32     renderFallbacks;
     U32     maxRenderFallbacks;
 
+    U32     renderLightweightSprites;
+    U32     maxRenderLightweightSprites;
+
     U32     bodyCount;
     U32     maxBodyCount;
 
@@ -234,6 +254,8 @@ public:
     U32     proxyCount;
     U32     maxProxyCount;
 
+    U32     physicsWorkerCount;
+
     U32     batchTrianglesSubmitted;
     U32     maxBatchTrianglesSubmitted;
 
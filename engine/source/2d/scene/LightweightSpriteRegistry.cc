@@ -0,0 +1,561 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "LightweightSpriteRegistry.h"
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define LIGHTWEIGHT_SPRITE_SSE
+#endif
+
+//-----------------------------------------------------------------------------
+
+LightweightSpriteRegistry::LightweightSpriteRegistry() :
+    mSpriteCount( 0 )
+{
+    // Set Vector Associations.
+    VECTOR_SET_ASSOCIATION( mSlots );
+    VECTOR_SET_ASSOCIATION( mFreeSlots );
+    VECTOR_SET_ASSOCIATION( mQuadVertices );
+    VECTOR_SET_ASSOCIATION( mQuadTexels );
+    VECTOR_SET_ASSOCIATION( mQuadColors );
+}
+
+//-----------------------------------------------------------------------------
+
+LightweightSpriteRegistry::~LightweightSpriteRegistry()
+{
+    clear();
+}
+
+//-----------------------------------------------------------------------------
+
+LightweightSpriteRegistry::SpriteId LightweightSpriteRegistry::createSprite(
+    const char* pImageAssetId,
+    const U32 frame,
+    const Vector2& position,
+    const Vector2& size,
+    const F32 angle,
+    const ColorF& color,
+    const U32 layer )
+{
+    // Sanity!
+    AssertFatal( pImageAssetId != NULL, "LightweightSpriteRegistry::createSprite() - Cannot use a NULL image asset Id." );
+
+    // Is the layer valid?
+    if ( layer >= MAX_LAYERS_SUPPORTED )
+    {
+        // No, so warn.
+        Con::warnf( "LightweightSpriteRegistry::createSprite() - Invalid layer '%d'.", layer );
+        return InvalidSpriteId;
+    }
+
+    // Find the group.
+    SpriteGroup* pGroup = findGroup( layer, pImageAssetId, true, "createSprite" );
+
+    // Finish if no group.
+    if ( pGroup == NULL )
+        return InvalidSpriteId;
+
+    // Fetch a free slot.
+    U32 slotIndex;
+    if ( mFreeSlots.size() > 0 )
+    {
+        slotIndex = mFreeSlots.last();
+        mFreeSlots.pop_back();
+    }
+    else
+    {
+        slotIndex = (U32)mSlots.size();
+        mSlots.increment();
+    }
+
+    // Sprite Ids are one-based so that zero can be invalid.
+    const SpriteId spriteId = slotIndex + 1;
+
+    // Configure the slot.
+    SpriteSlot& slot = mSlots[slotIndex];
+    slot.mpGroup = pGroup;
+    slot.mIndex = pGroup->size();
+
+    // Add the packed sprite state.
+    pGroup->mPositionX.push_back( position.x );
+    pGroup->mPositionY.push_back( position.y );
+    pGroup->mHalfWidth.push_back( size.x * 0.5f );
+    pGroup->mHalfHeight.push_back( size.y * 0.5f );
+    pGroup->mCos.push_back( mCos( angle ) );
+    pGroup->mSin.push_back( mSin( angle ) );
+    pGroup->mAngle.push_back( angle );
+    pGroup->mFrame.push_back( frame );
+    pGroup->mColor.push_back( color );
+    pGroup->mSpriteIds.push_back( spriteId );
+
+    mSpriteCount++;
+
+    return spriteId;
+}
+
+//-----------------------------------------------------------------------------
+
+bool LightweightSpriteRegistry::removeSprite( const SpriteId spriteId )
+{
+    // Find the slot.
+    SpriteSlot* pSlot = findSlot( spriteId );
+
+    // Finish if not found.
+    if ( pSlot == NULL )
+        return false;
+
+    SpriteGroup& group = *pSlot->mpGroup;
+    const U32 index = pSlot->mIndex;
+    const U32 lastIndex = group.size() - 1;
+
+    // Move the last sprite into the vacated position.
+    if ( index != lastIndex )
+    {
+        group.mPositionX[index]  = group.mPositionX[lastIndex];
+        group.mPositionY[index]  = group.mPositionY[lastIndex];
+        group.mHalfWidth[index]  = group.mHalfWidth[lastIndex];
+        group.mHalfHeight[index] = group.mHalfHeight[lastIndex];
+        group.mCos[index]        = group.mCos[lastIndex];
+        group.mSin[index]        = group.mSin[lastIndex];
+        group.mAngle[index]      = group.mAngle[lastIndex];
+        group.mFrame[index]      = group.mFrame[lastIndex];
+        group.mColor[index]      = group.mColor[lastIndex];
+        group.mSpriteIds[index]  = group.mSpriteIds[lastIndex];
+
+        // Update the moved sprites slot.
+        mSlots[group.mSpriteIds[index]-1].mIndex = index;
+    }
+
+    group.mPositionX.pop_back();
+    group.mPositionY.pop_back();
+    group.mHalfWidth.pop_back();
+    group.mHalfHeight.pop_back();
+    group.mCos.pop_back();
+    group.mSin.pop_back();
+    group.mAngle.pop_back();
+    group.mFrame.pop_back();
+    group.mColor.pop_back();
+    group.mSpriteIds.pop_back();
+
+    // Release the slot.
+    pSlot->mpGroup = NULL;
+    mFreeSlots.push_back( spriteId - 1 );
+
+    mSpriteCount--;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void LightweightSpriteRegistry::clear( void )
+{
+    // Delete all groups.
+    for ( U32 layer = 0; layer < MAX_LAYERS_SUPPORTED; ++layer )
+    {
+        typeSpriteGroupVector& groups = mLayerGroups[layer];
+
+        for ( typeSpriteGroupVector::iterator groupItr = groups.begin(); groupItr != groups.end(); ++groupItr )
+        {
+            delete *groupItr;
+        }
+
+        groups.clear();
+        mLayerGroupIndex[layer].clear();
+    }
+
+    mSlots.clear();
+    mFreeSlots.clear();
+    mSpriteCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+bool LightweightSpriteRegistry::setPosition( const SpriteId spriteId, const Vector2& position )
+{
+    SpriteSlot* pSlot = findSlot( spriteId );
+
+    if ( pSlot == NULL )
+        return false;
+
+    pSlot->mpGroup->mPositionX[pSlot->mIndex] = position.x;
+    pSlot->mpGroup->mPositionY[pSlot->mIndex] = position.y;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+Vector2 LightweightSpriteRegistry::getPosition( const SpriteId spriteId )
+{
+    SpriteSlot* pSlot = findSlot( spriteId );
+
+    if ( pSlot == NULL )
+        return Vector2::getZero();
+
+    return Vector2( pSlot->mpGroup->mPositionX[pSlot->mIndex], pSlot->mpGroup->mPositionY[pSlot->mIndex] );
+}
+
+//-----------------------------------------------------------------------------
+
+bool LightweightSpriteRegistry::setAngle( const SpriteId spriteId, const F32 angle )
+{
+    SpriteSlot* pSlot = findSlot( spriteId );
+
+    if ( pSlot == NULL )
+        return false;
+
+    pSlot->mpGroup->mAngle[pSlot->mIndex] = angle;
+    pSlot->mpGroup->mCos[pSlot->mIndex] = mCos( angle );
+    pSlot->mpGroup->mSin[pSlot->mIndex] = mSin( angle );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+F32 LightweightSpriteRegistry::getAngle( const SpriteId spriteId )
+{
+    SpriteSlot* pSlot = findSlot( spriteId );
+
+    if ( pSlot == NULL )
+        return 0.0f;
+
+    return pSlot->mpGroup->mAngle[pSlot->mIndex];
+}
+
+//-----------------------------------------------------------------------------
+
+bool LightweightSpriteRegistry::setTransform( const SpriteId spriteId, const Vector2& position, const F32 angle )
+{
+    return setPosition( spriteId, position ) && setAngle( spriteId, angle );
+}
+
+//-----------------------------------------------------------------------------
+
+bool LightweightSpriteRegistry::setSize( const SpriteId spriteId, const Vector2& size )
+{
+    SpriteSlot* pSlot = findSlot( spriteId );
+
+    if ( pSlot == NULL )
+        return false;
+
+    pSlot->mpGroup->mHalfWidth[pSlot->mIndex] = size.x * 0.5f;
+    pSlot->mpGroup->mHalfHeight[pSlot->mIndex] = size.y * 0.5f;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+Vector2 LightweightSpriteRegistry::getSize( const SpriteId spriteId )
+{
+    SpriteSlot* pSlot = findSlot( spriteId );
+
+    if ( pSlot == NULL )
+        return Vector2::getZero();
+
+    return Vector2( pSlot->mpGroup->mHalfWidth[pSlot->mIndex] * 2.0f, pSlot->mpGroup->mHalfHeight[pSlot->mIndex] * 2.0f );
+}
+
+//-----------------------------------------------------------------------------
+
+bool LightweightSpriteRegistry::setFrame( const SpriteId spriteId, const U32 frame )
+{
+    SpriteSlot* pSlot = findSlot( spriteId );
+
+    if ( pSlot == NULL )
+        return false;
+
+    pSlot->mpGroup->mFrame[pSlot->mIndex] = frame;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 LightweightSpriteRegistry::getFrame( const SpriteId spriteId )
+{
+    SpriteSlot* pSlot = findSlot( spriteId );
+
+    if ( pSlot == NULL )
+        return 0;
+
+    return pSlot->mpGroup->mFrame[pSlot->mIndex];
+}
+
+//-----------------------------------------------------------------------------
+
+bool LightweightSpriteRegistry::setColor( const SpriteId spriteId, const ColorF& color )
+{
+    SpriteSlot* pSlot = findSlot( spriteId );
+
+    if ( pSlot == NULL )
+        return false;
+
+    pSlot->mpGroup->mColor[pSlot->mIndex] = color;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+ColorF LightweightSpriteRegistry::getColor( const SpriteId spriteId )
+{
+    SpriteSlot* pSlot = findSlot( spriteId );
+
+    if ( pSlot == NULL )
+        return ColorF(1.0f, 1.0f, 1.0f, 1.0f);
+
+    return pSlot->mpGroup->mColor[pSlot->mIndex];
+}
+
+//-----------------------------------------------------------------------------
+
+U32 LightweightSpriteRegistry::renderLayer( const U32 layer, const b2AABB& clipAABB, BatchRender* pBatchRenderer )
+{
+    // Sanity!
+    AssertFatal( layer < MAX_LAYERS_SUPPORTED, "LightweightSpriteRegistry::renderLayer() - Invalid layer." );
+
+    typeSpriteGroupVector& groups = mLayerGroups[layer];
+
+    // Finish if nothing in this layer.
+    if ( groups.size() == 0 )
+        return 0;
+
+    // Debug Profiling.
+    PROFILE_SCOPE(LightweightSpriteRegistry_RenderLayer);
+
+    // Lightweight sprites always use standard alpha-blending.
+    pBatchRenderer->setBlendMode( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+    pBatchRenderer->setAlphaTestMode( -1.0f );
+
+    U32 renderCount = 0;
+
+    for ( typeSpriteGroupVector::iterator groupItr = groups.begin(); groupItr != groups.end(); ++groupItr )
+    {
+        SpriteGroup& group = *(*groupItr);
+
+        // Skip if nothing to render or the image is not usable.
+        if ( group.size() == 0 || group.mImageAsset.isNull() || !group.mImageAsset->isAssetValid() )
+            continue;
+
+        // Generate the visible quads.
+        const U32 quadCount = generateQuads( group, clipAABB );
+
+        // Skip if nothing is visible.
+        if ( quadCount == 0 )
+            continue;
+
+        // Submit the quads in bulk.
+        pBatchRenderer->SubmitQuads(
+            quadCount,
+            mQuadVertices.address(),
+            mQuadTexels.address(),
+            mQuadColors.address(),
+            group.mImageAsset->getImageTexture() );
+
+        renderCount += quadCount;
+    }
+
+    return renderCount;
+}
+
+//-----------------------------------------------------------------------------
+
+void LightweightSpriteRegistry::generateCorners(
+    const U32 count,
+    const F32* pPositionX, const F32* pPositionY,
+    const F32* pHalfWidth, const F32* pHalfHeight,
+    const F32* pCos, const F32* pSin,
+    Vector2* pCorners )
+{
+    U32 index = 0;
+
+#if defined(LIGHTWEIGHT_SPRITE_SSE)
+    // Four sprites at a time.
+    for ( ; index + 4 <= count; index += 4 )
+    {
+        const __m128 px = _mm_loadu_ps( pPositionX + index );
+        const __m128 py = _mm_loadu_ps( pPositionY + index );
+        const __m128 hw = _mm_loadu_ps( pHalfWidth + index );
+        const __m128 hh = _mm_loadu_ps( pHalfHeight + index );
+        const __m128 c  = _mm_loadu_ps( pCos + index );
+        const __m128 s  = _mm_loadu_ps( pSin + index );
+
+        // Rotated half-extents.
+        const __m128 cw = _mm_mul_ps( c, hw );
+        const __m128 sw = _mm_mul_ps( s, hw );
+        const __m128 ch = _mm_mul_ps( c, hh );
+        const __m128 sh = _mm_mul_ps( s, hh );
+
+        // Corner #0 = (-w,-h), #1 = (w,-h), #2 = (w,h), #3 = (-w,h).
+        F32 x[4][4];
+        F32 y[4][4];
+        _mm_storeu_ps( x[0], _mm_add_ps( px, _mm_sub_ps( sh, cw ) ) );
+        _mm_storeu_ps( y[0], _mm_sub_ps( py, _mm_add_ps( sw, ch ) ) );
+        _mm_storeu_ps( x[1], _mm_add_ps( px, _mm_add_ps( cw, sh ) ) );
+        _mm_storeu_ps( y[1], _mm_add_ps( py, _mm_sub_ps( sw, ch ) ) );
+        _mm_storeu_ps( x[2], _mm_add_ps( px, _mm_sub_ps( cw, sh ) ) );
+        _mm_storeu_ps( y[2], _mm_add_ps( py, _mm_add_ps( sw, ch ) ) );
+        _mm_storeu_ps( x[3], _mm_sub_ps( px, _mm_add_ps( cw, sh ) ) );
+        _mm_storeu_ps( y[3], _mm_add_ps( py, _mm_sub_ps( ch, sw ) ) );
+
+        // Interleave into the corner output.
+        Vector2* pOut = pCorners + (index * 4);
+        for ( U32 n = 0; n < 4; ++n )
+        {
+            pOut[0].Set( x[0][n], y[0][n] );
+            pOut[1].Set( x[1][n], y[1][n] );
+            pOut[2].Set( x[2][n], y[2][n] );
+            pOut[3].Set( x[3][n], y[3][n] );
+            pOut += 4;
+        }
+    }
+#endif
+
+    // Remaining sprites.
+    for ( ; index < count; ++index )
+    {
+        const F32 px = pPositionX[index];
+        const F32 py = pPositionY[index];
+        const F32 cw = pCos[index] * pHalfWidth[index];
+        const F32 sw = pSin[index] * pHalfWidth[index];
+        const F32 ch = pCos[index] * pHalfHeight[index];
+        const F32 sh = pSin[index] * pHalfHeight[index];
+
+        Vector2* pOut = pCorners + (index * 4);
+        pOut[0].Set( px - cw + sh, py - sw - ch );
+        pOut[1].Set( px + cw + sh, py + sw - ch );
+        pOut[2].Set( px + cw - sh, py + sw + ch );
+        pOut[3].Set( px - cw - sh, py - sw + ch );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+LightweightSpriteRegistry::SpriteGroup* LightweightSpriteRegistry::findGroup( const U32 layer, const char* pImageAssetId, const bool create, const char* pCallerName )
+{
+    typeSpriteGroupHash& groupIndex = mLayerGroupIndex[layer];
+
+    // Find an existing group.
+    StringTableEntry assetId = StringTable->insert( pImageAssetId );
+    typeSpriteGroupHash::iterator groupItr = groupIndex.find( assetId );
+    if ( groupItr != groupIndex.end() )
+        return groupItr->value;
+
+    // Finish if not creating.
+    if ( !create )
+        return NULL;
+
+    // Create a new group.
+    SpriteGroup* pGroup = new SpriteGroup( layer );
+    pGroup->mImageAsset = pImageAssetId;
+
+    // Is the image valid?
+    if ( pGroup->mImageAsset.isNull() )
+    {
+        // No, so warn.
+        Con::warnf( "LightweightSpriteRegistry::%s() - Could not find image asset '%s'.", pCallerName, pImageAssetId );
+        delete pGroup;
+        return NULL;
+    }
+
+    mLayerGroups[layer].push_back( pGroup );
+    groupIndex.insertUnique( assetId, pGroup );
+
+    return pGroup;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 LightweightSpriteRegistry::generateQuads( const SpriteGroup& group, const b2AABB& clipAABB )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(LightweightSpriteRegistry_GenerateQuads);
+
+    const U32 spriteCount = group.size();
+
+    // Size the scratch buffers.
+    mQuadVertices.setSize( spriteCount * 4 );
+    mQuadTexels.setSize( spriteCount * 4 );
+    mQuadColors.setSize( spriteCount );
+
+    // Generate all the corners in one pass.
+    generateCorners(
+        spriteCount,
+        group.mPositionX.address(), group.mPositionY.address(),
+        group.mHalfWidth.address(), group.mHalfHeight.address(),
+        group.mCos.address(), group.mSin.address(),
+        mQuadVertices.address() );
+
+    ImageAsset* pImageAsset = group.mImageAsset;
+    const Vector2* pCorners = mQuadVertices.address();
+    Vector2* pVertexOut = mQuadVertices.address();
+    Vector2* pTexelOut = mQuadTexels.address();
+    ColorF* pColorOut = mQuadColors.address();
+
+    U32 quadCount = 0;
+
+    // Cull and compact the visible quads.
+    for ( U32 index = 0; index < spriteCount; ++index, pCorners += 4 )
+    {
+        // Cull using the bounding radius of the sprite.
+        const F32 radius = getMax( group.mHalfWidth[index], group.mHalfHeight[index] ) * 1.41421356f;
+        const F32 px = group.mPositionX[index];
+        const F32 py = group.mPositionY[index];
+        if ( px + radius < clipAABB.lowerBound.x || px - radius > clipAABB.upperBound.x ||
+             py + radius < clipAABB.lowerBound.y || py - radius > clipAABB.upperBound.y )
+            continue;
+
+        // Compact the corners.
+        if ( pVertexOut != pCorners )
+        {
+            pVertexOut[0] = pCorners[0];
+            pVertexOut[1] = pCorners[1];
+            pVertexOut[2] = pCorners[2];
+            pVertexOut[3] = pCorners[3];
+        }
+        pVertexOut += 4;
+
+        // Fetch texel area.
+        const ImageAsset::FrameArea::TexelArea& texelArea = pImageAsset->getImageFrameArea( group.mFrame[index] ).mTexelArea;
+        const Vector2& texLower = texelArea.mTexelLower;
+        const Vector2& texUpper = texelArea.mTexelUpper;
+        pTexelOut[0].Set( texLower.x, texUpper.y );
+        pTexelOut[1].Set( texUpper.x, texUpper.y );
+        pTexelOut[2].Set( texUpper.x, texLower.y );
+        pTexelOut[3].Set( texLower.x, texLower.y );
+        pTexelOut += 4;
+
+        *pColorOut++ = group.mColor[index];
+
+        quadCount++;
+    }
+
+    return quadCount;
+}
@@ -0,0 +1,172 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _LIGHTWEIGHT_SPRITE_REGISTRY_H_
+#define _LIGHTWEIGHT_SPRITE_REGISTRY_H_
+
+#ifndef _VECTOR2_H_
+#include "2d/core/Vector2.h"
+#endif
+
+#ifndef _UTILITY_H_
+#include "2d/core/Utility.h"
+#endif
+
+#ifndef _BATCH_RENDER_H_
+#include "2d/core/BatchRender.h"
+#endif
+
+#ifndef _IMAGE_ASSET_H_
+#include "2d/assets/ImageAsset.h"
+#endif
+
+#ifndef _HASHTABLE_H
+#include "collection/hashTable.h"
+#endif
+
+#ifndef _ASSET_PTR_H_
+#include "assets/assetPtr.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+/// A registry of plain, non-simulated sprites owned by a scene.
+///
+/// Lightweight sprites are not SceneObjects: they have no physics, no callbacks,
+/// no world-query proxy and no virtual render path.  Their transform, frame and
+/// color are held in packed arrays grouped by layer and image so that each group
+/// can be turned into quads by a single tight loop and submitted to the batch
+/// renderer in bulk.  Within a layer they render after that layer's scene objects.
+class LightweightSpriteRegistry
+{
+public:
+    typedef U32 SpriteId;
+
+    enum
+    {
+        InvalidSpriteId = 0
+    };
+
+private:
+    /// Sprites that share a layer and an image.
+    struct SpriteGroup
+    {
+        SpriteGroup( const U32 layer ) : mLayer( layer ) {}
+
+        U32                     mLayer;
+        AssetPtr<ImageAsset>    mImageAsset;
+
+        Vector<F32>             mPositionX;
+        Vector<F32>             mPositionY;
+        Vector<F32>             mHalfWidth;
+        Vector<F32>             mHalfHeight;
+        Vector<F32>             mCos;
+        Vector<F32>             mSin;
+        Vector<F32>             mAngle;
+        Vector<U32>             mFrame;
+        Vector<ColorF>          mColor;
+        Vector<SpriteId>        mSpriteIds;
+
+        inline U32 size( void ) const { return (U32)mSpriteIds.size(); }
+    };
+
+    /// Maps a sprite Id to its group and packed index.
+    struct SpriteSlot
+    {
+        SpriteGroup*    mpGroup;
+        U32             mIndex;
+    };
+
+    typedef Vector<SpriteGroup*> typeSpriteGroupVector;
+    typedef HashTable<StringTableEntry, SpriteGroup*> typeSpriteGroupHash;
+
+    typeSpriteGroupVector   mLayerGroups[MAX_LAYERS_SUPPORTED];
+    typeSpriteGroupHash     mLayerGroupIndex[MAX_LAYERS_SUPPORTED];
+    Vector<SpriteSlot>      mSlots;
+    Vector<U32>             mFreeSlots;
+    U32                     mSpriteCount;
+
+    /// Quad generation scratch.
+    Vector<Vector2>         mQuadVertices;
+    Vector<Vector2>         mQuadTexels;
+    Vector<ColorF>          mQuadColors;
+
+private:
+    SpriteGroup*            findGroup( const U32 layer, const char* pImageAssetId, const bool create, const char* pCallerName );
+    inline SpriteSlot*      findSlot( const SpriteId spriteId )
+    {
+        // Finish if the Id is out of range.
+        if ( spriteId == InvalidSpriteId || spriteId > (U32)mSlots.size() )
+            return NULL;
+
+        SpriteSlot* pSlot = &mSlots[spriteId-1];
+
+        return pSlot->mpGroup == NULL ? NULL : pSlot;
+    }
+
+    U32                     generateQuads( const SpriteGroup& group, const b2AABB& clipAABB );
+
+public:
+    LightweightSpriteRegistry();
+    virtual ~LightweightSpriteRegistry();
+
+    /// Creation and removal.
+    SpriteId                createSprite(
+                                const char* pImageAssetId,
+                                const U32 frame,
+                                const Vector2& position,
+                                const Vector2& size,
+                                const F32 angle = 0.0f,
+                                const ColorF& color = ColorF(1.0f, 1.0f, 1.0f, 1.0f),
+                                const U32 layer = 0 );
+    bool                    removeSprite( const SpriteId spriteId );
+    void                    clear( void );
+    inline bool             isSprite( const SpriteId spriteId )         { return findSlot( spriteId ) != NULL; }
+    inline U32              getCount( void ) const                      { return mSpriteCount; }
+
+    /// Sprite state.
+    bool                    setPosition( const SpriteId spriteId, const Vector2& position );
+    Vector2                 getPosition( const SpriteId spriteId );
+    bool                    setAngle( const SpriteId spriteId, const F32 angle );
+    F32                     getAngle( const SpriteId spriteId );
+    bool                    setTransform( const SpriteId spriteId, const Vector2& position, const F32 angle );
+    bool                    setSize( const SpriteId spriteId, const Vector2& size );
+    Vector2                 getSize( const SpriteId spriteId );
+    bool                    setFrame( const SpriteId spriteId, const U32 frame );
+    U32                     getFrame( const SpriteId spriteId );
+    bool                    setColor( const SpriteId spriteId, const ColorF& color );
+    ColorF                  getColor( const SpriteId spriteId );
+
+    /// Render all sprites in the specified layer that overlap the clip area.
+    U32                     renderLayer( const U32 layer, const b2AABB& clipAABB, BatchRender* pBatchRenderer );
+
+    /// Generate the four corners of a run of sprites.
+    /// Corners are written in the same order as BatchRender::SubmitQuad() expects.
+    static void             generateCorners(
+                                const U32 count,
+                                const F32* pPositionX, const F32* pPositionY,
+                                const F32* pHalfWidth, const F32* pHalfHeight,
+                                const F32* pCos, const F32* pSin,
+                                Vector2* pCorners );
+};
+
+#endif // _LIGHTWEIGHT_SPRITE_REGISTRY_H_
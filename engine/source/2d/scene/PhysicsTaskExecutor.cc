@@ -0,0 +1,166 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "PhysicsTaskExecutor.h"
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+#ifndef _MMATHFN_H_
+#include "math/mMathFn.h"
+#endif
+
+#ifndef _FRAMEALLOCATOR_H_
+#include "memory/frameAllocator.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+PhysicsTaskExecutor::PhysicsTaskExecutor( const S32 workerCount ) :
+    mWorkerCount( mClamp( workerCount, 1, MaxWorkerCount ) ),
+    mFinished( 0 ),
+    mShutdown( false ),
+    mpTask( NULL ),
+    mTaskCount( 0 ),
+    mChunkSize( 1 ),
+    mNextItem( 0 )
+{
+    // Set Vector Associations.
+    VECTOR_SET_ASSOCIATION( mWorkers );
+
+    // The calling thread is worker zero.
+    for ( S32 index = 1; index < mWorkerCount; ++index )
+    {
+        Worker* pWorker = new Worker();
+        pWorker->mpOwner = this;
+        pWorker->mIndex = index;
+        mWorkers.push_back( pWorker );
+
+        pWorker->mpThread = new Thread( &PhysicsTaskExecutor::workerThread, pWorker, true );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+PhysicsTaskExecutor::~PhysicsTaskExecutor()
+{
+    // Wake the workers so they can see the shutdown.
+    mShutdown = true;
+    for ( S32 index = 0; index < mWorkers.size(); ++index )
+    {
+        mWorkers[index]->mStart.release();
+    }
+
+    for ( S32 index = 0; index < mWorkers.size(); ++index )
+    {
+        Worker* pWorker = mWorkers[index];
+        pWorker->mpThread->join();
+        delete pWorker->mpThread;
+        delete pWorker;
+    }
+    mWorkers.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void PhysicsTaskExecutor::ParallelFor( b2Task* pTask, int32 count )
+{
+    // Finish if nothing to do.
+    if ( count <= 0 )
+        return;
+
+    // Debug Profiling.
+    PROFILE_SCOPE(PhysicsTaskExecutor_ParallelFor);
+
+    // Run on this thread only if there's not enough to share.
+    if ( mWorkers.size() == 0 || count == 1 )
+    {
+        pTask->Execute( 0, count, 0 );
+        return;
+    }
+
+    mpTask = pTask;
+    mTaskCount = count;
+    mChunkSize = getMax( 1, count / (mWorkerCount * ChunksPerWorker) );
+    mNextItem = 0;
+
+    // Start the workers.
+    for ( S32 index = 0; index < mWorkers.size(); ++index )
+    {
+        mWorkers[index]->mStart.release();
+    }
+
+    executeChunks( 0 );
+
+    // Wait for the workers.
+    for ( S32 index = 0; index < mWorkers.size(); ++index )
+    {
+        mFinished.acquire();
+    }
+
+    mpTask = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void PhysicsTaskExecutor::executeChunks( const S32 workerIndex )
+{
+    while( true )
+    {
+        // Claim the next chunk.
+        mChunkMutex.lock();
+        const S32 begin = mNextItem;
+        const S32 end = getMin( begin + mChunkSize, mTaskCount );
+        mNextItem = end;
+        mChunkMutex.unlock();
+
+        // Finish if no more work.
+        if ( begin >= end )
+            return;
+
+        mpTask->Execute( begin, end, workerIndex );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void PhysicsTaskExecutor::workerThread( void* pArg )
+{
+    Worker* pWorker = static_cast<Worker*>( pArg );
+    PhysicsTaskExecutor* pOwner = pWorker->mpOwner;
+
+    while( true )
+    {
+        // Wait for work.
+        pWorker->mStart.acquire();
+
+        if ( pOwner->mShutdown )
+            return;
+
+        pOwner->executeChunks( pWorker->mIndex );
+
+        // Release any frame memory used by the task.
+        FrameAllocator::endFrame();
+
+        pOwner->mFinished.release();
+    }
+}
@@ -0,0 +1,92 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _PHYSICS_TASK_EXECUTOR_H_
+#define _PHYSICS_TASK_EXECUTOR_H_
+
+#ifndef BOX2D_H
+#include "Box2D/Box2D.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_SEMAPHORE_H_
+#include "platform/threads/semaphore.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+/// Runs the parallel parts of a physics step on a fixed set of worker threads.
+///
+/// The calling thread is worker zero so a pool of N workers owns N-1 threads.
+/// Work is handed out in chunks on demand.  Box2D only submits work whose results
+/// do not depend on which worker runs it so the step stays deterministic.
+class PhysicsTaskExecutor : public b2TaskExecutor
+{
+public:
+    enum
+    {
+        MaxWorkerCount = 32,
+        ChunksPerWorker = 4,
+    };
+
+private:
+    struct Worker
+    {
+        PhysicsTaskExecutor*    mpOwner;
+        S32                     mIndex;
+        Semaphore               mStart;
+        Thread*                 mpThread;
+
+        Worker() : mpOwner( NULL ), mIndex( 0 ), mStart( 0 ), mpThread( NULL ) {}
+    };
+
+    S32                     mWorkerCount;
+    Vector<Worker*>         mWorkers;
+    Semaphore               mFinished;
+    bool                    mShutdown;
+
+    /// Current task.
+    Mutex                   mChunkMutex;
+    b2Task*                 mpTask;
+    S32                     mTaskCount;
+    S32                     mChunkSize;
+    S32                     mNextItem;
+
+    static void             workerThread( void* pArg );
+    void                    executeChunks( const S32 workerIndex );
+
+public:
+    PhysicsTaskExecutor( const S32 workerCount );
+    virtual ~PhysicsTaskExecutor();
+
+    virtual int32           GetWorkerCount( void ) const                { return mWorkerCount; }
+    virtual void            ParallelFor( b2Task* pTask, int32 count );
+};
+
+#endif // _PHYSICS_TASK_EXECUTOR_H_
@@ -56,6 +56,22 @@
 #include "2d/core/ParticleSystem.h"
 #endif
 
+#ifndef _PHYSICS_TASK_EXECUTOR_H_
+#include "PhysicsTaskExecutor.h"
+#endif
+
+#ifndef _SCENE_STREAMER_H_
+#include "SceneStreamer.h"
+#endif
+
+#ifndef LEVEL_ASSET_H
+#include "2d/assets/LevelAsset.h"
+#endif
+
+#ifndef _ASSET_MANAGER_H_
+#include "assets/assetManager.h"
+#endif
+
 // Script bindings.
 #include "Scene_ScriptBinding.h"
 
@@ -152,6 +168,12 @@ Scene::Scene() :
     mWorldGravity(0.0f, 0.0f),
     mVelocityIterations(8),
     mPositionIterations(3),
+    mPhysicsWorkerCount(1),
+    mpPhysicsTaskExecutor(NULL),
+
+    /// Active tick set.
+    mEnabledSceneObjectCount(0),
+    mVisibleSceneObjectCount(0),
 
     /// Joint access.
     mJointMasterId(1),
@@ -164,6 +186,9 @@ Scene::Scene() :
     mDebugMask(0X00000000),
     mpDebugSceneObject(NULL),
 
+    /// Level streaming.
+    mpStreamer(NULL),
+
     /// Window rendering.
     mpCurrentRenderWindow(NULL),
 
@@ -171,13 +196,25 @@ Scene::Scene() :
     mIsEditorScene(0),
     mUpdateCallback(false),
     mRenderCallback(false),
-    mSceneIndex(0)
+    mSceneIndex(0),
+    mDeadContactEvents(0),
+    mBatchContactCallback(false),
+    mCoalesceContacts(false),
+    mBatchCallbackGroupMask(0)
 {
     // Set Vector Associations.
     VECTOR_SET_ASSOCIATION( mSceneObjects );
+    VECTOR_SET_ASSOCIATION( mActiveSceneObjects );
+    VECTOR_SET_ASSOCIATION( mWatchedSceneObjects );
     VECTOR_SET_ASSOCIATION( mDeleteRequests );
     VECTOR_SET_ASSOCIATION( mDeleteRequestsTemp );
     VECTOR_SET_ASSOCIATION( mEndContacts );
+    VECTOR_SET_ASSOCIATION( mContactListeners );
+    VECTOR_SET_ASSOCIATION( mBeginContactEvents );
+    VECTOR_SET_ASSOCIATION( mEndContactEvents );
+    VECTOR_SET_ASSOCIATION( mFilteredContactEvents );
+    VECTOR_SET_ASSOCIATION( mDispatchContactListeners );
+    VECTOR_SET_ASSOCIATION( mTickEvents );
     VECTOR_SET_ASSOCIATION( mAssetPreloads );
 
     // Initialize layer sort mode.
@@ -231,6 +268,13 @@ bool Scene::onAdd()
     // Set destruction listener.
     mpWorld->SetDestructionListener( this );
 
+    // Set physics workers.
+    if ( mPhysicsWorkerCount > 1 )
+    {
+        mpPhysicsTaskExecutor = new PhysicsTaskExecutor( mPhysicsWorkerCount );
+        mpWorld->SetTaskExecutor( mpPhysicsTaskExecutor );
+    }
+
     // Create ground body.
     b2BodyDef groundBodyDef;
     groundBodyDef.userData = static_cast<PhysicsProxy*>(this);
@@ -273,6 +317,10 @@ void Scene::onRemove()
     mpWorldQuery = NULL;
     mpWorld = NULL;
 
+    // Delete physics workers.
+    delete mpPhysicsTaskExecutor;
+    mpPhysicsTaskExecutor = NULL;
+
     // Detach All Scene Windows.
     detachAllSceneWindows();
 
@@ -283,6 +331,110 @@ void Scene::onRemove()
 
 //-----------------------------------------------------------------------------
 
+void Scene::setPhysicsWorkerCount( const S32 workerCount )
+{
+    const S32 newWorkerCount = mClamp( workerCount, 1, PhysicsTaskExecutor::MaxWorkerCount );
+
+    // Finish if no change.
+    if ( newWorkerCount == mPhysicsWorkerCount )
+        return;
+
+    mPhysicsWorkerCount = newWorkerCount;
+
+    // Finish if the world isn't created yet.
+    if ( mpWorld == NULL )
+        return;
+
+    // Sanity!
+    AssertFatal( !mpWorld->IsLocked(), "Scene::setPhysicsWorkerCount() - Cannot change the worker count during a physics step." );
+
+    // Replace the physics workers.
+    mpWorld->SetTaskExecutor( NULL );
+    delete mpPhysicsTaskExecutor;
+    mpPhysicsTaskExecutor = NULL;
+
+    if ( mPhysicsWorkerCount > 1 )
+    {
+        mpPhysicsTaskExecutor = new PhysicsTaskExecutor( mPhysicsWorkerCount );
+        mpWorld->SetTaskExecutor( mpPhysicsTaskExecutor );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+F32 Scene::benchmarkLiquidParticles( const U32 particleCount, const U32 stepCount )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_BenchmarkLiquidParticles);
+
+    // Sanity!
+    if ( particleCount == 0 || stepCount == 0 )
+    {
+        Con::warnf( "Scene::benchmarkLiquidParticles() - The particle and step counts must be greater than zero." );
+        return 0.0f;
+    }
+
+    // Use a separate world so that the scene is left untouched.
+    b2World* pWorld = new b2World( mWorldGravity );
+
+    PhysicsTaskExecutor* pTaskExecutor = NULL;
+    if ( mPhysicsWorkerCount > 1 )
+    {
+        pTaskExecutor = new PhysicsTaskExecutor( mPhysicsWorkerCount );
+        pWorld->SetTaskExecutor( pTaskExecutor );
+    }
+
+    b2ParticleSystemDef particleSystemDef;
+    particleSystemDef.radius = 0.1f;
+    b2ParticleSystem* pParticleSystem = pWorld->CreateParticleSystem( &particleSystemDef );
+
+    // Size a square block of water to hold the requested particles.
+    const F32 blockSize = mSqrt( (F32)particleCount ) * b2_particleStride * particleSystemDef.radius * 2.0f;
+
+    // Create a tank twice the size of the block.
+    const b2Vec2 tankVertices[4] = { b2Vec2( 0.0f, 0.0f ), b2Vec2( blockSize * 2.0f, 0.0f ), b2Vec2( blockSize * 2.0f, blockSize * 2.0f ), b2Vec2( 0.0f, blockSize * 2.0f ) };
+    b2ChainShape tankShape;
+    tankShape.CreateLoop( tankVertices, 4 );
+    b2BodyDef tankBodyDef;
+    pWorld->CreateBody( &tankBodyDef )->CreateFixture( &tankShape, 0.0f );
+
+    // Fill one corner of the tank so that the water collapses across it.
+    b2PolygonShape blockShape;
+    blockShape.SetAsBox( blockSize * 0.5f, blockSize * 0.5f, b2Vec2( blockSize * 0.5f, blockSize * 0.5f ), 0.0f );
+    b2ParticleGroupDef blockDef;
+    blockDef.shape = &blockShape;
+    blockDef.flags = b2_waterParticle;
+    pParticleSystem->CreateParticleGroup( blockDef );
+
+    F32 totalStepTime = 0.0f;
+    F32 maxStepTime = 0.0f;
+    F32 totalParticleTime = 0.0f;
+    for ( U32 stepIndex = 0; stepIndex < stepCount; ++stepIndex )
+    {
+        pWorld->Step( Tickable::smTickSec, mVelocityIterations, mPositionIterations );
+
+        const b2Profile& profile = pWorld->GetProfile();
+        totalStepTime += profile.step;
+        totalParticleTime += profile.solveParticles;
+        if ( profile.step > maxStepTime )
+            maxStepTime = profile.step;
+    }
+
+    const F32 averageStepTime = totalStepTime / (F32)stepCount;
+
+    Con::printf( "Scene::benchmarkLiquidParticles() - %d particles, %d workers, %d steps: Step=%0.2fms<%0.2fms>, SolveParticles=%0.2fms.",
+        pParticleSystem->GetParticleCount(), mPhysicsWorkerCount, stepCount,
+        averageStepTime, maxStepTime, totalParticleTime / (F32)stepCount );
+
+    pWorld->SetTaskExecutor( NULL );
+    delete pTaskExecutor;
+    delete pWorld;
+
+    return averageStepTime;
+}
+
+//-----------------------------------------------------------------------------
+
 void Scene::onDeleteNotify( SimObject* object )
 {
     // Ignore if we're not monitoring a debug banner scene object.
@@ -309,6 +461,7 @@ void Scene::initPersistFields()
     addProtectedField("Gravity", TypeVector2, Offset(mWorldGravity, Scene), &setGravity, &getGravity, &writeGravity, "" );
     addField("VelocityIterations", TypeS32, Offset(mVelocityIterations, Scene), &writeVelocityIterations, "" );
     addField("PositionIterations", TypeS32, Offset(mPositionIterations, Scene), &writePositionIterations, "" );
+    addProtectedField("PhysicsWorkerCount", TypeS32, Offset(mPhysicsWorkerCount, Scene), &setPhysicsWorkerCount, &defaultProtectedGetFn, &writePhysicsWorkerCount, "The number of threads used to solve physics islands, contacts and particles.  A value of one solves on the main thread." );
 
     // Layer sort modes.
     /*char buffer[64];
@@ -323,6 +476,9 @@ void Scene::initPersistFields()
     // Callbacks.
     addField("UpdateCallback", TypeBool, Offset(mUpdateCallback, Scene), &writeUpdateCallback, "");
     addField("RenderCallback", TypeBool, Offset(mRenderCallback, Scene), &writeRenderCallback, "");
+    addField("BatchContactCallback", TypeBool, Offset(mBatchContactCallback, Scene), &writeBatchContactCallback, "Whether a tick's contacts are reported with a single 'onSceneContacts' callback instead of per-contact collision callbacks.");
+    addField("CoalesceContacts", TypeBool, Offset(mCoalesceContacts, Scene), &writeCoalesceContacts, "Whether contacts between the same pair of objects are reported as a single contact event.");
+    addField("BatchCallbackGroupMask", TypeS32, Offset(mBatchCallbackGroupMask, Scene), &writeBatchCallbackGroupMask, "The scene groups whose objects report their update, completion and wake/sleep callbacks with a single 'onSceneTickEvents' callback.");
 }
 
 //-----------------------------------------------------------------------------
@@ -735,11 +891,365 @@ void Scene::dispatchEndContactCallbacks( void )
 
 //-----------------------------------------------------------------------------
 
+void Scene::addContactListener( SceneContactListener* pListener, const U32 groupMask )
+{
+    // Sanity!
+    AssertFatal( pListener != NULL, "Scene::addContactListener() - Cannot add a NULL listener." );
+
+    // Update the mask if the listener is already added.
+    const S32 index = findContactListener( pListener );
+    if ( index != -1 )
+    {
+        mContactListeners[index].mGroupMask = groupMask;
+        return;
+    }
+
+    ContactListenerEntry entry;
+    entry.mpListener = pListener;
+    entry.mGroupMask = groupMask;
+    mContactListeners.push_back( entry );
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::removeContactListener( SceneContactListener* pListener )
+{
+    const S32 index = findContactListener( pListener );
+    if ( index != -1 )
+        mContactListeners.erase( index );
+}
+
+//-----------------------------------------------------------------------------
+
+S32 Scene::findContactListener( const SceneContactListener* pListener ) const
+{
+    for ( S32 i = 0; i < mContactListeners.size(); ++i )
+    {
+        if ( mContactListeners[i].mpListener == pListener )
+            return i;
+    }
+
+    return -1;
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::bufferContactEvents( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_BufferContactEvents);
+
+    mBeginContactEvents.clear();
+    mEndContactEvents.clear();
+
+    // Buffer end contacts.
+    mContactPairs.clear();
+    for ( typeContactVector::iterator contactItr = mEndContacts.begin(); contactItr != mEndContacts.end(); ++contactItr )
+        bufferContactEvent( mEndContactEvents, *contactItr );
+
+    // Buffer begin contacts.
+    mContactPairs.clear();
+    for ( typeContactHash::iterator contactItr = mBeginContacts.begin(); contactItr != mBeginContacts.end(); ++contactItr )
+        bufferContactEvent( mBeginContactEvents, contactItr->value );
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::bufferContactEvent( typeContactVector& events, const TickContact& tickContact )
+{
+    // Skip if either object is being deleted.
+    if ( tickContact.mpSceneObjectA->isBeingDeleted() || tickContact.mpSceneObjectB->isBeingDeleted() )
+        return;
+
+    if ( !mCoalesceContacts )
+    {
+        events.push_back( tickContact );
+        return;
+    }
+
+    // Key the pair by its lowest object.
+    SceneObject* pSceneObjectKey = tickContact.mpSceneObjectA < tickContact.mpSceneObjectB ? tickContact.mpSceneObjectA : tickContact.mpSceneObjectB;
+    SceneObject* pSceneObjectOther = tickContact.getCollideWith( pSceneObjectKey );
+
+    // Coalesce with an existing contact between the pair.
+    for ( typeContactPairHash::iterator pairItr = mContactPairs.find( pSceneObjectKey ); pairItr != mContactPairs.end() && pairItr->key == pSceneObjectKey; ++pairItr )
+    {
+        TickContact& pairContact = events[pairItr->value];
+        if ( pairContact.getCollideWith( pSceneObjectKey ) != pSceneObjectOther )
+            continue;
+
+        // Keep the first manifold but accumulate the impulses.
+        for ( U32 index = 0; index < b2_maxManifoldPoints; ++index )
+        {
+            pairContact.mNormalImpulses[index] += tickContact.mNormalImpulses[index];
+            pairContact.mTangentImpulses[index] += tickContact.mTangentImpulses[index];
+        }
+        return;
+    }
+
+    mContactPairs.insertEqual( pSceneObjectKey, (U32)events.size() );
+    events.push_back( tickContact );
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::killContactEvents( typeContactVector& events, const SceneObject* pSceneObject )
+{
+    // The events may already have been handed out by index or pointer so they are only marked here.
+    for ( typeContactVector::iterator contactItr = events.begin(); contactItr != events.end(); ++contactItr )
+    {
+        if ( contactItr->mpSceneObjectA == pSceneObject || contactItr->mpSceneObjectB == pSceneObject )
+        {
+            contactItr->kill();
+            mDeadContactEvents++;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::compactContactEvents( typeContactVector& events )
+{
+    S32 liveCount = 0;
+    for ( S32 i = 0; i < events.size(); ++i )
+    {
+        if ( events[i].isDead() )
+            continue;
+
+        if ( liveCount != i )
+            events[liveCount] = events[i];
+        liveCount++;
+    }
+
+    events.setSize( liveCount );
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::compactDeadContactEvents( void )
+{
+    if ( mDeadContactEvents == 0 )
+        return;
+
+    compactContactEvents( mBeginContactEvents );
+    compactContactEvents( mEndContactEvents );
+    mDeadContactEvents = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::dispatchContactListeners( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_DispatchContactListeners);
+
+    // Listeners can be added or removed by a listener so dispatch to a copy.
+    mDispatchContactListeners = mContactListeners;
+
+    for ( S32 i = 0; i < mDispatchContactListeners.size(); ++i )
+    {
+        // Skip the listener if an earlier one removed it.
+        SceneContactListener* pListener = mDispatchContactListeners[i].mpListener;
+        const S32 listenerIndex = findContactListener( pListener );
+        if ( listenerIndex == -1 )
+            continue;
+
+        const U32 groupMask = mContactListeners[listenerIndex].mGroupMask;
+
+        // Drop contacts killed by an earlier listener.
+        compactDeadContactEvents();
+
+        // Pass everything through if the listener isn't filtering.
+        if ( groupMask == MASK_ALL )
+        {
+            pListener->onSceneEndContacts( this, mEndContactEvents.address(), mEndContactEvents.size() );
+
+            // Drop contacts killed by the end contacts callback.
+            compactDeadContactEvents();
+
+            pListener->onSceneBeginContacts( this, mBeginContactEvents.address(), mBeginContactEvents.size() );
+            continue;
+        }
+
+        // Filter end contacts.
+        mFilteredContactEvents.clear();
+        for ( typeContactVector::iterator contactItr = mEndContactEvents.begin(); contactItr != mEndContactEvents.end(); ++contactItr )
+        {
+            if ( !contactItr->isDead() &&
+                 ((contactItr->mpSceneObjectA->mSceneGroupMask | contactItr->mpSceneObjectB->mSceneGroupMask) & groupMask) != 0 )
+                mFilteredContactEvents.push_back( *contactItr );
+        }
+        pListener->onSceneEndContacts( this, mFilteredContactEvents.address(), mFilteredContactEvents.size() );
+
+        // Filter begin contacts, skipping any killed by the end contacts callback.
+        mFilteredContactEvents.clear();
+        for ( typeContactVector::iterator contactItr = mBeginContactEvents.begin(); contactItr != mBeginContactEvents.end(); ++contactItr )
+        {
+            if ( !contactItr->isDead() &&
+                 ((contactItr->mpSceneObjectA->mSceneGroupMask | contactItr->mpSceneObjectB->mSceneGroupMask) & groupMask) != 0 )
+                mFilteredContactEvents.push_back( *contactItr );
+        }
+        pListener->onSceneBeginContacts( this, mFilteredContactEvents.address(), mFilteredContactEvents.size() );
+    }
+
+    mDispatchContactListeners.clear();
+    mFilteredContactEvents.clear();
+
+    // Drop contacts killed by the last listener.
+    compactDeadContactEvents();
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::dispatchBatchContactCallback( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_DispatchBatchContactCallback);
+
+    // Finish if no contacts.
+    if ( mBeginContactEvents.size() == 0 && mEndContactEvents.size() == 0 )
+        return;
+
+    // Format counts.
+    char beginCountBuffer[16];
+    char endCountBuffer[16];
+    dSprintf( beginCountBuffer, sizeof(beginCountBuffer), "%d", mBeginContactEvents.size() );
+    dSprintf( endCountBuffer, sizeof(endCountBuffer), "%d", mEndContactEvents.size() );
+
+    // Does the scene handle the contacts callback?
+    Namespace* pNamespace = getNamespace();
+    if ( pNamespace != NULL && pNamespace->lookup( StringTable->insert( "onSceneContacts" ) ) != NULL )
+    {
+        // Yes, so perform script callback on the Scene.
+        Con::executef( this, 3, "onSceneContacts", beginCountBuffer, endCountBuffer );
+    }
+    else
+    {
+        // No, so call it on its behaviors.
+        const char* args[4] = { "onSceneContacts", "", beginCountBuffer, endCountBuffer };
+        callOnBehaviors( 4, args );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+const char* Scene::formatContactEvent( const TickContact& tickContact, const bool beginContact ) const
+{
+    // Fetch scene objects.
+    SceneObject* pSceneObjectA = tickContact.mpSceneObjectA;
+    SceneObject* pSceneObjectB = tickContact.mpSceneObjectB;
+
+    // Fetch shape indices.
+    const S32 shapeIndexA = pSceneObjectA->getCollisionShapeIndex( tickContact.mpFixtureA );
+    const S32 shapeIndexB = pSceneObjectB->getCollisionShapeIndex( tickContact.mpFixtureB );
+
+    // Fetch normal and contact points.
+    const U32 pointCount = beginContact ? tickContact.mPointCount : 0;
+    const b2Vec2& normal = tickContact.mWorldManifold.normal;
+    const b2Vec2& point1 = tickContact.mWorldManifold.points[0];
+    const b2Vec2& point2 = tickContact.mWorldManifold.points[1];
+
+    // Format the same as the collision callbacks from object A's point of view.
+    char* pBuffer = Con::getReturnBuffer(256);
+    if ( pointCount == 2 )
+    {
+        dSprintf( pBuffer, 256,
+            "%d %d %d %d %0.4f %0.4f %0.4f %0.4f %0.4f %0.4f %0.4f %0.4f %0.4f %0.4f",
+            pSceneObjectA->getId(), pSceneObjectB->getId(),
+            shapeIndexA, shapeIndexB,
+            -normal.x, -normal.y,
+            point1.x, point1.y,
+            tickContact.mNormalImpulses[0],
+            tickContact.mTangentImpulses[0],
+            point2.x, point2.y,
+            tickContact.mNormalImpulses[1],
+            tickContact.mTangentImpulses[1] );
+    }
+    else if ( pointCount == 1 )
+    {
+        dSprintf( pBuffer, 256,
+            "%d %d %d %d %0.4f %0.4f %0.4f %0.4f %0.4f %0.4f",
+            pSceneObjectA->getId(), pSceneObjectB->getId(),
+            shapeIndexA, shapeIndexB,
+            -normal.x, -normal.y,
+            point1.x, point1.y,
+            tickContact.mNormalImpulses[0],
+            tickContact.mTangentImpulses[0] );
+    }
+    else
+    {
+        dSprintf( pBuffer, 256,
+            "%d %d %d %d",
+            pSceneObjectA->getId(), pSceneObjectB->getId(),
+            shapeIndexA, shapeIndexB );
+    }
+
+    return pBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::bufferTickEvent( const SceneObject* pSceneObject, const U32 tickEvent )
+{
+    // Sanity!
+    AssertFatal( tickEvent < SceneObject::TickEventCount, "Scene::bufferTickEvent() - Invalid tick event." );
+
+    TickEventEntry entry;
+    entry.mObjectId = pSceneObject->getId();
+    entry.mTickEvent = tickEvent;
+    mTickEvents.push_back( entry );
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::dispatchBatchTickEventCallback( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_DispatchBatchTickEventCallback);
+
+    // Finish if no tick events.
+    if ( mTickEvents.size() == 0 )
+        return;
+
+    // Format count.
+    char countBuffer[16];
+    dSprintf( countBuffer, sizeof(countBuffer), "%d", mTickEvents.size() );
+
+    // Does the scene handle the tick events callback?
+    Namespace* pNamespace = getNamespace();
+    if ( pNamespace != NULL && pNamespace->lookup( StringTable->insert( "onSceneTickEvents" ) ) != NULL )
+    {
+        // Yes, so perform script callback on the Scene.
+        Con::executef( this, 2, "onSceneTickEvents", countBuffer );
+    }
+    else
+    {
+        // No, so call it on its behaviors.
+        const char* args[3] = { "onSceneTickEvents", "", countBuffer };
+        callOnBehaviors( 3, args );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+const char* Scene::formatTickEvent( const TickEventEntry& tickEvent ) const
+{
+    // Format as the object and the callback it would have received.
+    char* pBuffer = Con::getReturnBuffer(64);
+    dSprintf( pBuffer, 64, "%d %s", tickEvent.mObjectId, SceneObject::getTickEventCallbackName( (SceneObject::TickEvent)tickEvent.mTickEvent ) );
+    return pBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
 void Scene::processTick( void )
 {
     // Debug Profiling.
     PROFILE_SCOPE(Scene_ProcessTick);
 
+    // Memory Accounting.
+    Memory::TagScope memoryTag( Memory::TagScene );
+
     // Finish if the Scene is not added to the simulation.
     if ( !isProperlyAdded() )
         return;
@@ -747,6 +1257,10 @@ void Scene::processTick( void )
     // Process Delete Requests.
     processDeleteRequests(false);
 
+    // Update level streaming.
+    if ( mpStreamer != NULL )
+        mpStreamer->update();
+
     // Update debug stats.
     mDebugStats.fps           = Con::getFloatVariable("fps::framePeriod", 0.0f);
     mDebugStats.frameCount    = (U32)Con::getIntVariable("fps::frameCount", 0);
@@ -756,6 +1270,7 @@ void Scene::processTick( void )
     mDebugStats.proxyCount    = (U32)mpWorld->GetProxyCount();
     mDebugStats.objectsCount  = (U32)mSceneObjects.size();
     mDebugStats.worldProfile  = mpWorld->GetProfile();
+    mDebugStats.physicsWorkerCount = (U32)mPhysicsWorkerCount;
 
     // Set particle stats.
     mDebugStats.particlesAlloc = ParticleSystem::Instance->getAllocatedParticleCount();
@@ -766,8 +1281,6 @@ void Scene::processTick( void )
     if ( !getScenePause() )
     {
         // Reset object stats.
-        U32 objectsEnabled = 0;
-        U32 objectsVisible = 0;
         U32 objectsAwake   = 0;
 
         // Fetch if a "normal" i.e. non-editor scene.
@@ -776,46 +1289,65 @@ void Scene::processTick( void )
         // Update scene time.
         mSceneTime += Tickable::smTickSec;
 
-        // Clear ticked scene objects.
+        // Clear ticked and watched scene objects.
         mTickedSceneObjects.clear();
+        mWatchedSceneObjects.clear();
 
-        // Iterate scene objects.
-        for( S32 n = 0; n < mSceneObjects.size(); ++n )
+        // Iterate the active scene objects, dropping any that no longer have per-tick work.
+        S32 activeCount = 0;
+        for( S32 n = 0; n < mActiveSceneObjects.size(); ++n )
         {
             // Fetch scene object.
-            SceneObject* pSceneObject = mSceneObjects[n];
+            SceneObject* pSceneObject = mActiveSceneObjects[n];
 
-            // Update awake/asleep counts.
-            if ( pSceneObject->getAwake() )
-                objectsAwake++;
+            // Skip if removed from the scene.
+            if ( pSceneObject == NULL )
+                continue;
 
-            // Update visible.
-            if ( pSceneObject->getVisible() )
-                objectsVisible++;
+            // Fetch the tick state.
+            const SceneObject::TickState tickState = pSceneObject->getTickState();
 
-            // Push scene object if it's eligible for ticking.
-            if ( pSceneObject->isEnabled() )
+            // Drop the scene object if it has no per-tick work.
+            if ( tickState == SceneObject::TickNone )
             {
-                // Update enabled.
-                objectsEnabled++;
-
-                // Add to ticked objects if object is not being deleted and this is a "normal" scene or
-                // the object is marked as allowing editor ticks.
-                if ( !pSceneObject->isBeingDeleted() && (isNormalScene || pSceneObject->getIsEditorTickAllowed() )  )
-                    mTickedSceneObjects.push_back( pSceneObject );
+                pSceneObject->mActiveTickIndex = -1;
+                continue;
             }
+
+            // Keep the scene object active.
+            pSceneObject->mActiveTickIndex = activeCount;
+            mActiveSceneObjects[activeCount++] = pSceneObject;
+
+            // Update awake count.
+            // NOTE: Static bodies are never awake so all awake bodies are in the active set.
+            if ( pSceneObject->getAwake() )
+                objectsAwake++;
+
+            // Skip if the object is being deleted or this is not a "normal" scene and the object
+            // is not marked as allowing editor ticks.
+            if ( pSceneObject->isBeingDeleted() || !(isNormalScene || pSceneObject->getIsEditorTickAllowed()) )
+                continue;
+
+            // Tick the object or watch it for its body waking.
+            if ( tickState == SceneObject::TickRequired )
+                mTickedSceneObjects.push_back( pSceneObject );
+            else
+                mWatchedSceneObjects.push_back( pSceneObject );
         }
 
+        // Set the active count.
+        mActiveSceneObjects.setSize( activeCount );
+
         // Update object stats.
-        mDebugStats.objectsEnabled = objectsEnabled;
-        mDebugStats.objectsVisible = objectsVisible;
+        mDebugStats.objectsEnabled = mEnabledSceneObjectCount;
+        mDebugStats.objectsVisible = mVisibleSceneObjectCount;
         mDebugStats.objectsAwake   = objectsAwake;
 
         // Debug Status Reference.
         DebugStats* pDebugStats = &mDebugStats;
 
         // Fetch ticked scene object count.
-        const S32 tickedSceneObjectCount = mTickedSceneObjects.size();
+        S32 tickedSceneObjectCount = mTickedSceneObjects.size();
 
         // ****************************************************
         // Pre-integrate objects.
@@ -882,6 +1414,19 @@ void Scene::processTick( void )
         // Forward the contacts.
         forwardContacts();
 
+        // Tick any watched scene objects whose body was woken.
+        // NOTE: These objects have not been pre-integrated but there is nothing for them to do there.
+        for ( S32 i = 0; i < mWatchedSceneObjects.size(); ++i )
+        {
+            if ( mWatchedSceneObjects[i]->getAwake() )
+                mTickedSceneObjects.push_back( mWatchedSceneObjects[i] );
+        }
+        mWatchedSceneObjects.clear();
+
+        // Update ticked scene object count.
+        tickedSceneObjectCount = mTickedSceneObjects.size();
+        mDebugStats.objectsTicked = (U32)tickedSceneObjectCount;
+
         // ****************************************************
         // Integrate objects.
         // ****************************************************
@@ -910,6 +1455,12 @@ void Scene::processTick( void )
             mTickedSceneObjects[i]->postIntegrate( mSceneTime, Tickable::smTickSec, pDebugStats );
         }
 
+        // Dispatch batched tick events.
+        dispatchBatchTickEventCallback();
+
+        // The tick events are only valid during dispatch.
+        mTickEvents.clear();
+
         // Scene update callback.
         if( mUpdateCallback )
         {
@@ -922,9 +1473,28 @@ void Scene::processTick( void )
         // Only dispatch contacts if a "normal" scene.
         if ( isNormalScene )
         {
+            // Buffer contact events if anything wants them.
+            if ( mContactListeners.size() > 0 || mBatchContactCallback )
+            {
+                bufferContactEvents();
+                dispatchContactListeners();
+            }
+
             // Dispatch contacts callbacks.
-            dispatchEndContactCallbacks();
-            dispatchBeginContactCallbacks();
+            if ( mBatchContactCallback )
+            {
+                dispatchBatchContactCallback();
+            }
+            else
+            {
+                dispatchEndContactCallbacks();
+                dispatchBeginContactCallbacks();
+            }
+
+            // The contact events are only valid during dispatch.
+            mBeginContactEvents.clear();
+            mEndContactEvents.clear();
+            mDeadContactEvents = 0;
         }
 
         // Clear ticked scene objects.
@@ -949,17 +1519,18 @@ void Scene::interpolateTick( F32 timeDelta )
     // Interpolate scene objects.
     // ****************************************************
 
-    // Fetch the scene object count.
-    const S32 sceneObjectCount = mSceneObjects.size();
+    // Fetch the active scene object count.
+    // NOTE: Objects not in the active set have nothing to interpolate.
+    const S32 sceneObjectCount = mActiveSceneObjects.size();
 
-    // Iterate scene objects.
+    // Iterate active scene objects.
     for( S32 n = 0; n < sceneObjectCount; ++n )
     {
         // Fetch scene object.
-        SceneObject* pSceneObject = mSceneObjects[n];
+        SceneObject* pSceneObject = mActiveSceneObjects[n];
 
         // Skip interpolation of scene object if it's not eligible.
-        if ( !pSceneObject->isEnabled() || pSceneObject->isBeingDeleted() )
+        if ( pSceneObject == NULL || !pSceneObject->isEnabled() || pSceneObject->isBeingDeleted() )
             continue;
 
         pSceneObject->interpolateObject( timeDelta );
@@ -980,6 +1551,7 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
     pDebugStats->renderPicked                   = 0;
     pDebugStats->renderRequests                 = 0;
     pDebugStats->renderFallbacks                = 0;
+    pDebugStats->renderLightweightSprites       = 0;
     pDebugStats->batchTrianglesSubmitted        = 0;
     pDebugStats->batchDrawCallsStrict           = 0;
     pDebugStats->batchDrawCallsSorted           = 0;
@@ -1023,8 +1595,8 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
     // Debug Profiling.
     PROFILE_END();  //Scene_RenderSceneVisibleQuery
 
-    // Are there any query results?
-    if ( mpWorldQuery->getQueryResultsCount() > 0 )
+    // Are there any query results or lightweight sprites?
+    if ( mpWorldQuery->getQueryResultsCount() > 0 || mLightweightSprites.getCount() > 0 )
     {
         // Debug Profiling.
         PROFILE_SCOPE(Scene_RenderSceneCompileRenderRequests);
@@ -1233,6 +1805,19 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
                 }
             }
 
+            // Render any lightweight sprites in this layer.
+            if ( mLightweightSprites.getCount() > 0 && (pSceneRenderState->mRenderLayerMask & BIT(layer)) )
+            {
+                // Debug Profiling.
+                PROFILE_SCOPE(Scene_RenderLightweightSprites);
+
+                pDebugStats->renderLightweightSprites += mLightweightSprites.renderLayer( layer, cameraAABB, &mBatchRenderer );
+
+                // Flush.
+                // NOTE:    We cannot batch between layers as we adhere to a strict layer render order.
+                mBatchRenderer.flush( pDebugStats->batchLayerFlush );
+            }
+
             // Reset render queue.
             pSceneRenderQueue->resetState();
         }
@@ -1302,10 +1887,13 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
 
 void Scene::clearScene( bool deleteObjects )
 {
+    // Close any streaming level.
+    closeStreamingLevel();
+
     while( mSceneObjects.size() > 0 )
     {
-        // Fetch first scene object.
-        SceneObject* pSceneObject = mSceneObjects[0];
+        // Fetch last scene object.
+        SceneObject* pSceneObject = mSceneObjects.last();
 
         // Remove Object from Scene.
         removeFromScene( pSceneObject );
@@ -1326,6 +1914,9 @@ void Scene::clearScene( bool deleteObjects )
             pControllerSet->at(0)->deleteObject();
     }
 
+    // Clear lightweight sprites.
+    mLightweightSprites.clear();
+
     // Clear asset preloads.
     clearAssetPreloads();
 }
@@ -1344,13 +1935,8 @@ void Scene::addToScene( SceneObject* pSceneObject )
     if ( pCurrentScene == this )
         return;
 
-#if defined(TORQUE_DEBUG)
     // Sanity!
-    for ( S32 n = 0; n < mSceneObjects.size(); ++n )
-    {
-        AssertFatal( mSceneObjects[n] != pSceneObject, "A scene object has become corrupt." );
-    }
-#endif
+    AssertFatal( pSceneObject->mSceneObjectIndex == -1, "A scene object has become corrupt." );
 
     // Check that object is not already in a scene.
     if ( pCurrentScene )
@@ -1360,11 +1946,15 @@ void Scene::addToScene( SceneObject* pSceneObject )
     }
 
     // Add scene object.
+    pSceneObject->mSceneObjectIndex = mSceneObjects.size();
     mSceneObjects.push_back( pSceneObject );
 
     // Register with the scene.
     pSceneObject->OnRegisterScene( this );
 
+    // Update the tick state.
+    pSceneObject->updateTickState();
+
     // Perform callback only if properly added to the simulation.
     if ( pSceneObject->isProperlyAdded() )
     {
@@ -1407,25 +1997,92 @@ void Scene::removeFromScene( SceneObject* pSceneObject )
         (dynamic_cast<SceneWindow*>(mAttachedSceneWindows[i]))->removeFromInputEventPick(pSceneObject);
     }
 
-    // Unregister from scene.
-    pSceneObject->OnUnregisterScene( this );
+    // Kill any contact events being dispatched.
+    if ( mBeginContactEvents.size() > 0 || mEndContactEvents.size() > 0 )
+    {
+        killContactEvents( mBeginContactEvents, pSceneObject );
+        killContactEvents( mEndContactEvents, pSceneObject );
+        killContactEvents( mFilteredContactEvents, pSceneObject );
+    }
 
-    // Find scene object and remove it quickly.
-    for ( S32 n = 0; n < mSceneObjects.size(); ++n )
+    // Remove from the active set.
+    if ( pSceneObject->mActiveTickIndex != -1 )
     {
-        if ( mSceneObjects[n] == pSceneObject )
-        {
-            mSceneObjects.erase_fast( n );
-            break;
-        }
+        mActiveSceneObjects[pSceneObject->mActiveTickIndex] = NULL;
+        pSceneObject->mActiveTickIndex = -1;
     }
 
+    // Remove from the object stats.
+    if ( pSceneObject->mTickCountedEnabled )
+        mEnabledSceneObjectCount--;
+    if ( pSceneObject->mTickCountedVisible )
+        mVisibleSceneObjectCount--;
+    pSceneObject->mTickCountedEnabled = false;
+    pSceneObject->mTickCountedVisible = false;
+
+    // Unregister from scene.
+    pSceneObject->OnUnregisterScene( this );
+
+    // Remove scene object quickly.
+    const S32 sceneObjectIndex = pSceneObject->mSceneObjectIndex;
+    AssertFatal( sceneObjectIndex >= 0 && sceneObjectIndex < mSceneObjects.size() && mSceneObjects[sceneObjectIndex] == pSceneObject, "Scene::removeFromScene() - Invalid scene object index." );
+    mSceneObjects.erase_fast( sceneObjectIndex );
+    if ( sceneObjectIndex < mSceneObjects.size() )
+        mSceneObjects[sceneObjectIndex]->mSceneObjectIndex = sceneObjectIndex;
+    pSceneObject->mSceneObjectIndex = -1;
+
     // Perform callback.
     Con::executef( pSceneObject, 2, "onRemoveFromScene", getIdString() );
 }
 
 //-----------------------------------------------------------------------------
 
+void Scene::activateSceneObject( SceneObject* pSceneObject )
+{
+    // Sanity!
+    AssertFatal( pSceneObject->getScene() == this, "Scene::activateSceneObject() - Object is not in this scene." );
+
+    // Ignore if already active.
+    if ( pSceneObject->mActiveTickIndex != -1 )
+        return;
+
+    // Add to the active set.
+    // NOTE: Objects are dropped from the active set when ticked with no per-tick work left.
+    pSceneObject->mActiveTickIndex = mActiveSceneObjects.size();
+    mActiveSceneObjects.push_back( pSceneObject );
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::updateSceneObjectStats( SceneObject* pSceneObject )
+{
+    // Update enabled count.
+    const bool enabled = pSceneObject->isEnabled();
+    if ( enabled != pSceneObject->mTickCountedEnabled )
+    {
+        if ( enabled )
+            mEnabledSceneObjectCount++;
+        else
+            mEnabledSceneObjectCount--;
+
+        pSceneObject->mTickCountedEnabled = enabled;
+    }
+
+    // Update visible count.
+    const bool visible = pSceneObject->getVisible();
+    if ( visible != pSceneObject->mTickCountedVisible )
+    {
+        if ( visible )
+            mVisibleSceneObjectCount++;
+        else
+            mVisibleSceneObjectCount--;
+
+        pSceneObject->mTickCountedVisible = visible;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 SceneObject* Scene::getSceneObject( const U32 objectIndex ) const
 {
     // Sanity!
@@ -1589,6 +2246,35 @@ void Scene::mergeScene( const Scene* pScene )
 
 //-----------------------------------------------------------------------------
 
+bool Scene::openStreamingLevel( const char* pIndexFile )
+{
+    // Create the streamer if required.
+    if ( mpStreamer == NULL )
+        mpStreamer = new SceneStreamer( this );
+
+    // Open the level.
+    if ( mpStreamer->open( pIndexFile ) )
+        return true;
+
+    closeStreamingLevel();
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::closeStreamingLevel( void )
+{
+    // Finish if no streamer.
+    if ( mpStreamer == NULL )
+        return;
+
+    // Delete the streamer.  This unloads all resident cells.
+    delete mpStreamer;
+    mpStreamer = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
 b2Joint* Scene::findJoint( const S32 jointId )
 {
     // Find joint.
@@ -3662,6 +4348,21 @@ bool Scene::isSceneWindowAttached( SceneWindow* pSceneWindow2D )
 
 //-----------------------------------------------------------------------------
 
+S32 QSORT_CALLBACK Scene::deleteRequestSort(const void* a, const void* b)
+{
+    // Fetch delete requests.
+    const tDeleteRequest* pDeleteRequestA = static_cast<const tDeleteRequest*>(a);
+    const tDeleteRequest* pDeleteRequestB = static_cast<const tDeleteRequest*>(b);
+
+    // Sort by descending object Id.
+    if ( pDeleteRequestA->mObjectId > pDeleteRequestB->mObjectId )
+        return -1;
+
+    return pDeleteRequestA->mObjectId < pDeleteRequestB->mObjectId ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+
 void Scene::addDeleteRequest( SceneObject* pSceneObject )
 {
     // Ignore if it's already being safe-deleted.
@@ -3738,6 +4439,12 @@ void Scene::processDeleteRequests( const bool forceImmediate )
     //          the list whilst this is happening so we'll transfer it to a temporary list.
     mDeleteRequestsTemp = mDeleteRequests;
 
+    // Delete the most recently created objects first.
+    // NOTE:-   Objects are typically at the back of their group when deleted in this order so removing
+    //          them from the group is cheap.  Deleting thousands of objects in creation order would
+    //          shuffle the group's object list once for every object.
+    dQsort( mDeleteRequestsTemp.address(), mDeleteRequestsTemp.size(), sizeof(tDeleteRequest), deleteRequestSort );
+
     // Can we process all remaining delete-requests?
     if ( safeDeleteReadyCount == (U32)mDeleteRequestsTemp.size() )
     {
@@ -3760,7 +4467,7 @@ void Scene::processDeleteRequests( const bool forceImmediate )
     else
     {
         // No, so process only safe-ready delete-requests.
-        for ( U32 requestIndex = 0; requestIndex <(U32) mDeleteRequestsTemp.size(); )
+        for ( U32 requestIndex = 0; requestIndex <(U32) mDeleteRequestsTemp.size(); ++requestIndex )
         {
             // Fetch Reference to Delete Request.
             tDeleteRequest& deleteRequest = mDeleteRequestsTemp[requestIndex];
@@ -3776,17 +4483,12 @@ void Scene::processDeleteRequests( const bool forceImmediate )
 
                 // Destroy the object.
                 pSceneObject->deleteObject();
-
-                // Quickly remove delete-request.
-                mDeleteRequestsTemp.erase_fast( requestIndex );
-
-                // Repeat this item.
-                continue;
             }
-
-            // Skip to next request index.
-            ++requestIndex;
         }
+
+        // Remove All delete-requests.
+        // NOTE:-   Requests that were not ready remain in the delete-request list.
+        mDeleteRequestsTemp.clear();
     }
 }
 
@@ -75,14 +75,21 @@
 #include "assets/assetPtr.h"
 #endif
 
+#ifndef _LIGHTWEIGHT_SPRITE_REGISTRY_H_
+#include "2d/scene/LightweightSpriteRegistry.h"
+#endif
+
 //-----------------------------------------------------------------------------
 
 extern EnumTable jointTypeTable;
 
 ///-----------------------------------------------------------------------------
 
+class Scene;
 class SceneObject;
 class SceneWindow;
+class PhysicsTaskExecutor;
+class SceneStreamer;
 
 ///-----------------------------------------------------------------------------
 
@@ -144,6 +151,19 @@ struct TickContact
         return pMe == mpFixtureA ? mpFixtureB : mpFixtureA;
     }
 
+    /// A contact event is killed if either object is removed from the scene while it is being dispatched.
+    inline void kill( void )
+    {
+        mpContact = NULL;
+        mpSceneObjectA = mpSceneObjectB = NULL;
+        mpFixtureA = mpFixtureB = NULL;
+    }
+
+    inline bool isDead( void ) const
+    {
+        return mpSceneObjectA == NULL || mpSceneObjectB == NULL;
+    }
+
     b2Contact*      mpContact;
     SceneObject*    mpSceneObjectA;
     SceneObject*    mpSceneObjectB;
@@ -157,6 +177,21 @@ struct TickContact
 
 ///-----------------------------------------------------------------------------
 
+/// A native listener that receives a whole tick's contacts at once.
+/// Contacts involving objects being deleted are not reported.  If the listener
+/// removes objects while handling the contacts, their contacts are killed in place
+/// so check TickContact::isDead() on any contact handled after that.
+class SceneContactListener
+{
+public:
+    virtual ~SceneContactListener() {}
+
+    virtual void onSceneEndContacts( Scene* pScene, const TickContact* pContacts, const U32 contactCount ) = 0;
+    virtual void onSceneBeginContacts( Scene* pScene, const TickContact* pContacts, const U32 contactCount ) = 0;
+};
+
+///-----------------------------------------------------------------------------
+
 class Scene :
     public BehaviorComponent,
     public TamlChildren,
@@ -173,6 +208,23 @@ public:
     typedef HashMap<b2Contact*, TickContact>    typeContactHash;
     typedef Vector<AssetPtr<AssetBase>*>        typeAssetPtrVector;
 
+    /// Contact listener and the scene groups it is interested in.
+    struct ContactListenerEntry
+    {
+        SceneContactListener*   mpListener;
+        U32                     mGroupMask;
+    };
+    typedef Vector<ContactListenerEntry>        typeContactListenerVector;
+    typedef HashTable<SceneObject*, U32>        typeContactPairHash;
+
+    /// Scene object tick event reported by the batched callback.
+    struct TickEventEntry
+    {
+        SimObjectId             mObjectId;
+        U32                     mTickEvent;
+    };
+    typedef Vector<TickEventEntry>              typeTickEventVector;
+
     /// Scene Debug Options.
     enum DebugOption
     {
@@ -217,6 +269,8 @@ private:
     b2Vec2                      mWorldGravity;
     S32                         mVelocityIterations;
     S32                         mPositionIterations;
+    S32                         mPhysicsWorkerCount;
+    PhysicsTaskExecutor*        mpPhysicsTaskExecutor;
     b2BlockAllocator            mBlockAllocator;
     b2Body*                     mpGroundBody;
 
@@ -224,6 +278,12 @@ private:
     typeSceneObjectVector       mSceneObjects;
     typeSceneObjectVector       mTickedSceneObjects;
 
+    /// Active tick set.
+    typeSceneObjectVector       mActiveSceneObjects;
+    typeSceneObjectVector       mWatchedSceneObjects;
+    U32                         mEnabledSceneObjectCount;
+    U32                         mVisibleSceneObjectCount;
+
     /// Joint access.
     typeJointHash               mJoints;
     typeReverseJointHash        mReverseJoints;
@@ -250,6 +310,12 @@ private:
     /// Batch rendering.
     BatchRender                 mBatchRenderer;
 
+    /// Lightweight sprites.
+    LightweightSpriteRegistry   mLightweightSprites;
+
+    /// Level streaming.
+    SceneStreamer*              mpStreamer;
+
     /// Window rendering.
     SceneWindow*                mpCurrentRenderWindow;
 
@@ -268,11 +334,40 @@ private:
     typeContactVector           mEndContacts;
     U32                         mSceneIndex;
 
+    /// Contact events.
+    typeContactListenerVector   mContactListeners;
+    typeContactVector           mBeginContactEvents;
+    typeContactVector           mEndContactEvents;
+    typeContactVector           mFilteredContactEvents;
+    typeContactListenerVector   mDispatchContactListeners;
+    U32                         mDeadContactEvents;
+    typeContactPairHash         mContactPairs;
+    bool                        mBatchContactCallback;
+    bool                        mCoalesceContacts;
+
+    /// Batched tick events.
+    U32                         mBatchCallbackGroupMask;
+    typeTickEventVector         mTickEvents;
+
 private:   
     /// Contacts.
     void                        forwardContacts( void );
     void                        dispatchBeginContactCallbacks( void );
     void                        dispatchEndContactCallbacks( void );
+    void                        bufferContactEvents( void );
+    void                        bufferContactEvent( typeContactVector& events, const TickContact& tickContact );
+    void                        killContactEvents( typeContactVector& events, const SceneObject* pSceneObject );
+    void                        compactContactEvents( typeContactVector& events );
+    void                        compactDeadContactEvents( void );
+    S32                         findContactListener( const SceneContactListener* pListener ) const;
+    void                        dispatchContactListeners( void );
+    void                        dispatchBatchContactCallback( void );
+
+    /// Tick events.
+    void                        dispatchBatchTickEventCallback( void );
+
+    /// Delete requests.
+    static S32 QSORT_CALLBACK   deleteRequestSort( const void* a, const void* b );
 
     /// Joint definition.
     struct CommonJointDefinition
@@ -320,6 +415,25 @@ public:
     const typeContactHash&  getBeginContacts( void ) const              { return mBeginContacts; }
     const typeContactVector& getEndContacts( void ) const               { return mEndContacts; }
 
+    /// Contact events.
+    void                    addContactListener( SceneContactListener* pListener, const U32 groupMask = MASK_ALL );
+    void                    removeContactListener( SceneContactListener* pListener );
+    inline void             setBatchContactCallback( const bool callback ) { mBatchContactCallback = callback; }
+    inline bool             getBatchContactCallback( void ) const       { return mBatchContactCallback; }
+    inline void             setCoalesceContacts( const bool coalesce )  { mCoalesceContacts = coalesce; }
+    inline bool             getCoalesceContacts( void ) const           { return mCoalesceContacts; }
+    const typeContactVector& getBeginContactEvents( void ) const        { return mBeginContactEvents; }
+    const typeContactVector& getEndContactEvents( void ) const          { return mEndContactEvents; }
+    const char*             formatContactEvent( const TickContact& tickContact, const bool beginContact ) const;
+
+    /// Tick events.
+    /// Scene objects in the batched scene groups report their tick callbacks with a single 'onSceneTickEvents' callback.
+    inline void             setBatchCallbackGroupMask( const U32 groupMask ) { mBatchCallbackGroupMask = groupMask; }
+    inline U32              getBatchCallbackGroupMask( void ) const     { return mBatchCallbackGroupMask; }
+    void                    bufferTickEvent( const SceneObject* pSceneObject, const U32 tickEvent );
+    const typeTickEventVector& getTickEvents( void ) const              { return mTickEvents; }
+    const char*             formatTickEvent( const TickEventEntry& tickEvent ) const;
+
     /// Integration.
     virtual void            processTick();
     virtual void            interpolateTick( F32 delta );
@@ -340,6 +454,9 @@ public:
     inline S32              getVelocityIterations( void ) const         { return mVelocityIterations; }
     inline void             setPositionIterations( const S32 iterations ) { mPositionIterations = iterations; }
     inline S32              getPositionIterations( void ) const         { return mPositionIterations; }
+    void                    setPhysicsWorkerCount( const S32 workerCount );
+    inline S32              getPhysicsWorkerCount( void ) const         { return mPhysicsWorkerCount; }
+    F32                     benchmarkLiquidParticles( const U32 particleCount, const U32 stepCount );
 
     /// Scene occupancy.
     void                    clearScene( bool deleteObjects = true );
@@ -354,6 +471,18 @@ public:
 
     void                    mergeScene( const Scene* pScene );
 
+    /// Active tick set.
+    void                    activateSceneObject( SceneObject* pSceneObject );
+    void                    updateSceneObjectStats( SceneObject* pSceneObject );
+
+    /// Lightweight sprites.
+    inline LightweightSpriteRegistry& getLightweightSprites( void )     { return mLightweightSprites; }
+
+    /// Level streaming.
+    bool                    openStreamingLevel( const char* pIndexFile );
+    void                    closeStreamingLevel( void );
+    inline SceneStreamer*   getStreamer( void ) const                   { return mpStreamer; }
+
     inline SimSet*			getControllers( void )						{ return mControllers; }
 
     inline S32              getAssetPreloadCount( void ) const          { return mAssetPreloads.size(); }
@@ -689,6 +818,8 @@ protected:
     static bool writeGravity( void* obj, StringTableEntry pFieldName )              { return Vector2(static_cast<Scene*>(obj)->getGravity()).notEqual( Vector2::getZero() ); }
     static bool writeVelocityIterations( void* obj, StringTableEntry pFieldName )   { return static_cast<Scene*>(obj)->getVelocityIterations() != 8; }
     static bool writePositionIterations( void* obj, StringTableEntry pFieldName )   { return static_cast<Scene*>(obj)->getPositionIterations() != 3; }
+    static bool setPhysicsWorkerCount( void* obj, const char* data )                { static_cast<Scene*>(obj)->setPhysicsWorkerCount( dAtoi(data) ); return false; }
+    static bool writePhysicsWorkerCount( void* obj, StringTableEntry pFieldName )   { return static_cast<Scene*>(obj)->getPhysicsWorkerCount() != 1; }
 
     static bool writeLayerSortMode( void* obj, StringTableEntry pFieldName )
     {
@@ -723,6 +854,9 @@ protected:
     // Callbacks.
     static bool writeUpdateCallback( void* obj, StringTableEntry pFieldName )       { return static_cast<Scene*>(obj)->getUpdateCallback(); }
     static bool writeRenderCallback( void* obj, StringTableEntry pFieldName )       { return static_cast<Scene*>(obj)->getRenderCallback(); }
+    static bool writeBatchContactCallback( void* obj, StringTableEntry pFieldName ) { return static_cast<Scene*>(obj)->getBatchContactCallback(); }
+    static bool writeCoalesceContacts( void* obj, StringTableEntry pFieldName )     { return static_cast<Scene*>(obj)->getCoalesceContacts(); }
+    static bool writeBatchCallbackGroupMask( void* obj, StringTableEntry pFieldName ) { return static_cast<Scene*>(obj)->getBatchCallbackGroupMask() != 0; }
 
 public:
     static SimObjectPtr<Scene> LoadingScene;
@@ -0,0 +1,780 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "SceneStreamer.h"
+
+#ifndef _SCENE_H_
+#include "2d/scene/Scene.h"
+#endif
+
+#ifndef _SCENE_OBJECT_H_
+#include "2d/sceneobject/SceneObject.h"
+#endif
+
+#ifndef _TAML_H_
+#include "persistence/taml/taml.h"
+#endif
+
+#ifndef _MEMSTREAM_H_
+#include "io/memstream.h"
+#endif
+
+#ifndef _FILESTREAM_H_
+#include "io/fileStream.h"
+#endif
+
+#ifndef _FRAMEALLOCATOR_H_
+#include "memory/frameAllocator.h"
+#endif
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+#define SCENE_STREAMER_SIGNATURE    "SceneStream"
+
+//-----------------------------------------------------------------------------
+
+SceneStreamer::SceneStreamer( Scene* pScene ) :
+    mpScene( pScene ),
+    mIndexFile( StringTable->EmptyString ),
+    mCellSize( 0.0f ),
+    mLoadDistance( 50.0f ),
+    mUnloadDistance( 75.0f ),
+    mBatchSize( DefaultBatchSize ),
+    mpIOThread( NULL ),
+    mIORequested( 0 ),
+    mIOShutdown( false )
+{
+    // Set Vector Associations.
+    VECTOR_SET_ASSOCIATION( mCells );
+    VECTOR_SET_ASSOCIATION( mFocus );
+    VECTOR_SET_ASSOCIATION( mFocusPositions );
+    VECTOR_SET_ASSOCIATION( mIORequests );
+    VECTOR_SET_ASSOCIATION( mIOCompleted );
+}
+
+//-----------------------------------------------------------------------------
+
+SceneStreamer::~SceneStreamer()
+{
+    close();
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneStreamer::open( const char* pIndexFile )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneStreamer_Open);
+
+    // Close any current level.
+    close();
+
+    // Expand the index path.
+    char indexPath[1024];
+    Con::expandPath( indexPath, sizeof(indexPath), pIndexFile );
+
+    FileStream stream;
+
+    // File opened?
+    if ( !stream.open( indexPath, FileStream::Read ) )
+    {
+        // No, so warn.
+        Con::warnf( "SceneStreamer::open() - Could not open index file '%s'.", indexPath );
+        return false;
+    }
+
+    // Is the signature correct?
+    if ( stream.readSTString() != StringTable->insert( SCENE_STREAMER_SIGNATURE ) )
+    {
+        // No, so warn.
+        Con::warnf( "SceneStreamer::open() - File '%s' is not a streaming level index.", indexPath );
+        return false;
+    }
+
+    // Is the version supported?
+    U32 versionId;
+    stream.read( &versionId );
+    if ( versionId != IndexVersion )
+    {
+        // No, so warn.
+        Con::warnf( "SceneStreamer::open() - Index file '%s' has unsupported version '%d'.", indexPath, versionId );
+        return false;
+    }
+
+    // Read cell size and count.
+    U32 cellCount;
+    stream.read( &mCellSize );
+    stream.read( &cellCount );
+
+    // Fetch the index directory.
+    char indexDirectory[1024];
+    dStrcpy( indexDirectory, indexPath );
+    char* pSlash = dStrrchr( indexDirectory, '/' );
+    if ( pSlash != NULL )
+        *pSlash = 0;
+
+    // Read cells.
+    mCells.reserve( cellCount );
+    for ( U32 index = 0; index < cellCount; ++index )
+    {
+        Cell* pCell = new Cell();
+        stream.read( &pCell->mCellX );
+        stream.read( &pCell->mCellY );
+        stream.read( &pCell->mObjectCount );
+        stream.read( &pCell->mFileSize );
+
+        // Format the cell path.
+        char cellPath[1024];
+        dSprintf( cellPath, sizeof(cellPath), "%s/%s", indexDirectory, stream.readSTString() );
+        pCell->mFilePath = StringTable->insert( cellPath );
+
+        // Calculate the cell bounds.
+        pCell->mAABB.lowerBound.Set( pCell->mCellX * mCellSize, pCell->mCellY * mCellSize );
+        pCell->mAABB.upperBound.Set( (pCell->mCellX+1) * mCellSize, (pCell->mCellY+1) * mCellSize );
+
+        pCell->mState = CellUnloaded;
+        pCell->mDiscardRead = false;
+        pCell->mReadFailed = false;
+        pCell->mpData = NULL;
+        pCell->mDataSize = 0;
+        pCell->mPendingIndex = 0;
+
+        mCells.push_back( pCell );
+    }
+
+    // Was the index read correctly?
+    if ( stream.getStatus() != Stream::Ok && stream.getStatus() != Stream::EOS )
+    {
+        // No, so warn.
+        Con::warnf( "SceneStreamer::open() - Index file '%s' is truncated.", indexPath );
+        close();
+        return false;
+    }
+
+    mIndexFile = StringTable->insert( indexPath );
+
+    // Start the I/O thread.
+    mIOShutdown = false;
+    mpIOThread = new Thread( &SceneStreamer::ioThread, this, true );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::close( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneStreamer_Close);
+
+    // Stop the I/O thread.
+    if ( mpIOThread != NULL )
+    {
+        mIOMutex.lock();
+        mIOShutdown = true;
+        mIOMutex.unlock();
+        mIORequested.release();
+
+        mpIOThread->join();
+        delete mpIOThread;
+        mpIOThread = NULL;
+    }
+
+    mIORequests.clear();
+    mIOCompleted.clear();
+
+    // Unload and delete all cells.
+    for ( S32 index = 0; index < mCells.size(); ++index )
+    {
+        Cell* pCell = mCells[index];
+
+        unloadCell( pCell );
+
+        delete [] pCell->mpData;
+        delete pCell;
+    }
+    mCells.clear();
+
+    mIndexFile = StringTable->EmptyString;
+    mCellSize = 0.0f;
+}
+
+//-----------------------------------------------------------------------------
+
+static S32 QSORT_CALLBACK compareCellObjects( const void* a, const void* b )
+{
+    const S32* pA = (const S32*)a;
+    const S32* pB = (const S32*)b;
+
+    // Sort by cell then by scene order.
+    for ( U32 index = 0; index < 3; ++index )
+    {
+        if ( pA[index] != pB[index] )
+            return pA[index] < pB[index] ? -1 : 1;
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneStreamer::writeLevel( Scene* pScene, const char* pIndexFile, const F32 cellSize )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneStreamer_WriteLevel);
+
+    // Sanity!
+    AssertFatal( pScene != NULL, "SceneStreamer::writeLevel() - Cannot write a NULL scene." );
+
+    // Is the cell size valid?
+    if ( cellSize <= 0.0f )
+    {
+        // No, so warn.
+        Con::warnf( "SceneStreamer::writeLevel() - Invalid cell size of '%g'.", cellSize );
+        return false;
+    }
+
+    // Expand the index path.
+    char indexPath[1024];
+    Con::expandPath( indexPath, sizeof(indexPath), pIndexFile );
+
+    // Fetch the cell file prefix from the index path without its extension.
+    char cellPrefix[1024];
+    dStrcpy( cellPrefix, indexPath );
+    char* pSlash = dStrrchr( cellPrefix, '/' );
+    char* pExtension = dStrrchr( cellPrefix, '.' );
+    if ( pExtension != NULL && pExtension > pSlash )
+        *pExtension = 0;
+    const char* pCellName = pSlash != NULL ? pSlash + 1 : cellPrefix;
+
+    // Sort the scene objects into cells as (cellX, cellY, sceneIndex).
+    const U32 objectCount = pScene->getSceneObjectCount();
+    Vector<S32> cellObjects( __FILE__, __LINE__ );
+    cellObjects.setSize( objectCount * 3 );
+    for ( U32 index = 0; index < objectCount; ++index )
+    {
+        const Vector2 position = pScene->getSceneObject( index )->getPosition();
+        cellObjects[index*3+0] = (S32)mFloor( position.x / cellSize );
+        cellObjects[index*3+1] = (S32)mFloor( position.y / cellSize );
+        cellObjects[index*3+2] = (S32)index;
+    }
+    dQsort( cellObjects.address(), objectCount, sizeof(S32) * 3, compareCellObjects );
+
+    // Count the cells.
+    U32 cellCount = 0;
+    for ( U32 index = 0; index < objectCount; ++index )
+    {
+        if ( index == 0 || cellObjects[index*3] != cellObjects[(index-1)*3] || cellObjects[index*3+1] != cellObjects[(index-1)*3+1] )
+            ++cellCount;
+    }
+
+    FileStream stream;
+
+    // File opened?
+    if ( !stream.open( indexPath, FileStream::Write ) )
+    {
+        // No, so warn.
+        Con::warnf( "SceneStreamer::writeLevel() - Could not open index file '%s' for write.", indexPath );
+        return false;
+    }
+
+    // Write the index header.
+    stream.writeString( SCENE_STREAMER_SIGNATURE );
+    stream.write( (U32)IndexVersion );
+    stream.write( cellSize );
+    stream.write( cellCount );
+
+    // Cells are binary Taml.
+    Taml taml;
+    taml.setFormatMode( Taml::BinaryFormat );
+    taml.setAutoFormat( false );
+
+    // Write the cells.
+    bool success = true;
+    for ( U32 start = 0; start < objectCount; )
+    {
+        const S32 cellX = cellObjects[start*3+0];
+        const S32 cellY = cellObjects[start*3+1];
+
+        // Gather the cell objects.
+        SimSet* pCellSet = new SimSet();
+        pCellSet->registerObject();
+
+        U32 end = start;
+        for ( ; end < objectCount && cellObjects[end*3+0] == cellX && cellObjects[end*3+1] == cellY; ++end )
+        {
+            pCellSet->addObject( pScene->getSceneObject( cellObjects[end*3+2] ) );
+        }
+
+        // Write the cell.
+        char cellFile[256];
+        char cellPath[1024];
+        dSprintf( cellFile, sizeof(cellFile), "%s_%d_%d.baml", pCellName, cellX, cellY );
+        dSprintf( cellPath, sizeof(cellPath), "%s_%d_%d.baml", cellPrefix, cellX, cellY );
+        if ( !taml.write( pCellSet, cellPath ) )
+        {
+            // Warn.
+            Con::warnf( "SceneStreamer::writeLevel() - Could not write cell file '%s'.", cellPath );
+            success = false;
+        }
+
+        // The cell set does not own its objects.
+        pCellSet->deleteObject();
+
+        // Write the cell entry.
+        stream.write( cellX );
+        stream.write( cellY );
+        stream.write( end - start );
+        stream.write( (U32)getMax( Platform::getFileSize( cellPath ), 0 ) );
+        stream.writeString( cellFile );
+
+        start = end;
+    }
+
+    stream.close();
+
+    return success;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::setFocus( const U32 focusIndex, const Vector2& position )
+{
+    // Add focus points as required.
+    while ( (U32)mFocus.size() <= focusIndex )
+    {
+        mFocus.increment();
+        mFocus.last().mActive = false;
+    }
+
+    Focus& focus = mFocus[focusIndex];
+    focus.mPosition = position;
+    focus.mObject = NULL;
+    focus.mActive = true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::setFocus( const U32 focusIndex, SceneObject* pSceneObject )
+{
+    // Sanity!
+    AssertFatal( pSceneObject != NULL, "SceneStreamer::setFocus() - Cannot focus on a NULL object." );
+
+    setFocus( focusIndex, pSceneObject->getPosition() );
+    mFocus[focusIndex].mObject = pSceneObject;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::removeFocus( const U32 focusIndex )
+{
+    if ( focusIndex < (U32)mFocus.size() )
+    {
+        mFocus[focusIndex].mObject = NULL;
+        mFocus[focusIndex].mActive = false;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::setDistances( const F32 loadDistance, const F32 unloadDistance )
+{
+    mLoadDistance = getMax( loadDistance, 0.0f );
+    mUnloadDistance = getMax( unloadDistance, mLoadDistance );
+}
+
+//-----------------------------------------------------------------------------
+
+F32 SceneStreamer::getFocusDistance( const Cell& cell ) const
+{
+    F32 nearestDistanceSquared = F32_MAX;
+
+    for ( S32 index = 0; index < mFocusPositions.size(); ++index )
+    {
+        const Vector2& position = mFocusPositions[index];
+
+        // Distance from the focus to the cell bounds.
+        const F32 dx = getMax( getMax( cell.mAABB.lowerBound.x - position.x, position.x - cell.mAABB.upperBound.x ), 0.0f );
+        const F32 dy = getMax( getMax( cell.mAABB.lowerBound.y - position.y, position.y - cell.mAABB.upperBound.y ), 0.0f );
+        nearestDistanceSquared = getMin( nearestDistanceSquared, dx*dx + dy*dy );
+    }
+
+    return nearestDistanceSquared == F32_MAX ? F32_MAX : mSqrt( nearestDistanceSquared );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::update( void )
+{
+    // Finish if nothing is open.
+    if ( mCells.size() == 0 )
+        return;
+
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneStreamer_Update);
+
+    // Receive completed reads.
+    receiveReads();
+
+    // Fetch the focus positions.
+    mFocusPositions.clear();
+    for ( S32 index = 0; index < mFocus.size(); ++index )
+    {
+        Focus& focus = mFocus[index];
+
+        if ( !focus.mActive )
+            continue;
+
+        // Follow any focus object.
+        if ( !focus.mObject.isNull() )
+            focus.mPosition = focus.mObject->getPosition();
+
+        mFocusPositions.push_back( focus.mPosition );
+    }
+
+    // Update the cell states.
+    for ( S32 index = 0; index < mCells.size(); ++index )
+    {
+        Cell* pCell = mCells[index];
+
+        const F32 distance = getFocusDistance( *pCell );
+
+        switch( pCell->mState )
+        {
+            case CellUnloaded:
+                if ( distance <= mLoadDistance && !pCell->mReadFailed )
+                    requestRead( pCell );
+                break;
+
+            case CellReading:
+                pCell->mDiscardRead = distance > mUnloadDistance;
+                break;
+
+            default:
+                if ( distance > mUnloadDistance )
+                    unloadCell( pCell );
+                break;
+        }
+    }
+
+    // Parse a single cell per tick.
+    for ( S32 index = 0; index < mCells.size(); ++index )
+    {
+        if ( mCells[index]->mState == CellRead )
+        {
+            parseCell( mCells[index] );
+            break;
+        }
+    }
+
+    // Add parsed objects to the scene in a bounded batch.
+    U32 budget = mBatchSize;
+    for ( S32 index = 0; index < mCells.size() && budget > 0; ++index )
+    {
+        if ( mCells[index]->mState == CellLoading )
+            budget -= addPendingObjects( mCells[index], budget );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::requestRead( Cell* pCell )
+{
+    pCell->mState = CellReading;
+    pCell->mDiscardRead = false;
+
+    mIOMutex.lock();
+    mIORequests.push_back( pCell );
+    mIOMutex.unlock();
+
+    mIORequested.release();
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::receiveReads( void )
+{
+    // Fetch the completed reads.
+    FrameAllocatorMarker frameMarker;
+    Vector<Cell*> completed( __FILE__, __LINE__ );
+    completed.setAllocator( &FrameVectorAllocator::smAllocator );
+    mIOMutex.lock();
+    completed.merge( mIOCompleted );
+    mIOCompleted.clear();
+    mIOMutex.unlock();
+
+    for ( S32 index = 0; index < completed.size(); ++index )
+    {
+        Cell* pCell = completed[index];
+
+        // Did the read fail?
+        if ( pCell->mpData == NULL )
+        {
+            // Yes, so warn and don't try again.
+            Con::warnf( "SceneStreamer - Could not read cell file '%s'.", pCell->mFilePath );
+            pCell->mReadFailed = true;
+            pCell->mState = CellUnloaded;
+            continue;
+        }
+
+        // Has the cell gone out of range whilst reading?
+        if ( pCell->mDiscardRead )
+        {
+            // Yes, so discard it.
+            delete [] pCell->mpData;
+            pCell->mpData = NULL;
+            pCell->mState = CellUnloaded;
+            continue;
+        }
+
+        pCell->mState = CellRead;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::ioThread( void* pArg )
+{
+    static_cast<SceneStreamer*>( pArg )->processIO();
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::processIO( void )
+{
+    while( true )
+    {
+        // Wait for a request.
+        mIORequested.acquire();
+
+        // Fetch the next request.
+        mIOMutex.lock();
+        if ( mIOShutdown )
+        {
+            mIOMutex.unlock();
+            return;
+        }
+        if ( mIORequests.size() == 0 )
+        {
+            mIOMutex.unlock();
+            continue;
+        }
+        Cell* pCell = mIORequests.first();
+        mIORequests.erase( 0U );
+        mIOMutex.unlock();
+
+        // Read the cell file.
+        U8* pData = NULL;
+        U32 dataSize = 0;
+        FileStream stream;
+        if ( stream.open( pCell->mFilePath, FileStream::Read ) )
+        {
+            dataSize = stream.getStreamSize();
+            if ( dataSize > 0 )
+            {
+                pData = new U8[dataSize];
+                if ( !stream.read( dataSize, pData ) )
+                {
+                    delete [] pData;
+                    pData = NULL;
+                }
+            }
+            stream.close();
+        }
+
+        // Complete the request.
+        mIOMutex.lock();
+        pCell->mpData = pData;
+        pCell->mDataSize = dataSize;
+        mIOCompleted.push_back( pCell );
+        mIOMutex.unlock();
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::parseCell( Cell* pCell )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneStreamer_ParseCell);
+
+    // Parse the cell.
+    MemStream stream( pCell->mDataSize, pCell->mpData, true, false );
+    Taml taml;
+    SimObject* pSimObject = taml.readBinary( stream );
+
+    // Release the read buffer.
+    delete [] pCell->mpData;
+    pCell->mpData = NULL;
+    pCell->mDataSize = 0;
+
+    // Fetch the cell set.
+    SimSet* pCellSet = dynamic_cast<SimSet*>( pSimObject );
+
+    // Is the cell valid?
+    if ( pCellSet == NULL )
+    {
+        // No, so warn and don't try again.
+        Con::warnf( "SceneStreamer - Cell file '%s' does not contain a cell.", pCell->mFilePath );
+        if ( pSimObject != NULL )
+            pSimObject->deleteObject();
+        pCell->mReadFailed = true;
+        pCell->mState = CellUnloaded;
+        return;
+    }
+
+    pCell->mPendingSet = pCellSet;
+    pCell->mPendingIndex = 0;
+    pCell->mObjects.reserve( pCellSet->size() );
+    pCell->mState = CellLoading;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SceneStreamer::addPendingObjects( Cell* pCell, const U32 budget )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneStreamer_AddPendingObjects);
+
+    SimSet* pCellSet = pCell->mPendingSet;
+
+    U32 added = 0;
+
+    if ( pCellSet != NULL )
+    {
+        while ( added < budget && pCell->mPendingIndex < pCellSet->size() )
+        {
+            SimObject* pSimObject = pCellSet->at( pCell->mPendingIndex );
+            SceneObject* pSceneObject = dynamic_cast<SceneObject*>( pSimObject );
+
+            // Is this a scene object?
+            if ( pSceneObject == NULL )
+            {
+                // No, so warn and delete it.
+                Con::warnf( "SceneStreamer - Cell file '%s' contains a '%s' which is not a scene object.", pCell->mFilePath, pSimObject->getClassName() );
+                pSimObject->deleteObject();
+                continue;
+            }
+
+            mpScene->addToScene( pSceneObject );
+            pCell->mObjects.push_back( pSceneObject->getId() );
+
+            ++pCell->mPendingIndex;
+            ++added;
+        }
+
+        // Finish if there are more to add.
+        if ( pCell->mPendingIndex < pCellSet->size() )
+            return added;
+
+        // The cell set does not own its objects.
+        pCellSet->deleteObject();
+    }
+
+    pCell->mPendingSet = NULL;
+    pCell->mPendingIndex = 0;
+    pCell->mState = CellResident;
+
+    return added;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::unloadCell( Cell* pCell )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneStreamer_UnloadCell);
+
+    // Delete any objects not yet added to the scene.
+    SimSet* pCellSet = pCell->mPendingSet;
+    if ( pCellSet != NULL )
+    {
+        while ( pCell->mPendingIndex < pCellSet->size() )
+            pCellSet->last()->deleteObject();
+
+        pCellSet->deleteObject();
+    }
+    pCell->mPendingSet = NULL;
+    pCell->mPendingIndex = 0;
+
+    // Delete the objects added to the scene.
+    for ( S32 index = 0; index < pCell->mObjects.size(); ++index )
+    {
+        SceneObject* pSceneObject = dynamic_cast<SceneObject*>( Sim::findObject( pCell->mObjects[index] ) );
+
+        if ( pSceneObject != NULL )
+            pSceneObject->safeDelete();
+    }
+    pCell->mObjects.clear();
+
+    // Release any unparsed data.
+    if ( pCell->mState == CellRead )
+    {
+        delete [] pCell->mpData;
+        pCell->mpData = NULL;
+        pCell->mDataSize = 0;
+    }
+
+    pCell->mState = CellUnloaded;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::getMetrics( Metrics& metrics ) const
+{
+    metrics.mResidentCells = 0;
+    metrics.mResidentObjects = 0;
+    metrics.mResidentBytes = 0;
+    metrics.mPendingCells = 0;
+
+    for ( S32 index = 0; index < mCells.size(); ++index )
+    {
+        const Cell* pCell = mCells[index];
+
+        switch( pCell->mState )
+        {
+            case CellResident:
+                ++metrics.mResidentCells;
+                metrics.mResidentObjects += pCell->mObjects.size();
+                metrics.mResidentBytes += pCell->mFileSize;
+                break;
+
+            case CellLoading:
+                ++metrics.mPendingCells;
+                metrics.mResidentObjects += pCell->mObjects.size();
+                metrics.mResidentBytes += pCell->mFileSize;
+                break;
+
+            case CellReading:
+            case CellRead:
+                ++metrics.mPendingCells;
+                break;
+
+            default:
+                break;
+        }
+    }
+}
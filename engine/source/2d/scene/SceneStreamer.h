@@ -0,0 +1,184 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _SCENE_STREAMER_H_
+#define _SCENE_STREAMER_H_
+
+#ifndef _VECTOR2_H_
+#include "2d/core/Vector2.h"
+#endif
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_SEMAPHORE_H_
+#include "platform/threads/semaphore.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class Scene;
+class SceneObject;
+
+//-----------------------------------------------------------------------------
+
+/// Streams the cells of a spatially partitioned level in and out of a scene.
+///
+/// A streaming level is an index file plus one binary Taml file per cell.  Each cell
+/// holds the scene objects whose position fell inside it when the level was written.
+/// Cells within the load distance of any focus are read on a background I/O thread,
+/// parsed on the main thread one cell per tick then added to the scene in bounded
+/// batches.  Cells beyond the unload distance of every focus are removed.  Keeping
+/// the unload distance larger than the load distance stops cells thrashing at a border.
+///
+/// Joints, controllers and asset preloads are not partitioned and should live in the
+/// part of the level that is loaded normally.
+class SceneStreamer
+{
+public:
+    enum
+    {
+        IndexVersion = 1,
+        DefaultBatchSize = 64,
+    };
+
+    enum CellState
+    {
+        CellUnloaded,
+        CellReading,
+        CellRead,
+        CellLoading,
+        CellResident,
+    };
+
+    struct Metrics
+    {
+        U32 mResidentCells;
+        U32 mResidentObjects;
+        U32 mResidentBytes;
+        U32 mPendingCells;
+    };
+
+private:
+    struct Cell
+    {
+        S32                     mCellX;
+        S32                     mCellY;
+        b2AABB                  mAABB;
+        StringTableEntry        mFilePath;
+        U32                     mObjectCount;
+        U32                     mFileSize;
+
+        CellState               mState;
+        bool                    mDiscardRead;
+        bool                    mReadFailed;
+
+        /// Read buffer, owned by the I/O thread while reading.
+        U8*                     mpData;
+        U32                     mDataSize;
+
+        /// Objects parsed but not yet added to the scene.
+        SimObjectPtr<SimSet>    mPendingSet;
+        U32                     mPendingIndex;
+
+        /// Objects added to the scene.
+        Vector<SimObjectId>     mObjects;
+    };
+
+    struct Focus
+    {
+        Vector2                     mPosition;
+        SimObjectPtr<SceneObject>   mObject;
+        bool                        mActive;
+    };
+
+    Scene*                  mpScene;
+    StringTableEntry        mIndexFile;
+    F32                     mCellSize;
+    Vector<Cell*>           mCells;
+    Vector<Focus>           mFocus;
+    Vector<Vector2>         mFocusPositions;
+    F32                     mLoadDistance;
+    F32                     mUnloadDistance;
+    U32                     mBatchSize;
+
+    /// Background I/O.
+    Thread*                 mpIOThread;
+    Semaphore               mIORequested;
+    Mutex                   mIOMutex;
+    Vector<Cell*>           mIORequests;
+    Vector<Cell*>           mIOCompleted;
+    bool                    mIOShutdown;
+
+    static void             ioThread( void* pArg );
+    void                    processIO( void );
+
+    void                    requestRead( Cell* pCell );
+    void                    receiveReads( void );
+    void                    parseCell( Cell* pCell );
+    U32                     addPendingObjects( Cell* pCell, const U32 budget );
+    void                    unloadCell( Cell* pCell );
+    F32                     getFocusDistance( const Cell& cell ) const;
+
+public:
+    SceneStreamer( Scene* pScene );
+    virtual ~SceneStreamer();
+
+    /// Index.
+    bool                    open( const char* pIndexFile );
+    void                    close( void );
+    inline StringTableEntry getIndexFile( void ) const                  { return mIndexFile; }
+    inline F32              getCellSize( void ) const                   { return mCellSize; }
+    inline U32              getCellCount( void ) const                  { return (U32)mCells.size(); }
+
+    /// Write the scene objects of a scene as a streaming level.
+    static bool             writeLevel( Scene* pScene, const char* pIndexFile, const F32 cellSize );
+
+    /// Focus points.
+    void                    setFocus( const U32 focusIndex, const Vector2& position );
+    void                    setFocus( const U32 focusIndex, SceneObject* pSceneObject );
+    void                    removeFocus( const U32 focusIndex );
+
+    /// Streaming control.
+    void                    setDistances( const F32 loadDistance, const F32 unloadDistance );
+    inline F32              getLoadDistance( void ) const               { return mLoadDistance; }
+    inline F32              getUnloadDistance( void ) const             { return mUnloadDistance; }
+    inline void             setBatchSize( const U32 batchSize )         { mBatchSize = getMax( batchSize, (U32)1 ); }
+    inline U32              getBatchSize( void ) const                  { return mBatchSize; }
+
+    /// Update streaming.  Called once per scene tick.
+    void                    update( void );
+
+    void                    getMetrics( Metrics& metrics ) const;
+};
+
+#endif // _SCENE_STREAMER_H_
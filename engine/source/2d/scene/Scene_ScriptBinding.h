@@ -116,6 +116,44 @@ ConsoleMethodWithDocs(Scene, getPositionIterations, ConsoleInt, 2, 2, ())
 
 //-----------------------------------------------------------------------------
 
+/*! Sets the number of threads the physics step uses to solve islands, update contacts and solve particles.
+    The simulation results do not depend on the worker count.
+    @param workerCount The number of workers including the main thread.  A value of one solves on the main thread.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, setPhysicsWorkerCount, ConsoleVoid, 3, 3, (int workerCount))
+{
+    object->setPhysicsWorkerCount( dAtoi(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the number of threads the physics step uses to solve islands and update contacts.
+    @return The number of physics workers including the main thread.
+*/
+ConsoleMethodWithDocs(Scene, getPhysicsWorkerCount, ConsoleInt, 2, 2, ())
+{
+    return object->getPhysicsWorkerCount();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Times the physics step with a block of liquid particles collapsing inside a tank.
+    The benchmark runs in its own physics world with the scene's gravity, iterations and physics worker count.  The scene itself is not changed.
+    @param particleCount The approximate number of liquid particles.  Defaults to 50000.
+    @param stepCount The number of steps to time.  Defaults to 120.
+    @return The average physics step time in milliseconds.
+*/
+ConsoleMethodWithDocs(Scene, benchmarkLiquidParticles, ConsoleFloat, 2, 4, ([particleCount], [stepCount]))
+{
+    const S32 particleCount = argc >= 3 ? dAtoi(argv[2]) : 50000;
+    const S32 stepCount = argc >= 4 ? dAtoi(argv[3]) : 120;
+
+    return object->benchmarkLiquidParticles( (U32)getMax( particleCount, 0 ), (U32)getMax( stepCount, 0 ) );
+}
+
+//-----------------------------------------------------------------------------
+
 /*! Add the SceneObject to the scene.
     @param sceneObject The SceneObject to add to the scene.
     @return No return value.
@@ -368,6 +406,188 @@ ConsoleMethodWithDocs(Scene, mergeScene, ConsoleVoid, 3, 3, (scene))
 
 //-----------------------------------------------------------------------------
 
+/*! Writes the scene objects as a streaming level partitioned into square cells.
+    Each cell is written as a binary Taml file next to the index file and holds the objects whose position is inside it.
+    Joints, controllers and asset preloads are not written.  The scene itself is not changed.
+    @param indexFile The streaming level index file to write.
+    @param cellSize The width and height of each cell in world units.
+    @return Whether the streaming level was written or not.
+*/
+ConsoleMethodWithDocs(Scene, writeStreamingLevel, ConsoleBool, 4, 4, (indexFile, cellSize))
+{
+    return SceneStreamer::writeLevel( object, argv[2], dAtof(argv[3]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Opens a streaming level so that its cells are streamed in and out around the streaming focus points.
+    Any currently open streaming level is closed first.
+    @param level Either a streaming level index file or the asset Id of a LevelAsset with a streaming index.
+    @return Whether the streaming level was opened or not.
+*/
+ConsoleMethodWithDocs(Scene, openStreamingLevel, ConsoleBool, 3, 3, (level))
+{
+    // Is this a level asset?
+    if ( AssetDatabase.isDeclaredAsset( argv[2] ) )
+    {
+        // Yes, so acquire it.
+        LevelAsset* pLevelAsset = AssetDatabase.acquireAsset<LevelAsset>( argv[2] );
+
+        // Is it a level asset?
+        if ( pLevelAsset == NULL )
+        {
+            // No, so warn.
+            Con::warnf( "Scene::openStreamingLevel() - Asset '%s' is not a level asset.", argv[2] );
+            return false;
+        }
+
+        // Open the streaming index.
+        const bool opened = pLevelAsset->getStreamingIndex() != StringTable->EmptyString && object->openStreamingLevel( pLevelAsset->getStreamingIndex() );
+
+        // Release the asset.
+        AssetDatabase.releaseAsset( argv[2] );
+
+        return opened;
+    }
+
+    return object->openStreamingLevel( argv[2] );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Closes any streaming level, deleting all the objects it streamed in.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, closeStreamingLevel, ConsoleVoid, 2, 2, ())
+{
+    object->closeStreamingLevel();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets a streaming focus point.  Cells near any focus point are streamed in.
+    @param focusIndex The focus point to set starting at zero.
+    @param focus Either a world position formatted as (\x y\ or (x, y), or a scene object to follow.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, setStreamingFocus, ConsoleVoid, 4, 5, (focusIndex, x / y | sceneObject))
+{
+    // Fetch the streamer.
+    SceneStreamer* pStreamer = object->getStreamer();
+
+    // Is a streaming level open?
+    if ( pStreamer == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "Scene::setStreamingFocus() - No streaming level is open." );
+        return;
+    }
+
+    const U32 focusIndex = (U32)getMax( dAtoi(argv[2]), 0 );
+
+    // ("x y")
+    if ( argc == 4 )
+    {
+        // Is this a scene object?
+        SceneObject* pSceneObject = Utility::mGetStringElementCount(argv[3]) == 1 ? Sim::findObject<SceneObject>( argv[3] ) : NULL;
+        if ( pSceneObject != NULL )
+        {
+            // Yes, so follow it.
+            pStreamer->setFocus( focusIndex, pSceneObject );
+            return;
+        }
+
+        pStreamer->setFocus( focusIndex, Utility::mGetStringElementVector(argv[3]) );
+        return;
+    }
+
+    // (x, y)
+    pStreamer->setFocus( focusIndex, Vector2( dAtof(argv[3]), dAtof(argv[4]) ) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Removes a streaming focus point.
+    @param focusIndex The focus point to remove.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, removeStreamingFocus, ConsoleVoid, 3, 3, (focusIndex))
+{
+    // Fetch the streamer.
+    SceneStreamer* pStreamer = object->getStreamer();
+
+    if ( pStreamer != NULL )
+        pStreamer->removeFocus( (U32)getMax( dAtoi(argv[2]), 0 ) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets the streaming distances from the focus points.
+    Cells within the load distance of any focus point are streamed in.  Cells beyond the unload distance of every focus point are streamed out.
+    @param loadDistance The distance within which cells are streamed in.
+    @param unloadDistance The distance beyond which cells are streamed out.  This is clamped to be no less than the load distance.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, setStreamingDistances, ConsoleVoid, 4, 4, (loadDistance, unloadDistance))
+{
+    // Fetch the streamer.
+    SceneStreamer* pStreamer = object->getStreamer();
+
+    // Is a streaming level open?
+    if ( pStreamer == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "Scene::setStreamingDistances() - No streaming level is open." );
+        return;
+    }
+
+    pStreamer->setDistances( dAtof(argv[2]), dAtof(argv[3]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets the maximum number of streamed objects added to the scene per tick.
+    @param batchSize The maximum number of objects added per tick.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, setStreamingBatchSize, ConsoleVoid, 3, 3, (batchSize))
+{
+    // Fetch the streamer.
+    SceneStreamer* pStreamer = object->getStreamer();
+
+    // Is a streaming level open?
+    if ( pStreamer == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "Scene::setStreamingBatchSize() - No streaming level is open." );
+        return;
+    }
+
+    pStreamer->setBatchSize( (U32)getMax( dAtoi(argv[2]), 1 ) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the streaming level metrics.
+    @return The metrics formatted as "residentCells residentObjects residentBytes pendingCells" where resident bytes are the cell file sizes.
+*/
+ConsoleMethodWithDocs(Scene, getStreamingMetrics, ConsoleString, 2, 2, ())
+{
+    SceneStreamer::Metrics metrics;
+    dMemset( &metrics, 0, sizeof(metrics) );
+
+    // Fetch the metrics.
+    SceneStreamer* pStreamer = object->getStreamer();
+    if ( pStreamer != NULL )
+        pStreamer->getMetrics( metrics );
+
+    char* pBuffer = Con::getReturnBuffer( 64 );
+    dSprintf( pBuffer, 64, "%d %d %d %d", metrics.mResidentCells, metrics.mResidentObjects, metrics.mResidentBytes, metrics.mPendingCells );
+    return pBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
 /*! Gets the Scene Controllers.
     @return Gets the scene controllers.
 */
@@ -3578,6 +3798,264 @@ ConsoleMethodWithDocs(Scene, setIsEditorScene, ConsoleVoid, 3, 3, ())
 
 //-----------------------------------------------------------------------------
 
+/*! Creates a lightweight sprite.
+    Lightweight sprites are not scene objects: they have no physics, callbacks or picking and are rendered in bulk.
+    @param imageAssetId The image asset Id to use.
+    @param frame The image frame to use.
+    @param position The position of the sprite formatted as "x y".
+    @param size The size of the sprite formatted as "width height".
+    @param angle The angle of the sprite in degrees.  Optional: Defaults to zero.
+    @param color The color of the sprite formatted as "R G B [A]".  Optional: Defaults to white.
+    @param layer The layer of the sprite.  Optional: Defaults to zero.
+    @return The lightweight sprite Id or zero if it could not be created.
+*/
+ConsoleMethodWithDocs(Scene, createLightweightSprite, ConsoleInt, 6, 9, (imageAssetId, frame, position, size, [angle], [color], [layer]))
+{
+    // Fetch optional angle.
+    const F32 angle = argc > 6 ? mDegToRad( dAtof(argv[6]) ) : 0.0f;
+
+    // Fetch optional color.
+    ColorF color(1.0f, 1.0f, 1.0f, 1.0f);
+    if ( argc > 7 )
+        Con::setData( TypeColorF, &color, 0, 1, &(argv[7]) );
+
+    // Fetch optional layer.
+    const U32 layer = argc > 8 ? dAtoi(argv[8]) : 0;
+
+    return object->getLightweightSprites().createSprite( argv[2], dAtoi(argv[3]), Vector2(argv[4]), Vector2(argv[5]), angle, color, layer );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Removes a lightweight sprite.
+    @param spriteId The lightweight sprite Id.
+    @return Whether the lightweight sprite was removed or not.
+*/
+ConsoleMethodWithDocs(Scene, removeLightweightSprite, ConsoleBool, 3, 3, (spriteId))
+{
+    return object->getLightweightSprites().removeSprite( dAtoi(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Removes all lightweight sprites.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, clearLightweightSprites, ConsoleVoid, 2, 2, ())
+{
+    object->getLightweightSprites().clear();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the number of lightweight sprites.
+    @return The number of lightweight sprites.
+*/
+ConsoleMethodWithDocs(Scene, getLightweightSpriteCount, ConsoleInt, 2, 2, ())
+{
+    return object->getLightweightSprites().getCount();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets the position of a lightweight sprite.
+    @param spriteId The lightweight sprite Id.
+    @param position The position formatted as "x y".
+    @return Whether the position was set or not.
+*/
+ConsoleMethodWithDocs(Scene, setLightweightSpritePosition, ConsoleBool, 4, 4, (spriteId, position))
+{
+    return object->getLightweightSprites().setPosition( dAtoi(argv[2]), Vector2(argv[3]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the position of a lightweight sprite.
+    @param spriteId The lightweight sprite Id.
+    @return The position of the lightweight sprite.
+*/
+ConsoleMethodWithDocs(Scene, getLightweightSpritePosition, ConsoleString, 3, 3, (spriteId))
+{
+    return object->getLightweightSprites().getPosition( dAtoi(argv[2]) ).scriptThis();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets the angle of a lightweight sprite.
+    @param spriteId The lightweight sprite Id.
+    @param angle The angle in degrees.
+    @return Whether the angle was set or not.
+*/
+ConsoleMethodWithDocs(Scene, setLightweightSpriteAngle, ConsoleBool, 4, 4, (spriteId, angle))
+{
+    return object->getLightweightSprites().setAngle( dAtoi(argv[2]), mDegToRad( dAtof(argv[3]) ) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets the size of a lightweight sprite.
+    @param spriteId The lightweight sprite Id.
+    @param size The size formatted as "width height".
+    @return Whether the size was set or not.
+*/
+ConsoleMethodWithDocs(Scene, setLightweightSpriteSize, ConsoleBool, 4, 4, (spriteId, size))
+{
+    return object->getLightweightSprites().setSize( dAtoi(argv[2]), Vector2(argv[3]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets the image frame of a lightweight sprite.
+    @param spriteId The lightweight sprite Id.
+    @param frame The image frame.
+    @return Whether the frame was set or not.
+*/
+ConsoleMethodWithDocs(Scene, setLightweightSpriteFrame, ConsoleBool, 4, 4, (spriteId, frame))
+{
+    return object->getLightweightSprites().setFrame( dAtoi(argv[2]), dAtoi(argv[3]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets the color of a lightweight sprite.
+    @param spriteId The lightweight sprite Id.
+    @param color The color formatted as "R G B [A]".
+    @return Whether the color was set or not.
+*/
+ConsoleMethodWithDocs(Scene, setLightweightSpriteColor, ConsoleBool, 4, 4, (spriteId, color))
+{
+    ColorF color(1.0f, 1.0f, 1.0f, 1.0f);
+    Con::setData( TypeColorF, &color, 0, 1, &(argv[3]) );
+
+    return object->getLightweightSprites().setColor( dAtoi(argv[2]), color );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the number of begin contacts reported by the 'onSceneContacts' callback.
+    Contact events are only available during the 'onSceneContacts' callback.
+    @return The number of begin contacts.
+*/
+ConsoleMethodWithDocs(Scene, getBeginContactCount, ConsoleInt, 2, 2, ())
+{
+    return object->getBeginContactEvents().size();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets a begin contact reported by the 'onSceneContacts' callback.
+    @param contactIndex The index of the begin contact.
+    @return The contact formatted as "sceneObjectA sceneObjectB shapeIndexA shapeIndexB [normalX normalY point1X point1Y normalImpulse1 tangentImpulse1 [point2X point2Y normalImpulse2 tangentImpulse2]]" or nothing if the index is invalid or either object has been deleted during the callback.
+*/
+ConsoleMethodWithDocs(Scene, getBeginContact, ConsoleString, 3, 3, (contactIndex))
+{
+    const Scene::typeContactVector& contacts = object->getBeginContactEvents();
+    const S32 contactIndex = dAtoi(argv[2]);
+
+    if ( contactIndex < 0 || contactIndex >= contacts.size() )
+    {
+        Con::warnf( "Scene::getBeginContact() - Invalid contact index '%d'.", contactIndex );
+        return StringTable->EmptyString;
+    }
+
+    // The contact is killed if either object was deleted during the callback.
+    if ( contacts[contactIndex].isDead() )
+        return StringTable->EmptyString;
+
+    return object->formatContactEvent( contacts[contactIndex], true );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the number of end contacts reported by the 'onSceneContacts' callback.
+    Contact events are only available during the 'onSceneContacts' callback.
+    @return The number of end contacts.
+*/
+ConsoleMethodWithDocs(Scene, getEndContactCount, ConsoleInt, 2, 2, ())
+{
+    return object->getEndContactEvents().size();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets an end contact reported by the 'onSceneContacts' callback.
+    @param contactIndex The index of the end contact.
+    @return The contact formatted as "sceneObjectA sceneObjectB shapeIndexA shapeIndexB" or nothing if the index is invalid or either object has been deleted during the callback.
+*/
+ConsoleMethodWithDocs(Scene, getEndContact, ConsoleString, 3, 3, (contactIndex))
+{
+    const Scene::typeContactVector& contacts = object->getEndContactEvents();
+    const S32 contactIndex = dAtoi(argv[2]);
+
+    if ( contactIndex < 0 || contactIndex >= contacts.size() )
+    {
+        Con::warnf( "Scene::getEndContact() - Invalid contact index '%d'.", contactIndex );
+        return StringTable->EmptyString;
+    }
+
+    // The contact is killed if either object was deleted during the callback.
+    if ( contacts[contactIndex].isDead() )
+        return StringTable->EmptyString;
+
+    return object->formatContactEvent( contacts[contactIndex], false );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets the scene groups whose objects report their tick callbacks with a single 'onSceneTickEvents' callback.
+    The "onUpdate", "onMoveToComplete", "onFadeToComplete", "onGrowToComplete", "onWake" and "onSleep" callbacks
+    of objects in these groups are not performed individually.
+    @param sceneGroupMask The scene group mask.  Zero batches no groups and (-1) batches all groups.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, setBatchCallbackGroupMask, ConsoleVoid, 3, 3, (sceneGroupMask))
+{
+    object->setBatchCallbackGroupMask( (U32)dAtoi(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the scene groups whose objects report their tick callbacks with a single 'onSceneTickEvents' callback.
+    @return The scene group mask.
+*/
+ConsoleMethodWithDocs(Scene, getBatchCallbackGroupMask, ConsoleInt, 2, 2, ())
+{
+    return (S32)object->getBatchCallbackGroupMask();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the number of tick events reported by the 'onSceneTickEvents' callback.
+    Tick events are only available during the 'onSceneTickEvents' callback.
+    @return The number of tick events.
+*/
+ConsoleMethodWithDocs(Scene, getTickEventCount, ConsoleInt, 2, 2, ())
+{
+    return object->getTickEvents().size();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets a tick event reported by the 'onSceneTickEvents' callback.
+    @param eventIndex The index of the tick event.
+    @return The tick event formatted as "sceneObject callbackName" or nothing if the index is invalid.
+*/
+ConsoleMethodWithDocs(Scene, getTickEvent, ConsoleString, 3, 3, (eventIndex))
+{
+    const Scene::typeTickEventVector& tickEvents = object->getTickEvents();
+    const S32 eventIndex = dAtoi(argv[2]);
+
+    if ( eventIndex < 0 || eventIndex >= tickEvents.size() )
+    {
+        Con::warnf( "Scene::getTickEvent() - Invalid tick event index '%d'.", eventIndex );
+        return StringTable->EmptyString;
+    }
+
+    return object->formatTickEvent( tickEvents[eventIndex] );
+}
+
+//-----------------------------------------------------------------------------
+
 /*! Creates the specified scene-object derived type and adds it to the scene.
     @return The scene-object or NULL if not created.
 */
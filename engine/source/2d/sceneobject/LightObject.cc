@@ -2,6 +2,7 @@
 #include "console/consoleTypes.h"
 #include "2d/core/Utility.h"
 #include "2d/sceneobject/LightObject.h"
+#include "memory/frameAllocator.h"
 
 // Script bindings.
 #include "LightObject_ScriptBinding.h"
@@ -59,8 +60,13 @@ void LightObject::safeDelete(void)
 void LightObject::sceneRender(const SceneRenderState * sceneRenderState, const SceneRenderRequest * sceneRenderRequest, BatchRender * batchRender)
 {
    Vector2 worldPos = getPosition();
+
+   // The ray lists only live for this render so use frame memory.
+   FrameAllocatorMarker frameMarker;
    Vector<Vector2> verts;
    Vector<RayList> bList;
+   verts.setAllocator(&FrameVectorAllocator::smAllocator);
+   bList.setAllocator(&FrameVectorAllocator::smAllocator);
    S32 mSrcLightBlend = getSrcBlendFactor();
    S32 mDstLightBlend = getDstBlendFactor();
    ColorF mLightColor = getBlendColor();
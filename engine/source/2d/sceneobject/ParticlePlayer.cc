@@ -262,6 +262,9 @@ void ParticlePlayer::preIntegrate( const F32 totalTime, const F32 elapsedTime, D
 
 void ParticlePlayer::integrateObject( const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats )
 {
+    // Memory Accounting.
+    Memory::TagScope memoryTag( Memory::TagParticles );
+
     // Call parent.
     Parent::integrateObject( totalTime, elapsedTime, pDebugStats );
 
@@ -62,6 +62,7 @@ public:
 
    virtual void preIntegrate(const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats);
    virtual void integrateObject(const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats);
+   virtual TickState getTickState(void) { return getScene() != NULL && isEnabled() ? TickRequired : TickNone; }
 
    S32 addNode(Vector2 pos, F32 distance, F32 weight);
 
@@ -101,6 +101,7 @@ SceneObject::SceneObject() :
     /// Scene.
     mpScene(NULL),
     mpTargetScene(NULL),
+    mSceneObjectIndex(-1),
 
     /// Lifetime.
     mLifetime(0.0f),
@@ -195,7 +196,12 @@ SceneObject::SceneObject() :
     mAlwaysInScope(false),
     mRotateToEventId(0),
     mSerialId(0),
-    mRenderGroup( StringTable->EmptyString )
+    mRenderGroup( StringTable->EmptyString ),
+
+    /// Active tick set.
+    mActiveTickIndex(-1),
+    mTickCountedEnabled(false),
+    mTickCountedVisible(false)
 {
     // Set Vector Associations.
     VECTOR_SET_ASSOCIATION( mDestroyNotifyList );
@@ -395,6 +401,31 @@ void SceneObject::onDestroyNotify( SceneObject* pSceneObject )
 
 //-----------------------------------------------------------------------------
 
+void SceneObject::onStaticModified( const char* slotName, const char* newValue )
+{
+    // Call parent.
+    Parent::onStaticModified( slotName, newValue );
+
+    // Fields such as the callbacks and visibility are set directly so update the tick state.
+    updateTickState();
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneObject::addComponent( SimComponent* component )
+{
+    // Call parent.
+    if ( !Parent::addComponent( component ) )
+        return false;
+
+    // Components are updated each tick.
+    updateTickState();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
 void SceneObject::OnRegisterScene( Scene* pScene )
 {
     // Sanity!
@@ -560,6 +591,55 @@ void SceneObject::resetTickSpatials( const bool resize )
 
     // Flag spatial changed.
     mSpatialDirty = true;
+
+    // Update the tick state.
+    updateTickState();
+}
+
+//-----------------------------------------------------------------------------
+
+SceneObject::TickState SceneObject::getTickState( void )
+{
+    // Nothing to do if not in a scene or disabled.
+    if ( mpScene == NULL || !isEnabled() )
+        return TickNone;
+
+    // Do we have any per-tick work?
+    if (    mSpatialDirty ||
+            mGrowActive ||
+            mFadeActive ||
+            mLifetimeActive ||
+            mTargetPositionActive ||
+            mUpdateCallback ||
+            mSleepingCallback ||
+            mAttachedCtrls.size() > 0 ||
+            mpAttachedCamera != NULL ||
+            mAudioHandles.size() > 0 ||
+            getComponentCount() > 0 )
+        return TickRequired;
+
+    // Static bodies never move on their own.
+    if ( mpBody->GetType() == b2_staticBody )
+        return TickNone;
+
+    // The physics can wake a sleeping body at any time so watch it.
+    return mpBody->IsAwake() ? TickRequired : TickWatch;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneObject::updateTickState( void )
+{
+    // Finish if not in a scene.
+    if ( mpScene == NULL )
+        return;
+
+    // Update the scene object stats.
+    mpScene->updateSceneObjectStats( this );
+
+    // Add to the active set if we've got per-tick work.
+    if ( mActiveTickIndex == -1 && getTickState() != TickNone )
+        mpScene->activateSceneObject( this );
 }
 
 //-----------------------------------------------------------------------------
@@ -686,7 +766,7 @@ void SceneObject::postIntegrate(const F32 totalTime, const F32 elapsedTime, Debu
     if ( mUpdateCallback )
     {
         PROFILE_SCOPE(SceneObject_onUpdateCallback);
-        Con::executef(this, 1, "onUpdate");
+        raiseTickEvent( TickEventUpdate );
     }
 
     // Check to see if we're done moving.
@@ -695,7 +775,7 @@ void SceneObject::postIntegrate(const F32 totalTime, const F32 elapsedTime, Debu
        mTargetPositionActive = false;
 
        PROFILE_SCOPE(SceneObject_onMoveToComplete);
-       Con::executef(this, 1, "onMoveToComplete");
+       raiseTickEvent( TickEventMoveToComplete );
     }
 
 	// Check to see if we're done fading.
@@ -704,7 +784,7 @@ void SceneObject::postIntegrate(const F32 totalTime, const F32 elapsedTime, Debu
 		mFadeActive = false;
 
 		PROFILE_SCOPE(SceneObject_onFadeToComplete);
-		Con::executef(this, 1, "onFadeToComplete");
+		raiseTickEvent( TickEventFadeToComplete );
 	}
 
 	//Check to see if we're done growing.
@@ -713,7 +793,7 @@ void SceneObject::postIntegrate(const F32 totalTime, const F32 elapsedTime, Debu
 		mGrowActive = false;
 
 		PROFILE_SCOPE(SceneObject_onGrowToComplete);
-		Con::executef(this, 1, "onGrowToComplete");
+		raiseTickEvent( TickEventGrowToComplete );
 	}
 
     // Are we using the sleeping callback?
@@ -731,16 +811,57 @@ void SceneObject::postIntegrate(const F32 totalTime, const F32 elapsedTime, Debu
             mLastAwakeState = currentAwakeState;
 
             // Perform the appropriate callback.
-            if ( currentAwakeState )
-                Con::executef(this, 1, "onWake");
-            else
-                Con::executef(this, 1, "onSleep");
+            raiseTickEvent( currentAwakeState ? TickEventWake : TickEventSleep );
         }
     }
 }
 
 //-----------------------------------------------------------------------------
 
+void SceneObject::raiseTickEvent( const TickEvent tickEvent )
+{
+    // Notify natively.
+    onTickEvent( tickEvent );
+
+    // Finish if deleted by the native notification.
+    if ( isBeingDeleted() )
+        return;
+
+    // Fetch scene.
+    Scene* pScene = getScene();
+
+    // Buffer the event if the scene batches callbacks for our scene group.
+    if ( pScene != NULL && (pScene->getBatchCallbackGroupMask() & mSceneGroupMask) != 0 )
+    {
+        pScene->bufferTickEvent( this, tickEvent );
+        return;
+    }
+
+    // Perform script callback.
+    Con::executef( this, 1, getTickEventCallbackName( tickEvent ) );
+}
+
+//-----------------------------------------------------------------------------
+
+const char* SceneObject::getTickEventCallbackName( const TickEvent tickEvent )
+{
+    switch( tickEvent )
+    {
+        case TickEventUpdate:           return "onUpdate";
+        case TickEventMoveToComplete:   return "onMoveToComplete";
+        case TickEventFadeToComplete:   return "onFadeToComplete";
+        case TickEventGrowToComplete:   return "onGrowToComplete";
+        case TickEventWake:             return "onWake";
+        case TickEventSleep:            return "onSleep";
+
+        default:
+            AssertFatal( false, "SceneObject::getTickEventCallbackName() - Invalid tick event." );
+            return StringTable->EmptyString;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 void SceneObject::interpolateObject( const F32 timeDelta )
 {
     // Debug Profiling.
@@ -932,6 +1053,9 @@ void SceneObject::setEnabled( const bool enabled )
     {
         mpBody->SetActive( enabled );
     }
+
+    // Update the tick state.
+    updateTickState();
 }
 
 //-----------------------------------------------------------------------------
@@ -955,6 +1079,9 @@ void SceneObject::setLifetime( const F32 lifetime )
         // No, so reset it to be safe.
         mLifetime = 0.0f;
     }
+
+    // Update the tick state.
+    updateTickState();
 }
 
 //-----------------------------------------------------------------------------
@@ -1424,6 +1551,9 @@ void SceneObject::setBodyType( const b2BodyType type )
     if ( mpScene )
     {
         mpBody->SetType( type );
+
+        // Update the tick state.
+        updateTickState();
         return;
     }
     else
@@ -1714,6 +1844,9 @@ bool SceneObject::moveTo( const Vector2& targetWorldPoint, const F32 speed, cons
     // Set the linear velocity.
     setLinearVelocity( linearVelocity );
 
+    // Update the tick state.
+    updateTickState();
+
     return true;
 }
 
@@ -1795,6 +1928,9 @@ bool SceneObject::fadeTo(const ColorF& targetColor, const F32 deltaRed, const F3
 		mDeltaGreen = deltaGreen;
 		mDeltaBlue = deltaBlue;
 		mDeltaAlpha = deltaAlpha;
+
+		// Update the tick state.
+		updateTickState();
 	}
 
 	return true;
@@ -1817,6 +1953,9 @@ bool SceneObject::growTo(const Vector2& targetSize, const Vector2& deltaSize)
 		mGrowActive = true;
 		mTargetSize = targetSize;
 		mDeltaSize = deltaSize;
+
+		// Update the tick state.
+		updateTickState();
 	}
 
 	return true;
@@ -2844,6 +2983,9 @@ void SceneObject::attachGui(GuiControl* pGuiControl, SceneWindow* pSceneWindow,
     }
 
     mAttachedCtrls.push_back(attachedGui);
+
+    // Update the tick state.
+    updateTickState();
 }
 //-----------------------------------------------------------------------------
 
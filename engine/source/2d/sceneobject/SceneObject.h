@@ -131,6 +131,9 @@ protected:
     ///         callbacks.
     SimObjectPtr<Scene>     mpTargetScene;
 
+    /// Index in the scene's object list.
+    S32                     mSceneObjectIndex;
+
     /// Lifetime.
     F32                     mLifetime;
     bool                    mLifetimeActive;
@@ -249,6 +252,11 @@ protected:
     U32                     mSerialId;
     StringTableEntry        mRenderGroup;
 
+    /// Active tick set.
+    S32                     mActiveTickIndex;
+    bool                    mTickCountedEnabled;
+    bool                    mTickCountedVisible;
+
 protected:
     static S32 QSORT_CALLBACK sceneObjectLayerDepthSort(const void* a, const void* b);
 
@@ -260,6 +268,7 @@ protected:
     /// Ticking.
     void                    resetTickSpatials( const bool resize = false );
     inline bool             getSpatialDirty( void ) const { return mSpatialDirty; }
+    void                    updateTickState( void );
 
     /// Contact processing.
     void                    initializeContactGathering( void );
@@ -271,6 +280,35 @@ protected:
 	// Effect Processing.
 	F32					processEffect( const F32 current, const F32 target, const F32 rate );
 
+public:
+    /// Per-tick work.
+    enum TickState
+    {
+        /// Nothing to do each tick.
+        TickNone,
+        /// Nothing to do each tick unless the body wakes.
+        TickWatch,
+        /// Work to do each tick.
+        TickRequired,
+    };
+
+    /// Per-tick script callbacks.
+    enum TickEvent
+    {
+        TickEventUpdate,
+        TickEventMoveToComplete,
+        TickEventFadeToComplete,
+        TickEventGrowToComplete,
+        TickEventWake,
+        TickEventSleep,
+
+        TickEventCount
+    };
+
+protected:
+    /// Tick event dispatch.
+    void                    raiseTickEvent( const TickEvent tickEvent );
+
 public:
     SceneObject();
     virtual ~SceneObject();
@@ -279,6 +317,8 @@ public:
     virtual bool            onAdd();
     virtual void            onRemove();
     virtual void            onDestroyNotify( SceneObject* pSceneObject );
+    virtual void            onStaticModified( const char* slotName, const char* newValue = NULL );
+    virtual bool            addComponent( SimComponent* component );
     static void             initPersistFields();
 
     /// Integration.
@@ -288,6 +328,12 @@ public:
     virtual void            interpolateObject( const F32 timeDelta );
     inline bool             getIsEditorTickAllowed( void ) const { return mEditorTickAllowed; }
 
+    /// Active tick set.
+    /// Objects with no per-tick work are not ticked by the scene.  Anything that gives an object
+    /// per-tick work must call updateTickState() so it is added to the scene's active set.
+    virtual TickState       getTickState( void );
+    inline bool             getTickActive( void ) const { return mActiveTickIndex != -1; }
+
     /// Render batching.
     inline void             setBatchIsolated( const bool batchIsolated ) { mBatchIsolated = batchIsolated; }
     virtual bool            getBatchIsolated( void ) { return mBatchIsolated; }
@@ -522,7 +568,7 @@ public:
     Vector2                 getEdgeCollisionShapeAdjacentEnd( const U32 shapeIndex ) const;
 
     /// Render visibility.
-    inline void             setVisible( const bool status )             { mVisible = status; }
+    inline void             setVisible( const bool status )             { mVisible = status; updateTickState(); }
     inline bool             getVisible(void) const                      { return mVisible; }
 
     /// Render blending.
@@ -553,20 +599,25 @@ public:
     virtual void            onInputEvent( StringTableEntry name, const GuiEvent& event, const Vector2& worldMousePoint );
 
     // Script callbacks.
-    inline void             setUpdateCallback( bool status )            { mUpdateCallback = status; }
+    inline void             setUpdateCallback( bool status )            { mUpdateCallback = status; updateTickState(); }
     inline bool             getUpdateCallback( void ) const             { return mUpdateCallback; }
     inline void             setCollisionCallback( const bool status )   { mCollisionCallback = status; }
     inline bool             getCollisionCallback(void) const            { return mCollisionCallback; }
-    inline void             setSleepingCallback( bool status )          { mSleepingCallback = status; }
+    inline void             setSleepingCallback( bool status )          { mSleepingCallback = status; updateTickState(); }
     inline bool             getSleepingCallback( void ) const           { return mSleepingCallback; }
 
+    /// Tick events.
+    /// Native objects can override onTickEvent() to receive the same events as the script callbacks without any script dispatch.
+    virtual void            onTickEvent( const TickEvent tickEvent ) {}
+    static const char*      getTickEventCallbackName( const TickEvent tickEvent );
+
     /// Debug mode.
     inline void             setDebugOn( const U32 debugMask )           { mDebugMask |= debugMask; }
     inline void             setDebugOff( const U32 debugMask )          { mDebugMask &= ~debugMask; }
     inline U32              getDebugMask( void ) const                  { return mDebugMask; }
 
     /// Camera mounting.
-    inline void             addCameraMountReference( SceneWindow* pAttachedCamera ) { mpAttachedCamera = pAttachedCamera; }
+    inline void             addCameraMountReference( SceneWindow* pAttachedCamera ) { mpAttachedCamera = pAttachedCamera; updateTickState(); }
     inline void             removeCameraMountReference( void )          { mpAttachedCamera = NULL; }
     inline void             dismountCamera( void )                      { if ( mpAttachedCamera ) mpAttachedCamera->dismountMe( this ); }
 
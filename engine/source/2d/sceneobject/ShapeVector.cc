@@ -175,7 +175,7 @@ void ShapeVector::renderCircleShape(Vector2 position, F32 radius, const bool wir
         const F32 k_increment = 2.0f * M_PI_F / k_segments;
         F32 theta = 0.0f;
 
-        Vector<GLfloat> verts;
+        InlineVector<GLfloat, 64> verts;
         for (U32 n = 0; n < k_segments; n++)
         {
             Vector2 v = position + radius * Vector2(mCos(theta), mSin(theta));
@@ -211,7 +211,7 @@ void ShapeVector::renderCircleShape(Vector2 position, F32 radius, const bool wir
         const F32 k_increment = 2.0f * M_PI_F / k_segments;
         F32 theta = 0.0f;
 
-        Vector<GLfloat> verts;
+        InlineVector<GLfloat, 64> verts;
         for (U32 n = 0; n < k_segments; n++)
         {
             Vector2 v = position + radius * Vector2(mCos(theta), mSin(theta));
@@ -239,7 +239,7 @@ void ShapeVector::renderPolygonShape(U32 vertexCount, const bool wireFrame)
         glColor4f((GLfloat)mFillColor.red, (GLfloat)mFillColor.green, (GLfloat)mFillColor.blue, (GLfloat)mFillColor.alpha);
 
         // Draw the shape.
-        Vector<GLfloat> verts;
+        InlineVector<GLfloat, 64> verts;
         for (U32 n = 0; n < vertexCount; n++)
         {
             verts.push_back((GLfloat)mPolygonLocalList[n].x);
@@ -267,7 +267,7 @@ void ShapeVector::renderPolygonShape(U32 vertexCount, const bool wireFrame)
         glColor4f((GLfloat)mLineColor.red, (GLfloat)mLineColor.green, (GLfloat)mLineColor.blue, (GLfloat)mLineColor.alpha);
 
         // Draw the shape.
-        Vector<GLfloat> verts;
+        InlineVector<GLfloat, 64> verts;
         for (U32 n = 0; n < vertexCount; n++)
         {
             verts.push_back((GLfloat)mPolygonLocalList[n].x);
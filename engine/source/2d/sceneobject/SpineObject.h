@@ -213,6 +213,7 @@ protected:
 
 	virtual void preIntegrate(const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats);
 	virtual void interpolateObject(const F32 timeDelta);
+	virtual TickState getTickState(void) { return getScene() != NULL && isEnabled() ? TickRequired : TickNone; }
 
 	virtual bool canPrepareRender(void) const { return true; }
 	virtual bool validRender(void) const { return mSpineAsset.notNull(); }
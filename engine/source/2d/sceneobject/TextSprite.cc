@@ -32,6 +32,9 @@
 
 #include "TextSprite.h"
 
+// Debug Profiling.
+#include "debug/profiler.h"
+
 // Script bindings.
 #include "TextSprite_ScriptBinding.h"
 
@@ -271,7 +274,8 @@ TextSprite::TextSprite() :
    mCustomLineHeight(1.0f),
    mKerning(0.0f),
    mFontSpatialsDirty(true),
-   mCalculatedSize(1.0f, 1.0f)
+   mCalculatedSize(1.0f, 1.0f),
+   mpTextLayout(NULL)
 {
 }
 
@@ -279,6 +283,7 @@ TextSprite::TextSprite() :
 
 TextSprite::~TextSprite()
 {
+   ReleaseTextLayout();
 }
 
 //-----------------------------------------------------------------------------
@@ -318,6 +323,9 @@ bool TextSprite::onAdd()
 
 void TextSprite::onRemove()
 {
+    // Release the shared layout.
+    ReleaseTextLayout();
+
     // Call Parent.
     Parent::onRemove();
 }
@@ -395,24 +403,87 @@ void TextSprite::sceneRender( const SceneRenderState* pSceneRenderState, const S
        mOverflowY = OVERFLOW_Y_HIDDEN;
     }
 
-    // Get a size ratio
-    const F32 ratio = mFontAsset->mBitmapFont.getSizeRatio(mFontSize);
-
-    //get the line height
-    const F32 lineHeight = GetLineHeight();
-
     //prep for justify
     if (mTextAlign == ALIGN_JUSTIFY)
     {
        mKerning = 0;
     }
 
+    // Per-character settings are specific to this sprite so lay those out every frame.
+    if (!mCharInfo.empty())
+    {
+       ReleaseTextLayout();
+
+       mGlyphScratch.clear();
+       BuildTextLayout(mGlyphScratch);
+       SubmitGlyphs(pBatchRenderer, mGlyphScratch);
+       return;
+    }
+
+    // Fetch the shared layout if ours is out of date.
+    if (mpTextLayout == NULL || !mpTextLayout->isValid() || mFontSpatialsDirty || mSize != mCalculatedSize)
+    {
+       ReleaseTextLayout();
+
+       TextLayoutCache::Key key((FontAsset*)mFontAsset, mText.getPtr(), renderCharacters);
+       key.addParam(mFontSize);
+       key.addParam(mFontScaleX);
+       key.addParam(mFontScaleY);
+       key.addParam(mSize.x);
+       key.addParam(mSize.y);
+       key.addParam((F32)mTextAlign);
+       key.addParam((F32)mTextVAlign);
+       key.addParam((F32)mOverflowX);
+       key.addParam((F32)mOverflowY);
+       key.addParam(GetLineHeight());
+       key.addParam(mKerning);
+
+       mpTextLayout = TextLayoutCache::acquire(key);
+
+       if (mpTextLayout == NULL)
+       {
+          mpTextLayout = TextLayoutCache::createLayout(key);
+          BuildTextLayout(mpTextLayout->getGlyphs());
+          TextLayoutCache::commit(mpTextLayout);
+       }
+       else
+       {
+          // The rows weren't needed so calculate them if they are.
+          mLine.clear();
+          mFontSpatialsDirty = false;
+          mCalculatedSize = mSize;
+       }
+    }
+
+    SubmitGlyphs(pBatchRenderer, mpTextLayout->getGlyphs());
+}
+
+//-----------------------------------------------------------------------------
+
+void TextSprite::BuildTextLayout(Vector<TextLayoutCache::Glyph>& glyphs)
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TextSprite_BuildTextLayout);
+
+    // Fetch number of characters to render.
+    const U32 renderCharacters = mText.length();
+
+    // Get a size ratio
+    const F32 ratio = mFontAsset->mBitmapFont.getSizeRatio(mFontSize);
+
+    //get the line height
+    const F32 lineHeight = GetLineHeight();
+
     //determine the rows
-    if (mFontSpatialsDirty || mSize != mCalculatedSize)
+    if (mFontSpatialsDirty || mSize != mCalculatedSize || mLine.empty())
     {
        CalculateSpatials(ratio);
     }
 
+    // Finish if there's nothing but whitespace.
+    if (mLine.empty())
+       return;
+
     // If we're shrinking the set the scale
     bool shrinkX = false;
     bool shrinkY = false;
@@ -438,7 +509,7 @@ void TextSprite::sceneRender( const SceneRenderState* pSceneRenderState, const S
 
     ApplyAlignment(cursor, mLine.size(), 0, mLine.front().mLength, mLine.front().mEnd - mLine.front().mStart + 1, ratio);
 
-    // Render all the characters.  
+    // Lay out all the characters.
     U32 row = 0;
     S32 prevCharID = -1;
     for (U32 characterIndex = mLine.front().mStart; characterIndex < renderCharacters; ++characterIndex)
@@ -448,7 +519,7 @@ void TextSprite::sceneRender( const SceneRenderState* pSceneRenderState, const S
 
         if (characterIndex >= mLine[row].mStart)
         {
-           RenderLetter(pBatchRenderer, cursor, charID, ratio, characterIndex);
+           LayoutLetter(glyphs, cursor, charID, ratio, characterIndex);
         }
         
         if ((row + 1) < mLine.size() && mLine[row + 1].mStart == (characterIndex + 1))
@@ -485,14 +556,12 @@ void TextSprite::sceneRender( const SceneRenderState* pSceneRenderState, const S
 
 //-----------------------------------------------------------------------------
 
-
-void TextSprite::RenderLetter(BatchRender* pBatchRenderer, Vector2& cursor, U32 charID, F32 ratio, U32 charNum)
+void TextSprite::LayoutLetter(Vector<TextLayoutCache::Glyph>& glyphs, Vector2& cursor, U32 charID, F32 ratio, U32 charNum)
 {
    const BitmapFontCharacter& bmChar = mFontAsset->mBitmapFont.getCharacter(charID);
 
    Vector2 charScale = getCharacterScale(charNum);
    Vector2 charOffset = getCharacterOffset(charNum);
-   ColorF charColor = getCharacterBlendColor(charNum);
 
    F32 fontScaleX = mFontScaleX * charScale.x;
    F32 fontScaleY = mFontScaleY * charScale.y;
@@ -549,65 +618,95 @@ void TextSprite::RenderLetter(BatchRender* pBatchRenderer, Vector2& cursor, U32
          return;
    }
 
+   glyphs.increment();
+   TextLayoutCache::Glyph& glyph = glyphs.last();
+
    //create the source rect
-   Vector2 sourceOOBB[4];
-   sourceOOBB[0].Set(bmChar.mOOBB[0].x + ((insetLeft * (F32)bmChar.mWidth) / (F32)bmChar.mPageWidth), bmChar.mOOBB[0].y - ((insetBottom * (F32)bmChar.mHeight) / (F32)bmChar.mPageHeight));
-   sourceOOBB[1].Set(bmChar.mOOBB[1].x - ((insetRight * (F32)bmChar.mWidth) / (F32)bmChar.mPageWidth), bmChar.mOOBB[1].y - ((insetBottom * (F32)bmChar.mHeight) / (F32)bmChar.mPageHeight));
-   sourceOOBB[2].Set(bmChar.mOOBB[2].x - ((insetRight * (F32)bmChar.mWidth) / (F32)bmChar.mPageWidth), bmChar.mOOBB[2].y + ((insetTop * (F32)bmChar.mHeight) / (F32)bmChar.mPageHeight));
-   sourceOOBB[3].Set(bmChar.mOOBB[3].x + ((insetLeft * (F32)bmChar.mWidth) / (F32)bmChar.mPageWidth), bmChar.mOOBB[3].y + ((insetTop * (F32)bmChar.mHeight) / (F32)bmChar.mPageHeight));
+   glyph.mTexels[0].set(bmChar.mOOBB[0].x + ((insetLeft * (F32)bmChar.mWidth) / (F32)bmChar.mPageWidth), bmChar.mOOBB[0].y - ((insetBottom * (F32)bmChar.mHeight) / (F32)bmChar.mPageHeight));
+   glyph.mTexels[1].set(bmChar.mOOBB[1].x - ((insetRight * (F32)bmChar.mWidth) / (F32)bmChar.mPageWidth), bmChar.mOOBB[1].y - ((insetBottom * (F32)bmChar.mHeight) / (F32)bmChar.mPageHeight));
+   glyph.mTexels[2].set(bmChar.mOOBB[2].x - ((insetRight * (F32)bmChar.mWidth) / (F32)bmChar.mPageWidth), bmChar.mOOBB[2].y + ((insetTop * (F32)bmChar.mHeight) / (F32)bmChar.mPageHeight));
+   glyph.mTexels[3].set(bmChar.mOOBB[3].x + ((insetLeft * (F32)bmChar.mWidth) / (F32)bmChar.mPageWidth), bmChar.mOOBB[3].y + ((insetTop * (F32)bmChar.mHeight) / (F32)bmChar.mPageHeight));
 
-   //create the destination rect
-   Vector2 destLeft = (mRenderOOBB[1] - mRenderOOBB[0]);
-   destLeft.Normalize((F32)cursorX + (insetLeft * bmChar.mWidth * ratio * fontScaleX));
+   //create the destination rect, in local space from the top-left of the sprite
+   glyph.mLeft = (F32)cursorX + (insetLeft * bmChar.mWidth * ratio * fontScaleX);
+   glyph.mRight = glyph.mLeft + (((bmChar.mWidth * ratio) - (insetLeft * (bmChar.mWidth * ratio)) - (insetRight * (bmChar.mWidth * ratio))) * fontScaleX);
+   glyph.mTop = (F32)cursorY - (((mFontAsset->mBitmapFont.mBaseline * ratio) - (bmChar.mYOffset * ratio) - (insetTop * bmChar.mHeight * ratio)) * fontScaleY);
+   glyph.mBottom = glyph.mTop + (((bmChar.mHeight * ratio) - (insetBottom * bmChar.mHeight * ratio) - (insetTop * bmChar.mHeight * ratio)) * fontScaleY);
 
-   Vector2 destWidth = (mRenderOOBB[1] - mRenderOOBB[0]);
-   destWidth.Normalize(((bmChar.mWidth * ratio) - (insetLeft * (bmChar.mWidth * ratio)) - (insetRight * (bmChar.mWidth * ratio))) * fontScaleX);
+   glyph.mPage = bmChar.mPage;
+   glyph.mCharIndex = charNum;
+}
 
-   Vector2 destTop = -(mRenderOOBB[3] - mRenderOOBB[0]);
-   destTop.Normalize((F32)cursorY - (((mFontAsset->mBitmapFont.mBaseline * ratio) - (bmChar.mYOffset * ratio) - (insetTop * bmChar.mHeight * ratio)) * fontScaleY));
+//-----------------------------------------------------------------------------
 
-   Vector2 destHeight = -(mRenderOOBB[3] - mRenderOOBB[0]);
-   destHeight.Normalize(((bmChar.mHeight * ratio) - (insetBottom * bmChar.mHeight * ratio) - (insetTop * bmChar.mHeight * ratio)) * fontScaleY);
+void TextSprite::SubmitGlyphs(BatchRender* pBatchRenderer, const Vector<TextLayoutCache::Glyph>& glyphs)
+{
+   // Fetch the sprite axes, origin at the top-left and Y down.
+   Vector2 axisX = (mRenderOOBB[1] - mRenderOOBB[0]);
+   axisX.Normalize();
+   Vector2 axisY = (mRenderOOBB[0] - mRenderOOBB[3]);
+   axisY.Normalize();
 
-   Vector2 destOOBB[4];
-   destOOBB[0] = (mRenderOOBB[3] + destLeft + destTop + destHeight);
-   destOOBB[1] = (mRenderOOBB[3] + destLeft + destWidth + destTop + destHeight);
-   destOOBB[2] = (mRenderOOBB[3] + destLeft + destWidth + destTop);
-   destOOBB[3] = (mRenderOOBB[3] + destLeft + destTop);
+   const bool useCharacterColor = !mCharInfo.empty();
 
-   if (charColor != mBlendColor)
-   {
-      // Submit batched quad.
-      pBatchRenderer->SubmitQuad(
-         destOOBB[0],
-         destOOBB[1],
-         destOOBB[2],
-         destOOBB[3],
-         sourceOOBB[0],
-         sourceOOBB[1],
-         sourceOOBB[2],
-         sourceOOBB[3],
-         mFontAsset->getImageTexture(bmChar.mPage),
-         charColor);
-   }
-   else
+   for (Vector<TextLayoutCache::Glyph>::const_iterator glyphItr = glyphs.begin(); glyphItr != glyphs.end(); ++glyphItr)
    {
+      const TextLayoutCache::Glyph& glyph = *glyphItr;
+
+      const Vector2 left = mRenderOOBB[3] + (axisX * glyph.mLeft);
+      const Vector2 right = mRenderOOBB[3] + (axisX * glyph.mRight);
+      const Vector2 top = axisY * glyph.mTop;
+      const Vector2 bottom = axisY * glyph.mBottom;
+
+      if (useCharacterColor)
+      {
+         const ColorF charColor = getCharacterBlendColor(glyph.mCharIndex);
+
+         if (charColor != mBlendColor)
+         {
+            // Submit batched quad.
+            pBatchRenderer->SubmitQuad(
+               left + bottom,
+               right + bottom,
+               right + top,
+               left + top,
+               glyph.mTexels[0],
+               glyph.mTexels[1],
+               glyph.mTexels[2],
+               glyph.mTexels[3],
+               mFontAsset->getImageTexture(glyph.mPage),
+               charColor);
+            continue;
+         }
+      }
+
       // Submit batched quad.
       pBatchRenderer->SubmitQuad(
-         destOOBB[0],
-         destOOBB[1],
-         destOOBB[2],
-         destOOBB[3],
-         sourceOOBB[0],
-         sourceOOBB[1],
-         sourceOOBB[2],
-         sourceOOBB[3],
-         mFontAsset->getImageTexture(bmChar.mPage));
+         left + bottom,
+         right + bottom,
+         right + top,
+         left + top,
+         glyph.mTexels[0],
+         glyph.mTexels[1],
+         glyph.mTexels[2],
+         glyph.mTexels[3],
+         mFontAsset->getImageTexture(glyph.mPage));
    }
 }
 
 //-----------------------------------------------------------------------------
 
+void TextSprite::ReleaseTextLayout(void)
+{
+   if (mpTextLayout == NULL)
+      return;
+
+   TextLayoutCache::release(mpTextLayout);
+   mpTextLayout = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
 void TextSprite::CalculateSpatials(F32 ratio)
 {
    F32 length = 0;
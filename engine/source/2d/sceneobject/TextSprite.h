@@ -51,6 +51,10 @@
 #include "bitmapFont/BitmapFontCharacterInfo.h"
 #endif
 
+#ifndef _TEXT_LAYOUT_CACHE_H_
+#include "graphics/TextLayoutCache.h"
+#endif
+
 using CharInfoMap = std::map<U32, BitmapFontCharacterInfo>;
 
 //-----------------------------------------------------------------------------
@@ -117,6 +121,10 @@ private:
     Vector2                 mCalculatedSize;
     CharInfoMap             mCharInfo;
 
+    /// Shared layout used when there are no per-character settings.
+    TextLayoutCache::Layout*        mpTextLayout;
+    Vector<TextLayoutCache::Glyph>  mGlyphScratch;
+
 
 public:
     TextSprite();
@@ -230,7 +238,10 @@ protected:
     static bool writeKerning(void* obj, StringTableEntry pFieldName)       { return static_cast<TextSprite*>(obj)->getKerning() != 0.0f; }
 
 private:
-   void RenderLetter(BatchRender* pBatchRenderer, Vector2& cursor, U32 charID, F32 ratio, U32 charNum);
+   void BuildTextLayout(Vector<TextLayoutCache::Glyph>& glyphs);
+   void LayoutLetter(Vector<TextLayoutCache::Glyph>& glyphs, Vector2& cursor, U32 charID, F32 ratio, U32 charNum);
+   void SubmitGlyphs(BatchRender* pBatchRenderer, const Vector<TextLayoutCache::Glyph>& glyphs);
+   void ReleaseTextLayout(void);
    void ApplyAlignment(Vector2& cursor, U32 totalRows, U32 row, F32 length, U32 charCount, F32 ratio);
    F32 getCursorAdvance(U32 charID, S32 prevCharID, F32 ratio);
    F32 getCursorAdvance(const BitmapFontCharacter& bmChar, S32 prevCharID, F32 ratio);
@@ -61,6 +61,7 @@ public:
     /// Integration.
     virtual void            preIntegrate( const F32 totalTime, const F32 elapsedTime, DebugStats *pDebugStats );
     virtual void            integrateObject( const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats );
+    virtual TickState       getTickState( void ) { return getScene() != NULL && isEnabled() ? TickRequired : TickNone; }
 
     /// Rendering.
     virtual bool            shouldRender( void ) const { return false; }
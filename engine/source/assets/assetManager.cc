@@ -205,6 +205,9 @@ bool AssetManager::addDeclaredAsset( ModuleDefinition* pModuleDefinition, const
     // Debug Profiling.
     PROFILE_SCOPE(AssetManager_AddSingleDeclaredAsset);
 
+    // Memory Accounting.
+    Memory::TagScope memoryTag( Memory::TagAssets );
+
     // Sanity!
     AssertFatal( pModuleDefinition != NULL, "Cannot add single declared asset using a NULL module definition" );
     AssertFatal( pAssetFilePath != NULL, "Cannot add single declared asset using a NULL asset file-path." );
@@ -153,6 +153,9 @@ public:
         // Sanity!
         AssertFatal( pAssetId != NULL, "Cannot acquire NULL asset Id." );
 
+        // Memory Accounting.
+        Memory::TagScope memoryTag( Memory::TagAssets );
+
         // Is this an empty asset Id?
         if ( *pAssetId == 0 )
         {
@@ -24,37 +24,65 @@
 
 //-----------------------------------------------------------------------------
 
+/// Get the capacity to hold the specified count.
+///
+/// Growing is geometric so that appending is amortized constant time rather
+/// than reallocating every VectorBlockSize elements.  Shrinking is exact.
+static inline U32 VectorCapacity(const U32 size, const U32 newCount)
+{
+   U32 count = newCount;
+   if (newCount > size && size + (size >> 1) > newCount)
+      count = size + (size >> 1);
+
+   U32 blocks = count / VectorBlockSize;
+   if (count % VectorBlockSize)
+      blocks++;
+
+   return blocks * VectorBlockSize;
+}
+
+//-----------------------------------------------------------------------------
+
 #ifdef TORQUE_DEBUG
 
 bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 elemSize,
+                  VectorAllocator* allocator,
                   const char* fileName,
                   const U32   lineNum)
 {
    if (newCount > 0) {
-      U32 blocks = newCount / VectorBlockSize;
-      if (newCount % VectorBlockSize)
-         blocks++;
-      S32 mem_size = blocks * VectorBlockSize * elemSize;
-
-      const char* pUseFileName = fileName != NULL ? fileName : __FILE__;
-      U32 useLineNum           = fileName != NULL ? lineNum  : __LINE__;
+      const U32 capacity = VectorCapacity(*aSize, newCount);
+      S32 mem_size = capacity * elemSize;
 
-      if (*arrayPtr != NULL)
+      if (allocator != NULL)
       {
-         *arrayPtr = dRealloc_r(*arrayPtr, mem_size, pUseFileName, useLineNum);
+         *arrayPtr = allocator->reallocate(*arrayPtr, *aSize * elemSize, mem_size);
       }
       else
       {
-         *arrayPtr = dMalloc_r(mem_size, pUseFileName, useLineNum);
+         const char* pUseFileName = fileName != NULL ? fileName : __FILE__;
+         U32 useLineNum           = fileName != NULL ? lineNum  : __LINE__;
+
+         if (*arrayPtr != NULL)
+         {
+            *arrayPtr = dRealloc_r(*arrayPtr, mem_size, pUseFileName, useLineNum);
+         }
+         else
+         {
+            *arrayPtr = dMalloc_r(mem_size, pUseFileName, useLineNum);
+         }
       }
 
       *aCount = newCount;
-      *aSize = blocks * VectorBlockSize;
+      *aSize = capacity;
       return true;
    }
 
    if (*arrayPtr) {
-      dFree(*arrayPtr);
+      if (allocator != NULL)
+         allocator->reallocate(*arrayPtr, *aSize * elemSize, 0);
+      else
+         dFree(*arrayPtr);
       *arrayPtr = 0;
    }
 
@@ -65,25 +93,29 @@ bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 el
 
 #else
 
-bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 elemSize )
+bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 elemSize, VectorAllocator* allocator )
 {
    if (newCount > 0)
    {
-      U32 blocks = newCount / VectorBlockSize;
-      if (newCount % VectorBlockSize)
-         blocks++;
-      S32 mem_size = blocks * VectorBlockSize * elemSize;
-      *arrayPtr = *arrayPtr ? dRealloc(*arrayPtr,mem_size) :
-         dMalloc(mem_size);
+      const U32 capacity = VectorCapacity(*aSize, newCount);
+      S32 mem_size = capacity * elemSize;
+      if (allocator != NULL)
+         *arrayPtr = allocator->reallocate(*arrayPtr, *aSize * elemSize, mem_size);
+      else
+         *arrayPtr = *arrayPtr ? dRealloc(*arrayPtr,mem_size) :
+            dMalloc(mem_size);
 
       *aCount = newCount;
-      *aSize = blocks * VectorBlockSize;
+      *aSize = capacity;
       return true;
    }
 
    if (*arrayPtr) 
    {
-      dFree(*arrayPtr);
+      if (allocator != NULL)
+         allocator->reallocate(*arrayPtr, *aSize * elemSize, 0);
+      else
+         dFree(*arrayPtr);
       *arrayPtr = 0;
    }
 
@@ -31,14 +31,35 @@
 //-----------------------------------------------------------------------------
 
 /// Size of memory blocks to allocate at a time for vectors.
+/// Capacity is always a multiple of this and grows by at least half again each time.
 const static S32 VectorBlockSize = 16;
 
+//-----------------------------------------------------------------------------
+/// Provides the memory for a vector instead of the heap.
+///
+/// An allocator is used for frame or arena memory where the storage is released
+/// in bulk.  The allocator must outlive any vector using it.
+class VectorAllocator
+{
+  public:
+   virtual ~VectorAllocator() {}
+
+   /// Resize the memory for a vector preserving its contents up to the smaller size.
+   ///
+   /// @param memory   The current memory or NULL if there is none.
+   /// @param oldSize  The size in bytes of the current memory.
+   /// @param newSize  The size in bytes required.  Zero releases the memory.
+   /// @return The resized memory or NULL if it was released.
+   virtual void* reallocate(void* memory, const U32 oldSize, const U32 newSize) = 0;
+};
+
 #ifdef TORQUE_DEBUG
 extern bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 elemSize,
+                         VectorAllocator* allocator,
                          const char* fileName,
                          const U32   lineNum);
 #else
-extern bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 elemSize);
+extern bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 elemSize, VectorAllocator* allocator);
 #endif
 
 /// Use the following macro to bind a vector to a particular line
@@ -73,6 +94,7 @@ class Vector
    U32 mElementCount;
    U32 mArraySize;
    T*  mArray;
+   VectorAllocator* mAllocator;
 
 #ifdef TORQUE_DEBUG
    const char* mFileAssociation;
@@ -94,6 +116,11 @@ class Vector
    void setFileAssociation(const char* file, const U32 line);
 #endif
 
+   /// Use an allocator for the memory instead of the heap.  NULL uses the heap.
+   /// Any existing memory is released so this is best done before the vector is used.
+   void setAllocator(VectorAllocator* allocator);
+   VectorAllocator* getAllocator() const { return mAllocator; }
+
    /// @name STL interface
    /// @{
 
@@ -179,7 +206,10 @@ class Vector
 
 template<class T> inline Vector<T>::~Vector()
 {
-   dFree(mArray);
+   if (mAllocator)
+      mAllocator->reallocate(mArray, mArraySize * sizeof(T), 0);
+   else
+      dFree(mArray);
 }
 
 template<class T> inline Vector<T>::Vector(const U32 initialSize)
@@ -192,6 +222,7 @@ template<class T> inline Vector<T>::Vector(const U32 initialSize)
    mArray        = 0;
    mElementCount = 0;
    mArraySize    = 0;
+   mAllocator    = NULL;
    if(initialSize)
       reserve(initialSize);
 }
@@ -213,6 +244,7 @@ template<class T> inline Vector<T>::Vector(const U32 initialSize,
    mArray        = 0;
    mElementCount = 0;
    mArraySize    = 0;
+   mAllocator    = NULL;
    if(initialSize)
       reserve(initialSize);
 }
@@ -231,6 +263,7 @@ template<class T> inline Vector<T>::Vector(const char* fileName,
    mArray        = 0;
    mElementCount = 0;
    mArraySize    = 0;
+   mAllocator    = NULL;
 }
 
 template<class T> inline Vector<T>::Vector(const Vector& p)
@@ -241,6 +274,9 @@ template<class T> inline Vector<T>::Vector(const Vector& p)
 #endif
 
    mArray = 0;
+   mElementCount = 0;
+   mArraySize = 0;
+   mAllocator = NULL;
    resize(p.mElementCount);
    if (p.mElementCount)
       dMemcpy(mArray,p.mArray,mElementCount * sizeof(value_type));
@@ -256,6 +292,18 @@ template<class T> inline void Vector<T>::setFileAssociation(const char* file,
 }
 #endif
 
+template<class T> inline void Vector<T>::setAllocator(VectorAllocator* allocator)
+{
+   if (allocator == mAllocator)
+      return;
+
+   AssertFatal(mElementCount == 0, "Vector<T>::setAllocator - cannot change the allocator of a vector with elements.");
+
+   // Release any memory from the current allocator.
+   resize(0);
+   mAllocator = allocator;
+}
+
 template<class T> inline void  Vector<T>::destroy(U32 start, U32 end) // destroys from start to end-1
 {
    // This check is a little generous as we can legitimately get (0,0) as
@@ -623,9 +671,9 @@ template<class T> inline bool Vector<T>::resize(U32 ecount)
 {
 #ifdef TORQUE_DEBUG
    return VectorResize(&mArraySize, &mElementCount, (void**) &mArray, ecount, sizeof(T),
-                       mFileAssociation, mLineAssociation);
+                       mAllocator, mFileAssociation, mLineAssociation);
 #else
-   return VectorResize(&mArraySize, &mElementCount, (void**) &mArray, ecount, sizeof(T));
+   return VectorResize(&mArraySize, &mElementCount, (void**) &mArray, ecount, sizeof(T), mAllocator);
 #endif
 }
 
@@ -820,5 +868,94 @@ template<class T> inline const T& VectorPtr<T>::operator[](U32 index) const
    return (const T&)Parent::operator[](index);
 }
 
+//-----------------------------------------------------------------------------
+/// A vector with inline storage for a small number of elements.
+///
+/// Nothing is allocated until more than InlineCount elements are held which
+/// suits the short-lived vectors used in hot paths.  Once on the heap the vector
+/// stays there.  The element rules are the same as Vector.
+///
+/// @note The inline storage is part of the object so an InlineVector must not be
+///       moved with dMemcpy, for instance by storing it in another Vector.
+template<class T, U32 InlineCount>
+class InlineVector : public Vector<T>
+{
+   typedef Vector<T> Parent;
+
+   /// Hands out the inline storage until it is too small.
+   class InlineAllocator : public VectorAllocator
+   {
+     public:
+      alignas(T) U8 mStorage[InlineCount * sizeof(T)];
+
+      virtual void* reallocate(void* memory, const U32 oldSize, const U32 newSize)
+      {
+         if (newSize == 0)
+         {
+            if (memory != mStorage)
+               dFree(memory);
+            return NULL;
+         }
+
+         // Stay inline if possible.
+         if ((memory == NULL || memory == mStorage) && newSize <= sizeof(mStorage))
+            return mStorage;
+
+         // Move from the inline storage to the heap.
+         if (memory == mStorage)
+         {
+            void* heap = dMalloc(newSize);
+            dMemcpy(heap, mStorage, oldSize < newSize ? oldSize : newSize);
+            return heap;
+         }
+
+         return memory ? dRealloc(memory, newSize) : dMalloc(newSize);
+      }
+   };
+
+   InlineAllocator mInlineAllocator;
+
+   void useInlineStorage()
+   {
+      this->mAllocator = &mInlineAllocator;
+      this->mArray = (T*)mInlineAllocator.mStorage;
+      this->mArraySize = InlineCount;
+   }
+
+  public:
+   InlineVector()
+   {
+      useInlineStorage();
+   }
+
+   InlineVector(const InlineVector& p)
+   {
+      useInlineStorage();
+      Parent::operator=(p);
+   }
+
+   ~InlineVector()
+   {
+      // Release any heap memory while the inline allocator still exists.
+      this->resize(0);
+      this->mAllocator = NULL;
+   }
+
+   InlineVector& operator=(const Vector<T>& p)
+   {
+      Parent::operator=(p);
+      return *this;
+   }
+
+   InlineVector& operator=(const InlineVector& p)
+   {
+      Parent::operator=(p);
+      return *this;
+   }
+
+   /// Whether the elements are still held in the inline storage.
+   bool isInline() const { return this->mArray == (T*)mInlineAllocator.mStorage; }
+};
+
 #endif //_VECTOR_H_
 
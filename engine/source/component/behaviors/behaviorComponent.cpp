@@ -22,6 +22,7 @@
 
 #include "io/stream.h"
 #include "string/stringUnit.h"
+#include "string/stringStack.h"
 #include "memory/frameAllocator.h"
 
 #include "component/behaviors/behaviorComponent.h"
@@ -39,11 +40,20 @@
 #include "persistence/taml/taml.h"
 #endif
 
+// Debug Profiling.
+#include "debug/profiler.h"
+
 // Script bindings.
 #include "behaviorComponent_ScriptBinding.h"
 
 //-----------------------------------------------------------------------------
 
+// Needed to be able to directly call execute on a Namespace::Entry
+extern ExprEvalState gEvalState;
+extern StringStack STR;
+
+//-----------------------------------------------------------------------------
+
 static StringTableEntry behaviorIdFieldName         = StringTable->insert( "Id" );
 static StringTableEntry behaviorNodeName            = StringTable->insert( "Behaviors" );
 static StringTableEntry behaviorConnectionTypeName  = StringTable->insert( "Connection" );
@@ -53,13 +63,23 @@ static StringTableEntry behaviorTemplateAssetName   = StringTable->insert( "Asse
 
 BehaviorComponent::BehaviorComponent() :
     mMasterBehaviorId( 1 ),
-    mpBehaviorFieldNames( NULL )
+    mpBehaviorFieldNames( NULL ),
+    mMethodRouteSequence( Namespace::mCacheSequence ),
+    mMethodRouteVersion( 0 )
 {
     SIMSET_SET_ASSOCIATION( mBehaviors );
 }
 
 //-----------------------------------------------------------------------------
 
+BehaviorComponent::~BehaviorComponent()
+{
+    // Discard method routes.
+    invalidateMethodRoutes();
+}
+
+//-----------------------------------------------------------------------------
+
 bool BehaviorComponent::onAdd()
 {
     if( !Parent::onAdd() )
@@ -193,6 +213,9 @@ bool BehaviorComponent::addBehavior( BehaviorInstance* bi )
     // Store behavior.
     mBehaviors.pushObject( bi );
 
+    // Discard method routes.
+    invalidateMethodRoutes();
+
     // Notify if the behavior instance is destroyed.
     deleteNotify( bi );
 
@@ -218,6 +241,9 @@ bool BehaviorComponent::removeBehavior( BehaviorInstance *bi, bool deleteBehavio
         {
             mBehaviors.removeObject( *itr );
 
+            // Discard method routes.
+            invalidateMethodRoutes();
+
             // Perform callback if allowed.
             if( bi->isProperlyAdded() && bi->isMethod("onBehaviorRemove") )
                 Con::executef( bi , 1, "onBehaviorRemove" );
@@ -282,7 +308,13 @@ bool BehaviorComponent::reOrder( BehaviorInstance *obj, U32 desiredIndex /* = 0
         return false;
 
     SimObject *target = mBehaviors.at( desiredIndex );
-    return mBehaviors.reOrder( obj, target );
+    if ( !mBehaviors.reOrder( obj, target ) )
+        return false;
+
+    // Discard method routes.
+    invalidateMethodRoutes();
+
+    return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -733,9 +765,41 @@ bool BehaviorComponent::raise( BehaviorInstance* pOutputBehavior, StringTableEnt
             return false;
         }
 #endif
+        // Resolve the input dispatch if the namespaces have changed.
+        if ( connectionItr->mInputSequence != Namespace::mCacheSequence )
+            resolveBehaviorInput( connectionItr );
+
+        // Does the input have a native handler?
+        if ( connectionItr->mInputHandler != NULL )
+        {
+            // Yes, so call it.
+            connectionItr->mInputHandler( pInputBehavior, pOutputBehavior, pOutputName );
+            continue;
+        }
+
+        // Finish if the input has no method.
+        if ( connectionItr->mpInputEntry == NULL )
+            continue;
+
         // Execute a callback for the input.
         // NOTE: This callback should not delete behaviors otherwise strange things can happen!
-        Con::executef( pInputBehavior, 3, pInputName, pOutputBehavior->getIdString(), pOutputName );
+        const char* argv[4];
+        argv[0] = pInputName;
+        argv[1] = pInputBehavior->getIdString();
+        argv[2] = pOutputBehavior->getIdString();
+        argv[3] = pOutputName;
+
+        pInputBehavior->pushScriptCallbackGuard();
+
+        SimObject* save = gEvalState.thisObject;
+        gEvalState.thisObject = pInputBehavior;
+        connectionItr->mpInputEntry->execute( 4, argv, &gEvalState );
+        gEvalState.thisObject = save;
+
+        pInputBehavior->popScriptCallbackGuard();
+
+        // Reset the function offset so the stack doesn't continue to grow unnecessarily.
+        STR.clearFunctionOffset();
     }
 
     return true;
@@ -743,6 +807,23 @@ bool BehaviorComponent::raise( BehaviorInstance* pOutputBehavior, StringTableEnt
 
 //-----------------------------------------------------------------------------
 
+void BehaviorComponent::resolveBehaviorInput( BehaviorPortConnection* pConnection )
+{
+    BehaviorInstance* pInputBehavior = pConnection->mInputInstance;
+
+    // Fetch any native handler.
+    BehaviorTemplate::BehaviorPortInput* pInput = pInputBehavior->getTemplate()->getBehaviorInput( pConnection->mInputName );
+    pConnection->mInputHandler = pInput != NULL ? pInput->mHandler : NULL;
+
+    // Fetch the input method.
+    Namespace* pNamespace = pInputBehavior->getNamespace();
+    pConnection->mpInputEntry = pNamespace != NULL ? pNamespace->lookup( pConnection->mInputName ) : NULL;
+
+    pConnection->mInputSequence = Namespace::mCacheSequence;
+}
+
+//-----------------------------------------------------------------------------
+
 U32 BehaviorComponent::getBehaviorConnectionCount( BehaviorInstance* pOutputBehavior, StringTableEntry pOutputName )
 {
     // Sanity!
@@ -926,14 +1007,11 @@ bool BehaviorComponent::handlesConsoleMethod( const char *fname, S32 *routingId
    if( dStricmp( fname, "delete" ) == 0 )
       return Parent::handlesConsoleMethod( fname, routingId );
 
-   for( SimSet::iterator nItr = mBehaviors.begin(); nItr != mBehaviors.end(); nItr++ )
+   // Does any behavior implement the method?
+   if( !mBehaviors.empty() && findMethodRoutes( fname )->size() > 0 )
    {
-      SimObject *pComponent = dynamic_cast<SimObject *>(*nItr);
-      if( pComponent != NULL && pComponent->isMethod( fname ) )
-      {
-         *routingId = -2; // -2 denotes method on component
-         return true;
-      }
+      *routingId = -2; // -2 denotes method on component
+      return true;
    }
 
    // Let parent handle it
@@ -942,65 +1020,109 @@ bool BehaviorComponent::handlesConsoleMethod( const char *fname, S32 *routingId
 
 //-----------------------------------------------------------------------------
 
-// Needed to be able to directly call execute on a Namespace::Entry
-extern ExprEvalState gEvalState;
+const BehaviorComponent::typeMethodRouteVector* BehaviorComponent::findMethodRoutes( const char* pMethodName )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(BehaviorComponent_FindMethodRoutes);
 
-const char *BehaviorComponent::callOnBehaviors( U32 argc, const char *argv[] )
-{   
-    if( mBehaviors.empty() )   
-        return Parent::callOnBehaviors( argc, argv );
-      
-    // Copy the arguments to avoid weird clobbery situations.
-    FrameTemp<char *> argPtrs (argc);
-   
-    U32 strdupWatermark = FrameAllocator::getWaterMark();
-    for( U32 i = 0; i < argc; i++ )
+    // Discard the routes if the namespaces have changed.
+    if ( mMethodRouteSequence != Namespace::mCacheSequence )
     {
-        argPtrs[i] = reinterpret_cast<char *>( FrameAllocator::alloc( dStrlen( argv[i] ) + 1 ) );
-        dStrcpy( argPtrs[i], argv[i] );
+        invalidateMethodRoutes();
+        mMethodRouteSequence = Namespace::mCacheSequence;
     }
 
-    // Walk backwards through the list just as with components
-    const char* result = "";
-    bool handled = false;
-    for( SimSet::iterator i = (mBehaviors.end()-1); i >= mBehaviors.begin(); i-- )
+    // Find the method routes.
+    typeMethodRouteHash::iterator routeItr = mMethodRoutes.find( pMethodName );
+
+    // Return them if found.
+    if ( routeItr != mMethodRoutes.end() )
+        return routeItr->value;
+
+    // Resolve the method on each behavior.
+    StringTableEntry methodName = StringTable->insert( pMethodName );
+    typeMethodRouteVector* pRoutes = new typeMethodRouteVector();
+    for( SimSet::iterator itr = mBehaviors.begin(); itr != mBehaviors.end(); ++itr )
     {
-        BehaviorInstance *pBehavior = dynamic_cast<BehaviorInstance *>( *i );
-        AssertFatal( pBehavior, "BehaviorComponent::callOnBehaviors - Bad behavior instance in list." );
-        AssertFatal( pBehavior->getId() > 0, "Invalid id for behavior component" );
+        BehaviorInstance *pBehavior = dynamic_cast<BehaviorInstance *>( *itr );
+        AssertFatal( pBehavior, "BehaviorComponent::findMethodRoutes - Bad behavior instance in list." );
 
         // Use the BehaviorInstance's namespace
         Namespace *pNamespace = pBehavior->getNamespace();
-        if(!pNamespace)
+        if ( !pNamespace )
             continue;
 
-        // Lookup the Callback Namespace entry and then splice callback
-        const char *cbName = StringTable->insert(argv[0]);
-        Namespace::Entry *pNSEntry = pNamespace->lookup(cbName);
-        if( pNSEntry )
-        {
-            // Set %this to our BehaviorInstance's Object ID
-            argPtrs[1] = const_cast<char *>( pBehavior->getIdString() );
+        Namespace::Entry* pNSEntry = pNamespace->lookup( methodName );
+        if ( !pNSEntry )
+            continue;
 
-            // Change the Current Console object, execute, restore Object
-            SimObject *save = gEvalState.thisObject;
-            gEvalState.thisObject = pBehavior;
+        BehaviorMethodRoute route;
+        route.mpBehavior = pBehavior;
+        route.mBehaviorObjectId = pBehavior->getId();
+        route.mpEntry = pNSEntry;
+        pRoutes->push_back( route );
+    }
 
-            result = pNSEntry->execute(argc, const_cast<const char **>( ~argPtrs ), &gEvalState);
+    // Store the routes.
+    mMethodRoutes.insert( methodName, pRoutes );
 
-            gEvalState.thisObject = save;
-            handled = true;
-            break;
-        }
+    return pRoutes;
+}
+
+//-----------------------------------------------------------------------------
+
+void BehaviorComponent::invalidateMethodRoutes( void )
+{
+    for( typeMethodRouteHash::iterator routeItr = mMethodRoutes.begin(); routeItr != mMethodRoutes.end(); ++routeItr )
+    {
+        delete routeItr->value;
     }
+    mMethodRoutes.clear();
+
+    // Flag that any routes in use are stale.
+    mMethodRouteVersion++;
+}
+
+//-----------------------------------------------------------------------------
 
-    // If this wasn't handled by a behavior above then pass along to the parent DynamicConsoleMethodComponent
+const char *BehaviorComponent::callOnBehaviors( U32 argc, const char *argv[] )
+{   
+    if( mBehaviors.empty() )   
+        return Parent::callOnBehaviors( argc, argv );
+
+    // The last behavior implementing the method handles it, just as with components.
+    const typeMethodRouteVector* pRoutes = findMethodRoutes( argv[0] );
+
+    // If this isn't handled by a behavior then pass along to the parent DynamicConsoleMethodComponent
     // to deal with it.  If the parent cannot handle the message it will return an error string.
-    if (!handled)
+    if ( pRoutes->size() == 0 )
+        return Parent::callOnBehaviors( argc, argv );
+
+    const BehaviorMethodRoute& route = pRoutes->last();
+    BehaviorInstance* pBehavior = route.mpBehavior;
+    AssertFatal( pBehavior->getId() > 0, "Invalid id for behavior component" );
+
+    // Copy the arguments to avoid weird clobbery situations.
+    FrameTemp<char *> argPtrs (argc);
+   
+    U32 strdupWatermark = FrameAllocator::getWaterMark();
+    for( U32 i = 0; i < argc; i++ )
     {
-        result = Parent::callOnBehaviors( argc, argv );
+        argPtrs[i] = reinterpret_cast<char *>( FrameAllocator::alloc( dStrlen( argv[i] ) + 1 ) );
+        dStrcpy( argPtrs[i], argv[i] );
     }
 
+    // Set %this to our BehaviorInstance's Object ID
+    argPtrs[1] = const_cast<char *>( pBehavior->getIdString() );
+
+    // Change the Current Console object, execute, restore Object
+    SimObject *save = gEvalState.thisObject;
+    gEvalState.thisObject = pBehavior;
+
+    const char* result = route.mpEntry->execute(argc, const_cast<const char **>( ~argPtrs ), &gEvalState);
+
+    gEvalState.thisObject = save;
+
     // Clean up.
     FrameAllocator::setWaterMark( strdupWatermark );
 
@@ -1013,7 +1135,20 @@ const char *BehaviorComponent::_callMethod( U32 argc, const char *argv[], bool c
 {   
     if( mBehaviors.empty() )   
         return Parent::_callMethod( argc, argv, callThis );
-     
+
+    // Fetch the behaviors implementing the method.
+    const typeMethodRouteVector* pRoutes = findMethodRoutes( argv[0] );
+
+    // Pass this up to the parent if no behavior implements the method.
+    if ( pRoutes->size() == 0 )
+        return Parent::_callMethod( argc, argv, callThis );
+
+    // Copy the routes as a behavior method can change the behaviors.
+    const U32 routeCount = (U32)pRoutes->size();
+    const U32 routeVersion = mMethodRouteVersion;
+    FrameTemp<BehaviorMethodRoute> routes( routeCount );
+    dMemcpy( ~routes, pRoutes->address(), sizeof(BehaviorMethodRoute) * routeCount );
+
     // Copy the arguments to avoid weird clobbery situations.
     FrameTemp<char *> argPtrs (argc);
    
@@ -1024,33 +1159,37 @@ const char *BehaviorComponent::_callMethod( U32 argc, const char *argv[], bool c
         dStrcpy( argPtrs[i], argv[i] );
     }
 
-    for( SimSet::iterator i = mBehaviors.begin(); i != mBehaviors.end(); i++ )
+    for( U32 index = 0; index < routeCount; ++index )
     {
-        BehaviorInstance *pBehavior = dynamic_cast<BehaviorInstance *>( *i );
-        AssertFatal( pBehavior, "BehaviorComponent::_callMethod - Bad behavior instance in list." );
-        AssertFatal( pBehavior->getId() > 0, "Invalid id for behavior component" );
-
-        // Use the BehaviorInstance's namespace
-        Namespace *pNamespace = pBehavior->getNamespace();
-        if(!pNamespace)
-            continue;
+        BehaviorInstance* pBehavior = routes[index].mpBehavior;
+        Namespace::Entry* pNSEntry = routes[index].mpEntry;
 
-        // Lookup the Callback Namespace entry and then splice callback
-        const char *cbName = StringTable->insert(argv[0]);
-        Namespace::Entry *pNSEntry = pNamespace->lookup(cbName);
-        if( pNSEntry )
+        // Have the behaviors changed during a previous call?
+        if ( routeVersion != mMethodRouteVersion )
         {
-            // Set %this to our BehaviorInstance's Object ID
-            argPtrs[1] = const_cast<char *>( pBehavior->getIdString() );
+            // Yes, so skip the behavior if it's gone or no longer ours.
+            pBehavior = dynamic_cast<BehaviorInstance*>( Sim::findObject( routes[index].mBehaviorObjectId ) );
+            if ( pBehavior == NULL || pBehavior->getBehaviorOwner() != this || pBehavior->getNamespace() == NULL )
+                continue;
+
+            // Resolve the method again.
+            pNSEntry = pBehavior->getNamespace()->lookup( StringTable->insert( argv[0] ) );
+            if ( pNSEntry == NULL )
+                continue;
+        }
+
+        AssertFatal( pBehavior->getId() > 0, "Invalid id for behavior component" );
 
-            // Change the Current Console object, execute, restore Object
-            SimObject *save = gEvalState.thisObject;
-            gEvalState.thisObject = pBehavior;
+        // Set %this to our BehaviorInstance's Object ID
+        argPtrs[1] = const_cast<char *>( pBehavior->getIdString() );
 
-            pNSEntry->execute(argc, const_cast<const char **>( ~argPtrs ), &gEvalState);
+        // Change the Current Console object, execute, restore Object
+        SimObject *save = gEvalState.thisObject;
+        gEvalState.thisObject = pBehavior;
 
-            gEvalState.thisObject = save;
-        }
+        pNSEntry->execute(argc, const_cast<const char **>( ~argPtrs ), &gEvalState);
+
+        gEvalState.thisObject = save;
     }
 
     // Pass this up to the parent since a BehaviorComponent is still a DynamicConsoleMethodComponent
@@ -47,6 +47,22 @@ private:
 
     Vector<StringTableEntry>* mpBehaviorFieldNames;
 
+    /// A behavior that implements a method.
+    struct BehaviorMethodRoute
+    {
+        BehaviorInstance*   mpBehavior;
+        SimObjectId         mBehaviorObjectId;
+        Namespace::Entry*   mpEntry;
+    };
+
+    /// Method routing.
+    /// NOTE: Routes are resolved per method name on first use, including methods that no behavior implements.
+    /// They are discarded when behaviors are added, removed or reordered and when the namespaces change.
+    typedef Vector<BehaviorMethodRoute> typeMethodRouteVector;
+    typedef HashMap<StringTableEntry, typeMethodRouteVector*> typeMethodRouteHash;
+    typeMethodRouteHash mMethodRoutes;
+    U32 mMethodRouteSequence;
+    U32 mMethodRouteVersion;
 
 public:
     /// A behavior port connection.
@@ -62,12 +78,20 @@ public:
             mInputInstance  = pInputBehavior;
             mOutputName     = pOutputName;
             mInputName      = pInputName;
+            mInputHandler   = NULL;
+            mpInputEntry    = NULL;
+            mInputSequence  = Namespace::mCacheSequence - 1;
         }
 
         BehaviorInstance*   mOutputInstance;
         BehaviorInstance*   mInputInstance;
         StringTableEntry    mOutputName;
         StringTableEntry    mInputName;
+
+        /// Resolved input dispatch.
+        BehaviorInputHandler mInputHandler;
+        Namespace::Entry*   mpInputEntry;
+        U32                 mInputSequence;
     };
 
     /// Behavior connection map.
@@ -87,11 +111,14 @@ protected:
 private:
     void destroyBehaviorOutputConnections( BehaviorInstance* pOutputBehavior );
     void destroyBehaviorInputConnections( BehaviorInstance* pInputBehavior );
+    const typeMethodRouteVector* findMethodRoutes( const char* pMethodName );
+    void invalidateMethodRoutes( void );
+    void resolveBehaviorInput( BehaviorPortConnection* pConnection );
     
   
 public:
     BehaviorComponent();
-    virtual ~BehaviorComponent() {}
+    virtual ~BehaviorComponent();
 
     /// SimObject overrides
     virtual bool onAdd();
@@ -38,6 +38,13 @@
 
 class BehaviorTemplate;
 class BehaviorComponent;
+class BehaviorInstance;
+
+//-----------------------------------------------------------------------------
+
+/// A native handler for a behavior input.
+/// Raising a connected output calls this directly instead of the input's script method.
+typedef void (*BehaviorInputHandler)( BehaviorInstance* pInputBehavior, BehaviorInstance* pOutputBehavior, StringTableEntry pOutputName );
 
 //-----------------------------------------------------------------------------
 
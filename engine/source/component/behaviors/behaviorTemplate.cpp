@@ -23,6 +23,7 @@
 #include "platform/platform.h"
 #include "sim/simBase.h"
 #include "console/consoleTypes.h"
+#include "console/consoleInternal.h"
 #include "component/simComponent.h"
 #include "component/behaviors/behaviorTemplate.h"
 #include "memory/safeDelete.h"
@@ -156,3 +157,27 @@ bool BehaviorTemplate::addBehaviorInput( const char* name, const char* label, co
 
     return true;
 }
+
+//-----------------------------------------------------------------------------
+
+bool BehaviorTemplate::setBehaviorInputHandler( const char* name, BehaviorInputHandler handler )
+{
+    // Fetch input.
+    BehaviorPortInput* pInput = getBehaviorInput( name );
+
+    // Does the behavior have the input?
+    if ( pInput == NULL )
+    {
+        // No, so warn.
+        Con::warnf("Behavior input named '%s' on template '%s' does not exist.", name, mFriendlyName );
+        return false;
+    }
+
+    // Set handler.
+    pInput->mHandler = handler;
+
+    // Discard any resolved input dispatch.
+    Namespace::trashCache();
+
+    return true;
+}
@@ -75,9 +75,12 @@ public:
     struct BehaviorPortInput : public BehaviorPort
     {
         BehaviorPortInput( const char* name, const char* label, const char* description ) :
-            BehaviorPort( name, label, description )
+            BehaviorPort( name, label, description ),
+            mHandler( NULL )
             {
             }
+
+        BehaviorInputHandler mHandler;
     };
 
     /// A behavior port that raises an output.
@@ -162,6 +165,20 @@ public:
         }
         return false;
     }
+    inline BehaviorPortInput* getBehaviorInput( const char* portName )
+    {
+        StringTableEntry name = StringTable->insert( portName );
+        for( Vector<BehaviorPortInput>::iterator itr = mPortInputs.begin(); itr != mPortInputs.end(); ++itr )
+        {
+            // Check if found.
+            if ( name == itr->mName )
+                return itr;
+        }
+        return NULL;
+    }
+
+    /// Handle an input natively rather than with a script method.
+    bool setBehaviorInputHandler( const char* portName, BehaviorInputHandler handler );
 
     DECLARE_CONOBJECT(BehaviorTemplate);
 
@@ -936,6 +936,8 @@ void addCommand(const char *name,BoolCallback cb,const char *usage, S32 minArgs,
 
 const char *evaluate(const char* string, bool echo, const char *fileName)
 {
+   Memory::TagScope memoryTag( Memory::TagConsole );
+
    if (echo)
       Con::printf("%s%s", getVariable( "$Con::Prompt" ), string);
 
@@ -974,6 +976,8 @@ const char *execute(S32 argc, const char *argv[])
    if(isMainThread())
    {
 #endif
+      Memory::TagScope memoryTag( Memory::TagConsole );
+
       Namespace::Entry *ent;
       StringTableEntry funcName = StringTable->insert(argv[0]);
       ent = Namespace::global()->lookup(funcName);
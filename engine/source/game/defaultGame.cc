@@ -35,6 +35,7 @@
 #include "io/resource/resourceManager.h"
 #include "io/fileStream.h"
 #include "graphics/TextureManager.h"
+#include "graphics/TextLayoutCache.h"
 #include "console/console.h"
 #include "sim/simBase.h"
 #include "gui/guiCanvas.h"
@@ -49,6 +50,7 @@
 #include "io/resource/resourceManager.h"
 #include "platform/platformVideo.h"
 #include "network/netStringTable.h"
+#include "network/netScopeGrid.h"
 #include "memory/frameAllocator.h"
 #include "game/version.h"
 #include "debug/profiler.h"
@@ -138,6 +140,7 @@ bool initializeLibraries()
 #endif	//TORQUE_OS_IOS
 
     TextureManager::create();
+    TextLayoutCache::create();
     ResManager::create();
 
     // Register known file types here
@@ -153,6 +156,7 @@ bool initializeLibraries()
    
     Platform::initConsole();
     NetStringTable::create();
+    NetScopeGrid::create();
    
     TelnetConsole::create();
     TelnetDebugger::create();
@@ -185,9 +189,11 @@ void shutdownLibraries()
     Platform::shutdown();
     SFXDevice::shutdown();
     NetStringTable::destroy();
+    NetScopeGrid::destroy();
     Con::shutdown();
 
     ResManager::destroy();
+    TextLayoutCache::destroy();
     TextureManager::destroy();
 
     // Destroy the stock colors.
@@ -195,6 +201,10 @@ void shutdownLibraries()
 
     _StringTable::destroy();
 
+    // Report any memory still allocated.
+    if ( Memory::isTracking() )
+        Memory::reportLeaks( 50 );
+
     // asserts should be destroyed LAST
     FrameAllocator::destroy();
 
@@ -480,6 +490,7 @@ void DefaultGame::mainLoop( void )
          PROFILE_START(GameProcessEvents);
     Game->processEvents(); // process all non-sim posted events.
          PROFILE_END();
+    FrameAllocator::endFrame(); // release this frame's render and tick memory.
          PROFILE_END();
     
 #ifdef TORQUE_OS_IOS_PROFILE
@@ -758,3 +769,17 @@ void DefaultGame::processPacketReceiveEvent(PacketReceiveEvent * prEvent)
    GNet->processPacketReceiveEvent(prEvent);
 }
 
+//--------------------------------------------------------------------------
+
+void DefaultGame::processPacketBuffer(NetPacketBuffer *buffer)
+{
+   // Journals record events so packets must go through the event queue.
+   if(isJournalReading() || isJournalWriting())
+   {
+      GameInterface::processPacketBuffer(buffer);
+      return;
+   }
+
+   GNet->processPacketBuffer(buffer);
+}
+
@@ -62,6 +62,7 @@ public:
     void processScreenTouchEvent(ScreenTouchEvent *event);
     void processConsoleEvent(ConsoleEvent *event);
     void processPacketReceiveEvent(PacketReceiveEvent *event);
+    void processPacketBuffer(NetPacketBuffer *buffer);
     void processConnectedAcceptEvent(ConnectedAcceptEvent *event);
     void processConnectedReceiveEvent(ConnectedReceiveEvent *event);
     void processConnectedNotifyEvent(ConnectedNotifyEvent *event);
@@ -26,6 +26,7 @@
 #include "io/fileStream.h"
 #include "console/console.h"
 #include "platform/threads/mutex.h"
+#include "platform/platformNetPacket.h"
 
 // Script binding.
 #include "game/gameInterface_ScriptBinding.h"
@@ -144,6 +145,15 @@ void GameInterface::postEvent(Event &event)
 
 
 
+void GameInterface::processPacketBuffer(NetPacketBuffer *buffer)
+{
+   PacketReceiveEvent event;
+   event.sourceAddress = buffer->sourceAddress;
+   dMemcpy(event.data, buffer->data, buffer->size);
+   event.size = PacketReceiveEventHeaderSize + buffer->size;
+   postEvent(event);
+}
+
 void GameInterface::processEvents()
 {
    // We want to lock the queue when processing as well - don't need
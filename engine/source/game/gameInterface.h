@@ -27,6 +27,7 @@
 #include "collection/vector.h"
 
 class FileStream;
+struct NetPacketBuffer;
 
 class GameInterface
 {
@@ -84,6 +85,10 @@ public:
    virtual void processScreenTouchEvent(ScreenTouchEvent *event) = 0;
    virtual void processConsoleEvent(ConsoleEvent *event) = 0;
    virtual void processPacketReceiveEvent(PacketReceiveEvent *event) = 0;
+
+   /// Process a pooled packet buffer.  By default the packet is copied into a
+   /// PacketReceiveEvent and posted so that it is journaled like any other event.
+   virtual void processPacketBuffer(NetPacketBuffer *buffer);
    virtual void processConnectedAcceptEvent(ConnectedAcceptEvent *event) = 0;
    virtual void processConnectedReceiveEvent(ConnectedReceiveEvent *event) = 0;
    virtual void processConnectedNotifyEvent(ConnectedNotifyEvent *event) = 0;
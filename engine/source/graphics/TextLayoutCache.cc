@@ -0,0 +1,399 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "graphics/TextLayoutCache.h"
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+#ifndef _CONSOLETYPES_H_
+#include "console/consoleTypes.h"
+#endif
+
+#include "memory/safeDelete.h"
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+// Script bindings.
+#include "TextLayoutCache_ScriptBinding.h"
+
+//-----------------------------------------------------------------------------
+
+TextLayoutCache::Layout** TextLayoutCache::smBuckets = NULL;
+U32 TextLayoutCache::smBucketCount = 0;
+TextLayoutCache::Layout* TextLayoutCache::smLruHead = NULL;
+TextLayoutCache::Layout* TextLayoutCache::smLruTail = NULL;
+U32 TextLayoutCache::smLayoutCount = 0;
+U32 TextLayoutCache::smGlyphCount = 0;
+U32 TextLayoutCache::smHits = 0;
+U32 TextLayoutCache::smMisses = 0;
+U32 TextLayoutCache::smEvictions = 0;
+S32 TextLayoutCache::smMaxGlyphs = 32768;
+
+static const U32 TextLayoutCacheInitialBuckets = 256;
+
+//-----------------------------------------------------------------------------
+
+TextLayoutCache::Layout::Layout() :
+    mpFont( NULL ),
+    mpText( NULL ),
+    mTextLength( 0 ),
+    mParamCount( 0 ),
+    mHash( 0 ),
+    mAdvance( 0.0f ),
+    mCacheable( true ),
+    mRefCount( 0 ),
+    mCommitted( false ),
+    mValid( true ),
+    mpHashNext( NULL ),
+    mpLruPrev( NULL ),
+    mpLruNext( NULL )
+{
+    VECTOR_SET_ASSOCIATION( mGlyphs );
+}
+
+//-----------------------------------------------------------------------------
+
+TextLayoutCache::Layout::~Layout()
+{
+    SAFE_DELETE_ARRAY( mpText );
+}
+
+//-----------------------------------------------------------------------------
+
+bool TextLayoutCache::Layout::matches( const Key& key, const U32 hash ) const
+{
+    return
+        mHash == hash &&
+        mpFont == key.mpFont &&
+        mTextLength == key.mTextLength &&
+        mParamCount == key.mParamCount &&
+        dMemcmp( mParams, key.mParams, sizeof(F32) * mParamCount ) == 0 &&
+        dMemcmp( mpText, key.mpText, sizeof(UTF16) * mTextLength ) == 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void TextLayoutCache::create( void )
+{
+    AssertISV( smBuckets == NULL, "TextLayoutCache::create() - Already created." );
+
+    smBucketCount = TextLayoutCacheInitialBuckets;
+    smBuckets = new Layout*[smBucketCount];
+    dMemset( smBuckets, 0, sizeof(Layout*) * smBucketCount );
+
+    Con::addVariable( "$pref::Video::textLayoutCacheGlyphs", TypeS32, &smMaxGlyphs );
+}
+
+//-----------------------------------------------------------------------------
+
+void TextLayoutCache::destroy( void )
+{
+    // Orphan anything still referenced.
+    flush();
+
+    SAFE_DELETE_ARRAY( smBuckets );
+    smBucketCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 TextLayoutCache::hashKey( const Key& key )
+{
+    // FNV-1a.
+    U32 hash = 2166136261u;
+
+    const U8* pBytes = (const U8*)&key.mpFont;
+    for ( U32 n = 0; n < sizeof(key.mpFont); ++n )
+        hash = (hash ^ pBytes[n]) * 16777619u;
+
+    pBytes = (const U8*)key.mParams;
+    for ( U32 n = 0; n < sizeof(F32) * key.mParamCount; ++n )
+        hash = (hash ^ pBytes[n]) * 16777619u;
+
+    for ( U32 n = 0; n < key.mTextLength; ++n )
+        hash = (hash ^ key.mpText[n]) * 16777619u;
+
+    return hash;
+}
+
+//-----------------------------------------------------------------------------
+
+void TextLayoutCache::link( Layout* pLayout )
+{
+    // Hash chain.
+    Layout*& bucket = smBuckets[pLayout->mHash & (smBucketCount-1)];
+    pLayout->mpHashNext = bucket;
+    bucket = pLayout;
+
+    // Most-recently used.
+    pLayout->mpLruPrev = NULL;
+    pLayout->mpLruNext = smLruHead;
+    if ( smLruHead != NULL )
+        smLruHead->mpLruPrev = pLayout;
+    smLruHead = pLayout;
+    if ( smLruTail == NULL )
+        smLruTail = pLayout;
+
+    pLayout->mCommitted = true;
+    smLayoutCount++;
+    smGlyphCount += pLayout->getGlyphCount();
+}
+
+//-----------------------------------------------------------------------------
+
+void TextLayoutCache::unlink( Layout* pLayout )
+{
+    // Hash chain.
+    Layout** ppWalk = &smBuckets[pLayout->mHash & (smBucketCount-1)];
+    while ( *ppWalk != pLayout )
+        ppWalk = &(*ppWalk)->mpHashNext;
+    *ppWalk = pLayout->mpHashNext;
+    pLayout->mpHashNext = NULL;
+
+    // Recently used.
+    if ( pLayout->mpLruPrev != NULL )
+        pLayout->mpLruPrev->mpLruNext = pLayout->mpLruNext;
+    else
+        smLruHead = pLayout->mpLruNext;
+
+    if ( pLayout->mpLruNext != NULL )
+        pLayout->mpLruNext->mpLruPrev = pLayout->mpLruPrev;
+    else
+        smLruTail = pLayout->mpLruPrev;
+
+    pLayout->mpLruPrev = pLayout->mpLruNext = NULL;
+
+    pLayout->mCommitted = false;
+    smLayoutCount--;
+    smGlyphCount -= pLayout->getGlyphCount();
+}
+
+//-----------------------------------------------------------------------------
+
+void TextLayoutCache::touch( Layout* pLayout )
+{
+    // Finish if already most-recently used.
+    if ( pLayout == smLruHead )
+        return;
+
+    pLayout->mpLruPrev->mpLruNext = pLayout->mpLruNext;
+    if ( pLayout->mpLruNext != NULL )
+        pLayout->mpLruNext->mpLruPrev = pLayout->mpLruPrev;
+    else
+        smLruTail = pLayout->mpLruPrev;
+
+    pLayout->mpLruPrev = NULL;
+    pLayout->mpLruNext = smLruHead;
+    smLruHead->mpLruPrev = pLayout;
+    smLruHead = pLayout;
+}
+
+//-----------------------------------------------------------------------------
+
+void TextLayoutCache::rehash( const U32 bucketCount )
+{
+    Layout** pBuckets = new Layout*[bucketCount];
+    dMemset( pBuckets, 0, sizeof(Layout*) * bucketCount );
+
+    for ( U32 n = 0; n < smBucketCount; ++n )
+    {
+        Layout* pLayout = smBuckets[n];
+        while ( pLayout != NULL )
+        {
+            Layout* pNext = pLayout->mpHashNext;
+            Layout*& bucket = pBuckets[pLayout->mHash & (bucketCount-1)];
+            pLayout->mpHashNext = bucket;
+            bucket = pLayout;
+            pLayout = pNext;
+        }
+    }
+
+    delete [] smBuckets;
+    smBuckets = pBuckets;
+    smBucketCount = bucketCount;
+}
+
+//-----------------------------------------------------------------------------
+
+void TextLayoutCache::evict( void )
+{
+    // Evict least-recently used layouts that nobody is holding.
+    Layout* pLayout = smLruTail;
+    while ( pLayout != NULL && smGlyphCount > (U32)getMax( smMaxGlyphs, 0 ) )
+    {
+        Layout* pPrevious = pLayout->mpLruPrev;
+
+        if ( pLayout->mRefCount == 0 )
+        {
+            unlink( pLayout );
+            delete pLayout;
+            smEvictions++;
+        }
+
+        pLayout = pPrevious;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TextLayoutCache::Layout* TextLayoutCache::acquire( const Key& key )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TextLayoutCache_Acquire);
+
+    if ( smBuckets == NULL )
+        return NULL;
+
+    const U32 hash = hashKey( key );
+
+    for ( Layout* pLayout = smBuckets[hash & (smBucketCount-1)]; pLayout != NULL; pLayout = pLayout->mpHashNext )
+    {
+        if ( !pLayout->matches( key, hash ) )
+            continue;
+
+        touch( pLayout );
+        pLayout->mRefCount++;
+        smHits++;
+        return pLayout;
+    }
+
+    smMisses++;
+    return NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+TextLayoutCache::Layout* TextLayoutCache::createLayout( const Key& key )
+{
+    Layout* pLayout = new Layout();
+
+    pLayout->mpFont = key.mpFont;
+    pLayout->mTextLength = key.mTextLength;
+    pLayout->mpText = new UTF16[getMax( key.mTextLength, (U32)1 )];
+    dMemcpy( pLayout->mpText, key.mpText, sizeof(UTF16) * key.mTextLength );
+    pLayout->mParamCount = key.mParamCount;
+    dMemcpy( pLayout->mParams, key.mParams, sizeof(F32) * key.mParamCount );
+    pLayout->mHash = hashKey( key );
+    pLayout->mRefCount = 1;
+
+    return pLayout;
+}
+
+//-----------------------------------------------------------------------------
+
+void TextLayoutCache::commit( Layout* pLayout )
+{
+    AssertFatal( pLayout != NULL && !pLayout->mCommitted, "TextLayoutCache::commit() - Invalid layout." );
+
+    // The caller keeps sole ownership if the cache isn't running.
+    if ( smBuckets == NULL )
+        return;
+
+    // Grow the buckets to keep the chains short.
+    if ( smLayoutCount >= smBucketCount * 2 )
+        rehash( smBucketCount * 2 );
+
+    link( pLayout );
+
+    evict();
+}
+
+//-----------------------------------------------------------------------------
+
+void TextLayoutCache::release( Layout* pLayout )
+{
+    AssertFatal( pLayout != NULL && pLayout->mRefCount > 0, "TextLayoutCache::release() - Invalid layout." );
+
+    if ( --pLayout->mRefCount > 0 )
+        return;
+
+    // Delete layouts that are no longer in the cache.
+    if ( !pLayout->mCommitted )
+    {
+        delete pLayout;
+        return;
+    }
+
+    // Layouts held past the budget can go now.
+    if ( smGlyphCount > (U32)getMax( smMaxGlyphs, 0 ) )
+        evict();
+}
+
+//-----------------------------------------------------------------------------
+
+void TextLayoutCache::purgeFont( const void* pFont )
+{
+    Layout* pLayout = smLruHead;
+    while ( pLayout != NULL )
+    {
+        Layout* pNext = pLayout->mpLruNext;
+
+        if ( pLayout->mpFont == pFont )
+        {
+            unlink( pLayout );
+            pLayout->mValid = false;
+
+            if ( pLayout->mRefCount == 0 )
+                delete pLayout;
+        }
+
+        pLayout = pNext;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void TextLayoutCache::flush( void )
+{
+    while ( smLruHead != NULL )
+    {
+        Layout* pLayout = smLruHead;
+        unlink( pLayout );
+        pLayout->mValid = false;
+
+        if ( pLayout->mRefCount == 0 )
+            delete pLayout;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void TextLayoutCache::dumpMetrics( void )
+{
+    U32 referencedCount = 0;
+    for ( Layout* pLayout = smLruHead; pLayout != NULL; pLayout = pLayout->mpLruNext )
+    {
+        if ( pLayout->mRefCount > 0 )
+            referencedCount++;
+    }
+
+    const U32 lookups = smHits + smMisses;
+
+    Con::printSeparator();
+    Con::printf( "Text layout cache metrics:" );
+    Con::printf( "Layouts=%d, Referenced=%d, Glyphs=%d<%d>, Buckets=%d", smLayoutCount, referencedCount, smGlyphCount, smMaxGlyphs, smBucketCount );
+    Con::printf( "Hits=%d, Misses=%d, HitRate=%.1f%%, Evictions=%d", smHits, smMisses, lookups == 0 ? 0.0f : (F32)smHits * 100.0f / (F32)lookups, smEvictions );
+    Con::printSeparator();
+}
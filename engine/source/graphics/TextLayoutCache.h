@@ -0,0 +1,185 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _TEXT_LAYOUT_CACHE_H_
+#define _TEXT_LAYOUT_CACHE_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _MPOINT_H_
+#include "math/mPoint.h"
+#endif
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+/// A cache of shaped text.
+///
+/// A layout is the list of glyph quads produced by laying out a string with a
+/// given font and a set of layout parameters (size, wrap width, alignment etc).
+/// Glyph quads are held in the local space of whoever produced them so they can
+/// be transformed and submitted each frame without touching the font again.
+///
+/// Layouts are shared and reference counted.  Unreferenced layouts are evicted
+/// least-recently-used first once the cache exceeds its glyph budget.  The cache
+/// is only used from the main thread.
+class TextLayoutCache
+{
+public:
+    enum Constants
+    {
+        MaxLayoutParams = 12,
+    };
+
+    /// A single glyph quad.
+    /// Texels are in the order (left,bottom), (right,bottom), (right,top), (left,top).
+    struct Glyph
+    {
+        F32         mLeft;
+        F32         mTop;
+        F32         mRight;
+        F32         mBottom;
+        Point2F     mTexels[4];
+        U32         mPage;
+        U32         mCharIndex;
+    };
+
+    /// Identifies a layout.  Nothing is copied until a layout is created.
+    struct Key
+    {
+        Key( const void* pFont, const UTF16* pText, const U32 textLength ) :
+            mpFont( pFont ),
+            mpText( pText ),
+            mTextLength( textLength ),
+            mParamCount( 0 )
+        {
+        }
+
+        inline void addParam( const F32 param )
+        {
+            AssertFatal( mParamCount < MaxLayoutParams, "TextLayoutCache::Key::addParam() - Too many layout parameters." );
+            mParams[mParamCount++] = param;
+        }
+
+        const void*     mpFont;
+        const UTF16*    mpText;
+        U32             mTextLength;
+        F32             mParams[MaxLayoutParams];
+        U32             mParamCount;
+    };
+
+    class Layout
+    {
+        friend class TextLayoutCache;
+
+    private:
+        const void*     mpFont;
+        UTF16*          mpText;
+        U32             mTextLength;
+        F32             mParams[MaxLayoutParams];
+        U32             mParamCount;
+        U32             mHash;
+
+        Vector<Glyph>   mGlyphs;
+        F32             mAdvance;
+        bool            mCacheable;
+
+        U32             mRefCount;
+        bool            mCommitted;
+        bool            mValid;
+
+        Layout*         mpHashNext;
+        Layout*         mpLruPrev;
+        Layout*         mpLruNext;
+
+        Layout();
+        ~Layout();
+
+        bool matches( const Key& key, const U32 hash ) const;
+
+    public:
+        inline Vector<Glyph>& getGlyphs( void )                         { return mGlyphs; }
+        inline const Vector<Glyph>& getGlyphs( void ) const             { return mGlyphs; }
+        inline U32 getGlyphCount( void ) const                          { return (U32)mGlyphs.size(); }
+
+        /// Total advance of the laid out text, if the producer records it.
+        inline void setAdvance( const F32 advance )                     { mAdvance = advance; }
+        inline F32 getAdvance( void ) const                             { return mAdvance; }
+
+        /// A producer may record that some text can't be represented by glyph quads
+        /// alone so that it is not shaped again only to find that out.
+        inline void setCacheable( const bool cacheable )                { mCacheable = cacheable; }
+        inline bool isCacheable( void ) const                           { return mCacheable; }
+
+        /// A layout becomes invalid when its font is purged.  Holders should re-acquire.
+        inline bool isValid( void ) const                               { return mValid; }
+    };
+
+private:
+    static Layout**         smBuckets;
+    static U32              smBucketCount;
+    static Layout*          smLruHead;
+    static Layout*          smLruTail;
+    static U32              smLayoutCount;
+    static U32              smGlyphCount;
+
+    static U32              smHits;
+    static U32              smMisses;
+    static U32              smEvictions;
+
+    static U32              hashKey( const Key& key );
+    static void             link( Layout* pLayout );
+    static void             unlink( Layout* pLayout );
+    static void             touch( Layout* pLayout );
+    static void             rehash( const U32 bucketCount );
+    static void             evict( void );
+
+public:
+    /// Budget in glyphs.  Referenced layouts are never evicted so the budget can be exceeded.
+    static S32              smMaxGlyphs;
+
+    static void             create( void );
+    static void             destroy( void );
+
+    /// Find a layout.  Returns NULL on a miss otherwise a reference that must be released.
+    static Layout*          acquire( const Key& key );
+
+    /// Create an empty layout for the key.  The caller fills in the glyphs then commits it.
+    /// The returned layout is referenced and must be released.
+    static Layout*          createLayout( const Key& key );
+    static void             commit( Layout* pLayout );
+
+    static void             release( Layout* pLayout );
+
+    /// Invalidate all layouts produced with the specified font.
+    static void             purgeFont( const void* pFont );
+    static void             flush( void );
+
+    static void             dumpMetrics( void );
+};
+
+#endif // _TEXT_LAYOUT_CACHE_H_
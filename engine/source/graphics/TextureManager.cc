@@ -28,6 +28,7 @@
 #include "collection/vector.h"
 #include "io/resource/resourceManager.h"
 #include "graphics/gBitmap.h"
+#include "graphics/dgl.h"
 #include "console/console.h"
 #include "console/consoleInternal.h"
 #include "console/consoleTypes.h"
@@ -216,6 +217,7 @@ void TextureManager::killManager()
     }
 
     // Delete all textures.
+    dglFlushBatch();
     glDeleteTextures(deleteNames.size(), deleteNames.address());
 }
 
@@ -354,6 +356,7 @@ void TextureManager::freeTexture( TextureObject* pTextureObject )
 {
     if((mDGLRender || mManagerState == Resurrecting) && pTextureObject->mGLTextureName)
     {
+        dglFlushBatch();
         glDeleteTextures(1, (const GLuint*)&pTextureObject->mGLTextureName);
 
         // Adjust metrics.
@@ -773,6 +776,9 @@ void TextureManager::createGLName( TextureObject* pTextureObject )
 
 TextureObject* TextureManager::registerTexture(const char* pTextureKey, GBitmap* pNewBitmap, TextureHandle::TextureHandleType type, bool clampToEdge)
 {
+    // Memory Accounting.
+    Memory::TagScope memoryTag( Memory::TagTextures );
+
     // Sanity!
     AssertISV( type != TextureHandle::InvalidTexture, "Invalid texture type." );
 
@@ -802,6 +808,7 @@ TextureObject* TextureManager::registerTexture(const char* pTextureKey, GBitmap*
         // Remove any texture name.
         if ( pTextureObject->mGLTextureName != 0 )
         {
+            dglFlushBatch();
             glDeleteTextures(1, (const GLuint*)&pTextureObject->mGLTextureName);
             pTextureObject->mGLTextureName = 0;
 
@@ -857,6 +864,9 @@ TextureObject* TextureManager::registerTexture(const char* pTextureKey, GBitmap*
 
 TextureObject *TextureManager::loadTexture(const char* pTextureKey, TextureHandle::TextureHandleType type, bool clampToEdge, bool checkOnly, bool force16Bit )
 {
+    // Memory Accounting.
+    Memory::TagScope memoryTag( Memory::TagTextures );
+
     // Sanity!
     AssertISV( type != TextureHandle::InvalidTexture, "Invalid texture type." );
 
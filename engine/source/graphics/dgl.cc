@@ -27,6 +27,7 @@
 #include "math/mPoint.h"
 #include "math/mRect.h"
 #include "graphics/gFont.h"
+#include "graphics/TextLayoutCache.h"
 #include "console/console.h"
 #include "math/mMatrix.h"
 #include "memory/frameAllocator.h"
@@ -45,8 +46,217 @@ ColorI sg_textAnchorColor(255, 255, 255, 255);
 ColorI sg_stackColor(255, 255, 255, 255);
 RectI sgCurrentClipRect;
 
+struct TextVertex
+{
+   Point2F p;
+   Point2F t;
+   ColorI c;
+    TextVertex() { set( 0.0f, 0.0f, 0.0f, 0.0f, ColorI(0, 0, 0) ); }
+   void set(F32 x, F32 y, F32 tx, F32 ty, ColorI color)
+   {
+      p.x = x;
+      p.y = y;
+      t.x = tx;
+      t.y = ty;
+      c = color;
+   }
+};
+
+struct BatchMetrics
+{
+   U32 drawCalls;
+   U32 vertices;
+   U32 stateChanges;
+   U32 primitives;
+
+   BatchMetrics() { reset(); }
+   void reset() { drawCalls = vertices = stateChanges = primitives = 0; }
+};
+
+// Draw batch state.
+const U32 sg_batchMaxVertices = 32768;
+S32 sg_batchDepth = 0;
+S32 sg_batchSuspendDepth = 0;
+bool sg_batchEnabled = true;
+Vector<TextVertex> sg_batchVertices;
+GLenum sg_batchPrimitive = GL_TRIANGLES;
+GLuint sg_batchTexture = 0;
+F32 sg_batchLineWidth = 1.0f;
+F32 sg_lineWidth = 1.0f;
+BatchMetrics sg_batchMetrics;
+BatchMetrics sg_batchLastMetrics;
+
 } // namespace {}
 
+//--------------------------------------------------------------------------
+
+void dglBeginBatch()
+{
+   if(sg_batchDepth++ == 0)
+      sg_batchMetrics.reset();
+}
+
+void dglEndBatch()
+{
+   AssertFatal(sg_batchDepth > 0, "dglEndBatch() - Unbalanced batch.");
+
+   dglFlushBatch();
+
+   if(--sg_batchDepth == 0)
+      sg_batchLastMetrics = sg_batchMetrics;
+}
+
+bool dglIsBatching()
+{
+   return sg_batchEnabled && sg_batchDepth > 0 && sg_batchSuspendDepth == 0;
+}
+
+void dglSuspendBatch()
+{
+   dglFlushBatch();
+   sg_batchSuspendDepth++;
+}
+
+void dglResumeBatch()
+{
+   AssertFatal(sg_batchSuspendDepth > 0, "dglResumeBatch() - Unbalanced suspend.");
+   sg_batchSuspendDepth--;
+}
+
+void dglSetBatchEnabled(const bool enabled)
+{
+   dglFlushBatch();
+   sg_batchEnabled = enabled;
+}
+
+void dglGetBatchMetrics(U32* drawCalls, U32* vertices, U32* stateChanges, U32* primitives)
+{
+   if(drawCalls)
+      *drawCalls = sg_batchLastMetrics.drawCalls;
+   if(vertices)
+      *vertices = sg_batchLastMetrics.vertices;
+   if(stateChanges)
+      *stateChanges = sg_batchLastMetrics.stateChanges;
+   if(primitives)
+      *primitives = sg_batchLastMetrics.primitives;
+}
+
+void dglFlushBatch()
+{
+   if(sg_batchVertices.size() == 0)
+      return;
+
+   // Debug Profiling.
+   PROFILE_SCOPE(dglFlushBatch);
+
+   const TextVertex* pVertices = sg_batchVertices.address();
+   const bool textured = sg_batchTexture != 0;
+
+   glDisable(GL_LIGHTING);
+   glEnable(GL_BLEND);
+   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+   if(textured)
+   {
+      glEnable(GL_TEXTURE_2D);
+      glBindTexture(GL_TEXTURE_2D, sg_batchTexture);
+      glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+   }
+   else
+   {
+      glDisable(GL_TEXTURE_2D);
+   }
+
+   if(sg_batchPrimitive == GL_LINES)
+      glLineWidth(sg_batchLineWidth);
+
+   // Some callers expect the vertex array to stay enabled.
+   const bool vertexArrayEnabled = glIsEnabled(GL_VERTEX_ARRAY) == GL_TRUE;
+
+   glEnableClientState ( GL_VERTEX_ARRAY );
+   glVertexPointer     ( 2, GL_FLOAT, sizeof(TextVertex), &(pVertices[0].p) );
+
+   glEnableClientState ( GL_COLOR_ARRAY );
+   glColorPointer      ( 4, GL_UNSIGNED_BYTE, sizeof(TextVertex), &(pVertices[0].c) );
+
+   if(textured)
+   {
+      glEnableClientState ( GL_TEXTURE_COORD_ARRAY );
+      glTexCoordPointer   ( 2, GL_FLOAT, sizeof(TextVertex), &(pVertices[0].t) );
+   }
+
+   glDrawArrays( sg_batchPrimitive, 0, sg_batchVertices.size() );
+
+   glDisableClientState ( GL_COLOR_ARRAY );
+   if(textured)
+      glDisableClientState ( GL_TEXTURE_COORD_ARRAY );
+   if(!vertexArrayEnabled)
+      glDisableClientState ( GL_VERTEX_ARRAY );
+
+   // Leave the current color as immediate drawing would have.
+   const ColorI& lastColor = sg_batchVertices.last().c;
+   glColor4ub(lastColor.red, lastColor.green, lastColor.blue, lastColor.alpha);
+
+   glDisable(GL_BLEND);
+   glDisable(GL_TEXTURE_2D);
+
+   sg_batchMetrics.drawCalls++;
+   sg_batchMetrics.vertices += sg_batchVertices.size();
+
+   sg_batchVertices.clear();
+}
+
+/// Reserve vertices in the batch, drawing what is already there first if the state differs.
+static TextVertex* dglBatchReserve(const GLenum primitive, const GLuint texture, const U32 vertexCount)
+{
+   if(sg_batchVertices.size() != 0)
+   {
+      if(primitive != sg_batchPrimitive ||
+         texture != sg_batchTexture ||
+         (primitive == GL_LINES && sg_lineWidth != sg_batchLineWidth))
+      {
+         sg_batchMetrics.stateChanges++;
+         dglFlushBatch();
+      }
+      else if(sg_batchVertices.size() + vertexCount > sg_batchMaxVertices)
+      {
+         dglFlushBatch();
+      }
+   }
+
+   sg_batchPrimitive = primitive;
+   sg_batchTexture = texture;
+   sg_batchLineWidth = sg_lineWidth;
+   sg_batchMetrics.primitives++;
+
+   const U32 start = sg_batchVertices.size();
+   sg_batchVertices.setSize(start + vertexCount);
+   return sg_batchVertices.address() + start;
+}
+
+/// Batch quads given as fans of four vertices.
+static void dglBatchQuads(const GLuint texture, const TextVertex* pQuads, const U32 quadCount)
+{
+   TextVertex* pVertex = dglBatchReserve(GL_TRIANGLES, texture, quadCount * 6);
+   for(U32 i = 0; i < quadCount; i++, pQuads += 4)
+   {
+      *pVertex++ = pQuads[0];
+      *pVertex++ = pQuads[1];
+      *pVertex++ = pQuads[2];
+      *pVertex++ = pQuads[0];
+      *pVertex++ = pQuads[2];
+      *pVertex++ = pQuads[3];
+   }
+}
+
+/// Batch an untextured line segment.
+static void dglBatchLine(const F32 x1, const F32 y1, const F32 x2, const F32 y2, const ColorI& color)
+{
+   TextVertex* pVertex = dglBatchReserve(GL_LINES, 0, 2);
+   pVertex[0].set(x1, y1, 0.0f, 0.0f, color);
+   pVertex[1].set(x2, y2, 0.0f, 0.0f, color);
+}
+
 
 //--------------------------------------------------------------------------
 void dglSetBitmapModulation(const ColorF& in_rColor)
@@ -94,26 +304,34 @@ void dglDrawBitmapStretchSR(TextureObject* texture,
    AssertFatal(srcRect.isValidRect() == true,
                "GSurface::drawBitmapStretchSR: routines assume normal rects");
 
-   glDisable(GL_LIGHTING);
+   // Silhouettes need their own texture environment so are never batched.
+   const bool batched = dglIsBatching() && !bSilhouette;
 
-   glEnable(GL_TEXTURE_2D);
-   glBindTexture(GL_TEXTURE_2D, texture->getGLTextureName());
-   //glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-
-   if (bSilhouette)
+   if(!batched)
    {
-      glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_BLEND);
+      dglFlushBatch();
+
+      glDisable(GL_LIGHTING);
+
+      glEnable(GL_TEXTURE_2D);
+      glBindTexture(GL_TEXTURE_2D, texture->getGLTextureName());
+      //glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+      if (bSilhouette)
+      {
+         glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_BLEND);
    
-      ColorF kModulationColor;
-      dglGetBitmapModulation(&kModulationColor);
-      glTexEnvfv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, kModulationColor.address());
-   }
-   else
-   {
-      glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+         ColorF kModulationColor;
+         dglGetBitmapModulation(&kModulationColor);
+         glTexEnvfv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, kModulationColor.address());
+      }
+      else
+      {
+         glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+      }
+      glEnable(GL_BLEND);
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
    }
-   glEnable(GL_BLEND);
-   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
    F32 texLeft   = F32(srcRect.point.x)                    / F32(texture->getTextureWidth());
    F32 texRight  = F32(srcRect.point.x + srcRect.extent.x) / F32(texture->getTextureWidth());
@@ -172,6 +390,17 @@ void dglDrawBitmapStretchSR(TextureObject* texture,
       texBottom = temp;
    }
 
+   if(batched)
+   {
+      TextVertex quad[4];
+      quad[0].set(scrPoints[2].x, scrPoints[2].y, texLeft, texBottom, sg_bitmapModulation);
+      quad[1].set(scrPoints[3].x, scrPoints[3].y, texRight, texBottom, sg_bitmapModulation);
+      quad[2].set(scrPoints[1].x, scrPoints[1].y, texRight, texTop, sg_bitmapModulation);
+      quad[3].set(scrPoints[0].x, scrPoints[0].y, texLeft, texTop, sg_bitmapModulation);
+      dglBatchQuads(texture->getGLTextureName(), quad, 1);
+      return;
+   }
+
    glColor4ub(sg_bitmapModulation.red,
              sg_bitmapModulation.green,
              sg_bitmapModulation.blue,
@@ -310,22 +539,6 @@ U32 dglDrawText(GFont*   font,
    return dglDrawTextN(font, ptDraw, in_string, dStrlen((const UTF8 *) in_string), colorTable, maxColorIndex, rot);
 }
 
-struct TextVertex
-{
-   Point2F p;
-   Point2F t;
-   ColorI c;
-    TextVertex() { set( 0.0f, 0.0f, 0.0f, 0.0f, ColorI(0, 0, 0) ); }
-   void set(F32 x, F32 y, F32 tx, F32 ty, ColorI color)
-   {
-      p.x = x;
-      p.y = y;
-      t.x = tx;
-      t.y = ty;
-      c = color;
-   }
-};
-
 //------------------------------------------------------------------------------
 
 U32 dglDrawTextN(GFont*          font,
@@ -364,6 +577,7 @@ U32 dglDrawTextN(GFont*          font,
    if( n < 1 )
       return ptDraw.x;
 
+   dglFlushBatch();
 
    MatrixF rotMatrix( EulerF( 0.0, 0.0, mDegToRad( rot ) ) );
    Point3F offset( ptDraw.x, ptDraw.y, 0.0 );
@@ -566,6 +780,193 @@ U32 dglDrawTextN(GFont*          font,
 
 #else
 
+/// Draw text quads with a single texture, or add them to the batch.
+static void dglDrawTextQuads(TextureObject* pTexture, const TextVertex* pVertices, const S32 vertexCount)
+{
+   if(dglIsBatching())
+   {
+      dglBatchQuads(pTexture->getGLTextureName(), pVertices, vertexCount / 4);
+      return;
+   }
+
+   glBindTexture(GL_TEXTURE_2D, pTexture->getGLTextureName());
+   glDrawArrays( GL_QUADS, 0, vertexCount );
+}
+
+/// Fetch the shaped glyphs for a string, laying it out if it isn't cached.
+/// Color codes change the modulation part way through a string so those strings
+/// are recorded as not cacheable and drawn the long way.
+static TextLayoutCache::Layout* dglAcquireTextLayout(GFont* font, const UTF16* in_string, U32 n)
+{
+   // Drawing stops at the terminator.
+   U32 length = 0;
+   while(length < n && in_string[length])
+      length++;
+
+   TextLayoutCache::Key key(font, in_string, length);
+
+   TextLayoutCache::Layout* pLayout = TextLayoutCache::acquire(key);
+   if(pLayout != NULL)
+      return pLayout;
+
+   pLayout = TextLayoutCache::createLayout(key);
+   Vector<TextLayoutCache::Glyph>& glyphs = pLayout->getGlyphs();
+
+   S32 x = 0;
+   for(U32 i = 0; i < length; i++)
+   {
+      const UTF16 c = in_string[i];
+
+      // Color codes, reset, push and pop.
+      if ((c >=  1 && c <=  7) ||
+         (c >= 11 && c <= 12) ||
+         (c >= 14 && c <= 17))
+      {
+         glyphs.clear();
+         pLayout->setCacheable(false);
+         break;
+      }
+
+      // Tab character
+      if ( c == dT('\t') )
+      {
+         const PlatformFont::CharInfo &ci = font->getCharInfo( dT(' ') );
+         x += ci.xIncrement * GFont::TabWidthInSpaces;
+         continue;
+      }
+
+      if( !font->isValidChar( c ) )
+         continue;
+
+      const PlatformFont::CharInfo &ci = font->getCharInfo(c);
+
+      if(ci.bitmapIndex == -1)
+      {
+         x += ci.xOrigin + ci.xIncrement;
+         continue;
+      }
+
+      if(ci.width != 0 && ci.height != 0)
+      {
+         TextureObject *pTexture = font->getTextureHandle(ci.bitmapIndex);
+
+         const S32 y = font->getBaseline() - ci.yOrigin;
+         x += ci.xOrigin;
+
+         const F32 texLeft   = F32(ci.xOffset)             / F32(pTexture->getTextureWidth());
+         const F32 texRight  = F32(ci.xOffset + ci.width)  / F32(pTexture->getTextureWidth());
+         const F32 texTop    = F32(ci.yOffset)             / F32(pTexture->getTextureHeight());
+         const F32 texBottom = F32(ci.yOffset + ci.height) / F32(pTexture->getTextureHeight());
+
+         glyphs.increment();
+         TextLayoutCache::Glyph& glyph = glyphs.last();
+         glyph.mLeft   = (F32)x;
+         glyph.mRight  = (F32)(x + ci.width);
+         glyph.mTop    = (F32)y;
+         glyph.mBottom = (F32)(y + ci.height);
+         glyph.mTexels[0].set(texLeft, texBottom);
+         glyph.mTexels[1].set(texRight, texBottom);
+         glyph.mTexels[2].set(texRight, texTop);
+         glyph.mTexels[3].set(texLeft, texTop);
+         glyph.mPage = ci.bitmapIndex;
+         glyph.mCharIndex = i;
+
+         x += ci.xIncrement - ci.xOrigin;
+      }
+      else
+         x += ci.xIncrement;
+   }
+
+   pLayout->setAdvance((F32)x);
+   TextLayoutCache::commit(pLayout);
+
+   return pLayout;
+}
+
+/// Draw shaped glyphs with the current bitmap modulation.
+static U32 dglDrawTextLayout(GFont* font, const Point2I& ptDraw, const TextLayoutCache::Layout* pLayout, F32 rot)
+{
+   const Vector<TextLayoutCache::Glyph>& glyphs = pLayout->getGlyphs();
+
+   if(glyphs.size() == 0)
+      return (U32)pLayout->getAdvance();
+
+   const bool rotated = rot != 0.0f;
+   MatrixF rotMatrix( EulerF( 0.0, 0.0, mDegToRad( rot ) ) );
+   Point3F offset( (F32)ptDraw.x, (F32)ptDraw.y, 0.0f );
+   Point3F points[4];
+
+   const ColorI currentColor = sg_bitmapModulation;
+   S32 currentPt = 0;
+   TextureObject *lastTexture = NULL;
+
+   FrameTemp<TextVertex> vert(4*glyphs.size());
+
+   const bool batching = dglIsBatching();
+   if(!batching)
+   {
+      glDisable(GL_LIGHTING);
+
+      glEnable(GL_TEXTURE_2D);
+      glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+      glEnable(GL_BLEND);
+
+      glEnableClientState ( GL_VERTEX_ARRAY );
+      glVertexPointer     ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].p) );
+
+      glEnableClientState ( GL_COLOR_ARRAY );
+      glColorPointer      ( 4, GL_UNSIGNED_BYTE, sizeof(TextVertex), &(vert[0].c) );
+
+      glEnableClientState ( GL_TEXTURE_COORD_ARRAY );
+      glTexCoordPointer   ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].t) );
+   }
+
+   for(Vector<TextLayoutCache::Glyph>::const_iterator glyphItr = glyphs.begin(); glyphItr != glyphs.end(); ++glyphItr)
+   {
+      const TextLayoutCache::Glyph& glyph = *glyphItr;
+
+      TextureObject *newObj = font->getTextureHandle(glyph.mPage);
+      if(newObj != lastTexture)
+      {
+         if(currentPt)
+         {
+            dglDrawTextQuads(lastTexture, vert, currentPt);
+            currentPt = 0;
+         }
+         lastTexture = newObj;
+      }
+
+      points[0].set(glyph.mLeft, glyph.mBottom, 0.0f);
+      points[1].set(glyph.mRight, glyph.mBottom, 0.0f);
+      points[2].set(glyph.mRight, glyph.mTop, 0.0f);
+      points[3].set(glyph.mLeft, glyph.mTop, 0.0f);
+
+      for( int i=0; i<4; i++ )
+      {
+         if(rotated)
+            rotMatrix.mulP( points[i] );
+         points[i] += offset;
+
+         vert[currentPt++].set(points[i].x, points[i].y, glyph.mTexels[i].x, glyph.mTexels[i].y, currentColor);
+      }
+   }
+   if(currentPt)
+      dglDrawTextQuads(lastTexture, vert, currentPt);
+
+   if(!batching)
+   {
+      glDisableClientState ( GL_VERTEX_ARRAY );
+      glDisableClientState ( GL_COLOR_ARRAY );
+      glDisableClientState ( GL_TEXTURE_COORD_ARRAY );
+
+      glDisable(GL_BLEND);
+      glDisable(GL_TEXTURE_2D);
+   }
+
+   return (U32)pLayout->getAdvance();
+}
+
 U32 dglDrawTextN(GFont*          font,
                  const Point2I&  ptDraw,
                  const UTF16*    in_string,
@@ -579,6 +980,17 @@ U32 dglDrawTextN(GFont*          font,
       return ptDraw.x;
    PROFILE_START(DrawText);
 
+   // Draw from the text layout cache unless the string changes color part way through.
+   TextLayoutCache::Layout* pLayout = dglAcquireTextLayout(font, in_string, n);
+   if(pLayout->isCacheable())
+   {
+      const U32 width = dglDrawTextLayout(font, ptDraw, pLayout, rot);
+      TextLayoutCache::release(pLayout);
+      PROFILE_END();
+      return width;
+   }
+   TextLayoutCache::release(pLayout);
+
    MatrixF rotMatrix( EulerF( 0.0, 0.0, mDegToRad( rot ) ) );
    Point3F offset( (F32)ptDraw.x, (F32)ptDraw.y, 0.0f );
    Point3F points[4];
@@ -598,21 +1010,25 @@ U32 dglDrawTextN(GFont*          font,
 
    FrameTemp<TextVertex> vert(4*n);
 
-   glDisable(GL_LIGHTING);
+   const bool batching = dglIsBatching();
+   if(!batching)
+   {
+      glDisable(GL_LIGHTING);
 
-   glEnable(GL_TEXTURE_2D);
-   glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-   glEnable(GL_BLEND);
+      glEnable(GL_TEXTURE_2D);
+      glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+      glEnable(GL_BLEND);
 
-   glEnableClientState ( GL_VERTEX_ARRAY );
-   glVertexPointer     ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].p) );
+      glEnableClientState ( GL_VERTEX_ARRAY );
+      glVertexPointer     ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].p) );
 
-   glEnableClientState ( GL_COLOR_ARRAY );
-   glColorPointer      ( 4, GL_UNSIGNED_BYTE, sizeof(TextVertex), &(vert[0].c) );
+      glEnableClientState ( GL_COLOR_ARRAY );
+      glColorPointer      ( 4, GL_UNSIGNED_BYTE, sizeof(TextVertex), &(vert[0].c) );
 
-   glEnableClientState ( GL_TEXTURE_COORD_ARRAY );
-   glTexCoordPointer   ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].t) );
+      glEnableClientState ( GL_TEXTURE_COORD_ARRAY );
+      glTexCoordPointer   ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].t) );
+   }
 
    // first build the point, color, and coord arrays
    U32 i;
@@ -709,8 +1125,7 @@ U32 dglDrawTextN(GFont*          font,
       {
          if(currentPt)
          {
-            glBindTexture(GL_TEXTURE_2D, lastTexture->getGLTextureName());
-            glDrawArrays( GL_QUADS, 0, currentPt );
+            dglDrawTextQuads(lastTexture, vert, currentPt);
             currentPt = 0;
          }
          lastTexture = newObj;
@@ -751,17 +1166,17 @@ U32 dglDrawTextN(GFont*          font,
          pt.x += ci.xIncrement;
    }
    if(currentPt)
-   {
-      glBindTexture(GL_TEXTURE_2D, lastTexture->getGLTextureName());
-      glDrawArrays( GL_QUADS, 0, currentPt );
-   }
+      dglDrawTextQuads(lastTexture, vert, currentPt);
 
-   glDisableClientState ( GL_VERTEX_ARRAY );
-   glDisableClientState ( GL_COLOR_ARRAY );
-   glDisableClientState ( GL_TEXTURE_COORD_ARRAY );
+   if(!batching)
+   {
+      glDisableClientState ( GL_VERTEX_ARRAY );
+      glDisableClientState ( GL_COLOR_ARRAY );
+      glDisableClientState ( GL_TEXTURE_COORD_ARRAY );
 
-   glDisable(GL_BLEND);
-   glDisable(GL_TEXTURE_2D);
+      glDisable(GL_BLEND);
+      glDisable(GL_TEXTURE_2D);
+   }
 
    pt.x += ptDraw.x; // DAW: Account for the fact that we removed the drawing point from the text start at the beginning.
 
@@ -777,6 +1192,12 @@ U32 dglDrawTextN(GFont*          font,
 
 void dglDrawLine(S32 x1, S32 y1, S32 x2, S32 y2, const ColorI &color)
 {
+   if(dglIsBatching())
+   {
+      dglBatchLine((F32)x1 + 0.5f, (F32)y1 + 0.5f, (F32)x2 + 0.5f, (F32)y2 + 0.5f, color);
+      return;
+   }
+
    glEnable(GL_BLEND);
    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
    glDisable(GL_TEXTURE_2D);
@@ -809,6 +1230,15 @@ void dglDrawLine(const Point2I &startPt, const Point2I &endPt, const ColorI &col
 
 void dglDrawTriangleFill(const Point2I &pt1, const Point2I &pt2, const Point2I &pt3, const ColorI &color)
 {
+	if(dglIsBatching())
+	{
+		TextVertex* pVertex = dglBatchReserve(GL_TRIANGLES, 0, 3);
+		pVertex[0].set((F32)pt1.x, (F32)pt1.y, 0.0f, 0.0f, color);
+		pVertex[1].set((F32)pt2.x, (F32)pt2.y, 0.0f, 0.0f, color);
+		pVertex[2].set((F32)pt3.x, (F32)pt3.y, 0.0f, 0.0f, color);
+		return;
+	}
+
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	glDisable(GL_TEXTURE_2D);
@@ -836,6 +1266,29 @@ void dglDrawTriangleFill(const Point2I &pt1, const Point2I &pt2, const Point2I &
 
 void dglDrawRect(const Point2I &upperL, const Point2I &lowerR, const ColorI &color, const float &lineWidth)
 {
+   sg_lineWidth = lineWidth;
+
+   // The outline is always drawn as the same four segments, each starting where the last ended,
+   // so the corners rasterize identically whether or not it is batched.
+   const F32 left = (F32)upperL.x + 0.5f;
+   const F32 top = (F32)upperL.y + 0.5f;
+   const F32 right = (F32)lowerR.x + 0.5f;
+   const F32 bottom = (F32)lowerR.y + 0.5f;
+   const GLfloat verts[] = {
+      left, top,        right, top,
+      right, top,       right, bottom,
+      right, bottom,    left, bottom,
+      left, bottom,     left, top,
+   };
+
+   if(dglIsBatching())
+   {
+      TextVertex* pVertex = dglBatchReserve(GL_LINES, 0, 8);
+      for(U32 i = 0; i < 8; i++)
+         pVertex[i].set(verts[i * 2], verts[i * 2 + 1], 0.0f, 0.0f, color);
+      return;
+   }
+
    glEnable(GL_BLEND);
    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
    glDisable(GL_TEXTURE_2D);
@@ -844,21 +1297,12 @@ void dglDrawRect(const Point2I &upperL, const Point2I &lowerR, const ColorI &col
 
    glColor4ub(color.red, color.green, color.blue, color.alpha);
 #if defined(TORQUE_OS_IOS) || defined(TORQUE_OS_ANDROID) || defined(TORQUE_OS_EMSCRIPTEN)
-    GLfloat verts[] = {
-        (GLfloat)(upperL.x), (GLfloat)(upperL.y),
-        (GLfloat)(lowerR.x), (GLfloat)(upperL.y),
-        (GLfloat)(lowerR.x), (GLfloat)(lowerR.y),
-        (GLfloat)(upperL.x), (GLfloat)(lowerR.y),
-    };
-    
     glVertexPointer(2, GL_FLOAT, 0, verts );
-    glDrawArrays(GL_LINE_LOOP, 0, 4 );//draw last two
+    glDrawArrays(GL_LINES, 0, 8 );
 #else
-   glBegin(GL_LINE_LOOP);
-      glVertex2f((F32)upperL.x + 0.5f, (F32)upperL.y + 0.5f);
-      glVertex2f((F32)lowerR.x + 0.5f, (F32)upperL.y + 0.5f);
-      glVertex2f((F32)lowerR.x + 0.5f, (F32)lowerR.y + 0.5f);
-      glVertex2f((F32)upperL.x + 0.5f, (F32)lowerR.y + 0.5f);
+   glBegin(GL_LINES);
+   for(U32 i = 0; i < 8; i++)
+      glVertex2f(verts[i * 2], verts[i * 2 + 1]);
    glEnd();
 #endif
 }
@@ -877,6 +1321,17 @@ void dglDrawRect(const RectI &rect, const ColorI &color, const float &lineWidth)
 
 void dglDrawRectFill(const Point2I &upperL, const Point2I &lowerR, const ColorI &color)
 {
+   if(dglIsBatching())
+   {
+      TextVertex quad[4];
+      quad[0].set((F32)upperL.x, (F32)upperL.y, 0.0f, 0.0f, color);
+      quad[1].set((F32)lowerR.x, (F32)upperL.y, 0.0f, 0.0f, color);
+      quad[2].set((F32)lowerR.x, (F32)lowerR.y, 0.0f, 0.0f, color);
+      quad[3].set((F32)upperL.x, (F32)lowerR.y, 0.0f, 0.0f, color);
+      dglBatchQuads(0, quad, 1);
+      return;
+   }
+
    glEnable(GL_BLEND);
    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
    glDisable(GL_TEXTURE_2D);
@@ -907,6 +1362,17 @@ void dglDrawRectFill(const RectI &rect, const ColorI &color)
 //Start in the top left and move counter-clockwise around the quad.
 void dglDrawQuadFill(const Point2I &point1, const Point2I &point2, const Point2I &point3, const Point2I &point4, const ColorI &color)
 {
+	if(dglIsBatching())
+	{
+		TextVertex quad[4];
+		quad[0].set((F32)point1.x, (F32)point1.y, 0.0f, 0.0f, color);
+		quad[1].set((F32)point2.x, (F32)point2.y, 0.0f, 0.0f, color);
+		quad[2].set((F32)point3.x, (F32)point3.y, 0.0f, 0.0f, color);
+		quad[3].set((F32)point4.x, (F32)point4.y, 0.0f, 0.0f, color);
+		dglBatchQuads(0, quad, 1);
+		return;
+	}
+
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	glDisable(GL_TEXTURE_2D);
@@ -929,6 +1395,8 @@ void dglDrawQuadFill(const Point2I &point1, const Point2I &point2, const Point2I
 
 void dglDraw2DSquare( const Point2F &screenPoint, F32 width, F32 spinAngle )
 {
+   dglFlushBatch();
+
    width *= 0.5;
 
    MatrixF rotMatrix( EulerF( 0.0, 0.0, spinAngle ) );
@@ -989,6 +1457,8 @@ void dglDraw2DSquare( const Point2F &screenPoint, F32 width, F32 spinAngle )
 
 void dglDrawBillboard( const Point3F &position, F32 width, F32 spinAngle )
 {
+   dglFlushBatch();
+
    MatrixF modelview;
    dglGetModelview( &modelview );
    modelview.transpose();
@@ -1054,6 +1524,8 @@ void dglDrawBillboard( const Point3F &position, F32 width, F32 spinAngle )
 
 void dglWireCube(const Point3F & extent, const Point3F & center)
 {
+   dglFlushBatch();
+
    static Point3F cubePoints[8] =
    {
       Point3F(-1, -1, -1), Point3F(-1, -1,  1), Point3F(-1,  1, -1), Point3F(-1,  1,  1),
@@ -1111,6 +1583,8 @@ void dglWireCube(const Point3F & extent, const Point3F & center)
 
 void dglSolidCube(const Point3F & extent, const Point3F & center)
 {
+   dglFlushBatch();
+
    static Point3F cubePoints[8] =
    {
       Point3F(-1, -1, -1), Point3F(-1, -1,  1), Point3F(-1,  1, -1), Point3F(-1,  1,  1),
@@ -1178,6 +1652,29 @@ void dglDrawCircle(const Point2I &center, const F32 radius, const ColorI &color,
 	F32 x = adjustedRadius;//we start at angle = 0 
 	F32 y = 0;
 
+	sg_lineWidth = lineWidth;
+
+	if(dglIsBatching())
+	{
+		if (num_segments < 1)
+			return;
+
+		TextVertex* pVertex = dglBatchReserve(GL_LINES, 0, num_segments * 2);
+		for (int ii = 0; ii < num_segments; ii++)
+		{
+			pVertex[ii * 2].set(x + center.x, y + center.y, 0.0f, 0.0f, color);
+			if (ii > 0)
+				pVertex[ii * 2 - 1] = pVertex[ii * 2];
+
+			//apply the rotation matrix
+			t = x;
+			x = c * x - s * y;
+			y = s * t + c * y;
+		}
+		pVertex[num_segments * 2 - 1] = pVertex[0];
+		return;
+	}
+
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	glDisable(GL_TEXTURE_2D);
@@ -1217,6 +1714,30 @@ void dglDrawCircleFill(const Point2I &center, const F32 radius, const ColorI &co
 	F32 x = radius;//we start at angle = 0 
 	F32 y = 0;
 
+	if(dglIsBatching())
+	{
+		const F32 centerX = (F32)center.x;
+		const F32 centerY = (F32)center.y;
+		if (num_segments < 1)
+			return;
+
+		TextVertex* pVertex = dglBatchReserve(GL_TRIANGLES, 0, num_segments * 3);
+		for (int ii = 0; ii < num_segments; ii++)
+		{
+			pVertex[ii * 3].set(centerX, centerY, 0.0f, 0.0f, color);
+			pVertex[ii * 3 + 1].set(x + centerX, y + centerY, 0.0f, 0.0f, color);
+			if (ii > 0)
+				pVertex[ii * 3 - 1] = pVertex[ii * 3 + 1];
+
+			//apply the rotation matrix
+			t = x;
+			x = c * x - s * y;
+			y = s * t + c * y;
+		}
+		pVertex[num_segments * 3 - 1] = pVertex[1];
+		return;
+	}
+
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	glDisable(GL_TEXTURE_2D);
@@ -1247,6 +1768,10 @@ void dglDrawCircleFill(const Point2I &center, const F32 radius, const ColorI &co
 
 void dglSetClipRect(const RectI &clipRect)
 {
+   // Clipping is done with the projection and viewport so anything batched must be drawn first.
+   if(clipRect != sgCurrentClipRect)
+      dglFlushBatch();
+
    glMatrixMode(GL_PROJECTION);
    glLoadIdentity();
 
@@ -1434,6 +1959,8 @@ bool dglIsInCanonicalState()
 
 void dglSetCanonicalState()
 {
+   dglFlushBatch();
+
 #if defined(TORQUE_OS_IOS) || defined(TORQUE_OS_ANDROID) || defined(TORQUE_OS_EMSCRIPTEN)
 // PUAP -Mat removed unsupported textureARB and Fog stuff
    glDisable(GL_BLEND);
@@ -165,6 +165,38 @@ U32 dglDrawTextN(GFont *font, const Point2I &ptDraw, const UTF16 *in_string, U32
 /// Converts UTF8 text to UTF16, and calls the UTF16 version of dglDrawTextN
 U32 dglDrawTextN(GFont *font, const Point2I &ptDraw, const UTF8  *in_string, U32 n, const ColorI *colorTable = NULL, const U32 maxColorIndex = 9, F32 rot = 0.f);
 /// @}
+
+/// @defgroup dgl_batch Draw Batching
+/// @ingroup dgl
+/// While batching, 2d primitives, bitmaps and text are accumulated into a single vertex
+/// list which is only drawn when the texture, primitive type or line width changes or
+/// when the clip rect, viewport, matrices or textures are changed through dgl.  Paint
+/// order is always preserved.  Code that issues its own GL calls while batching is
+/// wrapped in dglSuspendBatch()/dglResumeBatch(); GUI controls do this by returning
+/// false from GuiControl::isBatchRendered().
+/// @{
+
+/// Starts batching.  Calls can be nested; the outermost call resets the draw metrics.
+void dglBeginBatch();
+/// Draws anything batched and, when ending the outermost call, stops batching.
+void dglEndBatch();
+/// Draws anything batched so far.
+void dglFlushBatch();
+/// Returns true if draws are currently being batched.
+bool dglIsBatching();
+/// Draws anything batched and draws immediately until the matching dglResumeBatch().  Calls can be nested.
+void dglSuspendBatch();
+/// Ends a dglSuspendBatch().
+void dglResumeBatch();
+/// Enables or disables batching.  When disabled every draw is issued immediately.
+void dglSetBatchEnabled(const bool enabled);
+/// Returns the metrics of the last completed outermost batch.
+/// @param drawCalls number of GL draw calls issued
+/// @param vertices number of vertices drawn
+/// @param stateChanges number of times the batch was drawn early because state changed
+/// @param primitives number of dgl primitives submitted
+void dglGetBatchMetrics(U32* drawCalls, U32* vertices, U32* stateChanges, U32* primitives);
+/// @}
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- //
 // Drawing primitives
 
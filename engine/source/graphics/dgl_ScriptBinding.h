@@ -215,3 +215,34 @@ ConsoleFunctionWithDocs(png2jpg, ConsoleInt, 2, 3, ( pngFilename, [quality ]? ))
 }
 
 /*! @} */ // end group ImageFileManipulation
+
+/*! @defgroup GuiDrawBatching GUI Draw Batching
+	@ingroup TorqueScriptFunctions
+	@{
+*/
+
+/*! Gets the GUI draw metrics for the last rendered frame.
+    @return A string of the form "drawCalls vertices stateChanges primitives".
+*/
+ConsoleFunctionWithDocs( getGuiDrawMetrics, ConsoleString, 1, 1, ())
+{
+    U32 drawCalls, vertices, stateChanges, primitives;
+    dglGetBatchMetrics( &drawCalls, &vertices, &stateChanges, &primitives );
+
+    char* pBuffer = Con::getReturnBuffer( 64 );
+    dSprintf( pBuffer, 64, "%d %d %d %d", drawCalls, vertices, stateChanges, primitives );
+    return pBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets whether GUI drawing is batched.
+    @param enabled Whether to batch GUI drawing or not.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs( setGuiDrawBatching, ConsoleVoid, 2, 2, (bool enabled))
+{
+    dglSetBatchEnabled( dAtob(argv[1]) );
+}
+
+/*! @} */ // end group GuiDrawBatching
@@ -32,6 +32,7 @@
 #include "string/stringUnit.h"
 #include "graphics/TextureManager.h"
 #include "graphics/gFont.h"
+#include "graphics/TextLayoutCache.h"
 #include "memory/safeDelete.h"
 #include "memory/frameAllocator.h"
 #include "string/unicode.h"
@@ -153,6 +154,8 @@ GFont::GFont()
    for (U32 i = 0; i < (sizeof(mRemapTable) / sizeof(S32)); i++)
       mRemapTable[i] = -1;
 
+   resetCharMetrics();
+
    mCurX = mCurY = mCurSheet = -1;
 
    mPlatformFont = NULL;
@@ -167,6 +170,8 @@ GFont::GFont()
 
 GFont::~GFont()
 {
+   // Drop any text laid out with this font.
+   TextLayoutCache::purgeFont(this);
 
    // Need to stop this for now!
    mNeedSave = false;
@@ -379,6 +384,29 @@ const PlatformFont::CharInfo &GFont::getCharInfo(const UTF16 in_charIndex)
       return mCharInfoList[mRemapTable[in_charIndex]];
 }
 
+void GFont::resetCharMetrics()
+{
+   dMemset(mCharMetrics, 0, sizeof(mCharMetrics));
+}
+
+void GFont::resolveCharMetrics(const UTF16 in_charIndex)
+{
+   CharMetrics& metrics = mCharMetrics[in_charIndex];
+   metrics.mResolved = true;
+   metrics.mValid = in_charIndex != 0 && isValidChar(in_charIndex);
+
+   if(!metrics.mValid)
+   {
+      metrics.mXIncrement = 0;
+      metrics.mWidth = 0;
+      return;
+   }
+
+   const PlatformFont::CharInfo& rChar = getCharInfo(in_charIndex);
+   metrics.mXIncrement = rChar.xIncrement;
+   metrics.mWidth = rChar.width;
+}
+
 const PlatformFont::CharInfo &GFont::getDefaultCharInfo()
 {
    static PlatformFont::CharInfo c;
@@ -427,6 +455,8 @@ U32 GFont::getStrNWidth(const UTF16 *str, U32 n)
    U32 totWidth = 0;
    UTF16 curChar;
    U32 charCount;
+   S32 xIncrement;
+   U32 width;
 
    for(charCount = 0; charCount < n; charCount++)
    {
@@ -434,15 +464,14 @@ U32 GFont::getStrNWidth(const UTF16 *str, U32 n)
       if(curChar == '\0')
          break;
 
-      if(isValidChar(curChar))
+      if(getCharMetrics(curChar, xIncrement, width))
       {
-         const PlatformFont::CharInfo& rChar = getCharInfo(curChar);
-         totWidth += rChar.xIncrement;
+         totWidth += xIncrement;
       }
       else if (curChar == dT('\t'))
       {
-         const PlatformFont::CharInfo& rChar = getCharInfo(dT(' '));
-         totWidth += rChar.xIncrement * TabWidthInSpaces;
+         getCharMetrics(dT(' '), xIncrement, width);
+         totWidth += xIncrement * TabWidthInSpaces;
       }
    }
 
@@ -466,6 +495,8 @@ U32 GFont::getStrNWidthPrecise(const UTF16 *str, U32 n)
    U32 totWidth = 0;
    UTF16 curChar;
    U32 charCount = 0;
+   S32 xIncrement;
+   U32 width;
 
    for(charCount = 0; charCount < n; charCount++)
    {
@@ -473,25 +504,23 @@ U32 GFont::getStrNWidthPrecise(const UTF16 *str, U32 n)
       if(curChar == '\0')
          break;
 
-      if(isValidChar(curChar))
+      if(getCharMetrics(curChar, xIncrement, width))
       {
-         const PlatformFont::CharInfo& rChar = getCharInfo(curChar);
-         totWidth += rChar.xIncrement;
+         totWidth += xIncrement;
       }
       else if (curChar == dT('\t'))
       {
-         const PlatformFont::CharInfo& rChar = getCharInfo(dT(' '));
-         totWidth += rChar.xIncrement * TabWidthInSpaces;
+         getCharMetrics(dT(' '), xIncrement, width);
+         totWidth += xIncrement * TabWidthInSpaces;
       }
    }
 
    UTF16 endChar = str[getMin(charCount,n-1)];
 
-   if (isValidChar(endChar))
+   if (getCharMetrics(endChar, xIncrement, width))
    {
-      const PlatformFont::CharInfo& rChar = getCharInfo(endChar);
-      if ((S32)rChar.width > rChar.xIncrement)
-         totWidth += (rChar.width - rChar.xIncrement);
+      if ((S32)width > xIncrement)
+         totWidth += (width - xIncrement);
    }
 
    return(totWidth);
@@ -507,6 +536,8 @@ U32 GFont::getBreakPos(const UTF16 *str16, U32 slen, U32 width, bool breakOnWhit
    U32 lastws = 0;
    UTF16 c;
    U32 charCount = 0;
+   S32 charXIncrement;
+   U32 charWidth;
 
    for( charCount=0; charCount < slen; charCount++)
    {
@@ -516,21 +547,20 @@ U32 GFont::getBreakPos(const UTF16 *str16, U32 slen, U32 width, bool breakOnWhit
 
       if(c == dT('\t'))
          c = dT(' ');
-      if(!isValidChar(c))
+      if(!getCharMetrics(c, charXIncrement, charWidth))
       {
          ret++;
          continue;
       }
       if(c == dT(' '))
          lastws = ret+1;
-      const PlatformFont::CharInfo& rChar = getCharInfo(c);
-      if(rChar.width > width || rChar.xIncrement > (S32)width)
+      if(charWidth > width || charXIncrement > (S32)width)
       {
          if(lastws && breakOnWhitespace)
             return lastws;
          return ret;
       }
-      width -= rChar.xIncrement;
+      width -= charXIncrement;
 
       ret++;
    }
@@ -559,11 +589,13 @@ void GFont::wrapString(const UTF8 *txt, U32 lineWidth, Vector<U32> &startLineOff
       // loop until the string is too large
       bool needsNewLine = false;
       U32 lineStrWidth = 0;
+      S32 xIncrement;
+      U32 width;
       for (; i < len; i++)
       {
-         if(isValidChar(txt[i]))
+         if(getCharMetrics(txt[i], xIncrement, width))
          {
-            lineStrWidth += getCharInfo(txt[i]).xIncrement;
+            lineStrWidth += xIncrement;
             if ( txt[i] == '\n' || lineStrWidth > lineWidth )
             {
                needsNewLine = true;
@@ -888,6 +920,10 @@ void GFont::importStrip(const char *fileName, U32 padding, U32 kerning)
    mCurSheet = mCurX = mCurY = 0;
    mTextureSheets.clear();
 
+   // Glyph placement is about to change.
+   TextLayoutCache::purgeFont(this);
+   resetCharMetrics();
+
    //  Now, load the font strip.
    GBitmap *strip = GBitmap::load(fileName);
 
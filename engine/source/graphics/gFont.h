@@ -98,6 +98,21 @@ private:
                                           //    be accessed through the getCharInfo(U32)
                                           //    function to account for remapping...
    S32             mRemapTable[65536];    // - Index remapping
+
+   /// Metrics for the Latin-1 range, resolved on first use so that width
+   /// queries don't go back through the remap table and platform font for
+   /// every character of every string.
+   struct CharMetrics
+   {
+      S32   mXIncrement;
+      U32   mWidth;
+      bool  mValid;
+      bool  mResolved;
+   };
+   CharMetrics     mCharMetrics[256];
+
+   void resetCharMetrics();
+   void resolveCharMetrics(const UTF16 in_charIndex);
 public:
    GFont();
    virtual ~GFont();
@@ -127,6 +142,10 @@ public:
    
    bool isValidChar(const UTF16 in_charIndex) const;
 
+   /// Fetch the advance and width of a character.  Returns false for characters
+   /// the font can't render, in which case both are zero.
+   bool getCharMetrics(const UTF16 in_charIndex, S32& xIncrement, U32& width);
+
    const U32 getHeight() const   { return mHeight; }
    const U32 getBaseline() const { return mBaseline; }
    const U32 getAscent() const   { return mAscent; }
@@ -188,6 +207,7 @@ public:
    void forcePlatformFont(PlatformFont  *pf)
    {
       mPlatformFont = pf;
+      resetCharMetrics();
    }
 };
 
@@ -209,6 +229,32 @@ inline U32 GFont::getCharHeight(const UTF16 in_charIndex)
     return rChar.height;
 }
 
+inline bool GFont::getCharMetrics(const UTF16 in_charIndex, S32& xIncrement, U32& width)
+{
+   if(in_charIndex < 256)
+   {
+      const CharMetrics& metrics = mCharMetrics[in_charIndex];
+      if(!metrics.mResolved)
+         resolveCharMetrics(in_charIndex);
+
+      xIncrement = metrics.mXIncrement;
+      width = metrics.mWidth;
+      return metrics.mValid;
+   }
+
+   if(!isValidChar(in_charIndex))
+   {
+      xIncrement = 0;
+      width = 0;
+      return false;
+   }
+
+   const PlatformFont::CharInfo& rChar = getCharInfo(in_charIndex);
+   xIncrement = rChar.xIncrement;
+   width = rChar.width;
+   return true;
+}
+
 inline bool GFont::isValidChar(const UTF16 in_charIndex) const
 {
    if(mRemapTable[in_charIndex] != -1)
@@ -77,6 +77,7 @@ class GuiEditCtrl : public GuiControl
    void drawNuts(RectI &box, ColorI &outlineColor, ColorI &nutColor);
    void onPreRender();
    void onRender(Point2I offset, const RectI &updateRect);
+   bool isBatchRendered() { return false; }
    void addNewControl(GuiControl *ctrl);
    bool selectionContains(GuiControl *ctrl);
    void setCurrentAddSet(GuiControl *ctrl, bool clearSelection = true);
@@ -72,6 +72,7 @@ class GuiFilterCtrl : public GuiControl
 
    void onPreRender();
    void onRender(Point2I offset, const RectI &updateRect );
+   bool isBatchRendered() { return false; }
 };
 
 
@@ -70,6 +70,7 @@ public:
    bool onWake();
 
    void onRender(Point2I offset, const RectI &updateRect);
+   bool isBatchRendered() { return false; }
 
    // Graph interface
    void addDatum(S32 plotID, F32 v);
@@ -75,6 +75,7 @@ class GuiMenuTextListCtrl : public GuiTextListCtrl
       void onTouchDown(const GuiEvent &event);
       void onTouchUp(const GuiEvent &event);
       void onRenderCell(Point2I offset, Point2I cell, bool selected, bool mouseOver);
+      bool isBatchRendered() { return false; }
 
       virtual void onCellHighlighted(Point2I cell); // DAW: Added
 };
@@ -102,6 +102,13 @@ GuiCanvas::GuiCanvas()
     /// Background color.
     mBackgroundColor.set( 0.0f, 0.0f, 0.0f, 0.0f );
     mUseBackgroundColor = true;
+
+    /// Dirty regions.
+    mUseDirtyRegions = false;
+    mRepaintArea = 0;
+    mRepaintControlCount = 0;
+    mRepaintCacheCount = 0;
+    mInputRenderCacheDirty = false;
 }
 
 GuiCanvas::~GuiCanvas()
@@ -121,6 +128,7 @@ void GuiCanvas::initPersistFields()
     // Physics.
     addField("UseBackgroundColor", TypeBool, Offset(mUseBackgroundColor, GuiCanvas), "" );
     addField("BackgroundColor", TypeColorF, Offset(mBackgroundColor, GuiCanvas), "" );
+    addField("UseDirtyRegions", TypeBool, Offset(mUseDirtyRegions, GuiCanvas), "Whether only the dirty regions of the canvas are repainted or not." );
 }
 
 //------------------------------------------------------------------------------
@@ -222,6 +230,12 @@ bool GuiCanvas::tabPrev(void)
 
 void GuiCanvas::processScreenTouchEvent(const ScreenTouchEvent *event)
 {
+    // Input can change any control so repaint everything.
+    if ( mUseDirtyRegions )
+        resetUpdateRegions();
+
+    invalidateInputRenderCaches();
+
     //copy the cursor point into the event
     mLastEvent.mousePoint.x = S32(event->xPos);
     mLastEvent.mousePoint.y = S32(event->yPos);
@@ -255,6 +269,12 @@ void GuiCanvas::processMouseMoveEvent(const MouseMoveEvent *event)
 {
    if( cursorON )
    {
+        // Input can change any control so repaint everything.
+        if ( mUseDirtyRegions )
+            resetUpdateRegions();
+
+        invalidateInputRenderCaches();
+
         //copy the modifier into the new event
         mLastEvent.modifier = event->modifier;
 
@@ -319,6 +339,12 @@ void GuiCanvas::processMouseMoveEvent(const MouseMoveEvent *event)
 
 bool GuiCanvas::processInputEvent(const InputEvent *event)
 {
+    // Input can change any control so repaint everything.
+    if ( mUseDirtyRegions )
+        resetUpdateRegions();
+
+    invalidateInputRenderCaches();
+
     // First call the general input handler (on the extremely off-chance that it will be handled):
     if ( mFirstResponder )
    {
@@ -1228,9 +1254,25 @@ void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
    if(preRenderOnly)
       return;
 
-   // for now, just always reset the update regions - this is a
-   // fix for FSAA on ATI cards
-   resetUpdateRegions();
+   // Repaint everything unless using dirty regions.  Always repainting was originally a
+   // fix for FSAA on ATI cards.
+   if (!mUseDirtyRegions)
+      resetUpdateRegions();
+
+   // Reset the repaint metrics.
+   mRepaintArea = 0;
+   GuiControl::smRenderCount = 0;
+   GuiControl::smRenderCacheCount = 0;
+
+   // Refresh the render caches of the controls that have received input, then take the areas
+   // repainted since the last frame.  Anything repainted during this frame applies to the next.
+   if (mInputRenderCacheDirty)
+   {
+      invalidateInputRenderCaches();
+      mInputRenderCacheDirty = false;
+   }
+   mFrameRenderCacheRects = mRenderCacheRects;
+   mRenderCacheRects.clear();
 
 // Moved this below object integration for performance reasons. -JDD
 //   // finish the gl render so we don't get too far ahead of ourselves
@@ -1255,14 +1297,17 @@ void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
    if(!mouseCursor)
       mouseCursor = defaultCursor;
 
-   if(lastCursorON && lastCursor)
+   // Only repaint the cursor if it has changed when using dirty regions.
+   const bool cursorChanged = !mUseDirtyRegions || lastCursorON != cursorVisible || lastCursor != mouseCursor || lastCursorPt != cursorPos;
+
+   if(cursorChanged && lastCursorON && lastCursor)
    {
       Point2I spot = lastCursor->getHotSpot();
       Point2I cext = lastCursor->getExtent();
       Point2I pos = lastCursorPt - spot;
       addUpdateRegion(pos - Point2I(2, 2), Point2I(cext.x + 4, cext.y + 4));
    }
-   if(cursorVisible && mouseCursor)
+   if(cursorChanged && cursorVisible && mouseCursor)
    {
       Point2I spot = mouseCursor->getHotSpot();
       Point2I cext = mouseCursor->getExtent();
@@ -1275,17 +1320,38 @@ void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
     lastCursor = mouseCursor;
     lastCursorPt = cursorPos;
 
+   // Keep repainting until a pending tooltip is shown when using dirty regions.
+   if(mUseDirtyRegions && bool(mMouseControl) && !hoverPositionSet && mMouseControl->getTooltip() != StringTable->EmptyString)
+      resetUpdateRegions();
+
    RectI updateUnion;
    buildUpdateUnion(&updateUnion);
-   if (updateUnion.intersect(screenRect))
+   const bool repaint = updateUnion.intersect(screenRect);
+   if (repaint)
    {
+    mRepaintArea = (U32)(updateUnion.extent.x * updateUnion.extent.y);
+
     // Clear the background color if requested.
     if ( mUseBackgroundColor )
     {
+        // Only clear the update region.
+        const bool scissor = updateUnion != screenRect;
+        if ( scissor )
+        {
+            glEnable( GL_SCISSOR_TEST );
+            glScissor( updateUnion.point.x, size.y - (updateUnion.point.y + updateUnion.extent.y), updateUnion.extent.x, updateUnion.extent.y );
+        }
+
         glClearColor( mBackgroundColor.red, mBackgroundColor.green, mBackgroundColor.blue, mBackgroundColor.alpha );
         glClear(GL_COLOR_BUFFER_BIT);
+
+        if ( scissor )
+            glDisable( GL_SCISSOR_TEST );
     }
 
+      // Batch the dialogs and tooltip.
+      dglBeginBatch();
+
       //render the dialogs
       iterator i;
       for(i = begin(); i != end(); i++)
@@ -1293,7 +1359,7 @@ void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
          GuiControl *contentCtrl = static_cast<GuiControl*>(*i);
          dglSetClipRect(updateUnion);
          glDisable( GL_CULL_FACE );
-         contentCtrl->onRender(contentCtrl->getPosition(), updateUnion);
+         contentCtrl->renderControl(contentCtrl->getPosition(), updateUnion);
       }
 
       // Tooltip resource
@@ -1329,6 +1395,8 @@ void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
       }
       //end tooltip
 
+      dglEndBatch();
+
       dglSetClipRect(updateUnion);
 
       //temp draw the mouse
@@ -1370,8 +1438,12 @@ void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
 
    PROFILE_END();
 
+   // Update the repaint metrics.
+   mRepaintControlCount = GuiControl::smRenderCount;
+   mRepaintCacheCount = GuiControl::smRenderCacheCount;
 
-   if( bufferSwap )
+   // Nothing to swap if nothing was repainted.
+   if( bufferSwap && repaint )
       swapBuffers();
 
 //#if defined(TORQUE_OS_WIN32)
@@ -1393,26 +1465,21 @@ void GuiCanvas::swapBuffers()
 
 void GuiCanvas::buildUpdateUnion(RectI *updateUnion)
 {
-   *updateUnion = mOldUpdateRects[0];
-
    //the update region should encompass the oldUpdateRects, and the curUpdateRect
-   Point2I upperL;
-   Point2I lowerR;
-
-   upperL.x = getMin(mOldUpdateRects[0].point.x, mOldUpdateRects[1].point.x);
-   upperL.x = getMin(upperL.x, mCurUpdateRect.point.x);
-
-   upperL.y = getMin(mOldUpdateRects[0].point.y, mOldUpdateRects[1].point.y);
-   upperL.y = getMin(upperL.y, mCurUpdateRect.point.y);
-
-   lowerR.x = getMax(mOldUpdateRects[0].point.x + mOldUpdateRects[0].extent.x, mOldUpdateRects[1].point.x + mOldUpdateRects[1].extent.x);
-   lowerR.x = getMax(lowerR.x, mCurUpdateRect.point.x + mCurUpdateRect.extent.x);
-
-   lowerR.y = getMax(mOldUpdateRects[0].point.y + mOldUpdateRects[0].extent.y, mOldUpdateRects[1].point.y + mOldUpdateRects[1].extent.y);
-   lowerR.y = getMax(lowerR.y, mCurUpdateRect.point.y + mCurUpdateRect.extent.y);
+   //the old rects cover what the other buffers are missing when double or triple buffered
+   //empty rects are skipped so an idle canvas has nothing to update
+   const RectI *rects[3] = { &mOldUpdateRects[0], &mOldUpdateRects[1], &mCurUpdateRect };
+   updateUnion->set(0, 0, 0, 0);
+   for (U32 i = 0; i < 3; i++)
+   {
+      if (!rects[i]->isValidRect())
+         continue;
 
-   updateUnion->point = upperL;
-   updateUnion->extent = lowerR - upperL;
+      if (updateUnion->isValidRect())
+         updateUnion->unionRects(*rects[i]);
+      else
+         *updateUnion = *rects[i];
+   }
 
    //shift the oldUpdateRects
    mOldUpdateRects[0] = mOldUpdateRects[1];
@@ -1451,6 +1518,35 @@ void GuiCanvas::resetUpdateRegions()
 
 }
 
+void GuiCanvas::invalidateRenderCaches(const RectI &rect)
+{
+   if (rect.isValidRect())
+      mRenderCacheRects.push_back(rect);
+}
+
+bool GuiCanvas::isRenderCacheInvalid(const RectI &rect) const
+{
+   for (S32 i = 0; i < mFrameRenderCacheRects.size(); i++)
+   {
+      if (mFrameRenderCacheRects[i].overlaps(rect))
+         return true;
+   }
+   return false;
+}
+
+void GuiCanvas::invalidateInputRenderCaches()
+{
+   if (bool(mMouseCapturedControl))
+      mMouseCapturedControl->setRenderCacheDirty();
+   if (bool(mMouseControl))
+      mMouseControl->setRenderCacheDirty();
+   if (mFirstResponder)
+      mFirstResponder->setRenderCacheDirty();
+
+   // The controls may change while the input is handled so refresh the new ones on the next frame.
+   mInputRenderCacheDirty = true;
+}
+
 void GuiCanvas::setFirstResponder( GuiControl* newResponder )
 {
     GuiControl* oldResponder = mFirstResponder;
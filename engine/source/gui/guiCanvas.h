@@ -91,6 +91,13 @@ protected:
    RectI      mOldUpdateRects[2];
    RectI      mCurUpdateRect;
    F32        rLastFrameTime;
+   bool       mUseDirtyRegions;       ///< if false, the whole canvas is repainted every frame
+   U32        mRepaintArea;           ///< pixels repainted in the last frame
+   U32        mRepaintControlCount;   ///< controls rendered in the last frame
+   U32        mRepaintCacheCount;     ///< controls drawn from their render cache in the last frame
+   Vector<RectI> mRenderCacheRects;   ///< areas repainted by controls since the last frame
+   Vector<RectI> mFrameRenderCacheRects; ///< areas repainted by controls before the current frame
+   bool       mInputRenderCacheDirty; ///< if true, input has been processed since the last frame
    /// @}
 
    /// @name Cursor Properties
@@ -186,6 +193,16 @@ public:
     inline void             setUseBackgroundColor( const bool useBackgroundColor ) { mUseBackgroundColor = useBackgroundColor; }
     inline bool             getUseBackgroundColor( void ) const         { return mUseBackgroundColor; }
 
+    /// Dirty regions.
+    /// When enabled only the dirty regions are repainted and nothing is rendered or swapped while
+    /// the canvas is idle.  Any input repaints the whole canvas.  This relies on the back buffer being
+    /// preserved between frames so is not enabled by default.
+    inline void             setUseDirtyRegions( const bool useDirtyRegions ) { mUseDirtyRegions = useDirtyRegions; resetUpdateRegions(); }
+    inline bool             getUseDirtyRegions( void ) const            { return mUseDirtyRegions; }
+    inline U32              getRepaintArea( void ) const                { return mRepaintArea; }
+    inline U32              getRepaintControlCount( void ) const        { return mRepaintControlCount; }
+    inline U32              getRepaintCacheCount( void ) const          { return mRepaintCacheCount; }
+
    /// @name Rendering methods
    ///
    /// @{
@@ -207,12 +224,24 @@ public:
    /// repaint the whole canvas
    virtual void resetUpdateRegions();
 
+   /// Records an area repainted by a control.  Render caches overlapping it are refreshed on the next frame
+   /// as they may have captured what was drawn there.
+   /// @param   rect   Screen-coordinates of the repainted area
+   void invalidateRenderCaches(const RectI &rect);
+
+   /// Returns true if a control repainted any of the given area before the current frame.
+   bool isRenderCacheInvalid(const RectI &rect) const;
+
+   /// Marks the render caches of the controls receiving input as dirty, as their hover or pressed
+   /// state may change.
+   void invalidateInputRenderCaches();
+
    /// Resizes the content control to match the canvas size.
    void maintainSizing();
 
    /// This builds a rectangle which encompasses all of the dirty regions to be
    /// repainted
-   /// @param   updateUnion   (out) Rectangle which surrounds all dirty areas
+   /// @param   updateUnion   (out) Rectangle which surrounds all dirty areas or an empty rectangle if there are none
    virtual void buildUpdateUnion(RectI *updateUnion);
 
    /// This will swap the buffers at the end of renderFrame. It was added for canvas
@@ -386,6 +386,40 @@ ConsoleMethodWithDocs(GuiCanvas, getUseBackgroundColor, ConsoleBool, 2, 2, (...)
     return object->getUseBackgroundColor();
 }
 
+//-----------------------------------------------------------------------------
+
+/*! Sets whether only the dirty regions of the canvas are repainted or not.
+    When enabled nothing is repainted while the canvas is idle.  Animated controls must mark themselves for repainting.
+    @param useDirtyRegions Whether to only repaint the dirty regions or not.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(GuiCanvas, setUseDirtyRegions, ConsoleVoid, 3, 3, (bool useDirtyRegions))
+{
+    object->setUseDirtyRegions( dAtob(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets whether only the dirty regions of the canvas are repainted or not.
+    @return Whether only the dirty regions of the canvas are repainted or not.
+*/
+ConsoleMethodWithDocs(GuiCanvas, getUseDirtyRegions, ConsoleBool, 2, 2, ())
+{
+    return object->getUseDirtyRegions();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the repaint metrics for the last rendered frame.
+    @return A string of the form "repaintedArea controlCount cachedControlCount" where the area is in pixels.
+*/
+ConsoleMethodWithDocs(GuiCanvas, getRepaintMetrics, ConsoleString, 2, 2, ())
+{
+    char* pBuffer = Con::getReturnBuffer( 64 );
+    dSprintf( pBuffer, 64, "%d %d %d", object->getRepaintArea(), object->getRepaintControlCount(), object->getRepaintCacheCount() );
+    return pBuffer;
+}
+
 ConsoleMethodGroupEndWithDocs(GuiCanvas)
 
 /*! Use the createCanvas function to initialize the canvas.
@@ -110,6 +110,7 @@ class GuiColorPickerCtrl : public GuiControl
 
    static void initPersistFields();
    void onRender(Point2I offset, const RectI &updateRect);
+   bool isBatchRendered() { return false; }
    
    /// @name Color Value Functions
    /// @{
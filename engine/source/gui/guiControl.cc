@@ -27,6 +27,7 @@
 #include "platform/event.h"
 #include "graphics/gBitmap.h"
 #include "graphics/dgl.h"
+#include "graphics/TextureManager.h"
 #include "input/actionMap.h"
 #include "gui/guiCanvas.h"
 #include "gui/guiControl.h"
@@ -54,6 +55,9 @@ GuiEditCtrl *GuiControl::smEditorHandle = NULL;
 
 bool GuiControl::smDesignTime = false;
 
+U32 GuiControl::smRenderCount = 0;
+U32 GuiControl::smRenderCacheCount = 0;
+
 GuiControl::GuiControl()
 {
    mLayer = 0;
@@ -86,6 +90,8 @@ GuiControl::GuiControl()
    mTipHoverTime        = 1000;
    mTooltipWidth		= 250;
    mIsContainer         = false;
+   mCacheRender         = false;
+   mRenderCacheDirty    = true;
 }
 
 GuiControl::~GuiControl()
@@ -177,6 +183,7 @@ void GuiControl::initPersistFields()
    addField("AltCommand",        TypeString,		Offset(mAltConsoleCommand, GuiControl));
    addField("Accelerator",       TypeString,		Offset(mAcceleratorKey, GuiControl));
    addField("Active",			 TypeBool,			Offset(mActive, GuiControl));
+   addField("CacheRender",       TypeBool,			Offset(mCacheRender, GuiControl));
    endGroup("GuiControl");	
 
    addGroup("ToolTip");
@@ -263,6 +270,15 @@ void GuiControl::removeObject(SimObject *object)
     Parent::removeObject(object);
 }
 
+void GuiControl::removeObjects(const SimObjectList& objects)
+{
+   for (S32 i = 0; i < objects.size(); i++)
+   {
+      if (objects[i]->getGroup() == this)
+         removeObject(objects[i]);
+   }
+}
+
 GuiControl *GuiControl::getParent()
 {
     SimObject *obj = getGroup();
@@ -748,7 +764,7 @@ void GuiControl::renderChildControls(Point2I offset, RectI content, const RectI
 				RectI old = dglGetClipRect();
 				dglSetClipRect(clipRect);
 				glDisable(GL_CULL_FACE);
-				ctrl->onRender(childPosition, RectI(childPosition, ctrl->getExtent()));
+				ctrl->renderControl(childPosition, RectI(childPosition, ctrl->getExtent()));
 				dglSetClipRect(old);
 			 }
 		  }
@@ -764,11 +780,17 @@ void GuiControl::renderChildControls(Point2I offset, RectI content, const RectI
 
 void GuiControl::setUpdateRegion(Point2I pos, Point2I ext)
 {
+   // Invalidate our render cache and any containing it.
+   setRenderCacheDirty();
+
    Point2I upos = localToGlobalCoord(pos);
    GuiCanvas *root = getRoot();
    if (root)
    {
       root->addUpdateRegion(upos, ext);
+
+      // Caches elsewhere may have captured this area behind them.
+      root->invalidateRenderCaches(RectI(upos, ext));
    }
 }
 
@@ -777,6 +799,83 @@ void GuiControl::setUpdate()
    setUpdateRegion(Point2I(0,0), mBounds.extent);
 }
 
+void GuiControl::renderControl(Point2I offset, const RectI &updateRect)
+{
+   smRenderCount++;
+
+   // Controls that make their own GL calls are drawn with batching suspended.
+   const bool batchRendered = isBatchRendered();
+   if (!batchRendered)
+      dglSuspendBatch();
+
+   // Render normally if not caching.  The editor always needs the live controls.
+   if (!mCacheRender || smDesignTime)
+      onRender(offset, updateRect);
+   else
+      renderCachedControl(offset, updateRect);
+
+   if (!batchRendered)
+      dglResumeBatch();
+}
+
+void GuiControl::renderCachedControl(Point2I offset, const RectI &updateRect)
+{
+   const RectI controlRect(offset, mBounds.extent);
+   const bool cacheSized = (bool)mRenderCache && mRenderCache.getWidth() == (U32)mBounds.extent.x && mRenderCache.getHeight() == (U32)mBounds.extent.y;
+
+   // The cache holds whatever was drawn behind the control so it is stale if that was repainted.
+   GuiCanvas *root = getRoot();
+   if (root && root->isRenderCacheInvalid(controlRect))
+      mRenderCacheDirty = true;
+
+   // Draw the cache if it is still valid.
+   if (!mRenderCacheDirty && cacheSized)
+   {
+      smRenderCacheCount++;
+      dglClearBitmapModulation();
+      dglDrawBitmapStretchSR(mRenderCache, controlRect, RectI(Point2I(0, 0), mBounds.extent), GFlip_Y);
+      return;
+   }
+
+   onRender(offset, updateRect);
+
+   // Only capture the control if all of it was drawn.
+   if (!controlRect.isValidRect() || !dglGetClipRect().contains(controlRect))
+      return;
+
+   // Allocate the cache.
+   if (!cacheSized)
+   {
+      GBitmap *bitmap = new GBitmap(mBounds.extent.x, mBounds.extent.y, false, GBitmap::RGBA);
+      mRenderCache.set(TextureManager::getUniqueTextureKey(), bitmap, TextureHandle::BitmapKeepTexture);
+   }
+
+   // Copy the control from the frame buffer.  The frame buffer is bottom-up so the cache is drawn flipped.
+   dglFlushBatch();
+   glBindTexture(GL_TEXTURE_2D, mRenderCache.getGLName());
+   glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, offset.x, Platform::getWindowSize().y - (offset.y + mBounds.extent.y), mBounds.extent.x, mBounds.extent.y);
+   mRenderCacheDirty = false;
+}
+
+void GuiControl::setRenderCacheDirty()
+{
+   for (GuiControl *walk = this; walk; walk = walk->getParent())
+   {
+      if (walk->mCacheRender)
+         walk->mRenderCacheDirty = true;
+   }
+}
+
+void GuiControl::setCacheRender(const bool cacheRender)
+{
+   mCacheRender = cacheRender;
+   mRenderCacheDirty = true;
+
+   // Release the cache.
+   if (!mCacheRender)
+      mRenderCache = NULL;
+}
+
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- //
 
 void GuiControl::awaken()
@@ -944,6 +1043,10 @@ void GuiControl::onSleep()
    if( isMethod("onSleep") )
       Con::executef(this, 1, "onSleep");
 
+   // Release the render cache.
+   mRenderCache = NULL;
+   mRenderCacheDirty = true;
+
    // Set Flag
    mAwake = false;
 }
@@ -60,6 +60,10 @@
 #include "math/mFluid.h"
 #endif
 
+#ifndef _TEXTURE_HANDLE_H_
+#include "graphics/TextureHandle.h"
+#endif
+
 class GuiCanvas;
 class GuiEditCtrl;
 
@@ -153,6 +157,16 @@ public:
     static bool smDesignTime; ///< static GuiControl boolean that specifies if the GUI Editor is active
     /// @}
 
+    /// @name Render Cache
+    /// @{
+    bool            mCacheRender;       ///< if true, the control and its children are drawn from a texture until they are updated.
+    bool            mRenderCacheDirty;
+    TextureHandle   mRenderCache;
+
+    static U32      smRenderCount;      ///< number of controls rendered in the current frame.
+    static U32      smRenderCacheCount; ///< number of controls drawn from their render cache in the current frame.
+    /// @}
+
     /// @name Design Time Editor Access
     /// @{
     static GuiEditCtrl *smEditorHandle; ///< static GuiEditCtrl pointer that gives controls access to editor-NULL if editor is closed
@@ -354,6 +368,11 @@ public:
     /// @param   obj Object to remove from this control
     void removeObject(SimObject *obj);
 
+    /// Removes child objects from this control.
+    /// Each child is removed individually so it is put to sleep.
+    /// @param   objects Objects to remove from this control
+    void removeObjects(const SimObjectList& objects);
+
     GuiControl *getParent();  ///< Returns the control which owns this one.
     GuiCanvas *getRoot();     ///< Returns the root canvas of this control.
     /// @}
@@ -430,6 +449,7 @@ public:
     /// @param   cursorPos   position of cursor to display the tip near
     /// @param   tipText     optional alternate tip to be rendered
     virtual bool renderTooltip(Point2I cursorPos, const char* tipText = NULL );
+    inline StringTableEntry getTooltip() const { return mTooltip; }
 
     /// Called when this control should render its children
     /// @param   offset   The top left of the parent control
@@ -446,6 +466,33 @@ public:
     virtual void setUpdate();
     /// @}
 
+    /// @name Render Cache
+    /// A control that caches its rendering is drawn once then copied into a texture which is
+    /// drawn instead until the control or one of its children calls setUpdate().  The copy includes
+    /// whatever was drawn behind the control so it is also refreshed when any control repaints an
+    /// overlapping area, or when one of its children receives input.  Only use it for subtrees that
+    /// change through setUpdate().
+    /// @{
+
+    /// Renders the control, from its render cache if it has a valid one.
+    /// @param   offset   The location this control is to begin rendering
+    /// @param   updateRect   The screen area this control has drawing access to
+    void renderControl(Point2I offset, const RectI &updateRect);
+
+    /// Renders the control through its render cache, refreshing the cache if it is dirty.
+    void renderCachedControl(Point2I offset, const RectI &updateRect);
+
+    void setCacheRender(const bool cacheRender);
+    inline bool getCacheRender() const { return mCacheRender; }
+
+    /// Forces the render cache of this control and any containing it to be redrawn.
+    void setRenderCacheDirty();
+    /// @}
+
+    /// Returns false if the control makes its own GL calls while rendering.  Such controls, and
+    /// their children, are drawn with dgl batching suspended so paint order is preserved.
+    virtual bool isBatchRendered() { return true; }
+
     //child hierarchy calls
     void awaken();          ///< Called when this control and its children have been wired up.
     void sleep();           ///< Called when this control is no more.
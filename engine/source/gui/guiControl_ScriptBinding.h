@@ -336,4 +336,29 @@ ConsoleMethodWithDocs(GuiControl, getText, ConsoleString, 2, 2, ())
 	return object->getText();
 }
 
+/*! Sets whether the control and its children are drawn from a cached texture until they are updated.
+    @param cacheRender Whether to cache the rendering or not.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(GuiControl, setCacheRender, ConsoleVoid, 3, 3, (bool cacheRender))
+{
+   object->setCacheRender( dAtob(argv[2]) );
+}
+
+/*! Gets whether the control and its children are drawn from a cached texture until they are updated.
+    @return Whether the rendering is cached or not.
+*/
+ConsoleMethodWithDocs(GuiControl, getCacheRender, ConsoleBool, 2, 2, ())
+{
+   return object->getCacheRender();
+}
+
+/*! Marks the control to be repainted.  This also redraws the render cache of the control and any control containing it.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(GuiControl, setUpdate, ConsoleVoid, 2, 2, ())
+{
+   object->setUpdate();
+}
+
 ConsoleMethodGroupEndWithDocs(GuiControl)
@@ -134,6 +134,7 @@ public:
    void addEntry(const char *buf, S32 id, U32 scheme = 0);
    void addScheme(U32 id, ColorI fontColor, ColorI fontColorHL, ColorI fontColorSEL);
    void onRender(Point2I offset, const RectI &updateRect);
+   bool isBatchRendered() { return false; }
    void onAction();
    virtual void closePopUp();
    void clear();
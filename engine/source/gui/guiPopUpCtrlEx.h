@@ -155,6 +155,7 @@ class GuiPopUpMenuCtrlEx : public GuiControl
    void addEntry(const char *buf, S32 id, U32 scheme = 0);
    void addScheme(U32 id, ColorI fontColor, ColorI fontColorHL, ColorI fontColorSEL);
    void onRender(Point2I offset, const RectI &updateRect);
+   bool isBatchRendered() { return false; }
    void onAction();
    virtual void closePopUp();
    void clear();
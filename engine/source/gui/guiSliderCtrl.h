@@ -75,6 +75,7 @@ public:
    void setScriptValue(const char *val);
 
    void onRender(Point2I offset, const RectI &updateRect);
+   bool isBatchRendered() { return false; }
 };
 
 #endif
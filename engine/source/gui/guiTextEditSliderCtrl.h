@@ -76,6 +76,7 @@ public:
 
    void onPreRender();
    void onRender(Point2I offset, const RectI &updateRect);
+   bool isBatchRendered() { return false; }
 
 
 };
@@ -42,6 +42,8 @@ GuiTreeViewCtrl::Item::Item( GuiControlProfile *pProfile )
    mTabLevel            = 0;
    mIcon                = 0;
    mDataRenderWidth     = 0;
+   mIndexKey            = 0;
+   mVisibleRow          = -1;
    mScriptInfo.mText    = NULL;
    mScriptInfo.mValue   = NULL;
    mInspectorInfo.mObject = NULL;
@@ -472,6 +474,8 @@ GuiTreeViewCtrl::Item * GuiTreeViewCtrl::createItem(S32 icon)
    pNewItem->mState.clear();
    pNewItem->mState = 0;
    pNewItem->mTabLevel = 0;
+   pNewItem->mVisibleRow = -1;
+   pNewItem->mSyncedSet.clear();
 
    // Null out item pointers
    pNewItem->mNext = 0;
@@ -507,6 +511,8 @@ void GuiTreeViewCtrl::destroyItem(Item * item)
    if(!item)
       return;
 
+   unindexItem(item);
+
    if(item->isInspectorData())
    {
       // make sure the SimObjectPtr is clean!
@@ -582,6 +588,8 @@ void GuiTreeViewCtrl::destroyTree()
 
    mVisibleItems.clear();
    mSelectedItems.clear();
+   mObjectIndex.clear();
+   mNameIndex.clear();
 
    //
    mRoot          = NULL;
@@ -594,6 +602,11 @@ void GuiTreeViewCtrl::destroyTree()
 //------------------------------------------------------------------------------
 
 void GuiTreeViewCtrl::buildItem( Item* item, U32 tabLevel, bool bForceFullUpdate )
+{
+   buildItemRows( item, tabLevel, bForceFullUpdate, mVisibleItems );
+}
+
+void GuiTreeViewCtrl::buildItemRows( Item* item, U32 tabLevel, bool bForceFullUpdate, Vector<Item*>& rows )
 {
    if (!item || !mActive || !isVisible() || !mProfile  )
       return;
@@ -614,20 +627,12 @@ void GuiTreeViewCtrl::buildItem( Item* item, U32 tabLevel, bool bForceFullUpdate
    }
 
    item->mTabLevel = tabLevel;
-   mVisibleItems.push_back( item );
+   rows.push_back( item );
 
-   if ( mProfile != NULL && !mProfile->mFont.isNull() )
-   {
-      S32 width = ( tabLevel + 1 ) * mTabSize + item->getDisplayTextWidth(mProfile->mFont);
-      if ( mProfile->mBitmapArrayRects.size() > 0 )
-         width += mProfile->mBitmapArrayRects[0].extent.x;
-      
-      width += (item->mTabLevel+1) * mItemHeight; // using mItemHeight for icon width, close enough
-                                                  // this will only fail if somebody starts using super wide icons.
-
-      if ( width > mMaxWidth )
-         mMaxWidth = width;
-   }
+   // Use the cached text width, rendering keeps it up to date.
+   const S32 width = getRowWidth( item );
+   if ( width > mMaxWidth )
+      mMaxWidth = width;
 
    // if expanded, then add all the children items as well
   if ( item->isExpanded() || bForceFullUpdate)
@@ -640,7 +645,7 @@ void GuiTreeViewCtrl::buildItem( Item* item, U32 tabLevel, bool bForceFullUpdate
          Item *pChildTemp = child;
          child = child->mNext;
 
-         buildItem( pChildTemp, tabLevel + 1, bForceFullUpdate );
+         buildItemRows( pChildTemp, tabLevel + 1, bForceFullUpdate, rows );
       }
    }
 }
@@ -654,27 +659,297 @@ void GuiTreeViewCtrl::buildVisibleTree(bool bForceFullUpdate)
       return;
    mFlags.set( BuildingVisTree, true );
 
+   // Debug Profiling.
+   PROFILE_SCOPE(GuiTreeViewCtrl_BuildVisibleTree);
+
    mMaxWidth = 0;
+   for ( S32 i = 0; i < mVisibleItems.size(); i++ )
+      mVisibleItems[i]->mVisibleRow = -1;
    mVisibleItems.clear();
 
-   // Update the flags.
-   mFlags.clear(RebuildVisible);
-
    // build the root items
    Item *traverse = mRoot;
    while(traverse)
    {
+      // The item may be removed as it is built.
+      Item *next = traverse->mNext;
       buildItem(traverse, 0, bForceFullUpdate);
-      traverse = traverse->mNext;
+      traverse = next;
    }
 
+   renumberVisibleRows( 0 );
+
+   // Update the flags.
+   mFlags.clear(RebuildVisible);
+
    // adjust the GuiArrayCtrl
+   updateVisibleSize();
+
+   // Done Recursing.
+   mFlags.clear( BuildingVisTree );
+}
+
+//------------------------------------------------------------------------------
+
+void GuiTreeViewCtrl::updateVisibleTree()
+{
+   if ( mFlags.test( RebuildVisible ) )
+      buildVisibleTree();
+}
+
+void GuiTreeViewCtrl::updateVisibleSize()
+{
    mCellSize.set(mMaxWidth+1, mItemHeight);
    setSize(Point2I(1, mVisibleItems.size()));
    syncSelection();
+}
+
+S32 GuiTreeViewCtrl::findVisibleRow( const Item* item ) const
+{
+   AssertFatal( item->mVisibleRow == -1 || ( item->mVisibleRow < mVisibleItems.size() && mVisibleItems[item->mVisibleRow] == item ),
+      "GuiTreeViewCtrl::findVisibleRow() - Item row is out of date." );
+
+   return item->mVisibleRow;
+}
+
+S32 GuiTreeViewCtrl::getRowWidth( const Item* item ) const
+{
+   if ( mProfile == NULL || mProfile->mFont.isNull() )
+      return 0;
+
+   S32 width = ( item->mTabLevel + 1 ) * mTabSize + item->mDataRenderWidth;
+   if ( mProfile->mBitmapArrayRects.size() > 0 )
+      width += mProfile->mBitmapArrayRects[0].extent.x;
+
+   width += (item->mTabLevel+1) * mItemHeight; // using mItemHeight for icon width, close enough
+                                               // this will only fail if somebody starts using super wide icons.
+   return width;
+}
+
+void GuiTreeViewCtrl::expandVisibleItem( Item* item )
+{
+   // Only splice rows of an item that is currently shown.
+   if ( mFlags.test( RebuildVisible ) || mFlags.test( BuildingVisTree ) )
+      return;
+
+   const S32 row = findVisibleRow( item );
+   if ( row == -1 )
+   {
+      mFlags.set( RebuildVisible );
+      return;
+   }
+
+   // Debug Profiling.
+   PROFILE_SCOPE(GuiTreeViewCtrl_ExpandVisibleItem);
+
+   // Give a virtual parent the chance to populate its children.
+   if ( item->mState.test( Item::VirtualParent ) )
+   {
+      mFlags.set( BuildingVisTree, true );
+      const bool kept = onVirtualParentBuild( item );
+      mFlags.clear( BuildingVisTree );
+
+      if ( !kept )
+      {
+         mFlags.set( RebuildVisible );
+         return;
+      }
+   }
+
+   insertChildRows( item, row );
+   updateVisibleSize();
+}
+
+void GuiTreeViewCtrl::insertChildRows( Item* item, const S32 row )
+{
+   mFlags.set( BuildingVisTree, true );
+
+   Vector<Item*> rows;
+   Item * child = item->mChild;
+   while ( child )
+   {
+      Item *pChildTemp = child;
+      child = child->mNext;
+
+      buildItemRows( pChildTemp, item->mTabLevel + 1, false, rows );
+   }
 
-   // Done Recursing.
    mFlags.clear( BuildingVisTree );
+
+   if ( rows.size() == 0 )
+      return;
+
+   const S32 tail = mVisibleItems.size() - (row + 1);
+   mVisibleItems.setSize( mVisibleItems.size() + rows.size() );
+   if ( tail > 0 )
+      dMemmove( mVisibleItems.address() + row + 1 + rows.size(), mVisibleItems.address() + row + 1, tail * sizeof(Item*) );
+   dMemcpy( mVisibleItems.address() + row + 1, rows.address(), rows.size() * sizeof(Item*) );
+
+   renumberVisibleRows( row + 1 );
+}
+
+void GuiTreeViewCtrl::collapseVisibleItem( Item* item )
+{
+   if ( mFlags.test( RebuildVisible ) || mFlags.test( BuildingVisTree ) )
+      return;
+
+   const S32 row = findVisibleRow( item );
+   if ( row == -1 )
+      return;
+
+   eraseVisibleRows( row + 1, item->mTabLevel );
+   updateVisibleSize();
+}
+
+void GuiTreeViewCtrl::removeVisibleRows( Item* item )
+{
+   const S32 row = findVisibleRow( item );
+   if ( row == -1 )
+      return;
+
+   item->mVisibleRow = -1;
+   mVisibleItems.erase( row );
+   eraseVisibleRows( row, item->mTabLevel );
+}
+
+void GuiTreeViewCtrl::eraseVisibleRows( const S32 first, const S32 tabLevel )
+{
+   // The rows are everything from the first that is nested deeper than the tab level.
+   S32 end = first;
+   while ( end < mVisibleItems.size() && mVisibleItems[end]->mTabLevel > tabLevel )
+   {
+      mVisibleItems[end]->mVisibleRow = -1;
+      end++;
+   }
+
+   const S32 count = end - first;
+   if ( count > 0 )
+   {
+      const S32 tail = mVisibleItems.size() - end;
+      if ( tail > 0 )
+         dMemmove( mVisibleItems.address() + first, mVisibleItems.address() + end, tail * sizeof(Item*) );
+      mVisibleItems.setSize( mVisibleItems.size() - count );
+   }
+
+   renumberVisibleRows( first );
+}
+
+void GuiTreeViewCtrl::renumberVisibleRows( const S32 first )
+{
+   for ( S32 i = first; i < mVisibleItems.size(); i++ )
+      mVisibleItems[i]->mVisibleRow = i;
+}
+
+void GuiTreeViewCtrl::syncVisibleRows()
+{
+   if ( mFlags.test( RebuildVisible ) || mFlags.test( BuildingVisTree ) )
+      return;
+
+   // Debug Profiling.
+   PROFILE_SCOPE(GuiTreeViewCtrl_SyncVisibleRows);
+
+   bool changed = false;
+   S32 row = 0;
+   while ( row < mVisibleItems.size() )
+   {
+      Item* item = mVisibleItems[row];
+
+      // Drop the rows of an item whose object has been deleted.
+      if ( item->isInspectorData() && !item->getObject() )
+      {
+         removeItem( item->mId );
+         changed = true;
+         continue;
+      }
+
+      // Splice in the children of an expanded set that gained members.
+      if ( item->mState.test( Item::VirtualParent ) && item->isExpanded() )
+      {
+         const S32 itemCount = mItemCount;
+
+         mFlags.set( BuildingVisTree, true );
+         onVirtualParentBuild( item );
+         mFlags.clear( BuildingVisTree );
+
+         if ( mItemCount != itemCount )
+         {
+            eraseVisibleRows( row + 1, item->mTabLevel );
+            insertChildRows( item, row );
+            changed = true;
+         }
+      }
+
+      row++;
+   }
+
+   if ( changed )
+      updateVisibleSize();
+}
+
+//------------------------------------------------------------------------------
+
+void GuiTreeViewCtrl::indexItem( Item* item )
+{
+   if ( item->mState.test( Item::Indexed ) )
+      unindexItem( item );
+
+   if ( item->isInspectorData() )
+   {
+      SimObject* pObject = item->getObject();
+      if ( pObject == NULL )
+         return;
+
+      item->mIndexKey = pObject->getId();
+      mObjectIndex.insertEqual( item->mIndexKey, item );
+   }
+   else
+   {
+      const char* pText = item->getText();
+      if ( pText == NULL )
+         return;
+
+      item->mIndexKey = Hash::hash( pText );
+      mNameIndex.insertEqual( item->mIndexKey, item );
+   }
+
+   item->mState.set( Item::Indexed );
+}
+
+void GuiTreeViewCtrl::unindexItem( Item* item )
+{
+   if ( !item->mState.test( Item::Indexed ) )
+      return;
+
+   typeItemIndexHash& index = item->isInspectorData() ? mObjectIndex : mNameIndex;
+   for ( typeItemIndexHash::iterator itr = index.find( item->mIndexKey ); itr != index.end() && itr->key == item->mIndexKey; ++itr )
+   {
+      if ( itr->value == item )
+      {
+         index.erase( itr );
+         break;
+      }
+   }
+
+   item->mState.clear( Item::Indexed );
+}
+
+GuiTreeViewCtrl::Item* GuiTreeViewCtrl::findInspectorDescendant( Item* ancestor, SimObject* obj )
+{
+   const U32 key = obj->getId();
+   for ( typeItemIndexHash::iterator itr = mObjectIndex.find( key ); itr != mObjectIndex.end() && itr->key == key; ++itr )
+   {
+      Item* item = itr->value;
+      if ( item->getObject() != obj )
+         continue;
+
+      for ( Item* parent = item->mParent; parent != NULL; parent = parent->mParent )
+      {
+         if ( parent == ancestor )
+            return item;
+      }
+   }
+
+   return NULL;
 }
 
 //------------------------------------------------------------------------------
@@ -697,6 +972,9 @@ bool GuiTreeViewCtrl::scrollVisible( Item *item )
 
    while(parent)
    {
+      if ( !parent->isExpanded() )
+         mFlags.set( RebuildVisible );
+
       parent->setExpanded(true);
 
       if( !parent->isInspectorData() && parent->mState.test(Item::VirtualParent) )
@@ -714,17 +992,15 @@ bool GuiTreeViewCtrl::scrollVisible( Item *item )
       return false;
    }
 
-   // And now, build the visible tree so we know where we have to scroll.
-   buildVisibleTree();
+   // And now, bring the visible tree up to date so we know where we have to scroll.
+   updateVisibleTree();
 
    // All done, let's figure out where we have to scroll...
-   for(S32 i=0; i<mVisibleItems.size(); i++)
+   const S32 row = findVisibleRow( item );
+   if ( row != -1 )
    {
-      if(mVisibleItems[i] == item)
-      {
-         pScrollParent->scrollRectVisible(RectI(0, i * mItemHeight, mMaxWidth, mItemHeight));
-         return true;
-      }
+      pScrollParent->scrollRectVisible(RectI(0, row * mItemHeight, mMaxWidth, mItemHeight));
+      return true;
    }
 
    // If we got here, it's probably bad...
@@ -775,6 +1051,8 @@ S32 GuiTreeViewCtrl::insertItem(S32 parentId, const char * text, const char * va
    pNewItem->setNormalImage( (S8)normalImage );
    pNewItem->setExpandedImage( (S8)expandedImage );
 
+   indexItem( pNewItem );
+
    // root level?
    if(parentId == 0)
    {
@@ -816,10 +1094,7 @@ S32 GuiTreeViewCtrl::insertItem(S32 parentId, const char * text, const char * va
          mFlags.set(RebuildVisible);
    }
 
-   //
-   if(mFlags.test(RebuildVisible))
-      buildVisibleTree();
-
+   // The visible tree is rebuilt lazily so bulk inserts only pay for it once.
    return pNewItem->mId;
 }
 
@@ -841,6 +1116,11 @@ bool GuiTreeViewCtrl::removeItem(S32 itemId)
       return false;
    }
 
+   // Drop the item's rows from the rendered tree...
+   const bool building = mFlags.test( BuildingVisTree );
+   if ( !building )
+      removeVisibleRows( item );
+
    // root?
    if(item == mRoot)
       mRoot = item->mNext;
@@ -853,7 +1133,8 @@ bool GuiTreeViewCtrl::removeItem(S32 itemId)
    destroyItem(item);
 
    // Update the rendered tree...
-   buildVisibleTree();
+   if ( !building )
+      updateVisibleSize();
 
    return true;
 }
@@ -864,7 +1145,14 @@ void GuiTreeViewCtrl::removeAllChildren(S32 itemId)
    Item * item = getItem(itemId);
    if(item)
    {
+      const S32 row = findVisibleRow( item );
+      if ( row != -1 )
+         eraseVisibleRows( row + 1, item->mTabLevel );
+
       destroyChildren(item->mChild, item);
+
+      if ( row != -1 )
+         updateVisibleSize();
    }
 }
 //------------------------------------------------------------------------------
@@ -1188,14 +1476,19 @@ void GuiTreeViewCtrl::onPreRender()
 
    mTicksPassed++;
 
+   updateVisibleTree();
+
+   // Pick up objects that were added or deleted since the last check.
    if( mTicksPassed > mTreeRefreshInterval ) 
    {
-      // Update every render in case new objects are added
-      buildVisibleTree();
+      syncVisibleRows();
 
       mTicksPassed = 0;
    }
 
+   // Rendering widened a row.
+   if ( mCellSize.x != mMaxWidth + 1 )
+      updateVisibleSize();
 }
 
 //------------------------------------------------------------------------------
@@ -1208,6 +1501,8 @@ bool GuiTreeViewCtrl::hitTest(const Point2I & pnt, Item* & item, BitSet32 & flag
    flags.clear();
    item = 0;
 
+   updateVisibleTree();
+
    // get the hit cell
    Point2I cell((pos.x < 0 ? -1 : pos.x / mCellSize.x),
                 (pos.y < 0 ? -1 : pos.y / mCellSize.y));
@@ -1285,68 +1580,46 @@ void GuiTreeViewCtrl::setInstantGroup(SimObject * obj)
 
 void GuiTreeViewCtrl::syncSelection()
 {
-   // for each visible item check to see if it is on the mSelected list.
-   // if it is then make sure that it is on the mSelectedItems list as well.
-   for (S32 i = 0; i < mVisibleItems.size(); i++) 
+   // for each id on the mSelected list find the visible items it refers to.
+   // those items make sure that they are on the mSelectedItems list as well.
+   for (S32 j = 0; j < mSelected.size(); j++) 
    {
-      for (S32 j = 0; j < mSelected.size(); j++) 
-      {
-         if (mVisibleItems[i]->mId == mSelected[j]) 
-         {
-            // check to see if it is on the visible items list.
-            bool addToSelectedItems = true;
-            for (S32 k = 0; k < mSelectedItems.size(); k++) 
-            {
-               if (mSelected[j] == mSelectedItems[k]->mId) 
-               {
-                  // don't add it
-                  addToSelectedItems = false;
-               }
-            }
-            if (addToSelectedItems) 
-            {
-               mVisibleItems[i]->mState.set(Item::Selected, true);
-               mSelectedItems.push_front(mVisibleItems[i]);
-               break;
-            }
-         } 
-         else if (mVisibleItems[i]->isInspectorData()) 
-         {
-            if (mVisibleItems[i]->getObject() && mVisibleItems[i]->getObject()->getId() == mSelected[j]) 
-            {
-               // check to see if it is on the visible items list.
-               bool addToSelectedItems = true;
-               for (S32 k = 0; k < mSelectedItems.size(); k++) 
-               {
-                  if (mSelectedItems[k]->isInspectorData()) 
-                  {
-                     if (mSelected[j] == mSelectedItems[k]->getObject()->getId()) 
-                     {
-                        // don't add it
-                        addToSelectedItems = false;
-                     }
-                  } 
-                  else 
-                  {
-                     if (mSelected[j] == mSelectedItems[k]->mId) 
-                     {
-                        // don't add it
-                        addToSelectedItems = false;
-                     }
-                  }
-               }
-               if (addToSelectedItems) 
-               {
-                  mVisibleItems[i]->mState.set(Item::Selected, true);
-                  mSelectedItems.push_front(mVisibleItems[i]);
-                  break;
-               }
-            }
-         }
+      const S32 selectedId = mSelected[j];
+
+      syncSelectedItem( getItem( selectedId ), selectedId );
 
+      const U32 key = (U32)selectedId;
+      for ( typeItemIndexHash::iterator itr = mObjectIndex.find( key ); itr != mObjectIndex.end() && itr->key == key; ++itr )
+      {
+         Item* item = itr->value;
+         if ( item->getObject() && item->getObject()->getId() == selectedId )
+            syncSelectedItem( item, selectedId );
       }
+   }
+}
+
+void GuiTreeViewCtrl::syncSelectedItem( Item* item, const S32 selectedId )
+{
+   if ( item == NULL || item->mVisibleRow == -1 )
+      return;
 
+   // check to see if it is already on the selected items list.
+   for (S32 k = 0; k < mSelectedItems.size(); k++) 
+   {
+      Item* selectedItem = mSelectedItems[k];
+      if (selectedItem->isInspectorData()) 
+      {
+         if (selectedItem->getObject() && selectedId == selectedItem->getObject()->getId()) 
+            return;
+      } 
+      else if (selectedId == selectedItem->mId) 
+      {
+         return;
+      }
    }
+
+   item->mState.set(Item::Selected, true);
+   mSelectedItems.push_front(item);
 }
 
 void GuiTreeViewCtrl::removeSelection(S32 itemId)
@@ -1694,14 +1967,25 @@ bool GuiTreeViewCtrl::setItemExpanded(S32 itemId, bool expand)
    // expand parents
    if(expand)
    {
+      Item * pExpandItem = item;
+      bool parentsExpanded = true;
       while(item)
       {
+         if(item != pExpandItem && !item->isExpanded())
+            parentsExpanded = false;
+
          if(item->mState.test(Item::VirtualParent))
             onVirtualParentExpand(item);
 
          item->setExpanded(true);
          item = item->mParent;
       }
+
+      // Splice the rows in if the item is already on screen.
+      if(parentsExpanded)
+         expandVisibleItem(pExpandItem);
+      else
+         mFlags.set(RebuildVisible);
    }
    else
    {
@@ -1709,6 +1993,7 @@ bool GuiTreeViewCtrl::setItemExpanded(S32 itemId, bool expand)
          onVirtualParentCollapse(item);
 
       item->setExpanded(false);
+      collapseVisibleItem(item);
    }
    return(true);
 }
@@ -1776,16 +2061,25 @@ bool GuiTreeViewCtrl::editItem( S32 itemId, const char* newText, const char* new
       return false;
    }
 
+   unindexItem( item );
+
    delete [] item->getText();
    item->setText (new char[dStrlen( newText ) + 1]);
    dStrcpy( item->getText(), newText );
 
+   indexItem( item );
+
    delete [] item->getValue();
    item->setValue( new char[dStrlen( newValue ) + 1] );
    dStrcpy( item->getValue(), newValue );
 
    // Update the widths and such:
-   buildVisibleTree();
+   const S32 width = getRowWidth( item );
+   if ( width > mMaxWidth )
+   {
+      mMaxWidth = width;
+      updateVisibleSize();
+   }
    return true;
 }
 
@@ -1833,6 +2127,8 @@ bool GuiTreeViewCtrl::onKeyDown( const GuiEvent& event )
    if ( !mVisible || !mActive || !mAwake )
       return true;
 
+   updateVisibleTree();
+
    // All the keyboard functionality requires a selected item, so if none exists...
 
    // Deal with enter and delete
@@ -2871,6 +3167,12 @@ void GuiTreeViewCtrl::onTouchDown(const GuiEvent & event)
       item->setExpanded(!item->isExpanded());
       if( !item->isInspectorData() && item->mState.test(Item::VirtualParent) )
          onVirtualParentExpand(item);
+
+      if( item->isExpanded() )
+         expandVisibleItem(item);
+      else
+         collapseVisibleItem(item);
+
       scrollVisible(item);
    }
 }
@@ -3187,13 +3489,23 @@ void GuiTreeViewCtrl::onRenderCell(Point2I offset, Point2I cell, bool, bool )
 
    // Ok, now we're off to rendering the actual data for the treeview item.
 
-   U32 bufLen = item->mDataRenderWidth + 1;
+   U32 bufLen = item->getDisplayTextLength() + 1;
    char *displayText = (char *)txtBuff.alloc(bufLen);
    displayText[bufLen-1] = 0;
    item->getDisplayText(bufLen, displayText);
 
+   // Inspector text follows its object so keep the cached width current.
+   const S32 textWidth = mProfile->mFont->getStrWidth( displayText );
+   if ( textWidth != item->mDataRenderWidth )
+   {
+      item->mDataRenderWidth = textWidth;
+      const S32 rowWidth = getRowWidth( item );
+      if ( rowWidth > mMaxWidth )
+         mMaxWidth = rowWidth;
+   }
+
    // Draw the rollover/selected bitmap, if one was specified.
-   drawRect.extent.x = mProfile->mFont->getStrWidth( displayText ) + ( 2 * mTextOffset );
+   drawRect.extent.x = textWidth + ( 2 * mTextOffset );
    if ( item->mState.test( Item::Selected ) && mTexSelected )
       dglDrawBitmapStretch( mTexSelected, drawRect );
    else if ( item->mState.test( Item::MouseOverText ) && mTexRollover )
@@ -3298,6 +3610,7 @@ void GuiTreeViewCtrl::addInspectorDataItem(Item *parent, SimObject *obj)
 
    // Actually store the data!
    item->setObject(obj);
+   indexItem(item);
 
    // Now add us to the data structure...
    if(parent)
@@ -3325,11 +3638,9 @@ void GuiTreeViewCtrl::addInspectorDataItem(Item *parent, SimObject *obj)
       item->mParent = NULL;
    }
 
-   if(!parent || parent->isExpanded())
+   // Items added while building are picked up by the build itself.
+   if(!mFlags.test(BuildingVisTree) && (!parent || parent->isExpanded()))
       mFlags.set(RebuildVisible);
-
-   buildVisibleTree();
-
 }
 
 void GuiTreeViewCtrl::unlinkItem(Item * item)
@@ -3440,27 +3751,32 @@ bool GuiTreeViewCtrl::onVirtualParentBuild(Item *item, bool bForceFullUpdate)
 
    SimSet::iterator i;
 
-   // This is slow but probably ok.
+   // Nothing to do if the set's members haven't changed since we last synced.
+   Vector<SimObjectId>& syncedSet = item->mSyncedSet;
+   bool synced = !bForceFullUpdate && syncedSet.size() == srcObj->size();
+   for(S32 n = 0; synced && n < syncedSet.size(); n++)
+      synced = syncedSet[n] == srcObj->at(n)->getId();
+
+   if(synced)
+      return true;
+
    for(i = srcObj->begin(); i != srcObj->end(); i++)
    {
       SimObject *obj = *i;
 
       // If we can't find it, add it.
       // unless it has a parent that is a child that is a script
-      Item *res = item->findChildByValue(obj);
-
-      bool foundChild = true;
-
-      // search the children. if any of them are the parent of the object then don't add it.
-      foundChild = childSearch(item,obj,foundChild);
-
-      if(!res && foundChild)
+      if(findInspectorDescendant(item, obj) == NULL)
       {
          if (mDebug) Con::printf("adding something");
          addInspectorDataItem(item, obj);
       }
    }
 
+   syncedSet.setSize(srcObj->size());
+   for(S32 n = 0; n < syncedSet.size(); n++)
+      syncedSet[n] = srcObj->at(n)->getId();
+
    return true;
 }
 
@@ -3495,16 +3811,18 @@ void GuiTreeViewCtrl::inspectObject(SimObject *obj, bool okToEdit)
 
 S32 GuiTreeViewCtrl::findItemByName(const char *name)
 {
-   for (S32 i = 0; i < mItems.size(); i++) 
+   // The first match in id order wins.
+   S32 itemId = 0;
+
+   const U32 key = Hash::hash( name );
+   for ( typeItemIndexHash::iterator itr = mNameIndex.find( key ); itr != mNameIndex.end() && itr->key == key; ++itr )
    {
-      if (mItems[i] != NULL)
-      {
-         if (dStrcmp(mItems[i]->getText(),name) == 0) 
-            return mItems[i]->mId;
-      }
+      Item* item = itr->value;
+      if ( dStrcmp( item->getText(), name ) == 0 && ( itemId == 0 || item->mId < itemId ) )
+         itemId = item->mId;
    }
 
-   return 0;
+   return itemId;
 }
 
 StringTableEntry GuiTreeViewCtrl::getTextToRoot( S32 itemId, const char * delimiter )
@@ -3836,17 +4154,19 @@ ConsoleMethod(GuiTreeViewCtrl,getSelectedItemList,const char*, 2,2,"returns a sp
 //------------------------------------------------------------------------------
 S32 GuiTreeViewCtrl::findItemByObjectId(S32 iObjId)
 {  
-   for (S32 i = 0; i < mItems.size(); i++)
+   // The first match in id order wins.
+   S32 itemId = -1;
+
+   const U32 key = (U32)iObjId;
+   for ( typeItemIndexHash::iterator itr = mObjectIndex.find( key ); itr != mObjectIndex.end() && itr->key == key; ++itr )
    {
-      if (mItems[i] != NULL)
-      {
-         SimObject* pObj = mItems[i]->getObject();
-         if(pObj && pObj->getId() == iObjId)
-            return mItems[i]->mId;
-      }
+      Item* item = itr->value;
+      SimObject* pObj = item->getObject();
+      if ( pObj && pObj->getId() == iObjId && ( itemId == -1 || item->mId < itemId ) )
+         itemId = item->mId;
    }
 
-   return -1;
+   return itemId;
 }
 
 //------------------------------------------------------------------------------
@@ -3878,11 +4198,22 @@ bool GuiTreeViewCtrl::scrollVisibleByObjectId(S32 objID)
       S32 parentID = findItemByObjectId(obj->getGroup()->getId());
       AssertFatal(parentID != -1, "We were able to show the parent, but could not then find the parent. This should not happen.");
       Item *parentItem = getItem(parentID);
-      parentItem->setExpanded(true);
-      buildVisibleTree();
+      if(!parentItem->isExpanded())
+      {
+         parentItem->setExpanded(true);
+         expandVisibleItem(parentItem);
+         updateVisibleTree();
+         itemID = findItemByObjectId(objID);
+      }
+
+      // The parent was already showing but hasn't picked up the child yet.
+      if(itemID == -1)
+      {
+         buildVisibleTree();
+         itemID = findItemByObjectId(objID);
+      }
       
       // NOW we should be able to find the object. if not... something's wrong.
-      itemID = findItemByObjectId(objID);
       AssertWarn(itemID != -1,"GuiTreeViewCtrl::scrollVisibleByObjectId() found the parent, but can't find it's immediate child. This should not happen.");
       if(itemID == -1)
          return false;
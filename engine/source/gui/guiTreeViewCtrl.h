@@ -24,6 +24,7 @@
 #define _GUI_TREEVIEWCTRL_H
 
 #include "collection/bitSet.h"
+#include "collection/hashTable.h"
 #include "math/mRect.h"
 #include "gui/guiControl.h"
 #include "gui/guiArrayCtrl.h"
@@ -59,11 +60,12 @@ class GuiTreeViewCtrl : public GuiArrayCtrl
                                      ///  Items that might never be shown (for instance
                                      ///  if we're browsing the object hierarchy in
                                      ///  Torque, which might have thousands of objects).
+            Indexed        = BIT(7), ///< Set if we're in the object id or name index.
          };
 
          BitSet32                mState;
          SimObjectPtr<GuiControlProfile> mProfile;
-         S16                     mId;
+         S32                     mId;
          U16                     mTabLevel;
          Item *                  mParent;
          Item *                  mChild;
@@ -74,6 +76,9 @@ class GuiTreeViewCtrl : public GuiArrayCtrl
                                                    /// to render the item's data in the 
                                                    /// onRenderCell function to optimize
                                                    /// for speed.
+         U32                     mIndexKey;        ///< Object id or text hash we are indexed by.
+         S32                     mVisibleRow;      ///< Our row in the visible item list, -1 if we're not in it.
+         Vector<SimObjectId>     mSyncedSet;       ///< Members of our SimSet when our children were last synced.
 
 
          Item( GuiControlProfile *pProfile );
@@ -99,7 +104,7 @@ class GuiTreeViewCtrl : public GuiArrayCtrl
          const S8 getExpandedImage() const;
          char *getText();
          char *getValue();
-         inline const S16 getID() const { return mId; };
+         inline const S32 getID() const { return mId; };
          SimObject *getObject();
          const U32 getDisplayTextLength();
          const S32 getDisplayTextWidth(GFont *font);
@@ -244,6 +249,10 @@ public:
                                              ///  item ids and do some other clever
                                              ///  things.
       Item *                  mRoot;
+
+      typedef HashTable<U32, Item*> typeItemIndexHash;
+      typeItemIndexHash       mObjectIndex;  ///< Inspector items by object id.
+      typeItemIndexHash       mNameIndex;    ///< Script items by text hash.
       S32                     mInstantGroup;
       S32                     mMaxWidth;
       S32                     mSelectedItem;
@@ -295,6 +304,35 @@ protected:
       void deleteItem(Item *item);
 
       void buildItem(Item * item, U32 tabLevel, bool bForceFullUpdate = false);
+      void buildItemRows(Item * item, U32 tabLevel, bool bForceFullUpdate, Vector<Item*> & rows);
+
+      /// @name Visible Rows
+      /// Expanding or collapsing a visible item splices its rows in or out of the
+      /// visible list, and each item keeps its row so lookups don't search the list.
+      /// Every mTreeRefreshInterval the visible rows are checked for deleted objects
+      /// and changed SimSets and only those rows are updated.  Anything else that
+      /// changes the rows flags RebuildVisible and the list is rebuilt before it is
+      /// next used.
+      /// @{
+      S32 findVisibleRow(const Item * item) const;
+      S32 getRowWidth(const Item * item) const;
+      void expandVisibleItem(Item * item);
+      void collapseVisibleItem(Item * item);
+      void insertChildRows(Item * item, const S32 row);
+      void removeVisibleRows(Item * item);
+      void eraseVisibleRows(const S32 first, const S32 tabLevel);
+      void renumberVisibleRows(const S32 first);
+      void syncVisibleRows();
+      void updateVisibleTree();
+      void updateVisibleSize();
+      /// @}
+
+      /// @name Item Index
+      /// @{
+      void indexItem(Item * item);
+      void unindexItem(Item * item);
+      Item * findInspectorDescendant(Item * ancestor, SimObject * obj);
+      /// @}
 
       bool hitTest(const Point2I & pnt, Item* & item, BitSet32 & flags);
 
@@ -311,6 +349,7 @@ protected:
 
       /// Used for syncing the mSelected and mSelectedItems lists.
       void syncSelection();
+      void syncSelectedItem(Item * item, const S32 selectedId);
 
       void lockSelection(bool lock);
       void hideSelection(bool hide);
@@ -28,6 +28,11 @@
 #include "platform/platformAssert.h"
 #include "io/fileStream.h"
 #include "io/resource/resourceManager.h"
+#include "console/consoleInternal.h"
+#include "string/stringStack.h"
+
+// Debug Profiling.
+#include "debug/profiler.h"
 
 // Script bindings.
 #include "actionMap_ScriptBinding.h"
@@ -60,11 +65,20 @@ extern AsciiMapping gAsciiMap[];
 //
 Vector<ActionMap::BreakEntry> ActionMap::smBreakTable(__FILE__, __LINE__);
 
+U32 ActionMap::smEventCount = 0;
+U32 ActionMap::smLookupCount = 0;
+U32 ActionMap::smDispatchCount = 0;
+
+extern ExprEvalState gEvalState;
+extern StringStack STR;
+
 
 //------------------------------------------------------------------------------
-ActionMap::ActionMap()
+ActionMap::ActionMap() :
+   mIndexDirty(false)
 {
    VECTOR_SET_ASSOCIATION(mDeviceMaps);
+   VECTOR_SET_ASSOCIATION(mBoundNodes);
 }
 
 //------------------------------------------------------------------------------
@@ -85,6 +99,13 @@ ActionMap::DeviceMap::~DeviceMap()
    }
 }
 
+//------------------------------------------------------------------------------
+S32 ActionMap::DeviceMap::findNodeIndex(const U32 modifiers, const U32 action) const
+{
+   HashTable<U32, U32>::const_iterator itr = nodeIndex.find(getNodeKey(modifiers, action));
+   return itr == nodeIndex.end() ? -1 : (S32)itr->value;
+}
+
 //------------------------------------------------------------------------------
 bool ActionMap::onAdd()
 {
@@ -418,18 +439,11 @@ bool ActionMap::createEventDescriptor(const char* pEventString, EventDescriptor*
 ActionMap::Node* ActionMap::getNode(const U32 inDeviceType, const U32 inDeviceInst,
                    const U32 inModifiers,  const U32 inAction,SimObject* object /*= NULL*/)
 {
-   // DMMTODO - Slow INITIAL implementation.  Replace with a faster version...
-   //
-   DeviceMap* pDeviceMap = NULL;
-   U32 i;
-   for (i = 0; i < (U32)mDeviceMaps.size(); i++) 
-   {
-      if (mDeviceMaps[i]->deviceType == inDeviceType &&
-          mDeviceMaps[i]->deviceInst == inDeviceInst) {
-         pDeviceMap = mDeviceMaps[i];
-         break;
-      }
-   }
+   // The caller is about to change the node so the indices must be rebuilt.
+   updateIndices();
+   mIndexDirty = true;
+
+   DeviceMap* pDeviceMap = findDeviceMap(inDeviceType, inDeviceInst);
    if (pDeviceMap == NULL) 
    {
       mDeviceMaps.increment();
@@ -440,13 +454,18 @@ ActionMap::Node* ActionMap::getNode(const U32 inDeviceType, const U32 inDeviceIn
       pDeviceMap->deviceType = inDeviceType;
    }
 
-   for (i = 0; i < (U32)pDeviceMap->nodeMap.size(); i++) 
+   // Nodes sharing modifiers and an action only differ by object so start from the first of them.
+   S32 firstIndex = pDeviceMap->findNodeIndex(inModifiers, inAction);
+   if (firstIndex >= 0)
    {
-      if (pDeviceMap->nodeMap[i].modifiers == inModifiers &&
-          pDeviceMap->nodeMap[i].action    == inAction &&
-          ( (object != NULL) ? object == pDeviceMap->nodeMap[i].object : true )) // Check for an object match if the object exists 
+      for (U32 i = (U32)firstIndex; i < (U32)pDeviceMap->nodeMap.size(); i++) 
       {
-         return &pDeviceMap->nodeMap[i];
+         if (pDeviceMap->nodeMap[i].modifiers == inModifiers &&
+             pDeviceMap->nodeMap[i].action    == inAction &&
+             ( (object != NULL) ? object == pDeviceMap->nodeMap[i].object : true )) // Check for an object match if the object exists 
+         {
+            return &pDeviceMap->nodeMap[i];
+         }
       }
    }
 
@@ -466,6 +485,9 @@ ActionMap::Node* ActionMap::getNode(const U32 inDeviceType, const U32 inDeviceIn
    pRetNode->makeConsoleCommand = NULL;
    pRetNode->breakConsoleCommand = NULL;
 
+   pRetNode->pFunctionEntry = NULL;
+   pRetNode->functionSequence = Namespace::mCacheSequence - 1;
+
    //[neob, 5/7/2007 - #2975]
    pRetNode->object = 0;
 
@@ -475,21 +497,12 @@ ActionMap::Node* ActionMap::getNode(const U32 inDeviceType, const U32 inDeviceIn
 //------------------------------------------------------------------------------
 void ActionMap::removeNode(const U32 inDeviceType, const U32 inDeviceInst, const U32 inModifiers, const U32 inAction, SimObject* object /*= NULL*/)
 {
-   // DMMTODO - Slow INITIAL implementation.  Replace with a faster version...
-   //
-   DeviceMap* pDeviceMap = NULL;
-   U32 i;
-   for (i = 0; i < (U32)mDeviceMaps.size(); i++) {
-      if (mDeviceMaps[i]->deviceType == inDeviceType &&
-          mDeviceMaps[i]->deviceInst == inDeviceInst) {
-         pDeviceMap = mDeviceMaps[i];
-         break;
-      }
-   }
-
+   DeviceMap* pDeviceMap = findDeviceMap(inDeviceType, inDeviceInst);
    if (pDeviceMap == NULL)
       return;
 
+   mIndexDirty = true;
+
    U32 realMods = inModifiers;
    if (realMods & SI_SHIFT)
       realMods |= SI_SHIFT;
@@ -500,7 +513,7 @@ void ActionMap::removeNode(const U32 inDeviceType, const U32 inDeviceInst, const
    if (realMods & SI_MAC_OPT)
       realMods |= SI_MAC_OPT;
 
-   for (i = 0; i < (U32)pDeviceMap->nodeMap.size(); i++) {
+   for (U32 i = 0; i < (U32)pDeviceMap->nodeMap.size(); i++) {
       if (pDeviceMap->nodeMap[i].modifiers == realMods &&
           pDeviceMap->nodeMap[i].action    == inAction &&
           ( (object != NULL) ? object == pDeviceMap->nodeMap[i].object : true )) 
@@ -516,19 +529,11 @@ void ActionMap::removeNode(const U32 inDeviceType, const U32 inDeviceInst, const
 const ActionMap::Node* ActionMap::findNode(const U32 inDeviceType, const U32 inDeviceInst,
                     const U32 inModifiers,  const U32 inAction)
 {
-   // DMMTODO - Slow INITIAL implementation.  Replace with a faster version...
-   //
-   DeviceMap* pDeviceMap = NULL;
-   U32 i;
-   for (i = 0; i < (U32)mDeviceMaps.size(); i++)
-   {
-      if (mDeviceMaps[i]->deviceType == inDeviceType && mDeviceMaps[i]->deviceInst == inDeviceInst)
-      {
-         pDeviceMap = mDeviceMaps[i];
-         break;
-      }
-   }
+   smLookupCount++;
+
+   updateIndices();
 
+   const DeviceMap* pDeviceMap = findDeviceMap(inDeviceType, inDeviceInst);
    if (pDeviceMap == NULL)
       return NULL;
 
@@ -542,19 +547,114 @@ const ActionMap::Node* ActionMap::findNode(const U32 inDeviceType, const U32 inD
    if (realMods & SI_MAC_OPT)
       realMods |= SI_MAC_OPT;
 
-   for (i = 0; i < (U32)pDeviceMap->nodeMap.size(); i++)
+   // An exact match or an "anykey" bind can satisfy the event.  Whichever was bound
+   //  first wins, as it would when searching the nodes in order.
+   S32 index = pDeviceMap->findNodeIndex(realMods, inAction);
+   if (dIsDecentChar(inAction))
+   {
+      const S32 anyKeyIndex = pDeviceMap->findNodeIndex(realMods, KEY_ANYKEY);
+      if (anyKeyIndex >= 0 && (index < 0 || anyKeyIndex < index))
+         index = anyKeyIndex;
+   }
+
+   return index >= 0 ? &pDeviceMap->nodeMap[index] : NULL;
+}
+
+//------------------------------------------------------------------------------
+ActionMap::DeviceMap* ActionMap::findDeviceMap(const U32 inDeviceType, const U32 inDeviceInst) const
+{
+   // There are only ever a handful of devices.
+   for (U32 i = 0; i < (U32)mDeviceMaps.size(); i++)
    {
-       if (pDeviceMap->nodeMap[i].action == KEY_ANYKEY && pDeviceMap->nodeMap[i].modifiers == realMods && dIsDecentChar(inAction))
-           return &pDeviceMap->nodeMap[i];
-       else if (inModifiers == 0 && pDeviceMap->nodeMap[i].modifiers == 0 && pDeviceMap->nodeMap[i].action == inAction)
-           return &pDeviceMap->nodeMap[i];
-       else if (pDeviceMap->nodeMap[i].modifiers == realMods && pDeviceMap->nodeMap[i].action    == inAction)
-           return &pDeviceMap->nodeMap[i];
+      if (mDeviceMaps[i]->deviceType == inDeviceType && mDeviceMaps[i]->deviceInst == inDeviceInst)
+         return mDeviceMaps[i];
    }
 
    return NULL;
 }
 
+//------------------------------------------------------------------------------
+S32 QSORT_CALLBACK ActionMap::compareBoundNodes(const void* a, const void* b)
+{
+   const ActionMap::BoundNode* pNodeA = (const ActionMap::BoundNode*)a;
+   const ActionMap::BoundNode* pNodeB = (const ActionMap::BoundNode*)b;
+
+   if (pNodeA->consoleFunction != pNodeB->consoleFunction)
+      return pNodeA->consoleFunction < pNodeB->consoleFunction ? -1 : 1;
+   if (pNodeA->devMapIndex != pNodeB->devMapIndex)
+      return (S32)pNodeA->devMapIndex - (S32)pNodeB->devMapIndex;
+   return (S32)pNodeA->nodeIndex - (S32)pNodeB->nodeIndex;
+}
+
+void ActionMap::updateIndices()
+{
+   if (!mIndexDirty)
+      return;
+
+   mIndexDirty = false;
+   mBoundNodes.clear();
+   mBoundNodeIndex.clear();
+
+   for (U32 i = 0; i < (U32)mDeviceMaps.size(); i++)
+   {
+      DeviceMap* pDeviceMap = mDeviceMaps[i];
+      pDeviceMap->nodeIndex.clear();
+
+      for (U32 j = 0; j < (U32)pDeviceMap->nodeMap.size(); j++)
+      {
+         const Node& node = pDeviceMap->nodeMap[j];
+
+         // Keep the first node for each key.
+         const U32 key = DeviceMap::getNodeKey(node.modifiers, node.action);
+         if (pDeviceMap->nodeIndex.find(key) == pDeviceMap->nodeIndex.end())
+            pDeviceMap->nodeIndex.insertUnique(key, j);
+
+         if (!(node.flags & Node::BindCmd) && node.consoleFunction != NULL)
+         {
+            mBoundNodes.increment();
+            mBoundNodes.last().consoleFunction = node.consoleFunction;
+            mBoundNodes.last().devMapIndex = i;
+            mBoundNodes.last().nodeIndex = j;
+         }
+      }
+   }
+
+   if (mBoundNodes.size() == 0)
+      return;
+
+   dQsort(mBoundNodes.address(), mBoundNodes.size(), sizeof(BoundNode), compareBoundNodes);
+
+   for (U32 i = 0; i < (U32)mBoundNodes.size(); i++)
+   {
+      if (i == 0 || mBoundNodes[i].consoleFunction != mBoundNodes[i - 1].consoleFunction)
+         mBoundNodeIndex.insertUnique(mBoundNodes[i].consoleFunction, i);
+   }
+}
+
+//------------------------------------------------------------------------------
+void ActionMap::executeFunction(const Node* pNode, const S32 argc, const char** argv)
+{
+   smDispatchCount++;
+
+   // Resolve the function if the namespaces have changed.
+   if (pNode->functionSequence != Namespace::mCacheSequence)
+   {
+      pNode->pFunctionEntry = Namespace::global()->lookup(pNode->consoleFunction);
+      pNode->functionSequence = Namespace::mCacheSequence;
+   }
+
+   if (pNode->pFunctionEntry == NULL)
+   {
+      Con::warnf(ConsoleLogEntry::Script, "%s: Unknown command.", argv[0]);
+      return;
+   }
+
+   pNode->pFunctionEntry->execute(argc, argv, &gEvalState);
+
+   // Reset the function offset so the stack doesn't continue to grow unnecessarily.
+   STR.clearFunctionOffset();
+}
+
 //------------------------------------------------------------------------------
 bool ActionMap::findBoundNode( const char* function, U32 &devMapIndex, U32 &nodeIndex )
 {
@@ -565,24 +665,27 @@ bool ActionMap::findBoundNode( const char* function, U32 &devMapIndex, U32 &node
 
 bool ActionMap::nextBoundNode( const char* function, U32 &devMapIndex, U32 &nodeIndex )
 {
-   // Loop through all of the existing nodes to find the one mapped to the
-   // given function:
-   for ( U32 i = devMapIndex; i < (U32)mDeviceMaps.size(); i++ )
-   {
-      const DeviceMap* dvcMap = mDeviceMaps[i];
+   // A function that was never added to the string table can't be bound.
+   StringTableEntry functionName = StringTable->lookup( function );
+   if ( functionName == NULL )
+      return( false );
+
+   updateIndices();
+
+   HashTable<StringTableEntry, U32>::iterator itr = mBoundNodeIndex.find( functionName );
+   if ( itr == mBoundNodeIndex.end() )
+      return( false );
 
-      for ( U32 j = nodeIndex; j < (U32)dvcMap->nodeMap.size(); j++ )
+   // Bound nodes for the function are in device map then node order.
+   for ( U32 i = itr->value; i < (U32)mBoundNodes.size() && mBoundNodes[i].consoleFunction == functionName; i++ )
+   {
+      const BoundNode& boundNode = mBoundNodes[i];
+      if ( boundNode.devMapIndex > devMapIndex || ( boundNode.devMapIndex == devMapIndex && boundNode.nodeIndex >= nodeIndex ) )
       {
-         const Node* node = &dvcMap->nodeMap[j];
-         if ( !( node->flags & Node::BindCmd ) && ( dStricmp( function, node->consoleFunction ) == 0 ) )
-         {
-            devMapIndex = i;
-            nodeIndex = j;
-            return( true );
-         }
+         devMapIndex = boundNode.devMapIndex;
+         nodeIndex = boundNode.nodeIndex;
+         return( true );
       }
-
-      nodeIndex = 0;
    }
 
    return( false );
@@ -1184,6 +1287,7 @@ bool ActionMap::processBind(const U32 argc, const char** argv, SimObject* object
    pBindNode->scaleFactor     = scaleFactor;
    pBindNode->object          = object;
    pBindNode->consoleFunction = StringTable->insert(pFnName);
+   pBindNode->functionSequence = Namespace::mCacheSequence - 1;
 
    return true;
 }
@@ -1236,7 +1340,7 @@ bool ActionMap::processGesture(const InputEvent* pEvent)
             if (pNode->object)
                 Con::executef(pNode->object, 6, argv[0], argv[1], argv[2], argv[3], argv[4], argv[5]);
             else
-                Con::execute(6, argv);
+                executeFunction(pNode, 6, argv);
             break;
 
         case SI_SWIPE_GESTURE:
@@ -1257,7 +1361,7 @@ bool ActionMap::processGesture(const InputEvent* pEvent)
             if (pNode->object)
                 Con::executef(pNode->object, 5, argv[0], argv[1], argv[2], argv[3], argv[4]);
             else
-                Con::execute(5, argv);
+                executeFunction(pNode, 5, argv);
             break;
 
         case SI_KEYTAP_GESTURE:
@@ -1279,7 +1383,7 @@ bool ActionMap::processGesture(const InputEvent* pEvent)
             if (pNode->object)
                 Con::executef(pNode->object, 4, argv[0], argv[1], argv[2], argv[3]);
             else
-                Con::execute(5, argv);
+                executeFunction(pNode, 5, argv);
 
             break;
 
@@ -1322,7 +1426,7 @@ bool ActionMap::processTouch(const InputEvent* pEvent)
     if (pNode->object)
         Con::executef(pNode->object, 4, argv[0], argv[1], argv[2], argv[3]);
     else
-        Con::execute(4, argv);
+        executeFunction(pNode, 4, argv);
        
     return true;
 }
@@ -1396,7 +1500,7 @@ bool ActionMap::processButton(const InputEvent* pEvent)
         if (pNode->object)
             Con::executef(pNode->object, 2, argv[0], argv[1]);
         else
-            Con::execute(2, argv);
+            executeFunction(pNode, 2, argv);
     }
 
     // [neo, 5/13/2007 - #3109]
@@ -1471,7 +1575,7 @@ bool ActionMap::processMove(const InputEvent* pEvent)
         if (pNode->object)
             Con::executef(pNode->object, 2, argv[0], argv[1]);
         else
-            Con::execute(2, argv);
+            executeFunction(pNode, 2, argv);
 
             return true;
     } 
@@ -1516,7 +1620,7 @@ bool ActionMap::processMove(const InputEvent* pEvent)
         }
         else
         {
-            Con::execute(argc, argv);
+            executeFunction(pNode, argc, argv);
         }
 
         return true;
@@ -1569,7 +1673,7 @@ bool ActionMap::processMove(const InputEvent* pEvent)
         if (pNode->object)
             Con::executef(pNode->object, 2, argv[0], argv[1]);
         else
-            Con::execute(2, argv);
+            executeFunction(pNode, 2, argv);
 
         return true;
     }
@@ -1621,7 +1725,7 @@ bool ActionMap::processMove(const InputEvent* pEvent)
         if (pNode->object)
             Con::executef(pNode->object, 2, argv[0], argv[1]);
         else
-            Con::execute(2, argv);
+            executeFunction(pNode, 2, argv);
 
         return true;
     }
@@ -1678,7 +1782,7 @@ bool ActionMap::processMotion(const InputEvent* pEvent)
     if (pNode->object)
         Con::executef(pNode->object, 2, argv[0], argv[1]);
     else
-        Con::execute(2, argv);
+        executeFunction(pNode, 2, argv);
        
     return true;
 }
@@ -1721,7 +1825,7 @@ bool ActionMap::processXInput(const InputEvent* pEvent)
         }
         else
         {
-            Con::execute(argc, argv);
+            executeFunction(pNode, argc, argv);
         }
     }
     
@@ -1874,6 +1978,11 @@ bool ActionMap::checkBreakTable(const InputEvent* pEvent)
 //------------------------------------------------------------------------------
 bool ActionMap::handleEvent(const InputEvent* pEvent)
 {
+   // Debug Profiling.
+   PROFILE_SCOPE(ActionMap_HandleEvent);
+
+   smEventCount++;
+
    // Interate through the ActionMapSet until we get a map that
    //  handles the event or we run out of maps...
    //
@@ -1904,6 +2013,24 @@ bool ActionMap::handleEventGlobal(const InputEvent* pEvent)
    return ((ActionMap*)pActionMapSet->first())->processAction(pEvent);
 }
 
+//------------------------------------------------------------------------------
+void ActionMap::resetMetrics()
+{
+   smEventCount = 0;
+   smLookupCount = 0;
+   smDispatchCount = 0;
+}
+
+//------------------------------------------------------------------------------
+void ActionMap::dumpMetrics()
+{
+   Con::printf("ActionMap Metrics:");
+   Con::printf("  Events: %d", smEventCount);
+   Con::printf("  Node Lookups: %d (%.2f per event)", smLookupCount, smEventCount > 0 ? (F32)smLookupCount / (F32)smEventCount : 0.0f);
+   Con::printf("  Dispatches: %d", smDispatchCount);
+   Con::printf("  Event latency is reported by the profiler as 'ActionMap_HandleEvent'.");
+}
+
 //------------------------------------------------------------------------------
 //-------------------------------------- Key code to string mapping
 //                                        TODO: Add most obvious aliases...
@@ -33,6 +33,12 @@
 #ifndef _SIMBASE_H_
 #include "sim/simBase.h"
 #endif
+#ifndef _HASHTABLE_H
+#include "collection/hashTable.h"
+#endif
+#ifndef _CONSOLEINTERNAL_H_
+#include "console/consoleInternal.h"
+#endif
 
 struct InputEvent;
 
@@ -76,6 +82,10 @@ class ActionMap : public SimObject
 
       char *makeConsoleCommand;         ///< Console command to execute when we make this command.
       char *breakConsoleCommand;        ///< Console command to execute when we break this command.
+
+      /// Console function resolved for dispatch, valid while the sequence matches Namespace::mCacheSequence.
+      mutable Namespace::Entry* pFunctionEntry;
+      mutable U32 functionSequence;
    };
 
    /// Used to represent a devices.
@@ -85,10 +95,25 @@ class ActionMap : public SimObject
       U32 deviceInst;
 
       Vector<Node> nodeMap;
+
+      /// Index of the first node for each (modifiers, action) pair.
+      HashTable<U32, U32> nodeIndex;
+
       DeviceMap() {
          VECTOR_SET_ASSOCIATION(nodeMap);
       }
       ~DeviceMap();
+
+      static inline U32 getNodeKey(const U32 modifiers, const U32 action) { return (modifiers << 16) | (action & 0xFFFF); }
+      S32 findNodeIndex(const U32 modifiers, const U32 action) const;
+   };
+
+   /// A console function bound to a node.  Bound nodes are grouped by function.
+   struct BoundNode
+   {
+      StringTableEntry consoleFunction;
+      U32 devMapIndex;
+      U32 nodeIndex;
    };
    struct BreakEntry
    {
@@ -118,6 +143,20 @@ class ActionMap : public SimObject
    Vector<DeviceMap*>        mDeviceMaps;
    static Vector<BreakEntry> smBreakTable;
 
+   /// Reverse index of bound functions, rebuilt along with the node indices when dirty.
+   Vector<BoundNode>                     mBoundNodes;
+   HashTable<StringTableEntry, U32>      mBoundNodeIndex;
+   bool                                  mIndexDirty;
+
+   static U32 smEventCount;
+   static U32 smLookupCount;
+   static U32 smDispatchCount;
+
+   DeviceMap* findDeviceMap(const U32 inDeviceType, const U32 inDeviceInst) const;
+   void updateIndices();
+   static S32 QSORT_CALLBACK compareBoundNodes(const void* a, const void* b);
+   void executeFunction(const Node* pNode, const S32 argc, const char** argv);
+
    // Find: return NULL if not found in current map, Get: create if not
    //  found.
    const Node* findNode(const U32 inDeviceType, const U32 inDeviceInst,
@@ -178,6 +217,13 @@ class ActionMap : public SimObject
 
    static bool getDeviceTypeAndInstance(const char *device, U32 &deviceType, U32 &deviceInstance);
 
+   /// Input processing metrics.
+   static void resetMetrics();
+   static void dumpMetrics();
+   static U32  getEventCount()    { return smEventCount; }
+   static U32  getLookupCount()   { return smLookupCount; }
+   static U32  getDispatchCount() { return smDispatchCount; }
+
    DECLARE_CONOBJECT(ActionMap);
 };
 
@@ -197,3 +197,39 @@ ConsoleMethodWithDocs( ActionMap, getDeadZone, ConsoleString, 4, 4, ( device , a
 }
 
 ConsoleMethodGroupEndWithDocs(ActionMap)
+
+//------------------------------------------------------------------------------
+
+/*! @defgroup ActionMapFunctions Action Map
+    @ingroup TorqueScriptFunctions
+    @{
+*/
+
+/*! Gets the input processing metrics for all action maps.
+    Event latency is reported by the profiler as 'ActionMap_HandleEvent'.
+    @return The metrics as "events lookups dispatches".
+*/
+ConsoleFunctionWithDocs( getActionMapMetrics, ConsoleString, 1, 1, ())
+{
+   char* pBuffer = Con::getReturnBuffer( 64 );
+   dSprintf( pBuffer, 64, "%d %d %d", ActionMap::getEventCount(), ActionMap::getLookupCount(), ActionMap::getDispatchCount() );
+   return pBuffer;
+}
+
+/*! Resets the input processing metrics.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs( resetActionMapMetrics, ConsoleVoid, 1, 1, ())
+{
+   ActionMap::resetMetrics();
+}
+
+/*! Dumps the input processing metrics.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs( dumpActionMapMetrics, ConsoleVoid, 1, 1, ())
+{
+   ActionMap::dumpMetrics();
+}
+
+/*! @} */ // group ActionMapFunctions
@@ -0,0 +1,367 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "frameAllocator.h"
+#include "console/console.h"
+
+#ifndef _MMATHFN_H_
+#include "math/mMathFn.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    enum
+    {
+        BlockGranularity = 64 * 1024,
+        MaxMergedBlockSize = 64 * 1024 * 1024,
+    };
+
+    /// The arenas of all threads for telemetry.
+    /// A spin lock is used as arenas can be created during static initialization.
+    FrameAllocator::Arena*  sgArenaList = NULL;
+    std::atomic_flag        sgArenaListLock = ATOMIC_FLAG_INIT;
+    ThreadIdent             sgMainThreadId = 0;
+    bool                    sgInitialized = false;
+
+    inline bool isMainThread( const ThreadIdent threadId )
+    {
+        return sgInitialized && ThreadManager::compare( threadId, sgMainThreadId );
+    }
+
+    inline void lockArenaList( void )
+    {
+        while ( sgArenaListLock.test_and_set( std::memory_order_acquire ) )
+        {
+        }
+    }
+
+    inline void unlockArenaList( void )
+    {
+        sgArenaListLock.clear( std::memory_order_release );
+    }
+
+    inline U32 roundBlockSize( const U32 size )
+    {
+        return ( size + ( BlockGranularity - 1 ) ) & ~( BlockGranularity - 1 );
+    }
+
+    FrameAllocator::Block* createBlock( const U32 base, const U32 size )
+    {
+        // Blocks start 16-byte aligned.
+        U8* pMemory = (U8*)dMalloc( sizeof(FrameAllocator::Block) + size + 15 );
+        FrameAllocator::Block* pBlock = (FrameAllocator::Block*)pMemory;
+        pBlock->mpNext = NULL;
+        pBlock->mpData = (U8*)(((dsize_t)(pMemory + sizeof(FrameAllocator::Block)) + 15) & ~(dsize_t)15);
+        pBlock->mBase = base;
+        pBlock->mSize = size;
+        return pBlock;
+    }
+
+    void releaseBlocks( FrameAllocator::Arena* pArena, FrameAllocator::Block* pBlock )
+    {
+        while ( pBlock != NULL )
+        {
+            FrameAllocator::Block* pNext = pBlock->mpNext;
+            pArena->mReserved.store( pArena->mReserved.load( std::memory_order_relaxed ) - pBlock->mSize, std::memory_order_relaxed );
+            pArena->mBlockCount.store( pArena->mBlockCount.load( std::memory_order_relaxed ) - 1, std::memory_order_relaxed );
+            dFree( pBlock );
+            pBlock = pNext;
+        }
+    }
+
+    inline void addBlock( FrameAllocator::Arena* pArena, FrameAllocator::Block* pBlock )
+    {
+        pArena->mReserved.store( pArena->mReserved.load( std::memory_order_relaxed ) + pBlock->mSize, std::memory_order_relaxed );
+        pArena->mBlockCount.store( pArena->mBlockCount.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+/// Releases the arena of a thread when it exits.
+struct FrameArenaOwner
+{
+    FrameArenaOwner() : mpArena( NULL ) {}
+    ~FrameArenaOwner()
+    {
+        if ( mpArena != NULL )
+            FrameAllocator::releaseArena( mpArena );
+    }
+
+    FrameAllocator::Arena* mpArena;
+};
+
+static thread_local FrameArenaOwner sgArenaOwner;
+
+//-----------------------------------------------------------------------------
+
+thread_local FrameAllocator::Arena* FrameAllocator::smpArena = NULL;
+U32 FrameAllocator::smMainBlockSize = 256 * 1024;
+U32 FrameAllocator::smThreadBlockSize = 256 * 1024;
+
+FrameVectorAllocator FrameVectorAllocator::smAllocator;
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocator::init(const U32 frameSize, const U32 threadFrameSize)
+{
+   AssertFatal(!sgInitialized, "Error, already initialized");
+
+   sgMainThreadId = ThreadManager::getCurrentThreadId();
+   sgInitialized = true;
+   smMainBlockSize = frameSize;
+   smThreadBlockSize = threadFrameSize;
+
+   // Create the main arena up front.
+   Arena* pArena = smpArena;
+   if (pArena == NULL)
+      pArena = createArena();
+
+   pArena->mDefaultBlockSize = frameSize;
+   if (pArena->mpFirstBlock == NULL)
+   {
+      pArena->mpFirstBlock = pArena->mpBlock = createBlock(0, frameSize);
+      addBlock(pArena, pArena->mpFirstBlock);
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocator::destroy()
+{
+   AssertFatal(sgInitialized, "Error, not initialized");
+
+   if (smpArena != NULL)
+   {
+      releaseArena(smpArena);
+      sgArenaOwner.mpArena = NULL;
+   }
+
+   sgInitialized = false;
+}
+
+//-----------------------------------------------------------------------------
+
+FrameAllocator::Arena* FrameAllocator::createArena()
+{
+   Arena* pArena = new Arena;
+   pArena->mpFirstBlock = NULL;
+   pArena->mpBlock = NULL;
+   pArena->mUsed = 0;
+   pArena->mFramePeak = 0;
+   pArena->mThreadId = ThreadManager::getCurrentThreadId();
+   pArena->mDefaultBlockSize = isMainThread( pArena->mThreadId ) ? smMainBlockSize : smThreadBlockSize;
+   pArena->mReserved.store( 0, std::memory_order_relaxed );
+   pArena->mBlockCount.store( 0, std::memory_order_relaxed );
+   pArena->mLastFramePeak.store( 0, std::memory_order_relaxed );
+   pArena->mPeakWaterMark.store( 0, std::memory_order_relaxed );
+   pArena->mOverflows.store( 0, std::memory_order_relaxed );
+   pArena->mFrames.store( 0, std::memory_order_relaxed );
+
+   lockArenaList();
+   pArena->mpNext = sgArenaList;
+   sgArenaList = pArena;
+   unlockArenaList();
+
+   smpArena = pArena;
+   sgArenaOwner.mpArena = pArena;
+
+   return pArena;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocator::releaseArena(Arena* pArena)
+{
+   lockArenaList();
+   for ( Arena** ppArena = &sgArenaList; *ppArena != NULL; ppArena = &(*ppArena)->mpNext )
+   {
+      if ( *ppArena == pArena )
+      {
+         *ppArena = pArena->mpNext;
+         break;
+      }
+   }
+   unlockArenaList();
+
+   releaseBlocks(pArena, pArena->mpFirstBlock);
+   delete pArena;
+
+   if (smpArena == pArena)
+      smpArena = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void* FrameAllocator::allocOverflow(Arena* pArena, const U32 allocSize, const U32 alignment)
+{
+   U32 requiredSize = allocSize + alignment;
+#ifdef TORQUE_DEBUG
+   requiredSize += 4;
+#endif
+
+   Block* pBlock = pArena->mpBlock;
+   Block* pNext = pBlock != NULL ? pBlock->mpNext : pArena->mpFirstBlock;
+
+   // Chain a new block if the next one is missing or too small.
+   // Blocks after the current one are unused so they can be released.
+   if (pNext == NULL || pNext->mSize < requiredSize)
+   {
+      if (pBlock != NULL)
+      {
+         pBlock->mpNext = NULL;
+
+         // Count the overflow.
+         pArena->mOverflows.store( pArena->mOverflows.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+      }
+      else
+      {
+         pArena->mpFirstBlock = NULL;
+      }
+
+      releaseBlocks(pArena, pNext);
+
+      const U32 base = pBlock != NULL ? pBlock->mBase + pBlock->mSize : 0;
+      pNext = createBlock(base, getMax(pArena->mDefaultBlockSize, roundBlockSize(requiredSize)));
+      addBlock(pArena, pNext);
+
+      if (pBlock != NULL)
+         pBlock->mpNext = pNext;
+      else
+         pArena->mpFirstBlock = pNext;
+   }
+
+   pArena->mpBlock = pNext;
+   pArena->mUsed = 0;
+
+   return alloc(allocSize, alignment);
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocator::setWaterMarkBlock(Arena* pArena, const U32 waterMark)
+{
+   // Find the block holding the water mark.
+   Block* pBlock = pArena->mpFirstBlock;
+   while (waterMark > pBlock->mBase + pBlock->mSize)
+      pBlock = pBlock->mpNext;
+
+   pArena->mpBlock = pBlock;
+   pArena->mUsed = waterMark - pBlock->mBase;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 FrameAllocator::getPeakWaterMark()
+{
+   Arena* pArena = smpArena;
+   if (pArena == NULL)
+      return 0;
+
+   return getMax(pArena->mFramePeak, pArena->mPeakWaterMark.load( std::memory_order_relaxed ));
+}
+
+//-----------------------------------------------------------------------------
+
+bool FrameAllocator::contains(const void* memory)
+{
+   Arena* pArena = smpArena;
+   if (pArena == NULL)
+      return false;
+
+   for (Block* pBlock = pArena->mpFirstBlock; pBlock != NULL; pBlock = pBlock->mpNext)
+   {
+      if (memory >= pBlock->mpData && memory < pBlock->mpData + pBlock->mSize)
+         return true;
+   }
+
+   return false;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocator::endFrame()
+{
+   Arena* pArena = smpArena;
+   if (pArena == NULL)
+      return;
+
+   // Publish the frame telemetry.
+   const U32 framePeak = pArena->mFramePeak;
+   pArena->mLastFramePeak.store( framePeak, std::memory_order_relaxed );
+   if (framePeak > pArena->mPeakWaterMark.load( std::memory_order_relaxed ))
+      pArena->mPeakWaterMark.store( framePeak, std::memory_order_relaxed );
+   pArena->mFrames.store( pArena->mFrames.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+
+   // Merge the blocks if the arena overflowed so the next frame fits in one.
+   Block* pFirstBlock = pArena->mpFirstBlock;
+   if (pFirstBlock != NULL && pFirstBlock->mpNext != NULL)
+   {
+      const U32 mergedSize = getMax(pArena->mDefaultBlockSize, getMin(roundBlockSize(framePeak), (U32)MaxMergedBlockSize));
+
+      releaseBlocks(pArena, pFirstBlock);
+
+      pArena->mpFirstBlock = createBlock(0, mergedSize);
+      addBlock(pArena, pArena->mpFirstBlock);
+   }
+
+   pArena->mpBlock = pArena->mpFirstBlock;
+   pArena->mUsed = 0;
+   pArena->mFramePeak = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocator::dumpMetrics()
+{
+   Con::printSeparator();
+   Con::printf( "Frame Allocator Metrics:" );
+
+   U32 arenaCount = 0;
+   U32 totalReserved = 0;
+
+   lockArenaList();
+   for ( Arena* pArena = sgArenaList; pArena != NULL; pArena = pArena->mpNext )
+   {
+      const U32 reserved = pArena->mReserved.load( std::memory_order_relaxed );
+
+      Con::printf( "  Thread %u%s: Reserved: %u bytes in %u block(s), Last Frame Peak: %u, Peak: %u, Overflows: %u, Frames: %u",
+         (U32)pArena->mThreadId,
+         isMainThread( pArena->mThreadId ) ? " (main)" : "",
+         reserved,
+         pArena->mBlockCount.load( std::memory_order_relaxed ),
+         pArena->mLastFramePeak.load( std::memory_order_relaxed ),
+         pArena->mPeakWaterMark.load( std::memory_order_relaxed ),
+         pArena->mOverflows.load( std::memory_order_relaxed ),
+         pArena->mFrames.load( std::memory_order_relaxed ) );
+
+      arenaCount++;
+      totalReserved += reserved;
+   }
+   unlockArenaList();
+
+   Con::printf( "  Total: %u arena(s), %u bytes reserved.", arenaCount, totalReserved );
+   Con::printSeparator();
+}
@@ -27,6 +27,25 @@
 #include "platform/platform.h"
 #endif
 
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+#include <atomic>
+
+/// This #define is used by the FrameAllocator to align starting addresses to
+/// be byte aligned to this value. This is important on the 360 and possibly
+/// on other platforms as well. Use this #define anywhere alignment is needed.
+///
+/// NOTE: Do not change this value per-platform unless you have a very good
+/// reason for doing so. It has the potential to cause inconsistencies in 
+/// memory which is allocated and expected to be contiguous.
+#define TORQUE_BYTE_ALIGNMENT 4
+
 /// Temporary memory pool for per-frame allocations.
 ///
 /// In the course of rendering a frame, it is often necessary to allocate
@@ -43,82 +62,120 @@
 ///   // Free frameAllocator memory
 ///   FrameAllocator::setWaterMark(waterMark);
 /// @endcode
+///
+/// Each thread has its own arena so the allocator can be used from worker threads
+/// without locking.  Memory must be released on the thread that allocated it.
+///
+/// An arena is a chain of blocks.  When the current block is full the allocation
+/// moves on to the next block, chaining a new one if required, rather than failing.
+/// Water marks are offsets into the whole chain so they remain valid across blocks.
+///
+/// Allocations made without a marker live until the thread calls endFrame() which
+/// releases everything and, if the arena overflowed, merges the chain into a single
+/// block sized to the peak usage.  The main loop and the worker loops call it once
+/// per iteration.
 class FrameAllocator
 {
-   static U8*   smBuffer;
-   static U32   smHighWaterMark;
-   static U32   smWaterMark;
+  public:
+   struct Block
+   {
+      Block*   mpNext;
+      U8*      mpData;
+      U32      mBase;
+      U32      mSize;
+   };
+
+   struct Arena
+   {
+      Block*            mpFirstBlock;
+      Block*            mpBlock;
+      U32               mUsed;
+      U32               mFramePeak;
+      U32               mDefaultBlockSize;
+      ThreadIdent       mThreadId;
+      Arena*            mpNext;
+
+      /// Telemetry readable from other threads.
+      std::atomic<U32>  mReserved;
+      std::atomic<U32>  mBlockCount;
+      std::atomic<U32>  mLastFramePeak;
+      std::atomic<U32>  mPeakWaterMark;
+      std::atomic<U32>  mOverflows;
+      std::atomic<U32>  mFrames;
+   };
+
+  private:
+   static thread_local Arena* smpArena;
+   static U32   smMainBlockSize;
+   static U32   smThreadBlockSize;
+
+   static Arena* createArena();
+   static void releaseArena(Arena* pArena);
+   static void* allocOverflow(Arena* pArena, const U32 allocSize, const U32 alignment);
+   static void setWaterMarkBlock(Arena* pArena, const U32 waterMark);
+
+   friend struct FrameArenaOwner;
 
   public:
-   inline static void init(const U32 frameSize);
-   inline static void destroy();
+   /// Set the first block size for the calling (main) thread and for other threads.
+   static void init(const U32 frameSize, const U32 threadFrameSize = 256 * 1024);
+   static void destroy();
 
-   inline static void* alloc(const U32 allocSize);
+   inline static void* alloc(const U32 allocSize, const U32 alignment = TORQUE_BYTE_ALIGNMENT);
 
    inline static void setWaterMark(const U32);
    inline static U32  getWaterMark();
-   inline static U32  getHighWaterMark();
-};
 
-#if defined(TORQUE_DEBUG)
-static U32 sgMaxFrameAllocation = 0;
-#endif
+   /// The water mark at the end of the current block.
+   inline static U32  getHighWaterMark();
 
-void FrameAllocator::init(const U32 frameSize)
-{
-   AssertFatal(smBuffer == NULL, "Error, already initialized");
-   smBuffer = new U8[frameSize];
-   smWaterMark = 0;
-   smHighWaterMark = frameSize;
-}
+   /// The highest water mark reached by the calling thread.
+   static U32 getPeakWaterMark();
 
-void FrameAllocator::destroy()
-{
-   AssertFatal(smBuffer != NULL, "Error, not initialized");
+   /// Whether the memory belongs to the calling thread's arena.
+   static bool contains(const void* memory);
 
-   delete [] smBuffer;
-   smBuffer = NULL;
-   smWaterMark = 0;
-   smHighWaterMark = 0;
-}
+   /// Release all frame memory of the calling thread.  No marker may be outstanding.
+   static void endFrame();
 
-/// This #define is used by the FrameAllocator to align starting addresses to
-/// be byte aligned to this value. This is important on the 360 and possibly
-/// on other platforms as well. Use this #define anywhere alignment is needed.
-///
-/// NOTE: Do not change this value per-platform unless you have a very good
-/// reason for doing so. It has the potential to cause inconsistencies in 
-/// memory which is allocated and expected to be contiguous.
-#define TORQUE_BYTE_ALIGNMENT 4
+   static void dumpMetrics();
+};
 
+//-----------------------------------------------------------------------------
 
-void* FrameAllocator::alloc(const U32 allocSize)
+void* FrameAllocator::alloc(const U32 allocSize, const U32 alignment)
 {
+   AssertFatal( alignment != 0 && (alignment & (alignment - 1)) == 0, "FrameAllocator::alloc() - Alignment must be a power of two." );
+
+   Arena* pArena = smpArena;
+   if (pArena == NULL)
+      pArena = createArena();
+
    U32 _allocSize = allocSize;
 #ifdef TORQUE_DEBUG
    _allocSize+=4;
 #endif
-   AssertFatal(smBuffer != NULL, "Error, no buffer!");
-   AssertFatal(smWaterMark + _allocSize <= smHighWaterMark, "Error alloc too large, increase frame size!");
 
-   // Keep all frame allocator allocations aligned to DWORD boundries on the 360
-   // Add 3, mask out the lower 3 bits.
-   smWaterMark = ( smWaterMark + ( TORQUE_BYTE_ALIGNMENT - 1 ) ) & (~( TORQUE_BYTE_ALIGNMENT - 1 ));
+   Block* pBlock = pArena->mpBlock;
 
-   // Sanity check.
-   AssertFatal( !( smWaterMark & ( TORQUE_BYTE_ALIGNMENT - 1 ) ), "Frame allocation is not on a 4-byte boundry." );
+   // Keep all frame allocator allocations aligned.  Blocks start 16-byte aligned.
+   const U32 start = ( pArena->mUsed + ( alignment - 1 ) ) & (~( alignment - 1 ));
 
-   U8* p = &smBuffer[smWaterMark];
-   smWaterMark += _allocSize;
+   // Move to another block if this one is full.
+   if (pBlock == NULL || start + _allocSize > pBlock->mSize)
+      return allocOverflow(pArena, allocSize, alignment);
 
-#if defined(TORQUE_DEBUG)
-   if (smWaterMark > sgMaxFrameAllocation)
-      sgMaxFrameAllocation = smWaterMark;
-#endif
+   U8* p = pBlock->mpData + start;
+   pArena->mUsed = start + _allocSize;
+
+   const U32 waterMark = pBlock->mBase + pArena->mUsed;
+   if (waterMark > pArena->mFramePeak)
+      pArena->mFramePeak = waterMark;
 
 #ifdef TORQUE_DEBUG
-   U32 *flag = (U32*) &smBuffer[smWaterMark-4];
-   *flag = 0xdeadbeef ^ smWaterMark;
+   // The guard may not be aligned.
+   const U32 flag = 0xdeadbeef ^ waterMark;
+   dMemcpy(&pBlock->mpData[pArena->mUsed-4], &flag, sizeof(flag));
 #endif
    return p;
 }
@@ -126,26 +183,46 @@ void* FrameAllocator::alloc(const U32 allocSize)
 
 void FrameAllocator::setWaterMark(const U32 waterMark)
 {
-   AssertFatal(waterMark < smHighWaterMark, "Error, invalid waterMark");
+   Arena* pArena = smpArena;
+   if (pArena == NULL || pArena->mpBlock == NULL)
+   {
+      AssertFatal(waterMark == 0, "Error, invalid waterMark");
+      return;
+   }
+
+   Block* pBlock = pArena->mpBlock;
+
+   AssertFatal(waterMark <= pBlock->mBase + pArena->mUsed, "Error, invalid waterMark");
 
 #ifdef TORQUE_DEBUG
-   if(smWaterMark >= 4 )
+   if(pArena->mUsed >= 4 )
    {
-      U32 *flag = (U32*) &smBuffer[smWaterMark-4];
-      AssertFatal( *flag == (0xdeadbeef ^ smWaterMark), "FrameAllocator guard overwritten!");
+      U32 flag;
+      dMemcpy(&flag, &pBlock->mpData[pArena->mUsed-4], sizeof(flag));
+      AssertFatal( flag == (0xdeadbeef ^ (pBlock->mBase + pArena->mUsed)), "FrameAllocator guard overwritten!");
    }
 #endif
-   smWaterMark = waterMark;
+
+   // Rewind within the current block if possible.
+   if (waterMark >= pBlock->mBase)
+   {
+      pArena->mUsed = waterMark - pBlock->mBase;
+      return;
+   }
+
+   setWaterMarkBlock(pArena, waterMark);
 }
 
 U32 FrameAllocator::getWaterMark()
 {
-   return smWaterMark;
+   Arena* pArena = smpArena;
+   return pArena != NULL && pArena->mpBlock != NULL ? pArena->mpBlock->mBase + pArena->mUsed : 0;
 }
 
 U32 FrameAllocator::getHighWaterMark()
 {
-   return smHighWaterMark;
+   Arena* pArena = smpArena;
+   return pArena != NULL && pArena->mpBlock != NULL ? pArena->mpBlock->mBase + pArena->mpBlock->mSize : 0;
 }
 
 /// Helper class to deal with FrameAllocator usage.
@@ -178,9 +255,42 @@ public:
       FrameAllocator::setWaterMark(mMarker);
    }
 
-   void* alloc(const U32 allocSize) const
+   void* alloc(const U32 allocSize, const U32 alignment = TORQUE_BYTE_ALIGNMENT) const
+   {
+      return FrameAllocator::alloc(allocSize, alignment);
+   }
+};
+
+/// Vector allocator that draws from the FrameAllocator of the calling thread.
+///
+/// Growing a vector leaves its previous memory in the frame which is only reclaimed
+/// when the water mark is restored.  Declare a single FrameAllocatorMarker before any
+/// vectors using this so that the vectors are gone before the water mark is restored,
+/// and only use the vectors on the thread that declared them:
+///
+/// @code
+/// FrameAllocatorMarker frameMarker;
+/// Vector<Vector2> verts;
+/// verts.setAllocator( &FrameVectorAllocator::smAllocator );
+/// @endcode
+class FrameVectorAllocator : public VectorAllocator
+{
+public:
+   static FrameVectorAllocator smAllocator;
+
+   virtual void* reallocate(void* memory, const U32 oldSize, const U32 newSize)
    {
-      return FrameAllocator::alloc(allocSize);
+      // Frame memory is released with the water mark.
+      if (newSize == 0)
+         return NULL;
+
+      // Align to 16 bytes for any element type.
+      void* p = FrameAllocator::alloc(newSize, 16);
+
+      if (memory)
+         dMemcpy(p, memory, oldSize < newSize ? oldSize : newSize);
+
+      return p;
    }
 };
 
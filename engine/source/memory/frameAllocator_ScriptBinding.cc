@@ -23,24 +23,28 @@
 #include "frameAllocator.h"
 #include "console/console.h"
 
-U8*   FrameAllocator::smBuffer = NULL;
-U32   FrameAllocator::smWaterMark = 0;
-U32   FrameAllocator::smHighWaterMark = 0;
-
-#if defined(TORQUE_DEBUG)
-
 /*! @defgroup MemoryFrameAllocation Memory Frames
 	@ingroup TorqueScriptFunctions
 	@{
 */
 
+#if defined(TORQUE_DEBUG)
+
 /*!
 */
 ConsoleFunctionWithDocs(getMaxFrameAllocation, S32, 1,1, ())
 {
-   return sgMaxFrameAllocation;
+   return FrameAllocator::getPeakWaterMark();
 }
 
-/*! @} */ // end group MemoryFrameAllocation
-
 #endif
+
+/*! Dump the frame allocator arena of each thread.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs(dumpFrameAllocatorMetrics, ConsoleVoid, 1,1, ())
+{
+   FrameAllocator::dumpMetrics();
+}
+
+/*! @} */ // end group MemoryFrameAllocation
@@ -281,6 +281,10 @@ NetConnection::NetConnection()
    // ghost management data:
 
    mScopeObject = NULL;
+   mScopeDistance = 0.0f;
+   mScopeRegionObject = NULL;
+   mScopeRegionValid = false;
+   mScopeExternal = false;
    mGhostingSequence = 0;
    mGhosting = false;
    mScoping = false;
@@ -291,6 +295,13 @@ NetConnection::NetConnection()
 
    mGhostsActive = 0;
 
+   mGhostPacketCount = 0;
+   mGhostBitsWritten = 0;
+   mGhostUpdatesWritten = 0;
+   mGhostPriorityCount = 0;
+   mScopeQueryCount = 0;
+   mScopeQuerySkipCount = 0;
+
    mMissionPathsSent = false;
    mDemoWriteStream = NULL;
    mDemoReadStream = NULL;
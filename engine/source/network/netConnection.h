@@ -29,6 +29,12 @@
 #ifndef _NETOBJECT_H_
 #include "network/netObject.h"
 #endif
+#ifndef _NETSCOPEGRID_H_
+#include "network/netScopeGrid.h"
+#endif
+#ifndef _NETREPLICATEDFIELDS_H_
+#include "network/netReplicatedFields.h"
+#endif
 #ifndef _NETSTRINGTABLE_H_
 #include "network/netStringTable.h"
 #endif
@@ -403,6 +409,7 @@ public:
 class NetConnection : public ConnectionProtocol, public SimGroup
 {
     friend class NetInterface;
+    friend class NetScopeGrid;
 
     typedef SimGroup Parent;
 
@@ -421,6 +428,7 @@ public:
         GhostInfo *ghost;          ///< Reference to the GhostInfo we're from.
         GhostRef *nextRef;         ///< Next GhostRef in this packet.
         GhostRef *nextUpdateChain; ///< Next update we sent for this ghost.
+        NetReplicatedPacket *replicated; ///< Replicated field slots we transmitted, if any.
     };
 
     enum Constants
@@ -787,6 +795,36 @@ protected:
     /// that the player is driving.
     SimObjectPtr<NetObject> mScopeObject;
 
+    /// @name Incremental Scoping
+    ///
+    /// A scope query that only scoped objects from the scope grid doesn't need
+    /// repeating until the grid region it covered changes.
+    /// @{
+
+    F32 mScopeDistance;                 ///< Radius of the 2D scope area around the scope object, zero for no limit.
+    NetScopeGrid::Region mScopeRegion;  ///< Region covered by the last scope query.
+    NetObject* mScopeRegionObject;      ///< Scope object of the last scope query.
+    bool mScopeRegionValid;             ///< Can the last scope query be kept while its region is unchanged?
+    bool mScopeExternal;                ///< Was anything scoped from outside the scope grid?
+
+    /// @}
+
+    /// Ghosts waiting to be written, as a heap ordered by priority.
+    Vector<GhostInfo*> mGhostHeap;
+
+    /// @name Ghosting Metrics
+    /// @{
+
+    U32 mGhostPacketCount;
+    U32 mGhostBitsWritten;
+    U32 mGhostUpdatesWritten;
+    U32 mGhostPriorityCount;
+    U32 mScopeQueryCount;
+    U32 mScopeQuerySkipCount;
+
+    /// @}
+
+    void scopeObject(NetObject *object);
     void clearGhostInfo();
     bool validateGhostArray();
 
@@ -837,6 +875,21 @@ public:
     /// Add an object to scope.
     void objectInScope(NetObject *object);
 
+    /// Limit scoping to objects within a distance of the scope object's scope position.
+    /// A distance of zero removes the limit.
+    void setScopeDistance(const F32 distance);
+    F32 getScopeDistance() const { return mScopeDistance; }
+
+    /// Ghosting metrics.
+    void resetGhostMetrics();
+    void dumpGhostMetrics();
+    U32 getGhostPacketCount() const { return mGhostPacketCount; }
+    U32 getGhostBitsWritten() const { return mGhostBitsWritten; }
+    U32 getGhostUpdatesWritten() const { return mGhostUpdatesWritten; }
+    U32 getGhostPriorityCount() const { return mGhostPriorityCount; }
+    U32 getScopeQueryCount() const { return mScopeQueryCount; }
+    U32 getScopeQuerySkipCount() const { return mScopeQuerySkipCount; }
+
     /// Add an object to scope, marking that it should always be scoped to this connection.
     void objectLocalScopeAlways(NetObject *object);
 
@@ -1051,6 +1104,7 @@ public:  // required for MSVC
     GhostInfo *nextObjectRef;              ///< Next ghosted object.
     GhostInfo *prevObjectRef;              ///< Previous ghosted object.
     NetConnection *connection;             ///< Connection that we're ghosting over.
+    NetReplicatedState *replicatedState;   ///< Replicated fields the other side has.
     GhostInfo *nextLookupInfo;             ///< GhostInfo references are stored in a hash; this is the bucket
     ///  implementation.
 
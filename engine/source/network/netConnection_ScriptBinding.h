@@ -229,4 +229,51 @@ ConsoleMethodWithDocs( NetConnection, getGhostsActive, S32, 2, 2, ())
     return object->getGhostsActive();
 }
 
+/*! Limits scoping to objects within a distance of the scope object.
+    The distance is measured from the scope object's scope position to the scope positions of other objects.  Objects without a scope position are always scoped.
+    @param distance The scope distance in world units, or zero for no limit.
+    @return No return value.
+    @sa NetObject::setScopePosition
+*/
+ConsoleMethodWithDocs( NetConnection, setScopeDistance, ConsoleVoid, 3, 3, ( distance ))
+{
+   object->setScopeDistance( dAtof(argv[2]) );
+}
+
+/*! Gets the scope distance.
+    @return The scope distance in world units, or zero for no limit.
+*/
+ConsoleMethodWithDocs( NetConnection, getScopeDistance, ConsoleFloat, 2, 2, ())
+{
+   return object->getScopeDistance();
+}
+
+/*! Gets the ghosting metrics for this connection.
+    @return The metrics as "packets ghostBits ghostUpdates prioritiesEvaluated scopeQueries scopeQueriesSkipped".
+*/
+ConsoleMethodWithDocs( NetConnection, getGhostMetrics, ConsoleString, 2, 2, ())
+{
+   char* pBuffer = Con::getReturnBuffer( 128 );
+   dSprintf( pBuffer, 128, "%d %d %d %d %d %d",
+      object->getGhostPacketCount(), object->getGhostBitsWritten(), object->getGhostUpdatesWritten(),
+      object->getGhostPriorityCount(), object->getScopeQueryCount(), object->getScopeQuerySkipCount() );
+   return pBuffer;
+}
+
+/*! Resets the ghosting metrics for this connection.
+    @return No return value.
+*/
+ConsoleMethodWithDocs( NetConnection, resetGhostMetrics, ConsoleVoid, 2, 2, ())
+{
+   object->resetGhostMetrics();
+}
+
+/*! Dumps the ghosting metrics for this connection.
+    @return No return value.
+*/
+ConsoleMethodWithDocs( NetConnection, dumpGhostMetrics, ConsoleVoid, 2, 2, ())
+{
+   object->dumpGhostMetrics();
+}
+
 ConsoleMethodGroupEndWithDocs(NetConnection)
@@ -30,6 +30,9 @@
 #include "console/console.h"
 #include "console/consoleTypes.h"
 
+// Debug Profiling.
+#include "debug/profiler.h"
+
 #define DebugChecksum 0xF00DBAAD
 
 extern U32 gGhostUpdates;
@@ -62,6 +65,7 @@ public:
       {
          S32 classId = obj->getClassId(ps->getNetClassGroup());
          bstream->writeClassId(classId, NetClassTypeObject, ps->getNetClassGroup());
+         obj->writeReplicatedFields(bstream);
          obj->packUpdate(ps, 0xFFFFFFFF, bstream);
       }
    }
@@ -72,6 +76,7 @@ public:
       {
          S32 classId = object->getClassId(ps->getNetClassGroup());
          bstream->writeClassId(classId, NetClassTypeObject, ps->getNetClassGroup());
+         object->writeReplicatedFields(bstream);
          object->packUpdate(ps, 0xFFFFFFFF, bstream);
       }
    }
@@ -95,6 +100,7 @@ public:
          }
          object->mNetFlags = NetObject::IsGhost;
          object->mNetIndex = ghostIndex;
+         object->readReplicatedFields(bstream);
          object->unpackUpdate(ps, bstream);
          validObject = true;
       }
@@ -145,6 +151,7 @@ void NetConnection::setGhostFrom(bool ghostFrom)
          mGhostRefs[i].obj = NULL;
          mGhostRefs[i].index = i;
          mGhostRefs[i].updateMask = 0;
+         mGhostRefs[i].replicatedState = NULL;
       }
       mGhostLookupTable = new GhostInfo *[GhostLookupTableSize];
       for(i = 0; i < GhostLookupTableSize; i++)
@@ -186,6 +193,15 @@ void NetConnection::ghostPacketDropped(PacketNotify *notify)
 
       orFlags = packRef->mask & ~orFlags;
 
+      // resend replicated fields whose latest value was lost
+      if(packRef->replicated)
+      {
+         GhostInfo *ghost = packRef->ghost;
+         if(ghost->replicatedState && ghost->obj && ghost->replicatedState->packetDropped(packRef->replicated, ghost->obj->getReplicatedSlots()))
+            orFlags |= NetObject::ReplicatedFieldsMask;
+         delete packRef->replicated;
+      }
+
       if(orFlags)
       {
          if(!packRef->ghost->updateMask)
@@ -243,6 +259,13 @@ void NetConnection::ghostPacketReceived(PacketNotify *notify)
 
       // if this object was ghosting , it is now ghosted
 
+      if(packRef->replicated)
+      {
+         if(packRef->ghost->replicatedState)
+            packRef->ghost->replicatedState->packetReceived(packRef->replicated);
+         delete packRef->replicated;
+      }
+
       if(packRef->ghostInfoFlags & GhostInfo::Ghosting)
          packRef->ghost->flags &= ~GhostInfo::Ghosting;
 
@@ -256,26 +279,43 @@ void NetConnection::ghostPacketReceived(PacketNotify *notify)
    }
 }
 
-struct UpdateQueueEntry
+// The ghost heap is a max-heap on priority so that only the ghosts
+// that fit in the packet are ever ordered.
+static void ghostHeapSiftDown(GhostInfo **heap, S32 count, S32 index)
 {
-   F32 priority;
-   GhostInfo *obj;
-
-   UpdateQueueEntry(F32 in_priority, GhostInfo *in_obj)
-      { priority = in_priority; obj = in_obj; }
-};
+   GhostInfo *ghost = heap[index];
+   for(;;)
+   {
+      S32 child = index * 2 + 1;
+      if(child >= count)
+         break;
+      if(child + 1 < count && heap[child + 1]->priority > heap[child]->priority)
+         child++;
+      if(heap[child]->priority <= ghost->priority)
+         break;
+      heap[index] = heap[child];
+      index = child;
+   }
+   heap[index] = ghost;
+}
 
-static S32 QSORT_CALLBACK UQECompare(const void *a,const void *b)
+static GhostInfo *ghostHeapPop(GhostInfo **heap, S32 &count)
 {
-   GhostInfo *ga = *((GhostInfo **) a);
-   GhostInfo *gb = *((GhostInfo **) b);
-
-   F32 ret = ga->priority - gb->priority;
-   return (ret < 0) ? -1 : ((ret > 0) ? 1 : 0);
+   GhostInfo *top = heap[0];
+   count--;
+   if(count > 0)
+   {
+      heap[0] = heap[count];
+      ghostHeapSiftDown(heap, count, 0);
+   }
+   return top;
 }
 
 void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
 {
+   // Debug Profiling.
+   PROFILE_SCOPE(NetConnection_GhostWritePacket);
+
 #ifdef    TORQUE_DEBUG_NET
    bstream->writeInt(DebugChecksum, 32);
 #endif
@@ -288,15 +328,19 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
    if(!bstream->writeFlag(mGhosting))
       return;
 
+   const S32 startPos = bstream->getCurPos();
+
    // fill a packet (or two) with ghosting data
 
    // first step is to check all our polled ghosts:
 
    // 1. Scope query - find if any new objects have come into
-   //    scope and if any have gone out.
+   //    scope and if any have gone out.  This is skipped if the
+   //    last query only scoped from the scope grid and nothing in
+   //    the region it covered has changed.
    // 2. call scoped objects' priority functions if the flag set is nonzero
    //    A removed ghost is assumed to have a high priority
-   // 3. call updates based on sorted priority until the packet is
+   // 3. call updates in priority order until the packet is
    //    full.  set flags to zero for all updated objects
 
    CameraScopeQuery camInfo;
@@ -308,6 +352,18 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
    camInfo.fov = (F32)(3.1415f / 4.0f);
    camInfo.sinFov = 0.7071f;
    camInfo.cosFov = 0.7071f;
+   camInfo.scopeArea = false;
+
+   // scope a 2D area around the scope object if it has a position
+   NetObject *scopeObject = mScopeObject;
+   if(scopeObject && scopeObject->hasScopePosition() && mScopeDistance > 0.0f)
+   {
+      const Point2F &scopePosition = scopeObject->getScopePosition();
+      camInfo.camera = scopeObject;
+      camInfo.pos.set(scopePosition.x, scopePosition.y, 0.0f);
+      camInfo.visibleDistance = mScopeDistance;
+      camInfo.scopeArea = true;
+   }
 
    GhostInfo *walk;
 
@@ -317,21 +373,49 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
    for(i = 0; i < (S32)mGhostZeroUpdateIndex; i++)
    {
       // increment the updateSkip for everyone... it's all good
-      walk = mGhostArray[i];
-      walk->updateSkipCount++;
-      if(!(walk->flags & (GhostInfo::ScopeAlways | GhostInfo::ScopeLocalAlways)))
-         walk->flags &= ~GhostInfo::InScope;
+      mGhostArray[i]->updateSkipCount++;
    }
 
-   if(mScopeObject)
-      mScopeObject->onCameraScopeQuery(this, &camInfo);
+   NetScopeGrid::Region scopeRegion;
+   bool rescope = true;
+   if(scopeObject)
+   {
+      NetScopeGrid::getRegion(&camInfo, scopeRegion);
+      rescope = !mScopeRegionValid || mScopeRegionObject != scopeObject || mScopeRegion != scopeRegion;
+   }
 
-   for(i = mGhostZeroUpdateIndex - 1; i >= 0; i--)
+   if(rescope)
+   {
+      mScopeQueryCount++;
+
+      for(i = 0; i < (S32)mGhostZeroUpdateIndex; i++)
+      {
+         walk = mGhostArray[i];
+         if(!(walk->flags & (GhostInfo::ScopeAlways | GhostInfo::ScopeLocalAlways)))
+            walk->flags &= ~GhostInfo::InScope;
+      }
+
+      mScopeExternal = false;
+      if(scopeObject)
+         scopeObject->onCameraScopeQuery(this, &camInfo);
+
+      // the query can be kept if it only scoped from the grid
+      mScopeRegion = scopeRegion;
+      mScopeRegionObject = scopeObject;
+      mScopeRegionValid = scopeObject && !mScopeExternal;
+
+      for(i = mGhostZeroUpdateIndex - 1; i >= 0; i--)
+      {
+         if(!(mGhostArray[i]->flags & GhostInfo::InScope))
+            detachObject(mGhostArray[i]);
+      }
+   }
+   else
    {
-      if(!(mGhostArray[i]->flags & GhostInfo::InScope))
-         detachObject(mGhostArray[i]);
+      mScopeQuerySkipCount++;
    }
 
+   mGhostHeap.clear();
    for(i = mGhostZeroUpdateIndex - 1; i >= 0; i--)
    {
       walk = mGhostArray[i];
@@ -351,17 +435,21 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
          if(walk->flags & GhostInfo::KillGhost)
             walk->priority = 10000;
          else
+         {
             walk->priority = walk->obj->getUpdatePriority(&camInfo, walk->updateMask, walk->updateSkipCount);
+            mGhostPriorityCount++;
+         }
+         mGhostHeap.push_back(walk);
       }
       else
          walk->priority = 0;
    }
    GhostRef *updateList = NULL;
-   dQsort(mGhostArray, mGhostZeroUpdateIndex, sizeof(GhostInfo *), UQECompare);
 
-   // reset the array indices...
-   for(i = mGhostZeroUpdateIndex - 1; i >= 0; i--)
-      mGhostArray[i]->arrayIndex = i;
+   // heapify the candidates, they are popped in priority order until the packet is full
+   S32 heapCount = mGhostHeap.size();
+   for(i = heapCount / 2 - 1; i >= 0; i--)
+      ghostHeapSiftDown(mGhostHeap.address(), heapCount, i);
 
    S32 sendSize = 1;
    while(maxIndex >>= 1)
@@ -374,12 +462,10 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
 
    U32 count = 0;
    //
-   for(i = mGhostZeroUpdateIndex - 1; i >= 0 && !bstream->isFull(); i--)
+   while(heapCount > 0 && !bstream->isFull())
    {
-      GhostInfo *walk = mGhostArray[i];
-        if(walk->flags & (GhostInfo::KillingGhost | GhostInfo::Ghosting))
-           continue;
-        
+      GhostInfo *walk = ghostHeapPop(mGhostHeap.address(), heapCount);
+      
       bstream->writeFlag(true);
 
       bstream->writeInt(walk->index, sendSize);
@@ -394,6 +480,7 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
 
       upd->ghost = walk;
       upd->ghostInfoFlags = 0;
+      upd->replicated = NULL;
 
       if(walk->flags & GhostInfo::KillGhost)
       {
@@ -419,6 +506,10 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
             walk->flags &= ~GhostInfo::NotYetGhosted;
             walk->flags |= GhostInfo::Ghosting;
             upd->ghostInfoFlags = GhostInfo::Ghosting;
+
+            // a new ghost has none of the replicated fields
+            if(walk->replicatedState)
+               walk->replicatedState->reset();
          }
 #ifdef TORQUE_DEBUG_NET
          else {
@@ -427,6 +518,22 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
             bstream->writeInt(classId ^ DebugChecksum, 32);
          }
 #endif
+         // replicated fields go ahead of the rest of the update
+         const NetReplicatedLayout *replicatedLayout = walk->obj->getReplicatedLayout();
+         if(replicatedLayout)
+         {
+            if(updateMask & NetObject::ReplicatedFieldsMask)
+            {
+               if(!walk->replicatedState)
+                  walk->replicatedState = new NetReplicatedState;
+               upd->replicated = walk->replicatedState->write(*replicatedLayout, walk->obj->getReplicatedSlots(), bstream);
+            }
+            else
+               bstream->writeFlag(false);
+
+            updateMask &= ~NetObject::ReplicatedFieldsMask;
+         }
+
          // update the object
          U32 retMask = walk->obj->packUpdate(this, updateMask, bstream);
          DEBUG_LOG(("PKLOG %d GHOST %d: %s", getId(), bstream->getCurPos() - 16 - startPos, walk->obj->getClassName()));
@@ -451,6 +558,10 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
    // no more objects...
    bstream->writeFlag(false);
    notify->ghostList = updateList;
+
+   mGhostPacketCount++;
+   mGhostUpdatesWritten += count;
+   mGhostBitsWritten += bstream->getCurPos() - startPos;
 }
 
 void NetConnection::ghostReadPacket(BitStream *bstream)
@@ -518,6 +629,7 @@ void NetConnection::ghostReadPacket(BitStream *bstream)
                avar("class id mismatch for dest class %s.",
                   mLocalGhosts[index]->getClassName()) );
 #endif
+            obj->readReplicatedFields(bstream);
             mLocalGhosts[index]->unpackUpdate(this, bstream);
 
             if(!obj->registerObject())
@@ -542,6 +654,7 @@ void NetConnection::ghostReadPacket(BitStream *bstream)
                avar("class id mismatch for dest class %s.",
                   mLocalGhosts[index]->getClassName()) );
 #endif
+            mLocalGhosts[index]->readReplicatedFields(bstream);
             mLocalGhosts[index]->unpackUpdate(this, bstream);
          }
          //PacketStream::getStats()->addBits(PacketStats::Receive, bstream->getCurPos() - startPos, ghostRefs[index].localGhost->getPersistTag());
@@ -568,6 +681,13 @@ void NetConnection::setScopeObject(NetObject *obj)
    if(((NetObject *) mScopeObject) == obj)
       return;
    mScopeObject = obj;
+   mScopeRegionValid = false;
+}
+
+void NetConnection::setScopeDistance(const F32 distance)
+{
+   mScopeDistance = getMax(distance, 0.0f);
+   mScopeRegionValid = false;
 }
 
 void NetConnection::detachObject(GhostInfo *info)
@@ -617,6 +737,35 @@ void NetConnection::freeGhostInfo(GhostInfo *ghost)
    }
    ghostPushZeroToFree(ghost);
    AssertFatal(ghost->updateChain == NULL, "Ack!");
+
+   delete ghost->replicatedState;
+   ghost->replicatedState = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void NetConnection::resetGhostMetrics()
+{
+   mGhostPacketCount = 0;
+   mGhostBitsWritten = 0;
+   mGhostUpdatesWritten = 0;
+   mGhostPriorityCount = 0;
+   mScopeQueryCount = 0;
+   mScopeQuerySkipCount = 0;
+}
+
+void NetConnection::dumpGhostMetrics()
+{
+   const F32 packets = mGhostPacketCount > 0 ? F32(mGhostPacketCount) : 1.0f;
+
+   Con::printf("Ghost Metrics for connection %d:", getId());
+   Con::printf("  Packets: %d", mGhostPacketCount);
+   Con::printf("  Ghost Bits: %d (%.1f per packet)", mGhostBitsWritten, F32(mGhostBitsWritten) / packets);
+   Con::printf("  Ghost Updates: %d (%.1f per packet)", mGhostUpdatesWritten, F32(mGhostUpdatesWritten) / packets);
+   Con::printf("  Priorities Evaluated: %d (%.1f per packet)", mGhostPriorityCount, F32(mGhostPriorityCount) / packets);
+   Con::printf("  Scope Queries: %d run, %d skipped", mScopeQueryCount, mScopeQuerySkipCount);
+   Con::printf("  Scope Grid Cells: %d", NetScopeGrid::getCellCount());
+   Con::printf("  Ghost write time is reported by the profiler as 'NetConnection_GhostWritePacket'.");
 }
 
 //-----------------------------------------------------------------------------
@@ -625,7 +774,7 @@ void NetConnection::objectLocalScopeAlways(NetObject *obj)
 {
    if(!isGhostingFrom())
       return;
-   objectInScope(obj);
+   scopeObject(obj);
    for(GhostInfo *walk = mGhostLookupTable[obj->getId() & (GhostLookupTableSize - 1)]; walk; walk = walk->nextLookupInfo)
    {
       if(walk->obj != obj)
@@ -671,6 +820,13 @@ bool NetConnection::validateGhostArray()
 }
 
 void NetConnection::objectInScope(NetObject *obj)
+{
+   // scoping from outside the scope grid means the scope query can't be skipped
+   mScopeExternal = true;
+   scopeObject(obj);
+}
+
+void NetConnection::scopeObject(NetObject *obj)
 {
    if (!mScoping || !isGhostingFrom())
       return;
@@ -802,6 +958,7 @@ void NetConnection::activateGhosting()
       return;
 
    mGhostingSequence++;
+   mScopeRegionValid = false;
 
    // iterate through the ghost always objects and InScope them...
    // also post em all to the other side.
@@ -881,6 +1038,7 @@ void NetConnection::resetGhosting()
 
    mGhosting = false;
    mScoping = false;
+   mScopeRegionValid = false;
    sendConnectionMessage(EndGhosting, mGhostingSequence);
    mGhostingSequence++;
    clearGhostInfo();
@@ -1062,6 +1220,7 @@ void NetConnection::ghostWriteStartBlock(ResizeBitStream *stream)
    {
       if(mLocalGhosts[i])
       {
+         mLocalGhosts[i]->writeReplicatedFields(stream);
          mLocalGhosts[i]->packUpdate(this, 0xFFFFFFFF, stream);
          stream->validate();
       }
@@ -1098,6 +1257,7 @@ void NetConnection::ghostReadStartBlock(BitStream *stream)
    {
       if(mLocalGhosts[i])
       {
+         mLocalGhosts[i]->readReplicatedFields(stream);
          mLocalGhosts[i]->unpackUpdate(this, stream);
          if(!mLocalGhosts[i]->registerObject())
          {
@@ -22,6 +22,7 @@
 
 #include "platform/platform.h"
 #include "platform/event.h"
+#include "platform/platformNetPacket.h"
 #include "network/netConnection.h"
 #include "network/netInterface.h"
 #include "io/bitStream.h"
@@ -88,19 +89,28 @@ NetConnection *NetInterface::findPendingConnection(const NetAddress *address, U3
 
 void NetInterface::processPacketReceiveEvent(PacketReceiveEvent *prEvent)
 {
+   processPacket(&prEvent->sourceAddress, prEvent->data, prEvent->size - PacketReceiveEventHeaderSize);
+}
 
-   U32 dataSize = prEvent->size;
-   BitStream pStream(prEvent->data, dataSize);
+void NetInterface::processPacketBuffer(NetPacketBuffer *buffer)
+{
+   processPacket(&buffer->sourceAddress, buffer->data, buffer->size);
+}
+
+void NetInterface::processPacket(const NetAddress *sourceAddress, U8 *data, U32 dataSize)
+{
+   // The stream reads the packet where it was received.
+   BitStream pStream(data, dataSize);
 
    // Determine what to do with this packet:
 
-   if(prEvent->data[0] & 0x01) // it's a protocol packet...
+   if(data[0] & 0x01) // it's a protocol packet...
    {
       // if the LSB of the first byte is set, it's a game data packet
       // so pass it to the appropriate connection.
 
       // lookup the connection in the addressTable
-      NetConnection *conn = NetConnection::lookup(&prEvent->sourceAddress);
+      NetConnection *conn = NetConnection::lookup(sourceAddress);
       if(conn)
          conn->processRawPacket(&pStream);
    }
@@ -111,14 +121,14 @@ void NetInterface::processPacketReceiveEvent(PacketReceiveEvent *prEvent)
 
       U8 packetType;
       pStream.read(&packetType);
-      NetAddress *addr = &prEvent->sourceAddress;
+      NetAddress *addr = const_cast<NetAddress *>(sourceAddress);
 
       if(packetType <= GameHeartbeat || packetType == MasterServerExtendedListResponse)
          handleInfoPacket(addr, packetType, &pStream);
 #ifdef GGC_PLUGIN
       else if (packetType == GGCPacket)
       {
-         HandleGGCPacket(addr, (U8*)packetData.data, dataSize);
+         HandleGGCPacket(addr, data, dataSize);
       }
 #endif
       else
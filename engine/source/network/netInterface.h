@@ -23,6 +23,8 @@
 #ifndef _H_NETINTERFACE
 #define _H_NETINTERFACE
 
+struct NetPacketBuffer;
+
 /// NetInterface class.  Manages all valid and pending notify protocol connections.
 ///
 /// @see NetConnection, GameConnection, NetObject, NetEvent
@@ -120,6 +122,12 @@ public:
    /// Dispatch function for processing all network packets through this NetInterface.
    virtual void processPacketReceiveEvent(PacketReceiveEvent *event);
 
+   /// Dispatch a pooled packet.  The packet is read in place.
+   virtual void processPacketBuffer(NetPacketBuffer *buffer);
+
+   /// Process a packet from the specified address.
+   virtual void processPacket(const NetAddress *sourceAddress, U8 *data, U32 dataSize);
+
    /// Handles all packets that don't fall into the category of connection handshake or game data.
    virtual void handleInfoPacket(const NetAddress *address, U8 packetType, BitStream *stream);
 
@@ -25,6 +25,9 @@
 #include "network/connectionProtocol.h"
 #include "network/netConnection.h"
 #include "network/netObject.h"
+#include "network/netScopeGrid.h"
+#include "network/netReplicatedFields.h"
+#include "io/bitStream.h"
 #include "console/consoleTypes.h"
 
 #include "netObject_ScriptBinding.h"
@@ -33,6 +36,7 @@ IMPLEMENT_CONOBJECT(NetObject);
 
 //----------------------------------------------------------------------------
 NetObject *NetObject::mDirtyList = NULL;
+Vector<NetObject*> NetObject::smReplicatedObjects;
 
 NetObject::NetObject()
 {
@@ -42,6 +46,12 @@ NetObject::NetObject()
    mPrevDirtyList = NULL;
    mNextDirtyList = NULL;
    mDirtyMaskBits = 0;
+   mScopePosition.set(0.0f, 0.0f);
+   mHasScopePosition = false;
+   mpScopeCell = NULL;
+   mScopeCellIndex = 0;
+   mpReplicatedLayout = NULL;
+   mReplicatedIndex = -1;
 }
 
 NetObject::~NetObject()
@@ -108,6 +118,8 @@ void NetObject::clearMaskBits(U32 orMask)
 
 void NetObject::collapseDirtyList()
 {
+   updateReplicatedFields();
+
    Vector<NetObject *> tempV;
    for(NetObject *t = mDirtyList; t; t = t->mNextDirtyList)
       tempV.push_back(t);
@@ -145,11 +157,64 @@ void NetObject::collapseDirtyList()
 
 //-----------------------------------------------------------------------------
 
+void NetObject::setReplicatedLayout(const NetReplicatedLayout* pLayout)
+{
+   AssertFatal(mReplicatedIndex == -1, "NetObject::setReplicatedLayout() - Cannot change the layout of a registered object.");
+
+   mpReplicatedLayout = pLayout;
+   mReplicatedSlots.setSize(pLayout ? pLayout->getSlotCount() : 0);
+   if(mReplicatedSlots.size())
+      dMemset(mReplicatedSlots.address(), 0, mReplicatedSlots.size() * sizeof(U32));
+}
+
+void NetObject::updateReplicatedFields()
+{
+   // Debug Profiling.
+   PROFILE_SCOPE(NetObject_UpdateReplicatedFields);
+
+   U32 slots[NetReplicatedLayout::MaxSlots];
+
+   for(U32 i = 0; i < (U32)smReplicatedObjects.size(); i++)
+   {
+      NetObject* obj = smReplicatedObjects[i];
+      const U32 slotCount = obj->mpReplicatedLayout->getSlotCount();
+
+      obj->mpReplicatedLayout->quantize(obj, slots);
+      if(dMemcmp(slots, obj->mReplicatedSlots.address(), slotCount * sizeof(U32)) == 0)
+         continue;
+
+      dMemcpy(obj->mReplicatedSlots.address(), slots, slotCount * sizeof(U32));
+      obj->setMaskBits(ReplicatedFieldsMask);
+   }
+}
+
+void NetObject::readReplicatedFields(BitStream *stream)
+{
+   if(!mpReplicatedLayout)
+      return;
+
+   const U32 slotMask = NetReplicatedState::read(*mpReplicatedLayout, mReplicatedSlots.address(), stream);
+   if(!slotMask)
+      return;
+
+   mpReplicatedLayout->dequantize(mReplicatedSlots.address(), this, slotMask);
+   onReplicatedFieldsChanged(slotMask);
+}
+
+void NetObject::writeReplicatedFields(BitStream *stream)
+{
+   if(mpReplicatedLayout)
+      NetReplicatedState::writeAll(*mpReplicatedLayout, mReplicatedSlots.address(), stream);
+}
+
+//-----------------------------------------------------------------------------
+
 void NetObject::setScopeAlways()
 {
    if(mNetFlags.test(Ghostable) && !mNetFlags.test(IsGhost))
    {
       mNetFlags.set(ScopeAlways);
+      NetScopeGrid::invalidateObject(this);
 
       // if it's a ghost always object, add it to the ghost always set
       // for ClientReps created later.
@@ -174,6 +239,7 @@ void NetObject::clearScopeAlways()
    if(!mNetFlags.test(IsGhost))
    {
       mNetFlags.clear(ScopeAlways);
+      NetScopeGrid::invalidateObject(this);
       Sim::getGhostAlwaysSet()->removeObject(this);
 
       // Un ghost this object from all the connections
@@ -182,16 +248,60 @@ void NetObject::clearScopeAlways()
    }
 }
 
+void NetObject::setScopePosition(const Point2F& position)
+{
+   mScopePosition = position;
+   mHasScopePosition = true;
+   NetScopeGrid::updateObject(this);
+}
+
+void NetObject::clearScopePosition()
+{
+   if(!mHasScopePosition)
+      return;
+
+   mHasScopePosition = false;
+   NetScopeGrid::updateObject(this);
+}
+
 bool NetObject::onAdd()
 {
    if(mNetFlags.test(ScopeAlways))
       setScopeAlways();
 
-   return Parent::onAdd();
+   if(!Parent::onAdd())
+      return false;
+
+   // Track ghostable server objects for scoping.
+   if(mNetFlags.test(Ghostable) && !mNetFlags.test(IsGhost))
+   {
+      NetScopeGrid::addObject(this);
+
+      // Track replicated fields for changes.
+      if(mpReplicatedLayout)
+      {
+         mpReplicatedLayout->quantize(this, mReplicatedSlots.address());
+         mReplicatedIndex = smReplicatedObjects.size();
+         smReplicatedObjects.push_back(this);
+      }
+   }
+
+   return true;
 }
 
 void NetObject::onRemove()
 {
+   NetScopeGrid::removeObject(this);
+
+   if(mReplicatedIndex != -1)
+   {
+      NetObject* last = smReplicatedObjects.last();
+      smReplicatedObjects[mReplicatedIndex] = last;
+      last->mReplicatedIndex = mReplicatedIndex;
+      smReplicatedObjects.pop_back();
+      mReplicatedIndex = -1;
+   }
+
    while(mFirstObjectRef)
       mFirstObjectRef->connection->detachObject(mFirstObjectRef);
 
@@ -200,9 +310,18 @@ void NetObject::onRemove()
 
 //-----------------------------------------------------------------------------
 
-F32 NetObject::getUpdatePriority(CameraScopeQuery*, U32, S32 updateSkips)
+F32 NetObject::getUpdatePriority(CameraScopeQuery* camInfo, U32, S32 updateSkips)
 {
-   return F32(updateSkips) * 0.1f;
+   F32 priority = F32(updateSkips) * 0.1f;
+
+   // Favor objects near the center of the scope area.
+   if(camInfo->scopeArea && mHasScopePosition && camInfo->visibleDistance > 0.0f)
+   {
+      const Point2F offset(mScopePosition.x - camInfo->pos.x, mScopePosition.y - camInfo->pos.y);
+      priority += getMax(0.0f, 1.0f - offset.len() / camInfo->visibleDistance);
+   }
+
+   return priority;
 }
 
 U32 NetObject::packUpdate(NetConnection* conn, U32 mask, BitStream* stream)
@@ -214,29 +333,12 @@ void NetObject::unpackUpdate(NetConnection*, BitStream*)
 {
 }
 
-void NetObject::onCameraScopeQuery(NetConnection *cr, CameraScopeQuery* /*camInfo*/)
+void NetObject::onCameraScopeQuery(NetConnection *cr, CameraScopeQuery *camInfo)
 {
    // default behavior -
-   // ghost everything that is ghostable
+   // ghost everything that is ghostable, limited to the scope area if there is one
 
-   for (SimSetIterator obj(Sim::getRootGroup()); *obj; ++obj)
-   {
-        NetObject* nobj = dynamic_cast<NetObject*>(*obj);
-        if (nobj)
-        {
-            AssertFatal(!nobj->mNetFlags.test(NetObject::Ghostable) || !nobj->mNetFlags.test(NetObject::IsGhost),
-               "NetObject::onCameraScopeQuery: object marked both ghostable and as ghost");
-
-            // Some objects don't ever want to be ghosted
-            if (!nobj->mNetFlags.test(NetObject::Ghostable))
-                continue;
-         if (!nobj->mNetFlags.test(NetObject::ScopeAlways))
-         {
-            // it's in scope...
-            cr->objectInScope(nobj);
-         }
-      }
-   }
+   NetScopeGrid::scopeObjects(cr, camInfo);
 }
 
 //-----------------------------------------------------------------------------
@@ -34,6 +34,8 @@
 //-----------------------------------------------------------------------------
 class NetConnection;
 class NetObject;
+class NetReplicatedLayout;
+struct NetScopeCell;
 
 //-----------------------------------------------------------------------------
 
@@ -46,6 +48,7 @@ struct CameraScopeQuery
    F32 sinFov;              ///< sin(fov/2);
    F32 cosFov;              ///< cos(fov/2);
    F32 visibleDistance;     ///< Visible distance.
+   bool scopeArea;          ///< Only objects within visibleDistance of pos in the xy plane are of interest.
 };
 
 struct GhostInfo;
@@ -223,6 +226,7 @@ class NetObject: public SimObject
    friend class  NetConnection;
    friend struct GhostInfo;
    friend class  NetworkProcessList;
+   friend class  NetScopeGrid;
 
    // Not the best way to do this, but the event needs access to mNetFlags
    friend class GhostAlwaysObjectEvent;
@@ -253,6 +257,28 @@ private:
    NetObject *mNextDirtyList;
 
    /// @}
+
+   /// @name Scope Grid
+   /// @{
+
+   Point2F mScopePosition;          ///< Position used for 2D interest management.
+   bool mHasScopePosition;          ///< Whether the object has a scope position.
+   NetScopeCell* mpScopeCell;       ///< Scope grid cell containing the object.
+   U32 mScopeCellIndex;             ///< Index of the object in its scope grid cell.
+
+   /// @}
+
+   /// @name Replicated Fields
+   /// @{
+
+   /// Server objects with replicated fields, checked for changes before updates are sent.
+   static Vector<NetObject*> smReplicatedObjects;
+
+   const NetReplicatedLayout* mpReplicatedLayout;  ///< Replicated fields of this class, if any.
+   Vector<U32> mReplicatedSlots;    ///< Quantized replicated fields as last seen (server) or received (ghost).
+   S32 mReplicatedIndex;            ///< Index of the object in the replicated object list.
+
+   /// @}
 protected:
 
    /// Pointer to the server object; used only when we are doing "short-circuited" networking.
@@ -279,11 +305,29 @@ protected:
       MaxNetFlagBit     =  15
    };
 
+   enum NetMasks
+   {
+      ReplicatedFieldsMask = BIT(31)   ///< Reserved for replicated fields on objects with a replicated layout.
+   };
+
    BitSet32 mNetFlags;              ///< Flag values from NetFlags
    U32 mNetIndex;                   ///< The index of this ghost in the GhostManager on the server.
 
    GhostInfo *mFirstObjectRef;      ///< Head of a linked list storing GhostInfos referencing this NetObject.
 
+   /// Declare the replicated fields of this object, usually from the constructor.
+   ///
+   /// Replicated fields are quantized and compared before each update is sent so
+   /// there is no need to call setMaskBits() when they change.  Changed fields are
+   /// written ahead of packUpdate(), as deltas where possible, using the
+   /// ReplicatedFieldsMask bit which packUpdate() will not see.
+   void setReplicatedLayout(const NetReplicatedLayout* pLayout);
+
+   /// Called on a ghost after replicated fields have been read, before unpackUpdate().
+   ///
+   /// @param   slotMask   Mask of the layout slots that changed.
+   virtual void onReplicatedFieldsChanged(U32 slotMask) {}
+
 public:
    NetObject();
    ~NetObject();
@@ -298,6 +342,9 @@ public:
 
    static void collapseDirtyList();
 
+   /// Mark server objects whose replicated fields changed as dirty.
+   static void updateReplicatedFields();
+
    /// Used to mark a bit as dirty; ie, that its corresponding set of fields need to be transmitted next update.
    ///
    /// @param   orMask   Bit(s) to set
@@ -321,10 +368,21 @@ public:
    /// all current active connections.
    void clearScopeAlways();
 
+   /// Set the position of the object used for 2D interest management.
+   ///
+   /// Connections whose scope object has a scope position and a scope distance
+   /// only scope objects near it.  Objects without a scope position are scoped
+   /// from anywhere.
+   void setScopePosition(const Point2F& position);
+   void clearScopePosition();
+   bool hasScopePosition() const { return mHasScopePosition; }
+   const Point2F& getScopePosition() const { return mScopePosition; }
+
    /// This returns a value which is used to prioritize which objects need to be updated.
    ///
    /// In NetObject, our returned priority is 0.1 * updateSkips, so that less recently
-   /// updated objects are more likely to be updated.
+   /// updated objects are more likely to be updated.  When the query describes an area
+   /// and the object has a scope position, objects nearer its center are favored.
    ///
    /// In subclasses, this can be adjusted. For instance, ShapeBase provides priority
    /// based on proximity to the camera.
@@ -359,12 +417,19 @@ public:
    /// how things should be scoped; basically, we tell it our field of view with camInfo,
    /// and have the opportunity to manually mark items as "in scope" as we see fit.
    ///
-   /// By default, we just mark all ghostable objects as in scope.
+   /// By default, we mark all ghostable objects as in scope, or only those in the
+   /// area described by camInfo if it has one.
    ///
    /// @param   cr         Net connection requesting scope information.
    /// @param   camInfo    Information about what this object can see.
    virtual void onCameraScopeQuery(NetConnection *cr, CameraScopeQuery *camInfo);
 
+   /// Replicated fields.
+   const NetReplicatedLayout* getReplicatedLayout() const { return mpReplicatedLayout; }
+   const U32* getReplicatedSlots() const { return mReplicatedSlots.address(); }
+   void readReplicatedFields(BitStream *stream);
+   void writeReplicatedFields(BitStream *stream);   ///< Write every replicated field in full.
+
    /// Get the ghost index of this object.
    U32 getNetIndex() { return mNetIndex; }
 
@@ -72,4 +72,39 @@ ConsoleMethodWithDocs( NetObject, getGhostID, ConsoleInt, 2, 2, ())
    return object->getNetIndex();
 }
 
+/*! Sets the position of the object used for 2D interest management.
+    Connections with a scope distance only scope objects near their scope object.
+    @param position The scope position as "x y".
+    @return No return value.
+    @sa clearScopePosition, NetConnection::setScopeDistance
+*/
+ConsoleMethodWithDocs( NetObject, setScopePosition, ConsoleVoid, 3, 3, ( position ))
+{
+   Point2F position( 0.0f, 0.0f );
+   dSscanf( argv[2], "%g %g", &position.x, &position.y );
+   object->setScopePosition( position );
+}
+
+/*! Removes the scope position so that the object is scoped from anywhere.
+    @return No return value.
+    @sa setScopePosition
+*/
+ConsoleMethodWithDocs( NetObject, clearScopePosition, ConsoleVoid, 2, 2, ())
+{
+   object->clearScopePosition();
+}
+
+/*! Gets the position of the object used for 2D interest management.
+    @return The scope position as "x y" or nothing if the object has no scope position.
+*/
+ConsoleMethodWithDocs( NetObject, getScopePosition, ConsoleString, 2, 2, ())
+{
+   if ( !object->hasScopePosition() )
+      return StringTable->EmptyString;
+
+   char* pBuffer = Con::getReturnBuffer( 64 );
+   dSprintf( pBuffer, 64, "%g %g", object->getScopePosition().x, object->getScopePosition().y );
+   return pBuffer;
+}
+
 ConsoleMethodGroupEndWithDocs(NetObject)
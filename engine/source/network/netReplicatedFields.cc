@@ -0,0 +1,452 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "network/netReplicatedFields.h"
+#include "io/bitStream.h"
+#include "math/mMath.h"
+#include "math/mPoint.h"
+#include "math/mRandom.h"
+#include "console/consoleTypes.h"
+
+#include "netReplicatedFields_ScriptBinding.h"
+
+//-----------------------------------------------------------------------------
+
+NetReplicatedLayout::NetReplicatedLayout()
+{
+   VECTOR_SET_ASSOCIATION( mFields );
+   VECTOR_SET_ASSOCIATION( mSlots );
+}
+
+//-----------------------------------------------------------------------------
+
+void NetReplicatedLayout::addField( const char* pName, const FieldType type, const dsize_t offset, const F32 min, const F32 max, const U32 slotCount, const U32 bits, const U32 deltaBits, const bool wraps )
+{
+   AssertFatal( mSlots.size() + slotCount <= MaxSlots, "NetReplicatedLayout::addField() - Too many replicated slots." );
+   AssertFatal( bits > 0 && bits <= MaxSlotBits, "NetReplicatedLayout::addField() - Invalid bit count." );
+
+   Field field;
+   field.mName = StringTable->insert( pName );
+   field.mType = type;
+   field.mOffset = offset;
+   field.mFirstSlot = (U32)mSlots.size();
+   field.mSlotCount = slotCount;
+   field.mMin = min;
+   field.mMax = max;
+   mFields.push_back( field );
+
+   // Deltas are only worth sending for multi-bit slots.  By default a delta covers about a third of the precision.
+   Slot slot;
+   slot.mBits = bits;
+   slot.mDeltaBits = bits < 4 ? 0 : getMin( deltaBits > 0 ? deltaBits : getMax( bits / 3 + 1, (U32)3 ), bits );
+   slot.mWraps = wraps;
+
+   for ( U32 i = 0; i < slotCount; i++ )
+      mSlots.push_back( slot );
+}
+
+//-----------------------------------------------------------------------------
+
+void NetReplicatedLayout::addBool( const char* pName, const dsize_t offset )
+{
+   addField( pName, FieldBool, offset, 0.0f, 1.0f, 1, 1, 0, false );
+}
+
+//-----------------------------------------------------------------------------
+
+void NetReplicatedLayout::addRangedS32( const char* pName, const dsize_t offset, const S32 min, const S32 max, const U32 deltaBits )
+{
+   AssertFatal( max > min, "NetReplicatedLayout::addRangedS32() - Invalid range." );
+
+   const U32 bits = getMax( getBinLog2( getNextPow2( U32(max - min) + 1 ) ), (U32)1 );
+   addField( pName, FieldRangedS32, offset, (F32)min, (F32)max, 1, bits, deltaBits, false );
+}
+
+//-----------------------------------------------------------------------------
+
+void NetReplicatedLayout::addRangedF32( const char* pName, const dsize_t offset, const F32 min, const F32 max, const U32 bits, const U32 deltaBits )
+{
+   AssertFatal( max > min, "NetReplicatedLayout::addRangedF32() - Invalid range." );
+
+   addField( pName, FieldRangedF32, offset, min, max, 1, bits, deltaBits, false );
+}
+
+//-----------------------------------------------------------------------------
+
+void NetReplicatedLayout::addAngle( const char* pName, const dsize_t offset, const U32 bits, const U32 deltaBits )
+{
+   addField( pName, FieldAngle, offset, 0.0f, M_2PI_F, 1, bits, deltaBits, true );
+}
+
+//-----------------------------------------------------------------------------
+
+void NetReplicatedLayout::addPoint2F( const char* pName, const dsize_t offset, const F32 min, const F32 max, const U32 bits, const U32 deltaBits )
+{
+   AssertFatal( max > min, "NetReplicatedLayout::addPoint2F() - Invalid range." );
+
+   addField( pName, FieldPoint2F, offset, min, max, 2, bits, deltaBits, false );
+}
+
+//-----------------------------------------------------------------------------
+
+inline U32 NetReplicatedLayout::quantizeF32( const F32 value, const F32 min, const F32 max, const U32 bits )
+{
+   const U32 steps = (1U << bits) - 1;
+   const F32 unit = (mClampF( value, min, max ) - min) / (max - min);
+   return getMin( (U32)(unit * (F32)steps + 0.5f), steps );
+}
+
+//-----------------------------------------------------------------------------
+
+inline F32 NetReplicatedLayout::dequantizeF32( const U32 value, const F32 min, const F32 max, const U32 bits )
+{
+   const U32 steps = (1U << bits) - 1;
+   return min + (max - min) * ((F32)value / (F32)steps);
+}
+
+//-----------------------------------------------------------------------------
+
+void NetReplicatedLayout::quantize( const void* pObject, U32* pSlots ) const
+{
+   const U8* pBase = (const U8*)pObject;
+
+   for ( U32 i = 0; i < (U32)mFields.size(); i++ )
+   {
+      const Field& field = mFields[i];
+      const U32 bits = mSlots[field.mFirstSlot].mBits;
+      const U8* pValue = pBase + field.mOffset;
+      U32* pSlot = pSlots + field.mFirstSlot;
+
+      switch( field.mType )
+      {
+         case FieldBool:
+            *pSlot = *(const bool*)pValue ? 1 : 0;
+            break;
+
+         case FieldRangedS32:
+            *pSlot = U32( mClamp( *(const S32*)pValue, (S32)field.mMin, (S32)field.mMax ) - (S32)field.mMin );
+            break;
+
+         case FieldRangedF32:
+            *pSlot = quantizeF32( *(const F32*)pValue, field.mMin, field.mMax, bits );
+            break;
+
+         case FieldAngle:
+            {
+               // Angles wrap so the last step is the same as the first.
+               const U32 range = 1U << bits;
+               F32 angle = mFmod( *(const F32*)pValue, M_2PI_F );
+               if ( angle < 0.0f )
+                  angle += M_2PI_F;
+               *pSlot = U32( angle / M_2PI_F * (F32)range + 0.5f ) & (range - 1);
+            }
+            break;
+
+         case FieldPoint2F:
+            {
+               const Point2F& point = *(const Point2F*)pValue;
+               pSlot[0] = quantizeF32( point.x, field.mMin, field.mMax, bits );
+               pSlot[1] = quantizeF32( point.y, field.mMin, field.mMax, bits );
+            }
+            break;
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void NetReplicatedLayout::dequantize( const U32* pSlots, void* pObject, const U32 slotMask ) const
+{
+   U8* pBase = (U8*)pObject;
+
+   for ( U32 i = 0; i < (U32)mFields.size(); i++ )
+   {
+      const Field& field = mFields[i];
+
+      // Only touch fields with a slot that was received.
+      const U32 fieldMask = ((1U << field.mSlotCount) - 1) << field.mFirstSlot;
+      if ( (slotMask & fieldMask) == 0 )
+         continue;
+
+      const U32 bits = mSlots[field.mFirstSlot].mBits;
+      const U32* pSlot = pSlots + field.mFirstSlot;
+      U8* pValue = pBase + field.mOffset;
+
+      switch( field.mType )
+      {
+         case FieldBool:
+            *(bool*)pValue = *pSlot != 0;
+            break;
+
+         case FieldRangedS32:
+            *(S32*)pValue = (S32)field.mMin + (S32)*pSlot;
+            break;
+
+         case FieldRangedF32:
+            *(F32*)pValue = dequantizeF32( *pSlot, field.mMin, field.mMax, bits );
+            break;
+
+         case FieldAngle:
+            *(F32*)pValue = (F32)*pSlot * M_2PI_F / (F32)(1U << bits);
+            break;
+
+         case FieldPoint2F:
+            {
+               Point2F& point = *(Point2F*)pValue;
+               point.x = dequantizeF32( pSlot[0], field.mMin, field.mMax, bits );
+               point.y = dequantizeF32( pSlot[1], field.mMin, field.mMax, bits );
+            }
+            break;
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+U32 NetReplicatedLayout::getRawBitCount( void ) const
+{
+   U32 bitCount = 0;
+
+   for ( U32 i = 0; i < (U32)mFields.size(); i++ )
+   {
+      const Field& field = mFields[i];
+      bitCount += 1 + (field.mType == FieldBool ? 1 : 32 * field.mSlotCount);
+   }
+
+   return bitCount;
+}
+
+//-----------------------------------------------------------------------------
+
+NetReplicatedState::NetReplicatedState() :
+   mBaselineMask( 0 ),
+   mInFlightMask( 0 ),
+   mSequence( 0 ),
+   mFirstSequence( 0 )
+{
+   VECTOR_SET_ASSOCIATION( mBaseline );
+   VECTOR_SET_ASSOCIATION( mLastSent );
+   VECTOR_SET_ASSOCIATION( mLastSentSequence );
+}
+
+//-----------------------------------------------------------------------------
+
+void NetReplicatedState::reset( void )
+{
+   mBaselineMask = 0;
+   mInFlightMask = 0;
+   mFirstSequence = mSequence + 1;
+}
+
+//-----------------------------------------------------------------------------
+
+NetReplicatedPacket* NetReplicatedState::write( const NetReplicatedLayout& layout, const U32* pCurrent, BitStream* pStream )
+{
+   const U32 slotCount = layout.getSlotCount();
+   if ( (U32)mBaseline.size() != slotCount )
+   {
+      mBaseline.setSize( slotCount );
+      mLastSent.setSize( slotCount );
+      mLastSentSequence.setSize( slotCount );
+      mBaselineMask = 0;
+      mInFlightMask = 0;
+   }
+
+   // Find the slots the receiver might not have.
+   U32 sendMask = 0;
+   for ( U32 i = 0; i < slotCount; i++ )
+   {
+      const U32 bit = 1U << i;
+
+      if ( mInFlightMask & bit )
+      {
+         if ( mLastSent[i] != pCurrent[i] )
+            sendMask |= bit;
+      }
+      else if ( !(mBaselineMask & bit) || mBaseline[i] != pCurrent[i] )
+      {
+         sendMask |= bit;
+      }
+   }
+
+   if ( !pStream->writeFlag( sendMask != 0 ) )
+      return NULL;
+
+   mSequence++;
+
+   NetReplicatedPacket* pPacket = new NetReplicatedPacket;
+   pPacket->mSequence = mSequence;
+   pPacket->mSlotMask = sendMask;
+
+   for ( U32 i = 0; i < slotCount; i++ )
+   {
+      const U32 bit = 1U << i;
+      if ( !pStream->writeFlag( (sendMask & bit) != 0 ) )
+         continue;
+
+      const NetReplicatedLayout::Slot& slot = layout.getSlot( i );
+      const U32 value = pCurrent[i];
+
+      if ( slot.mDeltaBits > 0 )
+      {
+         // The receiver holds the baseline when nothing is in flight so a delta can be sent against it.
+         bool sendDelta = false;
+         S32 delta = 0;
+         if ( (mBaselineMask & bit) && !(mInFlightMask & bit) )
+         {
+            if ( slot.mWraps )
+            {
+               const U32 range = 1U << slot.mBits;
+               delta = (S32)((value - mBaseline[i]) & (range - 1));
+               if ( delta >= (S32)(range >> 1) )
+                  delta -= (S32)range;
+            }
+            else
+            {
+               delta = (S32)value - (S32)mBaseline[i];
+            }
+
+            const S32 deltaLimit = 1 << (slot.mDeltaBits - 1);
+            sendDelta = delta > -deltaLimit && delta < deltaLimit;
+         }
+
+         if ( pStream->writeFlag( sendDelta ) )
+         {
+            pStream->writeSignedInt( delta, slot.mDeltaBits );
+         }
+         else
+         {
+            pStream->writeInt( (S32)value, slot.mBits );
+         }
+      }
+      else
+      {
+         pStream->writeInt( (S32)value, slot.mBits );
+      }
+
+      pPacket->mValues.push_back( value );
+      mLastSent[i] = value;
+      mLastSentSequence[i] = mSequence;
+      mInFlightMask |= bit;
+   }
+
+   return pPacket;
+}
+
+//-----------------------------------------------------------------------------
+
+void NetReplicatedState::packetReceived( const NetReplicatedPacket* pPacket )
+{
+   if ( pPacket->mSequence < mFirstSequence )
+      return;
+
+   U32 valueIndex = 0;
+   for ( U32 i = 0; i < (U32)mBaseline.size(); i++ )
+   {
+      const U32 bit = 1U << i;
+      if ( !(pPacket->mSlotMask & bit) )
+         continue;
+
+      // Notifications arrive in order so this is the newest value the receiver has.
+      mBaseline[i] = pPacket->mValues[valueIndex++];
+      mBaselineMask |= bit;
+
+      if ( mLastSentSequence[i] == pPacket->mSequence )
+         mInFlightMask &= ~bit;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+bool NetReplicatedState::packetDropped( const NetReplicatedPacket* pPacket, const U32* pCurrent )
+{
+   if ( pPacket->mSequence < mFirstSequence )
+      return false;
+
+   bool resend = false;
+   for ( U32 i = 0; i < (U32)mBaseline.size(); i++ )
+   {
+      const U32 bit = 1U << i;
+      if ( !(pPacket->mSlotMask & bit) || mLastSentSequence[i] != pPacket->mSequence )
+         continue;
+
+      // The most recent value was lost so the receiver still holds the baseline.
+      mInFlightMask &= ~bit;
+      if ( !(mBaselineMask & bit) || mBaseline[i] != pCurrent[i] )
+         resend = true;
+   }
+
+   return resend;
+}
+
+//-----------------------------------------------------------------------------
+
+void NetReplicatedState::writeAll( const NetReplicatedLayout& layout, const U32* pSlots, BitStream* pStream )
+{
+   if ( !pStream->writeFlag( layout.getSlotCount() > 0 ) )
+      return;
+
+   for ( U32 i = 0; i < layout.getSlotCount(); i++ )
+   {
+      const NetReplicatedLayout::Slot& slot = layout.getSlot( i );
+
+      pStream->writeFlag( true );
+      if ( slot.mDeltaBits > 0 )
+         pStream->writeFlag( false );
+      pStream->writeInt( (S32)pSlots[i], slot.mBits );
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+U32 NetReplicatedState::read( const NetReplicatedLayout& layout, U32* pSlots, BitStream* pStream )
+{
+   if ( !pStream->readFlag() )
+      return 0;
+
+   U32 readMask = 0;
+   for ( U32 i = 0; i < layout.getSlotCount(); i++ )
+   {
+      if ( !pStream->readFlag() )
+         continue;
+
+      const NetReplicatedLayout::Slot& slot = layout.getSlot( i );
+
+      if ( slot.mDeltaBits > 0 && pStream->readFlag() )
+      {
+         const S32 delta = pStream->readSignedInt( slot.mDeltaBits );
+         if ( slot.mWraps )
+            pSlots[i] = (pSlots[i] + (U32)delta) & ((1U << slot.mBits) - 1);
+         else
+            pSlots[i] = (U32)((S32)pSlots[i] + delta);
+      }
+      else
+      {
+         pSlots[i] = (U32)pStream->readInt( slot.mBits );
+      }
+
+      readMask |= 1U << i;
+   }
+
+   return readMask;
+}
@@ -0,0 +1,178 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _NETREPLICATEDFIELDS_H_
+#define _NETREPLICATEDFIELDS_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+#ifndef _STRINGTABLE_H_
+#include "string/stringTable.h"
+#endif
+
+class BitStream;
+
+//-----------------------------------------------------------------------------
+
+/// A declarative description of the state a NetObject class replicates.
+///
+/// Fields are declared once per class, usually in initPersistFields(), by
+/// offset in the same way as persistent fields.  Each field is quantized into
+/// one or two slots of at most 31 bits:
+///
+/// @code
+///    smReplicatedLayout.addPoint2F( "position", Offset(mPosition, MyObject), -1000.0f, 1000.0f, 20 );
+///    smReplicatedLayout.addAngle( "angle", Offset(mAngle, MyObject), 10 );
+///    smReplicatedLayout.addRangedS32( "health", Offset(mHealth, MyObject), 0, 100 );
+/// @endcode
+///
+/// A layout can hold up to MaxSlots slots.
+class NetReplicatedLayout
+{
+public:
+   enum Constants
+   {
+      MaxSlots = 32,
+      MaxSlotBits = 31,
+   };
+
+   enum FieldType
+   {
+      FieldBool,
+      FieldRangedS32,
+      FieldRangedF32,
+      FieldAngle,
+      FieldPoint2F,
+   };
+
+   struct Field
+   {
+      StringTableEntry  mName;
+      FieldType         mType;
+      dsize_t           mOffset;
+      U32               mFirstSlot;
+      U32               mSlotCount;
+      F32               mMin;
+      F32               mMax;
+   };
+
+   struct Slot
+   {
+      U32               mBits;
+      U32               mDeltaBits;
+      bool              mWraps;
+   };
+
+private:
+   Vector<Field>        mFields;
+   Vector<Slot>         mSlots;
+
+   void                 addField( const char* pName, const FieldType type, const dsize_t offset, const F32 min, const F32 max, const U32 slotCount, const U32 bits, const U32 deltaBits, const bool wraps );
+
+   static inline U32    quantizeF32( const F32 value, const F32 min, const F32 max, const U32 bits );
+   static inline F32    dequantizeF32( const U32 value, const F32 min, const F32 max, const U32 bits );
+
+public:
+   NetReplicatedLayout();
+
+   /// Field declaration.  A delta bit count of zero picks one from the field's precision.
+   void                 addBool( const char* pName, const dsize_t offset );
+   void                 addRangedS32( const char* pName, const dsize_t offset, const S32 min, const S32 max, const U32 deltaBits = 0 );
+   void                 addRangedF32( const char* pName, const dsize_t offset, const F32 min, const F32 max, const U32 bits, const U32 deltaBits = 0 );
+   void                 addAngle( const char* pName, const dsize_t offset, const U32 bits, const U32 deltaBits = 0 );
+   void                 addPoint2F( const char* pName, const dsize_t offset, const F32 min, const F32 max, const U32 bits, const U32 deltaBits = 0 );
+
+   inline U32           getFieldCount( void ) const                 { return (U32)mFields.size(); }
+   inline const Field&  getField( const U32 index ) const           { return mFields[index]; }
+   inline U32           getSlotCount( void ) const                  { return (U32)mSlots.size(); }
+   inline const Slot&   getSlot( const U32 index ) const            { return mSlots[index]; }
+
+   /// Convert between an object's fields and their quantized slots.
+   void                 quantize( const void* pObject, U32* pSlots ) const;
+   void                 dequantize( const U32* pSlots, void* pObject, const U32 slotMask ) const;
+
+   /// Bits needed to send every field at full precision with a flag each.
+   U32                  getRawBitCount( void ) const;
+};
+
+//-----------------------------------------------------------------------------
+
+/// The slots sent in one packet.
+struct NetReplicatedPacket
+{
+   U32                  mSequence;
+   U32                  mSlotMask;
+   Vector<U32>          mValues;
+};
+
+//-----------------------------------------------------------------------------
+
+/// What one connection knows about one object's replicated fields.
+///
+/// A slot is sent only when the receiver can't already have its current value.
+/// The baseline is the last value the receiver acknowledged.  While the most
+/// recent value sent for a slot is in flight, the slot is not sent again unless
+/// it changes.  Once nothing is in flight the receiver's value is the baseline,
+/// so small changes are sent as a delta against it.
+class NetReplicatedState
+{
+private:
+   Vector<U32>          mBaseline;
+   Vector<U32>          mLastSent;
+   Vector<U32>          mLastSentSequence;
+   U32                  mBaselineMask;
+   U32                  mInFlightMask;
+   U32                  mSequence;
+   U32                  mFirstSequence;
+
+public:
+   NetReplicatedState();
+
+   /// Forget what the receiver has, e.g. when the object is ghosted again.
+   /// Records of packets sent before the reset are ignored.
+   void                 reset( void );
+
+   /// Write the slots the receiver needs.  Returns the packet record to be
+   /// passed back on delivery or loss, or NULL if nothing was sent.
+   NetReplicatedPacket* write( const NetReplicatedLayout& layout, const U32* pCurrent, BitStream* pStream );
+
+   /// Notification that a packet arrived.
+   void                 packetReceived( const NetReplicatedPacket* pPacket );
+
+   /// Notification that a packet was lost.  Returns whether anything must be sent again.
+   bool                 packetDropped( const NetReplicatedPacket* pPacket, const U32* pCurrent );
+
+   /// Write every slot in full without reference to any state.
+   static void          writeAll( const NetReplicatedLayout& layout, const U32* pSlots, BitStream* pStream );
+
+   /// Read slots written by write() or writeAll() into the receiver's slots.  Returns the mask of slots read.
+   static U32           read( const NetReplicatedLayout& layout, U32* pSlots, BitStream* pStream );
+};
+
+#endif // _NETREPLICATEDFIELDS_H_
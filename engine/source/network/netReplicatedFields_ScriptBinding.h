@@ -0,0 +1,195 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+/*! @addtogroup Network Network
+	@ingroup TorqueScriptFunctions
+	@{
+*/
+
+/*! Measures replicated field bandwidth by streaming simulated objects over an in-process loopback link.
+    Each tick, every object moves and turns while a few change their other fields.  Their replicated fields are written to a packet that is delivered, or lost, after a fixed latency and read back into a mirror of each object.
+    @param objectCount The number of objects to simulate.
+    @param tickCount The number of ticks to simulate.
+    @param lossPercent The percentage of packets lost.  Optional, defaults to 0.
+    @param movingPercent The percentage of objects moving each tick.  Optional, defaults to 100.
+    @return Returns the average bits sent per object per tick, the bits needed to send every field in full and the number of fields the receiver got wrong, separated by spaces.
+*/
+ConsoleFunctionWithDocs( netReplicationBenchmark, ConsoleString, 3, 5, (objectCount, tickCount, [lossPercent], [movingPercent]))
+{
+   struct BenchmarkObject
+   {
+      Point2F  mPosition;
+      F32      mAngle;
+      S32      mHealth;
+      bool     mActive;
+   };
+
+   struct BenchmarkPacket
+   {
+      Vector<U8>                    mData;
+      bool                          mLost;
+      Vector<NetReplicatedPacket*>  mRecords;
+   };
+
+   const U32 objectCount = getMax( dAtoi(argv[1]), 1 );
+   const U32 tickCount = getMax( dAtoi(argv[2]), 1 );
+   const F32 lossPercent = argc > 3 ? mClampF( dAtof(argv[3]), 0.0f, 100.0f ) : 0.0f;
+   const F32 movingPercent = argc > 4 ? mClampF( dAtof(argv[4]), 0.0f, 100.0f ) : 100.0f;
+   const U32 latency = 3;
+
+   NetReplicatedLayout layout;
+   layout.addPoint2F( "position", Offset(mPosition, BenchmarkObject), -1000.0f, 1000.0f, 20 );
+   layout.addAngle( "angle", Offset(mAngle, BenchmarkObject), 10 );
+   layout.addRangedS32( "health", Offset(mHealth, BenchmarkObject), 0, 100 );
+   layout.addBool( "active", Offset(mActive, BenchmarkObject) );
+
+   const U32 slotCount = layout.getSlotCount();
+   const U32 packetSize = objectCount * (layout.getRawBitCount() + slotCount * 2 + 8) / 8 + 16;
+
+   RandomLCG random( 0x5eed );
+
+   Vector<BenchmarkObject> objects;
+   Vector<Point2F> velocities;
+   Vector<U32> senderSlots;
+   Vector<U32> receiverSlots;
+   Vector<NetReplicatedState> states;
+   objects.setSize( objectCount );
+   velocities.setSize( objectCount );
+   senderSlots.setSize( objectCount * slotCount );
+   receiverSlots.setSize( objectCount * slotCount );
+   states.setSize( objectCount );
+
+   for ( U32 i = 0; i < objectCount; i++ )
+   {
+      BenchmarkObject& object = objects[i];
+      object.mPosition.set( random.randRangeF( -900.0f, 900.0f ), random.randRangeF( -900.0f, 900.0f ) );
+      object.mAngle = random.randRangeF( 0.0f, M_2PI_F );
+      object.mHealth = 100;
+      object.mActive = true;
+      velocities[i].set( random.randRangeF( -0.5f, 0.5f ), random.randRangeF( -0.5f, 0.5f ) );
+      constructInPlace( &states[i] );
+      dMemset( &receiverSlots[i * slotCount], 0, slotCount * sizeof(U32) );
+   }
+
+   Vector<BenchmarkPacket*> inFlight;
+   U32 totalBits = 0;
+
+   // Run the measured ticks then enough quiet, lossless ticks for everything to arrive.
+   const U32 settleTicks = latency * 4;
+   for ( U32 tick = 0; tick < tickCount + settleTicks; tick++ )
+   {
+      const bool measuring = tick < tickCount;
+
+      if ( measuring )
+      {
+         for ( U32 i = 0; i < objectCount; i++ )
+         {
+            BenchmarkObject& object = objects[i];
+            if ( random.randF() * 100.0f < movingPercent )
+            {
+               object.mPosition += velocities[i];
+               object.mAngle = mFmod( object.mAngle + 0.02f, M_2PI_F );
+            }
+            if ( random.randI() % 100 == 0 )
+               object.mHealth = random.randRangeI( 0, 100 );
+            if ( random.randI() % 500 == 0 )
+               object.mActive = !object.mActive;
+         }
+      }
+
+      BenchmarkPacket* pPacket = new BenchmarkPacket;
+      pPacket->mData.setSize( packetSize );
+      pPacket->mLost = measuring && random.randF() * 100.0f < lossPercent;
+      pPacket->mRecords.setSize( objectCount );
+
+      BitStream stream( pPacket->mData.address(), packetSize );
+      for ( U32 i = 0; i < objectCount; i++ )
+      {
+         U32* pSlots = &senderSlots[i * slotCount];
+         layout.quantize( &objects[i], pSlots );
+         pPacket->mRecords[i] = states[i].write( layout, pSlots, &stream );
+      }
+
+      if ( measuring )
+         totalBits += stream.getCurPos();
+
+      inFlight.push_back( pPacket );
+
+      // Deliver or lose the oldest packet once it has been in flight long enough.
+      if ( (U32)inFlight.size() > latency || !measuring )
+      {
+         BenchmarkPacket* pArrived = inFlight.first();
+         inFlight.pop_front();
+
+         BitStream arrivedStream( pArrived->mData.address(), packetSize );
+         for ( U32 i = 0; i < objectCount; i++ )
+         {
+            if ( !pArrived->mLost )
+               NetReplicatedState::read( layout, &receiverSlots[i * slotCount], &arrivedStream );
+
+            NetReplicatedPacket* pRecord = pArrived->mRecords[i];
+            if ( pRecord == NULL )
+               continue;
+
+            if ( pArrived->mLost )
+               states[i].packetDropped( pRecord, &senderSlots[i * slotCount] );
+            else
+               states[i].packetReceived( pRecord );
+
+            delete pRecord;
+         }
+
+         delete pArrived;
+      }
+   }
+
+   for ( U32 i = 0; i < (U32)inFlight.size(); i++ )
+   {
+      for ( U32 j = 0; j < objectCount; j++ )
+         delete inFlight[i]->mRecords[j];
+      delete inFlight[i];
+   }
+
+   for ( U32 i = 0; i < objectCount; i++ )
+      destructInPlace( &states[i] );
+
+   U32 mismatches = 0;
+   for ( U32 i = 0; i < objectCount * slotCount; i++ )
+   {
+      if ( senderSlots[i] != receiverSlots[i] )
+         mismatches++;
+   }
+
+   const F32 bitsPerUpdate = F32(totalBits) / F32(objectCount * tickCount);
+   const U32 rawBits = layout.getRawBitCount();
+
+   Con::printf( "Replicated Field Benchmark: %d objects, %d ticks, %g%% loss, %g%% moving", objectCount, tickCount, lossPercent, movingPercent );
+   Con::printf( "  Bits per object per tick: %.2f (%d unquantized, %.1f%%)", bitsPerUpdate, rawBits, 100.0f * bitsPerUpdate / F32(rawBits) );
+   Con::printf( "  Receiver mismatches: %d", mismatches );
+
+   char* pBuffer = Con::getReturnBuffer( 64 );
+   dSprintf( pBuffer, 64, "%g %d %d", bitsPerUpdate, rawBits, mismatches );
+   return pBuffer;
+}
+
+/*! @} */ // end group Network
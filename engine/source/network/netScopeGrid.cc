@@ -0,0 +1,313 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "network/netScopeGrid.h"
+#include "network/netConnection.h"
+#include "network/netObject.h"
+#include "console/consoleTypes.h"
+
+//-----------------------------------------------------------------------------
+
+NetScopeGrid::typeCellHash NetScopeGrid::smCells;
+NetScopeCell NetScopeGrid::smUnboundedCell;
+F32 NetScopeGrid::smActiveCellSize = 0.0f;
+U32 NetScopeGrid::smSequence = 0;
+F32 NetScopeGrid::smCellSize = 32.0f;
+
+//-----------------------------------------------------------------------------
+
+void NetScopeGrid::create()
+{
+   Con::addVariable( "$pref::Net::scopeCellSize", TypeF32, &smCellSize );
+
+   smUnboundedCell.mX = 0;
+   smUnboundedCell.mY = 0;
+   smUnboundedCell.mSequence = 0;
+   smActiveCellSize = smCellSize;
+}
+
+//-----------------------------------------------------------------------------
+
+void NetScopeGrid::destroy()
+{
+   for ( typeCellHash::iterator itr = smCells.begin(); itr != smCells.end(); ++itr )
+      delete itr->value;
+
+   smCells.clear();
+   smUnboundedCell.mObjects.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+NetScopeCell* NetScopeGrid::findCell( const S32 x, const S32 y, const bool create )
+{
+   const U32 key = getCellKey( x, y );
+
+   // Matching keys are grouped together.
+   for ( typeCellHash::iterator itr = smCells.find( key ); itr != smCells.end() && itr->key == key; ++itr )
+   {
+      if ( itr->value->mX == x && itr->value->mY == y )
+         return itr->value;
+   }
+
+   if ( !create )
+      return NULL;
+
+   NetScopeCell* pCell = new NetScopeCell;
+   pCell->mX = x;
+   pCell->mY = y;
+   pCell->mSequence = 0;
+   smCells.insertEqual( key, pCell );
+   return pCell;
+}
+
+//-----------------------------------------------------------------------------
+
+S32 NetScopeGrid::getCellCoord( const F32 position )
+{
+   return (S32)mClampF( mFloor( position / smActiveCellSize ), (F32)-MaxCellCoord, (F32)MaxCellCoord );
+}
+
+//-----------------------------------------------------------------------------
+
+U32 NetScopeGrid::getRegionCellCount( const Region& region )
+{
+   if ( !region.mBounded )
+      return U32_MAX;
+
+   const U64 regionCells = (U64)((S64)region.mMaxX - region.mMinX + 1) * (U64)((S64)region.mMaxY - region.mMinY + 1);
+   return regionCells > (U64)U32_MAX ? U32_MAX : (U32)regionCells;
+}
+
+//-----------------------------------------------------------------------------
+
+NetScopeCell* NetScopeGrid::getObjectCell( NetObject* pObject )
+{
+   if ( !pObject->mHasScopePosition )
+      return &smUnboundedCell;
+
+   return findCell( getCellCoord( pObject->mScopePosition.x ), getCellCoord( pObject->mScopePosition.y ), true );
+}
+
+//-----------------------------------------------------------------------------
+
+void NetScopeGrid::insertObject( NetObject* pObject, NetScopeCell* pCell )
+{
+   pObject->mpScopeCell = pCell;
+   pObject->mScopeCellIndex = (U32)pCell->mObjects.size();
+   pCell->mObjects.push_back( pObject );
+   pCell->mSequence = ++smSequence;
+}
+
+//-----------------------------------------------------------------------------
+
+void NetScopeGrid::extractObject( NetObject* pObject )
+{
+   NetScopeCell* pCell = pObject->mpScopeCell;
+
+   // Swap the last object into the vacated slot.
+   NetObject* pLastObject = pCell->mObjects.last();
+   pCell->mObjects[pObject->mScopeCellIndex] = pLastObject;
+   pLastObject->mScopeCellIndex = pObject->mScopeCellIndex;
+   pCell->mObjects.decrement();
+   pCell->mSequence = ++smSequence;
+
+   pObject->mpScopeCell = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void NetScopeGrid::rebuild()
+{
+   // Gather the positioned objects.
+   Vector<NetObject*> objects;
+   for ( typeCellHash::iterator itr = smCells.begin(); itr != smCells.end(); ++itr )
+   {
+      NetScopeCell* pCell = itr->value;
+      for ( U32 i = 0; i < (U32)pCell->mObjects.size(); i++ )
+         objects.push_back( pCell->mObjects[i] );
+      delete pCell;
+   }
+   smCells.clear();
+
+   // Reject a cell size that would swamp the grid.
+   if ( smCellSize < 1.0f )
+      smCellSize = 1.0f;
+   smActiveCellSize = smCellSize;
+
+   for ( U32 i = 0; i < (U32)objects.size(); i++ )
+      insertObject( objects[i], getObjectCell( objects[i] ) );
+
+   // Every connection must scope again.
+   smUnboundedCell.mSequence = ++smSequence;
+}
+
+//-----------------------------------------------------------------------------
+
+void NetScopeGrid::addObject( NetObject* pObject )
+{
+   AssertFatal( pObject->mpScopeCell == NULL, "NetScopeGrid::addObject() - Object is already in the grid." );
+
+   // Apply any change of cell size before placing the object.
+   if ( smActiveCellSize != smCellSize )
+      rebuild();
+
+   insertObject( pObject, getObjectCell( pObject ) );
+}
+
+//-----------------------------------------------------------------------------
+
+void NetScopeGrid::removeObject( NetObject* pObject )
+{
+   if ( pObject->mpScopeCell != NULL )
+      extractObject( pObject );
+}
+
+//-----------------------------------------------------------------------------
+
+void NetScopeGrid::updateObject( NetObject* pObject )
+{
+   if ( pObject->mpScopeCell == NULL )
+      return;
+
+   if ( smActiveCellSize != smCellSize )
+      rebuild();
+
+   // Scope is resolved per cell so moving within a cell changes nothing.
+   NetScopeCell* pCell = getObjectCell( pObject );
+   if ( pCell == pObject->mpScopeCell )
+      return;
+
+   extractObject( pObject );
+   insertObject( pObject, pCell );
+}
+
+//-----------------------------------------------------------------------------
+
+void NetScopeGrid::invalidateObject( NetObject* pObject )
+{
+   if ( pObject->mpScopeCell != NULL )
+      pObject->mpScopeCell->mSequence = ++smSequence;
+}
+
+//-----------------------------------------------------------------------------
+
+void NetScopeGrid::getRegion( const CameraScopeQuery* pCamInfo, Region& region )
+{
+   region.mBounded = pCamInfo->scopeArea;
+
+   // An unbounded query sees every change.
+   if ( !region.mBounded )
+   {
+      region.mMinX = region.mMinY = region.mMaxX = region.mMaxY = 0;
+      region.mSequence = smSequence;
+      return;
+   }
+
+   if ( smActiveCellSize != smCellSize )
+      rebuild();
+
+   const F32 distance = pCamInfo->visibleDistance;
+   region.mMinX = getCellCoord( pCamInfo->pos.x - distance );
+   region.mMinY = getCellCoord( pCamInfo->pos.y - distance );
+   region.mMaxX = getCellCoord( pCamInfo->pos.x + distance );
+   region.mMaxY = getCellCoord( pCamInfo->pos.y + distance );
+   region.mSequence = smUnboundedCell.mSequence;
+
+   const U32 regionCells = getRegionCellCount( region );
+   if ( regionCells <= smCells.size() )
+   {
+      for ( S32 y = region.mMinY; y <= region.mMaxY; y++ )
+      {
+         for ( S32 x = region.mMinX; x <= region.mMaxX; x++ )
+         {
+            const NetScopeCell* pCell = findCell( x, y, false );
+            if ( pCell != NULL && pCell->mSequence > region.mSequence )
+               region.mSequence = pCell->mSequence;
+         }
+      }
+   }
+   else
+   {
+      // The region is larger than the occupied grid so visit the cells instead.
+      for ( typeCellHash::iterator itr = smCells.begin(); itr != smCells.end(); ++itr )
+      {
+         const NetScopeCell* pCell = itr->value;
+         if ( pCell->mX >= region.mMinX && pCell->mX <= region.mMaxX &&
+              pCell->mY >= region.mMinY && pCell->mY <= region.mMaxY &&
+              pCell->mSequence > region.mSequence )
+            region.mSequence = pCell->mSequence;
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void NetScopeGrid::scopeCell( NetConnection* pConnection, const NetScopeCell* pCell )
+{
+   for ( U32 i = 0; i < (U32)pCell->mObjects.size(); i++ )
+   {
+      NetObject* pObject = pCell->mObjects[i];
+
+      // Objects that always scope are handled by the connection.
+      if ( pObject->mNetFlags.test( NetObject::ScopeAlways ) )
+         continue;
+
+      pConnection->scopeObject( pObject );
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void NetScopeGrid::scopeObjects( NetConnection* pConnection, const CameraScopeQuery* pCamInfo )
+{
+   scopeCell( pConnection, &smUnboundedCell );
+
+   Region region;
+   if ( pCamInfo->scopeArea )
+      getRegion( pCamInfo, region );
+
+   const U32 regionCells = getRegionCellCount( region );
+   if ( regionCells <= smCells.size() )
+   {
+      for ( S32 y = region.mMinY; y <= region.mMaxY; y++ )
+      {
+         for ( S32 x = region.mMinX; x <= region.mMaxX; x++ )
+         {
+            const NetScopeCell* pCell = findCell( x, y, false );
+            if ( pCell != NULL )
+               scopeCell( pConnection, pCell );
+         }
+      }
+      return;
+   }
+
+   for ( typeCellHash::iterator itr = smCells.begin(); itr != smCells.end(); ++itr )
+   {
+      const NetScopeCell* pCell = itr->value;
+      if ( !region.mBounded ||
+           ( pCell->mX >= region.mMinX && pCell->mX <= region.mMaxX &&
+             pCell->mY >= region.mMinY && pCell->mY <= region.mMaxY ) )
+         scopeCell( pConnection, pCell );
+   }
+}
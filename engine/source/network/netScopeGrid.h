@@ -0,0 +1,143 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _NETSCOPEGRID_H_
+#define _NETSCOPEGRID_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+#ifndef _HASHTABLE_H
+#include "collection/hashTable.h"
+#endif
+
+#ifndef _MPOINT_H_
+#include "math/mPoint.h"
+#endif
+
+class NetObject;
+class NetConnection;
+struct CameraScopeQuery;
+
+//-----------------------------------------------------------------------------
+
+/// A cell of the scope grid.
+struct NetScopeCell
+{
+   S32 mX;
+   S32 mY;
+   Vector<NetObject*> mObjects;
+
+   /// Sequence of the last change to the cell's membership.
+   U32 mSequence;
+};
+
+//-----------------------------------------------------------------------------
+
+/// A uniform 2D grid of the ghostable server objects, used for interest management.
+///
+/// An object that has a scope position lives in the cell containing that position,
+/// otherwise it lives in an unbounded cell that is visible from anywhere.  Scope
+/// queries that describe an area only visit the cells that overlap it.
+///
+/// Every change to a cell's membership is stamped with a sequence number so that a
+/// connection can tell that nothing visible to it has changed since its last scope
+/// query and keep its current scope.
+class NetScopeGrid
+{
+public:
+   /// The cells a scope query covers and the last change to any of them.
+   struct Region
+   {
+      bool mBounded;
+      S32 mMinX;
+      S32 mMinY;
+      S32 mMaxX;
+      S32 mMaxY;
+      U32 mSequence;
+
+      Region() : mBounded(false), mMinX(0), mMinY(0), mMaxX(0), mMaxY(0), mSequence(0) {}
+
+      inline bool operator==(const Region& region) const
+      {
+         return mBounded == region.mBounded && mSequence == region.mSequence &&
+                mMinX == region.mMinX && mMinY == region.mMinY &&
+                mMaxX == region.mMaxX && mMaxY == region.mMaxY;
+      }
+      inline bool operator!=(const Region& region) const { return !(*this == region); }
+   };
+
+private:
+   typedef HashTable<U32, NetScopeCell*> typeCellHash;
+
+   /// Cell coordinates are clamped so that region extents and cell counts cannot overflow.
+   static const S32        MaxCellCoord = 1 << 30;
+
+   static typeCellHash     smCells;
+   static NetScopeCell     smUnboundedCell;
+   static F32              smActiveCellSize;
+   static U32              smSequence;
+
+   /// Cells whose coordinates hash to the same key are told apart by their coordinates.
+   static inline U32       getCellKey(const S32 x, const S32 y)        { return ((U32)x * 73856093u) ^ ((U32)y * 19349663u); }
+   static S32              getCellCoord(const F32 position);
+   static U32              getRegionCellCount(const Region& region);
+   static NetScopeCell*    findCell(const S32 x, const S32 y, const bool create);
+   static NetScopeCell*    getObjectCell(NetObject* pObject);
+   static void             insertObject(NetObject* pObject, NetScopeCell* pCell);
+   static void             extractObject(NetObject* pObject);
+   static void             rebuild(void);
+   static void             scopeCell(NetConnection* pConnection, const NetScopeCell* pCell);
+
+public:
+   /// Cell size in world units.
+   static F32              smCellSize;
+
+   static void             create(void);
+   static void             destroy(void);
+
+   /// Track a ghostable server object.
+   static void             addObject(NetObject* pObject);
+   static void             removeObject(NetObject* pObject);
+
+   /// Called when an object's scope position changes.
+   static void             updateObject(NetObject* pObject);
+
+   /// Called when an object's scoping flags change.
+   static void             invalidateObject(NetObject* pObject);
+
+   /// Find the region covered by a scope query.
+   static void             getRegion(const CameraScopeQuery* pCamInfo, Region& region);
+
+   /// Scope all the objects in the region covered by a scope query.
+   static void             scopeObjects(NetConnection* pConnection, const CameraScopeQuery* pCamInfo);
+
+   static U32              getCellCount(void)                          { return smCells.size(); }
+};
+
+#endif // _NETSCOPEGRID_H_
@@ -0,0 +1,62 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _TAML_BINARY_FORMAT_H_
+#define _TAML_BINARY_FORMAT_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+/// Binary Taml revisions.
+///
+/// Version 1 and 2 write every type name, object name, field name and field value inline as text.
+///
+/// Version 3 writes a per-file string pool ahead of the elements.  Names and text values are
+/// written as indices into the pool, common console types are written in their native binary form
+/// and references are resolved through an object table rather than a hash lookup.
+namespace TamlBinaryFormat
+{
+    enum Versions
+    {
+        InlineStringVersion = 2,
+        StringPoolVersion = 3,
+
+        CurrentVersion = StringPoolVersion,
+    };
+
+    /// Attribute value encodings used by the string pool version.
+    enum ValueType
+    {
+        PooledStringValue = 0,
+        F32Value,
+        S32Value,
+        BoolValue,
+        Vector2Value,
+        ColorFValue,
+    };
+}
+
+#endif // _TAML_BINARY_FORMAT_H_
@@ -26,12 +26,28 @@
 #include "io/zip/zipSubStream.h"
 #endif
 
+#ifndef _CONSOLETYPES_H_
+#include "console/consoleTypes.h"
+#endif
+
+#ifndef _CONSOLE_TYPE_VALIDATORS_H_
+#include "console/ConsoleTypeValidators.h"
+#endif
+
+#ifndef _VECTOR2_H_
+#include "2d/core/Vector2.h"
+#endif
+
+#ifndef _COLOR_H_
+#include "graphics/gColor.h"
+#endif
+
 // Debug Profiling.
 #include "debug/profiler.h"
 
 //-----------------------------------------------------------------------------
 
-SimObject* TamlBinaryReader::read( FileStream& stream )
+SimObject* TamlBinaryReader::read( Stream& stream )
 {
     // Debug Profiling.
     PROFILE_SCOPE(TamlBinaryReader_Read);
@@ -51,6 +67,14 @@ SimObject* TamlBinaryReader::read( FileStream& stream )
     U32 versionId;
     stream.read( &versionId );
 
+    // Is the version supported?
+    if ( versionId > TamlBinaryFormat::CurrentVersion )
+    {
+        // Warn.
+        Con::warnf("Taml: Cannot read binary file as version '%d' is newer than the supported version '%d'.", versionId, TamlBinaryFormat::CurrentVersion );
+        return NULL;
+    }
+
     // Read compressed flag.
     bool compressed;
     stream.read( &compressed );
@@ -64,18 +88,21 @@ SimObject* TamlBinaryReader::read( FileStream& stream )
         ZipSubRStream zipStream;
         zipStream.attachStream( &stream );
 
-        // Parse element.
-        pSimObject = parseElement( zipStream, versionId );
+        // Parse document.
+        pSimObject = parseDocument( zipStream, versionId );
 
         // Detach zip stream.
         zipStream.detachStream();
     }
     else
     {
-        // No, so parse element.
-        pSimObject = parseElement( stream, versionId );
+        // No, so parse document.
+        pSimObject = parseDocument( stream, versionId );
     }
 
+    // Reset parse.
+    resetParse();
+
     return pSimObject;
 }
 
@@ -88,6 +115,132 @@ void TamlBinaryReader::resetParse( void )
 
     // Clear object reference map.
     mObjectReferenceMap.clear();
+
+    // Clear object table and string pool.
+    mObjectTable.clear();
+    mStringPool.clear();
+    mStringPoolEntries.clear();
+    mStringPoolData.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+SimObject* TamlBinaryReader::parseDocument( Stream& stream, const U32 versionId )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryReader_ParseDocument);
+
+    // Inline string versions are just the root element.
+    if ( versionId < TamlBinaryFormat::StringPoolVersion )
+        return parseElement( stream, versionId );
+
+    // Read the string pool.
+    if ( !readStringPool( stream ) )
+        return NULL;
+
+    // Read the object table size.
+    U32 objectTableSize;
+    stream.read( &objectTableSize );
+
+    // Allocate the object table.
+    mObjectTable.setSize( objectTableSize + 1 );
+    dMemset( mObjectTable.address(), 0, mObjectTable.memSize() );
+
+    // Parse root element.
+    return parseElement( stream, versionId );
+}
+
+//-----------------------------------------------------------------------------
+
+bool TamlBinaryReader::readStringPool( Stream& stream )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryReader_ReadStringPool);
+
+    // Read string count and size.
+    U32 stringCount;
+    U32 stringPoolSize;
+    stream.read( &stringCount );
+    stream.read( &stringPoolSize );
+
+    // Read all the strings at once.
+    mStringPoolData.setSize( stringPoolSize );
+    if ( stringPoolSize == 0 || !stream.read( stringPoolSize, mStringPoolData.address() ) || mStringPoolData.last() != 0 )
+    {
+        // Warn.
+        Con::warnf("Taml: Cannot read binary file as the string pool is invalid." );
+        return false;
+    }
+
+    // Index the strings.
+    mStringPool.reserve( stringCount );
+    for ( const char* pString = mStringPoolData.address(); pString < mStringPoolData.end(); pString += dStrlen( pString ) + 1 )
+    {
+        mStringPool.push_back( pString );
+    }
+
+    // Is the string count correct?
+    if ( (U32)mStringPool.size() != stringCount )
+    {
+        // Warn.
+        Con::warnf("Taml: Cannot read binary file as the string pool has '%d' strings but expected '%d'.", mStringPool.size(), stringCount );
+        return false;
+    }
+
+    // Names are only inserted into the string table when first used.
+    mStringPoolEntries.setSize( stringCount );
+    dMemset( mStringPoolEntries.address(), 0, mStringPoolEntries.memSize() );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+const char* TamlBinaryReader::readPooledString( Stream& stream )
+{
+    // Read pool index.
+    U32 poolIndex;
+    stream.read( &poolIndex );
+
+    // Is the pool index valid?
+    if ( poolIndex >= (U32)mStringPool.size() )
+    {
+        // No, so warn.
+        Con::warnf( "Taml: Invalid string pool index of '%d'.", poolIndex );
+        return StringTable->EmptyString;
+    }
+
+    return mStringPool[poolIndex];
+}
+
+//-----------------------------------------------------------------------------
+
+StringTableEntry TamlBinaryReader::readName( Stream& stream, const U32 versionId )
+{
+    // Inline string versions write the name directly.
+    if ( versionId < TamlBinaryFormat::StringPoolVersion )
+        return stream.readSTString();
+
+    // Read pool index.
+    U32 poolIndex;
+    stream.read( &poolIndex );
+
+    // Is the pool index valid?
+    if ( poolIndex >= (U32)mStringPool.size() )
+    {
+        // No, so warn.
+        Con::warnf( "Taml: Invalid string pool index of '%d'.", poolIndex );
+        return StringTable->EmptyString;
+    }
+
+    // Fetch the name.
+    StringTableEntry& name = mStringPoolEntries[poolIndex];
+
+    // Insert the name if it has not been used yet.
+    if ( name == NULL )
+        name = StringTable->insert( mStringPool[poolIndex] );
+
+    return name;
 }
 
 //-----------------------------------------------------------------------------
@@ -106,10 +259,10 @@ SimObject* TamlBinaryReader::parseElement( Stream& stream, const U32 versionId )
 #endif
 
     // Fetch element name.    
-    StringTableEntry typeName = stream.readSTString();
+    StringTableEntry typeName = readName( stream, versionId );
 
     // Fetch object name.
-    StringTableEntry objectName = stream.readSTString();
+    StringTableEntry objectName = readName( stream, versionId );
 
     // Read references.
     U32 tamlRefId;
@@ -117,6 +270,24 @@ SimObject* TamlBinaryReader::parseElement( Stream& stream, const U32 versionId )
     stream.read( &tamlRefId );
     stream.read( &tamlRefToId );
 
+    // Do we have a reference to Id in the object table?
+    if ( tamlRefToId != 0 && versionId >= TamlBinaryFormat::StringPoolVersion )
+    {
+        // Yes, so fetch reference.
+        SimObject* pReferenceObject = tamlRefToId < (U32)mObjectTable.size() ? mObjectTable[tamlRefToId] : NULL;
+
+        // Did we find the reference?
+        if ( pReferenceObject == NULL )
+        {
+            // No, so warn.
+            Con::warnf( "Taml: Could not find a reference Id of '%d'", tamlRefToId );
+            return NULL;
+        }
+
+        // Return object.
+        return pReferenceObject;
+    }
+
     // Do we have a reference to Id?
     if ( tamlRefToId != 0 )
     {
@@ -183,8 +354,22 @@ SimObject* TamlBinaryReader::parseElement( Stream& stream, const U32 versionId )
         }
     }
 
-    // Do we have a reference Id?
-    if ( tamlRefId != 0 )
+    // Do we have a reference Id in the object table?
+    if ( tamlRefId != 0 && versionId >= TamlBinaryFormat::StringPoolVersion )
+    {
+        // Yes, so is it in range?
+        if ( tamlRefId < (U32)mObjectTable.size() )
+        {
+            // Yes, so set reference.
+            mObjectTable[tamlRefId] = pSimObject;
+        }
+        else
+        {
+            // No, so warn.
+            Con::warnf( "Taml: Reference Id of '%d' is outside of the object table.", tamlRefId );
+        }
+    }
+    else if ( tamlRefId != 0 )
     {
         // Yes, so insert reference.
         mObjectReferenceMap.insert( tamlRefId, pSimObject );
@@ -228,6 +413,17 @@ void TamlBinaryReader::parseAttributes( Stream& stream, SimObject* pSimObject, c
     if ( attributeCount == 0 )
         return;
 
+    // Is this the string pool version?
+    if ( versionId >= TamlBinaryFormat::StringPoolVersion )
+    {
+        // Yes, so iterate attributes.
+        for ( U32 index = 0; index < attributeCount; ++index )
+        {
+            parsePooledAttribute( stream, pSimObject );
+        }
+        return;
+    }
+
     char valueBuffer[4096];
 
     // Iterate attributes.
@@ -244,6 +440,145 @@ void TamlBinaryReader::parseAttributes( Stream& stream, SimObject* pSimObject, c
 
 //-----------------------------------------------------------------------------
 
+void TamlBinaryReader::parsePooledAttribute( Stream& stream, SimObject* pSimObject )
+{
+    // Fetch attribute name.
+    StringTableEntry attributeName = readName( stream, TamlBinaryFormat::StringPoolVersion );
+
+    // Fetch attribute value type.
+    U8 valueType;
+    stream.read( &valueType );
+
+    char valueBuffer[128];
+
+    switch( valueType )
+    {
+        case TamlBinaryFormat::PooledStringValue:
+            {
+                // We can assume this is a field for now.
+                pSimObject->setPrefixedDataField( attributeName, NULL, readPooledString( stream ) );
+            }
+            return;
+
+        case TamlBinaryFormat::F32Value:
+            {
+                F32 value;
+                stream.read( &value );
+
+                // Finish if set natively.
+                if ( setNativeField( pSimObject, attributeName, TypeF32, &value ) )
+                    return;
+
+                dSprintf( valueBuffer, sizeof(valueBuffer), "%.9g", value );
+            }
+            break;
+
+        case TamlBinaryFormat::S32Value:
+            {
+                S32 value;
+                stream.read( &value );
+
+                // Finish if set natively.
+                if ( setNativeField( pSimObject, attributeName, TypeS32, &value ) )
+                    return;
+
+                dSprintf( valueBuffer, sizeof(valueBuffer), "%d", value );
+            }
+            break;
+
+        case TamlBinaryFormat::BoolValue:
+            {
+                bool value;
+                stream.read( &value );
+
+                // Finish if set natively.
+                if ( setNativeField( pSimObject, attributeName, TypeBool, &value ) )
+                    return;
+
+                dStrcpy( valueBuffer, value ? "true" : "false" );
+            }
+            break;
+
+        case TamlBinaryFormat::Vector2Value:
+            {
+                Vector2 value;
+                stream.read( &value.x );
+                stream.read( &value.y );
+
+                // Finish if set natively.
+                if ( setNativeField( pSimObject, attributeName, TypeVector2, &value ) )
+                    return;
+
+                dSprintf( valueBuffer, sizeof(valueBuffer), "%.9g %.9g", value.x, value.y );
+            }
+            break;
+
+        case TamlBinaryFormat::ColorFValue:
+            {
+                ColorF value;
+                stream.read( &value.red );
+                stream.read( &value.green );
+                stream.read( &value.blue );
+                stream.read( &value.alpha );
+
+                // Finish if set natively.
+                if ( setNativeField( pSimObject, attributeName, TypeColorF, &value ) )
+                    return;
+
+                dSprintf( valueBuffer, sizeof(valueBuffer), "%.9g %.9g %.9g %.9g", value.red, value.green, value.blue, value.alpha );
+            }
+            break;
+
+        default:
+            // Warn.
+            Con::warnf( "Taml: Unknown attribute value type '%d' for attribute '%s'.", valueType, attributeName );
+            return;
+    }
+
+    // The field has changed since it was written so set it from text.
+    pSimObject->setPrefixedDataField( attributeName, NULL, valueBuffer );
+}
+
+//-----------------------------------------------------------------------------
+
+bool TamlBinaryReader::setNativeField( SimObject* pSimObject, StringTableEntry fieldName, const U32 fieldType, const void* pValue )
+{
+    // Fetch the static field.
+    const AbstractClassRep::Field* pField = pSimObject->isModStaticFields() ? pSimObject->findField( fieldName ) : NULL;
+
+    // Only plain fields of the same type can be assigned natively.
+    if ( pField == NULL || pField->type != fieldType || pField->elementCount < 1 || pField->setDataFn != &defaultProtectedSetFn )
+        return false;
+
+    // Fetch the field data.
+    void* pFieldData = ((U8*)pSimObject) + pField->offset;
+
+    // Assign the field.
+    if ( fieldType == (U32)TypeF32 )
+        *((F32*)pFieldData) = *((const F32*)pValue);
+    else if ( fieldType == (U32)TypeS32 )
+        *((S32*)pFieldData) = *((const S32*)pValue);
+    else if ( fieldType == (U32)TypeBool )
+        *((bool*)pFieldData) = *((const bool*)pValue);
+    else if ( fieldType == (U32)TypeVector2 )
+        *((Vector2*)pFieldData) = *((const Vector2*)pValue);
+    else if ( fieldType == (U32)TypeColorF )
+        *((ColorF*)pFieldData) = *((const ColorF*)pValue);
+    else
+        return false;
+
+    // Validate the field.
+    if ( pField->validator != NULL )
+        pField->validator->validateType( pSimObject, pFieldData );
+
+    // Notify the object.
+    pSimObject->onStaticModified( fieldName );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
 void TamlBinaryReader::parseChildren( Stream& stream, TamlCallbacks* pCallbacks, SimObject* pSimObject, const U32 versionId )
 {
     // Debug Profiling.
@@ -338,13 +673,23 @@ void TamlBinaryReader::parseCustomElements( Stream& stream, TamlCallbacks* pCall
     for ( U32 nodeIndex = 0; nodeIndex < customNodeCount; ++nodeIndex )
     {
         //Read custom node name.
-        StringTableEntry nodeName = stream.readSTString();
+        StringTableEntry nodeName = readName( stream, versionId );
 
         // Add custom node.
         TamlCustomNode* pCustomNode = customNodes.addNode( nodeName );
 
-        // Parse the custom node.
-        parseCustomNode( stream, pCustomNode, versionId );
+        // Inline string versions have a single child node.
+        U32 childNodeCount = 1;
+
+        // Read child node count.
+        if ( versionId >= TamlBinaryFormat::StringPoolVersion )
+            stream.read( &childNodeCount );
+
+        // Parse the child nodes.
+        for ( U32 childIndex = 0; childIndex < childNodeCount; ++childIndex )
+        {
+            parseCustomNode( stream, pCustomNode, versionId );
+        }
     }
 
     // Do we have callbacks?
@@ -380,15 +725,22 @@ void TamlBinaryReader::parseCustomNode( Stream& stream, TamlCustomNode* pCustomN
     }
 
     // No, so read custom node name.
-    StringTableEntry nodeName = stream.readSTString();
+    StringTableEntry nodeName = readName( stream, versionId );
 
     // Add child node.
     TamlCustomNode* pChildNode = pCustomNode->addNode( nodeName );
 
     // Read child node text.
-    char childNodeTextBuffer[MAX_TAML_NODE_FIELDVALUE_LENGTH];
-    stream.readLongString( MAX_TAML_NODE_FIELDVALUE_LENGTH, childNodeTextBuffer );
-    pChildNode->setNodeText( childNodeTextBuffer );
+    if ( versionId >= TamlBinaryFormat::StringPoolVersion )
+    {
+        pChildNode->setNodeText( readPooledString( stream ) );
+    }
+    else
+    {
+        char childNodeTextBuffer[MAX_TAML_NODE_FIELDVALUE_LENGTH];
+        stream.readLongString( MAX_TAML_NODE_FIELDVALUE_LENGTH, childNodeTextBuffer );
+        pChildNode->setNodeText( childNodeTextBuffer );
+    }
 
     // Read child node count.
     U32 childNodeCount;
@@ -416,7 +768,15 @@ void TamlBinaryReader::parseCustomNode( Stream& stream, TamlCustomNode* pCustomN
         for( U32 childFieldIndex = 0; childFieldIndex < childFieldCount; ++childFieldIndex )
         {
             // Read field name.
-            StringTableEntry fieldName = stream.readSTString();
+            StringTableEntry fieldName = readName( stream, versionId );
+
+            // Is this the string pool version?
+            if ( versionId >= TamlBinaryFormat::StringPoolVersion )
+            {
+                // Yes, so add pooled field.
+                pChildNode->addField( fieldName, readPooledString( stream ) );
+                continue;
+            }
 
             // Read field value.
             char valueBuffer[MAX_TAML_NODE_FIELDVALUE_LENGTH];
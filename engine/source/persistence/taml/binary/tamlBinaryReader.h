@@ -31,6 +31,10 @@
 #include "persistence/taml/taml.h"
 #endif
 
+#ifndef _TAML_BINARY_FORMAT_H_
+#include "persistence/taml/binary/tamlBinaryFormat.h"
+#endif
+
 //-----------------------------------------------------------------------------
 
 /// @ingroup tamlGroup
@@ -46,7 +50,7 @@ public:
     virtual ~TamlBinaryReader() {}
 
     /// Read.
-    SimObject* read( FileStream& stream );
+    SimObject* read( Stream& stream );
 
 private:
     Taml* mpTaml;
@@ -55,9 +59,21 @@ private:
 
     typeObjectReferenceHash mObjectReferenceMap;
 
+    Vector<SimObject*>          mObjectTable;
+    Vector<char>                mStringPoolData;
+    Vector<const char*>         mStringPool;
+    Vector<StringTableEntry>    mStringPoolEntries;
+
 private:
     void resetParse( void );
 
+    SimObject* parseDocument( Stream& stream, const U32 versionId );
+    bool readStringPool( Stream& stream );
+    StringTableEntry readName( Stream& stream, const U32 versionId );
+    const char* readPooledString( Stream& stream );
+    bool setNativeField( SimObject* pSimObject, StringTableEntry fieldName, const U32 fieldType, const void* pValue );
+    void parsePooledAttribute( Stream& stream, SimObject* pSimObject );
+
     SimObject* parseElement( Stream& stream, const U32 versionId );
     void parseAttributes( Stream& stream, SimObject* pSimObject, const U32 versionId );
     void parseChildren( Stream& stream, TamlCallbacks* pCallbacks, SimObject* pSimObject, const U32 versionId );
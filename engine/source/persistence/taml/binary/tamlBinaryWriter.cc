@@ -20,12 +20,29 @@
 // IN THE SOFTWARE.
 //-----------------------------------------------------------------------------
 
+
 #include "persistence/taml/binary/tamlBinaryWriter.h"
 
 #ifndef _ZIPSUBSTREAM_H_
 #include "io/zip/zipSubStream.h"
 #endif
 
+#ifndef _CONSOLETYPES_H_
+#include "console/consoleTypes.h"
+#endif
+
+#ifndef _VECTOR2_H_
+#include "2d/core/Vector2.h"
+#endif
+
+#ifndef _COLOR_H_
+#include "graphics/gColor.h"
+#endif
+
+#ifndef _STRINGUNIT_H_
+#include "string/stringUnit.h"
+#endif
+
 // Debug Profiling.
 #include "debug/profiler.h"
 
@@ -35,7 +52,13 @@ bool TamlBinaryWriter::write( FileStream& stream, const TamlWriteNode* pTamlWrit
 {
     // Debug Profiling.
     PROFILE_SCOPE(TamlBinaryWriter_Write);
- 
+
+    // Reset the string pool.
+    resetStringPool();
+
+    // Collect the strings and references.
+    collectElement( pTamlWriteNode );
+
     // Write Taml signature.
     stream.writeString( StringTable->insert( TAML_SIGNATURE ) );
 
@@ -52,6 +75,12 @@ bool TamlBinaryWriter::write( FileStream& stream, const TamlWriteNode* pTamlWrit
         ZipSubWStream zipStream;
         zipStream.attachStream( &stream );
 
+        // Write string pool.
+        writeStringPool( zipStream );
+
+        // Write object table size.
+        zipStream.write( mMaxRefId );
+
         // Write element.
         writeElement( zipStream, pTamlWriteNode );
 
@@ -60,15 +89,294 @@ bool TamlBinaryWriter::write( FileStream& stream, const TamlWriteNode* pTamlWrit
     }
     else
     {
-        // No, so write element.
+        // No, so write string pool.
+        writeStringPool( stream );
+
+        // Write object table size.
+        stream.write( mMaxRefId );
+
+        // Write element.
         writeElement( stream, pTamlWriteNode );
     }
 
+    // Reset the string pool.
+    resetStringPool();
+
     return true;
 }
 
 //-----------------------------------------------------------------------------
 
+void TamlBinaryWriter::resetStringPool( void )
+{
+    mStringPool.clear();
+    mStringPoolHashes.clear();
+    mStringPoolNext.clear();
+    mStringPoolBuckets.setSize( 1024 );
+    dMemset( mStringPoolBuckets.address(), -1, mStringPoolBuckets.memSize() );
+    mStringPoolSize = 0;
+    mMaxRefId = 0;
+
+    // The empty string is always the first entry.
+    addPoolString( StringTable->EmptyString );
+}
+
+//-----------------------------------------------------------------------------
+
+U32 TamlBinaryWriter::findPoolString( const char* pString ) const
+{
+    // Fetch the bucket.
+    const U32 hash = Hash::hash( pString );
+
+    // Search the bucket.
+    for ( S32 index = mStringPoolBuckets[hash & (mStringPoolBuckets.size()-1)]; index != -1; index = mStringPoolNext[index] )
+    {
+        if ( mStringPoolHashes[index] == hash && dStrcmp( mStringPool[index], pString ) == 0 )
+            return (U32)index;
+    }
+
+    return U32_MAX;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 TamlBinaryWriter::addPoolString( const char* pString )
+{
+    // Finish if the string is already pooled.
+    const U32 existingIndex = findPoolString( pString );
+    if ( existingIndex != U32_MAX )
+        return existingIndex;
+
+    // Grow the buckets if they are getting crowded.
+    if ( (U32)mStringPool.size() >= (U32)mStringPoolBuckets.size() )
+    {
+        mStringPoolBuckets.setSize( mStringPoolBuckets.size() * 2 );
+        dMemset( mStringPoolBuckets.address(), -1, mStringPoolBuckets.memSize() );
+
+        for ( S32 index = 0; index < mStringPool.size(); ++index )
+        {
+            const U32 bucket = mStringPoolHashes[index] & (mStringPoolBuckets.size()-1);
+            mStringPoolNext[index] = mStringPoolBuckets[bucket];
+            mStringPoolBuckets[bucket] = index;
+        }
+    }
+
+    // Add the string.
+    const U32 hash = Hash::hash( pString );
+    const U32 bucket = hash & (mStringPoolBuckets.size()-1);
+    const S32 index = mStringPool.size();
+    mStringPool.push_back( pString );
+    mStringPoolHashes.push_back( hash );
+    mStringPoolNext.push_back( mStringPoolBuckets[bucket] );
+    mStringPoolBuckets[bucket] = index;
+    mStringPoolSize += dStrlen( pString ) + 1;
+
+    return (U32)index;
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryWriter::getAttributeValue( SimObject* pSimObject, const TamlWriteNode::FieldValuePair* pFieldValue, AttributeValue& value )
+{
+    // Default to a pooled string.
+    value.mType = TamlBinaryFormat::PooledStringValue;
+
+    // Fetch the static field.
+    const AbstractClassRep::Field* pField = pSimObject->findField( pFieldValue->mName );
+
+    // Only plain fields can be assigned natively when read.
+    if ( pField == NULL || pField->elementCount != 1 || pField->setDataFn != &defaultProtectedSetFn )
+        return;
+
+    // Fetch the field value.
+    const char* pValue = pFieldValue->mpValue;
+
+    // Fetch the field type.
+    const S32 fieldType = (S32)pField->type;
+
+    // The native values below are exactly what the console type would produce from the text.
+    if ( fieldType == TypeF32 )
+    {
+        value.mType = TamlBinaryFormat::F32Value;
+        value.mF32[0] = dAtof( pValue );
+    }
+    else if ( fieldType == TypeS32 )
+    {
+        value.mType = TamlBinaryFormat::S32Value;
+        value.mS32 = dAtoi( pValue );
+    }
+    else if ( fieldType == TypeBool )
+    {
+        value.mType = TamlBinaryFormat::BoolValue;
+        value.mBool = dAtob( pValue );
+    }
+    else if ( fieldType == TypeVector2 )
+    {
+        const Vector2 vector( pValue );
+        value.mType = TamlBinaryFormat::Vector2Value;
+        value.mF32[0] = vector.x;
+        value.mF32[1] = vector.y;
+    }
+    else if ( fieldType == TypeColorF )
+    {
+        ColorF color;
+
+        // Is this a stock color name?
+        if ( StringUnit::getUnitCount( pValue, " " ) == 1 )
+        {
+            // Yes, so leave invalid names to the console type so it can warn.
+            if ( !StockColor::isColor( pValue ) )
+                return;
+
+            color.set( pValue );
+        }
+        else
+        {
+            // No, so leave anything other than three or four components to the console type.
+            F32 r,g,b,a = 1.0f;
+            if ( dSscanf( pValue, "%g %g %g %g", &r, &g, &b, &a ) < 3 )
+                return;
+
+            color.set( r, g, b, a );
+        }
+
+        value.mType = TamlBinaryFormat::ColorFValue;
+        value.mF32[0] = color.red;
+        value.mF32[1] = color.green;
+        value.mF32[2] = color.blue;
+        value.mF32[3] = color.alpha;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryWriter::collectElement( const TamlWriteNode* pTamlWriteNode )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryWriter_CollectElement);
+
+    // Fetch object.
+    SimObject* pSimObject = pTamlWriteNode->mpSimObject;
+
+    // Add element and object name.
+    addPoolString( pSimObject->getClassName() );
+    addPoolString( pTamlWriteNode->mpObjectName != NULL ? pTamlWriteNode->mpObjectName : StringTable->EmptyString );
+
+    // Track the object table size.
+    mMaxRefId = getMax( mMaxRefId, pTamlWriteNode->mRefId );
+
+    // Finish if this is a reference.
+    if ( pTamlWriteNode->mRefToNode != NULL )
+        return;
+
+    // Add attributes.
+    const Vector<TamlWriteNode::FieldValuePair*>& fields = pTamlWriteNode->mFields;
+    for( Vector<TamlWriteNode::FieldValuePair*>::const_iterator itr = fields.begin(); itr != fields.end(); ++itr )
+    {
+        // Fetch field/value pair.
+        const TamlWriteNode::FieldValuePair* pFieldValue = (*itr);
+
+        addPoolString( pFieldValue->mName );
+
+        // Add the value if it is not written natively.
+        AttributeValue value;
+        getAttributeValue( pSimObject, pFieldValue, value );
+        if ( value.mType == TamlBinaryFormat::PooledStringValue )
+            addPoolString( pFieldValue->mpValue );
+    }
+
+    // Add children.
+    if ( pTamlWriteNode->mChildren != NULL )
+    {
+        for( Vector<TamlWriteNode*>::iterator itr = pTamlWriteNode->mChildren->begin(); itr != pTamlWriteNode->mChildren->end(); ++itr )
+        {
+            collectElement( (*itr) );
+        }
+    }
+
+    // Add custom nodes.
+    const TamlCustomNodeVector& nodes = pTamlWriteNode->mCustomNodes.getNodes();
+    for( TamlCustomNodeVector::const_iterator customNodesItr = nodes.begin(); customNodesItr != nodes.end(); ++customNodesItr )
+    {
+        // Fetch the custom node.
+        const TamlCustomNode* pCustomNode = *customNodesItr;
+
+        addPoolString( pCustomNode->getNodeName() );
+
+        // Add node children.
+        const TamlCustomNodeVector& nodeChildren = pCustomNode->getChildren();
+        for( TamlCustomNodeVector::const_iterator childNodeItr = nodeChildren.begin(); childNodeItr != nodeChildren.end(); ++childNodeItr )
+        {
+            collectCustomNode( *childNodeItr );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryWriter::collectCustomNode( const TamlCustomNode* pCustomNode )
+{
+    // Is the node a proxy object?
+    if ( pCustomNode->isProxyObject() )
+    {
+        // Yes, so add the element.
+        collectElement( pCustomNode->getProxyWriteNode() );
+        return;
+    }
+
+    // Add custom node name and text.
+    addPoolString( pCustomNode->getNodeName() );
+    addPoolString( pCustomNode->getNodeTextField().getFieldValue() );
+
+    // Add node children.
+    const TamlCustomNodeVector& nodeChildren = pCustomNode->getChildren();
+    for( TamlCustomNodeVector::const_iterator childNodeItr = nodeChildren.begin(); childNodeItr != nodeChildren.end(); ++childNodeItr )
+    {
+        collectCustomNode( *childNodeItr );
+    }
+
+    // Add fields.
+    const TamlCustomFieldVector& fields = pCustomNode->getFields();
+    for ( TamlCustomFieldVector::const_iterator fieldItr = fields.begin(); fieldItr != fields.end(); ++fieldItr )
+    {
+        addPoolString( (*fieldItr)->getFieldName() );
+        addPoolString( (*fieldItr)->getFieldValue() );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryWriter::writeStringPool( Stream& stream )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryWriter_WriteStringPool);
+
+    // Write string count and size.
+    stream.write( (U32)mStringPool.size() );
+    stream.write( mStringPoolSize );
+
+    // Write strings including their terminators.
+    for( Vector<const char*>::const_iterator itr = mStringPool.begin(); itr != mStringPool.end(); ++itr )
+    {
+        stream.write( dStrlen( *itr ) + 1, *itr );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryWriter::writePooledString( Stream& stream, const char* pString )
+{
+    // Fetch pool index.
+    const U32 poolIndex = findPoolString( pString );
+
+    // Sanity!
+    AssertFatal( poolIndex != U32_MAX, "TamlBinaryWriter::writePooledString() - String was not collected into the pool." );
+
+    stream.write( poolIndex );
+}
+
+//-----------------------------------------------------------------------------
+
 void TamlBinaryWriter::writeElement( Stream& stream, const TamlWriteNode* pTamlWriteNode )
 {
     // Debug Profiling.
@@ -77,17 +385,14 @@ void TamlBinaryWriter::writeElement( Stream& stream, const TamlWriteNode* pTamlW
     // Fetch object.
     SimObject* pSimObject = pTamlWriteNode->mpSimObject;
 
-    // Fetch element name.
-    const char* pElementName = pSimObject->getClassName();
-
     // Write element name.
-    stream.writeString( pElementName );
+    writePooledString( stream, pSimObject->getClassName() );
 
     // Fetch object name.
     const char* pObjectName = pTamlWriteNode->mpObjectName;
 
     // Write object name.
-    stream.writeString( pObjectName != NULL ? pObjectName : StringTable->EmptyString );
+    writePooledString( stream, pObjectName != NULL ? pObjectName : StringTable->EmptyString );
 
     // Fetch reference Id.
     const U32 tamlRefId = pTamlWriteNode->mRefId;
@@ -112,7 +417,7 @@ void TamlBinaryWriter::writeElement( Stream& stream, const TamlWriteNode* pTamlW
     }
 
     // No, so write no reference to Id.
-    stream.write( 0 );
+    stream.write( (U32)0 );
 
     // Write attributes.
     writeAttributes( stream, pTamlWriteNode );
@@ -134,25 +439,68 @@ void TamlBinaryWriter::writeAttributes( Stream& stream, const TamlWriteNode* pTa
     // Fetch fields.
     const Vector<TamlWriteNode::FieldValuePair*>& fields = pTamlWriteNode->mFields;
 
-    // Write placeholder attribute count.
+    // Write attribute count.
     stream.write( (U32)fields.size() );
 
     // Finish if no fields.
     if ( fields.size() == 0 )
         return;
 
+    // Fetch object.
+    SimObject* pSimObject = pTamlWriteNode->mpSimObject;
+
     // Iterate fields.
     for( Vector<TamlWriteNode::FieldValuePair*>::const_iterator itr = fields.begin(); itr != fields.end(); ++itr )
     {
         // Fetch field/value pair.
         TamlWriteNode::FieldValuePair* pFieldValue = (*itr);
 
-        // Write attribute.
-        stream.writeString( pFieldValue->mName );
-        stream.writeLongString( 4096, pFieldValue->mpValue );
+        // Write attribute name.
+        writePooledString( stream, pFieldValue->mName );
+
+        // Fetch attribute value.
+        AttributeValue value;
+        getAttributeValue( pSimObject, pFieldValue, value );
+
+        // Write attribute value type.
+        stream.write( (U8)value.mType );
+
+        // Write attribute value.
+        switch( value.mType )
+        {
+            case TamlBinaryFormat::F32Value:
+                stream.write( value.mF32[0] );
+                break;
+
+            case TamlBinaryFormat::S32Value:
+                stream.write( value.mS32 );
+                break;
+
+            case TamlBinaryFormat::BoolValue:
+                stream.write( value.mBool );
+                break;
+
+            case TamlBinaryFormat::Vector2Value:
+                stream.write( value.mF32[0] );
+                stream.write( value.mF32[1] );
+                break;
+
+            case TamlBinaryFormat::ColorFValue:
+                stream.write( value.mF32[0] );
+                stream.write( value.mF32[1] );
+                stream.write( value.mF32[2] );
+                stream.write( value.mF32[3] );
+                break;
+
+            default:
+                writePooledString( stream, pFieldValue->mpValue );
+                break;
+        }
     }
 }
 
+//-----------------------------------------------------------------------------
+
 void TamlBinaryWriter::writeChildren( Stream& stream, const TamlWriteNode* pTamlWriteNode )
 {
     // Debug Profiling.
@@ -207,11 +555,14 @@ void TamlBinaryWriter::writeCustomElements( Stream& stream, const TamlWriteNode*
         TamlCustomNode* pCustomNode = *customNodesItr;
 
         // Write custom node name.
-        stream.writeString( pCustomNode->getNodeName() );
+        writePooledString( stream, pCustomNode->getNodeName() );
 
         // Fetch node children.
         const TamlCustomNodeVector& nodeChildren = pCustomNode->getChildren();
 
+        // Write node children count.
+        stream.write( (U32)nodeChildren.size() );
+
         // Iterate children nodes.
         for( TamlCustomNodeVector::const_iterator childNodeItr = nodeChildren.begin(); childNodeItr != nodeChildren.end(); ++childNodeItr )
         {
@@ -243,10 +594,10 @@ void TamlBinaryWriter::writeCustomNode( Stream& stream, const TamlCustomNode* pC
     stream.write( false );
 
     // Write custom node name.
-    stream.writeString( pCustomNode->getNodeName() );
+    writePooledString( stream, pCustomNode->getNodeName() );
 
     // Write custom node text.
-    stream.writeLongString(MAX_TAML_NODE_FIELDVALUE_LENGTH, pCustomNode->getNodeTextField().getFieldValue());
+    writePooledString( stream, pCustomNode->getNodeTextField().getFieldValue() );
 
     // Fetch node children.
     const TamlCustomNodeVector& nodeChildren = pCustomNode->getChildren();
@@ -290,8 +641,8 @@ void TamlBinaryWriter::writeCustomNode( Stream& stream, const TamlCustomNode* pC
             const TamlCustomField* pField = *fieldItr;
 
             // Write the node field.
-            stream.writeString( pField->getFieldName() );
-            stream.writeLongString( MAX_TAML_NODE_FIELDVALUE_LENGTH, pField->getFieldValue() );
+            writePooledString( stream, pField->getFieldName() );
+            writePooledString( stream, pField->getFieldValue() );
         }
     }
-}
\ No newline at end of file
+}
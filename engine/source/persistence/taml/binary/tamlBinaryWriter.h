@@ -27,6 +27,10 @@
 #include "persistence/taml/taml.h"
 #endif
 
+#ifndef _TAML_BINARY_FORMAT_H_
+#include "persistence/taml/binary/tamlBinaryFormat.h"
+#endif
+
 //-----------------------------------------------------------------------------
 
 /// @ingroup tamlGroup
@@ -36,7 +40,9 @@ class TamlBinaryWriter
 public:
     TamlBinaryWriter( Taml* pTaml ) :
         mpTaml( pTaml ),
-        mVersionId(2)
+        mVersionId(TamlBinaryFormat::CurrentVersion),
+        mStringPoolSize(0),
+        mMaxRefId(0)
     {
     }
     virtual ~TamlBinaryWriter() {}
@@ -48,7 +54,32 @@ private:
     Taml* mpTaml;
     const U32 mVersionId;
 
+    /// A native attribute value.
+    struct AttributeValue
+    {
+        TamlBinaryFormat::ValueType mType;
+        F32                         mF32[4];
+        S32                         mS32;
+        bool                        mBool;
+    };
+
+    Vector<const char*> mStringPool;
+    Vector<U32>         mStringPoolHashes;
+    Vector<S32>         mStringPoolNext;
+    Vector<S32>         mStringPoolBuckets;
+    U32                 mStringPoolSize;
+    U32                 mMaxRefId;
+
 private:
+    void resetStringPool( void );
+    U32 addPoolString( const char* pString );
+    U32 findPoolString( const char* pString ) const;
+    void collectElement( const TamlWriteNode* pTamlWriteNode );
+    void collectCustomNode( const TamlCustomNode* pCustomNode );
+    void writeStringPool( Stream& stream );
+    void writePooledString( Stream& stream, const char* pString );
+    static void getAttributeValue( SimObject* pSimObject, const TamlWriteNode::FieldValuePair* pFieldValue, AttributeValue& value );
+
     void writeElement( Stream& stream, const TamlWriteNode* pTamlWriteNode );
     void writeAttributes( Stream& stream, const TamlWriteNode* pTamlWriteNode );
     void writeChildren( Stream& stream, const TamlWriteNode* pTamlWriteNode );
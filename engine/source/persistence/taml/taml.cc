@@ -313,6 +313,28 @@ SimObject* Taml::read( const char* pFilename )
 
 //-----------------------------------------------------------------------------
 
+SimObject* Taml::readBinary( Stream& stream )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Taml_ReadBinary);
+
+    // Reset the compilation.
+    resetCompilation();
+
+    // Create reader.
+    TamlBinaryReader reader( this );
+
+    // Read.
+    SimObject* pSimObject = reader.read( stream );
+
+    // Reset the compilation.
+    resetCompilation();
+
+    return pSimObject;
+}
+
+//-----------------------------------------------------------------------------
+
 bool Taml::write( FileStream& stream, SimObject* pSimObject, const TamlFormatMode formatMode )
 {
     // Sanity!
@@ -184,6 +184,9 @@ public:
     }
     SimObject* read( const char* pFilename );
 
+    /// Read a binary document from any stream such as a memory stream.
+    SimObject* readBinary( Stream& stream );
+
     /// Parse.
     bool parse( const char* pFilename, TamlVisitor& visitor );
 
@@ -128,7 +128,7 @@ struct ConsoleEvent : public Event
 
 /// Header sizes for events defined later on.
 /// Byte offset to payload of a PacketReceiveEvent
-//const U32 PacketReceiveEventHeaderSize = Offset(data,PacketReceiveEvent);
+const U32 PacketReceiveEventHeaderSize = (U32)_Offset_Normal(data,PacketReceiveEvent);
 /// Byte offset to payload of a ConnectedReceiveEvent
 //const U32 ConnectedReceiveEventHeaderSize = Offset(data,ConnectedReceiveEvent);
 /// Byte offset to payload of a ConsoleEvent
@@ -20,6 +20,7 @@
 // IN THE SOFTWARE.
 //-----------------------------------------------------------------------------
 
+
 #include "platform/platform.h"
 #include "io/fileStream.h"
 #include "console/console.h"
@@ -27,9 +28,38 @@
 #include "platform/threads/mutex.h"
 #include "math/mMath.h"
 #include <stdlib.h>
+#include <stdarg.h>
+
+#ifdef TORQUE_MEMORY_TRACKING
+#include <atomic>
+#endif
+
+// Script bindings.
+#include "platformMemory_ScriptBinding.h"
+
+//-----------------------------------------------------------------------------
+
+static const char* smTagNames[Memory::TagCount] =
+{
+    "general",
+    "scene",
+    "particles",
+    "console",
+    "textures",
+    "assets",
+};
 
 //-----------------------------------------------------------------------------
 
+const char* Memory::getTagName( const Tag tag )
+{
+    return tag >= 0 && tag < TagCount ? smTagNames[tag] : "unknown";
+}
+
+//-----------------------------------------------------------------------------
+
+#ifndef TORQUE_MEMORY_TRACKING
+
 void* dMalloc_r(dsize_t in_size, const char* fileName, const dsize_t line)
 {
    return malloc(in_size);
@@ -48,3 +78,667 @@ void* dRealloc_r(void* in_pResize, dsize_t in_size, const char* fileName, const
 {
    return realloc(in_pResize,in_size);
 }
+
+//-----------------------------------------------------------------------------
+
+bool Memory::isTracking( void )
+{
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+
+void Memory::dumpAllocations( const U32 count )
+{
+    Con::warnf( "Memory::dumpAllocations() - Memory tracking is not available.  Build with TORQUE_MEMORY_TRACKING to enable it." );
+}
+
+//-----------------------------------------------------------------------------
+
+U32 Memory::takeSnapshot( void )
+{
+    Con::warnf( "Memory::takeSnapshot() - Memory tracking is not available.  Build with TORQUE_MEMORY_TRACKING to enable it." );
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void Memory::dumpSnapshotDiff( const U32 fromSnapshotId, const U32 toSnapshotId, const U32 count )
+{
+    Con::warnf( "Memory::dumpSnapshotDiff() - Memory tracking is not available.  Build with TORQUE_MEMORY_TRACKING to enable it." );
+}
+
+//-----------------------------------------------------------------------------
+
+void Memory::reportLeaks( const U32 count )
+{
+}
+
+#else // TORQUE_MEMORY_TRACKING
+
+//-----------------------------------------------------------------------------
+// Every tracked block is preceded by a header recording its size, call site and
+// tag so that it can be accounted for when it is freed.  Call sites are shared by
+// all threads and are only locked when a thread sees a site for the first time.
+// Counters are written only by the thread doing the allocation or free so a
+// block freed on another thread is subtracted from that thread's counters; the
+// live totals are the sum over all threads.
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    enum
+    {
+        MaxSites            = 1 << 15,
+        SiteTableSize       = MaxSites * 2,
+        SitePageSize        = 256,
+        SitePageCount       = MaxSites / SitePageSize,
+        SiteCacheSize       = 256,
+        MaxSnapshots        = 16,
+        HeaderSize          = 16,
+        HeaderMagic         = 0x7AC3,
+
+        // Site zero collects allocations once all the sites are in use.
+        OverflowSite        = 0,
+    };
+
+    struct AllocationHeader
+    {
+        dsize_t             mSize;
+        U32                 mSite;
+        U16                 mTag;
+        U16                 mMagic;
+    };
+
+    struct AllocationSite
+    {
+        const char*         mFileName;
+        U32                 mLine;
+        Memory::Tag         mTag;
+    };
+
+    struct SiteCounters
+    {
+        std::atomic<S64>    mBytes;
+        std::atomic<S64>    mBlocks;
+        std::atomic<S64>    mAllocations;
+    };
+
+    struct SiteCounterPage
+    {
+        SiteCounters        mSites[SitePageSize];
+    };
+
+    struct ThreadCounters
+    {
+        std::atomic<SiteCounterPage*>   mPages[SitePageCount];
+        std::atomic<S64>                mTagBytes[Memory::TagCount];
+        std::atomic<S64>                mTagBlocks[Memory::TagCount];
+
+        Memory::Tag                     mScopeTag;
+
+        const char*                     mCacheFileName[SiteCacheSize];
+        U32                             mCacheLine[SiteCacheSize];
+        U32                             mCacheSite[SiteCacheSize];
+
+        ThreadCounters*                 mpNext;
+    };
+
+    struct SiteTotals
+    {
+        U32                 mSite;
+        S64                 mBytes;
+        S64                 mBlocks;
+        S64                 mAllocations;
+    };
+
+    struct Snapshot
+    {
+        U32                 mId;
+        U32                 mSiteCount;
+        S64*                mpBytes;
+        S64*                mpBlocks;
+    };
+
+    typedef void (*PrintCallback)( const char* pFormat, ... );
+
+    // The header must preserve the alignment malloc provides.
+    typedef char AllocationHeaderFits[ sizeof(AllocationHeader) <= HeaderSize ? 1 : -1 ];
+
+    AllocationSite                  smSites[MaxSites];
+    U32                             smSiteTable[SiteTableSize];
+    std::atomic<U32>                smSiteCount( 1 );
+    std::atomic_flag                smSiteLock = ATOMIC_FLAG_INIT;
+
+    std::atomic<ThreadCounters*>    smThreadList( NULL );
+    thread_local ThreadCounters*    smpThreadCounters = NULL;
+
+    // Snapshots are only taken and compared from the main thread.
+    Snapshot                        smSnapshots[MaxSnapshots];
+    U32                             smLastSnapshotId = 0;
+
+    //-----------------------------------------------------------------------------
+
+    inline void addCounter( std::atomic<S64>& counter, const S64 value )
+    {
+        // Only the owning thread writes so a relaxed read-modify-write is enough.
+        counter.store( counter.load( std::memory_order_relaxed ) + value, std::memory_order_relaxed );
+    }
+
+    //-----------------------------------------------------------------------------
+
+    inline U32 hashSite( const char* pFileName, const U32 line )
+    {
+        return (U32)(((size_t)pFileName >> 3) * 2654435761u) ^ (line * 40503u);
+    }
+
+    //-----------------------------------------------------------------------------
+
+    Memory::Tag inferTag( const char* pFileName )
+    {
+        if ( pFileName == NULL )
+            return Memory::TagGeneral;
+
+        // Normalize the path separators.
+        char path[1024];
+        U32 index = 0;
+        for ( ; pFileName[index] != 0 && index < sizeof(path)-1; ++index )
+            path[index] = pFileName[index] == '\\' ? '/' : pFileName[index];
+        path[index] = 0;
+
+        if ( dStrstr( path, "Particle" ) != NULL )
+            return Memory::TagParticles;
+
+        if ( dStrstr( path, "2d/scene/" ) != NULL || dStrstr( path, "2d/sceneobject/" ) != NULL )
+            return Memory::TagScene;
+
+        if ( dStrstr( path, "console/" ) != NULL )
+            return Memory::TagConsole;
+
+        if ( dStrstr( path, "graphics/" ) != NULL && (dStrstr( path, "exture" ) != NULL || dStrstr( path, "itmap" ) != NULL) )
+            return Memory::TagTextures;
+
+        if ( dStrstr( path, "assets/" ) != NULL )
+            return Memory::TagAssets;
+
+        return Memory::TagGeneral;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    ThreadCounters* getThreadCounters( void )
+    {
+        // Fetch the counters for this thread.
+        ThreadCounters* pThreadCounters = smpThreadCounters;
+
+        if ( pThreadCounters != NULL )
+            return pThreadCounters;
+
+        // Create the counters.  These are never freed as other threads may still free blocks recorded against them.
+        pThreadCounters = new ThreadCounters();
+        pThreadCounters->mScopeTag = Memory::TagGeneral;
+
+        // Add to the thread list.
+        ThreadCounters* pHead = smThreadList.load( std::memory_order_relaxed );
+        do
+        {
+            pThreadCounters->mpNext = pHead;
+        }
+        while ( !smThreadList.compare_exchange_weak( pHead, pThreadCounters, std::memory_order_release, std::memory_order_relaxed ) );
+
+        smpThreadCounters = pThreadCounters;
+
+        return pThreadCounters;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    U32 findSite( ThreadCounters* pThreadCounters, const char* pFileName, const U32 line )
+    {
+        const U32 hash = hashSite( pFileName, line );
+
+        // Check the thread cache.
+        const U32 cacheIndex = hash & (SiteCacheSize-1);
+        if ( pThreadCounters->mCacheFileName[cacheIndex] == pFileName && pThreadCounters->mCacheLine[cacheIndex] == line && pFileName != NULL )
+            return pThreadCounters->mCacheSite[cacheIndex];
+
+        while ( smSiteLock.test_and_set( std::memory_order_acquire ) ) {}
+
+        // Find the site.
+        U32 site = OverflowSite;
+        U32 tableIndex = hash & (SiteTableSize-1);
+        while ( true )
+        {
+            const U32 entry = smSiteTable[tableIndex];
+
+            // Found an empty entry?
+            if ( entry == 0 )
+            {
+                // Yes, so add the site if there's room.
+                const U32 siteCount = smSiteCount.load( std::memory_order_relaxed );
+                if ( siteCount < MaxSites )
+                {
+                    AllocationSite& newSite = smSites[siteCount];
+                    newSite.mFileName = pFileName;
+                    newSite.mLine = line;
+                    newSite.mTag = inferTag( pFileName );
+                    smSiteTable[tableIndex] = siteCount;
+                    smSiteCount.store( siteCount+1, std::memory_order_release );
+                    site = siteCount;
+                }
+                break;
+            }
+
+            if ( smSites[entry].mFileName == pFileName && smSites[entry].mLine == line )
+            {
+                site = entry;
+                break;
+            }
+
+            tableIndex = (tableIndex + 1) & (SiteTableSize-1);
+        }
+
+        smSiteLock.clear( std::memory_order_release );
+
+        // Update the thread cache.
+        pThreadCounters->mCacheFileName[cacheIndex] = pFileName;
+        pThreadCounters->mCacheLine[cacheIndex] = line;
+        pThreadCounters->mCacheSite[cacheIndex] = site;
+
+        return site;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    SiteCounters& getSiteCounters( ThreadCounters* pThreadCounters, const U32 site )
+    {
+        std::atomic<SiteCounterPage*>& page = pThreadCounters->mPages[site / SitePageSize];
+
+        // Fetch the page.
+        SiteCounterPage* pPage = page.load( std::memory_order_relaxed );
+
+        // Create the page if required.
+        if ( pPage == NULL )
+        {
+            pPage = new SiteCounterPage();
+            page.store( pPage, std::memory_order_release );
+        }
+
+        return pPage->mSites[site % SitePageSize];
+    }
+
+    //-----------------------------------------------------------------------------
+
+    void* recordAllocation( void* pBlock, const dsize_t size, const char* pFileName, const U32 line )
+    {
+        ThreadCounters* pThreadCounters = getThreadCounters();
+
+        // Fetch the site.
+        const U32 site = findSite( pThreadCounters, pFileName, line );
+
+        // Use the scope tag for sites that don't belong to a subsystem.
+        const Memory::Tag tag = smSites[site].mTag != Memory::TagGeneral ? smSites[site].mTag : pThreadCounters->mScopeTag;
+
+        AllocationHeader* pHeader = (AllocationHeader*)pBlock;
+        pHeader->mSize = size;
+        pHeader->mSite = site;
+        pHeader->mTag = (U16)tag;
+        pHeader->mMagic = HeaderMagic;
+
+        SiteCounters& siteCounters = getSiteCounters( pThreadCounters, site );
+        addCounter( siteCounters.mBytes, (S64)size );
+        addCounter( siteCounters.mBlocks, 1 );
+        addCounter( siteCounters.mAllocations, 1 );
+        addCounter( pThreadCounters->mTagBytes[tag], (S64)size );
+        addCounter( pThreadCounters->mTagBlocks[tag], 1 );
+
+        return (U8*)pBlock + HeaderSize;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    void recordFree( AllocationHeader* pHeader )
+    {
+        ThreadCounters* pThreadCounters = getThreadCounters();
+
+        SiteCounters& siteCounters = getSiteCounters( pThreadCounters, pHeader->mSite );
+        addCounter( siteCounters.mBytes, -(S64)pHeader->mSize );
+        addCounter( siteCounters.mBlocks, -1 );
+        addCounter( pThreadCounters->mTagBytes[pHeader->mTag], -(S64)pHeader->mSize );
+        addCounter( pThreadCounters->mTagBlocks[pHeader->mTag], -1 );
+
+        pHeader->mMagic = 0;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    inline AllocationHeader* findHeader( void* pMemory )
+    {
+        AllocationHeader* pHeader = (AllocationHeader*)((U8*)pMemory - HeaderSize);
+
+        // Every block reaching here must have come from dMalloc_r() or dRealloc_r().
+        AssertFatal( pHeader->mMagic == HeaderMagic, "findHeader() - Block was not allocated by dMalloc_r() or has already been freed." );
+
+        return pHeader;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    U32 collectTotals( SiteTotals* pTotals, const U32 siteCount, S64* pTagBytes, S64* pTagBlocks )
+    {
+        for ( U32 site = 0; site < siteCount; ++site )
+        {
+            pTotals[site].mSite = site;
+            pTotals[site].mBytes = 0;
+            pTotals[site].mBlocks = 0;
+            pTotals[site].mAllocations = 0;
+        }
+
+        for ( U32 tag = 0; tag < Memory::TagCount; ++tag )
+        {
+            pTagBytes[tag] = 0;
+            pTagBlocks[tag] = 0;
+        }
+
+        // Sum the counters from all threads.
+        for ( ThreadCounters* pThreadCounters = smThreadList.load( std::memory_order_acquire ); pThreadCounters != NULL; pThreadCounters = pThreadCounters->mpNext )
+        {
+            for ( U32 pageIndex = 0; pageIndex < SitePageCount; ++pageIndex )
+            {
+                SiteCounterPage* pPage = pThreadCounters->mPages[pageIndex].load( std::memory_order_acquire );
+
+                if ( pPage == NULL )
+                    continue;
+
+                const U32 firstSite = pageIndex * SitePageSize;
+                for ( U32 index = 0; index < SitePageSize && firstSite + index < siteCount; ++index )
+                {
+                    const SiteCounters& siteCounters = pPage->mSites[index];
+                    SiteTotals& totals = pTotals[firstSite + index];
+                    totals.mBytes += siteCounters.mBytes.load( std::memory_order_relaxed );
+                    totals.mBlocks += siteCounters.mBlocks.load( std::memory_order_relaxed );
+                    totals.mAllocations += siteCounters.mAllocations.load( std::memory_order_relaxed );
+                }
+            }
+
+            for ( U32 tag = 0; tag < Memory::TagCount; ++tag )
+            {
+                pTagBytes[tag] += pThreadCounters->mTagBytes[tag].load( std::memory_order_relaxed );
+                pTagBlocks[tag] += pThreadCounters->mTagBlocks[tag].load( std::memory_order_relaxed );
+            }
+        }
+
+        return siteCount;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    S32 QSORT_CALLBACK compareSiteBytes( const void* a, const void* b )
+    {
+        const S64 bytesA = ((const SiteTotals*)a)->mBytes < 0 ? -((const SiteTotals*)a)->mBytes : ((const SiteTotals*)a)->mBytes;
+        const S64 bytesB = ((const SiteTotals*)b)->mBytes < 0 ? -((const SiteTotals*)b)->mBytes : ((const SiteTotals*)b)->mBytes;
+
+        return bytesA < bytesB ? 1 : bytesA > bytesB ? -1 : 0;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    void printSite( PrintCallback pPrint, const SiteTotals& totals )
+    {
+        const AllocationSite& site = smSites[totals.mSite];
+
+        if ( totals.mSite == OverflowSite )
+        {
+            pPrint( "  %12lld bytes %9lld blocks  %-10s <remaining sites>", (long long)totals.mBytes, (long long)totals.mBlocks, Memory::getTagName( site.mTag ) );
+            return;
+        }
+
+        pPrint( "  %12lld bytes %9lld blocks  %-10s %s(%d)",
+            (long long)totals.mBytes,
+            (long long)totals.mBlocks,
+            Memory::getTagName( site.mTag ),
+            site.mFileName != NULL ? site.mFileName : "<unknown>",
+            site.mLine );
+    }
+
+    //-----------------------------------------------------------------------------
+
+    void printLiveSites( PrintCallback pPrint, const U32 count )
+    {
+        const U32 siteCount = smSiteCount.load( std::memory_order_acquire );
+
+        // Collect the totals.  The C runtime is used so the report doesn't disturb what it's reporting.
+        SiteTotals* pTotals = (SiteTotals*)malloc( siteCount * sizeof(SiteTotals) );
+        S64 tagBytes[Memory::TagCount];
+        S64 tagBlocks[Memory::TagCount];
+        collectTotals( pTotals, siteCount, tagBytes, tagBlocks );
+
+        // Sort by live bytes.
+        dQsort( pTotals, siteCount, sizeof(SiteTotals), compareSiteBytes );
+
+        S64 totalBytes = 0;
+        S64 totalBlocks = 0;
+        for ( U32 tag = 0; tag < Memory::TagCount; ++tag )
+        {
+            totalBytes += tagBytes[tag];
+            totalBlocks += tagBlocks[tag];
+        }
+
+        pPrint( "Live memory: %lld bytes in %lld blocks from %d call sites.", (long long)totalBytes, (long long)totalBlocks, siteCount-1 );
+
+        pPrint( "By tag:" );
+        for ( U32 tag = 0; tag < Memory::TagCount; ++tag )
+            pPrint( "  %12lld bytes %9lld blocks  %s", (long long)tagBytes[tag], (long long)tagBlocks[tag], Memory::getTagName( (Memory::Tag)tag ) );
+
+        pPrint( "By call site:" );
+        for ( U32 index = 0; index < siteCount && index < count; ++index )
+        {
+            if ( pTotals[index].mBlocks == 0 && pTotals[index].mBytes == 0 )
+                break;
+
+            printSite( pPrint, pTotals[index] );
+        }
+
+        free( pTotals );
+    }
+
+    //-----------------------------------------------------------------------------
+
+    void printReportLine( const char* pFormat, ... )
+    {
+        char buffer[1024];
+        va_list args;
+        va_start( args, pFormat );
+        dVsprintf( buffer, sizeof(buffer), pFormat, args );
+        va_end( args );
+
+        dPrintf( "%s\n", buffer );
+    }
+
+    //-----------------------------------------------------------------------------
+
+    Snapshot* findSnapshot( const U32 snapshotId )
+    {
+        if ( snapshotId == 0 )
+            return NULL;
+
+        Snapshot& snapshot = smSnapshots[(snapshotId-1) % MaxSnapshots];
+
+        return snapshot.mId == snapshotId ? &snapshot : NULL;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void* dMalloc_r(dsize_t in_size, const char* fileName, const dsize_t line)
+{
+   void* pBlock = malloc(in_size + HeaderSize);
+
+   if ( pBlock == NULL )
+       return NULL;
+
+   return recordAllocation( pBlock, in_size, fileName, (U32)line );
+}
+
+//-----------------------------------------------------------------------------
+
+void dFree(void* in_pFree)
+{
+   if ( in_pFree == NULL )
+       return;
+
+   AllocationHeader* pHeader = findHeader( in_pFree );
+
+   recordFree( pHeader );
+   free( pHeader );
+}
+
+//-----------------------------------------------------------------------------
+
+void* dRealloc_r(void* in_pResize, dsize_t in_size, const char* fileName, const dsize_t line)
+{
+   if ( in_pResize == NULL )
+       return dMalloc_r( in_size, fileName, line );
+
+   AllocationHeader* pHeader = findHeader( in_pResize );
+
+   // Account for the block as freed then allocated again at this call site.
+   const dsize_t previousSize = pHeader->mSize;
+   recordFree( pHeader );
+
+   void* pBlock = realloc( pHeader, in_size + HeaderSize );
+
+   if ( pBlock == NULL )
+   {
+       // The original block is untouched so record it again.
+       recordAllocation( pHeader, previousSize, fileName, (U32)line );
+       return NULL;
+   }
+
+   return recordAllocation( pBlock, in_size, fileName, (U32)line );
+}
+
+//-----------------------------------------------------------------------------
+
+Memory::TagScope::TagScope( const Tag tag )
+{
+    ThreadCounters* pThreadCounters = getThreadCounters();
+    mPreviousTag = pThreadCounters->mScopeTag;
+    pThreadCounters->mScopeTag = tag;
+}
+
+//-----------------------------------------------------------------------------
+
+Memory::TagScope::~TagScope()
+{
+    getThreadCounters()->mScopeTag = mPreviousTag;
+}
+
+//-----------------------------------------------------------------------------
+
+bool Memory::isTracking( void )
+{
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void Memory::dumpAllocations( const U32 count )
+{
+    printLiveSites( &Con::printf, count );
+}
+
+//-----------------------------------------------------------------------------
+
+U32 Memory::takeSnapshot( void )
+{
+    const U32 siteCount = smSiteCount.load( std::memory_order_acquire );
+
+    SiteTotals* pTotals = (SiteTotals*)malloc( siteCount * sizeof(SiteTotals) );
+    S64 tagBytes[TagCount];
+    S64 tagBlocks[TagCount];
+    collectTotals( pTotals, siteCount, tagBytes, tagBlocks );
+
+    // Reuse the oldest snapshot.
+    const U32 snapshotId = ++smLastSnapshotId;
+    Snapshot& snapshot = smSnapshots[(snapshotId-1) % MaxSnapshots];
+    free( snapshot.mpBytes );
+    free( snapshot.mpBlocks );
+
+    snapshot.mId = snapshotId;
+    snapshot.mSiteCount = siteCount;
+    snapshot.mpBytes = (S64*)malloc( siteCount * sizeof(S64) );
+    snapshot.mpBlocks = (S64*)malloc( siteCount * sizeof(S64) );
+
+    for ( U32 site = 0; site < siteCount; ++site )
+    {
+        snapshot.mpBytes[site] = pTotals[site].mBytes;
+        snapshot.mpBlocks[site] = pTotals[site].mBlocks;
+    }
+
+    free( pTotals );
+
+    return snapshotId;
+}
+
+//-----------------------------------------------------------------------------
+
+void Memory::dumpSnapshotDiff( const U32 fromSnapshotId, const U32 toSnapshotId, const U32 count )
+{
+    // Fetch the snapshots.
+    const Snapshot* pFromSnapshot = findSnapshot( fromSnapshotId );
+    const Snapshot* pToSnapshot = findSnapshot( toSnapshotId );
+
+    if ( pFromSnapshot == NULL || pToSnapshot == NULL )
+    {
+        Con::warnf( "Memory::dumpSnapshotDiff() - Snapshot '%d' or '%d' is not available.  Only the last %d snapshots are kept.", fromSnapshotId, toSnapshotId, MaxSnapshots );
+        return;
+    }
+
+    // Sites are only ever added so the later snapshot may have more.
+    const U32 siteCount = getMax( pFromSnapshot->mSiteCount, pToSnapshot->mSiteCount );
+
+    SiteTotals* pDeltas = (SiteTotals*)malloc( siteCount * sizeof(SiteTotals) );
+    S64 totalBytes = 0;
+    S64 totalBlocks = 0;
+    for ( U32 site = 0; site < siteCount; ++site )
+    {
+        const S64 fromBytes = site < pFromSnapshot->mSiteCount ? pFromSnapshot->mpBytes[site] : 0;
+        const S64 fromBlocks = site < pFromSnapshot->mSiteCount ? pFromSnapshot->mpBlocks[site] : 0;
+        const S64 toBytes = site < pToSnapshot->mSiteCount ? pToSnapshot->mpBytes[site] : 0;
+        const S64 toBlocks = site < pToSnapshot->mSiteCount ? pToSnapshot->mpBlocks[site] : 0;
+
+        SiteTotals& delta = pDeltas[site];
+        delta.mSite = site;
+        delta.mBytes = toBytes - fromBytes;
+        delta.mBlocks = toBlocks - fromBlocks;
+        delta.mAllocations = 0;
+
+        totalBytes += delta.mBytes;
+        totalBlocks += delta.mBlocks;
+    }
+
+    // Sort by the size of the change.
+    dQsort( pDeltas, siteCount, sizeof(SiteTotals), compareSiteBytes );
+
+    Con::printf( "Live memory change from snapshot %d to %d: %lld bytes in %lld blocks.", fromSnapshotId, toSnapshotId, (long long)totalBytes, (long long)totalBlocks );
+    for ( U32 index = 0; index < siteCount && index < count; ++index )
+    {
+        if ( pDeltas[index].mBytes == 0 && pDeltas[index].mBlocks == 0 )
+            break;
+
+        printSite( &Con::printf, pDeltas[index] );
+    }
+
+    free( pDeltas );
+}
+
+//-----------------------------------------------------------------------------
+
+void Memory::reportLeaks( const U32 count )
+{
+    printReportLine( "Memory still allocated at shutdown:" );
+    printLiveSites( &printReportLine, count );
+}
+
+#endif // TORQUE_MEMORY_TRACKING
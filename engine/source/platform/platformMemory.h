@@ -76,4 +76,64 @@ extern void* dMemmove(void *dst, const void *src, dsize_t size);
 extern void* dMemset(void *dst, int c, dsize_t size);
 extern int   dMemcmp(const void *ptr1, const void *ptr2, dsize_t size);
 
+//------------------------------------------------------------------------------
+/// Tagged memory accounting.
+///
+/// When built with TORQUE_MEMORY_TRACKING, every allocation made through dMalloc_r()
+/// and dRealloc_r() is recorded against its call site and a subsystem tag.  Counters
+/// are kept per thread and only summed when they are reported.  Every block passed to
+/// dFree() or dRealloc_r() must have come from dMalloc_r() or dRealloc_r().  Without it
+/// the allocator forwards straight to the C runtime and the reports are unavailable.
+
+namespace Memory
+{
+    enum Tag
+    {
+        TagGeneral,
+        TagScene,
+        TagParticles,
+        TagConsole,
+        TagTextures,
+        TagAssets,
+
+        TagCount
+    };
+
+    /// Allocations from call sites that don't belong to a subsystem (containers,
+    /// strings etc) made on this thread are tagged with the innermost scope tag.
+#ifdef TORQUE_MEMORY_TRACKING
+    class TagScope
+    {
+    public:
+        TagScope( const Tag tag );
+        ~TagScope();
+
+    private:
+        Tag mPreviousTag;
+    };
+#else
+    class TagScope
+    {
+    public:
+        TagScope( const Tag tag ) {}
+    };
+#endif
+
+    extern const char* getTagName( const Tag tag );
+    extern bool isTracking( void );
+
+    /// Dump the call sites holding the most live memory along with the totals per tag.
+    extern void dumpAllocations( const U32 count );
+
+    /// Record the live memory per call site.  Returns the snapshot Id or zero if tracking is unavailable.
+    extern U32 takeSnapshot( void );
+
+    /// Dump the call sites whose live memory changed the most between two snapshots.
+    extern void dumpSnapshotDiff( const U32 fromSnapshotId, const U32 toSnapshotId, const U32 count );
+
+    /// Report the call sites still holding memory.  This is intended for shutdown
+    /// and doesn't rely on the console.
+    extern void reportLeaks( const U32 count );
+}
+
 #endif // _PLATFORM_MEMORY_H_
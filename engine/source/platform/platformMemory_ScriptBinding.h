@@ -0,0 +1,63 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+/*! @defgroup MemoryFunctions Memory
+    @ingroup TorqueScriptFunctions
+    @{
+*/
+
+/*! Dumps the call sites holding the most live memory along with the live memory per subsystem tag.
+    Only available when the engine is built with TORQUE_MEMORY_TRACKING.
+    @param count The maximum number of call sites to dump.  Defaults to 20.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs( dumpMemoryAllocations, ConsoleVoid, 1, 2, ([count]))
+{
+    Memory::dumpAllocations( argc > 1 ? (U32)getMax( dAtoi(argv[1]), 0 ) : 20 );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Records the live memory per call site so that it can be compared with a later snapshot.
+    Only the most recent snapshots are kept.
+    @return The snapshot Id or zero if memory tracking is not available.
+*/
+ConsoleFunctionWithDocs( takeMemorySnapshot, ConsoleInt, 1, 1, ())
+{
+    return (S32)Memory::takeSnapshot();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Dumps the call sites whose live memory changed the most between two snapshots.
+    @param fromSnapshotId The earlier snapshot Id.
+    @param toSnapshotId The later snapshot Id.
+    @param count The maximum number of call sites to dump.  Defaults to 20.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs( dumpMemorySnapshotDiff, ConsoleVoid, 3, 4, (fromSnapshotId, toSnapshotId, [count]))
+{
+    Memory::dumpSnapshotDiff( (U32)getMax( dAtoi(argv[1]), 0 ), (U32)getMax( dAtoi(argv[2]), 0 ), argc > 3 ? (U32)getMax( dAtoi(argv[3]), 0 ) : 20 );
+}
+
+/*! @} */ // group MemoryFunctions
@@ -21,7 +21,9 @@
 //-----------------------------------------------------------------------------
 
 #include "platform/platformNet.h"
+#include "platform/platformNetPacket.h"
 #include "platform/threads/mutex.h"
+#include "platform/threads/thread.h"
 #include "platform/event.h"
 #include "algorithm/hashFunction.h"
 #include "console/console.h"
@@ -29,6 +31,7 @@
 #include "io/fileStream.h"
 #include "collection/vector.h"
 #include "platform/platformNetAsync.h"
+#include "debug/profiler.h"
 #include <string.h>
 
 // jamesu - debug DNS
@@ -74,10 +77,13 @@ typedef int SOCKET;
 
 #elif defined( TORQUE_OS_LINUX )
 
+#define TORQUE_USE_EPOLL
+
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/poll.h>
+#include <sys/epoll.h>
 #include <arpa/inet.h>
 #include <netdb.h>
 #include <netinet/in.h>
@@ -215,6 +221,16 @@ namespace PlatformNetState
 
    static ReservedSocketList<SOCKET> smReservedSocketList;
 
+   /// Received packets waiting for the main thread.
+   static const U32 packetPoolSize = 256;
+   static NetPacketPool *packetPool = NULL;
+
+   /// Optional thread reading the UDP sockets.  It only sees the descriptors
+   /// it was started with and is stopped whenever the port changes.
+   static Thread *receiveThread = NULL;
+   static std::atomic<bool> receiveShutdown(false);
+   static SOCKET receiveSockets[2];
+
    Net::Error getLastError()
    {
 #if defined(TORQUE_USE_WINSOCK)
@@ -519,6 +535,7 @@ struct PolledSocket
       state = InvalidState;
       remoteAddr[0] = 0;
       remotePort = -1;
+      pollEvents = 0;
    }
 
    SOCKET fd;
@@ -526,11 +543,88 @@ struct PolledSocket
    S32 state;
    char remoteAddr[256];
    S32 remotePort;
+   U32 pollEvents;   // events we are registered for with the poller
 };
 
 // list of polled sockets
 static Vector<PolledSocket*> gPolledSockets( __FILE__, __LINE__ );
 
+#if defined(TORQUE_USE_EPOLL)
+
+// Sockets are serviced only when epoll reports them ready, so idle
+// connections cost nothing per tick.  Name lookups have no descriptor
+// to wait on and are swept from the polled list until they resolve.
+static const S32 EpollBatchSize = 256;
+static const S32 RecvBatchSize = 16;
+
+static int gEpollFd = -1;
+static Vector<PolledSocket*> gReadySockets( __FILE__, __LINE__ );
+static bool gPolledSocketsNeedSweep = false;
+
+static void watchPolledSocket(PolledSocket *sock)
+{
+   if (gEpollFd == -1)
+      return;
+
+   U32 events = 0;
+   if (sock->fd != -1)
+   {
+      switch (sock->state)
+      {
+      case PolledSocket::ConnectionPending:
+         // connect completion is reported as writable
+         events = EPOLLOUT;
+         break;
+      case PolledSocket::Connected:
+      case PolledSocket::Listening:
+         events = EPOLLIN;
+         break;
+      }
+   }
+
+   if (events == sock->pollEvents)
+      return;
+
+   epoll_event event;
+   event.events = events;
+   event.data.ptr = sock;
+
+   const int op = sock->pollEvents == 0 ? EPOLL_CTL_ADD : ( events == 0 ? EPOLL_CTL_DEL : EPOLL_CTL_MOD );
+   if (epoll_ctl(gEpollFd, op, sock->fd, &event) == -1)
+   {
+      Con::errorf("Error watching socket: %s", strerror(errno));
+      return;
+   }
+
+   sock->pollEvents = events;
+}
+
+static void unwatchPolledSocket(PolledSocket *sock)
+{
+   if (gEpollFd != -1 && sock->pollEvents != 0)
+   {
+      epoll_event event;
+      event.events = 0;
+      event.data.ptr = sock;
+      epoll_ctl(gEpollFd, EPOLL_CTL_DEL, sock->fd, &event);
+      sock->pollEvents = 0;
+   }
+
+   // it may be waiting to be serviced this tick
+   for (S32 i = 0; i < gReadySockets.size(); ++i)
+   {
+      if (gReadySockets[i] == sock)
+         gReadySockets[i] = NULL;
+   }
+}
+
+#else
+
+static inline void watchPolledSocket(PolledSocket *sock) {}
+static inline void unwatchPolledSocket(PolledSocket *sock) {}
+
+#endif
+
 static PolledSocket* addPolledSocket(NetSocket handleFd, SOCKET fd, S32 state,
                                char* remoteAddr = NULL, S32 port = -1)
 {
@@ -543,6 +637,11 @@ static PolledSocket* addPolledSocket(NetSocket handleFd, SOCKET fd, S32 state,
    if (port != -1)
       sock->remotePort = port;
    gPolledSockets.push_back(sock);
+   watchPolledSocket(sock);
+#if defined(TORQUE_USE_EPOLL)
+   if (state == PolledSocket::NameLookupRequired)
+      gPolledSocketsNeedSweep = true;
+#endif
    return sock;
 }
 
@@ -575,6 +674,16 @@ bool Net::init()
       //logprintf("Winsock initialization %s", success ? "succeeded." : "failed!");
    }
 #endif
+#if defined(TORQUE_USE_EPOLL)
+   if (gEpollFd == -1)
+   {
+      gEpollFd = epoll_create1(EPOLL_CLOEXEC);
+      AssertISV( gEpollFd != -1, "Net::init - failed to create epoll instance!" );
+   }
+#endif
+   if (!PlatformNetState::initCount)
+      PlatformNetState::packetPool = new NetPacketPool(PlatformNetState::packetPoolSize);
+
    PlatformNetState::initCount++;
 
 
@@ -595,6 +704,20 @@ void Net::shutdown()
    closePort();
    PlatformNetState::initCount--;
 
+   if (!PlatformNetState::initCount)
+   {
+      delete PlatformNetState::packetPool;
+      PlatformNetState::packetPool = NULL;
+   }
+
+#if defined(TORQUE_USE_EPOLL)
+   if (!PlatformNetState::initCount && gEpollFd != -1)
+   {
+      ::close(gEpollFd);
+      gEpollFd = -1;
+   }
+#endif
+
 
 #if defined(TORQUE_USE_WINSOCK)
    if(!PlatformNetState::initCount)
@@ -868,8 +991,12 @@ void Net::closeConnectTo(NetSocket handleFd)
    {
       if (gPolledSockets[i] && gPolledSockets[i]->handleFd == handleFd)
       {
+         unwatchPolledSocket(gPolledSockets[i]);
          delete gPolledSockets[i];
          gPolledSockets[i] = NULL;
+#if defined(TORQUE_USE_EPOLL)
+         gPolledSocketsNeedSweep = true;
+#endif
          break;
       }
    }
@@ -909,6 +1036,8 @@ Net::Error Net::sendtoSocket(NetSocket handleFd, const U8 *buffer, S32  bufferSi
 
 bool Net::openPort(S32 port, bool doBind)
 {
+   stopReceiveThread();
+
    if (PlatformNetState::udpSocket != NetSocket::INVALID)
    {
       closeSocket(PlatformNetState::udpSocket);
@@ -1046,6 +1175,9 @@ bool Net::openPort(S32 port, bool doBind)
 
    PlatformNetState::netPort = port;
 
+   if (Con::getBoolVariable("pref::Net::ReceiveThread", false))
+      startReceiveThread();
+
    return PlatformNetState::udpSocket != NetSocket::INVALID || PlatformNetState::udp6Socket != NetSocket::INVALID;
 }
 
@@ -1056,6 +1188,8 @@ NetSocket Net::getPort()
 
 void Net::closePort()
 {
+   stopReceiveThread();
+
    if (PlatformNetState::udpSocket != NetSocket::INVALID)
       closeSocket(PlatformNetState::udpSocket);
    if (PlatformNetState::udp6Socket != NetSocket::INVALID)
@@ -1112,18 +1246,8 @@ Net::Error Net::sendto(const NetAddress *address, const U8 *buffer, S32  bufferS
    return WrongProtocolType;
 }
 
-void Net::process()
+bool Net::processPolledSocket(PolledSocket *currentSock)
 {
-   // Process listening sockets
-   processListenSocket(PlatformNetState::udpSocket);
-   processListenSocket(PlatformNetState::udp6Socket);
-
-   // process the polled sockets.  This blob of code performs functions
-   // similar to WinsockProc in winNet.cc
-
-   if (gPolledSockets.size() == 0)
-      return;
-
    static ConnectedNotifyEvent notifyEvent;
    static ConnectedAcceptEvent acceptEvent;
    static ConnectedReceiveEvent cReceiveEvent;
@@ -1133,287 +1257,542 @@ void Net::process()
    S32 bytesRead;
    Net::Error err;
    bool removeSock = false;
-   PolledSocket *currentSock = NULL;
    NetSocket incomingHandleFd = NetSocket::INVALID;
    NetAddress out_h_addr;
    S32 out_h_length = 0;
-   NetSocket removeSockHandle;
 
-   for (S32 i = 0; i < gPolledSockets.size();
-      /* no increment, this is done at end of loop body */)
+   switch (currentSock->state)
    {
-      removeSock = false;
-      currentSock = gPolledSockets[i];
-
-      // Cleanup if we've removed it
-      if (currentSock == NULL)
+   case PolledSocket::InvalidState:
+      Con::errorf("Error, InvalidState socket in polled sockets  list");
+      break;
+   case PolledSocket::ConnectionPending:
+      // see if it is now connected
+      if (getsockopt(currentSock->fd, SOL_SOCKET, SO_ERROR,
+         (char*)&optval, &optlen) == -1)
       {
-         gPolledSockets.erase(i);
-         continue;
-      }
+         Con::errorf("Error getting socket options: %s",  strerror(errno));
+
+         removeSock = true;
 
-      switch (currentSock->state)
+         notifyEvent.state = ConnectedNotifyEvent::ConnectFailed;
+				notifyEvent.tag = currentSock->handleFd;
+         Game->postEvent(notifyEvent);
+      }
+      else
       {
-      case PolledSocket::InvalidState:
-         Con::errorf("Error, InvalidState socket in polled sockets  list");
-         break;
-      case PolledSocket::ConnectionPending:
-         // see if it is now connected
-         if (getsockopt(currentSock->fd, SOL_SOCKET, SO_ERROR,
-            (char*)&optval, &optlen) == -1)
-         {
-            Con::errorf("Error getting socket options: %s",  strerror(errno));
+         if (optval == EINPROGRESS)
+            // still connecting...
+            break;
 
-            removeSock = true;
-            removeSockHandle = currentSock->handleFd;
+         if (optval == 0)
+         {
+            // poll for writable status to be sure we're connected.
+            bool ready = netSocketWaitForWritable(currentSock->handleFd,0);
+            if(!ready)
+               break;
 
-            notifyEvent.state = ConnectedNotifyEvent::ConnectFailed;
-				notifyEvent.tag = currentSock->handleFd;
+            currentSock->state = PolledSocket::Connected;
+            watchPolledSocket(currentSock);
+            notifyEvent.state = ConnectedNotifyEvent::Connected;
+					notifyEvent.tag = currentSock->handleFd;
             Game->postEvent(notifyEvent);
          }
          else
          {
-            if (optval == EINPROGRESS)
-               // still connecting...
-               break;
-
-            if (optval == 0)
-            {
-               // poll for writable status to be sure we're connected.
-               bool ready = netSocketWaitForWritable(currentSock->handleFd,0);
-               if(!ready)
-                  break;
-
-               currentSock->state = PolledSocket::Connected;
-               notifyEvent.state = ConnectedNotifyEvent::Connected;
-					notifyEvent.tag = currentSock->handleFd;
-               Game->postEvent(notifyEvent);
-            }
-            else
-            {
-               // some kind of error
-               Con::errorf("Error connecting: %s", strerror(errno));
+            // some kind of error
+            Con::errorf("Error connecting: %s", strerror(errno));
 
-               removeSock = true;
-               removeSockHandle = currentSock->handleFd;
+            removeSock = true;
 
-               notifyEvent.state = ConnectedNotifyEvent::ConnectFailed;
+            notifyEvent.state = ConnectedNotifyEvent::ConnectFailed;
 					notifyEvent.tag = currentSock->handleFd;
-               Game->postEvent(notifyEvent);
-             }
-         }
-         break;
-      case PolledSocket::Connected:
+            Game->postEvent(notifyEvent);
+          }
+      }
+      break;
+   case PolledSocket::Connected:
 
-         // try to get some data
-         bytesRead = 0;
-         err = Net::recv(currentSock->handleFd, (U8*)cReceiveEvent.data, MaxPacketDataSize, &bytesRead);
-         if(err == Net::NoError)
+      // try to get some data
+      bytesRead = 0;
+      err = Net::recv(currentSock->handleFd, (U8*)cReceiveEvent.data, MaxPacketDataSize, &bytesRead);
+      if(err == Net::NoError)
+      {
+         if (bytesRead > 0)
          {
-            if (bytesRead > 0)
-            {
-               // got some data, post it
+            // got some data, post it
 					cReceiveEvent.size = bytesRead;
-               cReceiveEvent.tag = currentSock->handleFd;
-               Game->postEvent(cReceiveEvent);
-            }
-            else
-            {
-               // ack! this shouldn't happen
-               if (bytesRead < 0)
-                  Con::errorf("Unexpected error on socket: %s", strerror(errno));
-
-               removeSock = true;
-               removeSockHandle = currentSock->handleFd;
-
-               // zero bytes read means EOF
-               notifyEvent.tag = currentSock->handleFd;
-               notifyEvent.state = ConnectedNotifyEvent::Disconnected;
-					notifyEvent.tag = currentSock->handleFd;
-               Game->postEvent(notifyEvent);
-            }
+            cReceiveEvent.tag = currentSock->handleFd;
+            Game->postEvent(cReceiveEvent);
          }
-         else if (err != Net::NoError && err != Net::WouldBlock)
+         else
          {
-            Con::errorf("Error reading from socket: %s",  strerror(errno));
+            // ack! this shouldn't happen
+            if (bytesRead < 0)
+               Con::errorf("Unexpected error on socket: %s", strerror(errno));
 
             removeSock = true;
-            removeSockHandle = currentSock->handleFd;
 
+            // zero bytes read means EOF
+            notifyEvent.tag = currentSock->handleFd;
             notifyEvent.state = ConnectedNotifyEvent::Disconnected;
-				notifyEvent.tag = currentSock->handleFd;
+					notifyEvent.tag = currentSock->handleFd;
             Game->postEvent(notifyEvent);
          }
-         break;
-      case PolledSocket::NameLookupRequired:
-         U32 newState;
+      }
+      else if (err != Net::NoError && err != Net::WouldBlock)
+      {
+         Con::errorf("Error reading from socket: %s",  strerror(errno));
 
-         // is the lookup complete?
-         if (!gNetAsync.checkLookup(
-            currentSock->handleFd, &out_h_addr, &out_h_length,
-            sizeof(out_h_addr)))
-            break;
+         removeSock = true;
 
-         if (out_h_length == -1)
-         {
-            Con::errorf("DNS lookup failed: %s", currentSock->remoteAddr);
-             notifyEvent.state = ConnectedNotifyEvent::DNSFailed;
-            newState = Net::DNSFailed;
-            removeSock = true;
-            removeSockHandle = currentSock->handleFd;
-         }
-         else
+         notifyEvent.state = ConnectedNotifyEvent::Disconnected;
+				notifyEvent.tag = currentSock->handleFd;
+         Game->postEvent(notifyEvent);
+      }
+      break;
+   case PolledSocket::NameLookupRequired:
+      U32 newState;
+
+      // is the lookup complete?
+      if (!gNetAsync.checkLookup(
+         currentSock->handleFd, &out_h_addr, &out_h_length,
+         sizeof(out_h_addr)))
+         break;
+
+      if (out_h_length == -1)
+      {
+         Con::errorf("DNS lookup failed: %s", currentSock->remoteAddr);
+          notifyEvent.state = ConnectedNotifyEvent::DNSFailed;
+         newState = Net::DNSFailed;
+         removeSock = true;
+      }
+      else
+      {
+         // try to connect
+         out_h_addr.port = currentSock->remotePort;
+         const sockaddr *ai_addr = NULL;
+         int ai_addrlen = 0;
+         sockaddr_in socketAddress;
+         sockaddr_in6 socketAddress6;
+
+         if (out_h_addr.type == NetAddress::IPAddress)
          {
-            // try to connect
-            out_h_addr.port = currentSock->remotePort;
-            const sockaddr *ai_addr = NULL;
-            int ai_addrlen = 0;
-            sockaddr_in socketAddress;
-            sockaddr_in6 socketAddress6;
-
-            if (out_h_addr.type == NetAddress::IPAddress)
-            {
-               ai_addr = (const sockaddr*)&socketAddress;
-               ai_addrlen = sizeof(socketAddress);
-               NetAddressToIPSocket(&out_h_addr, &socketAddress);
+            ai_addr = (const sockaddr*)&socketAddress;
+            ai_addrlen = sizeof(socketAddress);
+            NetAddressToIPSocket(&out_h_addr, &socketAddress);
 
-               currentSock->fd = PlatformNetState::smReservedSocketList.activate(currentSock->handleFd, AF_INET, false);
-               setBlocking(currentSock->handleFd, false);
+            currentSock->fd = PlatformNetState::smReservedSocketList.activate(currentSock->handleFd, AF_INET, false);
+            setBlocking(currentSock->handleFd, false);
 
 #ifdef TORQUE_DEBUG_LOOKUPS
-               char addrString[256];
-               NetAddress addr;
-               IPSocketToNetAddress(&socketAddress, &addr);
-               Net::addressToString(&addr, addrString);
-               Con::printf("DNS: lookup resolved to %s", addrString);
+            char addrString[256];
+            NetAddress addr;
+            IPSocketToNetAddress(&socketAddress, &addr);
+            Net::addressToString(&addr, addrString);
+            Con::printf("DNS: lookup resolved to %s", addrString);
 #endif
-            }
-            else if (out_h_addr.type == NetAddress::IPV6Address)
-            {
-               ai_addr = (const sockaddr*)&socketAddress6;
-               ai_addrlen = sizeof(socketAddress6);
-               NetAddressToIPSocket6(&out_h_addr, &socketAddress6);
+         }
+         else if (out_h_addr.type == NetAddress::IPV6Address)
+         {
+            ai_addr = (const sockaddr*)&socketAddress6;
+            ai_addrlen = sizeof(socketAddress6);
+            NetAddressToIPSocket6(&out_h_addr, &socketAddress6);
 
-               currentSock->fd = PlatformNetState::smReservedSocketList.activate(currentSock->handleFd, AF_INET6, false);
-               setBlocking(currentSock->handleFd, false);
+            currentSock->fd = PlatformNetState::smReservedSocketList.activate(currentSock->handleFd, AF_INET6, false);
+            setBlocking(currentSock->handleFd, false);
 
 #ifdef TORQUE_DEBUG_LOOKUPS
-               char addrString[256];
-               NetAddress addr;
-               IPSocket6ToNetAddress(&socketAddress6, &addr);
-               Net::addressToString(&addr, addrString);
-               Con::printf("DNS: lookup resolved to %s", addrString);
+            char addrString[256];
+            NetAddress addr;
+            IPSocket6ToNetAddress(&socketAddress6, &addr);
+            Net::addressToString(&addr, addrString);
+            Con::printf("DNS: lookup resolved to %s", addrString);
 #endif
-            }
-            else
-            {
-               Con::errorf("Error connecting to %s: Invalid Protocol",
-               currentSock->remoteAddr);
-               notifyEvent.state = ConnectedNotifyEvent::ConnectFailed;
-               newState = Net::ConnectFailed;
-               removeSock = true;
-               removeSockHandle = currentSock->handleFd;
-            }
+         }
+         else
+         {
+            Con::errorf("Error connecting to %s: Invalid Protocol",
+            currentSock->remoteAddr);
+            notifyEvent.state = ConnectedNotifyEvent::ConnectFailed;
+            newState = Net::ConnectFailed;
+            removeSock = true;
+         }
 
-            if (ai_addr)
+         if (ai_addr)
+         {
+            if (::connect(currentSock->fd, ai_addr,
+               ai_addrlen) == -1)
             {
-               if (::connect(currentSock->fd, ai_addr,
-                  ai_addrlen) == -1)
+               err = PlatformNetState::getLastError();
+               if (err != Net::WouldBlock)
                {
-                  err = PlatformNetState::getLastError();
-                  if (err != Net::WouldBlock)
-                  {
-                     Con::errorf("Error connecting to %s: %u",
-                     currentSock->remoteAddr, err);
-                     notifyEvent.state = ConnectedNotifyEvent::ConnectFailed;
-                     newState = Net::ConnectFailed;
-                     removeSock = true;
-                     removeSockHandle = currentSock->handleFd;
-                  }
-                  else
-                  {
-                     notifyEvent.state = ConnectedNotifyEvent::DNSResolved;
-                     newState = Net::DNSResolved;
-                     currentSock->state = PolledSocket::ConnectionPending;
-                  }
+                  Con::errorf("Error connecting to %s: %u",
+                  currentSock->remoteAddr, err);
+                  notifyEvent.state = ConnectedNotifyEvent::ConnectFailed;
+                  newState = Net::ConnectFailed;
+                  removeSock = true;
                }
                else
                {
-                  notifyEvent.state = ConnectedNotifyEvent::Connected;
-                  newState = Net::Connected;
-                  currentSock->state = Connected;
+                  notifyEvent.state = ConnectedNotifyEvent::DNSResolved;
+                  newState = Net::DNSResolved;
+                  currentSock->state = PolledSocket::ConnectionPending;
+                  watchPolledSocket(currentSock);
                }
             }
+            else
+            {
+               notifyEvent.state = ConnectedNotifyEvent::Connected;
+               newState = Net::Connected;
+               currentSock->state = Connected;
+               watchPolledSocket(currentSock);
+            }
          }
+      }
 			notifyEvent.tag = currentSock->handleFd;
-         Game->postEvent(notifyEvent);
-         break;
-      case PolledSocket::Listening:
+      Game->postEvent(notifyEvent);
+      break;
+   case PolledSocket::Listening:
+
+      incomingHandleFd = Net::accept(currentSock->handleFd, &acceptEvent.address);
+      if(incomingHandleFd != NetSocket::INVALID)
+      {
+         setBlocking(incomingHandleFd, false);
+         addPolledSocket(incomingHandleFd, PlatformNetState::smReservedSocketList.resolve(incomingHandleFd), Connected);
+         acceptEvent.portTag = currentSock->handleFd;
+         acceptEvent.connectionTag = incomingHandleFd;
+         Game->postEvent(acceptEvent);
+      }
+      break;
+   }
+
+   return removeSock;
+}
+
+void Net::process()
+{
+   // Process listening sockets, unless the receive thread is reading them
+   if (PlatformNetState::receiveThread == NULL)
+   {
+      processListenSocket(PlatformNetState::udpSocket);
+      processListenSocket(PlatformNetState::udp6Socket);
+   }
+
+   dispatchPackets();
+
+   // process the polled sockets.  This blob of code performs functions
+   // similar to WinsockProc in winNet.cc
+
+   if (gPolledSockets.size() == 0)
+      return;
+
+   // Debug Profiling.
+   PROFILE_SCOPE(Net_ProcessPolledSockets);
+
+   PolledSocket *currentSock = NULL;
+
+#if defined(TORQUE_USE_EPOLL)
+   // Service the sockets that are ready.  Anything beyond the batch stays
+   // ready and is picked up next tick.
+   epoll_event events[EpollBatchSize];
+   const S32 readyCount = epoll_wait(gEpollFd, events, EpollBatchSize, 0);
+
+   for (S32 i = 0; i < readyCount; ++i)
+      gReadySockets.push_back((PolledSocket*)events[i].data.ptr);
+
+   for (S32 i = 0; i < gReadySockets.size(); ++i)
+   {
+      // Cleanup if we've removed it
+      currentSock = gReadySockets[i];
+      if (currentSock == NULL)
+         continue;
+
+      // events may close the socket while it is processed
+      const NetSocket handleFd = currentSock->handleFd;
+      if (processPolledSocket(currentSock))
+         closeConnectTo(handleFd);
+   }
+
+   gReadySockets.clear();
+
+   if (!gPolledSocketsNeedSweep)
+      return;
 
-         incomingHandleFd = Net::accept(currentSock->handleFd, &acceptEvent.address);
-         if(incomingHandleFd != NetSocket::INVALID)
+   // Compact the polled list and check on pending name lookups.
+   gPolledSocketsNeedSweep = false;
+
+   for (S32 i = 0; i < gPolledSockets.size();
+      /* no increment, this is done at end of loop body */)
+   {
+      currentSock = gPolledSockets[i];
+
+      // Cleanup if we've removed it
+      if (currentSock == NULL)
+      {
+         gPolledSockets.erase(i);
+         continue;
+      }
+
+      if (currentSock->state == PolledSocket::NameLookupRequired)
+      {
+         // the removal will null the entry which is then erased above
+         const NetSocket handleFd = currentSock->handleFd;
+         if (processPolledSocket(currentSock))
          {
-            setBlocking(incomingHandleFd, false);
-            addPolledSocket(incomingHandleFd, PlatformNetState::smReservedSocketList.resolve(incomingHandleFd), Connected);
-            acceptEvent.portTag = currentSock->handleFd;
-            acceptEvent.connectionTag = incomingHandleFd;
-            Game->postEvent(acceptEvent);
+            closeConnectTo(handleFd);
+            continue;
          }
-         break;
+
+         if (gPolledSockets[i] == currentSock && currentSock->state == PolledSocket::NameLookupRequired)
+            gPolledSocketsNeedSweep = true;
+      }
+
+      i++;
+   }
+#else
+   for (S32 i = 0; i < gPolledSockets.size();
+      /* no increment, this is done at end of loop body */)
+   {
+      currentSock = gPolledSockets[i];
+
+      // Cleanup if we've removed it
+      if (currentSock == NULL)
+      {
+         gPolledSockets.erase(i);
+         continue;
       }
 
       // only increment index if we're not removing the connection,  since
       // the removal will shift the indices down by one
-      if (removeSock)
-         closeConnectTo(removeSockHandle);
+      if (processPolledSocket(currentSock))
+         closeConnectTo(currentSock->handleFd);
       else
          i++;
    }
+#endif
 }
 
-void Net::processListenSocket(NetSocket socketHandle)
+static bool isLoopbackSelf(const NetAddress &address)
 {
-   if (socketHandle == NetSocket::INVALID)
-      return;
-   PacketReceiveEvent receiveEvent;
+   return address.type == NetAddress::IPAddress &&
+      address.address.ipv4.netNum[0] == 127 &&
+      address.address.ipv4.netNum[1] == 0 &&
+      address.address.ipv4.netNum[2] == 0 &&
+      address.address.ipv4.netNum[3] == 1 &&
+      address.port == PlatformNetState::netPort;
+}
+
+static bool sockAddrToNetAddress(const sockaddr_storage &sa, NetAddress *address)
+{
+   if (sa.ss_family == AF_INET)
+      IPSocketToNetAddress((sockaddr_in *)&sa, address);
+   else if (sa.ss_family == AF_INET6)
+      IPSocket6ToNetAddress((sockaddr_in6 *)&sa, address);
+   else
+      return false;
+
+   return true;
+}
+
+/// Receive waiting datagrams straight into pooled buffers and post them to the
+/// main thread.  Returns false if the pool ran out of buffers, in which case
+/// the rest are left in the socket.
+static bool receivePackets(SOCKET socketFd)
+{
+   NetPacketPool *pool = PlatformNetState::packetPool;
+
+#if defined(TORQUE_USE_EPOLL)
+   // Drain the socket a batch of datagrams per call.
+   NetPacketBuffer *buffers[RecvBatchSize];
+   sockaddr_storage sa[RecvBatchSize];
+   iovec iov[RecvBatchSize];
+   mmsghdr msgs[RecvBatchSize];
+
+   for (;;)
+   {
+      S32 bufferCount = 0;
+      while (bufferCount < RecvBatchSize)
+      {
+         NetPacketBuffer *buffer = pool->allocate();
+         if (buffer == NULL)
+            break;
+
+         buffers[bufferCount] = buffer;
+         iov[bufferCount].iov_base = buffer->data;
+         iov[bufferCount].iov_len = Net::MaxPacketDataSize;
+
+         dMemset(&msgs[bufferCount], 0, sizeof(mmsghdr));
+         msgs[bufferCount].msg_hdr.msg_name = &sa[bufferCount];
+         msgs[bufferCount].msg_hdr.msg_namelen = sizeof(sa[bufferCount]);
+         msgs[bufferCount].msg_hdr.msg_iov = &iov[bufferCount];
+         msgs[bufferCount].msg_hdr.msg_iovlen = 1;
+         bufferCount++;
+      }
+
+      if (bufferCount == 0)
+         return false;
+
+      S32 count = ::recvmmsg(socketFd, msgs, bufferCount, MSG_DONTWAIT, NULL);
+      if (count < 0)
+         count = 0;
+
+      for (S32 i = 0; i < bufferCount; ++i)
+      {
+         NetPacketBuffer *buffer = buffers[i];
+         if (i >= count ||
+            !sockAddrToNetAddress(sa[i], &buffer->sourceAddress) ||
+            msgs[i].msg_len == 0 ||
+            isLoopbackSelf(buffer->sourceAddress))
+         {
+            pool->recycle(buffer);
+            continue;
+         }
+
+         buffer->size = msgs[i].msg_len;
+         pool->post(buffer);
+      }
+
+      if (count < bufferCount)
+         return true;
+      if (bufferCount < RecvBatchSize)
+         return false;
+   }
+#else
+   NetPacketBuffer *buffer = NULL;
 
    sockaddr_storage sa;
    sa.ss_family = AF_UNSPEC;
 
-   SOCKET socketFd = PlatformNetState::smReservedSocketList.resolve(socketHandle);
-
    for (;;)
    {
-      socklen_t addrLen = sizeof(sa);
-      S32 bytesRead = -1;
+      if (buffer == NULL)
+      {
+         buffer = pool->allocate();
+         if (buffer == NULL)
+            return false;
+      }
 
-      if (socketHandle != NetSocket::INVALID)
-         bytesRead = ::recvfrom(socketFd, (char *)receiveEvent.data, Net::MaxPacketDataSize, 0, (struct sockaddr*)&sa, &addrLen);
+      socklen_t addrLen = sizeof(sa);
+      S32 bytesRead = ::recvfrom(socketFd, (char *)buffer->data, Net::MaxPacketDataSize, 0, (struct sockaddr*)&sa, &addrLen);
 
       if (bytesRead == -1)
          break;
 
-      if (sa.ss_family == AF_INET)
-         IPSocketToNetAddress((sockaddr_in *)&sa, &receiveEvent.sourceAddress);
-      else if (sa.ss_family == AF_INET6)
-        IPSocket6ToNetAddress((sockaddr_in6 *)&sa, &receiveEvent.sourceAddress);
-     else
+      if (!sockAddrToNetAddress(sa, &buffer->sourceAddress))
          continue;
 
       if (bytesRead <= 0)
          continue;
 
-      if (receiveEvent.sourceAddress.type == NetAddress::IPAddress &&
-			receiveEvent.sourceAddress.address.ipv4.netNum[0] == 127 &&
-			receiveEvent.sourceAddress.address.ipv4.netNum[1] == 0 &&
-			receiveEvent.sourceAddress.address.ipv4.netNum[2] == 0 &&
-			receiveEvent.sourceAddress.address.ipv4.netNum[3] == 1 &&
-			receiveEvent.sourceAddress.port == PlatformNetState::netPort)
+      if (isLoopbackSelf(buffer->sourceAddress))
          continue;
 
-		receiveEvent.size = bytesRead;
-      Game->postEvent(receiveEvent);
+      buffer->size = bytesRead;
+      pool->post(buffer);
+      buffer = NULL;
    }
+
+   if (buffer != NULL)
+      pool->recycle(buffer);
+
+   return true;
+#endif
+}
+
+void Net::processListenSocket(NetSocket socketHandle)
+{
+   if (socketHandle == NetSocket::INVALID)
+      return;
+
+   receivePackets(PlatformNetState::smReservedSocketList.resolve(socketHandle));
+}
+
+static void receiveThreadProc(void *)
+{
+   while (!PlatformNetState::receiveShutdown.load())
+   {
+      // Wait briefly for a datagram so shutdown is noticed promptly.
+      fd_set readfds;
+      FD_ZERO(&readfds);
+      SOCKET maxFd = 0;
+      for (U32 i = 0; i < 2; i++)
+      {
+         const SOCKET socketFd = PlatformNetState::receiveSockets[i];
+         if (socketFd == InvalidSocketHandle)
+            continue;
+
+         FD_SET(socketFd, &readfds);
+         if (socketFd > maxFd)
+            maxFd = socketFd;
+      }
+
+      timeval timeout;
+      timeout.tv_sec = 0;
+      timeout.tv_usec = 10000;
+
+      if (select((int)(maxFd + 1), &readfds, NULL, NULL, &timeout) <= 0)
+         continue;
+
+      bool exhausted = false;
+      for (U32 i = 0; i < 2; i++)
+      {
+         const SOCKET socketFd = PlatformNetState::receiveSockets[i];
+         if (socketFd != InvalidSocketHandle && FD_ISSET(socketFd, &readfds) && !receivePackets(socketFd))
+            exhausted = true;
+      }
+
+      // Give the main thread a chance to release buffers.
+      if (exhausted)
+         Platform::sleep(1);
+   }
+}
+
+void Net::startReceiveThread()
+{
+   if (PlatformNetState::receiveThread != NULL || PlatformNetState::packetPool == NULL)
+      return;
+
+   // The thread only reads these descriptors, never the socket list.
+   PlatformNetState::receiveSockets[0] = PlatformNetState::udpSocket != NetSocket::INVALID ? PlatformNetState::smReservedSocketList.resolve(PlatformNetState::udpSocket) : InvalidSocketHandle;
+   PlatformNetState::receiveSockets[1] = PlatformNetState::udp6Socket != NetSocket::INVALID ? PlatformNetState::smReservedSocketList.resolve(PlatformNetState::udp6Socket) : InvalidSocketHandle;
+   if (PlatformNetState::receiveSockets[0] == InvalidSocketHandle && PlatformNetState::receiveSockets[1] == InvalidSocketHandle)
+      return;
+
+   PlatformNetState::receiveShutdown.store(false);
+   PlatformNetState::receiveThread = new Thread(&receiveThreadProc, NULL, true);
+}
+
+void Net::stopReceiveThread()
+{
+   if (PlatformNetState::receiveThread == NULL)
+      return;
+
+   PlatformNetState::receiveShutdown.store(true);
+   PlatformNetState::receiveThread->join();
+   delete PlatformNetState::receiveThread;
+   PlatformNetState::receiveThread = NULL;
+}
+
+void Net::dispatchPackets()
+{
+   NetPacketPool *pool = PlatformNetState::packetPool;
+   if (pool == NULL)
+      return;
+
+   // Debug Profiling.
+   PROFILE_SCOPE(Net_DispatchPackets);
+
+   while (NetPacketBuffer *buffer = pool->receive())
+   {
+      Game->processPacketBuffer(buffer);
+      pool->release(buffer);
+   }
+}
+
+NetPacketPool* Net::getPacketPool()
+{
+   return PlatformNetState::packetPool;
 }
 
 NetSocket Net::openSocket()
@@ -173,6 +173,9 @@ public:
 };
 
 
+struct PolledSocket;
+class NetPacketPool;
+
 /// Platform-specific network operations.
 struct Net
 {
@@ -255,8 +258,17 @@ struct Net
    static bool isAddressTypeAvailable(NetAddress::Type addressType);
 
    static void process();
+
+   // Received packets are pooled and dispatched on the main thread by process().
+   // The UDP sockets can optionally be read on a separate thread, which is
+   // enabled by $pref::Net::ReceiveThread when the port is opened.
+   static NetPacketPool* getPacketPool();
+   static void startReceiveThread();
+   static void stopReceiveThread();
 private:
 	static void processListenSocket(NetSocket socket);
+	static void dispatchPackets();
+	static bool processPolledSocket(PolledSocket *socket);
 
 };
 
@@ -0,0 +1,137 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "platform/platformNetPacket.h"
+#include "platform/event.h"
+#include "platform/threads/thread.h"
+#include "platform/threads/mutex.h"
+#include "io/bitStream.h"
+#include "console/console.h"
+
+#include "platformNetPacket_ScriptBinding.h"
+
+//-----------------------------------------------------------------------------
+
+NetPacketRing::NetPacketRing(U32 capacity) : mRead(0), mWrite(0)
+{
+   mCapacity = getNextPow2(getMax(capacity, (U32)2));
+   mEntries = new NetPacketBuffer*[mCapacity];
+}
+
+NetPacketRing::~NetPacketRing()
+{
+   delete [] mEntries;
+}
+
+//-----------------------------------------------------------------------------
+
+NetPacketPool::NetPacketPool(U32 capacity) :
+   mQueue(capacity),
+   mReturns(capacity),
+   mPostCount(0),
+   mExhaustedCount(0),
+   mPeakInUse(0)
+{
+   AssertFatal(capacity > 0, "NetPacketPool - Invalid capacity.");
+
+   mCapacity = capacity;
+   mBuffers = new NetPacketBuffer[mCapacity];
+   mFreeBuffers = new NetPacketBuffer*[mCapacity];
+
+   // Hand out the lowest buffers first.
+   for(U32 i = 0; i < mCapacity; i++)
+      mFreeBuffers[i] = &mBuffers[mCapacity - i - 1];
+   mFreeCount = mCapacity;
+}
+
+NetPacketPool::~NetPacketPool()
+{
+   delete [] mFreeBuffers;
+   delete [] mBuffers;
+}
+
+//-----------------------------------------------------------------------------
+
+NetPacketBuffer* NetPacketPool::allocate()
+{
+   if(!mFreeCount)
+   {
+      // Take back everything the consumer has released.
+      while(NetPacketBuffer *buffer = mReturns.pop())
+         mFreeBuffers[mFreeCount++] = buffer;
+
+      if(!mFreeCount)
+      {
+         mExhaustedCount.fetch_add(1, std::memory_order_relaxed);
+         return NULL;
+      }
+   }
+
+   NetPacketBuffer *buffer = mFreeBuffers[--mFreeCount];
+   buffer->size = 0;
+   buffer->refCount = 0;
+
+   // Released buffers still waiting in the return ring count as in use.
+   const U32 inUse = mCapacity - mFreeCount - mReturns.getCount();
+   if(inUse > mPeakInUse.load(std::memory_order_relaxed))
+      mPeakInUse.store(inUse, std::memory_order_relaxed);
+
+   return buffer;
+}
+
+void NetPacketPool::recycle(NetPacketBuffer *buffer)
+{
+   AssertFatal(mFreeCount < mCapacity, "NetPacketPool::recycle - Buffer returned twice.");
+   mFreeBuffers[mFreeCount++] = buffer;
+}
+
+void NetPacketPool::post(NetPacketBuffer *buffer)
+{
+   buffer->refCount = 1;
+
+   // The queue can hold every buffer so this can't fail.
+   const bool posted = mQueue.push(buffer);
+   AssertFatal(posted, "NetPacketPool::post - Queue overflow.");
+   TORQUE_UNUSED(posted);
+   mPostCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void NetPacketPool::release(NetPacketBuffer *buffer)
+{
+   AssertFatal(buffer->refCount > 0, "NetPacketPool::release - Buffer is not referenced.");
+   if(--buffer->refCount)
+      return;
+
+   // The return ring can hold every buffer so this can't fail.
+   const bool returned = mReturns.push(buffer);
+   AssertFatal(returned, "NetPacketPool::release - Return overflow.");
+   TORQUE_UNUSED(returned);
+}
+
+void NetPacketPool::resetMetrics()
+{
+   mPostCount.store(0);
+   mExhaustedCount.store(0);
+   mPeakInUse.store(0);
+}
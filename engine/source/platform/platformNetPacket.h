@@ -0,0 +1,162 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _PLATFORM_PLATFORMNETPACKET_H_
+#define _PLATFORM_PLATFORMNETPACKET_H_
+
+#ifndef _PLATFORM_PLATFORMNET_H_
+#include "platform/platformNet.h"
+#endif
+
+#include <atomic>
+
+//-----------------------------------------------------------------------------
+
+/// A received datagram.
+///
+/// Buffers are owned by a NetPacketPool.  Sockets receive straight into
+/// mData and the buffer is handed on by pointer so the payload is never
+/// copied between the socket and NetConnection::processRawPacket().
+struct NetPacketBuffer
+{
+   NetAddress sourceAddress;              ///< Originating address.
+   U32 size;                              ///< Bytes of data.
+   U32 refCount;                          ///< References held by the consumer.
+   U8 data[Net::MaxPacketDataSize];       ///< Payload
+};
+
+//-----------------------------------------------------------------------------
+
+/// A fixed ring of packet buffer pointers.
+///
+/// There must be exactly one producer and one consumer.  Each side only
+/// writes its own index so no lock is needed.
+class NetPacketRing
+{
+private:
+   NetPacketBuffer** mEntries;
+   U32 mCapacity;
+   std::atomic<U32> mRead;
+   std::atomic<U32> mWrite;
+
+public:
+   /// The capacity is rounded up to a power of two.
+   NetPacketRing(U32 capacity);
+   ~NetPacketRing();
+
+   inline U32 getCapacity() const { return mCapacity; }
+   inline U32 getCount() const { return mWrite.load(std::memory_order_acquire) - mRead.load(std::memory_order_acquire); }
+
+   /// Producer.  Returns false if the ring is full.
+   inline bool push(NetPacketBuffer *buffer)
+   {
+      const U32 write = mWrite.load(std::memory_order_relaxed);
+      if(write - mRead.load(std::memory_order_acquire) >= mCapacity)
+         return false;
+
+      mEntries[write & (mCapacity - 1)] = buffer;
+      mWrite.store(write + 1, std::memory_order_release);
+      return true;
+   }
+
+   /// Consumer.  Returns NULL if the ring is empty.
+   inline NetPacketBuffer* pop()
+   {
+      const U32 read = mRead.load(std::memory_order_relaxed);
+      if(read == mWrite.load(std::memory_order_acquire))
+         return NULL;
+
+      NetPacketBuffer *buffer = mEntries[read & (mCapacity - 1)];
+      mRead.store(read + 1, std::memory_order_release);
+      return buffer;
+   }
+};
+
+//-----------------------------------------------------------------------------
+
+/// A fixed pool of packet buffers and the queue that carries them from the
+/// thread receiving packets to the thread processing them.
+///
+/// The producer allocates a buffer, receives into it and posts it.  The
+/// consumer receives the buffer, takes any extra references it needs and
+/// releases it.  Released buffers travel back to the producer through a
+/// second ring so neither side ever locks or allocates.  The producer and
+/// consumer may be the same thread.
+///
+/// When every buffer is in use allocate() fails and the producer should
+/// leave packets in the socket until buffers are released.
+class NetPacketPool
+{
+private:
+   NetPacketBuffer* mBuffers;
+   U32 mCapacity;
+
+   /// Producer-owned free buffers.
+   NetPacketBuffer** mFreeBuffers;
+   U32 mFreeCount;
+
+   NetPacketRing mQueue;                  ///< Producer to consumer.
+   NetPacketRing mReturns;                ///< Consumer to producer.
+
+   std::atomic<U32> mPostCount;
+   std::atomic<U32> mExhaustedCount;
+   std::atomic<U32> mPeakInUse;
+
+public:
+   NetPacketPool(U32 capacity);
+   ~NetPacketPool();
+
+   inline U32 getCapacity() const { return mCapacity; }
+
+   /// @name Producer
+   /// @{
+
+   /// Returns NULL if every buffer is in use.
+   NetPacketBuffer* allocate();
+
+   /// Return a buffer that was allocated but not posted.
+   void recycle(NetPacketBuffer *buffer);
+
+   /// Pass a buffer to the consumer.  The consumer holds the only reference.
+   void post(NetPacketBuffer *buffer);
+   /// @}
+
+   /// @name Consumer
+   /// @{
+
+   /// Returns NULL if no packets are waiting.
+   inline NetPacketBuffer* receive() { return mQueue.pop(); }
+
+   inline void addRef(NetPacketBuffer *buffer) { buffer->refCount++; }
+   void release(NetPacketBuffer *buffer);
+   /// @}
+
+   /// Metrics.
+   inline U32 getPostCount() const { return mPostCount.load(std::memory_order_relaxed); }
+   inline U32 getExhaustedCount() const { return mExhaustedCount.load(std::memory_order_relaxed); }
+   inline U32 getPeakInUse() const { return mPeakInUse.load(std::memory_order_relaxed); }
+   inline U32 getQueuedCount() const { return mQueue.getCount(); }
+   void resetMetrics();
+};
+
+#endif // _PLATFORM_PLATFORMNETPACKET_H_
@@ -0,0 +1,206 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+/*! @addtogroup Network Network
+	@ingroup TorqueScriptFunctions
+	@{
+*/
+
+/// Shared state for netPacketBenchmark().
+struct NetPacketBenchmark
+{
+   U32 mPacketCount;
+   U32 mPacketSize;
+   U8 mPayload[Net::MaxPacketDataSize];
+
+   NetPacketPool* mpPool;
+
+   Mutex mEventMutex;
+   Vector<Event*> mEventQueues[2];
+   Vector<Event*>* mpEventQueue;
+};
+
+/// Produces packets into the pool as a receive thread would.
+static void netPacketBenchmarkPooled(void *arg)
+{
+   NetPacketBenchmark &bench = *(NetPacketBenchmark *)arg;
+
+   for(U32 i = 0; i < bench.mPacketCount; i++)
+   {
+      NetPacketBuffer *buffer;
+      while((buffer = bench.mpPool->allocate()) == NULL)
+         Platform::sleep(0);
+
+      // Stands in for the socket writing the datagram.
+      dMemcpy(buffer->data, bench.mPayload, bench.mPacketSize);
+      *(U32 *)buffer->data = i;
+      buffer->size = bench.mPacketSize;
+      bench.mpPool->post(buffer);
+   }
+}
+
+/// Produces packets as events copied into a locked queue, as GameInterface::postEvent() does.
+static void netPacketBenchmarkEvents(void *arg)
+{
+   NetPacketBenchmark &bench = *(NetPacketBenchmark *)arg;
+
+   PacketReceiveEvent event;
+   for(U32 i = 0; i < bench.mPacketCount; i++)
+   {
+      dMemcpy(event.data, bench.mPayload, bench.mPacketSize);
+      *(U32 *)event.data = i;
+      event.size = PacketReceiveEventHeaderSize + bench.mPacketSize;
+
+      bench.mEventMutex.lock();
+      Event *copy = (Event *)dMalloc(event.size);
+      dMemcpy(copy, &event, event.size);
+      bench.mpEventQueue->push_back(copy);
+      bench.mEventMutex.unlock();
+   }
+}
+
+/*! Measures how many packets per second can be passed from a receiving thread to the main thread and wrapped in a BitStream.
+    The pooled packet path is compared with copying each packet into an event queue.  No sockets are involved so the figures exclude the cost of the system calls.
+    @param packetCount The number of packets to pass.  Optional, defaults to 100000.
+    @param packetSize The size of each packet in bytes.  Optional, defaults to 512.
+    @return Returns the packets per second through the pool and through the event queue separated by a space.
+*/
+ConsoleFunctionWithDocs( netPacketBenchmark, ConsoleString, 1, 3, ([packetCount], [packetSize]))
+{
+   NetPacketBenchmark *bench = new NetPacketBenchmark;
+   bench->mPacketCount = argc > 1 ? getMax(dAtoi(argv[1]), 1) : 100000;
+   bench->mPacketSize = argc > 2 ? mClamp(dAtoi(argv[2]), 4, Net::MaxPacketDataSize) : 512;
+   dMemset(bench->mPayload, 0xA5, sizeof(bench->mPayload));
+   bench->mpPool = new NetPacketPool(256);
+   bench->mpEventQueue = &bench->mEventQueues[0];
+
+   U32 errors = 0;
+
+   // Pooled buffers through the lock-free queue.
+   U32 startTime = Platform::getRealMilliseconds();
+   Thread *producer = new Thread(&netPacketBenchmarkPooled, bench, true);
+   for(U32 received = 0; received < bench->mPacketCount;)
+   {
+      NetPacketBuffer *buffer = bench->mpPool->receive();
+      if(buffer == NULL)
+      {
+         Platform::sleep(0);
+         continue;
+      }
+
+      BitStream stream(buffer->data, buffer->size);
+      U32 sequence;
+      stream.read(&sequence);
+      if(sequence != received)
+         errors++;
+
+      bench->mpPool->release(buffer);
+      received++;
+   }
+   producer->join();
+   delete producer;
+   const U32 pooledTime = getMax(Platform::getRealMilliseconds() - startTime, (U32)1);
+
+   // Copied events through a locked, double-buffered queue.
+   startTime = Platform::getRealMilliseconds();
+   producer = new Thread(&netPacketBenchmarkEvents, bench, true);
+   for(U32 received = 0; received < bench->mPacketCount;)
+   {
+      bench->mEventMutex.lock();
+      Vector<Event*> &processQueue = *bench->mpEventQueue;
+      bench->mpEventQueue = bench->mpEventQueue == &bench->mEventQueues[0] ? &bench->mEventQueues[1] : &bench->mEventQueues[0];
+      bench->mEventMutex.unlock();
+
+      if(processQueue.empty())
+      {
+         Platform::sleep(0);
+         continue;
+      }
+
+      for(S32 i = 0; i < processQueue.size(); i++)
+      {
+         PacketReceiveEvent *event = (PacketReceiveEvent *)processQueue[i];
+         BitStream stream(event->data, event->size - PacketReceiveEventHeaderSize);
+         U32 sequence;
+         stream.read(&sequence);
+         if(sequence != received)
+            errors++;
+
+         dFree(event);
+         received++;
+      }
+      processQueue.clear();
+   }
+   producer->join();
+   delete producer;
+   const U32 eventTime = getMax(Platform::getRealMilliseconds() - startTime, (U32)1);
+
+   const F32 pooledRate = F32(bench->mPacketCount) * 1000.0f / F32(pooledTime);
+   const F32 eventRate = F32(bench->mPacketCount) * 1000.0f / F32(eventTime);
+
+   Con::printf("Packet Benchmark: %d packets of %d bytes", bench->mPacketCount, bench->mPacketSize);
+   Con::printf("  Pooled: %.0f packets/sec (peak %d of %d buffers in use)", pooledRate, bench->mpPool->getPeakInUse(), bench->mpPool->getCapacity());
+   Con::printf("  Event Queue: %.0f packets/sec", eventRate);
+   if(errors)
+      Con::errorf("  %d packets arrived out of order!", errors);
+
+   delete bench->mpPool;
+   delete bench;
+
+   char *buffer = Con::getReturnBuffer(64);
+   dSprintf(buffer, 64, "%g %g", pooledRate, eventRate);
+   return buffer;
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Dump the metrics of the received packet pool.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs( dumpNetPacketMetrics, ConsoleVoid, 1, 1, ())
+{
+   NetPacketPool *pool = Net::getPacketPool();
+   if(pool == NULL)
+   {
+      Con::printf("No packet pool.");
+      return;
+   }
+
+   Con::printf("Packet Pool Metrics:");
+   Con::printf("  Packets Received: %d", pool->getPostCount());
+   Con::printf("  Buffers: %d (peak %d in use)", pool->getCapacity(), pool->getPeakInUse());
+   Con::printf("  Times Exhausted: %d", pool->getExhaustedCount());
+   Con::printf("  Queued: %d", pool->getQueuedCount());
+}
+
+/*! Reset the metrics of the received packet pool.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs( resetNetPacketMetrics, ConsoleVoid, 1, 1, ())
+{
+   NetPacketPool *pool = Net::getPacketPool();
+   if(pool != NULL)
+      pool->resetMetrics();
+}
+
+/*! @} */ // end group Network
@@ -115,6 +115,23 @@ void Net::processListenSocket(NetSocket socketHandle)
 {
 }
 
+void Net::dispatchPackets()
+{
+}
+
+NetPacketPool* Net::getPacketPool()
+{
+   return NULL;
+}
+
+void Net::startReceiveThread()
+{
+}
+
+void Net::stopReceiveThread()
+{
+}
+
 NetSocket Net::openSocket()
 {
 	return NetSocket::INVALID;
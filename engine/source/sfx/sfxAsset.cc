@@ -32,6 +32,7 @@
 #include "console/consoleTypes.h"
 #endif
 #include "sfxDevice.h"
+#include "sfxDecodeCache.h"
 
 //-----------------------------------------------------------------------------
 
@@ -99,6 +100,8 @@ SFXAsset::SFXAsset()
    mDescription.mConeOutsideVolume = 1.0f;
    mDescription.mConeVector.set(0, 0, 1);
 
+   mPreload = false;
+
 }
 
 //--------------------------------------------------------------------------
@@ -112,6 +115,7 @@ void SFXAsset::initPersistFields()
    addProtectedField("VolumeChannel", TypeS32, Offset(mDescription.mVolumeChannel, SFXAsset), &setVolumeChannel, &defaultProtectedGetFn, &writeVolumeChannel, "");
    addProtectedField("Looping", TypeBool, Offset(mDescription.mIsLooping, SFXAsset), &setLooping, &defaultProtectedGetFn, &writeLooping, "");
    addProtectedField("Streaming", TypeBool, Offset(mDescription.mIsStreaming, SFXAsset), &setStreaming, &defaultProtectedGetFn, &writeStreaming, "");
+   addProtectedField("Preload", TypeBool, Offset(mPreload, SFXAsset), &setPreload, &defaultProtectedGetFn, &writePreload, "");
 
    //addField("is3D",              TypeBool,    Offset(mDescription.mIs3D, AudioAsset));
    //addField("referenceDistance", TypeF32,     Offset(mDescription.mReferenceDistance, AudioAsset));
@@ -142,6 +146,7 @@ void SFXAsset::copyTo(SimObject* object)
    pAsset->setVolumeChannel(getVolumeChannel());
    pAsset->setLooping(getLooping());
    pAsset->setStreaming(getStreaming());
+   pAsset->setPreload(getPreload());
 }
 
 //--------------------------------------------------------------------------
@@ -168,6 +173,10 @@ void SFXAsset::initializeAsset(void)
       mDescription.mConeOutsideVolume = mClampF(mDescription.mConeOutsideVolume, 0.0f, 1.0f);
       mDescription.mConeVector.normalize();
    }
+
+   // Decode ahead of first use if requested.  Streams are decoded as they play.
+   if (mPreload && !mDescription.mIsStreaming)
+      SFXDecodeCache::preload(mAudioFile);
 }
 
 //--------------------------------------------------------------------------
@@ -254,6 +263,21 @@ void SFXAsset::setStreaming(const bool streaming)
 
 //--------------------------------------------------------------------------
 
+void SFXAsset::setPreload(const bool preload)
+{
+   // Ignore no change.
+   if (preload == mPreload)
+      return;
+
+   // Update.
+   mPreload = preload;
+
+   // Refresh the asset.
+   refreshAsset();
+}
+
+//--------------------------------------------------------------------------
+
 void SFXAsset::setDescription(const SFXDevice::DefDescription& audioDescription)
 {
    // Update.
@@ -59,6 +59,7 @@ private:
 
    StringTableEntry mAudioFile;
    SFXDevice::DefDescription mDescription;
+   bool mPreload;
 
 public:
    SFXAsset();
@@ -80,6 +81,9 @@ public:
    void setStreaming(const bool streaming);
    inline bool getStreaming(void) const { return mDescription.mIsStreaming; }
 
+   void setPreload(const bool preload);
+   inline bool getPreload(void) const { return mPreload; }
+
    void setDescription(const SFXDevice::DefDescription& audioDescription);
    inline const SFXDevice::DefDescription& getAudioDescription(void) const { return mDescription; }
 
@@ -107,6 +111,9 @@ protected:
 
    static bool setStreaming(void* obj, const char* data) { static_cast<SFXAsset*>(obj)->setStreaming(dAtob(data)); return false; }
    static bool writeStreaming(void* obj, StringTableEntry pFieldName) { return static_cast<SFXAsset*>(obj)->getStreaming() == true; }
+
+   static bool setPreload(void* obj, const char* data) { static_cast<SFXAsset*>(obj)->setPreload(dAtob(data)); return false; }
+   static bool writePreload(void* obj, StringTableEntry pFieldName) { return static_cast<SFXAsset*>(obj)->getPreload() == true; }
 };
 
 #endif  // _AUDIO_ASSET_H_
@@ -50,13 +50,8 @@ protected:
 
    const OPENALFNTABLE &mOpenAL;
 
-   bool readRIFFchunk(Stream &s, const char *seekLabel, U32 *size);
-   bool readWAV(ResourceObject *obj);
-
-#ifndef TORQUE_OS_IOS
-   bool readOgg(ResourceObject *obj);
-   long oggRead(struct OggVorbis_File* vf, char *buffer, int length, int bigendianp, int *bitstream);
-#endif
+   /// Fill the AL buffer from the decode cache.
+   bool readClip();
 
 public:
    static SFXBuffer* create(const OPENALFNTABLE &oalft,
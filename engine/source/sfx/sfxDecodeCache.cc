@@ -0,0 +1,675 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "sfx/sfxDecodeCache.h"
+#include "sfx/sfxStreamThread.h"
+#include "io/stream.h"
+#include "io/resource/resourceManager.h"
+#include "console/console.h"
+#include "console/consoleTypes.h"
+#include "memory/safeDelete.h"
+
+#ifndef TORQUE_OS_IOS
+#include "vorbis/vorbisfile.h"
+#endif
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+// Script bindings.
+#include "sfxDecodeCache_ScriptBinding.h"
+
+//--------------------------------------------------------------------------
+
+SFXDecodeCache::typeClipHash* SFXDecodeCache::smpClips = NULL;
+SFXDecodeCache::Clip* SFXDecodeCache::smLruHead = NULL;
+SFXDecodeCache::Clip* SFXDecodeCache::smLruTail = NULL;
+U32 SFXDecodeCache::smBytes = 0;
+U32 SFXDecodeCache::smHits = 0;
+U32 SFXDecodeCache::smMisses = 0;
+U32 SFXDecodeCache::smEvictions = 0;
+U32 SFXDecodeCache::smDecodeCount = 0;
+U32 SFXDecodeCache::smDecodeTime = 0;
+S32 SFXDecodeCache::smMaxBytes = 8 * 1024 * 1024;
+
+/// WAV File-header
+struct WAVFileHdr
+{
+   ALubyte  id[4];
+   ALsizei  size;
+   ALubyte  type[4];
+};
+
+//// WAV Fmt-header
+struct WAVFmtHdr
+{
+   ALushort format;
+   ALushort channels;
+   ALuint   samplesPerSec;
+   ALuint   bytesPerSec;
+   ALushort blockAlign;
+   ALushort bitsPerSample;
+};
+
+/// WAV FmtEx-header
+struct WAVFmtExHdr
+{
+   ALushort size;
+   ALushort samplesPerBlock;
+};
+
+/// WAV Smpl-header
+struct WAVSmplHdr
+{
+   ALuint   manufacturer;
+   ALuint   product;
+   ALuint   samplePeriod;
+   ALuint   note;
+   ALuint   fineTune;
+   ALuint   SMPTEFormat;
+   ALuint   SMPTEOffest;
+   ALuint   loops;
+   ALuint   samplerData;
+   struct
+   {
+      ALuint identifier;
+      ALuint type;
+      ALuint start;
+      ALuint end;
+      ALuint fraction;
+      ALuint count;
+   }      loop[1];
+};
+
+/// WAV Chunk-header
+struct WAVChunkHdr
+{
+   ALubyte  id[4];
+   ALuint   size;
+};
+
+#define CHUNKSIZE 4096
+
+#ifndef TORQUE_OS_IOS
+// Ogg Vorbis
+static size_t _ov_read_func(void *ptr, size_t size, size_t nmemb, void *datasource)
+{
+   Stream *stream = reinterpret_cast<Stream*>(datasource);
+
+   // Stream::read() returns true if any data was
+   // read, so we must track the read bytes ourselves.
+   U32 startByte = stream->getPosition();
+   stream->read(size * nmemb, ptr);
+   U32 endByte = stream->getPosition();
+
+   // How many did we actually read?
+   U32 readBytes = (endByte - startByte);
+   U32 readItems = readBytes / size;
+
+   return readItems;
+}
+
+static int _ov_seek_func(void *datasource, ogg_int64_t offset, int whence)
+{
+   Stream *stream = reinterpret_cast<Stream*>(datasource);
+
+   U32 newPos = 0;
+   if (whence == SEEK_CUR)
+      newPos = stream->getPosition() + (U32)offset;
+   else if (whence == SEEK_END)
+      newPos = stream->getStreamSize() - (U32)offset;
+   else
+      newPos = (U32)offset;
+
+   return stream->setPosition(newPos) ? 0 : -1;
+}
+
+static long _ov_tell_func(void *datasource)
+{
+   Stream *stream = reinterpret_cast<Stream*>(datasource);
+   return stream->getPosition();
+}
+#endif
+
+//--------------------------------------------------------------------------
+
+SFXDecodeCache::Clip::Clip() :
+   mFilename( StringTable->EmptyString ),
+   mFormat( AL_FORMAT_MONO16 ),
+   mFreq( 22050 ),
+   mpData( NULL ),
+   mSize( 0 ),
+   mRefCount( 0 ),
+   mCached( false ),
+   mpLruPrev( NULL ),
+   mpLruNext( NULL )
+{
+}
+
+//--------------------------------------------------------------------------
+
+SFXDecodeCache::Clip::~Clip()
+{
+   SAFE_DELETE_ARRAY( mpData );
+}
+
+//--------------------------------------------------------------------------
+
+void SFXDecodeCache::create( void )
+{
+   AssertISV( smpClips == NULL, "SFXDecodeCache::create() - Already created." );
+
+   smpClips = new typeClipHash();
+
+   Con::addVariable( "$pref::SFX::decodeCacheBytes", TypeS32, &smMaxBytes );
+}
+
+//--------------------------------------------------------------------------
+
+void SFXDecodeCache::destroy( void )
+{
+   // Orphan anything still referenced.
+   flush();
+
+   SAFE_DELETE( smpClips );
+}
+
+//--------------------------------------------------------------------------
+
+void SFXDecodeCache::link( Clip* pClip )
+{
+   // Most recently used at the head.
+   pClip->mpLruPrev = NULL;
+   pClip->mpLruNext = smLruHead;
+   if ( smLruHead != NULL )
+      smLruHead->mpLruPrev = pClip;
+   smLruHead = pClip;
+   if ( smLruTail == NULL )
+      smLruTail = pClip;
+
+   smpClips->insertUnique( pClip->mFilename, pClip );
+   smBytes += pClip->mSize;
+   pClip->mCached = true;
+}
+
+//--------------------------------------------------------------------------
+
+void SFXDecodeCache::unlink( Clip* pClip )
+{
+   if ( pClip->mpLruPrev != NULL )
+      pClip->mpLruPrev->mpLruNext = pClip->mpLruNext;
+   else
+      smLruHead = pClip->mpLruNext;
+
+   if ( pClip->mpLruNext != NULL )
+      pClip->mpLruNext->mpLruPrev = pClip->mpLruPrev;
+   else
+      smLruTail = pClip->mpLruPrev;
+
+   pClip->mpLruPrev = NULL;
+   pClip->mpLruNext = NULL;
+
+   smpClips->erase( pClip->mFilename );
+   smBytes -= pClip->mSize;
+   pClip->mCached = false;
+}
+
+//--------------------------------------------------------------------------
+
+void SFXDecodeCache::touch( Clip* pClip )
+{
+   if ( pClip == smLruHead )
+      return;
+
+   // Detach.
+   pClip->mpLruPrev->mpLruNext = pClip->mpLruNext;
+   if ( pClip->mpLruNext != NULL )
+      pClip->mpLruNext->mpLruPrev = pClip->mpLruPrev;
+   else
+      smLruTail = pClip->mpLruPrev;
+
+   // Move to the head.
+   pClip->mpLruPrev = NULL;
+   pClip->mpLruNext = smLruHead;
+   smLruHead->mpLruPrev = pClip;
+   smLruHead = pClip;
+}
+
+//--------------------------------------------------------------------------
+
+void SFXDecodeCache::evict( const U32 requiredBytes )
+{
+   const U32 maxBytes = (U32)getMax( smMaxBytes, 0 );
+
+   Clip* pClip = smLruTail;
+   while ( pClip != NULL && smBytes + requiredBytes > maxBytes )
+   {
+      Clip* pPrev = pClip->mpLruPrev;
+
+      if ( pClip->mRefCount == 0 )
+      {
+         unlink( pClip );
+         delete pClip;
+         smEvictions++;
+      }
+
+      pClip = pPrev;
+   }
+}
+
+//--------------------------------------------------------------------------
+
+SFXDecodeCache::Clip* SFXDecodeCache::decode( StringTableEntry filename )
+{
+   // Debug Profiling.
+   PROFILE_SCOPE(SFXDecodeCache_Decode);
+
+   Stream* pStream = ResourceManager->openStream( filename );
+   if ( pStream == NULL )
+      return NULL;
+
+   const U32 startTime = Platform::getRealMilliseconds();
+
+   ALenum format = AL_FORMAT_MONO16;
+   ALsizei freq = 22050;
+   U8* pData = NULL;
+   U32 size = 0;
+   bool decoded = false;
+
+   const S32 len = dStrlen( filename );
+   if ( len > 3 && !dStricmp( filename + len - 4, ".wav" ) )
+      decoded = decodeWAV( *pStream, format, freq, pData, size );
+#ifndef TORQUE_OS_IOS
+   else if ( len > 3 && !dStricmp( filename + len - 4, ".ogg" ) )
+      decoded = decodeOgg( *pStream, format, freq, pData, size );
+#endif
+
+   ResourceManager->closeStream( pStream );
+
+   if ( !decoded )
+      return NULL;
+
+   smDecodeCount++;
+   smDecodeTime += Platform::getRealMilliseconds() - startTime;
+
+   return insert( filename, format, freq, pData, size );
+}
+
+//--------------------------------------------------------------------------
+
+SFXDecodeCache::Clip* SFXDecodeCache::acquire( StringTableEntry filename )
+{
+   // Debug Profiling.
+   PROFILE_SCOPE(SFXDecodeCache_Acquire);
+
+   if ( smpClips != NULL )
+   {
+      typeClipHash::iterator itr = smpClips->find( filename );
+      if ( itr != smpClips->end() )
+      {
+         Clip* pClip = itr->value;
+
+         touch( pClip );
+         pClip->mRefCount++;
+         smHits++;
+         return pClip;
+      }
+   }
+
+   smMisses++;
+
+   return decode( filename );
+}
+
+//--------------------------------------------------------------------------
+
+void SFXDecodeCache::release( Clip* pClip )
+{
+   // Sanity!
+   AssertFatal( pClip != NULL && pClip->mRefCount > 0, "SFXDecodeCache::release() - Invalid clip reference." );
+
+   if ( --pClip->mRefCount > 0 )
+      return;
+
+   // Orphaned clips go as soon as they are unreferenced.
+   if ( !pClip->mCached )
+   {
+      delete pClip;
+      return;
+   }
+
+   // Referenced clips may have held the cache over budget.
+   if ( smBytes > (U32)getMax( smMaxBytes, 0 ) )
+      evict( 0 );
+}
+
+//--------------------------------------------------------------------------
+
+SFXDecodeCache::Clip* SFXDecodeCache::insert( StringTableEntry filename, const ALenum format, const ALsizei freq, U8* pData, const U32 size )
+{
+   // Sanity!
+   AssertFatal( pData != NULL || size == 0, "SFXDecodeCache::insert() - Invalid clip data." );
+
+   filename = StringTable->insert( filename );
+
+   Clip* pClip = new Clip();
+   pClip->mFilename = filename;
+   pClip->mFormat = format;
+   pClip->mFreq = freq;
+   pClip->mpData = pData;
+   pClip->mSize = size;
+   pClip->mRefCount = 1;
+
+   if ( smpClips == NULL || size > (U32)getMax( smMaxBytes, 0 ) )
+      return pClip;
+
+   // Replace any existing clip for the file.
+   typeClipHash::iterator itr = smpClips->find( filename );
+   if ( itr != smpClips->end() )
+   {
+      Clip* pExisting = itr->value;
+      unlink( pExisting );
+      if ( pExisting->mRefCount == 0 )
+         delete pExisting;
+   }
+
+   evict( size );
+   link( pClip );
+
+   return pClip;
+}
+
+//--------------------------------------------------------------------------
+
+bool SFXDecodeCache::preload( StringTableEntry filename )
+{
+   if ( smpClips == NULL || filename == NULL || *filename == 0 )
+      return false;
+
+   filename = StringTable->insert( filename );
+
+   Clip* pClip = acquire( filename );
+   if ( pClip == NULL )
+   {
+      Con::warnf( "SFXDecodeCache::preload() - Could not decode '%s'.", filename );
+      return false;
+   }
+
+   const bool cached = pClip->isCached();
+   release( pClip );
+
+   return cached;
+}
+
+//--------------------------------------------------------------------------
+
+bool SFXDecodeCache::isCached( StringTableEntry filename )
+{
+   return smpClips != NULL && smpClips->find( filename ) != smpClips->end();
+}
+
+//--------------------------------------------------------------------------
+
+void SFXDecodeCache::flush( void )
+{
+   while ( smLruHead != NULL )
+   {
+      Clip* pClip = smLruHead;
+      unlink( pClip );
+
+      // Referenced clips are deleted when they are released.
+      if ( pClip->mRefCount == 0 )
+         delete pClip;
+   }
+}
+
+//--------------------------------------------------------------------------
+
+void SFXDecodeCache::resetMetrics( void )
+{
+   smHits = 0;
+   smMisses = 0;
+   smEvictions = 0;
+   smDecodeCount = 0;
+   smDecodeTime = 0;
+}
+
+//--------------------------------------------------------------------------
+
+void SFXDecodeCache::dumpMetrics( void )
+{
+   U32 referencedCount = 0;
+   for ( Clip* pClip = smLruHead; pClip != NULL; pClip = pClip->mpLruNext )
+   {
+      if ( pClip->mRefCount > 0 )
+         referencedCount++;
+   }
+
+   const U32 lookups = smHits + smMisses;
+
+   Con::printSeparator();
+   Con::printf( "SFX decode cache metrics:" );
+   Con::printf( "Clips=%d, Referenced=%d, Bytes=%d<%d>", getClipCount(), referencedCount, smBytes, smMaxBytes );
+   Con::printf( "Hits=%d, Misses=%d, HitRate=%.1f%%, Evictions=%d", smHits, smMisses, lookups == 0 ? 0.0f : (F32)smHits * 100.0f / (F32)lookups, smEvictions );
+   Con::printf( "Decodes=%d, DecodeTime=%dms", smDecodeCount, smDecodeTime );
+   Con::printf( "Stream chunks=%d, StreamDecodeTime=%dms, Underruns=%d",
+      SFXStreamThread::getChunkCount(), SFXStreamThread::getDecodeTime(), SFXStreamThread::getUnderrunCount() );
+   Con::printSeparator();
+}
+
+//--------------------------------------------------------------------------
+
+/*!   Read a WAV file from the given stream.
+*/
+
+bool SFXDecodeCache::decodeWAV( Stream& stream, ALenum& format, ALsizei& freq, U8*& pData, U32& size )
+{
+   WAVChunkHdr chunkHdr;
+   WAVFmtExHdr fmtExHdr;
+   WAVFileHdr  fileHdr;
+   WAVSmplHdr  smplHdr;
+   WAVFmtHdr   fmtHdr;
+
+   fmtHdr.format = 0;
+   fmtHdr.bitsPerSample = 0;
+
+   char *data = NULL;
+
+   stream.read(4, &fileHdr.id[0]);
+   stream.read(&fileHdr.size);
+   stream.read(4, &fileHdr.type[0]);
+
+   fileHdr.size = ((fileHdr.size + 1)&~1) - 4;
+
+   stream.read(4, &chunkHdr.id[0]);
+   stream.read(&chunkHdr.size);
+   // unread chunk data rounded up to nearest WORD
+   S32 chunkRemaining = chunkHdr.size + (chunkHdr.size & 1);
+
+   while ((fileHdr.size != 0) && (stream.getStatus() != Stream::EOS))
+   {
+      // WAV Format header
+      if (!dStrncmp((const char*)chunkHdr.id, "fmt ", 4))
+      {
+         stream.read(&fmtHdr.format);
+         stream.read(&fmtHdr.channels);
+         stream.read(&fmtHdr.samplesPerSec);
+         stream.read(&fmtHdr.bytesPerSec);
+         stream.read(&fmtHdr.blockAlign);
+         stream.read(&fmtHdr.bitsPerSample);
+
+         if (fmtHdr.format == 0x0001)
+         {
+            format = (fmtHdr.channels == 1 ?
+               (fmtHdr.bitsPerSample == 8 ? AL_FORMAT_MONO8 : AL_FORMAT_MONO16) :
+               (fmtHdr.bitsPerSample == 8 ? AL_FORMAT_STEREO8 : AL_FORMAT_STEREO16));
+            freq = fmtHdr.samplesPerSec;
+            chunkRemaining -= sizeof(WAVFmtHdr);
+         }
+         else
+         {
+            stream.read(sizeof(WAVFmtExHdr), &fmtExHdr);
+            chunkRemaining -= sizeof(WAVFmtExHdr);
+         }
+      }
+      // WAV Format header
+      else if (!dStrncmp((const char*)chunkHdr.id, "data", 4))
+      {
+         if (fmtHdr.format == 0x0001 && data == NULL)
+         {
+            size = chunkHdr.size;
+            data = new char[chunkHdr.size];
+            if (data)
+            {
+               stream.read(chunkHdr.size, data);
+#if defined(TORQUE_BIG_ENDIAN)
+               // need to endian-flip the 16-bit data.
+               if (fmtHdr.bitsPerSample == 16) // !!!TBD we don't handle stereo, so may be RL flipped.
+               {
+                  U16 *ds = (U16*)data;
+                  U16 *de = (U16*)(data + size);
+                  while (ds < de)
+                  {
+                     *ds = convertLEndianToHost(*ds);
+                     ds++;
+                  }
+               }
+#endif
+               chunkRemaining -= chunkHdr.size;
+            }
+            else
+               break;
+         }
+         else if (fmtHdr.format == 0x0011)
+         {
+            //IMA ADPCM
+         }
+         else if (fmtHdr.format == 0x0055)
+         {
+            //MP3 WAVE
+         }
+      }
+      // WAV Loop header
+      else if (!dStrncmp((const char*)chunkHdr.id, "smpl", 4))
+      {
+         // this struct read is NOT endian safe but it is ok because
+         // we are only testing the loops field against ZERO
+         stream.read(sizeof(WAVSmplHdr), &smplHdr);
+         chunkRemaining -= sizeof(WAVSmplHdr);
+      }
+
+      // either we have unread chunk data or we found an unknown chunk type
+      // loop and read up to 1K bytes at a time until we have
+      // read to the end of this chunk
+      char buffer[1024];
+      AssertFatal(chunkRemaining >= 0, "SFXDecodeCache::decodeWAV: remaining chunk data should never be less than zero.");
+      while (chunkRemaining > 0)
+      {
+         S32 readSize = getMin(1024, chunkRemaining);
+         stream.read(readSize, buffer);
+         chunkRemaining -= readSize;
+      }
+
+      fileHdr.size -= (((chunkHdr.size + 1)&~1) + 8);
+
+      // read next chunk header...
+      stream.read(4, &chunkHdr.id[0]);
+      stream.read(&chunkHdr.size);
+      // unread chunk data rounded up to nearest WORD
+      chunkRemaining = chunkHdr.size + (chunkHdr.size & 1);
+   }
+
+   pData = (U8*)data;
+   return data != NULL;
+}
+
+#ifndef TORQUE_OS_IOS
+// Read an Ogg Vorbis file from the given stream.
+// Pulled from: https://www.garagegames.com/community/forums/viewthread/136675
+bool SFXDecodeCache::decodeOgg( Stream& stream, ALenum& format, ALsizei& freq, U8*& pData, U32& size )
+{
+   int current_section = 0;
+
+#if defined(TORQUE_BIG_ENDIAN)
+   int endian = 1;
+#else
+   int endian = 0;
+#endif
+
+   OggVorbis_File vf;
+   dMemset(&vf, 0, sizeof(OggVorbis_File));
+
+   const bool canSeek = stream.hasCapability(Stream::StreamPosition);
+
+   ov_callbacks cb;
+   cb.read_func = _ov_read_func;
+   cb.seek_func = canSeek ? _ov_seek_func : NULL;
+   cb.close_func = NULL;
+   cb.tell_func = canSeek ? _ov_tell_func : NULL;
+
+   // Open it.
+   int ovResult = ov_open_callbacks(&stream, &vf, NULL, 0, cb);
+   if (ovResult != 0)
+      return false;
+
+   const vorbis_info *vi = ov_info(&vf, -1);
+   freq = vi->rate;
+
+   long samples = (long)ov_pcm_total(&vf, -1);
+
+   if (vi->channels == 1)
+   {
+      format = AL_FORMAT_MONO16;
+      size = 2 * samples;
+   }
+   else
+   {
+      format = AL_FORMAT_STEREO16;
+      size = 4 * samples;
+   }
+
+   char* data = new char[size];
+
+   // ov_read() only returns a maximum of one page worth of data
+   // so repeat the read until the buffer is full.
+   U32 offset = 0;
+   while (offset < size)
+   {
+      const int bytesToRead = getMin((U32)CHUNKSIZE, size - offset);
+      const long bytesRead = ov_read(&vf, data + offset, bytesToRead, endian, 2, 1, &current_section);
+      if (bytesRead == OV_HOLE)
+         continue;
+      if (bytesRead <= 0)
+         break;
+      offset += bytesRead;
+   }
+
+   /* cleanup */
+   ov_clear(&vf);
+
+   // Only keep what was actually decoded.
+   size = offset;
+   pData = (U8*)data;
+   return true;
+}
+#endif
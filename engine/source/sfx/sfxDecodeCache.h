@@ -0,0 +1,144 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _SFXDECODECACHE_H_
+#define _SFXDECODECACHE_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _LOADOAL_H_
+#include "sfx/LoadOAL.h"
+#endif
+
+#ifndef _HASHTABLE_H
+#include "collection/hashTable.h"
+#endif
+
+class Stream;
+
+//--------------------------------------------------------------------------
+
+/// A cache of decoded sound clips.
+///
+/// A clip is the complete PCM data of a sound file, keyed by its filename, in the
+/// format expected by alBufferData().  Short sounds are decoded once and then
+/// handed to every buffer created for them.  Unreferenced clips are evicted
+/// least-recently-used first once the cache exceeds its byte budget.  A clip
+/// larger than the whole budget is decoded but never cached.  The cache is only
+/// used from the main thread.
+class SFXDecodeCache
+{
+public:
+   class Clip
+   {
+      friend class SFXDecodeCache;
+
+   private:
+      StringTableEntry  mFilename;
+      ALenum            mFormat;
+      ALsizei           mFreq;
+      U8*               mpData;
+      U32               mSize;
+
+      U32               mRefCount;
+      bool              mCached;
+
+      Clip*             mpLruPrev;
+      Clip*             mpLruNext;
+
+      Clip();
+      ~Clip();
+
+   public:
+      inline StringTableEntry getFilename( void ) const   { return mFilename; }
+      inline ALenum getFormat( void ) const               { return mFormat; }
+      inline ALsizei getFreq( void ) const                { return mFreq; }
+      inline const U8* getData( void ) const              { return mpData; }
+      inline U32 getSize( void ) const                    { return mSize; }
+      inline bool isCached( void ) const                  { return mCached; }
+   };
+
+private:
+   typedef HashTable<StringTableEntry, Clip*> typeClipHash;
+
+   static typeClipHash*    smpClips;
+   static Clip*            smLruHead;
+   static Clip*            smLruTail;
+   static U32              smBytes;
+
+   static U32              smHits;
+   static U32              smMisses;
+   static U32              smEvictions;
+   static U32              smDecodeCount;
+   static U32              smDecodeTime;
+
+   static void             link( Clip* pClip );
+   static void             unlink( Clip* pClip );
+   static void             touch( Clip* pClip );
+   static void             evict( const U32 requiredBytes );
+   static Clip*            decode( StringTableEntry filename );
+
+public:
+   /// Budget in bytes.  Referenced clips are never evicted so the budget can be exceeded.
+   static S32              smMaxBytes;
+
+   static void             create( void );
+   static void             destroy( void );
+   static inline bool      isCreated( void )           { return smpClips != NULL; }
+
+   /// Find a clip, decoding it on a miss.  Returns NULL if the file can't be decoded
+   /// otherwise a reference that must be released.
+   static Clip*            acquire( StringTableEntry filename );
+   static void             release( Clip* pClip );
+
+   /// Add decoded PCM for a file.  The cache takes ownership of the data, which must have
+   /// been allocated with new[].  The returned clip is referenced and must be released.
+   static Clip*            insert( StringTableEntry filename, const ALenum format, const ALsizei freq, U8* pData, const U32 size );
+
+   /// Decode a file into the cache ahead of its first use.
+   static bool             preload( StringTableEntry filename );
+
+   static bool             isCached( StringTableEntry filename );
+   static void             flush( void );
+
+   /// Decoders.  The data is allocated with new[] and owned by the caller.
+   static bool             decodeWAV( Stream& stream, ALenum& format, ALsizei& freq, U8*& pData, U32& size );
+#ifndef TORQUE_OS_IOS
+   static bool             decodeOgg( Stream& stream, ALenum& format, ALsizei& freq, U8*& pData, U32& size );
+#endif
+
+   /// Metrics.
+   static inline U32       getClipCount( void )        { return smpClips == NULL ? 0 : smpClips->size(); }
+   static inline U32       getBytes( void )            { return smBytes; }
+   static inline U32       getHits( void )             { return smHits; }
+   static inline U32       getMisses( void )           { return smMisses; }
+   static inline U32       getEvictions( void )        { return smEvictions; }
+   static inline U32       getDecodeCount( void )      { return smDecodeCount; }
+   static inline U32       getDecodeTime( void )       { return smDecodeTime; }
+   static void             resetMetrics( void );
+   static void             dumpMetrics( void );
+};
+
+#endif // _SFXDECODECACHE_H_
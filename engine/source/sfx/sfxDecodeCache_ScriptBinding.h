@@ -0,0 +1,88 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+/*! @defgroup SFXDecodeCacheFunctions SFX Decode Cache
+	@ingroup TorqueScriptFunctions
+	@{
+*/
+
+/*! Flushes all cached sound clips.  Clips are decoded again the next time they are used.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs( flushSFXDecodeCache, ConsoleVoid, 1, 1, ())
+{
+    SFXDecodeCache::flush();
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+/*! Decodes a sound file into the cache ahead of its first use.
+    @param filename The sound file to decode.
+    @return Whether the clip is now cached.
+*/
+ConsoleFunctionWithDocs( preloadSFXClip, ConsoleBool, 2, 2, (filename))
+{
+    char pathBuffer[1024];
+    Con::expandPath( pathBuffer, sizeof(pathBuffer), argv[1] );
+
+    return SFXDecodeCache::preload( StringTable->insert( pathBuffer ) );
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+/*! Gets the sound decode metrics.
+    @return The metrics as "hits misses evictions clips bytes decodes decodeMs streamChunks streamDecodeMs underruns".
+*/
+ConsoleFunctionWithDocs( getSFXDecodeMetrics, ConsoleString, 1, 1, ())
+{
+    char* pBuffer = Con::getReturnBuffer( 128 );
+    dSprintf( pBuffer, 128, "%d %d %d %d %d %d %d %d %d %d",
+        SFXDecodeCache::getHits(), SFXDecodeCache::getMisses(), SFXDecodeCache::getEvictions(),
+        SFXDecodeCache::getClipCount(), SFXDecodeCache::getBytes(),
+        SFXDecodeCache::getDecodeCount(), SFXDecodeCache::getDecodeTime(),
+        SFXStreamThread::getChunkCount(), SFXStreamThread::getDecodeTime(), SFXStreamThread::getUnderrunCount() );
+    return pBuffer;
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+/*! Resets the sound decode metrics.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs( resetSFXDecodeMetrics, ConsoleVoid, 1, 1, ())
+{
+    SFXDecodeCache::resetMetrics();
+    SFXStreamThread::resetMetrics();
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+/*! Dump the sound decode metrics.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs( dumpSFXDecodeMetrics, ConsoleVoid, 1, 1, ())
+{
+    SFXDecodeCache::dumpMetrics();
+}
+
+/*! @} */ // group SFXDecodeCacheFunctions
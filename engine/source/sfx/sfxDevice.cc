@@ -10,15 +10,52 @@
 #include "sfx/sfxCommon.h"
 #include "sfx/sfxEnvironment.h"
 #include "sfx/sfxProvider.h"
+#include "sfx/sfxDecodeCache.h"
+#include "sfx/sfxStreamThread.h"
+#include "sfx/sfxAsset.h"
+#include "assets/assetManager.h"
+#include "2d/core/Vector2.h"
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+// Script bindings.
+#include "sfxDevice_ScriptBinding.h"
+
+//-----------------------------------------------------
+
+struct SFXDevice::Voice
+{
+   VoiceHandle          mHandle;
+   Resource<SFXBuffer>  mBuffer;
+   ALuint               mALBuffer;
+   DefDescription       mDescription;
+   Point3F              mPosition;
+   F32                  mPriority;
+   F32                  mScore;
+
+   /// Length in seconds and where playback is (or would be if the voice were real).
+   F32                  mDuration;
+   F32                  mElapsed;
+
+   /// Zero when virtual.
+   ALuint               mSource;
+};
 
 //-----------------------------------------------------
 // INITIALIZATION
 //-----------------------------------------------------
 
 SFXDevice* SFXDevice::smDevice = NULL;
+S32 SFXDevice::smMaxRealVoices = 32;
 
 void SFXDevice::init()
 {
+   SFXDecodeCache::create();
+   SFXStreamThread::create();
+
+   Con::addVariable("$pref::SFX::maxRealVoices", TypeS32, &smMaxRealVoices);
+
    Con::printSeparator();
    Con::printf("OpenAL Initialization:");
    SFXProvider* dumPro = new SFXProvider;
@@ -27,7 +64,12 @@ void SFXDevice::init()
 
 void SFXDevice::shutdown()
 {
+   // Streams must stop decoding before the device goes.
+   SFXStreamThread::destroy();
+
    delete smDevice;
+
+   SFXDecodeCache::destroy();
 }
 
 //-----------------------------------------------------
@@ -40,8 +82,21 @@ SFXDevice::SFXDevice(SFXProvider* provider, const OPENALFNTABLE & openal)
 {
    smDevice = this;
 
+   mContext = NULL;
+   mDevice = NULL;
+   mRealSourceCount = 0;
+   mNextVoiceHandle = InvalidVoiceHandle + 1;
+   mListenerPosition.set(0.f, 0.f, 0.f);
+   mRealVoiceCount = 0;
+   mPromotionCount = 0;
+   mDemotionCount = 0;
+
+   // An empty name opens the default device.  A specific device such as OpenAL Soft's
+   // "No Output" or "Wave File Writer" can be used to run without a sound card.
+   const char* pDeviceName = Con::getVariable("$pref::SFX::deviceName");
+
    Con::printf("SFXDevice: creating Device");
-   mDevice = mOpenAL.alcOpenDevice((const ALCchar*)NULL);
+   mDevice = mOpenAL.alcOpenDevice(*pDeviceName ? (const ALCchar*)pDeviceName : (const ALCchar*)NULL);
 
    if (mDevice == (ALCvoid*)NULL)
    {
@@ -111,12 +166,36 @@ SFXDevice::SFXDevice(SFXProvider* provider, const OPENALFNTABLE & openal)
    mOpenAL.alListenerfv(AL_POSITION, listenerPos);
    mOpenAL.alListenerfv(AL_VELOCITY, listenerVel);
    mOpenAL.alListenerfv(AL_ORIENTATION, listenerOrientation);
+
+   // Sources for the real voices.
+   const U32 realSourceCount = getMin(maxSources, (U32)getMax(smMaxRealVoices, 1));
+   mFreeSources.setSize(realSourceCount);
+   mOpenAL.alGetError();
+   mOpenAL.alGenSources(realSourceCount, mFreeSources.address());
+   mRealSourceCount = (mOpenAL.alGetError() == AL_NO_ERROR) ? realSourceCount : 0;
+   if (mRealSourceCount == 0)
+      mFreeSources.clear();
+
+   Con::printf("SFXDevice: %d real voices", mRealSourceCount);
+
+   setProcessTicks(true);
+
    Con::printf("SFXDevice created.");
 }
 
 SFXDevice::~SFXDevice()
 {
    Con::printf("SFXDevice: Shutting down!");
+
+   if (mContext != NULL)
+   {
+      stopAllVoices();
+
+      if (mFreeSources.size() > 0)
+         mOpenAL.alDeleteSources(mFreeSources.size(), mFreeSources.address());
+      mFreeSources.clear();
+   }
+
    mOpenAL.alcMakeContextCurrent(NULL);
    mOpenAL.alcDestroyContext(mContext);
    mOpenAL.alcCloseDevice(mDevice);
@@ -153,4 +232,313 @@ U32 SFXDevice::GetMaxNumSources()
    Con::printf("SFXDevice supports: %i Sources", iSourceCount);
 
    return iSourceCount;
-}
\ No newline at end of file
+}
+//-----------------------------------------------------
+// VOICES
+//-----------------------------------------------------
+
+F32 SFXDevice::getAudibility(const DefDescription& description, const Point3F& position, const Point3F& listenerPosition)
+{
+   if (!description.mIs3D)
+      return description.mVolume;
+
+   // Matches the inverse distance model but anything past the max distance can't be heard.
+   const F32 distance = (position - listenerPosition).len();
+   if (distance >= description.mMaxDistance)
+      return 0.f;
+
+   const F32 referenceDistance = getMax(description.mReferenceDistance, 0.001f);
+   if (distance <= referenceDistance)
+      return description.mVolume;
+
+   return description.mVolume * referenceDistance / distance;
+}
+
+//-----------------------------------------------------
+
+SFXDevice::VoiceHandle SFXDevice::playVoice(const char* pFilename, const DefDescription& description, const Point3F& position, const F32 priority)
+{
+   // Debug Profiling.
+   PROFILE_SCOPE(SFXDevice_PlayVoice);
+
+   if (mContext == NULL)
+      return InvalidVoiceHandle;
+
+   // Fetch the buffer.
+   Resource<SFXBuffer> buffer = SFXBuffer::find(mOpenAL, pFilename);
+   if (bool(buffer) == false)
+   {
+      Con::warnf("SFXDevice::playVoice() - Could not find '%s'.", pFilename);
+      return InvalidVoiceHandle;
+   }
+
+   const ALuint alBuffer = buffer->getALBuffer();
+   if (alBuffer == 0)
+   {
+      Con::warnf("SFXDevice::playVoice() - Could not load '%s'.", pFilename);
+      return InvalidVoiceHandle;
+   }
+
+   // Work out the length so virtual voices know when they finish.
+   ALint size = 0, frequency = 0, channels = 0, bits = 0;
+   mOpenAL.alGetBufferi(alBuffer, AL_SIZE, &size);
+   mOpenAL.alGetBufferi(alBuffer, AL_FREQUENCY, &frequency);
+   mOpenAL.alGetBufferi(alBuffer, AL_CHANNELS, &channels);
+   mOpenAL.alGetBufferi(alBuffer, AL_BITS, &bits);
+   const U32 bytesPerSecond = (U32)(frequency * channels * (bits / 8));
+
+   Voice* pVoice = new Voice();
+   pVoice->mHandle = mNextVoiceHandle++;
+   pVoice->mBuffer = buffer;
+   pVoice->mALBuffer = alBuffer;
+   pVoice->mDescription = description;
+   pVoice->mPosition = position;
+   pVoice->mPriority = priority;
+   pVoice->mScore = priority * getAudibility(description, position, mListenerPosition);
+   pVoice->mDuration = bytesPerSecond == 0 ? 0.f : (F32)size / (F32)bytesPerSecond;
+   pVoice->mElapsed = 0.f;
+   pVoice->mSource = 0;
+   mVoices.push_back(pVoice);
+
+   if (mNextVoiceHandle == InvalidVoiceHandle)
+      mNextVoiceHandle++;
+
+   // Start straight away if there's a free source.  Otherwise the next update decides.
+   if (pVoice->mScore > 0.f && mFreeSources.size() > 0)
+      makeReal(pVoice);
+
+   return pVoice->mHandle;
+}
+
+//-----------------------------------------------------
+
+S32 SFXDevice::findVoice(const VoiceHandle handle) const
+{
+   for (S32 n = 0; n < mVoices.size(); ++n)
+   {
+      if (mVoices[n]->mHandle == handle)
+         return n;
+   }
+
+   return -1;
+}
+
+//-----------------------------------------------------
+
+void SFXDevice::stopVoice(const VoiceHandle handle)
+{
+   const S32 index = findVoice(handle);
+   if (index >= 0)
+      freeVoice(index);
+}
+
+//-----------------------------------------------------
+
+void SFXDevice::stopAllVoices()
+{
+   while (mVoices.size() > 0)
+      freeVoice(mVoices.size() - 1);
+}
+
+//-----------------------------------------------------
+
+bool SFXDevice::isVoicePlaying(const VoiceHandle handle)
+{
+   return findVoice(handle) >= 0;
+}
+
+//-----------------------------------------------------
+
+bool SFXDevice::isVoiceReal(const VoiceHandle handle)
+{
+   const S32 index = findVoice(handle);
+   return index >= 0 && mVoices[index]->mSource != 0;
+}
+
+//-----------------------------------------------------
+
+void SFXDevice::setVoicePosition(const VoiceHandle handle, const Point3F& position)
+{
+   const S32 index = findVoice(handle);
+   if (index < 0)
+      return;
+
+   Voice* pVoice = mVoices[index];
+   pVoice->mPosition = position;
+
+   if (pVoice->mSource != 0 && pVoice->mDescription.mIs3D)
+      mOpenAL.alSource3f(pVoice->mSource, AL_POSITION, position.x, position.y, position.z);
+}
+
+//-----------------------------------------------------
+
+void SFXDevice::setListenerPosition(const Point3F& position)
+{
+   mListenerPosition = position;
+
+   if (mContext != NULL)
+      mOpenAL.alListener3f(AL_POSITION, position.x, position.y, position.z);
+}
+
+//-----------------------------------------------------
+
+void SFXDevice::makeReal(Voice* pVoice)
+{
+   AssertFatal(pVoice->mSource == 0 && mFreeSources.size() > 0, "SFXDevice::makeReal() - Voice is already real or there are no free sources.");
+
+   const ALuint source = mFreeSources.last();
+   mFreeSources.pop_back();
+
+   const DefDescription& description = pVoice->mDescription;
+
+   mOpenAL.alSourcei(source, AL_BUFFER, pVoice->mALBuffer);
+   mOpenAL.alSourcef(source, AL_GAIN, description.mVolume);
+   mOpenAL.alSourcei(source, AL_LOOPING, description.mIsLooping ? AL_TRUE : AL_FALSE);
+
+   if (description.mIs3D)
+   {
+      mOpenAL.alSourcei(source, AL_SOURCE_RELATIVE, AL_FALSE);
+      mOpenAL.alSource3f(source, AL_POSITION, pVoice->mPosition.x, pVoice->mPosition.y, pVoice->mPosition.z);
+      mOpenAL.alSourcef(source, AL_REFERENCE_DISTANCE, description.mReferenceDistance);
+      mOpenAL.alSourcef(source, AL_MAX_DISTANCE, description.mMaxDistance);
+   }
+   else
+   {
+      mOpenAL.alSourcei(source, AL_SOURCE_RELATIVE, AL_TRUE);
+      mOpenAL.alSource3f(source, AL_POSITION, 0.f, 0.f, 0.f);
+   }
+
+   // Resume from where the voice would have been.
+   mOpenAL.alSourcef(source, AL_SEC_OFFSET, pVoice->mElapsed);
+   mOpenAL.alSourcePlay(source);
+
+   pVoice->mSource = source;
+   mRealVoiceCount++;
+}
+
+//-----------------------------------------------------
+
+void SFXDevice::makeVirtual(Voice* pVoice)
+{
+   AssertFatal(pVoice->mSource != 0, "SFXDevice::makeVirtual() - Voice is already virtual.");
+
+   // Remember where we were.
+   F32 offset = 0.f;
+   mOpenAL.alGetSourcef(pVoice->mSource, AL_SEC_OFFSET, &offset);
+   pVoice->mElapsed = offset;
+
+   mOpenAL.alSourceStop(pVoice->mSource);
+   mOpenAL.alSourcei(pVoice->mSource, AL_BUFFER, 0);
+
+   mFreeSources.push_back(pVoice->mSource);
+   pVoice->mSource = 0;
+   mRealVoiceCount--;
+}
+
+//-----------------------------------------------------
+
+void SFXDevice::freeVoice(const S32 index)
+{
+   Voice* pVoice = mVoices[index];
+
+   if (pVoice->mSource != 0)
+   {
+      mOpenAL.alSourceStop(pVoice->mSource);
+      mOpenAL.alSourcei(pVoice->mSource, AL_BUFFER, 0);
+      mFreeSources.push_back(pVoice->mSource);
+      mRealVoiceCount--;
+   }
+
+   delete pVoice;
+   mVoices.erase_fast(index);
+}
+
+//-----------------------------------------------------
+
+S32 QSORT_CALLBACK SFXDevice::voiceScoreSort(const void* a, const void* b)
+{
+   const F32 scoreA = (*((Voice**)a))->mScore;
+   const F32 scoreB = (*((Voice**)b))->mScore;
+
+   // Highest first.
+   if (scoreA > scoreB)
+      return -1;
+
+   return scoreA < scoreB ? 1 : 0;
+}
+
+//-----------------------------------------------------
+
+void SFXDevice::updateVoices(const F32 timeDelta)
+{
+   if (mContext == NULL || mVoices.size() == 0)
+      return;
+
+   // Debug Profiling.
+   PROFILE_SCOPE(SFXDevice_UpdateVoices);
+
+   // Retire finished voices, advance virtual ones and score everything.
+   for (S32 n = mVoices.size() - 1; n >= 0; --n)
+   {
+      Voice* pVoice = mVoices[n];
+
+      if (pVoice->mSource != 0)
+      {
+         ALint state;
+         mOpenAL.alGetSourcei(pVoice->mSource, AL_SOURCE_STATE, &state);
+         if (state == AL_STOPPED)
+         {
+            freeVoice(n);
+            continue;
+         }
+      }
+      else
+      {
+         pVoice->mElapsed += timeDelta;
+         if (pVoice->mDuration > 0.f && pVoice->mElapsed >= pVoice->mDuration)
+         {
+            if (!pVoice->mDescription.mIsLooping)
+            {
+               freeVoice(n);
+               continue;
+            }
+
+            pVoice->mElapsed = mFmod(pVoice->mElapsed, pVoice->mDuration);
+         }
+      }
+
+      pVoice->mScore = pVoice->mPriority * getAudibility(pVoice->mDescription, pVoice->mPosition, mListenerPosition);
+
+      // Favour real voices a little so voices with similar scores don't keep swapping.
+      if (pVoice->mSource != 0)
+         pVoice->mScore *= 1.1f;
+   }
+
+   // Rank them.
+   mVoiceOrder = mVoices;
+   dQsort(mVoiceOrder.address(), mVoiceOrder.size(), sizeof(Voice*), voiceScoreSort);
+
+   const S32 realCount = getMin((S32)mRealSourceCount, mVoiceOrder.size());
+
+   // Free the sources of voices that have dropped out first.
+   for (S32 n = 0; n < mVoiceOrder.size(); ++n)
+   {
+      Voice* pVoice = mVoiceOrder[n];
+      if (pVoice->mSource != 0 && (n >= realCount || pVoice->mScore <= 0.f))
+      {
+         makeVirtual(pVoice);
+         mDemotionCount++;
+      }
+   }
+
+   // Then give them to the voices that made it.
+   for (S32 n = 0; n < realCount; ++n)
+   {
+      Voice* pVoice = mVoiceOrder[n];
+      if (pVoice->mSource == 0 && pVoice->mScore > 0.f)
+      {
+         makeReal(pVoice);
+         mPromotionCount++;
+      }
+   }
+}
@@ -13,6 +13,14 @@
 #include "sfx/LoadOAL.h"
 #endif
 
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+#ifndef _TICKABLE_H_
+#include "platform/Tickable.h"
+#endif
+
 class SFXProvider;
 
 #define SFX SFXDevice->get();
@@ -31,7 +39,14 @@ enum SFXCaps
    SFXEAXRAM
 };
 
-class SFXDevice
+/// The OpenAL device.
+///
+/// Sounds are played as voices.  Any number of voices can be playing but only
+/// the most audible ones are bound to a real OpenAL source.  Each frame voices
+/// are scored by priority, distance and volume and the best are made real.  A
+/// virtual voice keeps track of where it would have been so it resumes at the
+/// right offset when it becomes real again.
+class SFXDevice : public virtual Tickable
 {
 
 public:
@@ -41,6 +56,13 @@ public:
    SFXDevice(SFXProvider* provider,const OPENALFNTABLE &openal);
    ~SFXDevice();
 
+   typedef U32 VoiceHandle;
+
+   enum
+   {
+      InvalidVoiceHandle = 0,
+   };
+
 protected:
 
    static SFXDevice* smDevice;
@@ -61,6 +83,32 @@ protected:
    U32            maxSources;
    ///---
 
+   struct Voice;
+
+   Vector<Voice*>    mVoices;
+   Vector<Voice*>    mVoiceOrder;
+   Vector<ALuint>    mFreeSources;
+   U32               mRealSourceCount;
+   VoiceHandle       mNextVoiceHandle;
+   Point3F           mListenerPosition;
+
+   U32               mRealVoiceCount;
+   U32               mPromotionCount;
+   U32               mDemotionCount;
+
+   S32               findVoice(const VoiceHandle handle) const;
+   void              makeReal(Voice* pVoice);
+   void              makeVirtual(Voice* pVoice);
+   void              freeVoice(const S32 index);
+   void              updateVoices(const F32 timeDelta);
+
+   static S32 QSORT_CALLBACK voiceScoreSort(const void* a, const void* b);
+
+   /// Tickable.
+   virtual void      interpolateTick(F32 delta) {}
+   virtual void      processTick() {}
+   virtual void      advanceTime(F32 timeDelta) { updateVoices(timeDelta); }
+
 
 public:
    static void init();
@@ -68,6 +116,9 @@ public:
 
    U32 GetMaxNumSources();
 
+   /// Upper limit on the real sources used by voices.
+   static S32 smMaxRealVoices;
+
    // sound property description
    struct DefDescription
    {
@@ -88,6 +139,25 @@ public:
       F32 mEnvironmentLevel;
    };
 
+   /// Voices.
+   VoiceHandle playVoice(const char* pFilename, const DefDescription& description, const Point3F& position, const F32 priority = 1.0f);
+   void stopVoice(const VoiceHandle handle);
+   void stopAllVoices();
+   bool isVoicePlaying(const VoiceHandle handle);
+   bool isVoiceReal(const VoiceHandle handle);
+   void setVoicePosition(const VoiceHandle handle, const Point3F& position);
+   void setListenerPosition(const Point3F& position);
+   inline const Point3F& getListenerPosition() const { return mListenerPosition; }
+
+   inline U32 getVoiceCount() const { return (U32)mVoices.size(); }
+   inline U32 getRealVoiceCount() const { return mRealVoiceCount; }
+   inline U32 getVirtualVoiceCount() const { return (U32)mVoices.size() - mRealVoiceCount; }
+   inline U32 getPromotionCount() const { return mPromotionCount; }
+   inline U32 getDemotionCount() const { return mDemotionCount; }
+
+   /// How loud a voice would be, from zero (inaudible) to its volume.
+   static F32 getAudibility(const DefDescription& description, const Point3F& position, const Point3F& listenerPosition);
+
 };
 
 
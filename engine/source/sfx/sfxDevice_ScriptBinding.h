@@ -0,0 +1,174 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+/*! @defgroup SFXVoiceFunctions SFX Voices
+	@ingroup TorqueScriptFunctions
+	@{
+*/
+
+/// Reads "x y" or "x y z".
+static Point3F getVoicePosition( const char* pPosition )
+{
+    if ( Utility::mGetStringElementCount( pPosition ) >= 3 )
+        return Utility::mGetStringElementVector3D( pPosition );
+
+    const Vector2 position = Utility::mGetStringElementVector( pPosition );
+    return Point3F( position.x, position.y, 0.0f );
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+/*! Plays a sound asset as a voice.  Only the most audible voices are given a real source.
+    Streaming assets cannot be played as voices.
+    @param assetId The SFXAsset to play.
+    @param position The position of the sound as "x y" or "x y z".  Optional.
+    @param priority How important the sound is.  Scales its audibility when voices are ranked.  Optional, defaults to one.
+    @return The voice handle or zero if the sound can't be played.
+*/
+ConsoleFunctionWithDocs( sfxPlayVoice, ConsoleInt, 2, 4, (assetId, [position], [priority]))
+{
+    SFXDevice* pDevice = SFXDevice::get();
+    if ( pDevice == NULL )
+        return SFXDevice::InvalidVoiceHandle;
+
+    // Fetch asset.
+    SFXAsset* pAsset = AssetDatabase.acquireAsset<SFXAsset>( argv[1] );
+    if ( pAsset == NULL )
+    {
+        Con::warnf( "sfxPlayVoice() - Could not find asset '%s'.", argv[1] );
+        return SFXDevice::InvalidVoiceHandle;
+    }
+
+    // Streaming sounds are too large for a single buffer so they are played through a stream source instead.
+    if ( pAsset->getStreaming() )
+    {
+        Con::warnf( "sfxPlayVoice() - Cannot play streaming asset '%s' as a voice.", argv[1] );
+        AssetDatabase.releaseAsset( argv[1] );
+        return SFXDevice::InvalidVoiceHandle;
+    }
+
+    const Point3F position = argc >= 3 ? getVoicePosition( argv[2] ) : Point3F( 0.0f, 0.0f, 0.0f );
+    const F32 priority = argc >= 4 ? dAtof( argv[3] ) : 1.0f;
+
+    const SFXDevice::VoiceHandle handle = pDevice->playVoice( pAsset->getAudioFile(), pAsset->getAudioDescription(), position, priority );
+
+    AssetDatabase.releaseAsset( argv[1] );
+
+    return handle;
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+/*! Stops a voice.
+    @param handle The voice handle.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs( sfxStopVoice, ConsoleVoid, 2, 2, (handle))
+{
+    SFXDevice* pDevice = SFXDevice::get();
+    if ( pDevice != NULL )
+        pDevice->stopVoice( dAtoi( argv[1] ) );
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+/*! Stops all voices.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs( sfxStopAllVoices, ConsoleVoid, 1, 1, ())
+{
+    SFXDevice* pDevice = SFXDevice::get();
+    if ( pDevice != NULL )
+        pDevice->stopAllVoices();
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+/*! Checks whether a voice is still playing, real or virtual.
+    @param handle The voice handle.
+    @return Whether the voice is playing.
+*/
+ConsoleFunctionWithDocs( sfxIsVoicePlaying, ConsoleBool, 2, 2, (handle))
+{
+    SFXDevice* pDevice = SFXDevice::get();
+    return pDevice != NULL && pDevice->isVoicePlaying( dAtoi( argv[1] ) );
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+/*! Checks whether a voice currently has a real source.
+    @param handle The voice handle.
+    @return Whether the voice is real.
+*/
+ConsoleFunctionWithDocs( sfxIsVoiceReal, ConsoleBool, 2, 2, (handle))
+{
+    SFXDevice* pDevice = SFXDevice::get();
+    return pDevice != NULL && pDevice->isVoiceReal( dAtoi( argv[1] ) );
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+/*! Moves a voice.
+    @param handle The voice handle.
+    @param position The position of the sound as "x y" or "x y z".
+    @return No return value.
+*/
+ConsoleFunctionWithDocs( sfxSetVoicePosition, ConsoleVoid, 3, 3, (handle, position))
+{
+    SFXDevice* pDevice = SFXDevice::get();
+    if ( pDevice != NULL )
+        pDevice->setVoicePosition( dAtoi( argv[1] ), getVoicePosition( argv[2] ) );
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+/*! Moves the listener.
+    @param position The position of the listener as "x y" or "x y z".
+    @return No return value.
+*/
+ConsoleFunctionWithDocs( sfxSetListenerPosition, ConsoleVoid, 2, 2, (position))
+{
+    SFXDevice* pDevice = SFXDevice::get();
+    if ( pDevice != NULL )
+        pDevice->setListenerPosition( getVoicePosition( argv[1] ) );
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+/*! Gets the voice metrics.
+    @return The metrics as "voices real virtual promotions demotions".
+*/
+ConsoleFunctionWithDocs( getSFXVoiceMetrics, ConsoleString, 1, 1, ())
+{
+    SFXDevice* pDevice = SFXDevice::get();
+    if ( pDevice == NULL )
+        return "0 0 0 0 0";
+
+    char* pBuffer = Con::getReturnBuffer( 64 );
+    dSprintf( pBuffer, 64, "%d %d %d %d %d",
+        pDevice->getVoiceCount(), pDevice->getRealVoiceCount(), pDevice->getVirtualVoiceCount(),
+        pDevice->getPromotionCount(), pDevice->getDemotionCount() );
+    return pBuffer;
+}
+
+/*! @} */ // group SFXVoiceFunctions
@@ -55,6 +55,10 @@ public:
    virtual F32 getElapsedTime() = 0;
    virtual F32 getTotalTime() = 0;
 
+   /// Decode ahead of playback.  Called from the stream worker thread
+   /// so it must not call OpenAL.
+   virtual void decodeAhead() {}
+
    ALuint			               mSource;
    SFXDevice::DefDescription     mDescription;
    SFXEnvironment                *mEnvironment;
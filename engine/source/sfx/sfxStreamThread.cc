@@ -0,0 +1,143 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "sfx/sfxStreamThread.h"
+#include "sfx/sfxStreamSource.h"
+#include "console/console.h"
+#include "memory/safeDelete.h"
+
+//--------------------------------------------------------------------------
+
+Thread* SFXStreamThread::smpThread = NULL;
+Semaphore* SFXStreamThread::smpWake = NULL;
+Mutex* SFXStreamThread::smpSourceMutex = NULL;
+Vector<SFXStreamSource*> SFXStreamThread::smSources;
+std::atomic<bool> SFXStreamThread::smShutdown( false );
+std::atomic<U32> SFXStreamThread::smChunkCount( 0 );
+std::atomic<U32> SFXStreamThread::smDecodeTime( 0 );
+U32 SFXStreamThread::smUnderrunCount = 0;
+
+//--------------------------------------------------------------------------
+
+void SFXStreamThread::create( void )
+{
+   AssertISV( smpThread == NULL, "SFXStreamThread::create() - Already created." );
+
+   smShutdown.store( false );
+   smpWake = new Semaphore( 0 );
+   smpSourceMutex = new Mutex();
+   smpThread = new Thread( &SFXStreamThread::workerThread, NULL, true );
+}
+
+//--------------------------------------------------------------------------
+
+void SFXStreamThread::destroy( void )
+{
+   if ( smpThread == NULL )
+      return;
+
+   // Stop the worker.
+   smShutdown.store( true );
+   smpWake->release();
+   smpThread->join();
+
+   SAFE_DELETE( smpThread );
+   SAFE_DELETE( smpWake );
+   SAFE_DELETE( smpSourceMutex );
+
+   smSources.clear();
+}
+
+//--------------------------------------------------------------------------
+
+void SFXStreamThread::addSource( SFXStreamSource* pSource )
+{
+   if ( smpThread == NULL )
+      return;
+
+   smpSourceMutex->lock();
+   smSources.push_back( pSource );
+   smpSourceMutex->unlock();
+
+   wake();
+}
+
+//--------------------------------------------------------------------------
+
+void SFXStreamThread::removeSource( SFXStreamSource* pSource )
+{
+   if ( smpThread == NULL )
+      return;
+
+   // The worker holds the lock for a whole pass so it can't be using the source once we have it.
+   smpSourceMutex->lock();
+   for ( S32 n = 0; n < smSources.size(); ++n )
+   {
+      if ( smSources[n] == pSource )
+      {
+         smSources.erase_fast( n );
+         break;
+      }
+   }
+   smpSourceMutex->unlock();
+}
+
+//--------------------------------------------------------------------------
+
+void SFXStreamThread::wake( void )
+{
+   if ( smpWake != NULL )
+      smpWake->release();
+}
+
+//--------------------------------------------------------------------------
+
+void SFXStreamThread::resetMetrics( void )
+{
+   smChunkCount.store( 0 );
+   smDecodeTime.store( 0 );
+   smUnderrunCount = 0;
+}
+
+//--------------------------------------------------------------------------
+
+void SFXStreamThread::workerThread( void* pArg )
+{
+   while ( true )
+   {
+      smpWake->acquire();
+
+      if ( smShutdown.load() )
+         break;
+
+      // The profiler is main thread only so time the pass ourselves.
+      const U32 startTime = Platform::getRealMilliseconds();
+
+      smpSourceMutex->lock();
+      for ( S32 n = 0; n < smSources.size(); ++n )
+         smSources[n]->decodeAhead();
+      smpSourceMutex->unlock();
+
+      addDecodeTime( Platform::getRealMilliseconds() - startTime );
+   }
+}
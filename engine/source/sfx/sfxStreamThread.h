@@ -0,0 +1,154 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _SFXSTREAMTHREAD_H_
+#define _SFXSTREAMTHREAD_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_SEMAPHORE_H_
+#include "platform/threads/semaphore.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
+
+#include <atomic>
+
+class SFXStreamSource;
+
+//--------------------------------------------------------------------------
+
+/// A fixed ring of decoded PCM chunks.
+///
+/// There must be exactly one producer and one consumer.  Each side only
+/// writes its own index so no lock is needed.
+class SFXStreamQueue
+{
+public:
+   enum
+   {
+      ChunkCount = 4,
+      ChunkSize = 32768,
+   };
+
+   struct Chunk
+   {
+      U32   mSize;
+      U8    mData[ChunkSize];
+   };
+
+private:
+   Chunk             mChunks[ChunkCount];
+   std::atomic<U32>  mRead;
+   std::atomic<U32>  mWrite;
+
+public:
+   SFXStreamQueue() : mRead( 0 ), mWrite( 0 ) {}
+
+   /// Only valid while neither side is using the queue.
+   inline void reset( void )              { mRead.store( 0 ); mWrite.store( 0 ); }
+
+   inline bool isEmpty( void ) const      { return mRead.load( std::memory_order_acquire ) == mWrite.load( std::memory_order_acquire ); }
+
+   /// Producer.  Returns NULL if the queue is full.
+   inline Chunk* beginWrite( void )
+   {
+      const U32 write = mWrite.load( std::memory_order_relaxed );
+      if ( write - mRead.load( std::memory_order_acquire ) >= ChunkCount )
+         return NULL;
+
+      return &mChunks[write % ChunkCount];
+   }
+
+   inline void endWrite( void )           { mWrite.store( mWrite.load( std::memory_order_relaxed ) + 1, std::memory_order_release ); }
+
+   /// Consumer.  Returns NULL if the queue is empty.
+   inline const Chunk* beginRead( void )
+   {
+      const U32 read = mRead.load( std::memory_order_relaxed );
+      if ( read == mWrite.load( std::memory_order_acquire ) )
+         return NULL;
+
+      return &mChunks[read % ChunkCount];
+   }
+
+   inline void endRead( void )            { mRead.store( mRead.load( std::memory_order_relaxed ) + 1, std::memory_order_release ); }
+};
+
+//--------------------------------------------------------------------------
+
+/// Decodes streaming sources ahead of playback on a dedicated worker thread.
+///
+/// The worker only decodes into each source's SFXStreamQueue.  OpenAL is only
+/// called from the main thread, which moves decoded chunks into buffers.  When
+/// the worker isn't running sources decode on the main thread instead.
+class SFXStreamThread
+{
+private:
+   static Thread*                   smpThread;
+   static Semaphore*                smpWake;
+   static Mutex*                    smpSourceMutex;
+   static Vector<SFXStreamSource*>  smSources;
+   static std::atomic<bool>         smShutdown;
+
+   static std::atomic<U32>          smChunkCount;
+   static std::atomic<U32>          smDecodeTime;
+   static U32                       smUnderrunCount;
+
+   static void                      workerThread( void* pArg );
+
+public:
+   static void                      create( void );
+   static void                      destroy( void );
+   static inline bool               isRunning( void )        { return smpThread != NULL; }
+
+   /// Once a source has been removed the worker no longer touches it.
+   static void                      addSource( SFXStreamSource* pSource );
+   static void                      removeSource( SFXStreamSource* pSource );
+
+   /// Wake the worker after chunks have been consumed.
+   static void                      wake( void );
+
+   /// Metrics.
+   static inline void               addChunk( void )                         { smChunkCount.fetch_add( 1, std::memory_order_relaxed ); }
+   static inline void               addDecodeTime( const U32 ms )            { smDecodeTime.fetch_add( ms, std::memory_order_relaxed ); }
+   static inline void               addUnderrun( void )                      { smUnderrunCount++; }
+   static inline U32                getChunkCount( void )                    { return smChunkCount.load( std::memory_order_relaxed ); }
+   static inline U32                getDecodeTime( void )                    { return smDecodeTime.load( std::memory_order_relaxed ); }
+   static inline U32                getUnderrunCount( void )                 { return smUnderrunCount; }
+   static void                      resetMetrics( void );
+};
+
+#endif // _SFXSTREAMTHREAD_H_
@@ -10,7 +10,6 @@
 
 #include "sfx/sfxVorbisStreamSource.h"
 
-#define BUFFERSIZE 32768
 #define CHUNKSIZE 4096
 
 #if defined(TORQUE_BIG_ENDIAN)
@@ -68,6 +67,7 @@ SFXVorbisStreamSource::SFXVorbisStreamSource(const OPENALFNTABLE &oalft,
    bBuffersAllocated = false;
    bVorbisFileInitialized = false;
    mBufferList[0] = 0;
+   mDecodeFinished = false;
    clear();
 
    mFilename = filename;
@@ -106,6 +106,11 @@ void SFXVorbisStreamSource::clear()
    bIsValid = false;
    bBuffersAllocated = false;
    bVorbisFileInitialized = false;
+   mFreeBufferCount = 0;
+   buffersinqueue = 0;
+   mBytesPerSecond = 0;
+   mBytesQueued = 0;
+   mTotalTime = 0.f;
 }
 
 bool SFXVorbisStreamSource::initStream()
@@ -114,12 +119,10 @@ bool SFXVorbisStreamSource::initStream()
 
    ALint error;
 
-   bFinished = false;
+   // Make sure the worker is done with us before the stream and queue are reset.
+   SFXStreamThread::removeSource(this);
 
-   // CSH 11/1/15 - Page 404's, not sure what bug this was working around??
-   // JMQ: changed buffer to static and doubled size.  workaround for
-   // https://206.163.64.242/mantis/view_bug_page.php?f_id=0000242
-   static char data[BUFFERSIZE * 2];
+   bFinished = false;
 
    mOpenAL.alSourceStop(mSource);
    mOpenAL.alSourcei(mSource, AL_BUFFER, 0);
@@ -170,6 +173,9 @@ bool SFXVorbisStreamSource::initStream()
          DataSize = 4 * samples;
       }
       DataLeft = DataSize;
+      mBytesPerSecond = freq * (vi->channels == 1 ? 2 : 4);
+      mTotalTime = (F32)ov_time_total(&vf, -1);
+      mBytesQueued = 0;
 
       // Clear Error Code
       mOpenAL.alGetError();
@@ -180,37 +186,24 @@ bool SFXVorbisStreamSource::initStream()
 
       bBuffersAllocated = true;
 
-      int numBuffers = 0;
       for (int loop = 0; loop < NUMBUFFERS; loop++)
-      {
-         ALuint DataToRead = (DataLeft > BUFFERSIZE) ? BUFFERSIZE : DataLeft;
-         if (DataToRead == DataLeft)
-            bFinished = AL_TRUE;
-
-         long ret = oggRead(data, BUFFERSIZE, ENDIAN, &current_section);
-         if (ret <= 0)
-         {
-            bFinished = AL_TRUE;
-            break;
-         }
-
-         DataLeft -= ret;
-         mOpenAL.alBufferData(mBufferList[loop], format, data, ret, freq);
-         ++numBuffers;
-
-         if ((error = mOpenAL.alGetError()) != AL_NO_ERROR)
-            return false;
-         if (bFinished)
-            break;
-      }
+         mFreeBuffers[loop] = mBufferList[loop];
+      mFreeBufferCount = NUMBUFFERS;
+      buffersinqueue = 0;
 
-      // Queue the buffers on the source
-      mOpenAL.alSourceQueueBuffers(mSource, NUMBUFFERS, mBufferList);
-      if ((error = mOpenAL.alGetError()) != AL_NO_ERROR)
+      // Decode the first chunks here so the source can start straight away.
+      mQueue.reset();
+      mDecodeFinished = false;
+      decodeAhead();
+
+      if (!queueChunks())
          return false;
 
       mOpenAL.alSourcei(mSource, AL_LOOPING, AL_FALSE);
       bReady = true;
+
+      // The worker owns decoding from here.
+      SFXStreamThread::addSource(this);
    }
    else
    {
@@ -227,99 +220,132 @@ bool SFXVorbisStreamSource::updateBuffers()
    ALuint         BufferID;
    ALint         error;
 
-   // CSH 11/1/15 - Page 404's, not sure what bug this was working around??
-   // JMQ: changed buffer to static and doubled size.  workaround for
-   // https://206.163.64.242/mantis/view_bug_page.php?f_id=0000242
-   static char data[BUFFERSIZE * 2];
-
    // don't do anything if stream not loaded properly
    if (!bIsValid)
       return false;
 
-   if (bFinished && mDescription.mIsLooping)
-      resetStream();
+   // Decode here if there is no worker.
+   if (!SFXStreamThread::isRunning())
+   {
+      const U32 startTime = Platform::getRealMilliseconds();
+      decodeAhead();
+      SFXStreamThread::addDecodeTime(Platform::getRealMilliseconds() - startTime);
+   }
 
    // reset AL error code
    mOpenAL.alGetError();
 
-#if 1 //def TORQUE_OS_LINUX
-   // JMQ: this doesn't really help on linux.  it may make things worse.
-   // if it doesn't help on mac/win either, could disable it.
+   // Get status
+   mOpenAL.alGetSourcei(mSource, AL_BUFFERS_PROCESSED, &processed);
+
+   // Unqueue the buffers that have been played.
+   while (processed > 0)
+   {
+      mOpenAL.alSourceUnqueueBuffers(mSource, 1, &BufferID);
+      if ((error = mOpenAL.alGetError()) != AL_NO_ERROR)
+         return false;
+
+      mFreeBuffers[mFreeBufferCount++] = BufferID;
+      buffersinqueue--;
+      processed--;
+   }
+
+   // Refill them with whatever has been decoded.
+   if (!queueChunks())
+      return false;
+
+   if (buffersinqueue == 0)
+   {
+      if (mDecodeFinished && mQueue.isEmpty())
+      {
+         bFinishedPlaying = AL_TRUE;
+         return AL_FALSE;
+      }
+
+      // Still waiting on the decoder.
+      return true;
+   }
+
    ALint state;
    mOpenAL.alGetSourcei(mSource, AL_SOURCE_STATE, &state);
    if (state == AL_STOPPED)
    {
-      // um, yeah.  you should be playing
-      // restart
+      // The source ran dry before the decoder caught up so restart it.
+      SFXStreamThread::addUnderrun();
       mOpenAL.alSourcePlay(mSource);
-      //#ifdef TORQUE_DEBUG
-      //Con::errorf(">><<>><< THE MUSIC STOPPED >><<>><<");
-      //#endif
-      return true;
    }
-#endif
 
+   return true;
+}
 
-   // Get status
-   mOpenAL.alGetSourcei(mSource, AL_BUFFERS_PROCESSED, &processed);
+bool SFXVorbisStreamSource::queueChunks()
+{
+   ALint error;
+   bool consumed = false;
 
-   // If some buffers have been played, unqueue them and load new audio into them, then add them to the queue
-   if (processed > 0)
+   const SFXStreamQueue::Chunk* pChunk;
+   while (mFreeBufferCount > 0 && (pChunk = mQueue.beginRead()) != NULL)
    {
-      while (processed)
-      {
-         mOpenAL.alSourceUnqueueBuffers(mSource, 1, &BufferID);
-         if ((error = mOpenAL.alGetError()) != AL_NO_ERROR)
-            return false;
-
-         if (!bFinished)
-         {
-            ALuint DataToRead = (DataLeft > BUFFERSIZE) ? BUFFERSIZE : DataLeft;
-
-            if (DataToRead == DataLeft)
-               bFinished = AL_TRUE;
-
-            long ret = oggRead(data, BUFFERSIZE, ENDIAN, &current_section);
-            if (ret > 0)
-            {
-               DataLeft -= ret;
-
-               mOpenAL.alBufferData(BufferID, format, data, ret, freq);
-               if ((error = mOpenAL.alGetError()) != AL_NO_ERROR)
-                  return false;
-
-               // Queue buffer
-               mOpenAL.alSourceQueueBuffers(mSource, 1, &BufferID);
-               if ((error = mOpenAL.alGetError()) != AL_NO_ERROR)
-                  return false;
-            }
-
-            processed--;
-
-            if (bFinished && mDescription.mIsLooping)
-            {
-               resetStream();
-            }
-         }
-         else
-         {
-            buffersinqueue--;
-            processed--;
-
-            if (buffersinqueue == 0)
-            {
-               bFinishedPlaying = AL_TRUE;
-               return AL_FALSE;
-            }
-         }
-      }
+      const ALuint BufferID = mFreeBuffers[--mFreeBufferCount];
+
+      mOpenAL.alBufferData(BufferID, format, pChunk->mData, pChunk->mSize, freq);
+      mBytesQueued += pChunk->mSize;
+      mQueue.endRead();
+      consumed = true;
+
+      if ((error = mOpenAL.alGetError()) != AL_NO_ERROR)
+         return false;
+
+      // Queue buffer
+      mOpenAL.alSourceQueueBuffers(mSource, 1, &BufferID);
+      if ((error = mOpenAL.alGetError()) != AL_NO_ERROR)
+         return false;
+
+      buffersinqueue++;
    }
 
+   // There's room to decode more.
+   if (consumed)
+      SFXStreamThread::wake();
+
    return true;
 }
 
+void SFXVorbisStreamSource::decodeAhead()
+{
+   if (!bVorbisFileInitialized || mDecodeFinished)
+      return;
+
+   SFXStreamQueue::Chunk* pChunk;
+   while ((pChunk = mQueue.beginWrite()) != NULL)
+   {
+      long ret = oggRead((char*)pChunk->mData, SFXStreamQueue::ChunkSize, ENDIAN, &current_section);
+      if (ret <= 0 && mDescription.mIsLooping && DataSize > 0)
+      {
+         resetStream();
+         ret = oggRead((char*)pChunk->mData, SFXStreamQueue::ChunkSize, ENDIAN, &current_section);
+      }
+
+      if (ret <= 0)
+      {
+         bFinished = true;
+         mDecodeFinished = true;
+         return;
+      }
+
+      DataLeft -= getMin((ALuint)ret, DataLeft);
+      pChunk->mSize = ret;
+      mQueue.endWrite();
+
+      SFXStreamThread::addChunk();
+   }
+}
+
 void SFXVorbisStreamSource::freeStream()
 {
+   // Make sure the worker is done with us.
+   SFXStreamThread::removeSource(this);
+
    bReady = false;
 
    if (stream != NULL)
@@ -334,6 +360,8 @@ void SFXVorbisStreamSource::freeStream()
       for (int i = 0; i < NUMBUFFERS; i++)
          mBufferList[i] = 0;
 
+      mFreeBufferCount = 0;
+      buffersinqueue = 0;
       bBuffersAllocated = false;
    }
 
@@ -357,6 +385,8 @@ void SFXVorbisStreamSource::setNewFile(const char * file)
    // close down old file...
    //---------------------
 
+   SFXStreamThread::removeSource(this);
+
    if (stream != NULL)
    {
       ResourceManager->closeStream(stream);
@@ -412,6 +442,9 @@ void SFXVorbisStreamSource::setNewFile(const char * file)
          DataSize = 4 * samples;
       }
       DataLeft = DataSize;
+      mBytesPerSecond = freq * (vi->channels == 1 ? 2 : 4);
+      mTotalTime = (F32)ov_time_total(&vf, -1);
+      mBytesQueued = 0;
 
       // Clear Error Code
       mOpenAL.alGetError();
@@ -419,6 +452,10 @@ void SFXVorbisStreamSource::setNewFile(const char * file)
       bFinished = AL_FALSE;
       bVorbisFileInitialized = true;
       bIsValid = true;
+
+      mQueue.reset();
+      mDecodeFinished = false;
+      SFXStreamThread::addSource(this);
    }
 }
 
@@ -459,12 +496,16 @@ long SFXVorbisStreamSource::oggRead(char *buffer, int length,
    return offset;
 }
 
+// The worker owns the decoder so these are worked out from what has been queued.
 F32 SFXVorbisStreamSource::getElapsedTime()
 {
-   return ov_time_tell(&vf);
+   if (mBytesPerSecond == 0 || DataSize == 0)
+      return 0.f;
+
+   return (F32)(mBytesQueued % DataSize) / (F32)mBytesPerSecond;
 }
 
 F32 SFXVorbisStreamSource::getTotalTime()
 {
-   return ov_time_total(&vf, -1);
+   return mTotalTime;
 }
@@ -12,6 +12,10 @@
 #include "sfx/sfxStreamSource.h"
 #endif
 
+#ifndef _SFXSTREAMTHREAD_H_
+#include "sfx/sfxStreamThread.h"
+#endif
+
 #ifndef TORQUE_OS_IOS
 #include "vorbis/vorbisfile.h"
 
@@ -26,6 +30,7 @@ public:
    virtual void freeStream();
    virtual F32 getElapsedTime();
    virtual F32 getTotalTime();
+   virtual void decodeAhead();
 
 private:
    const OPENALFNTABLE  &mOpenAL;
@@ -44,6 +49,15 @@ private:
    ALuint			      DataSize;
    ALuint			      DataLeft;
    ALuint			      buffersinqueue;
+   ALuint               mBytesPerSecond;
+   F32                  mTotalTime;
+   U64                  mBytesQueued;
+
+   /// Decoded chunks waiting for a buffer and the buffers waiting for a chunk.
+   SFXStreamQueue       mQueue;
+   std::atomic<bool>    mDecodeFinished;
+   ALuint               mFreeBuffers[NUMBUFFERS];
+   S32                  mFreeBufferCount;
 
    bool			         bBuffersAllocated;
    bool			         bVorbisFileInitialized;
@@ -54,6 +68,7 @@ private:
    void clear();
    long oggRead(char *buffer, int length, int bigendianp, int *bitstream);
    void resetStream();
+   bool queueChunks();
    void setNewFile(const char * file);
 };
 #endif
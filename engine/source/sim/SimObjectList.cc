@@ -61,20 +61,86 @@ void SimObjectList::pushFront(SimObject* obj)
 
 //-----------------------------------------------------------------------------
 
+S32 SimObjectList::findLast(SimObject* obj) const
+{
+   // Search from the back as recently added objects are the most likely to be removed.
+   for (S32 index = size() - 1; index >= 0; --index)
+   {
+      if ((*this)[index] == obj)
+         return index;
+   }
+
+   return -1;
+}
+
+//-----------------------------------------------------------------------------
+
 void SimObjectList::remove(SimObject* obj)
 {
-   iterator ptr = ::find(begin(),end(),obj);
-   if (ptr != end()) 
-      erase(ptr);
+   removeStable(obj);
 }
 
 //-----------------------------------------------------------------------------
 
 void SimObjectList::removeStable(SimObject* obj)
 {
-   iterator ptr = ::find(begin(),end(),obj);
-   if (ptr != end()) 
-      erase(ptr);
+   // Sets are emptied from the front so check it before searching from the back.
+   const S32 index = (size() > 0 && (*this)[0] == obj) ? 0 : findLast(obj);
+   if (index != -1)
+      erase(begin() + index);
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SimObjectList::removeObjects(const SimObjectList& objects, SimObjectList* pRemoved)
+{
+   if (objects.empty() || empty())
+      return 0;
+
+   // Sort the objects to remove so each member can be tested with a binary search.
+   SimObjectList sorted;
+   sorted.merge(objects);
+   dQsort(sorted.address(),sorted.size(),sizeof(value_type),comparePtr);
+
+   // Compact the list in a single pass preserving order.
+   S32 count = 0;
+   for (S32 index = 0; index < size(); ++index)
+   {
+      SimObject* obj = (*this)[index];
+      if (sorted.containsSorted(obj))
+      {
+         if (pRemoved)
+            pRemoved->push_back(obj);
+         continue;
+      }
+
+      (*this)[count++] = obj;
+   }
+
+   const U32 removed = size() - count;
+   setSize(count);
+   return removed;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SimObjectList::containsSorted(SimObject* obj) const
+{
+   S32 low = 0;
+   S32 high = size() - 1;
+   while (low <= high)
+   {
+      const S32 mid = (low + high) >> 1;
+      const SimObject* pMid = (*this)[mid];
+      if (pMid == obj)
+         return true;
+      if (pMid < obj)
+         low = mid + 1;
+      else
+         high = mid - 1;
+   }
+
+   return false;
 }
 
 //-----------------------------------------------------------------------------
@@ -91,3 +157,12 @@ S32 QSORT_CALLBACK SimObjectList::compareId(const void* a,const void* b)
    return (*reinterpret_cast<const SimObject* const*>(a))->getId() -
       (*reinterpret_cast<const SimObject* const*>(b))->getId();
 }
+
+//-----------------------------------------------------------------------------
+
+S32 QSORT_CALLBACK SimObjectList::comparePtr(const void* a,const void* b)
+{
+   const SimObject* pA = *reinterpret_cast<const SimObject* const*>(a);
+   const SimObject* pB = *reinterpret_cast<const SimObject* const*>(b);
+   return pA < pB ? -1 : pA > pB ? 1 : 0;
+}
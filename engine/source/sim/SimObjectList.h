@@ -36,6 +36,7 @@ class SimObject;
 class SimObjectList : public VectorPtr<SimObject*>
 {
    static S32 QSORT_CALLBACK compareId(const void* a,const void* b);
+   static S32 QSORT_CALLBACK comparePtr(const void* a,const void* b);
 
 public:
    void pushBack(SimObject*);       ///< Add the SimObject* to the end of the list, unless it's already in the list.
@@ -48,6 +49,17 @@ public:
    /// Remove the SimObject* from the list; guaranteed to preserve list order.
    void removeStable(SimObject* pObject);
 
+   /// Find the last index of the SimObject* in the list or -1 if it is not present.
+   S32 findLast(SimObject* pObject) const;
+
+   /// Remove all of the specified SimObject* from the list in a single pass; preserves list order.
+   /// Objects that were actually in the list are appended to pRemoved, if given, in list order.
+   /// Returns the number of objects removed.
+   U32 removeObjects(const SimObjectList& objects, SimObjectList* pRemoved = NULL);
+
+   /// Check if the SimObject* is in a list sorted by address.
+   bool containsSorted(SimObject* pObject) const;
+
    void sortId();                   ///< Sort the list by object ID.
 };
 
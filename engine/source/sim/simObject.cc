@@ -956,49 +956,74 @@ void SimObject::freeNotify(SimObject::Notify* note)
 
 //------------------------------------------------------------------------------
 
-SimObject::Notify* SimObject::removeNotify(void *ptr, SimObject::Notify::Type type)
+SimObject::Notify* SimObject::findNotify(void *ptr, SimObject::Notify::Type type) const
 {
-   Notify **list = &mNotifyList;
-   while(*list)
+   for(Notify *note = mNotifyList; note; note = note->next)
    {
-      if((*list)->ptr == ptr && (*list)->type == type)
-      {
-         SimObject::Notify *ret = *list;
-         *list = ret->next;
-         return ret;
-      }
-      list = &((*list)->next);
+      if(note->ptr == ptr && note->type == type)
+         return note;
    }
    return NULL;
 }
 
+void SimObject::linkNotify(SimObject::Notify* note)
+{
+   note->prev = NULL;
+   note->next = mNotifyList;
+   if(mNotifyList)
+      mNotifyList->prev = note;
+   mNotifyList = note;
+}
+
+void SimObject::unlinkNotify(SimObject::Notify* note)
+{
+   if(note->prev)
+      note->prev->next = note->next;
+   else
+      mNotifyList = note->next;
+
+   if(note->next)
+      note->next->prev = note->prev;
+
+   note->next = note->prev = NULL;
+}
+
+SimObject::Notify* SimObject::removeNotify(void *ptr, SimObject::Notify::Type type)
+{
+   Notify *note = findNotify(ptr, type);
+   if(note)
+      unlinkNotify(note);
+   return note;
+}
+
 void SimObject::deleteNotify(SimObject* obj)
 {
    AssertFatal(!obj->isDeleted(),
                "SimManager::deleteNotify: Object is being deleted");
+
+   // The pair of notifications reference each other so either side
+   // can be removed without searching the other object's list.
    Notify *note = allocNotify();
    note->ptr = (void *) this;
-   note->next = obj->mNotifyList;
    note->type = Notify::DeleteNotify;
-   obj->mNotifyList = note;
+   obj->linkNotify(note);
 
-   note = allocNotify();
-   note->ptr = (void *) obj;
-   note->next = mNotifyList;
-   note->type = Notify::ClearNotify;
-   mNotifyList = note;
+   Notify *cnote = allocNotify();
+   cnote->ptr = (void *) obj;
+   cnote->type = Notify::ClearNotify;
+   linkNotify(cnote);
 
-   //obj->deleteNotifyList.pushBack(this);
-   //clearNotifyList.pushBack(obj);
+   note->partner = cnote;
+   cnote->partner = note;
 }
 
 void SimObject::registerReference(SimObject **ptr)
 {
    Notify *note = allocNotify();
    note->ptr = (void *) ptr;
-   note->next = mNotifyList;
    note->type = Notify::ObjectRef;
-   mNotifyList = note;
+   note->partner = NULL;
+   linkNotify(note);
 }
 
 void SimObject::unregisterReference(SimObject **ptr)
@@ -1010,13 +1035,15 @@ void SimObject::unregisterReference(SimObject **ptr)
 
 void SimObject::clearNotify(SimObject* obj)
 {
+   // Search the cleared object's list as it is typically much shorter
+   // than ours i.e. a set with many members.
    Notify *note = obj->removeNotify((void *) this, Notify::DeleteNotify);
-   if(note)
-      freeNotify(note);
+   if(!note)
+      return;
 
-   note = removeNotify((void *) obj, Notify::ClearNotify);
-   if(note)
-      freeNotify(note);
+   unlinkNotify(note->partner);
+   freeNotify(note->partner);
+   freeNotify(note);
 }
 
 void SimObject::processDeleteNotifies()
@@ -1027,14 +1054,15 @@ void SimObject::processDeleteNotifies()
    while(mNotifyList)
    {
       Notify *note = mNotifyList;
-      mNotifyList = note->next;
+      unlinkNotify(note);
 
       AssertFatal(note->type != Notify::ClearNotify, "Clear notes should be all gone.");
 
       if(note->type == Notify::DeleteNotify)
       {
          SimObject *obj = (SimObject *) note->ptr;
-         Notify *cnote = obj->removeNotify((void *)this, Notify::ClearNotify);
+         Notify *cnote = note->partner;
+         obj->unlinkNotify(cnote);
          obj->onDeleteNotify(this);
          freeNotify(cnote);
       }
@@ -1049,18 +1077,18 @@ void SimObject::processDeleteNotifies()
 
 void SimObject::clearAllNotifications()
 {
-   for(Notify **cnote = &mNotifyList; *cnote; )
+   for(Notify *cnote = mNotifyList; cnote; )
    {
-      Notify *temp = *cnote;
+      Notify *temp = cnote;
+      cnote = cnote->next;
+
       if(temp->type == Notify::ClearNotify)
       {
-         *cnote = temp->next;
-         Notify *note = ((SimObject *) temp->ptr)->removeNotify((void *) this, Notify::DeleteNotify);
+         unlinkNotify(temp);
+         ((SimObject *) temp->ptr)->unlinkNotify(temp->partner);
+         freeNotify(temp->partner);
          freeNotify(temp);
-         freeNotify(note);
       }
-      else
-         cnote = &(temp->next);
    }
 }
 
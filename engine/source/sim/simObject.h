@@ -285,6 +285,8 @@ public:
         } type;
         void *ptr;        ///< Data (typically referencing or interested object).
         Notify *next;     ///< Next notification in the linked list.
+        Notify *prev;     ///< Previous notification in the linked list.
+        Notify *partner;  ///< Matching notification on the other object for delete/clear notifications.
     };
 
     /// @}
@@ -518,6 +520,9 @@ public:
     /// @name Notification
     /// @{
     Notify *removeNotify(void *ptr, Notify::Type);   ///< Remove a notification from the list.
+    Notify *findNotify(void *ptr, Notify::Type) const; ///< Find a notification in the list.
+    void linkNotify(Notify* note);                   ///< Add a notification to the front of the list.
+    void unlinkNotify(Notify* note);                 ///< Remove a notification from the list.
     void deleteNotify(SimObject* obj);               ///< Notify an object when we are deleted.
     void clearNotify(SimObject* obj);                ///< Notify an object when we are cleared.
     void clearAllNotifications();                    ///< Remove all notifications for this object.
@@ -726,6 +731,7 @@ public:
     void setExpanded(bool exp) { if(exp) mFlags.set(Expanded); else mFlags.clear(Expanded); }
     void setModDynamicFields(bool dyn) { if(dyn) mFlags.set(ModDynamicFields); else mFlags.clear(ModDynamicFields); }
     void setModStaticFields(bool sta) { if(sta) mFlags.set(ModStaticFields); else mFlags.clear(ModStaticFields); }
+    bool isModStaticFields() const { return mFlags.test(ModStaticFields); }
 
     /// @}
 
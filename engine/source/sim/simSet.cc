@@ -42,19 +42,51 @@
 void SimSet::addObject(SimObject* obj)
 {
    lock();
-   objectList.pushBack(obj);
-   deleteNotify(obj);
+
+   // Members are always delete-notified so the list only needs
+   // searching if the object already notifies us.
+   if (obj->findNotify(this, Notify::DeleteNotify) == NULL || objectList.findLast(obj) == -1)
+   {
+      objectList.push_back(obj);
+      deleteNotify(obj);
+   }
+
    unlock();
 }
 
 void SimSet::removeObject(SimObject* obj)
 {
    lock();
-   objectList.remove(obj);
+   removeFromList(obj);
    clearNotify(obj);
    unlock();
 }
 
+void SimSet::removeFromList(SimObject* obj)
+{
+   // The object being deleted by deleteObjects() only clears its slot.
+   if (mDeletingObjects && mDeletedCount < objectList.size() && objectList[mDeletedCount] == obj)
+   {
+      objectList[mDeletedCount++] = NULL;
+      return;
+   }
+
+   objectList.remove(obj);
+}
+
+void SimSet::removeObjects(const SimObjectList& objects)
+{
+   lock();
+
+   // Remove the objects in a single pass then clear the notifications of those that were members.
+   SimObjectList removed;
+   objectList.removeObjects(objects, &removed);
+   for (S32 i = 0; i < removed.size(); i++)
+      clearNotify(removed[i]);
+
+   unlock();
+}
+
 void SimSet::pushObject(SimObject* pObj)
 {
    lock();
@@ -209,10 +241,28 @@ void SimSet::write(Stream &stream, U32 tabStop, U32 flags)
 void SimSet::deleteObjects( void )
 {
     lock();
+
+    // A nested call leaves the compaction to the outer one.
+    const bool nested = mDeletingObjects;
+    mDeletingObjects = true;
+
         while(size() > 0 )
         {
-            objectList[0]->deleteObject();
+            first()->deleteObject();
         }
+
+    // Compact the cleared slots.
+    if ( !nested )
+    {
+        const S32 liveCount = objectList.size() - mDeletedCount;
+        for ( S32 index = 0; index < liveCount; ++index )
+            objectList[index] = objectList[index + mDeletedCount];
+        objectList.setSize( liveCount );
+
+        mDeletedCount = 0;
+        mDeletingObjects = false;
+    }
+
     unlock();
 }
 
@@ -375,13 +425,42 @@ void SimGroup::removeObject(SimObject* obj)
    {
       obj->onGroupRemove();
       nameDictionary.remove(obj);
-      objectList.remove(obj);
+      removeFromList(obj);
       obj->mGroup = 0;
 	  onChildRemoved(obj);
    }
    unlock();
 }
 
+void SimGroup::removeObjects(const SimObjectList& objects)
+{
+   lock();
+
+   // Detach our children.
+   SimObjectList children;
+   for (S32 i = 0; i < objects.size(); i++)
+   {
+      SimObject* obj = objects[i];
+      if (obj->mGroup != this)
+         continue;
+
+      obj->onGroupRemove();
+      nameDictionary.remove(obj);
+      children.push_back(obj);
+   }
+
+   // Remove them in a single pass.
+   objectList.removeObjects(children);
+
+   for (S32 i = 0; i < children.size(); i++)
+   {
+      children[i]->mGroup = 0;
+      onChildRemoved(children[i]);
+   }
+
+   unlock();
+}
+
 void SimGroup::onChildRemoved(SimObject* obj)
 {
 	//Left blank...
@@ -107,10 +107,21 @@ protected:
    SimObjectList objectList;
    void *mMutex;
 
+   /// While deleteObjects() runs, objects are deleted from the front and only clear their
+   /// slot as they are removed.  The cleared slots are hidden then compacted once at the end.
+   bool mDeletingObjects;
+   S32 mDeletedCount;
+
+   /// Remove an object from the list, deferring the compaction while deleting objects.
+   void removeFromList(SimObject* obj);
+
 public:
    SimSet() {
       VECTOR_SET_ASSOCIATION(objectList);
 
+      mDeletingObjects = false;
+      mDeletedCount = 0;
+
       mMutex = Mutex::createMutex();
    }
 
@@ -128,14 +139,14 @@ public:
    ///
    typedef SimObjectList::iterator iterator;
    typedef SimObjectList::value_type value;
-   SimObject* front() { return objectList.front(); }
-   SimObject* first() { return objectList.first(); }
+   SimObject* front() { return objectList[U32(mDeletedCount)]; }
+   SimObject* first() { return objectList[U32(mDeletedCount)]; }
    SimObject* last()  { return objectList.last(); }
-   bool       empty() { return objectList.empty();   }
-   S32        size() const  { return objectList.size(); }
-   iterator   begin() { return objectList.begin(); }
+   bool       empty() { return size() == 0;   }
+   S32        size() const  { return objectList.size() - mDeletedCount; }
+   iterator   begin() { return objectList.begin() + mDeletedCount; }
    iterator   end()   { return objectList.end(); }
-   value operator[] (S32 index) { return objectList[U32(index)]; }
+   value operator[] (S32 index) { return objectList[U32(index + mDeletedCount)]; }
 
    inline iterator find( iterator first, iterator last, SimObject *obj ) { return ::find(first, last, obj); }
    inline iterator find( SimObject *obj ) { return ::find(begin(), end(), obj); }
@@ -152,8 +163,10 @@ public:
    }
 
    virtual bool reOrder( SimObject *obj, SimObject *target=0 );
-   SimObject* at(S32 index) const { return objectList.at(index); }
+   SimObject* at(S32 index) const { return objectList.at(index + mDeletedCount); }
 
+   /// Delete all the objects in the set, front to back.  Each object is still in the set
+   /// while it is deleted.
    void deleteObjects( void );
 
    void clear();
@@ -168,6 +181,12 @@ public:
    virtual void addObject(SimObject*);      ///< Add an object to the set.
    virtual void removeObject(SimObject*);   ///< Remove an object from the set.
 
+   /// Remove many objects from the set.
+   ///
+   /// The objects are removed in a single pass so this should be preferred over
+   /// removeObject() when removing many objects from a large set.
+   virtual void removeObjects(const SimObjectList& objects);
+
    virtual void pushObject(SimObject*);     ///< Add object to end of list.
    ///
    /// It will force the object to the end of the list if it already exists
@@ -307,6 +326,7 @@ public:
 
    /// Remove an object from the group.
    virtual void removeObject(SimObject*);
+   virtual void removeObjects(const SimObjectList& objects);
 
    virtual void onRemove();
 
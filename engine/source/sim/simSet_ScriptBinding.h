@@ -237,16 +237,21 @@ ConsoleMethodWithDocs(SimSet, add, ConsoleVoid, 3, 0, (obj1, [obj2]*))
 */
 ConsoleMethodWithDocs(SimSet, remove, ConsoleVoid, 3, 0, (obj1, [obj2]*))
 {
+   SimObjectList objects;
+
+   object->lock();
    for(S32 i = 2; i < argc; i++)
    {
       SimObject *obj = Sim::findObject(argv[i]);
-      object->lock();
       if(obj && object->find(object->begin(),object->end(),obj) != object->end())
-         object->removeObject(obj);
+         objects.push_back(obj);
       else
          Con::printf("Set::remove: Object \"%s\" does not exist in set", argv[i]);
-      object->unlock();
    }
+
+   // Remove the objects together.
+   object->removeObjects(objects);
+   object->unlock();
 }
 
 //-----------------------------------------------------------------------------
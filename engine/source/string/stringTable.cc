@@ -23,71 +23,120 @@
 #include "platform/platform.h"
 #include "stringTable.h"
 
+#include <atomic>
+#include <new>
+
 _StringTable *_gStringTable = NULL;
-const U32 _StringTable::csm_stInitSize = 29;
+const U32 _StringTable::csm_stInitSize = 32;
 StringTableEntry _StringTable::EmptyString;
 
 //---------------------------------------------------------------
 //
-// StringTable functions
+// StringTable internals
 //
 //---------------------------------------------------------------
 
+/// A string in the table.  Nodes are never moved or freed so the string
+/// pointer is the StringTableEntry.
+struct _StringTable::Node
+{
+   char *val;
+   U32   hash;
+
+   /// The next node in the shard in insertion order.  Only used when growing.
+   Node *next;
+};
+
+/// An open-addressed table of nodes.  Slots are only ever filled so readers can
+/// probe without a lock.  A table is never freed while the string table exists
+/// so a reader may finish probing a table that has since been replaced.
+struct _StringTable::Table
+{
+   U32                  size;
+   Table*               previous;
+   std::atomic<Node*>*  slots;
+};
+
+struct _StringTable::Shard
+{
+   Mutex                mutex;
+   std::atomic<Table*>  table;
+   Node*                first;
+   Node*                last;
+   U32                  itemCount;
+   DataChunker          mempool;
+};
+
 namespace {
-bool sgInitTable = true;
-U8   sgHashTable[256];
 
-void initTolowerTable()
+inline U8 foldCase(const U8 c)
 {
-   for (U32 i = 0; i < 256; i++) {
-      U8 c = dTolower(i);
-      sgHashTable[i] = c * c;
-   }
+   return (U8)(c - 'A') < 26 ? c | 0x20 : c;
+}
+
+inline U32 finalizeHash(U32 hash)
+{
+   // Avalanche so both the shard and slot bits are well mixed.
+   hash ^= hash >> 16;
+   hash *= 0x85ebca6b;
+   hash ^= hash >> 13;
+   hash *= 0xc2b2ae35;
+   hash ^= hash >> 16;
+   return hash;
+}
 
-   sgInitTable = false;
+inline bool matchNode(const char *nodeVal, const char *val, const S32 len, const bool caseSens)
+{
+   if (len < 0)
+      return caseSens ? !dStrcmp(nodeVal, val) : !dStricmp(nodeVal, val);
+
+   if (caseSens)
+      return !dStrncmp(nodeVal, val, len) && nodeVal[len] == 0;
+
+   return !dStrnicmp(nodeVal, val, len) && nodeVal[len] == 0;
 }
 
 } // namespace {}
 
+//---------------------------------------------------------------
+
 U32 _StringTable::hashString(const char* str)
 {
-   if (sgInitTable)
-      initTolowerTable();
-
-   U32 ret = 0;
-   char c;
-   while((c = *str++) != 0) {
-      ret <<= 1;
-      ret ^= sgHashTable[c];
+   // FNV-1a over the case folded string.
+   U32 ret = 2166136261u;
+   U8 c;
+   while((c = (U8)*str++) != 0) {
+      ret ^= foldCase(c);
+      ret *= 16777619u;
    }
-   return ret;
+   return finalizeHash(ret);
 }
 
 U32 _StringTable::hashStringn(const char* str, S32 len)
 {
-   if (sgInitTable)
-      initTolowerTable();
-
-   U32 ret = 0;
-   char c;
-   while((c = *str++) != 0 && len--) {
-      ret <<= 1;
-      ret ^= sgHashTable[c];
+   U32 ret = 2166136261u;
+   U8 c;
+   while(len-- > 0 && (c = (U8)*str++) != 0) {
+      ret ^= foldCase(c);
+      ret *= 16777619u;
    }
-   return ret;
+   return finalizeHash(ret);
 }
 
 //--------------------------------------
 _StringTable::_StringTable()
 {
-   buckets = (Node **) dMalloc(csm_stInitSize * sizeof(Node *));
-   for(U32 i = 0; i < csm_stInitSize; i++) {
-      buckets[i] = 0;
+   mShards = new Shard[ShardCount];
+
+   for(U32 i = 0; i < ShardCount; i++) {
+      Shard& shard = mShards[i];
+      shard.table.store(NULL, std::memory_order_relaxed);
+      shard.first = NULL;
+      shard.last = NULL;
+      shard.itemCount = 0;
+      growShard(shard, csm_stInitSize);
    }
 
-   numBuckets = csm_stInitSize;
-   itemCount = 0;
-
    // Insert empty string.
    EmptyString = insert("");
 }
@@ -95,7 +144,16 @@ _StringTable::_StringTable()
 //--------------------------------------
 _StringTable::~_StringTable()
 {
-   dFree(buckets);
+   for(U32 i = 0; i < ShardCount; i++) {
+      Table *walk = mShards[i].table.load(std::memory_order_relaxed);
+      while(walk) {
+         Table *temp = walk->previous;
+         dFree(walk);
+         walk = temp;
+      }
+   }
+
+   delete [] mShards;
 }
 
 
@@ -118,37 +176,111 @@ void _StringTable::destroy()
 }
 
 //--------------------------------------
-StringTableEntry _StringTable::insert(const char* val, const bool  caseSens)
+StringTableEntry _StringTable::findNode(const Table* table, const char* val, const S32 len, const U32 hash, const bool caseSens)
 {
-   if ( val == NULL )
-       return StringTable->EmptyString;
-
-   MutexHandle mutex;
-   mutex.lock(&mMutex, true);
-
-   Node **walk, *temp;
-   U32 key = hashString(val);
-   walk = &buckets[key % numBuckets];
-   while((temp = *walk) != NULL)   {
-      if(caseSens && !dStrcmp(temp->val, val))
-         return temp->val;
-      else if(!caseSens && !dStricmp(temp->val, val))
+   // Strings that differ only by case have the same hash and are found in the
+   // order they were added so a case insensitive match finds the first added.
+   const U32 mask = table->size - 1;
+   U32 index = hash & mask;
+   Node *temp;
+   while((temp = table->slots[index].load(std::memory_order_acquire)) != NULL) {
+      if(temp->hash == hash && matchNode(temp->val, val, len, caseSens))
          return temp->val;
-      walk = &(temp->next);
+      index = (index + 1) & mask;
    }
-   char *ret = 0;
-   if(!*walk) {
-      *walk = (Node *) mempool.alloc(sizeof(Node));
-      (*walk)->next = 0;
-      (*walk)->val = (char *) mempool.alloc(dStrlen(val) + 1);
-      dStrcpy((*walk)->val, val);
-      ret = (*walk)->val;
-      itemCount ++;
+   return NULL;
+}
+
+//--------------------------------------
+StringTableEntry _StringTable::insertNode(const char* val, const S32 len, const U32 hash, const bool caseSens)
+{
+   Shard& shard = mShards[hash >> (32 - ShardBits)];
+
+   // Most strings are already present so look without locking first.
+   StringTableEntry ret = findNode(shard.table.load(std::memory_order_acquire), val, len, hash, caseSens);
+   if(ret)
+      return ret;
+
+   MutexHandle mutex;
+   mutex.lock(&shard.mutex, true);
+
+   // Look again in case another thread added it.
+   Table *table = shard.table.load(std::memory_order_relaxed);
+   ret = findNode(table, val, len, hash, caseSens);
+   if(ret)
+      return ret;
+
+   // Keep the table at most half full.
+   if((shard.itemCount + 1) * 2 > table->size) {
+      growShard(shard, table->size * 2);
+      table = shard.table.load(std::memory_order_relaxed);
    }
-   if(itemCount > 2 * numBuckets) {
-      resize(4 * numBuckets - 1);
+
+   // Create the node.
+   const S32 valLen = len < 0 ? dStrlen(val) : len;
+   Node *node = (Node *) shard.mempool.alloc(sizeof(Node));
+   node->val = (char *) shard.mempool.alloc(valLen + 1);
+   dMemcpy(node->val, val, valLen);
+   node->val[valLen] = 0;
+   node->hash = hash;
+   node->next = NULL;
+
+   if(shard.last)
+      shard.last->next = node;
+   else
+      shard.first = node;
+   shard.last = node;
+   shard.itemCount++;
+
+   // Publish the node.
+   const U32 mask = table->size - 1;
+   U32 index = hash & mask;
+   while(table->slots[index].load(std::memory_order_relaxed) != NULL)
+      index = (index + 1) & mask;
+   table->slots[index].store(node, std::memory_order_release);
+
+   return node->val;
+}
+
+//--------------------------------------
+void _StringTable::growShard(Shard& shard, const U32 newSize)
+{
+   U32 size = csm_stInitSize;
+   while(size < newSize)
+      size <<= 1;
+
+   Table *previous = shard.table.load(std::memory_order_relaxed);
+   if(previous && previous->size >= size)
+      return;
+
+   Table *table = (Table *) dMalloc(sizeof(Table) + size * sizeof(std::atomic<Node*>));
+   table->size = size;
+   table->previous = previous;
+   table->slots = (std::atomic<Node*>*)(table + 1);
+   for(U32 i = 0; i < size; i++)
+      new (&table->slots[i]) std::atomic<Node*>(NULL);
+
+   // Add the nodes in the order they were added so that case insensitive
+   // matches still find the first string added.
+   const U32 mask = size - 1;
+   for(Node *walk = shard.first; walk; walk = walk->next) {
+      U32 index = walk->hash & mask;
+      while(table->slots[index].load(std::memory_order_relaxed) != NULL)
+         index = (index + 1) & mask;
+      table->slots[index].store(walk, std::memory_order_relaxed);
    }
-   return ret;
+
+   // Publish the table.  The previous table is kept for readers still probing it.
+   shard.table.store(table, std::memory_order_release);
+}
+
+//--------------------------------------
+StringTableEntry _StringTable::insert(const char* val, const bool  caseSens)
+{
+   if ( val == NULL )
+       return StringTable->EmptyString;
+
+   return insertNode(val, -1, hashString(val), caseSens);
 }
 
 //--------------------------------------
@@ -157,14 +289,38 @@ StringTableEntry _StringTable::insertn(const char* src, S32 len, const bool  cas
    if ( src == NULL )
        return StringTable->EmptyString;
 
-   MutexHandle mutex;
-   mutex.lock(&mMutex, true);
+   // Stop at any terminator inside the length.
+   S32 valLen = 0;
+   while(valLen < len && src[valLen] != 0)
+      valLen++;
 
-   char val[1024];
-   AssertFatal(len < sizeof(val), "Invalid string to insertn");
-   dStrncpy(val, src, len);
-   val[len] = 0;
-   return insert(val, caseSens);
+   return insertNode(src, valLen, hashStringn(src, valLen), caseSens);
+}
+
+//--------------------------------------
+StringTableEntry _StringTable::insertHashed(const char* val, const U32 hash, const bool  caseSens)
+{
+   if ( val == NULL )
+       return StringTable->EmptyString;
+
+   AssertFatal(hash == hashString(val), "StringTable::insertHashed: Hash does not match the string.");
+
+   return insertNode(val, -1, hash, caseSens);
+}
+
+//--------------------------------------
+StringTableEntry _StringTable::insertnHashed(const char* src, S32 len, const U32 hash, const bool  caseSens)
+{
+   if ( src == NULL )
+       return StringTable->EmptyString;
+
+   S32 valLen = 0;
+   while(valLen < len && src[valLen] != 0)
+      valLen++;
+
+   AssertFatal(hash == hashStringn(src, valLen), "StringTable::insertnHashed: Hash does not match the string.");
+
+   return insertNode(src, valLen, hash, caseSens);
 }
 
 //--------------------------------------
@@ -173,20 +329,7 @@ StringTableEntry _StringTable::lookup(const char* val, const bool  caseSens)
    if ( val == NULL )
        return StringTable->EmptyString;
 
-   MutexHandle mutex;
-   mutex.lock(&mMutex, true);
-
-   Node **walk, *temp;
-   U32 key = hashString(val);
-   walk = &buckets[key % numBuckets];
-   while((temp = *walk) != NULL)   {
-      if(caseSens && !dStrcmp(temp->val, val))
-            return temp->val;
-      else if(!caseSens && !dStricmp(temp->val, val))
-         return temp->val;
-      walk = &(temp->next);
-   }
-   return NULL;
+   return lookupHashed(val, hashString(val), caseSens);
 }
 
 //--------------------------------------
@@ -194,57 +337,49 @@ StringTableEntry _StringTable::lookupn(const char* val, S32 len, const bool  cas
 {
    if ( val == NULL )
        return StringTable->EmptyString;
-       
-   MutexHandle mutex;
-   mutex.lock(&mMutex, true);
 
-   Node **walk, *temp;
-   U32 key = hashStringn(val, len);
-   walk = &buckets[key % numBuckets];
-   while((temp = *walk) != NULL) {
-      if(caseSens && !dStrncmp(temp->val, val, len) && temp->val[len] == 0)
-         return temp->val;
-      else if(!caseSens && !dStrnicmp(temp->val, val, len) && temp->val[len] == 0)
-         return temp->val;
-      walk = &(temp->next);
-   }
-   return NULL;
+   S32 valLen = 0;
+   while(valLen < len && val[valLen] != 0)
+      valLen++;
+
+   const U32 hash = hashStringn(val, valLen);
+   return findNode(mShards[hash >> (32 - ShardBits)].table.load(std::memory_order_acquire), val, valLen, hash, caseSens);
+}
+
+//--------------------------------------
+StringTableEntry _StringTable::lookupHashed(const char* val, const U32 hash, const bool  caseSens)
+{
+   if ( val == NULL )
+       return StringTable->EmptyString;
+
+   AssertFatal(hash == hashString(val), "StringTable::lookupHashed: Hash does not match the string.");
+
+   return findNode(mShards[hash >> (32 - ShardBits)].table.load(std::memory_order_acquire), val, -1, hash, caseSens);
 }
 
 //--------------------------------------
 void _StringTable::resize(const U32 newSize)
 {
-   Node *head = NULL, *walk, *temp;
-   U32 i;
-   // reverse individual bucket lists
-   // we do this because new strings are added at the end of bucket
-   // lists so that case sens strings are always after their
-   // corresponding case insens strings
-
-   for(i = 0; i < numBuckets; i++) {
-      walk = buckets[i];
-      while(walk)
-      {
-         temp = walk->next;
-         walk->next = head;
-         head = walk;
-         walk = temp;
-      }
-   }
-   buckets = (Node **) dRealloc(buckets, newSize * sizeof(Node));
-   for(i = 0; i < newSize; i++) {
-      buckets[i] = 0;
-   }
-   numBuckets = newSize;
-   walk = head;
-   while(walk) {
-      U32 key;
-      Node *temp = walk;
-
-      walk = walk->next;
-      key = hashString(temp->val);
-      temp->next = buckets[key % newSize];
-      buckets[key % newSize] = temp;
+   // Spread the items over the shards keeping each at most half full.
+   const U32 shardSize = (newSize * 2) / ShardCount;
+
+   for(U32 i = 0; i < ShardCount; i++) {
+      MutexHandle mutex;
+      mutex.lock(&mShards[i].mutex, true);
+      growShard(mShards[i], shardSize);
    }
 }
 
+//--------------------------------------
+U32 _StringTable::getCount()
+{
+   U32 count = 0;
+
+   for(U32 i = 0; i < ShardCount; i++) {
+      MutexHandle mutex;
+      mutex.lock(&mShards[i].mutex, true);
+      count += mShards[i].itemCount;
+   }
+
+   return count;
+}
@@ -81,19 +81,24 @@ private:
    /// @name Implementation details
    /// @{
 
-   /// This is internal to the _StringTable class.
-   struct Node
+   /// The table is split into shards selected by the top bits of the hash, each with
+   /// its own lock.  Strings already in the table are found without taking a lock.
+   enum
    {
-      char *val;
-      Node *next;
+      ShardBits = 4,
+      ShardCount = 1 << ShardBits,
    };
 
-   Node**      buckets;
-   U32         numBuckets;
-   U32         itemCount;
-   DataChunker mempool;
+   /// These are internal to the _StringTable class.
+   struct Node;
+   struct Table;
+   struct Shard;
 
-   Mutex mMutex;
+   Shard*      mShards;
+
+   static StringTableEntry findNode( const Table* table, const char* val, const S32 len, const U32 hash, const bool caseSens );
+   StringTableEntry insertNode( const char* val, const S32 len, const U32 hash, const bool caseSens );
+   void growShard( Shard& shard, const U32 newSize );
 
   protected:
    static const U32 csm_stInitSize;
@@ -117,6 +122,8 @@ private:
    /// Get a pointer from the string table, adding the string to the table
    /// if it was not already present.
    ///
+   /// This is safe to call from any thread.
+   ///
    /// @param  string   String to check in the table (and add).
    /// @param  caseSens Determines whether case matters.
    StringTableEntry insert(const char *string, bool caseSens = false);
@@ -129,6 +136,23 @@ private:
    /// @param  caseSens Determines whether case matters.
    StringTableEntry insertn(const char *string, S32 len, bool caseSens = false);
 
+   /// Get a pointer from the string table using a hash already calculated with
+   /// hashString(), adding the string to the table if it was not already present.
+   ///
+   /// @param  string   String to check in the table (and add).
+   /// @param  hash     Hash of the string from hashString().
+   /// @param  caseSens Determines whether case matters.
+   StringTableEntry insertHashed(const char *string, const U32 hash, bool caseSens = false);
+
+   /// Get a pointer from the string table using a hash already calculated with
+   /// hashStringn(), adding the string to the table if it was not already present.
+   ///
+   /// @param  string   String to check in the table (and add).
+   /// @param  len      Length of the string in bytes.
+   /// @param  hash     Hash of the string from hashStringn().
+   /// @param  caseSens Determines whether case matters.
+   StringTableEntry insertnHashed(const char *string, S32 len, const U32 hash, bool caseSens = false);
+
    /// Get a pointer from the string table, NOT adding the string to the table
    /// if it was not already present.
    ///
@@ -144,6 +168,14 @@ private:
    /// @param  caseSens Determines whether case matters.
    StringTableEntry lookupn(const char *string, S32 len, bool caseSens = false);
 
+   /// Get a pointer from the string table using a hash already calculated with
+   /// hashString(), NOT adding the string to the table if it was not already present.
+   ///
+   /// @param  string   String to check in the table (but not add).
+   /// @param  hash     Hash of the string from hashString().
+   /// @param  caseSens Determines whether case matters.
+   StringTableEntry lookupHashed(const char *string, const U32 hash, bool caseSens = false);
+
 
    /// Resize the StringTable to be able to hold newSize items. This
    /// is called automatically by the StringTable when the table is
@@ -152,10 +184,13 @@ private:
    /// @param newSize   Number of new items to allocate space for.
    void             resize(const U32 newSize);
 
-   /// Hash a string into a U32.
+   /// Get the number of strings in the table.
+   U32              getCount();
+
+   /// Hash a string into a U32.  The hash ignores case.
    static U32 hashString(const char* in_pString);
 
-   /// Hash a string of given length into a U32.
+   /// Hash a string of given length into a U32.  The hash ignores case.
    static U32 hashStringn(const char* in_pString, S32 len);
 
    /// Empty string.
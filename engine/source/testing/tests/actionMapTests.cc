@@ -0,0 +1,80 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _ACTIONMAP_H_
+#include "input/actionMap.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    void bind( ActionMap* pMap, const char* pDevice, const char* pAction, const char* pFunction )
+    {
+        const char* argv[3] = { pDevice, pAction, pFunction };
+        pMap->processBind( 3, argv );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ActionMapTests, BindingLookupTest )
+{
+    ActionMap* pMap = new ActionMap();
+    pMap->registerObject();
+
+    bind( pMap, "keyboard", "a", "actionMapTestsMove" );
+    bind( pMap, "keyboard", "ctrl b", "actionMapTestsFire" );
+    bind( pMap, "keyboard", "c", "actionMapTestsMove" );
+
+    // Commands are found by event.
+    ASSERT_STREQ( "actionMapTestsMove", pMap->getCommand( "keyboard", "a" ) );
+    ASSERT_STREQ( "actionMapTestsFire", pMap->getCommand( "keyboard", "ctrl b" ) );
+    ASSERT_STREQ( "", pMap->getCommand( "keyboard", "b" ) ) << "Modifiers should be part of the lookup.";
+
+    // Bindings are found by command, case-insensitively and in bind order.
+    ASSERT_STREQ( "keyboard\ta\tkeyboard\tc", pMap->getBinding( "actionMapTestsMove" ) );
+    ASSERT_STREQ( "keyboard\ta\tkeyboard\tc", pMap->getBinding( "ACTIONMAPTESTSMOVE" ) );
+    ASSERT_STREQ( "", pMap->getBinding( "actionMapTestsNeverBound" ) );
+
+    // Rebinding an event replaces its command.
+    bind( pMap, "keyboard", "a", "actionMapTestsFire" );
+    ASSERT_STREQ( "actionMapTestsFire", pMap->getCommand( "keyboard", "a" ) );
+    ASSERT_STREQ( "keyboard\tc", pMap->getBinding( "actionMapTestsMove" ) );
+
+    // Unbinding removes the event.
+    pMap->processUnbind( "keyboard", "c" );
+    ASSERT_STREQ( "", pMap->getCommand( "keyboard", "c" ) );
+    ASSERT_STREQ( "", pMap->getBinding( "actionMapTestsMove" ) );
+
+    pMap->deleteObject();
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,152 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _FRAMEALLOCATOR_H_
+#include "memory/frameAllocator.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define FRAMEALLOCATOR_UNITTEST_THREADS         4
+#define FRAMEALLOCATOR_UNITTEST_ALLOCATIONS     4096
+#define FRAMEALLOCATOR_UNITTEST_SIZE            1024
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    /// Each job runs on its own thread so that it has a fresh arena.
+    struct ArenaJob
+    {
+        U32     mThreadIndex;
+        bool    mContentsValid;
+        bool    mAligned;
+        bool    mContained;
+        bool    mRestored;
+        bool    mMerged;
+        void*   mpFirstAllocation;
+    };
+
+    void arenaJob( void* pArg )
+    {
+        ArenaJob* pJob = static_cast<ArenaJob*>( pArg );
+
+        const U32 startMark = FrameAllocator::getWaterMark();
+
+        {
+            FrameAllocatorMarker frameMarker;
+
+            // Allocate well past the first block so the arena has to chain.
+            U8* pAllocations[FRAMEALLOCATOR_UNITTEST_ALLOCATIONS];
+            pJob->mAligned = true;
+            pJob->mContained = true;
+            for ( U32 index = 0; index < FRAMEALLOCATOR_UNITTEST_ALLOCATIONS; ++index )
+            {
+                pAllocations[index] = (U8*)frameMarker.alloc( FRAMEALLOCATOR_UNITTEST_SIZE, 16 );
+                dMemset( pAllocations[index], (U8)(index + pJob->mThreadIndex), FRAMEALLOCATOR_UNITTEST_SIZE );
+
+                if ( ((dsize_t)pAllocations[index] & 15) != 0 )
+                    pJob->mAligned = false;
+
+                if ( !FrameAllocator::contains( pAllocations[index] ) )
+                    pJob->mContained = false;
+            }
+            pJob->mpFirstAllocation = pAllocations[0];
+
+            // Check nothing was overwritten.
+            pJob->mContentsValid = true;
+            for ( U32 index = 0; index < FRAMEALLOCATOR_UNITTEST_ALLOCATIONS; ++index )
+            {
+                for ( U32 byte = 0; byte < FRAMEALLOCATOR_UNITTEST_SIZE; ++byte )
+                {
+                    if ( pAllocations[index][byte] != (U8)(index + pJob->mThreadIndex) )
+                        pJob->mContentsValid = false;
+                }
+            }
+        }
+
+        // Check the marker rewound across the blocks.
+        pJob->mRestored = FrameAllocator::getWaterMark() == startMark;
+
+        // Leave some memory allocated and end the frame.
+        FrameAllocator::alloc( FRAMEALLOCATOR_UNITTEST_SIZE );
+        FrameAllocator::endFrame();
+
+        // Check the blocks were merged so the same usage fits in the first block.
+        pJob->mMerged = FrameAllocator::getWaterMark() == 0 &&
+            FrameAllocator::getHighWaterMark() >= FRAMEALLOCATOR_UNITTEST_ALLOCATIONS * FRAMEALLOCATOR_UNITTEST_SIZE;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( FrameAllocatorTests, ThreadArenaTest )
+{
+    ArenaJob jobs[FRAMEALLOCATOR_UNITTEST_THREADS];
+    Thread* pThreads[FRAMEALLOCATOR_UNITTEST_THREADS];
+
+    // Run the jobs.
+    for ( U32 threadIndex = 0; threadIndex < FRAMEALLOCATOR_UNITTEST_THREADS; ++threadIndex )
+    {
+        jobs[threadIndex].mThreadIndex = threadIndex;
+        pThreads[threadIndex] = new Thread( arenaJob, &jobs[threadIndex], true );
+    }
+
+    for ( U32 threadIndex = 0; threadIndex < FRAMEALLOCATOR_UNITTEST_THREADS; ++threadIndex )
+    {
+        pThreads[threadIndex]->join();
+        delete pThreads[threadIndex];
+    }
+
+    // Check.
+    for ( U32 threadIndex = 0; threadIndex < FRAMEALLOCATOR_UNITTEST_THREADS; ++threadIndex )
+    {
+        const ArenaJob& job = jobs[threadIndex];
+        ASSERT_TRUE( job.mContentsValid ) << "Frame allocations overlapped.";
+        ASSERT_TRUE( job.mAligned ) << "Frame allocations were not aligned.";
+        ASSERT_TRUE( job.mContained ) << "Frame allocations were not in the thread arena.";
+        ASSERT_TRUE( job.mRestored ) << "Frame marker did not restore the water mark.";
+        ASSERT_TRUE( job.mMerged ) << "Frame blocks were not merged at the end of the frame.";
+
+        for ( U32 otherIndex = 0; otherIndex < threadIndex; ++otherIndex )
+        {
+            ASSERT_NE( job.mpFirstAllocation, jobs[otherIndex].mpFirstAllocation ) << "Threads shared an arena.";
+        }
+    }
+
+    // Check the memory of other threads isn't in this arena.
+    ASSERT_FALSE( FrameAllocator::contains( jobs[0].mpFirstAllocation ) ) << "Another thread's memory was found in this arena.";
+}
+
+#endif // TORQUE_SHIPPING
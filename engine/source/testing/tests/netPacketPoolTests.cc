@@ -0,0 +1,147 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _PLATFORM_PLATFORMNETPACKET_H_
+#include "platform/platformNetPacket.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    struct ProducerState
+    {
+        NetPacketPool*  mpPool;
+        U32             mPacketCount;
+    };
+
+    void producePackets( void* pArg )
+    {
+        ProducerState& state = *(ProducerState*)pArg;
+
+        for ( U32 i = 0; i < state.mPacketCount; i++ )
+        {
+            NetPacketBuffer* pBuffer;
+            while ( (pBuffer = state.mpPool->allocate()) == NULL )
+                Platform::sleep( 0 );
+
+            *(U32*)pBuffer->data = i;
+            pBuffer->size = sizeof(U32);
+            state.mpPool->post( pBuffer );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( NetPacketPoolTests, RingTest )
+{
+    NetPacketRing ring( 3 );
+    ASSERT_EQ( 4, (S32)ring.getCapacity() ) << "The capacity should be rounded up to a power of two.";
+
+    NetPacketBuffer buffers[5];
+    for ( U32 i = 0; i < 4; i++ )
+        ASSERT_TRUE( ring.push( &buffers[i] ) ) << "The ring should accept up to its capacity.";
+    ASSERT_FALSE( ring.push( &buffers[4] ) ) << "A full ring should refuse more.";
+
+    for ( U32 i = 0; i < 4; i++ )
+        ASSERT_EQ( &buffers[i], ring.pop() ) << "The ring should be first in first out.";
+    ASSERT_TRUE( ring.pop() == NULL ) << "An empty ring should return nothing.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( NetPacketPoolTests, ExhaustionTest )
+{
+    NetPacketPool pool( 2 );
+
+    NetPacketBuffer* pFirst = pool.allocate();
+    NetPacketBuffer* pSecond = pool.allocate();
+    ASSERT_TRUE( pFirst != NULL && pSecond != NULL && pFirst != pSecond ) << "Each buffer should be handed out once.";
+    ASSERT_TRUE( pool.allocate() == NULL ) << "An exhausted pool should not allocate.";
+    ASSERT_EQ( 1, (S32)pool.getExhaustedCount() ) << "Exhaustion should be counted.";
+
+    // A recycled buffer is immediately available.
+    pool.recycle( pSecond );
+    ASSERT_EQ( pSecond, pool.allocate() ) << "A recycled buffer should be reused.";
+
+    // A posted buffer comes back once every reference is released.
+    pool.post( pFirst );
+    NetPacketBuffer* pReceived = pool.receive();
+    ASSERT_EQ( pFirst, pReceived ) << "The posted buffer should be received.";
+    pool.addRef( pReceived );
+    pool.release( pReceived );
+    ASSERT_TRUE( pool.allocate() == NULL ) << "A referenced buffer should not be reused.";
+    pool.release( pReceived );
+    ASSERT_EQ( pFirst, pool.allocate() ) << "A released buffer should be reused.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( NetPacketPoolTests, ThreadedTest )
+{
+    NetPacketPool pool( 8 );
+
+    ProducerState state;
+    state.mpPool = &pool;
+    state.mPacketCount = 10000;
+
+    Thread* pProducer = new Thread( &producePackets, &state, true );
+
+    U32 received = 0;
+    bool ordered = true;
+    while ( received < state.mPacketCount )
+    {
+        NetPacketBuffer* pBuffer = pool.receive();
+        if ( pBuffer == NULL )
+        {
+            Platform::sleep( 0 );
+            continue;
+        }
+
+        if ( *(U32*)pBuffer->data != received )
+            ordered = false;
+
+        pool.release( pBuffer );
+        received++;
+    }
+
+    pProducer->join();
+    delete pProducer;
+
+    ASSERT_TRUE( ordered ) << "Packets should arrive in the order they were posted.";
+    ASSERT_LE( pool.getPeakInUse(), pool.getCapacity() ) << "The pool should never hand out more buffers than it has.";
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,214 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _NETREPLICATEDFIELDS_H_
+#include "network/netReplicatedFields.h"
+#endif
+
+#ifndef _BITSTREAM_H_
+#include "io/bitStream.h"
+#endif
+
+#ifndef _CONSOLETYPES_H_
+#include "console/consoleTypes.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    struct ReplicatedObject
+    {
+        Point2F mPosition;
+        F32     mAngle;
+        S32     mHealth;
+        bool    mActive;
+    };
+
+    void buildLayout( NetReplicatedLayout& layout )
+    {
+        layout.addPoint2F( "position", Offset(mPosition, ReplicatedObject), -100.0f, 100.0f, 16 );
+        layout.addAngle( "angle", Offset(mAngle, ReplicatedObject), 10 );
+        layout.addRangedS32( "health", Offset(mHealth, ReplicatedObject), 0, 100 );
+        layout.addBool( "active", Offset(mActive, ReplicatedObject) );
+    }
+
+    /// Write the current slots and read them back into the receiver's slots.
+    NetReplicatedPacket* send( const NetReplicatedLayout& layout, NetReplicatedState& state, const U32* pSlots, U32* pReceived, const bool lost, S32& bits )
+    {
+        U8 buffer[256];
+        BitStream stream( buffer, sizeof(buffer) );
+        NetReplicatedPacket* pPacket = state.write( layout, pSlots, &stream );
+        bits = stream.getCurPos();
+
+        if ( !lost )
+        {
+            BitStream readStream( buffer, sizeof(buffer) );
+            NetReplicatedState::read( layout, pReceived, &readStream );
+        }
+
+        return pPacket;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( NetReplicatedFieldsTests, QuantizeTest )
+{
+    NetReplicatedLayout layout;
+    buildLayout( layout );
+    ASSERT_EQ( 5, (S32)layout.getSlotCount() ) << "A point should use two slots.";
+
+    ReplicatedObject source;
+    source.mPosition.set( 12.5f, -37.25f );
+    source.mAngle = -0.5f;
+    source.mHealth = 250;
+    source.mActive = true;
+
+    U32 slots[NetReplicatedLayout::MaxSlots];
+    layout.quantize( &source, slots );
+
+    ReplicatedObject result;
+    dMemset( &result, 0, sizeof(result) );
+    layout.dequantize( slots, &result, 0xFFFFFFFF );
+
+    const F32 step = 200.0f / 65535.0f;
+    ASSERT_NEAR( source.mPosition.x, result.mPosition.x, step ) << "Position should survive quantization.";
+    ASSERT_NEAR( source.mPosition.y, result.mPosition.y, step ) << "Position should survive quantization.";
+    ASSERT_NEAR( M_2PI_F - 0.5f, result.mAngle, M_2PI_F / 1024.0f ) << "Angles should be wrapped into a turn.";
+    ASSERT_EQ( 100, result.mHealth ) << "Integers should be clamped to their range.";
+    ASSERT_TRUE( result.mActive ) << "Bools should survive quantization.";
+
+    // Only the masked fields are written.
+    ReplicatedObject partial;
+    dMemset( &partial, 0, sizeof(partial) );
+    layout.dequantize( slots, &partial, BIT(2) );
+    ASSERT_EQ( 0.0f, partial.mPosition.x ) << "Unmasked fields should not be written.";
+    ASSERT_NE( 0.0f, partial.mAngle ) << "Masked fields should be written.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( NetReplicatedFieldsTests, DeltaTest )
+{
+    NetReplicatedLayout layout;
+    buildLayout( layout );
+
+    U32 slots[NetReplicatedLayout::MaxSlots];
+    U32 received[NetReplicatedLayout::MaxSlots];
+    dMemset( received, 0, sizeof(received) );
+
+    ReplicatedObject object;
+    object.mPosition.set( 0.0f, 0.0f );
+    object.mAngle = 0.0f;
+    object.mHealth = 100;
+    object.mActive = true;
+    layout.quantize( &object, slots );
+
+    NetReplicatedState state;
+    S32 fullBits;
+    NetReplicatedPacket* pPacket = send( layout, state, slots, received, false, fullBits );
+    ASSERT_TRUE( pPacket != NULL ) << "The first write should send everything.";
+    state.packetReceived( pPacket );
+    delete pPacket;
+
+    // Nothing changed so only the flag is sent.
+    S32 bits;
+    pPacket = send( layout, state, slots, received, false, bits );
+    ASSERT_TRUE( pPacket == NULL ) << "Unchanged fields should not be sent.";
+    ASSERT_EQ( 1, bits ) << "Unchanged fields should cost one bit.";
+
+    // A small move is sent as a delta, including across the angle wrap.
+    object.mPosition.x += 0.01f;
+    object.mAngle = M_2PI_F - 0.01f;
+    layout.quantize( &object, slots );
+    S32 deltaBits;
+    pPacket = send( layout, state, slots, received, false, deltaBits );
+    ASSERT_TRUE( pPacket != NULL ) << "Changed fields should be sent.";
+    ASSERT_LT( deltaBits, fullBits ) << "Small changes should be sent as deltas.";
+    ASSERT_EQ( 0, dMemcmp( slots, received, layout.getSlotCount() * sizeof(U32) ) ) << "The receiver should apply the deltas.";
+    state.packetReceived( pPacket );
+    delete pPacket;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( NetReplicatedFieldsTests, LossTest )
+{
+    NetReplicatedLayout layout;
+    buildLayout( layout );
+
+    U32 slots[NetReplicatedLayout::MaxSlots];
+    U32 received[NetReplicatedLayout::MaxSlots];
+    dMemset( received, 0, sizeof(received) );
+
+    ReplicatedObject object;
+    object.mPosition.set( 10.0f, 10.0f );
+    object.mAngle = 1.0f;
+    object.mHealth = 50;
+    object.mActive = false;
+    layout.quantize( &object, slots );
+
+    NetReplicatedState state;
+    S32 bits;
+    NetReplicatedPacket* pFirst = send( layout, state, slots, received, false, bits );
+    state.packetReceived( pFirst );
+    delete pFirst;
+
+    // Send two changes, the first of which is lost and reported after the second was sent.
+    object.mPosition.x += 0.5f;
+    layout.quantize( &object, slots );
+    NetReplicatedPacket* pLost = send( layout, state, slots, received, true, bits );
+
+    object.mHealth = 40;
+    layout.quantize( &object, slots );
+    NetReplicatedPacket* pDelivered = send( layout, state, slots, received, false, bits );
+
+    ASSERT_TRUE( state.packetDropped( pLost, slots ) ) << "A lost change should be sent again.";
+    state.packetReceived( pDelivered );
+    delete pLost;
+    delete pDelivered;
+
+    NetReplicatedPacket* pResent = send( layout, state, slots, received, false, bits );
+    ASSERT_TRUE( pResent != NULL ) << "The lost change should be resent.";
+    ASSERT_EQ( 0, dMemcmp( slots, received, layout.getSlotCount() * sizeof(U32) ) ) << "The receiver should catch up after a loss.";
+    state.packetReceived( pResent );
+    delete pResent;
+
+    // Forgetting the receiver's state sends everything again.
+    state.reset();
+    dMemset( received, 0, sizeof(received) );
+    NetReplicatedPacket* pReset = send( layout, state, slots, received, false, bits );
+    ASSERT_TRUE( pReset != NULL ) << "A reset should send everything.";
+    ASSERT_EQ( 0, dMemcmp( slots, received, layout.getSlotCount() * sizeof(U32) ) ) << "The receiver should match after a reset.";
+    delete pReset;
+}
+
+#endif // TORQUE_SHIPPING
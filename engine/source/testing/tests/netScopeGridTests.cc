@@ -0,0 +1,134 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _NETSCOPEGRID_H_
+#include "network/netScopeGrid.h"
+#endif
+
+#ifndef _NETOBJECT_H_
+#include "network/netObject.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    class GhostableObject : public NetObject
+    {
+    public:
+        GhostableObject() { mNetFlags.set( Ghostable ); }
+    };
+
+    void getRegion( const F32 x, const F32 y, const F32 distance, NetScopeGrid::Region& region )
+    {
+        CameraScopeQuery camInfo;
+        camInfo.camera = NULL;
+        camInfo.pos.set( x, y, 0.0f );
+        camInfo.visibleDistance = distance;
+        camInfo.scopeArea = true;
+        NetScopeGrid::getRegion( &camInfo, region );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( NetScopeGridTests, RegionChangeTest )
+{
+    const F32 cellSize = NetScopeGrid::smCellSize;
+
+    GhostableObject* pObject = new GhostableObject();
+    pObject->setScopePosition( Point2F( cellSize * 0.25f, cellSize * 0.25f ) );
+    pObject->registerObject();
+
+    NetScopeGrid::Region region;
+    getRegion( 0.0f, 0.0f, cellSize * 0.1f, region );
+
+    // Moving within a cell doesn't change the region.
+    pObject->setScopePosition( Point2F( cellSize * 0.75f, cellSize * 0.75f ) );
+    NetScopeGrid::Region sameRegion;
+    getRegion( 0.0f, 0.0f, cellSize * 0.1f, sameRegion );
+    ASSERT_TRUE( region == sameRegion ) << "Moving within a cell should not change scope.";
+
+    // Leaving the cell does.
+    pObject->setScopePosition( Point2F( cellSize * 100.5f, cellSize * 0.5f ) );
+    NetScopeGrid::Region changedRegion;
+    getRegion( 0.0f, 0.0f, cellSize * 0.1f, changedRegion );
+    ASSERT_TRUE( region != changedRegion ) << "Leaving a cell should change scope.";
+
+    // Changes far away don't affect the region.
+    pObject->setScopePosition( Point2F( cellSize * 200.5f, cellSize * 0.5f ) );
+    NetScopeGrid::Region farRegion;
+    getRegion( 0.0f, 0.0f, cellSize * 0.1f, farRegion );
+    ASSERT_TRUE( changedRegion == farRegion ) << "Changes outside the region should not change scope.";
+
+    // Moving the area does.
+    NetScopeGrid::Region movedRegion;
+    getRegion( cellSize * 50.5f, 0.0f, cellSize * 0.1f, movedRegion );
+    ASSERT_TRUE( farRegion != movedRegion ) << "Moving the scope area should change scope.";
+
+    pObject->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( NetScopeGridTests, DistantCellTest )
+{
+    const F32 cellSize = NetScopeGrid::smCellSize;
+
+    GhostableObject* pObject = new GhostableObject();
+    pObject->setScopePosition( Point2F( cellSize * 0.5f, cellSize * 0.5f ) );
+    pObject->registerObject();
+
+    NetScopeGrid::Region region;
+    getRegion( cellSize * 0.5f, cellSize * 0.5f, cellSize * 0.1f, region );
+
+    // A cell whose coordinates only differ above 16 bits is a different cell.
+    pObject->setScopePosition( Point2F( cellSize * 65536.5f, cellSize * 65536.5f ) );
+    NetScopeGrid::Region movedRegion;
+    getRegion( cellSize * 0.5f, cellSize * 0.5f, cellSize * 0.1f, movedRegion );
+    ASSERT_TRUE( region != movedRegion ) << "Leaving a cell should change scope.";
+
+    pObject->setScopePosition( Point2F( cellSize * 65536.5f, cellSize * 0.5f ) );
+    NetScopeGrid::Region distantRegion;
+    getRegion( cellSize * 0.5f, cellSize * 0.5f, cellSize * 0.1f, distantRegion );
+    pObject->setScopePosition( Point2F( cellSize * 131072.5f, cellSize * 0.5f ) );
+    NetScopeGrid::Region fartherRegion;
+    getRegion( cellSize * 0.5f, cellSize * 0.5f, cellSize * 0.1f, fartherRegion );
+    ASSERT_TRUE( distantRegion == fartherRegion ) << "Changes in distant cells should not change scope.";
+
+    // A huge scope distance covers everything.
+    NetScopeGrid::Region hugeRegion;
+    getRegion( 0.0f, 0.0f, 1.0e30f, hugeRegion );
+    ASSERT_TRUE( hugeRegion.mMinX < 0 && hugeRegion.mMaxX > 131072 ) << "A huge scope distance should cover every cell.";
+
+    pObject->deleteObject();
+}
+
+#endif // TORQUE_SHIPPING
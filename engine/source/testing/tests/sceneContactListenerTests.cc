@@ -0,0 +1,129 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SCENE_H_
+#include "2d/scene/Scene.h"
+#endif
+
+#ifndef _SCENE_OBJECT_H_
+#include "2d/sceneobject/SceneObject.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    /// Deletes an object when it first sees its contacts end.
+    class DeletingContactListener : public SceneContactListener
+    {
+    public:
+        DeletingContactListener( SceneObject* pDeleteObject ) :
+            mpDeleteObject( pDeleteObject ),
+            mEndContactCount( 0 ),
+            mDeadContactCount( 0 )
+        {
+        }
+
+        virtual void onSceneEndContacts( Scene* pScene, const TickContact* pContacts, const U32 contactCount )
+        {
+            mEndContactCount += contactCount;
+            countDead( pContacts, contactCount );
+
+            if ( contactCount > 0 && mpDeleteObject != NULL )
+            {
+                mpDeleteObject->deleteObject();
+                mpDeleteObject = NULL;
+            }
+        }
+
+        virtual void onSceneBeginContacts( Scene* pScene, const TickContact* pContacts, const U32 contactCount )
+        {
+            countDead( pContacts, contactCount );
+        }
+
+        void countDead( const TickContact* pContacts, const U32 contactCount )
+        {
+            for ( U32 index = 0; index < contactCount; ++index )
+            {
+                if ( pContacts[index].isDead() )
+                    mDeadContactCount++;
+            }
+        }
+
+        SceneObject*    mpDeleteObject;
+        U32             mEndContactCount;
+        U32             mDeadContactCount;
+    };
+
+    SceneObject* createBox( Scene* pScene, const Vector2& position )
+    {
+        SceneObject* pSceneObject = new SceneObject();
+        pSceneObject->registerObject();
+        pSceneObject->setSceneGroup( 1 );
+        pSceneObject->setPosition( position );
+        pSceneObject->createPolygonBoxCollisionShape( 1.0f, 1.0f );
+        pScene->addToScene( pSceneObject );
+        return pSceneObject;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneContactListenerTests, DeleteInEndContactsTest )
+{
+    Scene* pScene = new Scene();
+    pScene->registerObject();
+
+    // Overlap two objects so they begin touching.
+    SceneObject* pObjectA = createBox( pScene, Vector2( 0.0f, 0.0f ) );
+    SceneObject* pObjectB = createBox( pScene, Vector2( 0.5f, 0.0f ) );
+    pScene->processTick();
+
+    // Only listen to the objects' scene group so the contacts are filtered.
+    DeletingContactListener listener( pObjectB );
+    pScene->addContactListener( &listener, pObjectB->getSceneGroupMask() );
+
+    // Move the second object onto a new one so it ends one contact and begins another in the same tick.
+    // The listener deletes it while handling the end contact which kills the begin contact.
+    SceneObject* pObjectC = createBox( pScene, Vector2( 100.0f, 0.0f ) );
+    pObjectB->setPosition( Vector2( 100.5f, 0.0f ) );
+    pScene->processTick();
+
+    ASSERT_NE( 0, listener.mEndContactCount ) << "The end contact was not reported.";
+    ASSERT_TRUE( listener.mpDeleteObject == NULL ) << "The object was not deleted.";
+    ASSERT_EQ( 0, listener.mDeadContactCount ) << "Killed contacts were passed to the listener.";
+
+    pScene->removeContactListener( &listener );
+    pObjectA->deleteObject();
+    pObjectC->deleteObject();
+    pScene->deleteObject();
+}
+
+#endif // TORQUE_SHIPPING
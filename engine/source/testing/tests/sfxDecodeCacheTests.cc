@@ -0,0 +1,211 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SFXDECODECACHE_H_
+#include "sfx/sfxDecodeCache.h"
+#endif
+
+#ifndef _SFXSTREAMTHREAD_H_
+#include "sfx/sfxStreamThread.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SFXDECODECACHE_UNITTEST_CLIP_BYTES      400
+#define SFXDECODECACHE_UNITTEST_BUDGET_BYTES    1000
+#define SFXSTREAMQUEUE_UNITTEST_CHUNKS          1000
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    /// Synthetic PCM so no sound files or OpenAL device are needed.
+    SFXDecodeCache::Clip* insertClip( const char* pFilename, const U32 size )
+    {
+        U8* pData = new U8[size];
+        dMemset( pData, 0, size );
+        return SFXDecodeCache::insert( StringTable->insert( pFilename ), AL_FORMAT_MONO16, 22050, pData, size );
+    }
+
+    /// Use a private budget for the duration of a test.
+    class CacheScope
+    {
+    public:
+        CacheScope() : mCreated( !SFXDecodeCache::isCreated() ), mMaxBytes( SFXDecodeCache::smMaxBytes )
+        {
+            if ( mCreated )
+                SFXDecodeCache::create();
+
+            SFXDecodeCache::flush();
+            SFXDecodeCache::resetMetrics();
+            SFXDecodeCache::smMaxBytes = SFXDECODECACHE_UNITTEST_BUDGET_BYTES;
+        }
+
+        ~CacheScope()
+        {
+            SFXDecodeCache::flush();
+            SFXDecodeCache::smMaxBytes = mMaxBytes;
+
+            if ( mCreated )
+                SFXDecodeCache::destroy();
+        }
+
+    private:
+        bool    mCreated;
+        S32     mMaxBytes;
+    };
+
+    struct QueueProducer
+    {
+        SFXStreamQueue* mpQueue;
+        U32             mChunkCount;
+    };
+
+    void produceChunks( void* pArg )
+    {
+        QueueProducer* pProducer = (QueueProducer*)pArg;
+
+        U32 written = 0;
+        while ( written < pProducer->mChunkCount )
+        {
+            SFXStreamQueue::Chunk* pChunk = pProducer->mpQueue->beginWrite();
+            if ( pChunk == NULL )
+            {
+                Platform::sleep( 0 );
+                continue;
+            }
+
+            pChunk->mSize = written;
+            pChunk->mData[0] = (U8)written;
+            pChunk->mData[SFXStreamQueue::ChunkSize-1] = (U8)written;
+            pProducer->mpQueue->endWrite();
+            written++;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SFXDecodeCacheTests, LeastRecentlyUsedEvictionTest )
+{
+    CacheScope scope;
+
+    SFXDecodeCache::release( insertClip( "^test/a.wav", SFXDECODECACHE_UNITTEST_CLIP_BYTES ) );
+    SFXDecodeCache::release( insertClip( "^test/b.wav", SFXDECODECACHE_UNITTEST_CLIP_BYTES ) );
+    ASSERT_EQ( 2, (S32)SFXDecodeCache::getClipCount() );
+    ASSERT_EQ( 2 * SFXDECODECACHE_UNITTEST_CLIP_BYTES, (S32)SFXDecodeCache::getBytes() );
+
+    // Use "a" so "b" is the least recently used.
+    SFXDecodeCache::Clip* pClip = SFXDecodeCache::acquire( StringTable->insert( "^test/a.wav" ) );
+    ASSERT_TRUE( pClip != NULL );
+    ASSERT_EQ( SFXDECODECACHE_UNITTEST_CLIP_BYTES, (S32)pClip->getSize() );
+    SFXDecodeCache::release( pClip );
+    ASSERT_EQ( 1, (S32)SFXDecodeCache::getHits() );
+
+    // Going over budget evicts "b".
+    SFXDecodeCache::release( insertClip( "^test/c.wav", SFXDECODECACHE_UNITTEST_CLIP_BYTES ) );
+    ASSERT_TRUE( SFXDecodeCache::isCached( StringTable->insert( "^test/a.wav" ) ) );
+    ASSERT_FALSE( SFXDecodeCache::isCached( StringTable->insert( "^test/b.wav" ) ) );
+    ASSERT_TRUE( SFXDecodeCache::isCached( StringTable->insert( "^test/c.wav" ) ) );
+    ASSERT_EQ( 1, (S32)SFXDecodeCache::getEvictions() );
+    ASSERT_EQ( 2 * SFXDECODECACHE_UNITTEST_CLIP_BYTES, (S32)SFXDecodeCache::getBytes() );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SFXDecodeCacheTests, ReferencedClipTest )
+{
+    CacheScope scope;
+
+    // Referenced clips survive going over budget.
+    SFXDecodeCache::Clip* pHeld = insertClip( "^test/a.wav", SFXDECODECACHE_UNITTEST_CLIP_BYTES );
+    SFXDecodeCache::release( insertClip( "^test/b.wav", SFXDECODECACHE_UNITTEST_CLIP_BYTES ) );
+    SFXDecodeCache::release( insertClip( "^test/c.wav", SFXDECODECACHE_UNITTEST_CLIP_BYTES ) );
+    ASSERT_TRUE( SFXDecodeCache::isCached( StringTable->insert( "^test/a.wav" ) ) );
+    ASSERT_FALSE( SFXDecodeCache::isCached( StringTable->insert( "^test/b.wav" ) ) );
+    SFXDecodeCache::release( pHeld );
+
+    // Clips bigger than the budget are handed out but not cached.
+    SFXDecodeCache::Clip* pLarge = insertClip( "^test/large.wav", SFXDECODECACHE_UNITTEST_BUDGET_BYTES + 1 );
+    ASSERT_TRUE( pLarge != NULL );
+    ASSERT_FALSE( pLarge->isCached() );
+    ASSERT_FALSE( SFXDecodeCache::isCached( StringTable->insert( "^test/large.wav" ) ) );
+    SFXDecodeCache::release( pLarge );
+
+    // Flushing orphans referenced clips until they are released.
+    pHeld = SFXDecodeCache::acquire( StringTable->insert( "^test/a.wav" ) );
+    ASSERT_TRUE( pHeld != NULL );
+    SFXDecodeCache::flush();
+    ASSERT_FALSE( pHeld->isCached() );
+    ASSERT_EQ( 0, (S32)SFXDecodeCache::getClipCount() );
+    ASSERT_EQ( 0, (S32)SFXDecodeCache::getBytes() );
+    SFXDecodeCache::release( pHeld );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SFXDecodeCacheTests, StreamQueueTest )
+{
+    SFXStreamQueue* pQueue = new SFXStreamQueue();
+    ASSERT_TRUE( pQueue->isEmpty() );
+
+    QueueProducer producer;
+    producer.mpQueue = pQueue;
+    producer.mChunkCount = SFXSTREAMQUEUE_UNITTEST_CHUNKS;
+
+    Thread* pThread = new Thread( &produceChunks, &producer, true );
+
+    // Chunks must arrive complete and in order.
+    U32 read = 0;
+    while ( read < SFXSTREAMQUEUE_UNITTEST_CHUNKS )
+    {
+        const SFXStreamQueue::Chunk* pChunk = pQueue->beginRead();
+        if ( pChunk == NULL )
+        {
+            Platform::sleep( 0 );
+            continue;
+        }
+
+        ASSERT_EQ( read, pChunk->mSize );
+        ASSERT_EQ( (U8)read, pChunk->mData[0] );
+        ASSERT_EQ( (U8)read, pChunk->mData[SFXStreamQueue::ChunkSize-1] );
+        pQueue->endRead();
+        read++;
+    }
+
+    pThread->join();
+    delete pThread;
+
+    ASSERT_TRUE( pQueue->isEmpty() );
+    delete pQueue;
+}
+
+#endif // TORQUE_SHIPPING
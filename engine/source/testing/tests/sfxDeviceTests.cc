@@ -0,0 +1,63 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SFXDEVICE_H_
+#include "sfx/sfxDevice.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+TEST( SFXDeviceTests, VoiceAudibilityTest )
+{
+    SFXDevice::DefDescription description;
+    dMemset( &description, 0, sizeof(description) );
+    description.mVolume = 0.5f;
+    description.mIs3D = true;
+    description.mReferenceDistance = 2.0f;
+    description.mMaxDistance = 10.0f;
+
+    const Point3F listener( 1.0f, 1.0f, 0.0f );
+
+    // Full volume inside the reference distance.
+    ASSERT_FLOAT_EQ( 0.5f, SFXDevice::getAudibility( description, Point3F( 2.0f, 1.0f, 0.0f ), listener ) );
+
+    // Inverse distance past it.
+    ASSERT_FLOAT_EQ( 0.25f, SFXDevice::getAudibility( description, Point3F( 5.0f, 1.0f, 0.0f ), listener ) );
+
+    // Inaudible past the max distance.
+    ASSERT_FLOAT_EQ( 0.0f, SFXDevice::getAudibility( description, Point3F( 11.0f, 1.0f, 0.0f ), listener ) );
+
+    // Distance doesn't matter for 2D sounds.
+    description.mIs3D = false;
+    ASSERT_FLOAT_EQ( 0.5f, SFXDevice::getAudibility( description, Point3F( 100.0f, 1.0f, 0.0f ), listener ) );
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,350 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SIMSET_UNITTEST_OBJECTS                 16
+#define SIMSET_UNITTEST_BENCHMARK_OBJECTS       100000
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    SimObject* createObject( void )
+    {
+        SimObject* pObject = new SimObject();
+        pObject->registerObject();
+        return pObject;
+    }
+
+    template<class T> T* createSet( void )
+    {
+        T* pSet = new T();
+        pSet->registerObject();
+        return pSet;
+    }
+
+    bool isMember( SimSet* pSet, SimObject* pObject )
+    {
+        for ( SimSet::iterator itr = pSet->begin(); itr != pSet->end(); ++itr )
+        {
+            if ( *itr == pObject )
+                return true;
+        }
+
+        return false;
+    }
+
+    struct RemoveLog
+    {
+        Vector<SimObjectId> mOrder;
+        Vector<bool>        mWasMember;
+    };
+
+    /// Logs the order objects are removed in and whether they were still in the set at the time.
+    class RemoveLogObject : public SimObject
+    {
+    public:
+        RemoveLogObject( SimSet* pSet, RemoveLog* pLog ) :
+            mpDeleteOnRemove( NULL ),
+            mpSet( pSet ),
+            mpLog( pLog )
+        {
+        }
+
+        virtual void onRemove( void )
+        {
+            mpLog->mOrder.push_back( getId() );
+            mpLog->mWasMember.push_back( isMember( mpSet, this ) );
+
+            // Optionally delete another object while being removed.
+            if ( mpDeleteOnRemove != NULL )
+                mpDeleteOnRemove->deleteObject();
+
+            SimObject::onRemove();
+        }
+
+        SimObject*  mpDeleteOnRemove;
+
+    private:
+        SimSet*     mpSet;
+        RemoveLog*  mpLog;
+    };
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimSetTests, RemoveObjectsTest )
+{
+    SimSet* pSet = createSet<SimSet>();
+
+    // Add objects.
+    SimObjectList objects;
+    for ( U32 index = 0; index < SIMSET_UNITTEST_OBJECTS; ++index )
+    {
+        SimObject* pObject = createObject();
+        objects.push_back( pObject );
+        pSet->addObject( pObject );
+
+        // Adding again should be ignored.
+        pSet->addObject( pObject );
+    }
+    ASSERT_EQ( SIMSET_UNITTEST_OBJECTS, pSet->size() ) << "Objects were added more than once.";
+
+    // Remove every other object.
+    SimObjectList removed;
+    for ( U32 index = 0; index < SIMSET_UNITTEST_OBJECTS; index += 2 )
+        removed.push_back( objects[index] );
+    pSet->removeObjects( removed );
+
+    // Check the remaining objects are in order.
+    ASSERT_EQ( SIMSET_UNITTEST_OBJECTS / 2, pSet->size() ) << "Incorrect number of objects removed.";
+    for ( U32 index = 0; index < (U32)pSet->size(); ++index )
+    {
+        ASSERT_EQ( objects[index * 2 + 1], pSet->at( index ) ) << "Object order was not preserved.";
+    }
+
+    // Deleting a removed object should not affect the set.
+    const SimObjectId removedId = removed[0]->getId();
+    removed[0]->deleteObject();
+    ASSERT_EQ( SIMSET_UNITTEST_OBJECTS / 2, pSet->size() ) << "Deleting a removed object changed the set.";
+    ASSERT_TRUE( Sim::findObject( removedId ) == NULL ) << "Removed object was not deleted.";
+
+    // Deleting a member should remove it.
+    pSet->at( 0 )->deleteObject();
+    ASSERT_EQ( SIMSET_UNITTEST_OBJECTS / 2 - 1, pSet->size() ) << "Deleting a member did not remove it.";
+    ASSERT_EQ( objects[3], pSet->at( 0 ) ) << "Object order was not preserved.";
+
+    // Delete the remaining objects.
+    for ( U32 index = 1; index < (U32)removed.size(); ++index )
+        removed[index]->deleteObject();
+    pSet->deleteObjects();
+    ASSERT_EQ( 0, pSet->size() ) << "Objects remain after deletion.";
+
+    pSet->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimSetTests, RemoveNonMembersTest )
+{
+    SimSet* pSet = createSet<SimSet>();
+    SimSet* pOtherSet = createSet<SimSet>();
+
+    // Add an object to both sets and another object to the other set only.
+    SimObject* pShared = createObject();
+    SimObject* pOther = createObject();
+    pSet->addObject( pShared );
+    pOtherSet->addObject( pShared );
+    pOtherSet->addObject( pOther );
+
+    // Removing a non-member from the set should leave everything alone.
+    SimObjectList objects;
+    objects.push_back( pOther );
+    pSet->removeObjects( objects );
+    ASSERT_EQ( 1, pSet->size() ) << "Removing a non-member changed the set.";
+    ASSERT_EQ( 2, pOtherSet->size() ) << "Removing a non-member changed another set.";
+
+    // Deleting the object is still seen by the set it is in.
+    pOther->deleteObject();
+    ASSERT_EQ( 1, pOtherSet->size() ) << "Deleted object was not removed from its set.";
+
+    pShared->deleteObject();
+    ASSERT_EQ( 0, pSet->size() ) << "Deleted object was not removed from the set.";
+    ASSERT_EQ( 0, pOtherSet->size() ) << "Deleted object was not removed from the other set.";
+
+    pSet->deleteObject();
+    pOtherSet->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimSetTests, DeleteObjectsOrderTest )
+{
+    SimSet* pSet = createSet<SimSet>();
+
+    // Add objects.
+    RemoveLog removeLog;
+    Vector<SimObjectId> objectIds;
+    for ( U32 index = 0; index < SIMSET_UNITTEST_OBJECTS; ++index )
+    {
+        RemoveLogObject* pObject = new RemoveLogObject( pSet, &removeLog );
+        pObject->registerObject();
+        pSet->addObject( pObject );
+        objectIds.push_back( pObject->getId() );
+    }
+
+    // Check the objects are deleted front to back while they are still members.
+    pSet->deleteObjects();
+    ASSERT_EQ( 0, pSet->size() ) << "Objects remain after deletion.";
+    ASSERT_EQ( objectIds.size(), removeLog.mOrder.size() ) << "Incorrect number of objects deleted.";
+    for ( U32 index = 0; index < (U32)objectIds.size(); ++index )
+    {
+        ASSERT_EQ( objectIds[index], removeLog.mOrder[index] ) << "Objects were not deleted front to back.";
+        ASSERT_TRUE( removeLog.mWasMember[index] ) << "Object was removed from the set before it was deleted.";
+    }
+
+    pSet->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimSetTests, DeleteObjectsRemovalTest )
+{
+    SimGroup* pGroup = createSet<SimGroup>();
+
+    // Add objects.
+    RemoveLog removeLog;
+    Vector<RemoveLogObject*> objects;
+    for ( U32 index = 0; index < SIMSET_UNITTEST_OBJECTS; ++index )
+    {
+        RemoveLogObject* pObject = new RemoveLogObject( pGroup, &removeLog );
+        pObject->registerObject();
+        pGroup->addObject( pObject );
+        objects.push_back( pObject );
+    }
+
+    // The first object deletes the last one while it is being deleted.
+    const SimObjectId firstId = objects.first()->getId();
+    const SimObjectId lastId = objects.last()->getId();
+    objects.first()->mpDeleteOnRemove = objects.last();
+
+    // Check every object is deleted once and the removal out of order is seen.
+    pGroup->deleteObjects();
+    ASSERT_EQ( 0, pGroup->size() ) << "Objects remain after deletion.";
+    ASSERT_EQ( SIMSET_UNITTEST_OBJECTS, removeLog.mOrder.size() ) << "Incorrect number of objects deleted.";
+    ASSERT_EQ( firstId, removeLog.mOrder[0] ) << "The first object was not deleted first.";
+    ASSERT_EQ( lastId, removeLog.mOrder[1] ) << "The last object was not deleted by the first.";
+    for ( U32 index = 0; index < (U32)removeLog.mWasMember.size(); ++index )
+    {
+        ASSERT_TRUE( removeLog.mWasMember[index] ) << "Object was removed from the group before it was deleted.";
+    }
+
+    pGroup->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimSetTests, GroupRemoveObjectsTest )
+{
+    SimGroup* pGroup = createSet<SimGroup>();
+
+    // Add objects.
+    SimObjectList objects;
+    for ( U32 index = 0; index < SIMSET_UNITTEST_OBJECTS; ++index )
+    {
+        SimObject* pObject = createObject();
+        objects.push_back( pObject );
+        pGroup->addObject( pObject );
+    }
+
+    // Remove the first half.
+    SimObjectList removed;
+    for ( U32 index = 0; index < SIMSET_UNITTEST_OBJECTS / 2; ++index )
+        removed.push_back( objects[index] );
+    pGroup->removeObjects( removed );
+
+    // Check.
+    ASSERT_EQ( SIMSET_UNITTEST_OBJECTS / 2, pGroup->size() ) << "Incorrect number of objects removed.";
+    for ( U32 index = 0; index < (U32)removed.size(); ++index )
+    {
+        ASSERT_TRUE( removed[index]->getGroup() == NULL ) << "Removed object still has a group.";
+        removed[index]->deleteObject();
+    }
+    for ( U32 index = 0; index < (U32)pGroup->size(); ++index )
+    {
+        ASSERT_EQ( objects[SIMSET_UNITTEST_OBJECTS / 2 + index], pGroup->at( index ) ) << "Object order was not preserved.";
+    }
+
+    // Deleting the group deletes the remaining objects.
+    const SimObjectId lastId = objects.last()->getId();
+    pGroup->deleteObject();
+    ASSERT_TRUE( Sim::findObject( lastId ) == NULL ) << "Group did not delete its objects.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimSetTests, DeleteBenchmarkTest )
+{
+    SimSet* pSet = createSet<SimSet>();
+    SimGroup* pGroup = createSet<SimGroup>();
+
+    // Create objects in both a set and a group.
+    SimObjectList objects;
+    U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 index = 0; index < SIMSET_UNITTEST_BENCHMARK_OBJECTS; ++index )
+    {
+        SimObject* pObject = createObject();
+        pGroup->addObject( pObject );
+        pSet->addObject( pObject );
+        objects.push_back( pObject );
+    }
+    const U32 addTime = Platform::getRealMilliseconds() - startTime;
+
+    // Remove all the objects from the set together.
+    startTime = Platform::getRealMilliseconds();
+    pSet->removeObjects( objects );
+    const U32 removeTime = Platform::getRealMilliseconds() - startTime;
+    ASSERT_EQ( 0, pSet->size() ) << "Objects remain in the set.";
+
+    // Delete all the objects through the set.
+    // Each object is also removed from the group.
+    for ( U32 index = 0; index < (U32)objects.size(); ++index )
+        pSet->addObject( objects[index] );
+    startTime = Platform::getRealMilliseconds();
+    pSet->deleteObjects();
+    const U32 setDeleteTime = Platform::getRealMilliseconds() - startTime;
+    ASSERT_EQ( 0, pSet->size() ) << "Objects remain in the set.";
+    ASSERT_EQ( 0, pGroup->size() ) << "Objects remain in the group.";
+
+    // Delete all the objects through the group.
+    for ( U32 index = 0; index < SIMSET_UNITTEST_BENCHMARK_OBJECTS; ++index )
+        pGroup->addObject( createObject() );
+    startTime = Platform::getRealMilliseconds();
+    pGroup->deleteObjects();
+    const U32 groupDeleteTime = Platform::getRealMilliseconds() - startTime;
+    ASSERT_EQ( 0, pGroup->size() ) << "Objects remain in the group.";
+
+    Con::printf( "SimSet of %d objects: add %dms, remove %dms, delete %dms.  SimGroup delete %dms.",
+        SIMSET_UNITTEST_BENCHMARK_OBJECTS, addTime, removeTime, setDeleteTime, groupDeleteTime );
+
+    pGroup->deleteObject();
+    pSet->deleteObject();
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,191 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _STRINGTABLE_H_
+#include "string/stringTable.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define STRINGTABLE_UNITTEST_THREADS            4
+#define STRINGTABLE_UNITTEST_STRINGS            8192
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    struct InsertJob
+    {
+        U32                 mThreadIndex;
+        bool                mShared;
+        StringTableEntry    mEntries[STRINGTABLE_UNITTEST_STRINGS];
+    };
+
+    void formatTestString( char* pBuffer, const U32 bufferSize, const U32 threadIndex, const U32 stringIndex, const bool shared )
+    {
+        if ( shared )
+            dSprintf( pBuffer, bufferSize, "StringTableTest_Shared_%d", stringIndex );
+        else
+            dSprintf( pBuffer, bufferSize, "StringTableTest_Thread%d_%d", threadIndex, stringIndex );
+    }
+
+    void insertJob( void* pArg )
+    {
+        InsertJob* pJob = static_cast<InsertJob*>( pArg );
+
+        char buffer[64];
+        for ( U32 index = 0; index < STRINGTABLE_UNITTEST_STRINGS; ++index )
+        {
+            // Each thread walks the strings from a different starting point.
+            const U32 stringIndex = (index + pJob->mThreadIndex * (STRINGTABLE_UNITTEST_STRINGS / STRINGTABLE_UNITTEST_THREADS)) % STRINGTABLE_UNITTEST_STRINGS;
+            formatTestString( buffer, sizeof(buffer), pJob->mThreadIndex, stringIndex, pJob->mShared );
+            pJob->mEntries[stringIndex] = StringTable->insert( buffer, true );
+        }
+    }
+
+    U32 runInsertJobs( InsertJob* pJobs, const bool shared )
+    {
+        Thread* pThreads[STRINGTABLE_UNITTEST_THREADS];
+
+        const U32 startTime = Platform::getRealMilliseconds();
+
+        for ( U32 threadIndex = 0; threadIndex < STRINGTABLE_UNITTEST_THREADS; ++threadIndex )
+        {
+            pJobs[threadIndex].mThreadIndex = threadIndex;
+            pJobs[threadIndex].mShared = shared;
+            pThreads[threadIndex] = new Thread( &insertJob, &pJobs[threadIndex], true );
+        }
+
+        for ( U32 threadIndex = 0; threadIndex < STRINGTABLE_UNITTEST_THREADS; ++threadIndex )
+        {
+            pThreads[threadIndex]->join();
+            delete pThreads[threadIndex];
+        }
+
+        return Platform::getRealMilliseconds() - startTime;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( StringTableTests, InsertTest )
+{
+    // Insert.
+    StringTableEntry entry = StringTable->insert( "StringTableTest_Insert" );
+
+    // Check.
+    ASSERT_STREQ( "StringTableTest_Insert", entry ) << "Inserted string is incorrect.";
+    ASSERT_EQ( entry, StringTable->insert( "StringTableTest_Insert" ) ) << "Inserting again returned a different entry.";
+    ASSERT_EQ( entry, StringTable->insert( "STRINGTABLETEST_INSERT" ) ) << "Case insensitive insert did not find the first entry.";
+    ASSERT_EQ( entry, StringTable->insertn( "StringTableTest_InsertXXXX", 22 ) ) << "Inserting with a length returned a different entry.";
+    ASSERT_EQ( entry, StringTable->lookup( "stringtabletest_insert" ) ) << "Lookup did not find the entry.";
+    ASSERT_EQ( entry, StringTable->lookupn( "StringTableTest_InsertXXXX", 22 ) ) << "Lookup with a length did not find the entry.";
+    ASSERT_EQ( StringTable->EmptyString, StringTable->insert( NULL ) ) << "Inserting NULL did not return the empty string.";
+
+    // Insert a case sensitive variant.
+    StringTableEntry variant = StringTable->insert( "STRINGTABLETEST_INSERT", true );
+
+    // Check.
+    ASSERT_NE( entry, variant ) << "Case sensitive insert did not add a new entry.";
+    ASSERT_STREQ( "STRINGTABLETEST_INSERT", variant ) << "Case sensitive string is incorrect.";
+    ASSERT_EQ( entry, StringTable->insert( "STRINGTABLETEST_INSERT" ) ) << "Case insensitive insert did not find the first entry.";
+    ASSERT_EQ( variant, StringTable->lookup( "STRINGTABLETEST_INSERT", true ) ) << "Case sensitive lookup did not find the variant.";
+    ASSERT_EQ( (StringTableEntry)NULL, StringTable->lookup( "StringTableTest_Missing" ) ) << "Lookup found a missing string.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( StringTableTests, HashedInsertTest )
+{
+    const char* pString = "StringTableTest_Hashed";
+
+    // Check the hash ignores case and length.
+    ASSERT_EQ( _StringTable::hashString( pString ), _StringTable::hashString( "STRINGTABLETEST_HASHED" ) ) << "Hash does not ignore case.";
+    ASSERT_EQ( _StringTable::hashString( pString ), _StringTable::hashStringn( "StringTableTest_HashedXXXX", 22 ) ) << "Hash with a length is incorrect.";
+
+    // Insert with a precomputed hash.
+    StringTableEntry entry = StringTable->insertHashed( pString, _StringTable::hashString( pString ) );
+
+    // Check.
+    ASSERT_EQ( entry, StringTable->insert( pString ) ) << "Hashed insert returned a different entry.";
+    ASSERT_EQ( entry, StringTable->insertnHashed( "StringTableTest_HashedXXXX", 22, _StringTable::hashStringn( "StringTableTest_HashedXXXX", 22 ) ) ) << "Hashed insert with a length returned a different entry.";
+    ASSERT_EQ( entry, StringTable->lookupHashed( pString, _StringTable::hashString( pString ) ) ) << "Hashed lookup did not find the entry.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( StringTableTests, ConcurrentInsertTest )
+{
+    InsertJob* pJobs = new InsertJob[STRINGTABLE_UNITTEST_THREADS];
+
+    // All threads insert the same strings.
+    const U32 sharedTime = runInsertJobs( pJobs, true );
+
+    // Check every thread got the same entries.
+    char buffer[64];
+    for ( U32 stringIndex = 0; stringIndex < STRINGTABLE_UNITTEST_STRINGS; ++stringIndex )
+    {
+        formatTestString( buffer, sizeof(buffer), 0, stringIndex, true );
+        StringTableEntry entry = StringTable->lookup( buffer, true );
+        ASSERT_STREQ( buffer, entry ) << "Shared string is incorrect.";
+
+        for ( U32 threadIndex = 0; threadIndex < STRINGTABLE_UNITTEST_THREADS; ++threadIndex )
+        {
+            ASSERT_EQ( entry, pJobs[threadIndex].mEntries[stringIndex] ) << "Threads inserting the same string got different entries.";
+        }
+    }
+
+    // Each thread inserts its own strings.
+    const U32 distinctTime = runInsertJobs( pJobs, false );
+
+    // Check every entry can be found.
+    for ( U32 threadIndex = 0; threadIndex < STRINGTABLE_UNITTEST_THREADS; ++threadIndex )
+    {
+        for ( U32 stringIndex = 0; stringIndex < STRINGTABLE_UNITTEST_STRINGS; ++stringIndex )
+        {
+            formatTestString( buffer, sizeof(buffer), threadIndex, stringIndex, false );
+            ASSERT_EQ( StringTable->lookup( buffer, true ), pJobs[threadIndex].mEntries[stringIndex] ) << "Thread string was not found.";
+        }
+    }
+
+    // All threads find the same strings.
+    const U32 findTime = runInsertJobs( pJobs, true );
+
+    Con::printf( "StringTable contention with %d threads x %d strings: shared inserts %dms, distinct inserts %dms, finds %dms.",
+        STRINGTABLE_UNITTEST_THREADS, STRINGTABLE_UNITTEST_STRINGS, sharedTime, distinctTime, findTime );
+
+    delete [] pJobs;
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,263 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _TAML_BINARYREADER_H_
+#include "persistence/taml/binary/tamlBinaryReader.h"
+#endif
+
+#ifndef _MEMSTREAM_H_
+#include "io/memstream.h"
+#endif
+
+#ifndef _CONSOLETYPES_H_
+#include "console/consoleTypes.h"
+#endif
+
+#ifndef _VECTOR2_H_
+#include "2d/core/Vector2.h"
+#endif
+
+#ifndef _COLOR_H_
+#include "graphics/gColor.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define TAML_UNITTEST_BINARY_FILE               "_unitTestTamlBinary_RemoveMe.baml"
+#define TAML_UNITTEST_BINARY_BUFFER_SIZE        1024
+
+//-----------------------------------------------------------------------------
+
+/// An object with a field of each natively written type and a text field.
+class TamlBinaryTestObject : public SimObject
+{
+    typedef SimObject Parent;
+
+public:
+    F32                 mFloatValue;
+    S32                 mIntValue;
+    bool                mBoolValue;
+    Vector2             mVectorValue;
+    ColorF              mColorValue;
+    StringTableEntry    mTextValue;
+
+public:
+    TamlBinaryTestObject() :
+        mFloatValue( 0.0f ),
+        mIntValue( 0 ),
+        mBoolValue( false ),
+        mVectorValue( 0.0f, 0.0f ),
+        mColorValue( 0.0f, 0.0f, 0.0f, 0.0f ),
+        mTextValue( StringTable->EmptyString )
+    {
+    }
+
+    static void initPersistFields()
+    {
+        Parent::initPersistFields();
+
+        addField( "FloatValue", TypeF32, Offset(mFloatValue, TamlBinaryTestObject) );
+        addField( "IntValue", TypeS32, Offset(mIntValue, TamlBinaryTestObject) );
+        addField( "BoolValue", TypeBool, Offset(mBoolValue, TamlBinaryTestObject) );
+        addField( "VectorValue", TypeVector2, Offset(mVectorValue, TamlBinaryTestObject) );
+        addField( "ColorValue", TypeColorF, Offset(mColorValue, TamlBinaryTestObject) );
+        addField( "TextValue", TypeString, Offset(mTextValue, TamlBinaryTestObject) );
+    }
+
+    DECLARE_CONOBJECT( TamlBinaryTestObject );
+};
+
+IMPLEMENT_CONOBJECT( TamlBinaryTestObject );
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    /// Writes a string pool version document by hand so that invalid indices can be written.
+    void writeHeader( Stream& stream, const char** pStrings, const U32 stringCount, const U32 objectTableSize )
+    {
+        stream.writeString( TAML_SIGNATURE );
+        stream.write( (U32)TamlBinaryFormat::StringPoolVersion );
+        stream.write( false );
+
+        // Write the string pool.
+        U32 stringPoolSize = 0;
+        for ( U32 index = 0; index < stringCount; ++index )
+            stringPoolSize += dStrlen( pStrings[index] ) + 1;
+
+        stream.write( stringCount );
+        stream.write( stringPoolSize );
+        for ( U32 index = 0; index < stringCount; ++index )
+            stream.write( dStrlen( pStrings[index] ) + 1, pStrings[index] );
+
+        stream.write( objectTableSize );
+    }
+
+    void writeElement( Stream& stream, const U32 typeIndex, const U32 nameIndex, const U32 refId, const U32 refToId )
+    {
+        stream.write( typeIndex );
+        stream.write( nameIndex );
+        stream.write( refId );
+        stream.write( refToId );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( TamlBinaryTests, RoundTripTest )
+{
+    TamlBinaryTestObject* pObject = new TamlBinaryTestObject();
+    pObject->mFloatValue = 1.5f;
+    pObject->mIntValue = -42;
+    pObject->mBoolValue = true;
+    pObject->mVectorValue.Set( 3.25f, -7.5f );
+    pObject->mColorValue.set( 0.25f, 0.5f, 0.75f, 1.0f );
+    pObject->mTextValue = StringTable->insert( "Pooled Text" );
+    pObject->registerObject( "TamlBinaryRoundTripObject" );
+
+    // Write the object.
+    Taml taml;
+    taml.setFormatMode( Taml::BinaryFormat );
+    taml.setAutoFormat( false );
+    taml.setBinaryCompression( false );
+    ASSERT_TRUE( taml.write( pObject, TAML_UNITTEST_BINARY_FILE ) ) << "Failed to write the object.";
+
+    // Delete the object so its name is free.
+    pObject->deleteObject();
+
+    // Read the object back.
+    TamlBinaryTestObject* pReadObject = taml.read<TamlBinaryTestObject>( TAML_UNITTEST_BINARY_FILE );
+    Platform::fileDelete( taml.getFilePathBuffer() );
+    ASSERT_TRUE( pReadObject != NULL ) << "Failed to read the object.";
+
+    // Check the fields.
+    EXPECT_STREQ( "TamlBinaryRoundTripObject", pReadObject->getName() ) << "Object name was not read.";
+    EXPECT_EQ( 1.5f, pReadObject->mFloatValue ) << "F32 field was not read.";
+    EXPECT_EQ( -42, pReadObject->mIntValue ) << "S32 field was not read.";
+    EXPECT_TRUE( pReadObject->mBoolValue ) << "Bool field was not read.";
+    EXPECT_EQ( 3.25f, pReadObject->mVectorValue.x ) << "Vector2 field was not read.";
+    EXPECT_EQ( -7.5f, pReadObject->mVectorValue.y ) << "Vector2 field was not read.";
+    EXPECT_TRUE( pReadObject->mColorValue == ColorF( 0.25f, 0.5f, 0.75f, 1.0f ) ) << "ColorF field was not read.";
+    EXPECT_STREQ( "Pooled Text", pReadObject->mTextValue ) << "Text field was not read.";
+
+    pReadObject->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( TamlBinaryTests, InvalidPoolIndexTest )
+{
+    const char* strings[] = { "TamlBinaryTestObject", "", "TextValue" };
+    const U32 stringCount = sizeof(strings) / sizeof(const char*);
+
+    U8 buffer[TAML_UNITTEST_BINARY_BUFFER_SIZE];
+    Taml taml;
+
+    // An element whose type is outside the pool is rejected.
+    {
+        MemStream stream( sizeof(buffer), buffer );
+        writeHeader( stream, strings, stringCount, 0 );
+        writeElement( stream, stringCount, 1, 0, 0 );
+        stream.setPosition( 0 );
+
+        SimObject* pObject = taml.readBinary( stream );
+        ASSERT_TRUE( pObject == NULL ) << "An element type outside the string pool was accepted.";
+    }
+
+    // An attribute value outside the pool is not used.
+    {
+        MemStream stream( sizeof(buffer), buffer );
+        writeHeader( stream, strings, stringCount, 0 );
+        writeElement( stream, 0, 1, 0, 0 );
+        stream.write( (U32)1 );
+        stream.write( (U32)2 );
+        stream.write( (U8)TamlBinaryFormat::PooledStringValue );
+        stream.write( (U32)1000 );
+        stream.write( (U32)0 );
+        stream.write( (U32)0 );
+        stream.setPosition( 0 );
+
+        TamlBinaryTestObject* pObject = dynamic_cast<TamlBinaryTestObject*>( taml.readBinary( stream ) );
+        ASSERT_TRUE( pObject != NULL ) << "Failed to read the object.";
+        EXPECT_STREQ( "", pObject->mTextValue ) << "An attribute value outside the string pool was used.";
+        pObject->deleteObject();
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( TamlBinaryTests, InvalidReferenceTest )
+{
+    const char* strings[] = { "SimSet", "", "SimObject" };
+    const U32 stringCount = sizeof(strings) / sizeof(const char*);
+
+    U8 buffer[TAML_UNITTEST_BINARY_BUFFER_SIZE];
+    MemStream stream( sizeof(buffer), buffer );
+
+    // The object table only holds reference Id one.
+    writeHeader( stream, strings, stringCount, 1 );
+
+    // Write a set with four children.
+    writeElement( stream, 0, 1, 0, 0 );
+    stream.write( (U32)0 );
+    stream.write( (U32)4 );
+
+    // A referenced child.
+    writeElement( stream, 2, 1, 1, 0 );
+    stream.write( (U32)0 );
+    stream.write( (U32)0 );
+    stream.write( (U32)0 );
+
+    // A reference to it.
+    writeElement( stream, 2, 1, 0, 1 );
+
+    // A child whose reference Id is outside the object table.
+    writeElement( stream, 2, 1, 5, 0 );
+    stream.write( (U32)0 );
+    stream.write( (U32)0 );
+    stream.write( (U32)0 );
+
+    // A reference to it, which is rejected and ends the children.
+    writeElement( stream, 2, 1, 0, 5 );
+
+    // The set has no custom nodes.
+    stream.write( (U32)0 );
+    stream.setPosition( 0 );
+
+    Taml taml;
+    SimSet* pSet = dynamic_cast<SimSet*>( taml.readBinary( stream ) );
+    ASSERT_TRUE( pSet != NULL ) << "Failed to read the set.";
+    EXPECT_EQ( 2, pSet->size() ) << "A reference outside the object table was accepted.";
+
+    pSet->deleteObjects();
+    pSet->deleteObject();
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,259 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+#ifndef _FRAMEALLOCATOR_H_
+#include "memory/frameAllocator.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define VECTOR_UNITTEST_ELEMENTS                65536
+#define VECTOR_UNITTEST_SHORT_ELEMENTS          24
+#define VECTOR_UNITTEST_SHORT_ITERATIONS        20000
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    /// Counts reallocations while using the heap.
+    class CountingAllocator : public VectorAllocator
+    {
+    public:
+        CountingAllocator() : mReallocations( 0 ), mReleases( 0 ) {}
+
+        virtual void* reallocate( void* memory, const U32 oldSize, const U32 newSize )
+        {
+            if ( newSize == 0 )
+            {
+                mReleases++;
+                dFree( memory );
+                return NULL;
+            }
+
+            mReallocations++;
+            return memory ? dRealloc( memory, newSize ) : dMalloc( newSize );
+        }
+
+        U32 mReallocations;
+        U32 mReleases;
+    };
+
+    /// The previous fixed block growth for comparison.
+    U32 fixedBlockAppend( const U32 count )
+    {
+        U32* pArray = NULL;
+        U32 arraySize = 0;
+
+        for ( U32 index = 0; index < count; ++index )
+        {
+            if ( index == arraySize )
+            {
+                arraySize += VectorBlockSize;
+                pArray = (U32*)( pArray ? dRealloc( pArray, arraySize * sizeof(U32) ) : dMalloc( arraySize * sizeof(U32) ) );
+            }
+
+            pArray[index] = index;
+        }
+
+        const U32 result = pArray[count-1];
+        dFree( pArray );
+        return result;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( VectorTests, GeometricGrowthTest )
+{
+    CountingAllocator allocator;
+
+    {
+        Vector<U32> values;
+        values.setAllocator( &allocator );
+
+        // Append.
+        for ( U32 index = 0; index < VECTOR_UNITTEST_ELEMENTS; ++index )
+            values.push_back( index );
+
+        // Check.
+        ASSERT_EQ( VECTOR_UNITTEST_ELEMENTS, values.size() ) << "Vector size is incorrect.";
+        ASSERT_EQ( 0, (S32)(values.capacity() % VectorBlockSize) ) << "Vector capacity is not a multiple of the block size.";
+        ASSERT_GT( (U32)(VECTOR_UNITTEST_ELEMENTS / VectorBlockSize / 16), allocator.mReallocations ) << "Vector growth is not geometric.";
+
+        for ( U32 index = 0; index < VECTOR_UNITTEST_ELEMENTS; ++index )
+        {
+            ASSERT_EQ( index, values[index] ) << "Vector element is incorrect.";
+        }
+
+        // Compact.
+        values.setSize( 10 );
+        values.compact();
+
+        // Check.
+        ASSERT_EQ( (U32)VectorBlockSize, values.capacity() ) << "Compact did not shrink to fit.";
+    }
+
+    // Check the allocator released the memory.
+    ASSERT_EQ( 1, allocator.mReleases ) << "Vector memory was not released.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( VectorTests, InlineVectorTest )
+{
+    InlineVector<U32, 16> values;
+
+    // Check.
+    ASSERT_TRUE( values.isInline() ) << "Inline vector did not start inline.";
+    ASSERT_EQ( 16, (S32)values.capacity() ) << "Inline vector capacity is incorrect.";
+
+    // Fill the inline storage.
+    for ( U32 index = 0; index < 16; ++index )
+        values.push_back( index );
+
+    // Check.
+    ASSERT_TRUE( values.isInline() ) << "Inline vector left inline storage too early.";
+
+    // Spill to the heap.
+    for ( U32 index = 16; index < 100; ++index )
+        values.push_back( index );
+
+    // Check.
+    ASSERT_FALSE( values.isInline() ) << "Inline vector did not move to the heap.";
+    for ( U32 index = 0; index < 100; ++index )
+    {
+        ASSERT_EQ( index, values[index] ) << "Inline vector element is incorrect after moving to the heap.";
+    }
+
+    // Copy.
+    InlineVector<U32, 16> copy( values );
+    ASSERT_EQ( 100, copy.size() ) << "Inline vector copy size is incorrect.";
+    ASSERT_EQ( 99, (S32)copy.last() ) << "Inline vector copy is incorrect.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( VectorTests, FrameVectorTest )
+{
+    const U32 waterMark = FrameAllocator::getWaterMark();
+
+    {
+        FrameAllocatorMarker frameMarker;
+
+        Vector<F64> values;
+        values.setAllocator( &FrameVectorAllocator::smAllocator );
+
+        for ( U32 index = 0; index < 1000; ++index )
+            values.push_back( (F64)index );
+
+        // Check.
+        ASSERT_TRUE( FrameAllocator::contains( values.address() ) ) << "Frame vector is not in frame memory.";
+        ASSERT_EQ( 0, (S32)((dsize_t)values.address() & 15) ) << "Frame vector memory is not aligned.";
+        ASSERT_EQ( 999.0, values.last() ) << "Frame vector element is incorrect.";
+    }
+
+    // Check.
+    ASSERT_EQ( waterMark, FrameAllocator::getWaterMark() ) << "Frame water mark was not restored.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( VectorTests, AppendBenchmarkTest )
+{
+    U32 checksum = 0;
+
+    // Fixed block growth.
+    U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 repeat = 0; repeat < 16; ++repeat )
+        checksum += fixedBlockAppend( VECTOR_UNITTEST_ELEMENTS );
+    const U32 fixedTime = Platform::getRealMilliseconds() - startTime;
+
+    // Geometric growth.
+    startTime = Platform::getRealMilliseconds();
+    for ( U32 repeat = 0; repeat < 16; ++repeat )
+    {
+        Vector<U32> values;
+        for ( U32 index = 0; index < VECTOR_UNITTEST_ELEMENTS; ++index )
+            values.push_back( index );
+        checksum += values.last();
+    }
+    const U32 geometricTime = Platform::getRealMilliseconds() - startTime;
+
+    // Short-lived heap vectors.
+    startTime = Platform::getRealMilliseconds();
+    for ( U32 repeat = 0; repeat < VECTOR_UNITTEST_SHORT_ITERATIONS; ++repeat )
+    {
+        Vector<U32> values;
+        for ( U32 index = 0; index < VECTOR_UNITTEST_SHORT_ELEMENTS; ++index )
+            values.push_back( index );
+        checksum += values.last();
+    }
+    const U32 shortHeapTime = Platform::getRealMilliseconds() - startTime;
+
+    // Short-lived inline vectors.
+    startTime = Platform::getRealMilliseconds();
+    for ( U32 repeat = 0; repeat < VECTOR_UNITTEST_SHORT_ITERATIONS; ++repeat )
+    {
+        InlineVector<U32, 32> values;
+        for ( U32 index = 0; index < VECTOR_UNITTEST_SHORT_ELEMENTS; ++index )
+            values.push_back( index );
+        checksum += values.last();
+    }
+    const U32 shortInlineTime = Platform::getRealMilliseconds() - startTime;
+
+    // Short-lived frame vectors.
+    startTime = Platform::getRealMilliseconds();
+    for ( U32 repeat = 0; repeat < VECTOR_UNITTEST_SHORT_ITERATIONS; ++repeat )
+    {
+        FrameAllocatorMarker frameMarker;
+        Vector<U32> values;
+        values.setAllocator( &FrameVectorAllocator::smAllocator );
+        for ( U32 index = 0; index < VECTOR_UNITTEST_SHORT_ELEMENTS; ++index )
+            values.push_back( index );
+        checksum += values.last();
+    }
+    const U32 shortFrameTime = Platform::getRealMilliseconds() - startTime;
+
+    Con::printf( "Vector append of %d elements x16: fixed blocks %dms, geometric %dms.", VECTOR_UNITTEST_ELEMENTS, fixedTime, geometricTime );
+    Con::printf( "Vector short-lived %d elements x%d: heap %dms, inline %dms, frame %dms.", VECTOR_UNITTEST_SHORT_ELEMENTS, VECTOR_UNITTEST_SHORT_ITERATIONS, shortHeapTime, shortInlineTime, shortFrameTime );
+
+    // Check.
+    ASSERT_NE( 0, (S32)checksum ) << "Benchmark checksum is incorrect.";
+}
+
+#endif // TORQUE_SHIPPING
@@ -36,6 +36,8 @@ mark_as_advanced(TORQUE_BOX2D)
 option(TORQUE_SFX_VORBIS "Vorbis Sound" ON)
 mark_as_advanced(TORQUE_SFX_VORBIS)
 option(TORQUE_SFX_OPENAL "OpenAL Sound" ON)
+option(TORQUE_MEMORY_TRACKING "Tagged memory accounting" OFF)
+mark_as_advanced(TORQUE_MEMORY_TRACKING)
 #windows uses openal-soft
 if(WIN32)
     #disable a few things that are not required
@@ -231,6 +233,10 @@ if(AL_ALEXT_PROTOTYPES)
 	addDef( "AL_ALEXT_PROTOTYPES" )
 endif()
 
+if(TORQUE_MEMORY_TRACKING)
+	addDef( "TORQUE_MEMORY_TRACKING" )
+endif()
+
 if(UNIX AND NOT APPLE)
        #set(CMAKE_SIZEOF_VOID_P 4) #force 32 bit
        set(ENV{CFLAGS} "${CXX_FLAG32} -g -O3")